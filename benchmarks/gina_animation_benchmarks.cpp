@@ -0,0 +1,42 @@
+#include "gina_benchmark.h"
+#include "gina_animation_fixtures.h"
+
+#include "animation/gina_pose.h"
+
+using namespace gina;
+
+GINA_BENCHMARK(SkeletonLodPose)
+{
+    constexpr uint32 CHARACTER_COUNT = 256;
+
+    const Skeleton skeleton = SkeletonBuilder::Build(fixtures::CreateHumanoidJoints());
+    const AnimationClip walk = fixtures::CreateRandomClip(skeleton, 1.0f, 1);
+    const AnimationClip run = fixtures::CreateRandomClip(skeleton, 0.8f, 2);
+
+    const uint32 jointCount = skeleton.GetJointCount();
+    std::vector<Transform> walkPose(jointCount);
+    std::vector<Transform> runPose(jointCount);
+    std::vector<Transform> blended(jointCount);
+    std::vector<Transform> model(jointCount);
+
+    // Sample two clips, blend them and build model space transforms for a crowd, per skeleton LOD
+    for (uint32 lod = 0; lod < skeleton.GetLodCount(); ++lod)
+    {
+        const uint32 lodJointCount = skeleton.GetLodJointCount(lod);
+        char label[64];
+        std::snprintf(label, sizeof(label), "LOD %u (%u/%u joints), characters", lod, lodJointCount, jointCount);
+
+        context.Measure(label, CHARACTER_COUNT, [&]()
+        {
+            for (uint32 character = 0; character < CHARACTER_COUNT; ++character)
+            {
+                const float time = character * 0.013f;
+                AnimationSampler::Sample(walk, time, true, lodJointCount, walkPose.data());
+                AnimationSampler::Sample(run, time, true, lodJointCount, runPose.data());
+                PoseOps::Blend(walkPose.data(), runPose.data(), 0.3f, lodJointCount, blended.data());
+                PoseOps::LocalToModel(skeleton, blended.data(), lodJointCount, model.data());
+                DoNotOptimize(model[lodJointCount - 1]);
+            }
+        });
+    }
+}
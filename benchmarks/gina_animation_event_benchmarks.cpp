@@ -0,0 +1,84 @@
+#include "gina_benchmark.h"
+
+#include <random>
+
+#include "animation/gina_animation_event.h"
+
+using namespace gina;
+
+namespace
+{
+    class EventCounter
+    {
+    public:
+        void OnEvents(const FiredAnimationEvent* events, uint32 count)
+        {
+            for (uint32 i = 0; i < count; ++i)
+            {
+                total += events[i].event.payload;
+            }
+        }
+
+        uint64 total = 0;
+    };
+}
+
+GINA_BENCHMARK(AnimationEventCrowd)
+{
+    constexpr uint32 CHARACTER_COUNT = 10000;
+    constexpr uint32 LAYER_COUNT = 2;
+    constexpr uint32 CLIP_COUNT = 32;
+    constexpr float TICK = 1.0f / 60.0f;
+
+    // Locomotion-like clips: two footsteps, their sounds and a few effect and gameplay markers each cycle
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> pickTime(0.0f, 1.0f);
+    std::vector<AnimationClip> clips(CLIP_COUNT);
+    for (uint32 c = 0; c < CLIP_COUNT; ++c)
+    {
+        AnimationClip& clip = clips[c];
+        clip.duration = 0.6f + 0.05f * c;
+        for (uint32 e = 0; e < 12; ++e)
+        {
+            clip.events.Add({ pickTime(random) * clip.duration, e % 4, e });
+        }
+    }
+
+    std::uniform_int_distribution<uint32> pickClip(0, CLIP_COUNT - 1);
+    std::uniform_real_distribution<float> pickStart(0.0f, 30.0f);
+    std::vector<AnimationEventQuery> queries(CHARACTER_COUNT * LAYER_COUNT);
+    for (uint32 q = 0; q < queries.size(); ++q)
+    {
+        AnimationEventQuery& query = queries[q];
+        query.clip = &clips[pickClip(random)];
+        query.previousTime = pickStart(random);
+        query.currentTime = query.previousTime + TICK;
+        query.loop = true;
+        query.source = q / LAYER_COUNT;
+    }
+
+    EventCounter counter;
+    AnimationEventAction action;
+    action.Subscribe(&counter, &EventCounter::OnEvents);
+    AnimationEventBuffer buffer;
+
+    AnimationEventSampler::CollectBatch(queries.data(), static_cast<uint32>(queries.size()), buffer);
+    std::printf("  %u events fired per tick by %u characters\n", buffer.GetCount(), CHARACTER_COUNT);
+
+    context.Measure("collect + dispatch, characters", CHARACTER_COUNT, [&]()
+    {
+        AnimationEventSampler::CollectBatch(queries.data(), static_cast<uint32>(queries.size()), buffer);
+        AnimationEventSampler::Dispatch(buffer, action);
+        DoNotOptimize(counter.total);
+    });
+
+    ThreadPool threadPool;
+    char label[64];
+    std::snprintf(label, sizeof(label), "collect on %u workers + caller, characters", threadPool.GetWorkerCount());
+    context.Measure(label, CHARACTER_COUNT, [&]()
+    {
+        AnimationEventSampler::CollectBatch(queries.data(), static_cast<uint32>(queries.size()), buffer, &threadPool);
+        AnimationEventSampler::Dispatch(buffer, action);
+        DoNotOptimize(counter.total);
+    });
+}
@@ -0,0 +1,137 @@
+#ifndef _GINA_ANIMATION_FIXTURES_H_
+#define _GINA_ANIMATION_FIXTURES_H_
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "animation/gina_animation_clip.h"
+#include "animation/gina_skeleton.h"
+#include "animation/gina_skinning.h"
+
+namespace gina
+{
+    namespace fixtures
+    {
+        inline uint16 AddJoint(std::vector<SkeletonJointDesc>& joints, const std::string& name, uint16 parent, const float3& offset)
+        {
+            SkeletonJointDesc joint;
+            joint.name = name;
+            joint.parent = parent;
+            joint.bindPose.translation = offset;
+            joints.push_back(joint);
+            return static_cast<uint16>(joints.size() - 1);
+        }
+
+        // Game-style humanoid: spine, limbs, three-joint fingers on both hands and a facial rig, 77 joints
+        inline std::vector<SkeletonJointDesc> CreateHumanoidJoints()
+        {
+            std::vector<SkeletonJointDesc> joints;
+            const uint16 root = AddJoint(joints, "root", INVALID_JOINT, float3(0.0f, 0.0f, 0.0f));
+            const uint16 pelvis = AddJoint(joints, "pelvis", root, float3(0.0f, 1.0f, 0.0f));
+            uint16 spine = pelvis;
+            for (uint32 i = 0; i < 3; ++i)
+            {
+                spine = AddJoint(joints, "spine" + std::to_string(i), spine, float3(0.0f, 0.15f, 0.0f));
+            }
+            const uint16 neck = AddJoint(joints, "neck", spine, float3(0.0f, 0.15f, 0.0f));
+            const uint16 head = AddJoint(joints, "head", neck, float3(0.0f, 0.1f, 0.0f));
+
+            for (uint32 i = 0; i < 24; ++i)
+            {
+                const float angle = 2.0f * PI * i / 24.0f;
+                AddJoint(joints, "face" + std::to_string(i), head, float3(std::cos(angle) * 0.05f, 0.08f, 0.08f + std::sin(angle) * 0.02f));
+            }
+
+            for (int side = -1; side <= 1; side += 2)
+            {
+                const std::string prefix = side < 0 ? "l_" : "r_";
+                const float s = static_cast<float>(side);
+
+                const uint16 clavicle = AddJoint(joints, prefix + "clavicle", spine, float3(s * 0.05f, 0.1f, 0.0f));
+                const uint16 upperArm = AddJoint(joints, prefix + "upperarm", clavicle, float3(s * 0.15f, 0.0f, 0.0f));
+                const uint16 foreArm = AddJoint(joints, prefix + "forearm", upperArm, float3(s * 0.28f, 0.0f, 0.0f));
+                const uint16 hand = AddJoint(joints, prefix + "hand", foreArm, float3(s * 0.25f, 0.0f, 0.0f));
+                for (uint32 finger = 0; finger < 5; ++finger)
+                {
+                    uint16 phalanx = hand;
+                    for (uint32 i = 0; i < 3; ++i)
+                    {
+                        const float3 offset = i == 0 ? float3(s * 0.08f, 0.0f, 0.02f * (finger - 2.0f)) : float3(s * 0.025f, 0.0f, 0.0f);
+                        phalanx = AddJoint(joints, prefix + "finger" + std::to_string(finger) + "_" + std::to_string(i), phalanx, offset);
+                    }
+                }
+
+                const uint16 thigh = AddJoint(joints, prefix + "thigh", pelvis, float3(s * 0.1f, -0.05f, 0.0f));
+                const uint16 calf = AddJoint(joints, prefix + "calf", thigh, float3(0.0f, -0.45f, 0.0f));
+                const uint16 foot = AddJoint(joints, prefix + "foot", calf, float3(0.0f, -0.42f, 0.0f));
+                AddJoint(joints, prefix + "toe", foot, float3(0.0f, -0.05f, 0.12f));
+            }
+
+            return joints;
+        }
+
+        // Random local rotations around the bind pose, uniformly sampled at 30 Hz
+        inline AnimationClip CreateRandomClip(const Skeleton& skeleton, float duration, uint32 seed)
+        {
+            std::mt19937 random(seed);
+            std::uniform_real_distribution<float> angle(-0.5f, 0.5f);
+
+            AnimationClip clip;
+            clip.name = "random" + std::to_string(seed);
+            clip.duration = duration;
+            clip.jointCount = skeleton.GetJointCount();
+
+            const uint32 frameCount = static_cast<uint32>(duration * clip.sampleRate) + 1;
+            clip.frames.reserve(static_cast<size_t>(frameCount) * clip.jointCount);
+            for (uint32 frame = 0; frame < frameCount; ++frame)
+            {
+                for (uint32 joint = 0; joint < clip.jointCount; ++joint)
+                {
+                    Transform local = skeleton.bindPose[joint];
+                    local.rotation = quaternion::fromAxisAngle(float3(angle(random), 1.0f, angle(random)), angle(random));
+                    clip.frames.push_back(local);
+                }
+            }
+            return clip;
+        }
+
+        // Random unit-cube vertices with four random influences each, as a dense character mesh would have
+        inline SkinningData CreateRandomSkinningData(const Skeleton& skeleton, uint32 vertexCount, uint32 seed)
+        {
+            std::mt19937 random(seed);
+            std::uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+            std::uniform_real_distribution<float> weight(0.0f, 1.0f);
+            std::uniform_int_distribution<uint32> joint(0, std::min(skeleton.GetJointCount(), MAX_SKINNING_JOINTS) - 1);
+
+            SkinningData data;
+            data.bindVertices.Resize(vertexCount, true);
+            data.joints.resize(vertexCount);
+            data.weights.resize(vertexCount);
+            for (uint32 v = 0; v < vertexCount; ++v)
+            {
+                data.bindVertices.positionX[v] = coordinate(random);
+                data.bindVertices.positionY[v] = coordinate(random);
+                data.bindVertices.positionZ[v] = coordinate(random);
+
+                const float3 normal = float3(coordinate(random), coordinate(random), coordinate(random)).normalized();
+                data.bindVertices.normalX[v] = normal.x;
+                data.bindVertices.normalY[v] = normal.y;
+                data.bindVertices.normalZ[v] = normal.z;
+
+                float weights[MAX_SKIN_INFLUENCES];
+                uint32 joints = 0;
+                for (uint32 i = 0; i < MAX_SKIN_INFLUENCES; ++i)
+                {
+                    weights[i] = weight(random);
+                    joints |= joint(random) << (i * 8);
+                }
+                data.joints[v] = joints;
+                data.weights[v] = SkinningData::PackWeights(weights);
+            }
+            return data;
+        }
+    }
+}
+
+#endif // !_GINA_ANIMATION_FIXTURES_H_
@@ -0,0 +1,112 @@
+#ifndef _GINA_BENCHMARK_H_
+#define _GINA_BENCHMARK_H_
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "core/gina_singleton.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    template <typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+#if defined(_MSC_VER)
+        static volatile const void* sink;
+        sink = &value;
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    class BenchmarkContext
+    {
+    public:
+        explicit BenchmarkContext(double minSeconds) : m_minSeconds(minSeconds) {}
+
+        /**
+         * Runs body until at least the configured minimum time has elapsed (after one warm-up call)
+         * and prints the average time per call together with itemsPerCall throughput
+         */
+        template <typename Func>
+        double Measure(const std::string& label, uint64 itemsPerCall, Func&& body)
+        {
+            using Clock = std::chrono::steady_clock;
+
+            body();
+
+            uint64 iterations = 0;
+            const Clock::time_point start = Clock::now();
+            double elapsed = 0.0;
+
+            do
+            {
+                body();
+                ++iterations;
+                elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            } while (elapsed < m_minSeconds);
+
+            const double secondsPerCall = elapsed / static_cast<double>(iterations);
+            const double itemsPerSecond = static_cast<double>(itemsPerCall) / secondsPerCall;
+
+            std::printf("  %-56s %12.3f us/call %14.3f M items/s\n", label.c_str(), secondsPerCall * 1e6, itemsPerSecond * 1e-6);
+            return secondsPerCall;
+        }
+
+    private:
+        double m_minSeconds;
+    };
+
+    class BenchmarkRegistry : public Singleton<BenchmarkRegistry>
+    {
+        friend class Singleton<BenchmarkRegistry>;
+
+    public:
+        using BenchmarkFunc = void(*)(BenchmarkContext&);
+
+        bool Register(const char* name, BenchmarkFunc func)
+        {
+            m_benchmarks.push_back({ name, func });
+            return true;
+        }
+
+        uint32 Run(const std::string& filter, double minSeconds)
+        {
+            uint32 runCount = 0;
+            for (const Entry& entry : m_benchmarks)
+            {
+                if (!filter.empty() && entry.name.find(filter) == std::string::npos)
+                {
+                    continue;
+                }
+
+                std::printf("%s\n", entry.name.c_str());
+                BenchmarkContext context(minSeconds);
+                entry.func(context);
+                ++runCount;
+            }
+            return runCount;
+        }
+
+    private:
+        BenchmarkRegistry() = default;
+
+        struct Entry
+        {
+            std::string name;
+            BenchmarkFunc func;
+        };
+
+        std::vector<Entry> m_benchmarks;
+    };
+}
+
+#define GINA_BENCHMARK(name) \
+    static void name(gina::BenchmarkContext& context); \
+    static const bool name##Registered = gina::BenchmarkRegistry::Get().Register(#name, &name); \
+    static void name(gina::BenchmarkContext& context)
+
+#endif // !_GINA_BENCHMARK_H_
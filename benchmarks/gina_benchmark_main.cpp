@@ -0,0 +1,33 @@
+#include <cstdlib>
+#include <string>
+
+#include "gina_benchmark.h"
+
+using namespace gina;
+
+int main(int argc, char** argv)
+{
+    std::string filter;
+    double minSeconds = 0.25;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--filter" && i + 1 < argc)
+        {
+            filter = argv[++i];
+        }
+        else if (argument == "--min-time" && i + 1 < argc)
+        {
+            minSeconds = std::atof(argv[++i]);
+        }
+        else
+        {
+            std::printf("Usage: gina_benchmarks [--filter <substring>] [--min-time <seconds>]\n");
+            return 1;
+        }
+    }
+
+    const uint32 runCount = BenchmarkRegistry::Get().Run(filter, minSeconds);
+    return runCount > 0 ? 0 : 1;
+}
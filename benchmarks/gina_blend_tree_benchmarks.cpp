@@ -0,0 +1,91 @@
+#include "gina_benchmark.h"
+#include "gina_animation_fixtures.h"
+
+#include "animation/gina_blend_tree.h"
+
+using namespace gina;
+
+GINA_BENCHMARK(BlendTreeCrowd)
+{
+    constexpr uint32 CHARACTER_COUNT = 1000;
+    constexpr uint32 CLIP_COUNT = 8;
+
+    const Skeleton skeleton = SkeletonBuilder::Build(fixtures::CreateHumanoidJoints());
+    const uint32 jointCount = skeleton.GetJointCount();
+
+    std::vector<AnimationClip> clips;
+    for (uint32 i = 0; i < CLIP_COUNT; ++i)
+    {
+        clips.push_back(fixtures::CreateRandomClip(skeleton, 0.8f + 0.1f * i, i + 1));
+    }
+
+    // Balanced binary tree of lerps over eight clips, one parameter per blend node
+    BlendTree tree;
+    std::vector<uint16> level;
+    for (const AnimationClip& clip : clips)
+    {
+        level.push_back(tree.AddClip(&clip));
+    }
+    while (level.size() > 1)
+    {
+        std::vector<uint16> next;
+        for (size_t i = 0; i < level.size(); i += 2)
+        {
+            const uint16 parameter = tree.AddParameter("blend" + std::to_string(tree.GetParameterCount()));
+            next.push_back(tree.AddBlend(level[i], level[i + 1], parameter));
+        }
+        level = std::move(next);
+    }
+
+    std::vector<float> fullParameters(tree.GetParameterCount() * CHARACTER_COUNT);
+    std::vector<float> prunedParameters(fullParameters.size());
+    for (uint32 character = 0; character < CHARACTER_COUNT; ++character)
+    {
+        for (uint32 p = 0; p < tree.GetParameterCount(); ++p)
+        {
+            const uint32 index = character * tree.GetParameterCount() + p;
+            fullParameters[index] = 0.25f + 0.5f * ((character + p) % 7) / 6.0f;
+
+            // Only the root blend is active: each side collapses onto a single clip
+            prunedParameters[index] = p + 1 == tree.GetParameterCount() ? 0.5f : static_cast<float>((character + p) % 2);
+        }
+    }
+
+    std::vector<BlendCommandList> commands(CHARACTER_COUNT);
+    std::vector<Transform> scratch;
+    std::vector<Transform> local(jointCount);
+
+    context.Measure("compile 8-way, characters", CHARACTER_COUNT, [&]()
+    {
+        for (uint32 character = 0; character < CHARACTER_COUNT; ++character)
+        {
+            BlendTreeEvaluator::Compile(tree, &fullParameters[character * tree.GetParameterCount()], commands[character]);
+        }
+        DoNotOptimize(commands.back().commands.size());
+    });
+
+    context.Measure("execute 8-way, characters", CHARACTER_COUNT, [&]()
+    {
+        for (uint32 character = 0; character < CHARACTER_COUNT; ++character)
+        {
+            BlendTreeEvaluator::Execute(tree, commands[character], character * 0.013f, jointCount, scratch, local.data());
+            DoNotOptimize(local[jointCount - 1]);
+        }
+    });
+
+    for (uint32 character = 0; character < CHARACTER_COUNT; ++character)
+    {
+        BlendTreeEvaluator::Compile(tree, &prunedParameters[character * tree.GetParameterCount()], commands[character]);
+    }
+
+    char label[64];
+    std::snprintf(label, sizeof(label), "execute pruned to %u clips, characters", commands[0].sampledClipCount);
+    context.Measure(label, CHARACTER_COUNT, [&]()
+    {
+        for (uint32 character = 0; character < CHARACTER_COUNT; ++character)
+        {
+            BlendTreeEvaluator::Execute(tree, commands[character], character * 0.013f, jointCount, scratch, local.data());
+            DoNotOptimize(local[jointCount - 1]);
+        }
+    });
+}
@@ -0,0 +1,56 @@
+#include "gina_benchmark.h"
+
+#include "core/gina_thread_pool.h"
+#include "rhi/gina_command_list_pool.h"
+#include "rhi/gina_frame_ring.h"
+#include "rhi/gina_null_rhi.h"
+
+using namespace gina;
+
+// Recording the draws of a skinned crowd, each character binding its palette offset and drawing its mesh
+GINA_BENCHMARK(CommandListRecording)
+{
+    constexpr uint32 CHARACTER_COUNT = 10000;
+    constexpr uint32 DRAWS_PER_CHARACTER = 3;
+
+    NullDeviceSettings settings;
+    settings.recordCommands = false;
+    NullDevice device(settings);
+    const RHIBufferHandle indices = device.CreateBuffer({ 16 << 20, RHIMemoryType::Default, false, "indices" });
+
+    auto recordCharacters = [&](RHICommandList& list, uint32 begin, uint32 end)
+    {
+        list.SetIndexBuffer(indices, 0, 16 << 20, false);
+        for (uint32 i = begin; i < end; ++i)
+        {
+            for (uint32 draw = 0; draw < DRAWS_PER_CHARACTER; ++draw)
+            {
+                const uint32 constants[] = { i * 64, draw, i, 0 };
+                list.SetConstants(0, constants, 4);
+                list.DrawIndexed(4000, 1, draw * 4000, 0, i);
+            }
+        }
+    };
+
+    auto measure = [&](const char* label, ThreadPool* threadPool, uint32 grainSize)
+    {
+        FrameRing ring(device);
+        CommandListPool pool(device);
+        context.Measure(label, CHARACTER_COUNT, [&]()
+        {
+            ring.BeginFrame();
+            pool.BeginFrame(ring.GetCurrentFenceValue(), ring.GetCompletedValue());
+            pool.Record(threadPool, CHARACTER_COUNT, grainSize, recordCharacters);
+            pool.Submit(device.GetQueue(RHIQueueType::Graphics));
+            ring.EndFrame();
+        });
+        std::printf("  %u lists, %u allocators\n", pool.GetStats().lists, pool.GetStats().allocators);
+    };
+
+    ThreadPool threadPool;
+    const uint32 threadCount = threadPool.GetWorkerCount() + 1;
+    std::printf("  %u recording threads\n", threadCount);
+    measure("single list, characters", nullptr, CHARACTER_COUNT);
+    measure("one list per thread, characters", &threadPool, (CHARACTER_COUNT + threadCount - 1) / threadCount);
+    measure("lists of 256 characters, characters", &threadPool, 256);
+}
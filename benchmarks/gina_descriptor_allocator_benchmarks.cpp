@@ -0,0 +1,60 @@
+#include "gina_benchmark.h"
+
+#include <random>
+#include <vector>
+
+#include "rhi/gina_descriptor_allocator.h"
+
+using namespace gina;
+
+GINA_BENCHMARK(DescriptorAllocation)
+{
+    constexpr uint32 HEAP_SIZE = 1000000;
+    constexpr uint32 RESIDENT_COUNT = 100000;
+    constexpr uint32 CHURN_COUNT = 1000;
+
+    // Streaming churn: a heap holding 100k texture and buffer views replaces 1000 of them a frame
+    {
+        PersistentDescriptorAllocator allocator(0, HEAP_SIZE);
+        std::mt19937 random(5);
+        std::uniform_int_distribution<uint32> pickCount(1, 4);
+        std::vector<DescriptorRange> resident;
+        for (uint32 i = 0; i < RESIDENT_COUNT; ++i)
+        {
+            resident.push_back(allocator.Allocate(pickCount(random)));
+        }
+
+        uint64 frame = 0;
+        context.Measure("persistent free and allocate, descriptors", CHURN_COUNT, [&]()
+        {
+            ++frame;
+            allocator.Reclaim(frame - 1);
+            for (uint32 i = 0; i < CHURN_COUNT; ++i)
+            {
+                DescriptorRange& range = resident[random() % RESIDENT_COUNT];
+                allocator.Free(range, frame);
+                range = allocator.Allocate(pickCount(random));
+            }
+        });
+        const PersistentDescriptorStats stats = allocator.GetStats();
+        std::printf("  %u used, %u free blocks, largest %u, %llu failures\n", stats.usedCount, stats.freeBlockCount,
+            stats.largestFreeBlock, static_cast<unsigned long long>(stats.failures));
+    }
+
+    // Per draw descriptor tables of 8 views for a frame of draws
+    {
+        constexpr uint32 DRAW_COUNT = 20000;
+        TransientDescriptorAllocator allocator(HEAP_SIZE, 4096, 256);
+        uint64 frame = 0;
+        context.Measure("transient tables, draws", DRAW_COUNT, [&]()
+        {
+            ++frame;
+            allocator.BeginFrame(frame, frame - 1);
+            DescriptorPageCursor cursor;
+            for (uint32 i = 0; i < DRAW_COUNT; ++i)
+            {
+                DoNotOptimize(allocator.Allocate(cursor, 8).index);
+            }
+        });
+    }
+}
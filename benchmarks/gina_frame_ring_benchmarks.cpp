@@ -0,0 +1,52 @@
+#include "gina_benchmark.h"
+
+#include <chrono>
+
+#include "rhi/gina_frame_ring.h"
+#include "rhi/gina_null_rhi.h"
+
+using namespace gina;
+
+// Frame time of a 1.5 ms CPU frame feeding a 2 ms GPU frame on the real time null backend, by frames in flight
+GINA_BENCHMARK(FramePacing)
+{
+    constexpr double CPU_TIME = 1.5;
+    constexpr double GPU_TIME = 2.0;
+
+    for (uint32 framesInFlight : { 1u, 2u, 3u })
+    {
+        NullDeviceSettings settings;
+        settings.submissionTime = GPU_TIME;
+        settings.realTime = true;
+        settings.recordCommands = false;
+        NullDevice device(settings);
+
+        FrameRing ring(device, { framesInFlight });
+        std::unique_ptr<RHICommandList> list = device.CreateCommandList(RHIQueueType::Graphics);
+
+        char label[64];
+        std::snprintf(label, sizeof(label), "%u frames in flight, frames", framesInFlight);
+        context.Measure(label, 1, [&]()
+        {
+            FrameContext& frame = ring.BeginFrame();
+            list->Begin(*frame.allocator);
+            list->Draw(3, 1, 0, 0);
+            list->End();
+
+            using Clock = std::chrono::steady_clock;
+            const Clock::time_point start = Clock::now();
+            while (std::chrono::duration<double, std::milli>(Clock::now() - start).count() < CPU_TIME)
+            {
+            }
+
+            RHICommandList* batch[] = { list.get() };
+            device.GetQueue(RHIQueueType::Graphics).Submit(batch, 1);
+            ring.EndFrame();
+        });
+        ring.Flush();
+
+        const FrameRingStats& stats = ring.GetStats();
+        std::printf("  %u frames in flight: CPU waited in %.0f%% of frames, %.3f ms a frame on average, %.3f ms at most\n",
+            framesInFlight, 100.0 * stats.cpuWaits / stats.frames, stats.cpuWaitTime / stats.frames, stats.maxCpuWaitTime);
+    }
+}
@@ -0,0 +1,92 @@
+#include "gina_benchmark.h"
+
+#include <random>
+
+#include "animation/gina_ik.h"
+
+using namespace gina;
+
+GINA_BENCHMARK(CrowdIK)
+{
+    constexpr uint32 CHARACTER_COUNT = 1000;
+    constexpr uint32 TAIL_JOINTS = 6;
+
+    std::mt19937 random(5);
+    std::uniform_real_distribution<float> spread(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> ground(-0.15f, 0.15f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    // Foot planting: both legs of every character reach for uneven ground under their hips
+    TwoBoneIKBatch legs;
+    legs.Resize(CHARACTER_COUNT * 2);
+    // Tails swinging towards a point beside the character, some out of reach
+    FabrikIKBatch tails;
+    tails.Resize(TAIL_JOINTS, CHARACTER_COUNT);
+    tails.tolerance = 1e-3f;
+    // Heads tracking a point of interest
+    LookAtIKBatch heads;
+    heads.Resize(CHARACTER_COUNT);
+    heads.maxAngle = 1.2f;
+
+    for (uint32 c = 0; c < CHARACTER_COUNT; ++c)
+    {
+        const float3 pelvis(spread(random), 1.0f, spread(random));
+        for (uint32 side = 0; side < 2; ++side)
+        {
+            const uint32 leg = c * 2 + side;
+            const float3 hip = pelvis + float3(side == 0 ? -0.1f : 0.1f, 0.0f, 0.0f);
+            legs.root.Set(leg, hip);
+            legs.mid.Set(leg, hip + float3(0.0f, -0.45f, 0.03f));
+            legs.end.Set(leg, hip + float3(0.0f, -0.9f, 0.0f));
+            legs.target.Set(leg, float3(hip.x, 0.08f + ground(random), hip.z + ground(random)));
+            legs.pole.Set(leg, float3(0.0f, 0.0f, 1.0f));
+        }
+
+        for (uint32 j = 0; j < TAIL_JOINTS; ++j)
+        {
+            tails.positions[j].Set(c, pelvis + float3(0.02f * (j % 2), 0.0f, -0.15f * j));
+        }
+        tails.target.Set(c, pelvis + float3(unit(random) * 0.8f, unit(random) * 0.3f, -0.4f));
+
+        heads.position.Set(c, pelvis + float3(0.0f, 0.7f, 0.0f));
+        heads.forward.Set(c, float3(0.0f, 0.0f, 1.0f));
+        heads.target.Set(c, float3(spread(random), 1.7f, spread(random)));
+    }
+
+    context.Measure("two-bone legs, scalar", legs.GetCount(), [&]()
+    {
+        IKSolver::SolveTwoBoneScalar(legs, 0, legs.GetCount());
+        DoNotOptimize(legs.midDelta.w.back());
+    });
+    context.Measure("two-bone legs, SSE2 batch", legs.GetCount(), [&]()
+    {
+        IKSolver::SolveTwoBone(legs);
+        DoNotOptimize(legs.midDelta.w.back());
+    });
+
+    // FABRIK solves positions in place; both variants restart from the same rest pose
+    const std::vector<IKVectorStream> restPositions = tails.positions;
+    context.Measure("FABRIK 6-joint tails, scalar", tails.GetCount(), [&]()
+    {
+        tails.positions = restPositions;
+        IKSolver::SolveFabrikScalar(tails, 0, tails.GetCount());
+        DoNotOptimize(tails.deltas.back().w.back());
+    });
+    context.Measure("FABRIK 6-joint tails, SSE2 batch", tails.GetCount(), [&]()
+    {
+        tails.positions = restPositions;
+        IKSolver::SolveFabrik(tails);
+        DoNotOptimize(tails.deltas.back().w.back());
+    });
+
+    context.Measure("look-at heads, scalar", heads.GetCount(), [&]()
+    {
+        IKSolver::SolveLookAtScalar(heads, 0, heads.GetCount());
+        DoNotOptimize(heads.delta.w.back());
+    });
+    context.Measure("look-at heads, SSE2 batch", heads.GetCount(), [&]()
+    {
+        IKSolver::SolveLookAt(heads);
+        DoNotOptimize(heads.delta.w.back());
+    });
+}
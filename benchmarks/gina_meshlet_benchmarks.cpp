@@ -0,0 +1,107 @@
+#include "gina_benchmark.h"
+
+#include "mesh/gina_meshlet.h"
+#include "mesh/gina_meshlet_culler.h"
+#include "mesh/gina_mesh_optimizer.h"
+
+using namespace gina;
+
+namespace
+{
+    Mesh CreateSphereMesh(uint32 rings, uint32 segments, float radius)
+    {
+        Mesh mesh;
+        mesh.name = "sphere";
+
+        for (uint32 r = 0; r <= rings; ++r)
+        {
+            const float theta = PI * static_cast<float>(r) / static_cast<float>(rings);
+            for (uint32 s = 0; s <= segments; ++s)
+            {
+                const float phi = 2.0f * PI * static_cast<float>(s) / static_cast<float>(segments);
+                const float3 normal(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+                mesh.positions.push_back(normal * radius);
+                mesh.normals.push_back(normal);
+            }
+        }
+
+        const uint32 stride = segments + 1;
+        for (uint32 r = 0; r < rings; ++r)
+        {
+            for (uint32 s = 0; s < segments; ++s)
+            {
+                const uint32 v0 = r * stride + s;
+                mesh.indices.insert(mesh.indices.end(), { v0, v0 + 1, v0 + stride });
+                mesh.indices.insert(mesh.indices.end(), { v0 + 1, v0 + stride + 1, v0 + stride });
+            }
+        }
+
+        return mesh;
+    }
+
+    std::vector<MeshletBounds> CreateMeshletField(const MeshletData& meshlets, uint32 copiesPerAxis, float spacing)
+    {
+        std::vector<MeshletBounds> bounds;
+        bounds.reserve(meshlets.bounds.size() * copiesPerAxis * copiesPerAxis);
+
+        for (uint32 x = 0; x < copiesPerAxis; ++x)
+        {
+            for (uint32 z = 0; z < copiesPerAxis; ++z)
+            {
+                const float3 offset((x - copiesPerAxis * 0.5f) * spacing, 0.0f, (z - copiesPerAxis * 0.5f) * spacing);
+                for (MeshletBounds instance : meshlets.bounds)
+                {
+                    instance.center += offset;
+                    bounds.push_back(instance);
+                }
+            }
+        }
+
+        return bounds;
+    }
+}
+
+GINA_BENCHMARK(MeshletBuild)
+{
+    Mesh mesh = CreateSphereMesh(256, 512, 1.0f);
+    MeshOptimizer::Optimize(mesh);
+
+    context.Measure("build 64v/124t (triangles)", mesh.GetTriangleCount(), [&]()
+    {
+        MeshletData data = MeshletBuilder::Build(mesh);
+        DoNotOptimize(data.meshlets.size());
+    });
+}
+
+GINA_BENCHMARK(MeshletCull)
+{
+    Mesh mesh = CreateSphereMesh(128, 256, 1.0f);
+    MeshOptimizer::Optimize(mesh);
+
+    const MeshletData meshlets = MeshletBuilder::Build(mesh);
+    const std::vector<MeshletBounds> bounds = CreateMeshletField(meshlets, 16, 3.0f);
+    const uint32 count = static_cast<uint32>(bounds.size());
+
+    const float3 cameraPosition(0.0f, 2.0f, -30.0f);
+    const Frustum frustum = Frustum::FromPerspective(cameraPosition, float3(0.0f, -0.1f, 1.0f), float3(0.0f, 1.0f, 0.0f),
+        ConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+
+    std::vector<uint32> visible(count);
+    uint32 visibleCount = 0;
+
+    context.Measure("scalar (meshlets)", count, [&]()
+    {
+        visibleCount = MeshletCuller::CullScalar(bounds.data(), count, frustum, cameraPosition, visible.data());
+        DoNotOptimize(visibleCount);
+    });
+
+#if defined(GINA_SSE2_ENABLED)
+    context.Measure("sse2 (meshlets)", count, [&]()
+    {
+        visibleCount = MeshletCuller::CullSSE2(bounds.data(), count, frustum, cameraPosition, visible.data());
+        DoNotOptimize(visibleCount);
+    });
+#endif
+
+    std::printf("  %u of %u meshlets visible (%.1f%%)\n", visibleCount, count, 100.0f * visibleCount / count);
+}
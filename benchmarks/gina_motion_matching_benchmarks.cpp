@@ -0,0 +1,186 @@
+#include "gina_benchmark.h"
+#include "gina_animation_fixtures.h"
+
+#include <chrono>
+#include <random>
+
+#include "animation/gina_motion_matching.h"
+
+using namespace gina;
+
+namespace
+{
+    constexpr float SAMPLE_RATE = 30.0f;
+    constexpr float CLIP_DURATION = 60.0f;
+
+    // Root, pelvis and two-joint legs: enough for the features, cheap to generate hours of
+    Skeleton CreateLocomotionSkeleton()
+    {
+        std::vector<SkeletonJointDesc> joints;
+        const uint16 root = fixtures::AddJoint(joints, "root", INVALID_JOINT, float3(0.0f, 0.0f, 0.0f));
+        const uint16 pelvis = fixtures::AddJoint(joints, "pelvis", root, float3(0.0f, 1.0f, 0.0f));
+        const uint16 leftThigh = fixtures::AddJoint(joints, "l_thigh", pelvis, float3(-0.1f, 0.0f, 0.0f));
+        fixtures::AddJoint(joints, "l_foot", leftThigh, float3(0.0f, -0.9f, 0.0f));
+        const uint16 rightThigh = fixtures::AddJoint(joints, "r_thigh", pelvis, float3(0.1f, 0.0f, 0.0f));
+        fixtures::AddJoint(joints, "r_foot", rightThigh, float3(0.0f, -0.9f, 0.0f));
+        return SkeletonBuilder::Build(joints);
+    }
+
+    // A minute of wandering: speed and turn rate drift smoothly, the legs swing with the stride
+    AnimationClip CreateLocomotionClip(const Skeleton& skeleton, uint32 seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> frequency(0.05f, 0.4f);
+        std::uniform_real_distribution<float> phase(0.0f, 2.0f * PI);
+        const float speedFrequency = frequency(random), speedPhase = phase(random);
+        const float turnFrequency = frequency(random), turnPhase = phase(random);
+
+        AnimationClip clip;
+        clip.duration = CLIP_DURATION;
+        clip.sampleRate = SAMPLE_RATE;
+        clip.jointCount = skeleton.GetJointCount();
+
+        const uint16 leftThigh = skeleton.FindJoint("l_thigh");
+        const uint16 rightThigh = skeleton.FindJoint("r_thigh");
+        const float frameTime = 1.0f / SAMPLE_RATE;
+        float3 position;
+        float heading = phase(random);
+        float stride = 0.0f;
+
+        const uint32 frameCount = static_cast<uint32>(CLIP_DURATION * SAMPLE_RATE) + 1;
+        clip.frames.reserve(frameCount * clip.jointCount);
+        for (uint32 frame = 0; frame < frameCount; ++frame)
+        {
+            const float time = frame * frameTime;
+            const float speed = 2.0f + 1.9f * std::sin(2.0f * PI * speedFrequency * time + speedPhase);
+            heading += 1.5f * std::sin(2.0f * PI * turnFrequency * time + turnPhase) * frameTime;
+            stride += speed * frameTime * 2.0f;
+
+            const quaternion facing = quaternion::fromAxisAngle(float3(0.0f, 1.0f, 0.0f), heading);
+            position += facing.rotate(float3(0.0f, 0.0f, speed * frameTime));
+            const float swing = std::min(speed, 2.0f) * 0.3f * std::sin(stride);
+
+            for (uint32 joint = 0; joint < clip.jointCount; ++joint)
+            {
+                Transform local = skeleton.bindPose[joint];
+                if (joint == 0)
+                {
+                    local.translation = position;
+                    local.rotation = facing;
+                }
+                else if (joint == leftThigh || joint == rightThigh)
+                {
+                    local.rotation = quaternion::fromAxisAngle(float3(1.0f, 0.0f, 0.0f), joint == leftThigh ? swing : -swing);
+                }
+                clip.frames.push_back(local);
+            }
+        }
+        return clip;
+    }
+
+    MotionDatabase CreateDatabase(const Skeleton& skeleton, const MotionFeatureSettings& settings, uint32 entryCount,
+        std::vector<float>& rows)
+    {
+        std::vector<uint32> clips;
+        std::vector<uint32> frames;
+        std::vector<Transform> scratch;
+        float features[MOTION_FEATURE_COUNT];
+
+        // Clips are generated and dropped one at a time; only their feature rows are kept
+        for (uint32 c = 0; clips.size() < entryCount; ++c)
+        {
+            const AnimationClip clip = CreateLocomotionClip(skeleton, c + 1);
+            for (uint32 frame = 0; frame < clip.GetFrameCount() && clips.size() < entryCount; ++frame)
+            {
+                if (MotionDatabaseBuilder::ExtractFeatures(skeleton, { &clip, false }, frame, settings, scratch, features))
+                {
+                    rows.insert(rows.end(), features, features + MOTION_FEATURE_COUNT);
+                    clips.push_back(c);
+                    frames.push_back(frame);
+                }
+            }
+        }
+
+        return MotionDatabaseBuilder::Build(rows, clips, frames, settings);
+    }
+
+    // Database poses with a perturbed trajectory, like a character steering away from the clip it plays
+    std::vector<float> CreateQueries(const MotionDatabase& database, const std::vector<float>& rows, uint32 count, uint32 seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<uint32> pickEntry(0, database.entryCount - 1);
+        std::normal_distribution<float> steer(0.0f, 0.3f);
+
+        std::vector<float> queries(count * MOTION_FEATURE_COUNT);
+        for (uint32 q = 0; q < count; ++q)
+        {
+            float raw[MOTION_FEATURE_COUNT];
+            std::copy_n(&rows[pickEntry(random) * static_cast<size_t>(MOTION_FEATURE_COUNT)], MOTION_FEATURE_COUNT, raw);
+            for (uint32 d = MOTION_TRAJECTORY_POSITION_OFFSET; d < MOTION_FOOT_POSITION_OFFSET; ++d)
+            {
+                raw[d] += steer(random);
+            }
+            database.Normalize(raw, &queries[q * MOTION_FEATURE_COUNT]);
+        }
+        return queries;
+    }
+}
+
+GINA_BENCHMARK(MotionMatching)
+{
+    constexpr uint32 QUERY_COUNT = 64;
+
+    const Skeleton skeleton = CreateLocomotionSkeleton();
+    MotionFeatureSettings settings;
+    settings.leftFoot = skeleton.FindJoint("l_foot");
+    settings.rightFoot = skeleton.FindJoint("r_foot");
+
+    for (uint32 entryCount : { 16u * 1024u, 128u * 1024u, 1024u * 1024u })
+    {
+        std::vector<float> rows;
+        const auto start = std::chrono::steady_clock::now();
+        const MotionDatabase database = CreateDatabase(skeleton, settings, entryCount, rows);
+        const double buildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("  %u entries (%.1f hours at 30 Hz), extracted and built in %.2f s, %zu tree nodes\n",
+            entryCount, entryCount / SAMPLE_RATE / 3600.0f, buildSeconds, database.nodes.size());
+
+        const std::vector<float> queries = CreateQueries(database, rows, QUERY_COUNT, entryCount);
+
+        std::vector<MotionMatch> matches(QUERY_COUNT);
+        auto measure = [&](const char* name, bool useTree)
+        {
+            char label[64];
+            std::snprintf(label, sizeof(label), "%s, queries", name);
+            context.Measure(label, QUERY_COUNT, [&]()
+            {
+                MotionMatcher::SearchBatch(database, queries.data(), QUERY_COUNT, matches.data(), useTree);
+                DoNotOptimize(matches.back().cost);
+            });
+        };
+
+        detail::MotionMatchingDispatch::useScalar();
+        measure("brute force scalar", false);
+        measure("tree scalar", true);
+        detail::MotionMatchingDispatch::useAVX2();
+        measure("brute force AVX2", false);
+        measure("tree AVX2", true);
+    }
+
+    // Query count: a crowd asking every frame, threaded over the pool
+    std::vector<float> rows;
+    const MotionDatabase database = CreateDatabase(skeleton, settings, 128u * 1024u, rows);
+    ThreadPool threadPool;
+    for (uint32 queryCount : { 1u, 64u, 1024u })
+    {
+        const std::vector<float> queries = CreateQueries(database, rows, queryCount, queryCount);
+
+        std::vector<MotionMatch> matches(queryCount);
+        char label[64];
+        std::snprintf(label, sizeof(label), "%u queries on %u workers + caller, 128K entries", queryCount, threadPool.GetWorkerCount());
+        context.Measure(label, queryCount, [&]()
+        {
+            MotionMatcher::SearchBatch(database, queries.data(), queryCount, matches.data(), true, &threadPool);
+            DoNotOptimize(matches.back().cost);
+        });
+    }
+}
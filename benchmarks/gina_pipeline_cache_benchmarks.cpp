@@ -0,0 +1,92 @@
+#include "gina_benchmark.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "rhi/gina_pipeline_cache.h"
+
+using namespace gina;
+
+namespace
+{
+    // Half a millisecond per pipeline without a blob, a fifth of that with one; optimistic for a real driver
+    class SleepingPipelineCompiler final : public PipelineCompiler
+    {
+    public:
+        RHIPipelineHandle CreatePipeline(const PipelineDesc&, const std::vector<byte>& cachedBlob, std::vector<byte>& blob) override
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(cachedBlob.empty() ? 500 : 100));
+            blob.assign(64, 0);
+            return { m_nextPipeline++ };
+        }
+
+    private:
+        std::atomic<uint32> m_nextPipeline{ 0 };
+    };
+
+    PipelineDesc MakeDesc(uint32 material)
+    {
+        PipelineDesc desc;
+        desc.vertexShader = 1 + material % 8;
+        desc.pixelShader = 100 + material;
+        desc.rootSignature = 7;
+        desc.renderTargetCount = 3;
+        desc.renderTargetFormats[0] = RHIFormat::R8G8B8A8Srgb;
+        desc.renderTargetFormats[1] = RHIFormat::R16G16B16A16Float;
+        desc.renderTargetFormats[2] = RHIFormat::R8G8Unorm;
+        desc.depthFormat = RHIFormat::D32Float;
+        desc.raster.cullMode = material % 5 == 0 ? PipelineCullMode::None : PipelineCullMode::Back;
+        return desc;
+    }
+}
+
+// First frame of a level asking for every material's pipeline, without and with last run's cache
+GINA_BENCHMARK(PipelineCacheStartup)
+{
+    constexpr uint32 PIPELINE_COUNT = 200;
+
+    std::vector<PipelineDesc> descs;
+    for (uint32 i = 0; i < PIPELINE_COUNT; ++i)
+    {
+        descs.push_back(MakeDesc(i));
+    }
+
+    SleepingPipelineCompiler compiler;
+    BinaryWriter file;
+    PipelineCacheStats cold;
+    {
+        PipelineCache cache(compiler, 1);
+        for (const PipelineDesc& desc : descs)
+        {
+            DoNotOptimize(cache.GetPipeline(desc));
+        }
+        cold = cache.GetStats();
+        cache.Serialize(file);
+    }
+
+    PipelineCache cache(compiler, 1);
+    BinaryReader reader(file.GetBuffer());
+    cache.Deserialize(reader);
+    cache.BeginPrewarm(2);
+    cache.WaitForPrewarm();
+    for (const PipelineDesc& desc : descs)
+    {
+        DoNotOptimize(cache.GetPipeline(desc));
+    }
+    const PipelineCacheStats warm = cache.GetStats();
+
+    std::printf("  cold: %llu misses, %.1f ms stalled; warm: %llu hits, %llu misses, %.2f ms stalled, %.1f ms of hitches avoided\n",
+        static_cast<unsigned long long>(cold.misses), cold.stallTime, static_cast<unsigned long long>(warm.hits),
+        static_cast<unsigned long long>(warm.misses), warm.stallTime, warm.hitchTimeAvoided);
+
+    // Steady state: every draw hashes its description and finds the pipeline
+    context.Measure("cached lookups", PIPELINE_COUNT, [&]()
+    {
+        for (const PipelineDesc& desc : descs)
+        {
+            DoNotOptimize(cache.GetPipeline(desc));
+        }
+    });
+}
@@ -0,0 +1,122 @@
+#include "gina_benchmark.h"
+#include "gina_animation_fixtures.h"
+
+#include <algorithm>
+#include <random>
+
+#include "animation/gina_pose.h"
+#include "animation/gina_pose_cache.h"
+
+using namespace gina;
+
+GINA_BENCHMARK(PoseCacheCrowd)
+{
+    constexpr uint32 CHARACTER_COUNT = 10000;
+    constexpr uint32 CLIP_COUNT = 16;
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+    const Skeleton skeleton = SkeletonBuilder::Build(fixtures::CreateHumanoidJoints());
+    const uint32 jointCount = skeleton.GetJointCount();
+    std::vector<AnimationClip> clips;
+    for (uint32 c = 0; c < CLIP_COUNT; ++c)
+    {
+        clips.push_back(fixtures::CreateRandomClip(skeleton, 0.8f + 0.1f * c, c + 1));
+    }
+
+    // Characters on random clips and LODs, the nearest tenth at full detail. Crowds are usually spawned
+    // in groups sharing a phase; phaseVariations 0 gives every character its own.
+    struct Character
+    {
+        const AnimationClip* clip;
+        float phase;
+        uint32 lod;
+    };
+    auto createCrowd = [&](uint32 phaseVariations)
+    {
+        std::mt19937 random(11);
+        std::uniform_int_distribution<uint32> pickClip(0, CLIP_COUNT - 1);
+        std::uniform_real_distribution<float> pickPhase(0.0f, 2.0f);
+        std::uniform_int_distribution<uint32> pickVariation(0, std::max(phaseVariations, 1u) - 1);
+        std::uniform_int_distribution<uint32> pickLod(0, skeleton.GetLodCount() - 1);
+        std::vector<Character> characters(CHARACTER_COUNT);
+        for (uint32 i = 0; i < CHARACTER_COUNT; ++i)
+        {
+            const float phase = phaseVariations == 0 ? pickPhase(random) : 0.25f * pickVariation(random);
+            characters[i] = { &clips[pickClip(random)], phase, i < CHARACTER_COUNT / 10 ? 0 : pickLod(random) };
+        }
+        return characters;
+    };
+
+    std::vector<Transform> local(jointCount);
+    std::vector<Transform> model(jointCount);
+    std::vector<PoseHandle> handles(CHARACTER_COUNT);
+    float time = 0.0f;
+
+    auto measureEvaluation = [&](const std::vector<Character>& characters)
+    {
+        context.Measure("per character evaluation, characters", CHARACTER_COUNT, [&]()
+        {
+            time += DELTA_TIME;
+            for (const Character& character : characters)
+            {
+                const uint32 count = skeleton.GetLodJointCount(character.lod);
+                AnimationSampler::Sample(*character.clip, time + character.phase, true, count, local.data());
+                PoseOps::LocalToModel(skeleton, local.data(), count, model.data());
+                DoNotOptimize(model[0].translation.x);
+            }
+        });
+    };
+
+    auto measureCache = [&](const std::vector<Character>& characters, const char* label, float timeQuantum)
+    {
+        PoseCache cache(skeleton, { timeQuantum, 1 });
+        context.Measure(label, CHARACTER_COUNT, [&]()
+        {
+            time += DELTA_TIME;
+            cache.BeginFrame();
+            for (uint32 i = 0; i < CHARACTER_COUNT; ++i)
+            {
+                handles[i] = cache.Request(*characters[i].clip, time + characters[i].phase, true, characters[i].lod);
+            }
+            cache.Evaluate();
+            DoNotOptimize(cache.GetModelPose(handles.back())[0].translation.x);
+        });
+        std::printf("  %u distinct poses for %u characters\n", cache.GetEvaluatedCount(), CHARACTER_COUNT);
+    };
+
+    // Every character writes its own interpolated pose, as a consumer needing per character poses would
+    auto measureReducedRate = [&](const std::vector<Character>& characters, const char* label, float timeQuantum, uint32 updateInterval)
+    {
+        PoseCache cache(skeleton, { timeQuantum, updateInterval });
+        std::vector<ReducedRatePose> states(CHARACTER_COUNT);
+        context.Measure(label, CHARACTER_COUNT, [&]()
+        {
+            time += DELTA_TIME;
+            cache.BeginFrame();
+            for (uint32 i = 0; i < CHARACTER_COUNT; ++i)
+            {
+                handles[i] = cache.RequestReducedRate(states[i], i, *characters[i].clip, time + characters[i].phase, DELTA_TIME, true,
+                    characters[i].lod);
+            }
+            cache.Evaluate();
+            for (uint32 i = 0; i < CHARACTER_COUNT; ++i)
+            {
+                cache.ResolveReducedRate(states[i], handles[i], model.data());
+            }
+            DoNotOptimize(model[0].translation.x);
+        });
+    };
+
+    std::printf("  grouped crowd, 8 phases per clip\n");
+    const std::vector<Character> grouped = createCrowd(8);
+    measureEvaluation(grouped);
+    measureCache(grouped, "pose cache 1/30 s, characters", 1.0f / 30.0f);
+    measureCache(grouped, "pose cache 1/60 s, characters", 1.0f / 60.0f);
+
+    std::printf("  scattered crowd, random phases\n");
+    const std::vector<Character> scattered = createCrowd(0);
+    measureEvaluation(scattered);
+    measureCache(scattered, "pose cache 1/30 s, characters", 1.0f / 30.0f);
+    measureReducedRate(scattered, "every 4th frame, unshared, characters", 0.0f, 4);
+    measureReducedRate(scattered, "every 4th frame, pose cache 1/30 s, characters", 1.0f / 30.0f, 4);
+}
@@ -0,0 +1,83 @@
+#include "gina_benchmark.h"
+#include "gina_animation_fixtures.h"
+
+#include <random>
+
+#include "animation/gina_retarget.h"
+
+using namespace gina;
+
+GINA_BENCHMARK(RetargetCrowd)
+{
+    constexpr uint32 CHARACTER_COUNT = 1000;
+    constexpr uint32 CLIP_COUNT = 16;
+
+    // The target rig is a renamed humanoid with longer bones and its own bind orientations
+    const std::vector<SkeletonJointDesc> sourceJoints = fixtures::CreateHumanoidJoints();
+    std::vector<SkeletonJointDesc> targetJoints = sourceJoints;
+    for (uint32 i = 0; i < targetJoints.size(); ++i)
+    {
+        SkeletonJointDesc& joint = targetJoints[i];
+        joint.name = "rig:" + joint.name;
+        joint.bindPose.translation = joint.bindPose.translation * 1.15f;
+        joint.bindPose.rotation = quaternion::fromAxisAngle(float3(0.2f, 1.0f, 0.4f).normalized(), 0.3f * i);
+    }
+    const Skeleton source = SkeletonBuilder::Build(sourceJoints);
+    const Skeleton target = SkeletonBuilder::Build(targetJoints);
+    const RetargetMap map = RetargetMapBuilder::Build(source, target);
+    const uint32 targetCount = map.targetJointCount;
+
+    std::vector<AnimationClip> clips;
+    size_t clipBytes = 0;
+    for (uint32 c = 0; c < CLIP_COUNT; ++c)
+    {
+        clips.push_back(fixtures::CreateRandomClip(source, 0.8f + 0.1f * c, c + 1));
+        clipBytes += clips.back().frames.size() * sizeof(Transform);
+    }
+    std::printf("  %u of %u joints mapped, map %zu bytes, duplicating the %u clips for the rig %zu bytes\n",
+        map.GetMappedJointCount(), targetCount, map.GetMemoryUsage(), CLIP_COUNT, clipBytes);
+
+    std::mt19937 random(5);
+    std::uniform_int_distribution<uint32> pickClip(0, CLIP_COUNT - 1);
+    std::uniform_real_distribution<float> pickTime(0.0f, 1.0f);
+    std::vector<PoseStreams> sources(CHARACTER_COUNT);
+    std::vector<PoseStreams> targets(CHARACTER_COUNT);
+    std::vector<Transform> local(source.GetJointCount());
+    for (uint32 c = 0; c < CHARACTER_COUNT; ++c)
+    {
+        AnimationSampler::Sample(clips[pickClip(random)], pickTime(random), true, source.GetJointCount(), local.data());
+        sources[c].Resize(map.GetSourceSlotCount());
+        PoseOps::ToStreams(local.data(), source.GetJointCount(), sources[c]);
+        targets[c].Resize(targetCount);
+    }
+
+    context.Measure("retarget, joints", CHARACTER_COUNT * targetCount, [&]()
+    {
+        for (uint32 c = 0; c < CHARACTER_COUNT; ++c)
+        {
+            Retargeter::Retarget(map, sources[c], targets[c]);
+        }
+        DoNotOptimize(targets.back().rotationW[0]);
+    });
+
+    context.Measure("retarget scalar kernel, joints", CHARACTER_COUNT * targetCount, [&]()
+    {
+        for (uint32 c = 0; c < CHARACTER_COUNT; ++c)
+        {
+            Retargeter::FillSlots(map, sources[c]);
+            Retargeter::RetargetScalar(map, sources[c], targets[c], 0, targetCount);
+        }
+        DoNotOptimize(targets.back().rotationW[0]);
+    });
+
+    // Reference point: converting the retargeted streams back to transforms for passes that take them
+    std::vector<Transform> pose(targetCount);
+    context.Measure("streams to transforms, joints", CHARACTER_COUNT * targetCount, [&]()
+    {
+        for (uint32 c = 0; c < CHARACTER_COUNT; ++c)
+        {
+            PoseOps::FromStreams(targets[c], targetCount, pose.data());
+            DoNotOptimize(pose.back().rotation.w);
+        }
+    });
+}
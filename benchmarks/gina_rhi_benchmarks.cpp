@@ -0,0 +1,46 @@
+#include "gina_benchmark.h"
+
+#include "rhi/gina_null_rhi.h"
+
+using namespace gina;
+
+// CPU cost of recording and submitting a frame of draws through the RHI, on the null backend
+GINA_BENCHMARK(RHISubmission)
+{
+    constexpr uint32 DRAW_COUNT = 10000;
+
+    auto measure = [&](const char* label, bool recordCommands)
+    {
+        NullDeviceSettings settings;
+        settings.recordCommands = recordCommands;
+        NullDevice device(settings);
+
+        const RHIBufferHandle indices = device.CreateBuffer({ 1 << 20, RHIMemoryType::Default, false, "indices" });
+        std::unique_ptr<RHIFence> fence = device.CreateFence();
+        std::unique_ptr<RHICommandAllocator> allocator = device.CreateCommandAllocator(RHIQueueType::Graphics);
+        std::unique_ptr<RHICommandList> list = device.CreateCommandList(RHIQueueType::Graphics);
+        NullQueue& queue = device.GetNullQueue(RHIQueueType::Graphics);
+
+        context.Measure(label, DRAW_COUNT, [&]()
+        {
+            allocator->Reset();
+            list->Begin(*allocator);
+            list->SetIndexBuffer(indices, 0, 1 << 20, false);
+            for (uint32 i = 0; i < DRAW_COUNT; ++i)
+            {
+                const uint32 constants[] = { i, i * 3, i * 7, 1 };
+                list->SetConstants(0, constants, 4);
+                list->DrawIndexed(3000, 1, 0, 0, 0);
+            }
+            list->End();
+
+            RHICommandList* batch[] = { list.get() };
+            queue.Submit(batch, 1);
+            fence->WaitOnCPU(queue.Signal(*fence));
+            queue.ClearStream();
+        });
+    };
+
+    measure("record and submit, timing only, draws", false);
+    measure("record and submit, recorded stream, draws", true);
+}
@@ -0,0 +1,68 @@
+#include "gina_benchmark.h"
+#include "gina_animation_fixtures.h"
+
+#include <random>
+
+#include "animation/gina_root_motion.h"
+
+using namespace gina;
+
+GINA_BENCHMARK(RootMotionCrowd)
+{
+    constexpr uint32 CHARACTER_COUNT = 10000;
+    constexpr uint32 CLIP_COUNT = 16;
+    constexpr float TICK = 1.0f / 60.0f;
+
+    const Skeleton skeleton = SkeletonBuilder::Build(fixtures::CreateHumanoidJoints());
+    const uint32 jointCount = skeleton.GetJointCount();
+
+    std::vector<AnimationClip> clips;
+    std::vector<RootMotionTrack> tracks;
+    for (uint32 c = 0; c < CLIP_COUNT; ++c)
+    {
+        clips.push_back(fixtures::CreateRandomClip(skeleton, 0.8f + 0.1f * c, c + 1));
+        AnimationClip stripped = clips.back();
+        tracks.push_back(RootMotionExtractor::Extract(stripped));
+    }
+
+    std::mt19937 random(3);
+    std::uniform_int_distribution<uint32> pickClip(0, CLIP_COUNT - 1);
+    std::uniform_real_distribution<float> pickTime(0.0f, 10.0f);
+    std::vector<RootMotionQuery> queries(CHARACTER_COUNT);
+    for (RootMotionQuery& query : queries)
+    {
+        query.track = &tracks[pickClip(random)];
+        query.startTime = pickTime(random);
+        query.endTime = query.startTime + TICK;
+        query.loop = true;
+    }
+
+    std::printf("  root track %zu bytes per clip second, clip %zu bytes per second\n",
+        static_cast<size_t>(30 * (sizeof(float3) + sizeof(float))), static_cast<size_t>(30 * jointCount * sizeof(Transform)));
+
+    std::vector<RootMotionDelta> deltas(CHARACTER_COUNT);
+    context.Measure("root track deltas, characters", CHARACTER_COUNT, [&]()
+    {
+        RootMotionSampler::GetDeltas(queries.data(), CHARACTER_COUNT, deltas.data());
+        DoNotOptimize(deltas.back().yaw);
+    });
+
+    // What movement code does without root tracks: sample the pose at both times and diff the roots
+    std::vector<Transform> start(jointCount);
+    std::vector<Transform> end(jointCount);
+    auto measureSampled = [&](const char* label, uint32 sampledJoints)
+    {
+        context.Measure(label, CHARACTER_COUNT, [&]()
+        {
+            for (const RootMotionQuery& query : queries)
+            {
+                const AnimationClip& clip = clips[query.track - tracks.data()];
+                AnimationSampler::Sample(clip, query.startTime, true, sampledJoints, start.data());
+                AnimationSampler::Sample(clip, query.endTime, true, sampledJoints, end.data());
+                DoNotOptimize(start[0].rotation.conjugate().rotate(end[0].translation - start[0].translation));
+            }
+        });
+    };
+    measureSampled("full pose sampling, characters", jointCount);
+    measureSampled("root joint sampling, characters", 1);
+}
@@ -0,0 +1,136 @@
+#include "gina_benchmark.h"
+#include "gina_animation_fixtures.h"
+
+#include "animation/gina_pose.h"
+#include "animation/gina_skinning.h"
+#include "core/gina_cpu_features.h"
+
+using namespace gina;
+
+GINA_BENCHMARK(LinearBlendSkinning)
+{
+    constexpr uint32 VERTEX_COUNT = 64 * 1024;
+
+    const Skeleton skeleton = SkeletonBuilder::Build(fixtures::CreateHumanoidJoints());
+    const AnimationClip clip = fixtures::CreateRandomClip(skeleton, 1.0f, 1);
+    const SkinningData data = fixtures::CreateRandomSkinningData(skeleton, VERTEX_COUNT, 3);
+
+    const uint32 jointCount = skeleton.GetJointCount();
+    std::vector<Transform> local(jointCount);
+    std::vector<Transform> model(jointCount);
+    AnimationSampler::Sample(clip, 0.4f, true, jointCount, local.data());
+    PoseOps::LocalToModel(skeleton, local.data(), jointCount, model.data());
+
+    const std::vector<float3x4> inverseBind = Skinning::ComputeInverseBindMatrices(skeleton);
+    std::vector<float3x4> palette(jointCount);
+    Skinning::BuildPalette(skeleton, inverseBind, model.data(), 0, palette.data());
+
+    VertexStreams output;
+    output.Resize(VERTEX_COUNT, true);
+
+    // Skinned positions and normals per kernel, single-threaded
+    context.Measure("scalar, vertices", VERTEX_COUNT, [&]()
+    {
+        Skinning::SkinScalar(data, palette.data(), output, 0, VERTEX_COUNT);
+        DoNotOptimize(output.positionX[VERTEX_COUNT - 1]);
+    });
+
+#if defined(GINA_SSE2_ENABLED)
+    context.Measure("SSE2, vertices", VERTEX_COUNT, [&]()
+    {
+        Skinning::SkinSSE2(data, palette.data(), output, 0, VERTEX_COUNT);
+        DoNotOptimize(output.positionX[VERTEX_COUNT - 1]);
+    });
+
+    if (CpuFeatures::HasAVX2())
+    {
+        context.Measure("AVX2, vertices", VERTEX_COUNT, [&]()
+        {
+            Skinning::SkinAVX2(data, palette.data(), output, 0, VERTEX_COUNT);
+            DoNotOptimize(output.positionX[VERTEX_COUNT - 1]);
+        });
+    }
+#endif
+
+    // Best kernel split across every hardware thread
+    ThreadPool threadPool;
+    char label[64];
+    std::snprintf(label, sizeof(label), "threaded (%u workers + caller), vertices", threadPool.GetWorkerCount());
+    context.Measure(label, VERTEX_COUNT, [&]()
+    {
+        Skinning::Skin(data, palette.data(), output, &threadPool);
+        DoNotOptimize(output.positionX[VERTEX_COUNT - 1]);
+    });
+}
+
+GINA_BENCHMARK(DualQuaternionSkinning)
+{
+    constexpr uint32 VERTEX_COUNT = 64 * 1024;
+
+    const Skeleton skeleton = SkeletonBuilder::Build(fixtures::CreateHumanoidJoints());
+    const AnimationClip clip = fixtures::CreateRandomClip(skeleton, 1.0f, 1);
+    const SkinningData data = fixtures::CreateRandomSkinningData(skeleton, VERTEX_COUNT, 3);
+
+    const uint32 jointCount = skeleton.GetJointCount();
+    std::vector<Transform> local(jointCount);
+    std::vector<Transform> model(jointCount);
+    AnimationSampler::Sample(clip, 0.4f, true, jointCount, local.data());
+    PoseOps::LocalToModel(skeleton, local.data(), jointCount, model.data());
+
+    const std::vector<float3x4> inverseBindMatrices = Skinning::ComputeInverseBindMatrices(skeleton);
+    const std::vector<Transform> inverseBindTransforms = Skinning::ComputeInverseBindTransforms(skeleton);
+    std::vector<float3x4> matrices(jointCount);
+    std::vector<dualquaternion> dualQuaternions(jointCount);
+
+    // Per-frame palette cost for one character
+    context.Measure("matrix palette, joints", jointCount, [&]()
+    {
+        Skinning::BuildPalette(skeleton, inverseBindMatrices, model.data(), 0, matrices.data());
+        DoNotOptimize(matrices[jointCount - 1]);
+    });
+
+    context.Measure("dual quaternion palette scalar, joints", jointCount, [&]()
+    {
+        Skinning::ConvertPaletteScalar(inverseBindTransforms.data(), model.data(), jointCount, dualQuaternions.data());
+        DoNotOptimize(dualQuaternions[jointCount - 1]);
+    });
+
+    context.Measure("dual quaternion palette, joints", jointCount, [&]()
+    {
+        Skinning::BuildDualQuaternionPalette(skeleton, inverseBindTransforms, model.data(), 0, dualQuaternions.data());
+        DoNotOptimize(dualQuaternions[jointCount - 1]);
+    });
+
+    // Best kernel for this CPU, single-threaded, against linear blend skinning of the same mesh
+    VertexStreams output;
+    output.Resize(VERTEX_COUNT, true);
+
+    context.Measure("linear blend, vertices", VERTEX_COUNT, [&]()
+    {
+        Skinning::Skin(data, matrices.data(), output);
+        DoNotOptimize(output.positionX[VERTEX_COUNT - 1]);
+    });
+
+    context.Measure("dual quaternion scalar, vertices", VERTEX_COUNT, [&]()
+    {
+        Skinning::SkinDualQuaternionScalar(data, dualQuaternions.data(), output, 0, VERTEX_COUNT);
+        DoNotOptimize(output.positionX[VERTEX_COUNT - 1]);
+    });
+
+#if defined(GINA_SSE2_ENABLED)
+    context.Measure("dual quaternion SSE2, vertices", VERTEX_COUNT, [&]()
+    {
+        Skinning::SkinDualQuaternionSSE2(data, dualQuaternions.data(), output, 0, VERTEX_COUNT);
+        DoNotOptimize(output.positionX[VERTEX_COUNT - 1]);
+    });
+
+    if (CpuFeatures::HasAVX2())
+    {
+        context.Measure("dual quaternion AVX2, vertices", VERTEX_COUNT, [&]()
+        {
+            Skinning::SkinDualQuaternionAVX2(data, dualQuaternions.data(), output, 0, VERTEX_COUNT);
+            DoNotOptimize(output.positionX[VERTEX_COUNT - 1]);
+        });
+    }
+#endif
+}
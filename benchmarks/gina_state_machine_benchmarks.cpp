@@ -0,0 +1,154 @@
+#include "gina_benchmark.h"
+#include "gina_animation_fixtures.h"
+
+#include <random>
+
+#include "animation/gina_state_machine.h"
+#include "core/gina_action.h"
+
+using namespace gina;
+
+GINA_BENCHMARK(StateMachineCrowd)
+{
+    constexpr uint32 CHARACTER_COUNT = 1000;
+    constexpr uint32 STATE_COUNT = 512;
+    constexpr uint32 PARAMETER_COUNT = 32;
+    constexpr uint32 TRANSITIONS_PER_STATE = 6;
+    constexpr uint32 ANY_STATE_TRANSITIONS = 16;
+
+    const Skeleton skeleton = SkeletonBuilder::Build(fixtures::CreateHumanoidJoints());
+    const AnimationClip clip = fixtures::CreateRandomClip(skeleton, 1.0f, 1);
+    BlendTree tree;
+    tree.AddClip(&clip);
+
+    // Random graph; every transition reads two parameters with thresholds that rarely hold together
+    std::mt19937 random(11);
+    std::uniform_int_distribution<uint32> pickState(0, STATE_COUNT - 1);
+    std::uniform_int_distribution<uint32> pickParameter(0, PARAMETER_COUNT - 1);
+    std::uniform_real_distribution<float> pickThreshold(0.6f, 0.95f);
+
+    StateMachine machine;
+    for (uint32 p = 0; p < PARAMETER_COUNT; ++p)
+    {
+        machine.AddParameter("parameter" + std::to_string(p));
+    }
+    for (uint32 s = 0; s < STATE_COUNT; ++s)
+    {
+        machine.AddState("state" + std::to_string(s), &tree);
+    }
+
+    auto addConditions = [&](uint16 transition)
+    {
+        for (uint32 c = 0; c < 2; ++c)
+        {
+            machine.AddCondition(transition, static_cast<uint16>(pickParameter(random)), TransitionCompare::Greater, pickThreshold(random));
+        }
+    };
+    for (uint32 s = 0; s < STATE_COUNT; ++s)
+    {
+        for (uint32 t = 0; t < TRANSITIONS_PER_STATE; ++t)
+        {
+            addConditions(machine.AddTransition(static_cast<uint16>(s), static_cast<uint16>(pickState(random)), 0.2f));
+        }
+    }
+    for (uint32 t = 0; t < ANY_STATE_TRANSITIONS; ++t)
+    {
+        addConditions(machine.AddTransition(ANY_ANIMATION_STATE, static_cast<uint16>(pickState(random)), 0.2f));
+    }
+
+    std::vector<StateMachineInstance> instances(CHARACTER_COUNT);
+    for (StateMachineInstance& instance : instances)
+    {
+        instance.Initialize(machine);
+        StateMachineEvaluator::Update(instance, 0.0f);
+    }
+
+    // Two gameplay driven parameter changes per character per frame
+    constexpr uint32 FRAME_VARIATIONS = 64;
+    std::vector<float> values(FRAME_VARIATIONS * CHARACTER_COUNT * 2);
+    std::vector<uint16> changed(values.size());
+    std::uniform_real_distribution<float> pickValue(0.0f, 0.75f);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = pickValue(random);
+        changed[i] = static_cast<uint16>(pickParameter(random));
+    }
+
+    uint32 frame = 0;
+    uint32 transitionsTaken = 0;
+    context.Measure("update, no changes, characters", CHARACTER_COUNT, [&]()
+    {
+        for (StateMachineInstance& instance : instances)
+        {
+            transitionsTaken += StateMachineEvaluator::Update(instance, 1.0f / 60.0f) != INVALID_ANIMATION_TRANSITION;
+        }
+        DoNotOptimize(transitionsTaken);
+    });
+
+    context.Measure("update, 2 changes each, characters", CHARACTER_COUNT, [&]()
+    {
+        const size_t base = static_cast<size_t>(frame++ % FRAME_VARIATIONS) * CHARACTER_COUNT * 2;
+        for (uint32 character = 0; character < CHARACTER_COUNT; ++character)
+        {
+            StateMachineInstance& instance = instances[character];
+            instance.SetParameter(changed[base + character * 2], values[base + character * 2]);
+            instance.SetParameter(changed[base + character * 2 + 1], values[base + character * 2 + 1]);
+            transitionsTaken += StateMachineEvaluator::Update(instance, 1.0f / 60.0f) != INVALID_ANIMATION_TRANSITION;
+        }
+        DoNotOptimize(transitionsTaken);
+    });
+
+    // Typical frame: one character in ten sees a gameplay change
+    context.Measure("update, 10% of characters changed, characters", CHARACTER_COUNT, [&]()
+    {
+        const size_t base = static_cast<size_t>(frame++ % FRAME_VARIATIONS) * CHARACTER_COUNT * 2;
+        for (uint32 character = 0; character < CHARACTER_COUNT; ++character)
+        {
+            StateMachineInstance& instance = instances[character];
+            if ((character + frame) % 10 == 0)
+            {
+                instance.SetParameter(changed[base + character * 2], values[base + character * 2]);
+            }
+            transitionsTaken += StateMachineEvaluator::Update(instance, 1.0f / 60.0f) != INVALID_ANIMATION_TRANSITION;
+        }
+        DoNotOptimize(transitionsTaken);
+    });
+
+    std::vector<Action<uint16, float>> actions(CHARACTER_COUNT);
+    for (uint32 character = 0; character < CHARACTER_COUNT; ++character)
+    {
+        actions[character].Subscribe(&instances[character], &StateMachineInstance::SetParameter);
+    }
+
+    context.Measure("update, 2 changes each via Action, characters", CHARACTER_COUNT, [&]()
+    {
+        const size_t base = static_cast<size_t>(frame++ % FRAME_VARIATIONS) * CHARACTER_COUNT * 2;
+        for (uint32 character = 0; character < CHARACTER_COUNT; ++character)
+        {
+            actions[character].Invoke(changed[base + character * 2], values[base + character * 2]);
+            actions[character].Invoke(changed[base + character * 2 + 1], values[base + character * 2 + 1]);
+            transitionsTaken += StateMachineEvaluator::Update(instances[character], 1.0f / 60.0f) != INVALID_ANIMATION_TRANSITION;
+        }
+        DoNotOptimize(transitionsTaken);
+    });
+
+    // Reference: checking every transition of the current state and every any-state transition each frame
+    context.Measure("poll all transitions, characters", CHARACTER_COUNT, [&]()
+    {
+        uint32 satisfied = 0;
+        for (const StateMachineInstance& instance : instances)
+        {
+            for (uint16 transition : machine.anyStateTransitions)
+            {
+                satisfied += StateMachineEvaluator::IsSatisfied(machine, transition, instance.parameters.data());
+            }
+            for (uint16 transition : machine.states[instance.currentState].transitions)
+            {
+                satisfied += StateMachineEvaluator::IsSatisfied(machine, transition, instance.parameters.data());
+            }
+        }
+        DoNotOptimize(satisfied);
+    });
+
+    std::printf("  %u transitions taken over all updates\n", transitionsTaken);
+}
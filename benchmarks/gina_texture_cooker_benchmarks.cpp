@@ -0,0 +1,66 @@
+#include "gina_benchmark.h"
+
+#include <cmath>
+#include <vector>
+
+#include "asset/gina_texture_cooker.h"
+#include "texture/gina_block_compression.h"
+
+using namespace gina;
+
+namespace
+{
+    constexpr uint32 TEXTURE_SIZE = 512;
+
+    // Gradients, a soft pattern and per texel noise; worse than most real albedo for a block encoder
+    TextureImage MakeTexture(uint32 size)
+    {
+        TextureImage image{ size, size, std::vector<uint8>(static_cast<size_t>(size) * size * 4) };
+        uint32 noise = 12345;
+        for (uint32 y = 0; y < size; ++y)
+        {
+            for (uint32 x = 0; x < size; ++x)
+            {
+                noise = noise * 1664525u + 1013904223u;
+                const float pattern = 0.5f + 0.5f * std::sin(x * 0.05f) * std::cos(y * 0.07f);
+                uint8* texel = &image.texels[(static_cast<size_t>(y) * size + x) * 4];
+                texel[0] = static_cast<uint8>(pattern * 200.0f + (noise >> 28));
+                texel[1] = static_cast<uint8>(x * 255 / size);
+                texel[2] = static_cast<uint8>(y * 255 / size);
+                texel[3] = static_cast<uint8>(255 - (noise >> 29));
+            }
+        }
+        return image;
+    }
+}
+
+// Full cooks of a 512x512 texture with its mips per usage, on one thread and on the pool
+GINA_BENCHMARK(TextureCookThroughput)
+{
+    const TextureImage image = MakeTexture(TEXTURE_SIZE);
+    ThreadPool pool;
+    std::printf("  pool: %u threads with the caller\n", pool.GetWorkerCount() + 1);
+
+    const TextureCookUsage usages[] = { TextureCookUsage::Albedo, TextureCookUsage::Normal, TextureCookUsage::Mask };
+    const char* names[] = { "albedo BC7", "normal BC5", "mask BC4" };
+    for (uint32 i = 0; i < 3; ++i)
+    {
+        TextureCookSettings settings;
+        settings.usage = usages[i];
+        TextureCookReport report;
+        TextureCooker::Cook(image, settings, &pool, report);
+        std::printf("  %s: %u mips, %.1f KB -> %.1f KB, PSNR %.2f dB\n", names[i], report.mipLevels,
+            report.sourceBytes / 1024.0, report.cookedBytes / 1024.0, report.psnr);
+
+        // Items are source texels of every mip
+        const uint64 texels = report.sourceBytes / 4;
+        context.Measure(std::string(names[i]) + ", 1 thread", texels, [&]()
+        {
+            DoNotOptimize(TextureCooker::Cook(image, settings, nullptr, report));
+        });
+        context.Measure(std::string(names[i]) + ", pool", texels, [&]()
+        {
+            DoNotOptimize(TextureCooker::Cook(image, settings, &pool, report));
+        });
+    }
+}
@@ -0,0 +1,132 @@
+#include "gina_benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "asset/gina_texture_cooker.h"
+#include "rhi/gina_null_rhi.h"
+#include "texture/gina_texture_streamer.h"
+
+using namespace gina;
+
+namespace
+{
+    constexpr uint32 TEXTURE_SIZE = 1024;
+    constexpr uint32 TEXTURE_COUNT = 64;
+    constexpr uint32 FRAME_COUNT = 400;
+
+    // One cooked 1024x1024 BC4 texture stored under TEXTURE_COUNT names, so every read really goes to a file
+    std::vector<std::string> WriteTextures(const std::string& directory)
+    {
+        TextureImage image{ TEXTURE_SIZE, TEXTURE_SIZE, std::vector<uint8>(static_cast<size_t>(TEXTURE_SIZE) * TEXTURE_SIZE * 4) };
+        for (size_t i = 0; i < image.texels.size(); ++i)
+        {
+            image.texels[i] = static_cast<uint8>((i / 4) ^ (i / 4 / TEXTURE_SIZE));
+        }
+
+        TextureCookSettings settings;
+        settings.usage = TextureCookUsage::Mask;
+        TextureCookReport report;
+        const TextureAsset asset = TextureCooker::Cook(image, settings, nullptr, report);
+
+        std::filesystem::create_directories(directory);
+        std::vector<std::string> fileNames;
+        for (uint32 i = 0; i < TEXTURE_COUNT; ++i)
+        {
+            fileNames.push_back(directory + "/texture" + std::to_string(i) + ".gtex");
+            TextureAssetSerializer::Save(fileNames.back(), asset);
+        }
+        return fileNames;
+    }
+}
+
+// A camera flying down a corridor of 64 textured walls, each 1024x1024, with a quarter of the memory they would take in full
+GINA_BENCHMARK(TextureStreamingCorridor)
+{
+    const std::string directory = (std::filesystem::temp_directory_path() / "gina_texture_streaming").string();
+    const std::vector<std::string> fileNames = WriteTextures(directory);
+
+    NullDeviceSettings deviceSettings;
+    deviceSettings.recordCommands = false;
+    NullDevice device(deviceSettings);
+    FrameRing frames(device);
+    std::unique_ptr<RHICommandList> list = device.CreateCommandList(RHIQueueType::Graphics);
+
+    TextureStreamerSettings settings;
+    uint64 fullBytes = 0;
+    {
+        TextureAsset header;
+        uint64 dataOffset = 0;
+        TextureAssetSerializer::LoadHeader(fileNames[0], header, dataOffset);
+        for (const TextureMip& mip : header.mips)
+        {
+            fullBytes += mip.size;
+        }
+    }
+    settings.memoryBudget = fullBytes * TEXTURE_COUNT / 4;
+    TextureStreamer streamer(device, frames, settings);
+
+    std::vector<uint32> textures;
+    for (const std::string& fileName : fileNames)
+    {
+        textures.push_back(streamer.AddTexture(fileName));
+    }
+
+    // Walls every 10 m; the ones within 40 m ahead are visible, at a 1000 pixel screen size from 1 m away
+    uint64 peakWanted = 0;
+    double slowestUpdate = 0.0;
+    auto runFrame = [&](uint32 frame)
+    {
+        const float camera = frame * 1.6f;
+        for (uint32 i = 0; i < TEXTURE_COUNT; ++i)
+        {
+            const float distance = i * 10.0f - camera;
+            if (distance > 0.0f && distance < 40.0f)
+            {
+                const float pixels = 1000.0f / std::max(distance, 1.0f);
+                streamer.RequestMip(textures[i], ComputeStreamingMip(TEXTURE_SIZE, TEXTURE_SIZE, pixels, pixels));
+            }
+        }
+
+        FrameContext& context = frames.BeginFrame();
+        list->Begin(*context.allocator);
+        const auto start = std::chrono::steady_clock::now();
+        streamer.Update(*list);
+        slowestUpdate = std::max(slowestUpdate, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        list->End();
+        RHICommandList* lists[] = { list.get() };
+        device.GetQueue(RHIQueueType::Graphics).Submit(lists, 1);
+        frames.EndFrame();
+        peakWanted = std::max(peakWanted, streamer.GetStats().wantedBytes);
+    };
+
+    // The rest of each frame is a 2 ms sleep, leaving the I/O threads time to read
+    for (uint32 frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        runFrame(frame);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    const TextureStreamerStats& stats = streamer.GetStats();
+    std::printf("  all mips %.1f MB, budget %.1f MB, peak wanted %.1f MB, peak resident %.1f MB\n",
+        fullBytes * TEXTURE_COUNT / 1048576.0, settings.memoryBudget / 1048576.0, peakWanted / 1048576.0,
+        stats.peakResidentBytes / 1048576.0);
+    std::printf("  %llu loads, %llu cancelled, %llu deferred for memory, %llu mips evicted, %.1f MB read, %.2f ms average load, %.2f ms slowest update\n",
+        static_cast<unsigned long long>(stats.loadsCompleted), static_cast<unsigned long long>(stats.loadsCancelled),
+        static_cast<unsigned long long>(stats.budgetDeferrals), static_cast<unsigned long long>(stats.evictedMips),
+        stats.bytesRead / 1048576.0, stats.loadsCompleted > 0 ? stats.loadTime / stats.loadsCompleted : 0.0, slowestUpdate);
+
+    // Steady state: the camera parked, every request satisfied
+    streamer.WaitForLoads();
+    context.Measure("update, 64 textures, nothing to load", TEXTURE_COUNT, [&]()
+    {
+        runFrame(FRAME_COUNT);
+    });
+
+    std::filesystem::remove_all(directory);
+}
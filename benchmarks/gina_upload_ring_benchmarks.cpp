@@ -0,0 +1,62 @@
+#include "gina_benchmark.h"
+
+#include <cstring>
+#include <vector>
+
+#include "rhi/gina_frame_ring.h"
+#include "rhi/gina_null_rhi.h"
+#include "rhi/gina_upload_ring.h"
+
+using namespace gina;
+
+// Per frame upload of draw constants and 64 joint skinning palettes, through the ring and with a buffer per draw
+GINA_BENCHMARK(UploadRingThroughput)
+{
+    constexpr uint32 DRAW_COUNT = 5000;
+    constexpr uint32 CONSTANTS_SIZE = 64;
+    constexpr uint32 PALETTE_SIZE = 64 * 48;    // 3x4 float matrices
+
+    NullDeviceSettings settings;
+    settings.recordCommands = false;
+    NullDevice device(settings);
+    std::vector<byte> constants(CONSTANTS_SIZE, 1);
+    std::vector<byte> palette(PALETTE_SIZE, 2);
+    const uint64 frameBytes = DRAW_COUNT * (CONSTANTS_SIZE + PALETTE_SIZE);
+
+    {
+        FrameRing frames(device, { 3 });
+        UploadRing ring(device, frames.GetFence(), 64 << 20);
+        const double seconds = context.Measure("upload ring, draws", DRAW_COUNT, [&]()
+        {
+            frames.BeginFrame();
+            ring.BeginFrame();
+            for (uint32 i = 0; i < DRAW_COUNT; ++i)
+            {
+                DoNotOptimize(ring.Upload(constants.data(), CONSTANTS_SIZE).offset);
+                DoNotOptimize(ring.Upload(palette.data(), PALETTE_SIZE).offset);
+            }
+            ring.EndFrame(frames.GetCurrentFenceValue());
+            frames.EndFrame();
+        });
+        std::printf("  %.2f GB/s, peak ring use %.1f MB of %.1f MB, %llu stalls\n", frameBytes / seconds * 1e-9,
+            ring.GetStats().peakUsedSize / 1048576.0, ring.GetAllocator().GetCapacity() / 1048576.0,
+            static_cast<unsigned long long>(ring.GetStats().stalls));
+    }
+
+    // The alternative the ring replaces: create, map and release an upload buffer for every piece of data
+    FrameRing frames(device, { 3 });
+    context.Measure("buffer per upload, draws", DRAW_COUNT, [&]()
+    {
+        frames.BeginFrame();
+        for (uint32 i = 0; i < DRAW_COUNT; ++i)
+        {
+            for (const std::vector<byte>* data : { &constants, &palette })
+            {
+                const RHIBufferHandle buffer = device.CreateBuffer({ data->size(), RHIMemoryType::Upload, false, "" });
+                std::memcpy(device.Map(buffer), data->data(), data->size());
+                frames.DeferRelease(buffer);
+            }
+        }
+        frames.EndFrame();
+    });
+}
@@ -0,0 +1,75 @@
+#include "animation/gina_animation_clip.h"
+
+#include <algorithm>
+
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    void AnimationEventTrack::Add(const AnimationEvent& event)
+    {
+        events.insert(events.begin() + UpperBound(event.time), event);
+    }
+
+    uint32 AnimationEventTrack::LowerBound(float time) const noexcept
+    {
+        const auto it = std::lower_bound(events.begin(), events.end(), time,
+            [](const AnimationEvent& event, float t) { return event.time < t; });
+        return static_cast<uint32>(it - events.begin());
+    }
+
+    uint32 AnimationEventTrack::UpperBound(float time) const noexcept
+    {
+        const auto it = std::upper_bound(events.begin(), events.end(), time,
+            [](float t, const AnimationEvent& event) { return t < event.time; });
+        return static_cast<uint32>(it - events.begin());
+    }
+
+    void AnimationClip::RemapJoints(const std::vector<uint16>& newIndices)
+    {
+        GINA_ASSERT_MSG(newIndices.size() == jointCount, "Joint remap size mismatch");
+
+        std::vector<Transform> remapped(frames.size());
+        for (size_t frame = 0; frame < frames.size(); frame += jointCount)
+        {
+            for (uint32 joint = 0; joint < jointCount; ++joint)
+            {
+                remapped[frame + newIndices[joint]] = frames[frame + joint];
+            }
+        }
+        frames = std::move(remapped);
+    }
+
+    void AnimationSampler::Sample(const AnimationClip& clip, float time, bool loop, uint32 jointCount, Transform* local) noexcept
+    {
+        GINA_ASSERT_MSG(jointCount <= clip.jointCount, "Sampling more joints than the clip animates");
+
+        const uint32 frameCount = clip.GetFrameCount();
+        if (frameCount == 0)
+        {
+            return;
+        }
+
+        if (loop && clip.duration > 0.0f)
+        {
+            time = std::fmod(time, clip.duration);
+            time = time < 0.0f ? time + clip.duration : time;
+        }
+        else
+        {
+            time = std::clamp(time, 0.0f, clip.duration);
+        }
+
+        const float frame = time * clip.sampleRate;
+        const uint32 frame0 = std::min(static_cast<uint32>(frame), frameCount - 1);
+        const uint32 frame1 = std::min(frame0 + 1, frameCount - 1);
+        const float alpha = frame - static_cast<float>(frame0);
+
+        const Transform* keys0 = &clip.frames[static_cast<size_t>(frame0) * clip.jointCount];
+        const Transform* keys1 = &clip.frames[static_cast<size_t>(frame1) * clip.jointCount];
+        for (uint32 joint = 0; joint < jointCount; ++joint)
+        {
+            local[joint] = Blend(keys0[joint], keys1[joint], alpha);
+        }
+    }
+}
@@ -0,0 +1,202 @@
+#include "animation/gina_animation_event.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gina
+{
+    namespace
+    {
+        constexpr uint32 QUERY_GRAIN_SIZE = 64;
+
+        /**
+         * Calls visit(first, last, backwards, cycleStart, cycles) for every run of track indices crossed
+         *
+         * A run covers events [first, last) of the cycle starting at cycleStart on the unwrapped timeline,
+         * repeated for cycles consecutive cycles (going back in time when playing backwards). Runs come in
+         * playback order, so counting needs no iteration over whole cycles and emitting just walks them.
+         */
+        template <typename Visit>
+        void VisitCrossedRuns(const AnimationClip& clip, float previous, float current, bool loop, Visit&& visit)
+        {
+            const AnimationEventTrack& track = clip.events;
+            const uint32 eventCount = track.GetCount();
+            const float duration = clip.duration;
+            if (eventCount == 0 || previous == current)
+            {
+                return;
+            }
+
+            const bool backwards = current < previous;
+            if (!loop || duration <= 0.0f)
+            {
+                const float a = std::clamp(previous, 0.0f, std::max(duration, 0.0f));
+                const float b = std::clamp(current, 0.0f, std::max(duration, 0.0f));
+                if (backwards)
+                {
+                    visit(track.LowerBound(b), track.LowerBound(a), true, 0.0f, 1u);
+                }
+                else
+                {
+                    visit(track.UpperBound(a), track.UpperBound(b), false, 0.0f, 1u);
+                }
+                return;
+            }
+
+            float previousCycle = std::floor(previous / duration);
+            const float currentCycle = std::floor(current / duration);
+            float a = std::clamp(previous - previousCycle * duration, 0.0f, duration);
+            const float b = std::clamp(current - currentCycle * duration, 0.0f, duration);
+
+            // Going back from a cycle boundary starts at the end of the cycle before, where the window
+            // [current, previous) leaves out an event at the duration just as it does one at 0
+            if (backwards && a == 0.0f)
+            {
+                previousCycle -= 1.0f;
+                a = duration;
+            }
+            const float previousStart = previousCycle * duration;
+            const float currentStart = currentCycle * duration;
+
+            if (previousCycle == currentCycle)
+            {
+                if (backwards)
+                {
+                    visit(track.LowerBound(b), track.LowerBound(a), true, previousStart, 1u);
+                }
+                else
+                {
+                    visit(track.UpperBound(a), track.UpperBound(b), false, previousStart, 1u);
+                }
+                return;
+            }
+
+            const uint32 wholeCycles = static_cast<uint32>(std::fabs(currentCycle - previousCycle)) - 1;
+            if (backwards)
+            {
+                visit(0u, track.LowerBound(a), true, previousStart, 1u);
+                if (wholeCycles > 0)
+                {
+                    visit(0u, eventCount, true, previousStart - duration, wholeCycles);
+                }
+                visit(track.LowerBound(b), eventCount, true, currentStart, 1u);
+            }
+            else
+            {
+                visit(track.UpperBound(a), eventCount, false, previousStart, 1u);
+                if (wholeCycles > 0)
+                {
+                    visit(0u, eventCount, false, previousStart + duration, wholeCycles);
+                }
+                visit(0u, track.UpperBound(b), false, currentStart, 1u);
+            }
+        }
+
+        void EmitEvents(const AnimationClip& clip, float previous, float current, bool loop, uint32 source, FiredAnimationEvent* output)
+        {
+            const std::vector<AnimationEvent>& events = clip.events.events;
+            VisitCrossedRuns(clip, previous, current, loop, [&](uint32 first, uint32 last, bool backwards, float cycleStart, uint32 cycles)
+            {
+                for (uint32 cycle = 0; cycle < cycles; ++cycle)
+                {
+                    const float start = backwards ? cycleStart - cycle * clip.duration : cycleStart + cycle * clip.duration;
+                    for (uint32 i = 0; i < last - first; ++i)
+                    {
+                        const AnimationEvent& event = events[backwards ? last - 1 - i : first + i];
+                        output->event = event;
+                        output->time = start + event.time;
+                        output->source = source;
+                        ++output;
+                    }
+                }
+            });
+        }
+    }
+
+    void AnimationEventBuffer::Clear() noexcept
+    {
+        events.clear();
+        offsets.clear();
+    }
+
+    uint32 AnimationEventSampler::CountEvents(const AnimationClip& clip, float previousTime, float currentTime, bool loop) noexcept
+    {
+        uint32 count = 0;
+        VisitCrossedRuns(clip, previousTime, currentTime, loop, [&](uint32 first, uint32 last, bool, float, uint32 cycles)
+        {
+            count += (last - first) * cycles;
+        });
+        return count;
+    }
+
+    void AnimationEventSampler::CollectEvents(const AnimationClip& clip, float previousTime, float currentTime, bool loop, uint32 source,
+        AnimationEventBuffer& buffer)
+    {
+        const uint32 first = buffer.GetCount();
+        buffer.events.resize(first + CountEvents(clip, previousTime, currentTime, loop));
+        EmitEvents(clip, previousTime, currentTime, loop, source, buffer.events.data() + first);
+
+        if (buffer.offsets.empty())
+        {
+            buffer.offsets.push_back(0);
+        }
+        buffer.offsets.push_back(buffer.GetCount());
+    }
+
+    void AnimationEventSampler::CollectBatch(const AnimationEventQuery* queries, uint32 count, AnimationEventBuffer& buffer,
+        ThreadPool* threadPool)
+    {
+        buffer.offsets.resize(count + 1);
+        buffer.offsets[0] = 0;
+
+        auto countRange = [&](uint32 begin, uint32 end)
+        {
+            for (uint32 q = begin; q < end; ++q)
+            {
+                const AnimationEventQuery& query = queries[q];
+                buffer.offsets[q + 1] = CountEvents(*query.clip, query.previousTime, query.currentTime, query.loop);
+            }
+        };
+
+        auto emitRange = [&](uint32 begin, uint32 end)
+        {
+            for (uint32 q = begin; q < end; ++q)
+            {
+                const AnimationEventQuery& query = queries[q];
+                EmitEvents(*query.clip, query.previousTime, query.currentTime, query.loop, query.source, buffer.events.data() + buffer.offsets[q]);
+            }
+        };
+
+        if (threadPool == nullptr)
+        {
+            countRange(0, count);
+        }
+        else
+        {
+            threadPool->ParallelFor(count, QUERY_GRAIN_SIZE, countRange);
+        }
+
+        for (uint32 q = 0; q < count; ++q)
+        {
+            buffer.offsets[q + 1] += buffer.offsets[q];
+        }
+        buffer.events.resize(buffer.offsets[count]);
+
+        if (threadPool == nullptr)
+        {
+            emitRange(0, count);
+        }
+        else
+        {
+            threadPool->ParallelFor(count, QUERY_GRAIN_SIZE, emitRange);
+        }
+    }
+
+    void AnimationEventSampler::Dispatch(const AnimationEventBuffer& buffer, AnimationEventAction& action)
+    {
+        if (buffer.GetCount() > 0)
+        {
+            action.Invoke(buffer.events.data(), buffer.GetCount());
+        }
+    }
+}
@@ -0,0 +1,262 @@
+#include "animation/gina_blend_space.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    namespace
+    {
+        struct Point
+        {
+            double x, y;
+        };
+
+        using Triangle = std::array<uint32, 3>;
+
+        double Orientation(const Point& a, const Point& b, const Point& c) noexcept
+        {
+            return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+        }
+
+        // True when p lies strictly inside the circumcircle of the counter-clockwise triangle abc
+        bool InCircumcircle(const Point& a, const Point& b, const Point& c, const Point& p) noexcept
+        {
+            const double adx = a.x - p.x, ady = a.y - p.y;
+            const double bdx = b.x - p.x, bdy = b.y - p.y;
+            const double cdx = c.x - p.x, cdy = c.y - p.y;
+            const double determinant =
+                (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy) -
+                (bdx * bdx + bdy * bdy) * (adx * cdy - cdx * ady) +
+                (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+            return determinant > 0.0;
+        }
+
+        void ComputeBarycentric(const float2& a, const float2& b, const float2& c, const float2& point, float* barycentric) noexcept
+        {
+            const float2 edge0 = b - a;
+            const float2 edge1 = c - a;
+            const float2 offset = point - a;
+            const float d00 = dot(edge0, edge0);
+            const float d01 = dot(edge0, edge1);
+            const float d11 = dot(edge1, edge1);
+            const float d20 = dot(offset, edge0);
+            const float d21 = dot(offset, edge1);
+            const float denominator = d00 * d11 - d01 * d01;
+
+            barycentric[1] = (d11 * d20 - d01 * d21) / denominator;
+            barycentric[2] = (d00 * d21 - d01 * d20) / denominator;
+            barycentric[0] = 1.0f - barycentric[1] - barycentric[2];
+        }
+
+        float MinCoordinate(const float* barycentric, uint32& index) noexcept
+        {
+            index = 0;
+            for (uint32 i = 1; i < 3; ++i)
+            {
+                index = barycentric[i] < barycentric[index] ? i : index;
+            }
+            return barycentric[index];
+        }
+
+        constexpr float INSIDE_TOLERANCE = -1e-5f;
+    }
+
+    /**
+     * Bowyer-Watson insertion: each sample removes the triangles whose circumcircle contains it and
+     * fans the cavity boundary to it. A large enclosing triangle seeds the process and every triangle
+     * touching it is dropped at the end. Blendspaces hold a few dozen samples, so the quadratic
+     * cavity search is irrelevant offline.
+     */
+    BlendSpaceTriangulation BlendSpaceTriangulator::Triangulate(const std::vector<float2>& positions)
+    {
+        BlendSpaceTriangulation triangulation;
+        const uint32 sampleCount = static_cast<uint32>(positions.size());
+        if (sampleCount < 3)
+        {
+            return triangulation;
+        }
+
+        std::vector<Point> points;
+        points.reserve(sampleCount + 3);
+        float2 minimum = positions[0];
+        float2 maximum = positions[0];
+        for (const float2& position : positions)
+        {
+            points.push_back({ position.x, position.y });
+            minimum = float2(std::min(minimum.x, position.x), std::min(minimum.y, position.y));
+            maximum = float2(std::max(maximum.x, position.x), std::max(maximum.y, position.y));
+        }
+
+        const double extent = std::max({ static_cast<double>(maximum.x - minimum.x), static_cast<double>(maximum.y - minimum.y), 1e-6 });
+        const double centerX = 0.5 * (minimum.x + maximum.x);
+        const double centerY = 0.5 * (minimum.y + maximum.y);
+        points.push_back({ centerX - 100.0 * extent, centerY - 50.0 * extent });
+        points.push_back({ centerX + 100.0 * extent, centerY - 50.0 * extent });
+        points.push_back({ centerX, centerY + 100.0 * extent });
+
+        std::vector<Triangle> triangles = { { sampleCount, sampleCount + 1, sampleCount + 2 } };
+        std::vector<std::array<uint32, 2>> edges;
+
+        for (uint32 sample = 0; sample < sampleCount; ++sample)
+        {
+            const Point& point = points[sample];
+            edges.clear();
+
+            for (size_t t = 0; t < triangles.size();)
+            {
+                const Triangle& triangle = triangles[t];
+                if (!InCircumcircle(points[triangle[0]], points[triangle[1]], points[triangle[2]], point))
+                {
+                    ++t;
+                    continue;
+                }
+
+                for (uint32 e = 0; e < 3; ++e)
+                {
+                    edges.push_back({ triangle[e], triangle[(e + 1) % 3] });
+                }
+                triangles[t] = triangles.back();
+                triangles.pop_back();
+            }
+
+            // Edges shared by two removed triangles appear once in each direction and are interior to the cavity
+            for (size_t i = 0; i < edges.size(); ++i)
+            {
+                bool shared = false;
+                for (size_t j = 0; j < edges.size() && !shared; ++j)
+                {
+                    shared = edges[j][0] == edges[i][1] && edges[j][1] == edges[i][0];
+                }
+
+                if (!shared)
+                {
+                    triangles.push_back({ edges[i][0], edges[i][1], sample });
+                }
+            }
+        }
+
+        for (const Triangle& triangle : triangles)
+        {
+            const bool touchesEnclosing = triangle[0] >= sampleCount || triangle[1] >= sampleCount || triangle[2] >= sampleCount;
+            if (touchesEnclosing || Orientation(points[triangle[0]], points[triangle[1]], points[triangle[2]]) <= 0.0)
+            {
+                continue;
+            }
+
+            for (uint32 vertex : triangle)
+            {
+                triangulation.triangles.push_back(static_cast<uint16>(vertex));
+            }
+        }
+
+        // Neighbor across the edge opposite vertex e shares that edge in the opposite direction
+        const uint32 triangleCount = triangulation.GetTriangleCount();
+        const std::vector<uint16>& indices = triangulation.triangles;
+        triangulation.neighbors.assign(indices.size(), INVALID_BLEND_TRIANGLE);
+        for (uint32 t = 0; t < triangleCount; ++t)
+        {
+            for (uint32 e = 0; e < 3; ++e)
+            {
+                const uint16 from = indices[t * 3 + (e + 1) % 3];
+                const uint16 to = indices[t * 3 + (e + 2) % 3];
+                for (uint32 other = 0; other < triangleCount; ++other)
+                {
+                    for (uint32 k = 0; k < 3 && other != t; ++k)
+                    {
+                        if (indices[other * 3 + k] == to && indices[other * 3 + (k + 1) % 3] == from)
+                        {
+                            triangulation.neighbors[t * 3 + e] = static_cast<uint16>(other);
+                        }
+                    }
+                }
+            }
+        }
+
+        return triangulation;
+    }
+
+    BlendSpaceLocation BlendSpaceTriangulator::Locate(const BlendSpaceTriangulation& triangulation, const std::vector<float2>& positions,
+        const float2& point, uint16 startTriangle) noexcept
+    {
+        BlendSpaceLocation location;
+        const uint32 triangleCount = triangulation.GetTriangleCount();
+        if (triangleCount == 0)
+        {
+            return location;
+        }
+
+        const uint16* indices = triangulation.triangles.data();
+        auto barycentricOf = [&](uint32 triangle, float* barycentric)
+        {
+            ComputeBarycentric(positions[indices[triangle * 3]], positions[indices[triangle * 3 + 1]],
+                positions[indices[triangle * 3 + 2]], point, barycentric);
+        };
+
+        // Visibility walk: step across the edge facing the point until it is inside. Small parameter
+        // changes between frames leave the point in the same or an adjacent triangle.
+        uint32 triangle = startTriangle < triangleCount ? startTriangle : 0;
+        for (uint32 step = 0; step < triangleCount; ++step)
+        {
+            uint32 edge = 0;
+            barycentricOf(triangle, location.barycentric);
+            if (MinCoordinate(location.barycentric, edge) >= INSIDE_TOLERANCE)
+            {
+                location.triangle = static_cast<uint16>(triangle);
+                return location;
+            }
+
+            const uint16 next = triangulation.neighbors[triangle * 3 + edge];
+            if (next == INVALID_BLEND_TRIANGLE)
+            {
+                break;
+            }
+            triangle = next;
+        }
+
+        // The walk left through the hull; the point may still be inside if the hull is not convex
+        for (uint32 t = 0; t < triangleCount; ++t)
+        {
+            uint32 edge = 0;
+            barycentricOf(t, location.barycentric);
+            if (MinCoordinate(location.barycentric, edge) >= INSIDE_TOLERANCE)
+            {
+                location.triangle = static_cast<uint16>(t);
+                return location;
+            }
+        }
+
+        // Outside: clamp to the closest point on the hull edges
+        float bestDistance = std::numeric_limits<float>::max();
+        for (uint32 t = 0; t < triangleCount; ++t)
+        {
+            for (uint32 e = 0; e < 3; ++e)
+            {
+                if (triangulation.neighbors[t * 3 + e] != INVALID_BLEND_TRIANGLE)
+                {
+                    continue;
+                }
+
+                const float2& from = positions[indices[t * 3 + (e + 1) % 3]];
+                const float2& to = positions[indices[t * 3 + (e + 2) % 3]];
+                const float2 edgeVector = to - from;
+                const float lengthSquared = std::max(dot(edgeVector, edgeVector), std::numeric_limits<float>::min());
+                const float along = std::clamp(dot(point - from, edgeVector) / lengthSquared, 0.0f, 1.0f);
+                const float distanceSquared = (point - lerp(from, to, along)).lengthSquared();
+                if (distanceSquared < bestDistance)
+                {
+                    bestDistance = distanceSquared;
+                    location.triangle = static_cast<uint16>(t);
+                    location.barycentric[e] = 0.0f;
+                    location.barycentric[(e + 1) % 3] = 1.0f - along;
+                    location.barycentric[(e + 2) % 3] = along;
+                }
+            }
+        }
+
+        return location;
+    }
+}
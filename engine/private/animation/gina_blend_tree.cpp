@@ -0,0 +1,345 @@
+#include "animation/gina_blend_tree.h"
+
+#include <algorithm>
+
+#include "animation/gina_pose.h"
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    uint16 BlendTree::AddParameter(const std::string& name)
+    {
+        GINA_ASSERT_MSG(FindParameter(name) == INVALID_BLEND_PARAMETER, "Duplicate blend tree parameter");
+        parameterNames.push_back(name);
+        return static_cast<uint16>(parameterNames.size() - 1);
+    }
+
+    uint16 BlendTree::FindParameter(const std::string& name) const noexcept
+    {
+        for (uint32 i = 0; i < parameterNames.size(); ++i)
+        {
+            if (parameterNames[i] == name)
+            {
+                return static_cast<uint16>(i);
+            }
+        }
+        return INVALID_BLEND_PARAMETER;
+    }
+
+    uint16 BlendTree::AddNode(BlendNode&& node)
+    {
+        GINA_ASSERT_MSG(nodes.size() < INVALID_BLEND_NODE, "Too many blend tree nodes");
+        for ([[maybe_unused]] uint16 child : node.children)
+        {
+            GINA_ASSERT_MSG(child < nodes.size(), "Blend tree children must be added before their parent");
+        }
+
+        nodes.push_back(std::move(node));
+        root = static_cast<uint16>(nodes.size() - 1);
+        return root;
+    }
+
+    uint16 BlendTree::AddClip(const AnimationClip* clip, float speed, bool loop)
+    {
+        GINA_ASSERT_MSG(clip != nullptr, "Clip node without a clip");
+
+        BlendNode node;
+        node.type = BlendNodeType::Clip;
+        node.clip = clip;
+        node.speed = speed;
+        node.loop = loop;
+        return AddNode(std::move(node));
+    }
+
+    uint16 BlendTree::AddBlend(uint16 a, uint16 b, uint16 parameter)
+    {
+        BlendNode node;
+        node.type = BlendNodeType::Blend;
+        node.children = { a, b };
+        node.parameter = parameter;
+        return AddNode(std::move(node));
+    }
+
+    uint16 BlendTree::AddAdditive(uint16 base, uint16 additive, uint16 parameter)
+    {
+        BlendNode node;
+        node.type = BlendNodeType::Additive;
+        node.children = { base, additive };
+        node.parameter = parameter;
+        return AddNode(std::move(node));
+    }
+
+    uint16 BlendTree::AddMask(uint16 base, uint16 overlay, std::vector<float> jointWeights, uint16 parameter)
+    {
+        BlendNode node;
+        node.type = BlendNodeType::Mask;
+        node.children = { base, overlay };
+        node.jointWeights = std::move(jointWeights);
+        node.parameter = parameter;
+        return AddNode(std::move(node));
+    }
+
+    uint16 BlendTree::AddBlendSpace1D(std::vector<uint16> children, const std::vector<float>& positions, uint16 parameter)
+    {
+        GINA_ASSERT_MSG(!children.empty() && children.size() == positions.size(), "Blendspace needs one position per child");
+        GINA_ASSERT_MSG(children.size() <= MAX_BLENDSPACE_SAMPLES, "Too many blendspace samples");
+        GINA_ASSERT_MSG(std::is_sorted(positions.begin(), positions.end()), "1D blendspace positions must be sorted");
+
+        BlendNode node;
+        node.type = BlendNodeType::BlendSpace1D;
+        node.children = std::move(children);
+        node.parameter = parameter;
+        for (float position : positions)
+        {
+            node.positions.emplace_back(position, 0.0f);
+        }
+        return AddNode(std::move(node));
+    }
+
+    uint16 BlendTree::AddBlendSpace2D(std::vector<uint16> children, std::vector<float2> positions, uint16 parameterX, uint16 parameterY)
+    {
+        GINA_ASSERT_MSG(!children.empty() && children.size() == positions.size(), "Blendspace needs one position per child");
+        GINA_ASSERT_MSG(children.size() <= MAX_BLENDSPACE_SAMPLES, "Too many blendspace samples");
+
+        BlendNode node;
+        node.type = BlendNodeType::BlendSpace2D;
+        node.children = std::move(children);
+        node.positions = std::move(positions);
+        node.triangulation = BlendSpaceTriangulator::Triangulate(node.positions);
+        GINA_ASSERT_MSG(node.triangulation.GetTriangleCount() > 0, "2D blendspace samples must span an area");
+        node.parameter = parameterX;
+        node.parameterY = parameterY;
+        return AddNode(std::move(node));
+    }
+
+    void BlendCommandList::Clear() noexcept
+    {
+        commands.clear();
+        maxStackDepth = 0;
+        sampledClipCount = 0;
+    }
+
+    namespace
+    {
+        class Compiler
+        {
+        public:
+            Compiler(const BlendTree& tree, const float* parameters, BlendCommandList& output) noexcept
+                : m_tree(tree), m_parameters(parameters), m_output(output)
+            {
+            }
+
+            void Emit(uint16 index)
+            {
+                const BlendNode& node = m_tree.nodes[index];
+                switch (node.type)
+                {
+                case BlendNodeType::Clip:
+                    m_output.commands.push_back({ BlendOp::SampleClip, index, 1.0f });
+                    m_output.sampledClipCount++;
+                    Push();
+                    break;
+
+                case BlendNodeType::Blend:
+                {
+                    const float weight = std::clamp(GetParameter(node.parameter, node.weight), 0.0f, 1.0f);
+                    const float weights[2] = { 1.0f - weight, weight };
+                    EmitWeighted(node, weights);
+                    break;
+                }
+
+                case BlendNodeType::Additive:
+                case BlendNodeType::Mask:
+                {
+                    Emit(node.children[0]);
+
+                    const float weight = std::max(GetParameter(node.parameter, node.weight), 0.0f);
+                    if (weight >= BLEND_WEIGHT_EPSILON)
+                    {
+                        Emit(node.children[1]);
+                        m_output.commands.push_back({ node.type == BlendNodeType::Additive ? BlendOp::Additive : BlendOp::Mask, index,
+                            node.type == BlendNodeType::Mask ? std::min(weight, 1.0f) : weight });
+                        Pop();
+                    }
+                    break;
+                }
+
+                case BlendNodeType::BlendSpace1D:
+                {
+                    float weights[MAX_BLENDSPACE_SAMPLES];
+                    BlendTreeEvaluator::ComputeBlendSpace1DWeights(node, GetParameter(node.parameter, 0.0f), weights);
+                    EmitWeighted(node, weights);
+                    break;
+                }
+
+                case BlendNodeType::BlendSpace2D:
+                {
+                    float weights[MAX_BLENDSPACE_SAMPLES];
+                    const float2 position(GetParameter(node.parameter, 0.0f), GetParameter(node.parameterY, 0.0f));
+                    BlendTreeEvaluator::ComputeBlendSpace2DWeights(node, position, m_output.blendSpaceTriangles[index], weights);
+                    EmitWeighted(node, weights);
+                    break;
+                }
+                }
+            }
+
+        private:
+            float GetParameter(uint16 parameter, float fallback) const noexcept
+            {
+                return parameter == INVALID_BLEND_PARAMETER ? fallback : m_parameters[parameter];
+            }
+
+            // N-way blend as a chain of lerps: after k children the stack top holds their normalized
+            // weighted average, so child k + 1 enters with weight w / (sum of kept weights so far + w)
+            void EmitWeighted(const BlendNode& node, const float* weights)
+            {
+                float accumulated = 0.0f;
+                for (size_t i = 0; i < node.children.size(); ++i)
+                {
+                    const float weight = weights[i];
+                    if (weight < BLEND_WEIGHT_EPSILON)
+                    {
+                        continue;
+                    }
+
+                    Emit(node.children[i]);
+                    if (accumulated > 0.0f)
+                    {
+                        m_output.commands.push_back({ BlendOp::Blend, INVALID_BLEND_NODE, weight / (accumulated + weight) });
+                        Pop();
+                    }
+                    accumulated += weight;
+                }
+            }
+
+            void Push() noexcept
+            {
+                m_depth++;
+                m_output.maxStackDepth = std::max(m_output.maxStackDepth, m_depth);
+            }
+
+            void Pop() noexcept
+            {
+                m_depth--;
+            }
+
+            const BlendTree& m_tree;
+            const float* m_parameters;
+            BlendCommandList& m_output;
+            uint32 m_depth = 0;
+        };
+    }
+
+    void BlendTreeEvaluator::Compile(const BlendTree& tree, const float* parameters, BlendCommandList& commands)
+    {
+        commands.Clear();
+        if (tree.root == INVALID_BLEND_NODE)
+        {
+            return;
+        }
+
+        if (commands.blendSpaceTriangles.size() != tree.nodes.size())
+        {
+            commands.blendSpaceTriangles.assign(tree.nodes.size(), INVALID_BLEND_TRIANGLE);
+        }
+
+        Compiler compiler(tree, parameters, commands);
+        compiler.Emit(tree.root);
+    }
+
+    void BlendTreeEvaluator::Execute(const BlendTree& tree, const BlendCommandList& commands, float time, uint32 jointCount,
+        std::vector<Transform>& scratch, Transform* local)
+    {
+        if (commands.commands.empty())
+        {
+            return;
+        }
+
+        const size_t required = static_cast<size_t>(commands.maxStackDepth) * jointCount;
+        if (scratch.size() < required)
+        {
+            scratch.resize(required);
+        }
+
+        uint32 depth = 0;
+        for (const BlendCommand& command : commands.commands)
+        {
+            if (command.op == BlendOp::SampleClip)
+            {
+                const BlendNode& node = tree.nodes[command.node];
+                AnimationSampler::Sample(*node.clip, time * node.speed, node.loop, jointCount, &scratch[depth * jointCount]);
+                depth++;
+                continue;
+            }
+
+            Transform* below = &scratch[(depth - 2) * jointCount];
+            const Transform* top = &scratch[(depth - 1) * jointCount];
+            switch (command.op)
+            {
+            case BlendOp::Blend:
+                PoseOps::Blend(below, top, command.weight, jointCount, below);
+                break;
+            case BlendOp::Additive:
+                PoseOps::Add(below, top, command.weight, jointCount, below);
+                break;
+            case BlendOp::Mask:
+                PoseOps::BlendMasked(below, top, command.weight, tree.nodes[command.node].jointWeights.data(), jointCount, below);
+                break;
+            default:
+                break;
+            }
+            depth--;
+        }
+
+        GINA_ASSERT_MSG(depth == 1, "Unbalanced blend commands");
+        std::copy(scratch.begin(), scratch.begin() + jointCount, local);
+    }
+
+    void BlendTreeEvaluator::ComputeBlendSpace1DWeights(const BlendNode& node, float x, float* weights) noexcept
+    {
+        const std::vector<float2>& positions = node.positions;
+        const size_t count = positions.size();
+        std::fill(weights, weights + count, 0.0f);
+
+        if (x <= positions.front().x)
+        {
+            weights[0] = 1.0f;
+            return;
+        }
+        if (x >= positions.back().x)
+        {
+            weights[count - 1] = 1.0f;
+            return;
+        }
+
+        size_t upper = 1;
+        while (positions[upper].x < x)
+        {
+            ++upper;
+        }
+
+        const float span = positions[upper].x - positions[upper - 1].x;
+        const float t = span > 0.0f ? (x - positions[upper - 1].x) / span : 1.0f;
+        weights[upper - 1] = 1.0f - t;
+        weights[upper] = t;
+    }
+
+    void BlendTreeEvaluator::ComputeBlendSpace2DWeights(const BlendNode& node, const float2& position, uint16& triangle, float* weights) noexcept
+    {
+        std::fill(weights, weights + node.positions.size(), 0.0f);
+
+        const BlendSpaceLocation location = BlendSpaceTriangulator::Locate(node.triangulation, node.positions, position, triangle);
+        if (location.triangle == INVALID_BLEND_TRIANGLE)
+        {
+            // Samples that span no area have no triangulation; the first one keeps the pose stack balanced
+            weights[0] = 1.0f;
+            return;
+        }
+
+        triangle = location.triangle;
+        for (uint32 i = 0; i < 3; ++i)
+        {
+            weights[node.triangulation.triangles[triangle * 3 + i]] = std::max(location.barycentric[i], 0.0f);
+        }
+    }
+}
@@ -0,0 +1,509 @@
+#include "animation/gina_ik.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    namespace
+    {
+        /**
+         * Lane types the kernels are written against
+         *
+         * Every kernel is a template over its lane type: float solves one instance, Float4 solves four
+         * adjacent ones. Branches become masks and selects, so both instantiations compute the same
+         * thing per instance and the scalar kernel doubles as the tail loop and reference.
+         */
+        inline float Splat(float value, float) noexcept { return value; }
+        inline float Load(const float* data, float) noexcept { return *data; }
+        inline void Store(float* data, float value) noexcept { *data = value; }
+        inline float Sqrt(float value) noexcept { return std::sqrt(value); }
+        inline float Abs(float value) noexcept { return std::fabs(value); }
+        inline float Min(float a, float b) noexcept { return std::min(a, b); }
+        inline float Max(float a, float b) noexcept { return std::max(a, b); }
+        inline float Select(bool mask, float a, float b) noexcept { return mask ? a : b; }
+        inline bool And(bool a, bool b) noexcept { return a && b; }
+        inline bool Any(bool mask) noexcept { return mask; }
+
+#if defined(GINA_SSE2_ENABLED)
+        struct Float4
+        {
+            __m128 v;
+        };
+
+        struct Mask4
+        {
+            __m128 v;
+        };
+
+        inline Float4 Splat(float value, Float4) noexcept { return { _mm_set1_ps(value) }; }
+        inline Float4 Load(const float* data, Float4) noexcept { return { _mm_loadu_ps(data) }; }
+        inline void Store(float* data, Float4 value) noexcept { _mm_storeu_ps(data, value.v); }
+        inline Float4 operator+(Float4 a, Float4 b) noexcept { return { _mm_add_ps(a.v, b.v) }; }
+        inline Float4 operator-(Float4 a, Float4 b) noexcept { return { _mm_sub_ps(a.v, b.v) }; }
+        inline Float4 operator*(Float4 a, Float4 b) noexcept { return { _mm_mul_ps(a.v, b.v) }; }
+        inline Float4 operator/(Float4 a, Float4 b) noexcept { return { _mm_div_ps(a.v, b.v) }; }
+        inline Float4 operator-(Float4 a) noexcept { return { _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)) }; }
+        inline Mask4 operator<(Float4 a, Float4 b) noexcept { return { _mm_cmplt_ps(a.v, b.v) }; }
+        inline Mask4 operator>(Float4 a, Float4 b) noexcept { return { _mm_cmpgt_ps(a.v, b.v) }; }
+        inline Float4 Sqrt(Float4 value) noexcept { return { _mm_sqrt_ps(value.v) }; }
+        inline Float4 Abs(Float4 value) noexcept { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), value.v) }; }
+        inline Float4 Min(Float4 a, Float4 b) noexcept { return { _mm_min_ps(a.v, b.v) }; }
+        inline Float4 Max(Float4 a, Float4 b) noexcept { return { _mm_max_ps(a.v, b.v) }; }
+        inline Float4 Select(Mask4 mask, Float4 a, Float4 b) noexcept { return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) }; }
+        inline Mask4 And(Mask4 a, Mask4 b) noexcept { return { _mm_and_ps(a.v, b.v) }; }
+        inline bool Any(Mask4 mask) noexcept { return _mm_movemask_ps(mask.v) != 0; }
+#endif
+
+        template<typename T>
+        struct Vec3
+        {
+            T x, y, z;
+        };
+
+        template<typename T>
+        struct Quat
+        {
+            T x, y, z, w;
+        };
+
+        template<typename T>
+        inline T Splat(float value) noexcept { return Splat(value, T()); }
+
+        template<typename T>
+        inline Vec3<T> LoadVec3(const IKVectorStream& stream, uint32 index) noexcept
+        {
+            return { Load(&stream.x[index], T()), Load(&stream.y[index], T()), Load(&stream.z[index], T()) };
+        }
+
+        template<typename T>
+        inline void StoreVec3(IKVectorStream& stream, uint32 index, const Vec3<T>& value) noexcept
+        {
+            Store(&stream.x[index], value.x);
+            Store(&stream.y[index], value.y);
+            Store(&stream.z[index], value.z);
+        }
+
+        template<typename T>
+        inline void StoreQuat(IKRotationStream& stream, uint32 index, const Quat<T>& value) noexcept
+        {
+            Store(&stream.x[index], value.x);
+            Store(&stream.y[index], value.y);
+            Store(&stream.z[index], value.z);
+            Store(&stream.w[index], value.w);
+        }
+
+        template<typename T>
+        inline Vec3<T> operator+(const Vec3<T>& a, const Vec3<T>& b) noexcept { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+
+        template<typename T>
+        inline Vec3<T> operator-(const Vec3<T>& a, const Vec3<T>& b) noexcept { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+
+        template<typename T>
+        inline Vec3<T> operator*(const Vec3<T>& a, T scalar) noexcept { return { a.x * scalar, a.y * scalar, a.z * scalar }; }
+
+        template<typename T, typename M>
+        inline Vec3<T> Select(M mask, const Vec3<T>& a, const Vec3<T>& b) noexcept
+        {
+            return { Select(mask, a.x, b.x), Select(mask, a.y, b.y), Select(mask, a.z, b.z) };
+        }
+
+        template<typename T, typename M>
+        inline Quat<T> Select(M mask, const Quat<T>& a, const Quat<T>& b) noexcept
+        {
+            return { Select(mask, a.x, b.x), Select(mask, a.y, b.y), Select(mask, a.z, b.z), Select(mask, a.w, b.w) };
+        }
+
+        template<typename T>
+        inline T Dot(const Vec3<T>& a, const Vec3<T>& b) noexcept { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+        template<typename T>
+        inline Vec3<T> Cross(const Vec3<T>& a, const Vec3<T>& b) noexcept
+        {
+            return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+        }
+
+        template<typename T>
+        inline T Length(const Vec3<T>& a) noexcept { return Sqrt(Dot(a, a)); }
+
+        // Zero length vectors stay (nearly) zero instead of turning into NaNs
+        template<typename T>
+        inline Vec3<T> Normalize(const Vec3<T>& a) noexcept
+        {
+            return a * (Splat<T>(1.0f) / Max(Length(a), Splat<T>(1e-12f)));
+        }
+
+        template<typename T>
+        inline Quat<T> Normalize(const Quat<T>& q) noexcept
+        {
+            const T inverse = Splat<T>(1.0f) / Sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+            return { q.x * inverse, q.y * inverse, q.z * inverse, q.w * inverse };
+        }
+
+        template<typename T>
+        inline Quat<T> Multiply(const Quat<T>& a, const Quat<T>& b) noexcept
+        {
+            return {
+                a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+                a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z };
+        }
+
+        template<typename T>
+        inline Vec3<T> Rotate(const Quat<T>& q, const Vec3<T>& v) noexcept
+        {
+            const Vec3<T> u = { q.x, q.y, q.z };
+            const Vec3<T> t = Cross(u, v) * Splat<T>(2.0f);
+            return v + t * q.w + Cross(u, t);
+        }
+
+        // quaternion::fromTo, with degenerate (zero length) inputs giving identity
+        template<typename T>
+        inline Quat<T> FromTo(const Vec3<T>& from, const Vec3<T>& to) noexcept
+        {
+            const Vec3<T> a = Normalize(from);
+            const Vec3<T> b = Normalize(to);
+            const T cosine = Dot(a, b);
+            const Vec3<T> axis = Cross(a, b);
+            const Quat<T> rotation = Normalize(Quat<T>{ axis.x, axis.y, axis.z, Splat<T>(1.0f) + cosine });
+
+            const Vec3<T> perpendicular = Normalize(Select(Abs(a.x) < Splat<T>(0.9f),
+                Vec3<T>{ Splat<T>(0.0f), a.z, -a.y },     // a x (1, 0, 0)
+                Vec3<T>{ -a.z, Splat<T>(0.0f), a.x }));   // a x (0, 1, 0)
+            const Quat<T> halfTurn = { perpendicular.x, perpendicular.y, perpendicular.z, Splat<T>(0.0f) };
+            const Quat<T> identity = { Splat<T>(0.0f), Splat<T>(0.0f), Splat<T>(0.0f), Splat<T>(1.0f) };
+
+            const Quat<T> result = Select(cosine < Splat<T>(-1.0f + 1e-6f), halfTurn, rotation);
+            const T tiny = Splat<T>(1e-12f);
+            return Select(And(Dot(from, from) > tiny, Dot(to, to) > tiny), result, identity);
+        }
+
+        // Normalized lerp from identity, along the shorter arc
+        template<typename T>
+        inline Quat<T> Weighted(const Quat<T>& q, T weight) noexcept
+        {
+            const T sign = Select(q.w < Splat<T>(0.0f), Splat<T>(-1.0f), Splat<T>(1.0f));
+            const T scale = weight * sign;
+            return Normalize(Quat<T>{ q.x * scale, q.y * scale, q.z * scale, Splat<T>(1.0f) - weight + q.w * scale });
+        }
+
+        template<typename T>
+        void SolveTwoBoneKernel(TwoBoneIKBatch& batch, uint32 begin, uint32 end, uint32 step) noexcept
+        {
+            const T zero = Splat<T>(0.0f);
+            const T one = Splat<T>(1.0f);
+            const T epsilon = Splat<T>(1e-6f);
+
+            for (uint32 i = begin; i < end; i += step)
+            {
+                const Vec3<T> a = LoadVec3<T>(batch.root, i);
+                const Vec3<T> b = LoadVec3<T>(batch.mid, i);
+                const Vec3<T> c = LoadVec3<T>(batch.end, i);
+                const Vec3<T> target = LoadVec3<T>(batch.target, i);
+                const Vec3<T> pole = LoadVec3<T>(batch.pole, i);
+                const T weight = Load(&batch.weight[i], T());
+
+                const Vec3<T> ab = b - a;
+                const Vec3<T> bc = c - b;
+                const T upperLength = Length(ab);
+                const T lowerLength = Length(bc);
+
+                // Reach limits: fully stretched or fully folded
+                const Vec3<T> toTarget = target - a;
+                const T targetDistance = Length(toTarget);
+                const T reach = Min(Max(targetDistance, Abs(upperLength - lowerLength)), upperLength + lowerLength);
+                const Vec3<T> direction = Select(targetDistance > epsilon, toTarget * (one / Max(targetDistance, epsilon)), Normalize(c - a));
+
+                // Law of cosines for the angle at the root
+                const T cosine = Min(Max((upperLength * upperLength + reach * reach - lowerLength * lowerLength) /
+                    Max(Splat<T>(2.0f) * upperLength * reach, epsilon), -one), one);
+                const T sine = Sqrt(Max(one - cosine * cosine, zero));
+
+                // Bend towards the pole, or keep the current bend plane when the pole is along the limb
+                const Vec3<T> poleBend = pole - direction * Dot(pole, direction);
+                const Vec3<T> currentBend = ab - direction * Dot(ab, direction);
+                const Vec3<T> bend = Normalize(Select(Dot(poleBend, poleBend) > epsilon, poleBend, currentBend));
+
+                const Vec3<T> solvedMid = a + direction * (upperLength * cosine) + bend * (upperLength * sine);
+                const Vec3<T> solvedEnd = a + direction * reach;
+
+                const Quat<T> rootDelta = FromTo(ab, solvedMid - a);
+                const Quat<T> midDelta = Multiply(FromTo(Rotate(rootDelta, bc), solvedEnd - solvedMid), rootDelta);
+
+                StoreQuat(batch.rootDelta, i, Weighted(rootDelta, weight));
+                StoreQuat(batch.midDelta, i, Weighted(midDelta, weight));
+            }
+        }
+
+        template<typename T>
+        void SolveFabrikKernel(FabrikIKBatch& batch, uint32 begin, uint32 end, uint32 step) noexcept
+        {
+            const uint32 jointCount = batch.GetJointCount();
+            const T one = Splat<T>(1.0f);
+            const T toleranceSquared = Splat<T>(batch.tolerance * batch.tolerance);
+
+            Vec3<T> original[MAX_IK_CHAIN_JOINTS];
+            Vec3<T> positions[MAX_IK_CHAIN_JOINTS];
+            Vec3<T> solved[MAX_IK_CHAIN_JOINTS];
+            T lengths[MAX_IK_CHAIN_JOINTS];
+
+            for (uint32 i = begin; i < end; i += step)
+            {
+                const Vec3<T> target = LoadVec3<T>(batch.target, i);
+                const T weight = Load(&batch.weight[i], T());
+
+                T chainLength = Splat<T>(0.0f);
+                for (uint32 j = 0; j < jointCount; ++j)
+                {
+                    original[j] = positions[j] = LoadVec3<T>(batch.positions[j], i);
+                    if (j > 0)
+                    {
+                        lengths[j - 1] = Length(positions[j] - positions[j - 1]);
+                        chainLength = chainLength + lengths[j - 1];
+                    }
+                }
+
+                const Vec3<T> base = positions[0];
+                const Vec3<T> baseToTarget = target - base;
+                const auto reachable = chainLength * chainLength > Dot(baseToTarget, baseToTarget);
+
+                // Lanes that converged (or cannot reach) are frozen, so each instance iterates exactly as
+                // it would on its own
+                const Vec3<T> initialError = positions[jointCount - 1] - target;
+                auto active = And(reachable, Dot(initialError, initialError) > toleranceSquared);
+                for (uint32 iteration = 0; iteration < batch.maxIterations && Any(active); ++iteration)
+                {
+                    // Backward: pin the end to the target and pull the chain after it
+                    solved[jointCount - 1] = target;
+                    for (uint32 j = jointCount - 1; j-- > 0;)
+                    {
+                        solved[j] = solved[j + 1] + Normalize(positions[j] - solved[j + 1]) * lengths[j];
+                    }
+
+                    // Forward: pin the base back in place
+                    solved[0] = base;
+                    for (uint32 j = 1; j < jointCount; ++j)
+                    {
+                        solved[j] = solved[j - 1] + Normalize(solved[j] - solved[j - 1]) * lengths[j - 1];
+                    }
+
+                    for (uint32 j = 1; j < jointCount; ++j)
+                    {
+                        positions[j] = Select(active, solved[j], positions[j]);
+                    }
+
+                    const Vec3<T> error = positions[jointCount - 1] - target;
+                    active = And(active, Dot(error, error) > toleranceSquared);
+                }
+
+                // Out of reach: straighten towards the target
+                for (uint32 j = 1; j < jointCount; ++j)
+                {
+                    const Vec3<T> straight = positions[j - 1] + Normalize(target - positions[j - 1]) * lengths[j - 1];
+                    positions[j] = Select(reachable, positions[j], straight);
+                }
+
+                // Model space deltas, each joint's accumulating its parents'
+                Quat<T> delta = { Splat<T>(0.0f), Splat<T>(0.0f), Splat<T>(0.0f), one };
+                for (uint32 j = 0; j + 1 < jointCount; ++j)
+                {
+                    const Vec3<T> previous = Rotate(delta, original[j + 1] - original[j]);
+                    delta = Multiply(FromTo(previous, positions[j + 1] - positions[j]), delta);
+                    StoreQuat(batch.deltas[j], i, Weighted(delta, weight));
+                }
+
+                for (uint32 j = 1; j < jointCount; ++j)
+                {
+                    StoreVec3(batch.positions[j], i, positions[j]);
+                }
+            }
+        }
+
+        template<typename T>
+        void SolveLookAtKernel(LookAtIKBatch& batch, uint32 begin, uint32 end, uint32 step) noexcept
+        {
+            const float halfAngle = 0.5f * std::min(std::max(batch.maxAngle, 0.0f), PI);
+            const T minCosine = Splat<T>(std::cos(halfAngle));
+            const T maxSine = Splat<T>(std::sin(halfAngle));
+
+            for (uint32 i = begin; i < end; i += step)
+            {
+                const Vec3<T> position = LoadVec3<T>(batch.position, i);
+                const Vec3<T> forward = LoadVec3<T>(batch.forward, i);
+                const Vec3<T> target = LoadVec3<T>(batch.target, i);
+                const T weight = Load(&batch.weight[i], T());
+
+                // fromTo keeps w = cos(angle / 2) non-negative, so the limit is a compare on w
+                const Quat<T> rotation = FromTo(forward, target - position);
+                const Vec3<T> axis = Normalize(Vec3<T>{ rotation.x, rotation.y, rotation.z }) * maxSine;
+                const Quat<T> limited = Select(rotation.w < minCosine, Quat<T>{ axis.x, axis.y, axis.z, minCosine }, rotation);
+
+                StoreQuat(batch.delta, i, Weighted(limited, weight));
+            }
+        }
+
+        // Whole batches through the widest kernel, the remainder one instance at a time
+        template<typename Batch>
+        void SolveBatch(Batch& batch, uint32 count, void(*simd)(Batch&, uint32, uint32) noexcept,
+            void(*scalar)(Batch&, uint32, uint32) noexcept) noexcept
+        {
+            uint32 simdEnd = 0;
+#if defined(GINA_SSE2_ENABLED)
+            simdEnd = count / IK_BATCH_WIDTH * IK_BATCH_WIDTH;
+            simd(batch, 0, simdEnd);
+#else
+            (void)simd;
+#endif
+            scalar(batch, simdEnd, count);
+        }
+    }
+
+    void IKVectorStream::Resize(uint32 count)
+    {
+        x.resize(count, 0.0f);
+        y.resize(count, 0.0f);
+        z.resize(count, 0.0f);
+    }
+
+    void IKVectorStream::Set(uint32 index, const float3& value) noexcept
+    {
+        x[index] = value.x;
+        y[index] = value.y;
+        z[index] = value.z;
+    }
+
+    void IKRotationStream::Resize(uint32 count)
+    {
+        x.resize(count, 0.0f);
+        y.resize(count, 0.0f);
+        z.resize(count, 0.0f);
+        w.resize(count, 1.0f);
+    }
+
+    void IKRotationStream::Set(uint32 index, const quaternion& value) noexcept
+    {
+        x[index] = value.x;
+        y[index] = value.y;
+        z[index] = value.z;
+        w[index] = value.w;
+    }
+
+    void TwoBoneIKBatch::Resize(uint32 count)
+    {
+        root.Resize(count);
+        mid.Resize(count);
+        end.Resize(count);
+        target.Resize(count);
+        pole.Resize(count);
+        weight.resize(count, 1.0f);
+        rootDelta.Resize(count);
+        midDelta.Resize(count);
+    }
+
+    void FabrikIKBatch::Resize(uint32 jointCount, uint32 count)
+    {
+        GINA_ASSERT_MSG(jointCount >= 2 && jointCount <= MAX_IK_CHAIN_JOINTS, "FABRIK chains need 2 to MAX_IK_CHAIN_JOINTS joints");
+
+        positions.resize(jointCount);
+        for (IKVectorStream& stream : positions)
+        {
+            stream.Resize(count);
+        }
+        target.Resize(count);
+        weight.resize(count, 1.0f);
+        deltas.resize(jointCount - 1);
+        for (IKRotationStream& stream : deltas)
+        {
+            stream.Resize(count);
+        }
+    }
+
+    void LookAtIKBatch::Resize(uint32 count)
+    {
+        position.Resize(count);
+        forward.Resize(count);
+        target.Resize(count);
+        weight.resize(count, 1.0f);
+        delta.Resize(count);
+    }
+
+    void IKSolver::SolveTwoBone(TwoBoneIKBatch& batch) noexcept
+    {
+#if defined(GINA_SSE2_ENABLED)
+        SolveBatch(batch, batch.GetCount(), &SolveTwoBoneSSE2, &SolveTwoBoneScalar);
+#else
+        SolveBatch(batch, batch.GetCount(), &SolveTwoBoneScalar, &SolveTwoBoneScalar);
+#endif
+    }
+
+    void IKSolver::SolveFabrik(FabrikIKBatch& batch) noexcept
+    {
+        GINA_ASSERT_MSG(batch.GetJointCount() >= 2 && batch.GetJointCount() <= MAX_IK_CHAIN_JOINTS, "FABRIK chains need 2 to MAX_IK_CHAIN_JOINTS joints");
+#if defined(GINA_SSE2_ENABLED)
+        SolveBatch(batch, batch.GetCount(), &SolveFabrikSSE2, &SolveFabrikScalar);
+#else
+        SolveBatch(batch, batch.GetCount(), &SolveFabrikScalar, &SolveFabrikScalar);
+#endif
+    }
+
+    void IKSolver::SolveLookAt(LookAtIKBatch& batch) noexcept
+    {
+#if defined(GINA_SSE2_ENABLED)
+        SolveBatch(batch, batch.GetCount(), &SolveLookAtSSE2, &SolveLookAtScalar);
+#else
+        SolveBatch(batch, batch.GetCount(), &SolveLookAtScalar, &SolveLookAtScalar);
+#endif
+    }
+
+    void IKSolver::SolveTwoBoneScalar(TwoBoneIKBatch& batch, uint32 begin, uint32 end) noexcept
+    {
+        SolveTwoBoneKernel<float>(batch, begin, end, 1);
+    }
+
+    void IKSolver::SolveFabrikScalar(FabrikIKBatch& batch, uint32 begin, uint32 end) noexcept
+    {
+        SolveFabrikKernel<float>(batch, begin, end, 1);
+    }
+
+    void IKSolver::SolveLookAtScalar(LookAtIKBatch& batch, uint32 begin, uint32 end) noexcept
+    {
+        SolveLookAtKernel<float>(batch, begin, end, 1);
+    }
+
+#if defined(GINA_SSE2_ENABLED)
+    void IKSolver::SolveTwoBoneSSE2(TwoBoneIKBatch& batch, uint32 begin, uint32 end) noexcept
+    {
+        GINA_ASSERT_MSG((end - begin) % IK_BATCH_WIDTH == 0, "SSE2 kernels solve whole batches of IK_BATCH_WIDTH");
+        SolveTwoBoneKernel<Float4>(batch, begin, end, IK_BATCH_WIDTH);
+    }
+
+    void IKSolver::SolveFabrikSSE2(FabrikIKBatch& batch, uint32 begin, uint32 end) noexcept
+    {
+        GINA_ASSERT_MSG((end - begin) % IK_BATCH_WIDTH == 0, "SSE2 kernels solve whole batches of IK_BATCH_WIDTH");
+        SolveFabrikKernel<Float4>(batch, begin, end, IK_BATCH_WIDTH);
+    }
+
+    void IKSolver::SolveLookAtSSE2(LookAtIKBatch& batch, uint32 begin, uint32 end) noexcept
+    {
+        GINA_ASSERT_MSG((end - begin) % IK_BATCH_WIDTH == 0, "SSE2 kernels solve whole batches of IK_BATCH_WIDTH");
+        SolveLookAtKernel<Float4>(batch, begin, end, IK_BATCH_WIDTH);
+    }
+#endif
+
+    void IKSolver::ApplyRotationDeltas(const Skeleton& skeleton, const uint16* joints, const quaternion* deltas, uint32 count,
+        Transform* local, Transform* model) noexcept
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            const uint16 joint = joints[i];
+            const uint16 parent = skeleton.parents[joint];
+            const quaternion rotation = (deltas[i] * model[joint].rotation).normalized();
+
+            local[joint].rotation = parent == INVALID_JOINT ? rotation : (model[parent].rotation.conjugate() * rotation).normalized();
+            model[joint] = parent == INVALID_JOINT ? local[joint] : model[parent] * local[joint];
+        }
+    }
+}
@@ -0,0 +1,531 @@
+#include "animation/gina_motion_matching.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "animation/gina_pose.h"
+#include "core/gina_assert.h"
+#include "core/gina_cpu_features.h"
+
+namespace gina
+{
+    namespace
+    {
+        // Value of the unused lanes of a leaf's last block; far enough to never match, small enough not to overflow
+        constexpr float MOTION_PADDING = 1e15f;
+
+        constexpr uint32 MAX_TREE_DEPTH = 64;
+
+        struct FeatureGroup
+        {
+            uint32 offset;
+            uint32 count;
+            float weight;
+        };
+
+        // Ground-projected root frame: features are expressed relative to it so they do not depend on
+        // where the character stands or faces
+        struct CharacterFrame
+        {
+            float3 origin;
+            float3 right;
+            float3 forward;
+
+            explicit CharacterFrame(const Transform& root) noexcept
+            {
+                origin = float3(root.translation.x, 0.0f, root.translation.z);
+                const float3 facing = root.rotation.rotate(float3(0.0f, 0.0f, 1.0f));
+                const float length = std::sqrt(facing.x * facing.x + facing.z * facing.z);
+                forward = length > 1e-6f ? float3(facing.x / length, 0.0f, facing.z / length) : float3(0.0f, 0.0f, 1.0f);
+                right = float3(forward.z, 0.0f, -forward.x);
+            }
+
+            float3 ToLocalVector(const float3& vector) const noexcept
+            {
+                return float3(dot(vector, right), vector.y, dot(vector, forward));
+            }
+
+            float3 ToLocalPoint(const float3& point) const noexcept
+            {
+                return ToLocalVector(point - origin);
+            }
+        };
+
+        class TreeBuilder
+        {
+        public:
+            TreeBuilder(const std::vector<float>& rows, const std::vector<uint32>& clips, const std::vector<uint32>& frames,
+                MotionDatabase& database) noexcept
+                : m_rows(rows), m_clips(clips), m_frames(frames), m_database(database)
+            {
+                m_order.resize(clips.size());
+                std::iota(m_order.begin(), m_order.end(), 0u);
+            }
+
+            void Build()
+            {
+                if (!m_order.empty())
+                {
+                    BuildNode(0, static_cast<uint32>(m_order.size()), 0);
+                }
+            }
+
+        private:
+            uint32 BuildNode(uint32 begin, uint32 end, uint32 depth)
+            {
+                const uint32 index = static_cast<uint32>(m_database.nodes.size());
+                m_database.nodes.emplace_back();
+                m_database.nodeBounds.resize(m_database.nodeBounds.size() + 2 * MOTION_FEATURE_COUNT);
+
+                float* minimum = &m_database.nodeBounds[index * 2 * MOTION_FEATURE_COUNT];
+                float* maximum = minimum + MOTION_FEATURE_COUNT;
+                std::fill(minimum, maximum, std::numeric_limits<float>::max());
+                std::fill(maximum, maximum + MOTION_FEATURE_COUNT, -std::numeric_limits<float>::max());
+                for (uint32 i = begin; i < end; ++i)
+                {
+                    const float* row = &m_rows[m_order[i] * MOTION_FEATURE_COUNT];
+                    for (uint32 d = 0; d < MOTION_FEATURE_COUNT; ++d)
+                    {
+                        minimum[d] = std::min(minimum[d], row[d]);
+                        maximum[d] = std::max(maximum[d], row[d]);
+                    }
+                }
+
+                const uint32 firstBlock = m_database.GetBlockCount();
+                uint32 widest = 0;
+                for (uint32 d = 1; d < MOTION_FEATURE_COUNT; ++d)
+                {
+                    widest = maximum[d] - minimum[d] > maximum[widest] - minimum[widest] ? d : widest;
+                }
+
+                if (end - begin <= MOTION_LEAF_SIZE || depth + 1 >= MAX_TREE_DEPTH || maximum[widest] <= minimum[widest])
+                {
+                    EmitLeaf(begin, end);
+                }
+                else
+                {
+                    // Split on the widest feature at a multiple of the block size so leaves waste few lanes
+                    const uint32 half = (end - begin) / 2;
+                    const uint32 middle = std::min(begin + (half + MOTION_BLOCK_SIZE - 1) / MOTION_BLOCK_SIZE * MOTION_BLOCK_SIZE, end - 1);
+                    std::nth_element(m_order.begin() + begin, m_order.begin() + middle, m_order.begin() + end,
+                        [&](uint32 a, uint32 b) { return m_rows[a * MOTION_FEATURE_COUNT + widest] < m_rows[b * MOTION_FEATURE_COUNT + widest]; });
+
+                    BuildNode(begin, middle, depth + 1);
+                    const uint32 right = BuildNode(middle, end, depth + 1);
+                    m_database.nodes[index].right = right;
+                }
+
+                m_database.nodes[index].firstBlock = firstBlock;
+                m_database.nodes[index].blockCount = m_database.GetBlockCount() - firstBlock;
+                return index;
+            }
+
+            void EmitLeaf(uint32 begin, uint32 end)
+            {
+                for (uint32 first = begin; first < end; first += MOTION_BLOCK_SIZE)
+                {
+                    const size_t base = m_database.features.size();
+                    m_database.features.resize(base + MOTION_FEATURE_COUNT * MOTION_BLOCK_SIZE, MOTION_PADDING);
+                    for (uint32 lane = 0; lane < MOTION_BLOCK_SIZE; ++lane)
+                    {
+                        if (first + lane >= end)
+                        {
+                            m_database.entryClips.push_back(INVALID_MOTION_ENTRY);
+                            m_database.entryFrames.push_back(0);
+                            continue;
+                        }
+
+                        const uint32 source = m_order[first + lane];
+                        for (uint32 d = 0; d < MOTION_FEATURE_COUNT; ++d)
+                        {
+                            m_database.features[base + d * MOTION_BLOCK_SIZE + lane] = m_rows[source * MOTION_FEATURE_COUNT + d];
+                        }
+                        m_database.entryClips.push_back(m_clips[source]);
+                        m_database.entryFrames.push_back(m_frames[source]);
+                    }
+                }
+            }
+
+            const std::vector<float>& m_rows;
+            const std::vector<uint32>& m_clips;
+            const std::vector<uint32>& m_frames;
+            MotionDatabase& m_database;
+            std::vector<uint32> m_order;
+        };
+
+        // Squared distance from the query to a node's bounds; stops once it reaches limit
+        float NodeLowerBound(const MotionDatabase& database, uint32 node, const float* query, float limit) noexcept
+        {
+            const float* minimum = &database.nodeBounds[node * 2 * MOTION_FEATURE_COUNT];
+            const float* maximum = minimum + MOTION_FEATURE_COUNT;
+            float bound = 0.0f;
+            for (uint32 d = 0; d < MOTION_FEATURE_COUNT && bound < limit; ++d)
+            {
+                const float outside = std::max({ minimum[d] - query[d], query[d] - maximum[d], 0.0f });
+                bound += outside * outside;
+            }
+            return bound;
+        }
+    }
+
+    void MotionDatabase::Normalize(const float* raw, float* normalized) const noexcept
+    {
+        for (uint32 d = 0; d < MOTION_FEATURE_COUNT; ++d)
+        {
+            normalized[d] = (raw[d] - offsets[d]) * scales[d];
+        }
+    }
+
+    bool MotionDatabaseBuilder::ExtractFeatures(const Skeleton& skeleton, const MotionClip& motionClip, uint32 frame,
+        const MotionFeatureSettings& settings, std::vector<Transform>& scratch, float* features)
+    {
+        GINA_ASSERT_MSG(settings.leftFoot < skeleton.GetJointCount() && settings.rightFoot < skeleton.GetJointCount(), "Motion features need both feet");
+
+        const AnimationClip& clip = *motionClip.clip;
+        const float frameTime = 1.0f / clip.sampleRate;
+        const float time = frame * frameTime;
+        for (float offset : settings.trajectoryTimes)
+        {
+            if (!motionClip.loop && time + offset > clip.duration + 1e-4f)
+            {
+                return false;
+            }
+        }
+
+        // Feet are reached through a prefix of the skeleton, parents first
+        const uint32 jointCount = std::max(settings.leftFoot, settings.rightFoot) + 1u;
+        scratch.resize(3 * static_cast<size_t>(jointCount));
+        Transform* local = scratch.data();
+        Transform* model = local + jointCount;
+        Transform* next = model + jointCount;
+
+        AnimationSampler::Sample(clip, time + frameTime, motionClip.loop, jointCount, local);
+        PoseOps::LocalToModel(skeleton, local, jointCount, next);
+        AnimationSampler::Sample(clip, time, motionClip.loop, jointCount, local);
+        PoseOps::LocalToModel(skeleton, local, jointCount, model);
+
+        const CharacterFrame character(model[0]);
+        for (uint32 i = 0; i < MOTION_TRAJECTORY_SAMPLES; ++i)
+        {
+            Transform root;
+            AnimationSampler::Sample(clip, time + settings.trajectoryTimes[i], motionClip.loop, 1, &root);
+
+            const CharacterFrame future(root);
+            const float3 position = character.ToLocalPoint(future.origin);
+            const float3 direction = character.ToLocalVector(future.forward);
+            features[MOTION_TRAJECTORY_POSITION_OFFSET + i * 2] = position.x;
+            features[MOTION_TRAJECTORY_POSITION_OFFSET + i * 2 + 1] = position.z;
+            features[MOTION_TRAJECTORY_DIRECTION_OFFSET + i * 2] = direction.x;
+            features[MOTION_TRAJECTORY_DIRECTION_OFFSET + i * 2 + 1] = direction.z;
+        }
+
+        const uint16 feet[2] = { settings.leftFoot, settings.rightFoot };
+        for (uint32 i = 0; i < 2; ++i)
+        {
+            const float3 position = character.ToLocalPoint(model[feet[i]].translation);
+            const float3 velocity = character.ToLocalVector((next[feet[i]].translation - model[feet[i]].translation) / frameTime);
+            for (uint32 axis = 0; axis < 3; ++axis)
+            {
+                features[MOTION_FOOT_POSITION_OFFSET + i * 3 + axis] = position[axis];
+                features[MOTION_FOOT_VELOCITY_OFFSET + i * 3 + axis] = velocity[axis];
+            }
+        }
+        return true;
+    }
+
+    MotionDatabase MotionDatabaseBuilder::Build(const Skeleton& skeleton, const std::vector<MotionClip>& clips, const MotionFeatureSettings& settings)
+    {
+        std::vector<float> rows;
+        std::vector<uint32> entryClips;
+        std::vector<uint32> entryFrames;
+        std::vector<Transform> scratch;
+        float features[MOTION_FEATURE_COUNT];
+
+        for (uint32 c = 0; c < clips.size(); ++c)
+        {
+            const uint32 frameCount = clips[c].clip->GetFrameCount();
+            for (uint32 frame = 0; frame < frameCount; ++frame)
+            {
+                if (ExtractFeatures(skeleton, clips[c], frame, settings, scratch, features))
+                {
+                    rows.insert(rows.end(), features, features + MOTION_FEATURE_COUNT);
+                    entryClips.push_back(c);
+                    entryFrames.push_back(frame);
+                }
+            }
+        }
+
+        return Build(rows, entryClips, entryFrames, settings);
+    }
+
+    /**
+     * Features are centered per dimension and each group is divided by the standard deviation of its
+     * dimensions taken together, so a group's weight is its share of the distance regardless of units
+     * and of how many dimensions it has. The tree then splits the widest normalized dimension at its
+     * median until leaves hold at most MOTION_LEAF_SIZE entries.
+     */
+    MotionDatabase MotionDatabaseBuilder::Build(const std::vector<float>& rawFeatures, const std::vector<uint32>& clips,
+        const std::vector<uint32>& frames, const MotionFeatureSettings& settings)
+    {
+        GINA_ASSERT_MSG(rawFeatures.size() == clips.size() * MOTION_FEATURE_COUNT && clips.size() == frames.size(), "One feature row per entry");
+
+        MotionDatabase database;
+        database.entryCount = static_cast<uint32>(clips.size());
+        database.offsets.assign(MOTION_FEATURE_COUNT, 0.0f);
+        database.scales.assign(MOTION_FEATURE_COUNT, 1.0f);
+        if (database.entryCount == 0)
+        {
+            return database;
+        }
+
+        std::vector<double> mean(MOTION_FEATURE_COUNT, 0.0);
+        std::vector<double> variance(MOTION_FEATURE_COUNT, 0.0);
+        for (uint32 e = 0; e < database.entryCount; ++e)
+        {
+            for (uint32 d = 0; d < MOTION_FEATURE_COUNT; ++d)
+            {
+                mean[d] += rawFeatures[e * MOTION_FEATURE_COUNT + d];
+            }
+        }
+        for (double& value : mean)
+        {
+            value /= database.entryCount;
+        }
+        for (uint32 e = 0; e < database.entryCount; ++e)
+        {
+            for (uint32 d = 0; d < MOTION_FEATURE_COUNT; ++d)
+            {
+                const double delta = rawFeatures[e * MOTION_FEATURE_COUNT + d] - mean[d];
+                variance[d] += delta * delta;
+            }
+        }
+
+        const FeatureGroup groups[] =
+        {
+            { MOTION_TRAJECTORY_POSITION_OFFSET, 2 * MOTION_TRAJECTORY_SAMPLES, settings.trajectoryPositionWeight },
+            { MOTION_TRAJECTORY_DIRECTION_OFFSET, 2 * MOTION_TRAJECTORY_SAMPLES, settings.trajectoryDirectionWeight },
+            { MOTION_FOOT_POSITION_OFFSET, 6, settings.footPositionWeight },
+            { MOTION_FOOT_VELOCITY_OFFSET, 6, settings.footVelocityWeight }
+        };
+        for (const FeatureGroup& group : groups)
+        {
+            double groupVariance = 0.0;
+            for (uint32 d = group.offset; d < group.offset + group.count; ++d)
+            {
+                groupVariance += variance[d] / database.entryCount;
+            }
+
+            const double deviation = std::sqrt(groupVariance / group.count);
+            for (uint32 d = group.offset; d < group.offset + group.count; ++d)
+            {
+                database.offsets[d] = static_cast<float>(mean[d]);
+                database.scales[d] = deviation > 1e-6 ? static_cast<float>(group.weight / deviation) : group.weight;
+            }
+        }
+
+        std::vector<float> rows(rawFeatures.size());
+        for (uint32 e = 0; e < database.entryCount; ++e)
+        {
+            database.Normalize(&rawFeatures[e * MOTION_FEATURE_COUNT], &rows[e * MOTION_FEATURE_COUNT]);
+        }
+
+        TreeBuilder builder(rows, clips, frames, database);
+        builder.Build();
+        return database;
+    }
+
+    namespace detail
+    {
+        MotionMatchingDispatch::SearchBlocksFunc MotionMatchingDispatch::searchBlocksImpl = nullptr;
+        bool MotionMatchingDispatch::initialized = (MotionMatchingDispatch::initialize(), true);
+
+        void MotionMatchingDispatch::initialize() noexcept
+        {
+            useAVX2();
+        }
+
+        void MotionMatchingDispatch::useScalar() noexcept
+        {
+            searchBlocksImpl = &MotionMatcher::SearchBlocksScalar;
+        }
+
+        void MotionMatchingDispatch::useAVX2() noexcept
+        {
+#if defined(GINA_SSE2_ENABLED)
+            if (CpuFeatures::HasAVX2())
+            {
+                searchBlocksImpl = &MotionMatcher::SearchBlocksAVX2;
+                return;
+            }
+#endif
+            useScalar();
+        }
+    }
+
+    /**
+     * Depth-first descent that visits the nearer child first and skips every subtree whose bounds are
+     * already farther than the best match. Motion databases are dense along a few locomotion modes,
+     * so most leaves are rejected on their bounds after the first few full block scans.
+     */
+    MotionMatch MotionMatcher::Search(const MotionDatabase& database, const float* query, bool useTree) noexcept
+    {
+        MotionMatch best;
+        best.cost = std::numeric_limits<float>::max();
+        const detail::MotionMatchingDispatch::SearchBlocksFunc searchBlocks = detail::MotionMatchingDispatch::searchBlocksImpl;
+
+        if (!useTree || database.nodes.empty())
+        {
+            searchBlocks(database, query, 0, database.GetBlockCount(), best);
+        }
+        else
+        {
+            struct Pending
+            {
+                uint32 node;
+                float bound;
+            };
+
+            Pending stack[MAX_TREE_DEPTH + 1];
+            uint32 size = 0;
+            stack[size++] = { 0, 0.0f };
+            while (size > 0)
+            {
+                const Pending pending = stack[--size];
+                if (pending.bound >= best.cost)
+                {
+                    continue;
+                }
+
+                const MotionNode& node = database.nodes[pending.node];
+                if (node.right == INVALID_MOTION_ENTRY)
+                {
+                    searchBlocks(database, query, node.firstBlock, node.blockCount, best);
+                    continue;
+                }
+
+                const uint32 left = pending.node + 1;
+                const float leftBound = NodeLowerBound(database, left, query, best.cost);
+                const float rightBound = NodeLowerBound(database, node.right, query, best.cost);
+                const bool leftFirst = leftBound <= rightBound;
+                const Pending nearer = leftFirst ? Pending{ left, leftBound } : Pending{ node.right, rightBound };
+                const Pending farther = leftFirst ? Pending{ node.right, rightBound } : Pending{ left, leftBound };
+                if (farther.bound < best.cost)
+                {
+                    stack[size++] = farther;
+                }
+                if (nearer.bound < best.cost)
+                {
+                    stack[size++] = nearer;
+                }
+            }
+        }
+
+        if (best.entry != INVALID_MOTION_ENTRY)
+        {
+            best.clip = database.entryClips[best.entry];
+            best.frame = database.entryFrames[best.entry];
+        }
+        return best;
+    }
+
+    void MotionMatcher::SearchBatch(const MotionDatabase& database, const float* queries, uint32 queryCount, MotionMatch* results,
+        bool useTree, ThreadPool* threadPool)
+    {
+        auto searchRange = [&](uint32 begin, uint32 end)
+        {
+            for (uint32 q = begin; q < end; ++q)
+            {
+                results[q] = Search(database, &queries[q * MOTION_FEATURE_COUNT], useTree);
+            }
+        };
+
+        if (threadPool == nullptr)
+        {
+            searchRange(0, queryCount);
+            return;
+        }
+        threadPool->ParallelFor(queryCount, 16, searchRange);
+    }
+
+    void MotionMatcher::SearchBlocksScalar(const MotionDatabase& database, const float* query, uint32 first, uint32 count, MotionMatch& best) noexcept
+    {
+        for (uint32 b = first; b < first + count; ++b)
+        {
+            const float* block = database.GetBlock(b);
+            for (uint32 lane = 0; lane < MOTION_BLOCK_SIZE; ++lane)
+            {
+                float cost = 0.0f;
+                for (uint32 d = 0; d < MOTION_FEATURE_COUNT; ++d)
+                {
+                    const float difference = block[d * MOTION_BLOCK_SIZE + lane] - query[d];
+                    cost += difference * difference;
+                    if ((d & 7) == 7 && cost >= best.cost)
+                    {
+                        break;
+                    }
+                }
+
+                if (cost < best.cost)
+                {
+                    best.cost = cost;
+                    best.entry = b * MOTION_BLOCK_SIZE + lane;
+                }
+            }
+        }
+    }
+
+#if defined(GINA_SSE2_ENABLED)
+    namespace
+    {
+        // Adds the squared differences of features [first, first + 8) of a block; two chains hide the add latency
+        GINA_TARGET_AVX2 inline __m256 AccumulateAVX2(const float* block, const float* query, uint32 first, __m256 cost) noexcept
+        {
+            __m256 other = _mm256_setzero_ps();
+            for (uint32 d = first; d < first + 8; d += 2)
+            {
+                const __m256 difference0 = _mm256_sub_ps(_mm256_loadu_ps(block + d * MOTION_BLOCK_SIZE), _mm256_broadcast_ss(query + d));
+                const __m256 difference1 = _mm256_sub_ps(_mm256_loadu_ps(block + (d + 1) * MOTION_BLOCK_SIZE), _mm256_broadcast_ss(query + d + 1));
+                cost = _mm256_add_ps(cost, _mm256_mul_ps(difference0, difference0));
+                other = _mm256_add_ps(other, _mm256_mul_ps(difference1, difference1));
+            }
+            return _mm256_add_ps(cost, other);
+        }
+    }
+
+    GINA_TARGET_AVX2 void MotionMatcher::SearchBlocksAVX2(const MotionDatabase& database, const float* query, uint32 first, uint32 count, MotionMatch& best) noexcept
+    {
+        static_assert(MOTION_FEATURE_COUNT % 8 == 0, "The AVX2 kernel checks for early-out every eight features");
+
+        alignas(32) float costs[MOTION_BLOCK_SIZE];
+        for (uint32 b = first; b < first + count; ++b)
+        {
+            const float* block = database.GetBlock(b);
+            const __m256 bestCost = _mm256_set1_ps(best.cost);
+
+            __m256 cost = _mm256_setzero_ps();
+            int closer = 0xFF;
+            for (uint32 d = 0; d < MOTION_FEATURE_COUNT && closer != 0; d += 8)
+            {
+                cost = AccumulateAVX2(block, query, d, cost);
+                closer = _mm256_movemask_ps(_mm256_cmp_ps(cost, bestCost, _CMP_LT_OQ));
+            }
+
+            if (closer == 0)
+            {
+                continue;
+            }
+
+            _mm256_store_ps(costs, cost);
+            for (uint32 lane = 0; lane < MOTION_BLOCK_SIZE; ++lane)
+            {
+                if (costs[lane] < best.cost)
+                {
+                    best.cost = costs[lane];
+                    best.entry = b * MOTION_BLOCK_SIZE + lane;
+                }
+            }
+        }
+    }
+#endif
+}
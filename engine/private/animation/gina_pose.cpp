@@ -0,0 +1,115 @@
+#include "animation/gina_pose.h"
+
+namespace gina
+{
+    void PoseStreams::Resize(uint32 jointCount)
+    {
+        rotationX.resize(jointCount, 0.0f);
+        rotationY.resize(jointCount, 0.0f);
+        rotationZ.resize(jointCount, 0.0f);
+        rotationW.resize(jointCount, 1.0f);
+        translationX.resize(jointCount, 0.0f);
+        translationY.resize(jointCount, 0.0f);
+        translationZ.resize(jointCount, 0.0f);
+        scaleX.resize(jointCount, 1.0f);
+        scaleY.resize(jointCount, 1.0f);
+        scaleZ.resize(jointCount, 1.0f);
+    }
+
+    Transform PoseStreams::Get(uint32 joint) const noexcept
+    {
+        Transform transform;
+        transform.rotation = quaternion(rotationX[joint], rotationY[joint], rotationZ[joint], rotationW[joint]);
+        transform.translation = float3(translationX[joint], translationY[joint], translationZ[joint]);
+        transform.scale = float3(scaleX[joint], scaleY[joint], scaleZ[joint]);
+        return transform;
+    }
+
+    void PoseStreams::Set(uint32 joint, const Transform& transform) noexcept
+    {
+        rotationX[joint] = transform.rotation.x;
+        rotationY[joint] = transform.rotation.y;
+        rotationZ[joint] = transform.rotation.z;
+        rotationW[joint] = transform.rotation.w;
+        translationX[joint] = transform.translation.x;
+        translationY[joint] = transform.translation.y;
+        translationZ[joint] = transform.translation.z;
+        scaleX[joint] = transform.scale.x;
+        scaleY[joint] = transform.scale.y;
+        scaleZ[joint] = transform.scale.z;
+    }
+
+    void PoseOps::Blend(const Transform* a, const Transform* b, float weight, uint32 jointCount, Transform* result) noexcept
+    {
+        for (uint32 joint = 0; joint < jointCount; ++joint)
+        {
+            result[joint] = gina::Blend(a[joint], b[joint], weight);
+        }
+    }
+
+    void PoseOps::BlendMasked(const Transform* a, const Transform* b, float weight, const float* jointWeights,
+        uint32 jointCount, Transform* result) noexcept
+    {
+        for (uint32 joint = 0; joint < jointCount; ++joint)
+        {
+            result[joint] = gina::Blend(a[joint], b[joint], weight * jointWeights[joint]);
+        }
+    }
+
+    void PoseOps::MakeAdditive(const Transform* reference, const Transform* pose, uint32 jointCount, Transform* delta) noexcept
+    {
+        for (uint32 joint = 0; joint < jointCount; ++joint)
+        {
+            const Transform& ref = reference[joint];
+            delta[joint].rotation = ref.rotation.conjugate() * pose[joint].rotation;
+            delta[joint].translation = pose[joint].translation - ref.translation;
+            delta[joint].scale = float3(pose[joint].scale.x / ref.scale.x, pose[joint].scale.y / ref.scale.y, pose[joint].scale.z / ref.scale.z);
+        }
+    }
+
+    void PoseOps::Add(const Transform* base, const Transform* delta, float weight, uint32 jointCount, Transform* result) noexcept
+    {
+        for (uint32 joint = 0; joint < jointCount; ++joint)
+        {
+            const Transform& d = delta[joint];
+            result[joint].rotation = base[joint].rotation * nlerp(quaternion::Identity, d.rotation, weight);
+            result[joint].translation = base[joint].translation + d.translation * weight;
+            result[joint].scale = base[joint].scale * lerp(float3(1.0f), d.scale, weight);
+        }
+    }
+
+    void PoseOps::LocalToModel(const Skeleton& skeleton, const Transform* local, uint32 jointCount, Transform* model) noexcept
+    {
+        // Parents precede children, so a single forward pass sees every parent resolved
+        for (uint32 joint = 0; joint < jointCount; ++joint)
+        {
+            const uint16 parent = skeleton.parents[joint];
+            model[joint] = parent == INVALID_JOINT ? local[joint] : model[parent] * local[joint];
+        }
+    }
+
+    void PoseOps::FillCulledJoints(const Skeleton& skeleton, uint32 lod, Transform* model) noexcept
+    {
+        for (uint32 joint = skeleton.GetLodJointCount(lod); joint < skeleton.GetJointCount(); ++joint)
+        {
+            const uint16 parent = skeleton.parents[joint];
+            model[joint] = parent == INVALID_JOINT ? skeleton.bindPose[joint] : model[parent] * skeleton.bindPose[joint];
+        }
+    }
+
+    void PoseOps::ToStreams(const Transform* pose, uint32 jointCount, PoseStreams& streams) noexcept
+    {
+        for (uint32 joint = 0; joint < jointCount; ++joint)
+        {
+            streams.Set(joint, pose[joint]);
+        }
+    }
+
+    void PoseOps::FromStreams(const PoseStreams& streams, uint32 jointCount, Transform* pose) noexcept
+    {
+        for (uint32 joint = 0; joint < jointCount; ++joint)
+        {
+            pose[joint] = streams.Get(joint);
+        }
+    }
+}
@@ -0,0 +1,200 @@
+#include "animation/gina_pose_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "animation/gina_pose.h"
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    namespace
+    {
+        constexpr uint32 POSE_GRAIN_SIZE = 4;
+        constexpr size_t MIN_LOOKUP_SIZE = 64;
+    }
+
+    size_t PoseCache::KeyHash::operator()(const Key& key) const noexcept
+    {
+        size_t hash = std::hash<const void*>()(key.clip);
+        hash ^= (static_cast<size_t>(key.time) * 0x9E3779B97F4A7C15ull) + (hash << 6) + (hash >> 2);
+        hash ^= (static_cast<size_t>(key.jointCount) << 1 | (key.loop ? 1u : 0u)) + 0x9E3779B9u + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    PoseCache::PoseCache(const Skeleton& skeleton, const PoseCacheSettings& settings)
+        : m_skeleton(&skeleton), m_settings(settings)
+    {
+        GINA_ASSERT_MSG(settings.updateInterval > 0, "The update interval is at least one frame");
+    }
+
+    void PoseCache::BeginFrame()
+    {
+        ++m_frame;
+        m_requestCount = 0;
+        m_poses.clear();
+        m_local.clear();
+        m_model.clear();
+    }
+
+    PoseHandle PoseCache::Request(const AnimationClip& clip, float time, bool loop, uint32 lod)
+    {
+        ++m_requestCount;
+
+        const float duration = std::max(clip.duration, 0.0f);
+        if (loop && duration > 0.0f)
+        {
+            time -= std::floor(time / duration) * duration;
+        }
+        time = std::clamp(time, 0.0f, duration);
+
+        Key key = { &clip, 0, static_cast<uint16>(m_skeleton->GetLodJointCount(lod)), loop };
+        const float quantum = m_settings.timeQuantum;
+        if (quantum > 0.0f)
+        {
+            key.time = static_cast<uint32>(time / quantum + 0.5f);
+            time = std::min(key.time * quantum, duration);
+            if (loop && time >= duration)
+            {
+                key.time = 0;
+                time = 0.0f;
+            }
+        }
+        else
+        {
+            std::memcpy(&key.time, &time, sizeof(float));
+        }
+
+        if ((m_poses.size() + 1) * 2 > m_lookup.size())
+        {
+            GrowLookup();
+        }
+
+        const size_t mask = m_lookup.size() - 1;
+        for (size_t slot = KeyHash()(key) & mask;; slot = (slot + 1) & mask)
+        {
+            LookupSlot& entry = m_lookup[slot];
+            if (entry.frame == m_frame)
+            {
+                if (entry.key == key)
+                {
+                    return entry.handle;
+                }
+                continue;
+            }
+
+            entry = { key, static_cast<PoseHandle>(m_poses.size()), m_frame };
+            m_poses.push_back({ &clip, time, loop, key.jointCount, static_cast<uint32>(m_local.size()) });
+            m_local.resize(m_local.size() + key.jointCount);
+            m_model.resize(m_model.size() + key.jointCount);
+            return entry.handle;
+        }
+    }
+
+    void PoseCache::GrowLookup()
+    {
+        std::vector<LookupSlot> previous = std::move(m_lookup);
+        m_lookup.assign(std::max(previous.size() * 2, MIN_LOOKUP_SIZE), { {}, INVALID_POSE_HANDLE, m_frame - 1 });
+
+        const size_t mask = m_lookup.size() - 1;
+        for (const LookupSlot& entry : previous)
+        {
+            if (entry.frame != m_frame)
+            {
+                continue;
+            }
+
+            size_t slot = KeyHash()(entry.key) & mask;
+            while (m_lookup[slot].frame == m_frame)
+            {
+                slot = (slot + 1) & mask;
+            }
+            m_lookup[slot] = entry;
+        }
+    }
+
+    void PoseCache::Evaluate(ThreadPool* threadPool)
+    {
+        auto evaluateRange = [this](uint32 begin, uint32 end)
+        {
+            for (uint32 p = begin; p < end; ++p)
+            {
+                const CachedPose& pose = m_poses[p];
+                Transform* local = m_local.data() + pose.offset;
+                AnimationSampler::Sample(*pose.clip, pose.time, pose.loop, pose.jointCount, local);
+                PoseOps::LocalToModel(*m_skeleton, local, pose.jointCount, m_model.data() + pose.offset);
+            }
+        };
+
+        const uint32 count = GetEvaluatedCount();
+        if (threadPool == nullptr)
+        {
+            evaluateRange(0, count);
+        }
+        else
+        {
+            threadPool->ParallelFor(count, POSE_GRAIN_SIZE, evaluateRange);
+        }
+    }
+
+    const Transform* PoseCache::GetLocalPose(PoseHandle handle) const noexcept
+    {
+        return m_local.data() + m_poses[handle].offset;
+    }
+
+    const Transform* PoseCache::GetModelPose(PoseHandle handle) const noexcept
+    {
+        return m_model.data() + m_poses[handle].offset;
+    }
+
+    bool PoseCache::IsUpdateFrame(uint32 instance) const noexcept
+    {
+        return (m_frame + instance) % m_settings.updateInterval == 0;
+    }
+
+    PoseHandle PoseCache::RequestReducedRate(const ReducedRatePose& state, uint32 instance, const AnimationClip& clip, float time,
+        float deltaTime, bool loop, uint32 lod)
+    {
+        if (!state.to.empty() && !IsUpdateFrame(instance))
+        {
+            return INVALID_POSE_HANDLE;
+        }
+        return Request(clip, time + deltaTime * m_settings.updateInterval, loop, lod);
+    }
+
+    void PoseCache::ResolveReducedRate(ReducedRatePose& state, PoseHandle handle, Transform* model) const
+    {
+        if (handle != INVALID_POSE_HANDLE)
+        {
+            const Transform* pose = GetModelPose(handle);
+            const uint32 jointCount = GetPoseJointCount(handle);
+            if (state.to.size() == jointCount)
+            {
+                std::swap(state.from, state.to);
+                state.to.assign(pose, pose + jointCount);
+            }
+            else
+            {
+                // First update or a LOD change: nothing to interpolate from
+                state.to.assign(pose, pose + jointCount);
+                state.from = state.to;
+            }
+            state.framesSinceUpdate = 0;
+        }
+        else
+        {
+            GINA_ASSERT_MSG(!state.to.empty(), "Reduced rate instances need an update before interpolating");
+            ++state.framesSinceUpdate;
+        }
+
+        const uint32 jointCount = static_cast<uint32>(state.to.size());
+        const float weight = std::min(static_cast<float>(state.framesSinceUpdate) / m_settings.updateInterval, 1.0f);
+        if (weight == 0.0f)
+        {
+            std::copy(state.from.begin(), state.from.end(), model);
+            return;
+        }
+        PoseOps::Blend(state.from.data(), state.to.data(), weight, jointCount, model);
+    }
+}
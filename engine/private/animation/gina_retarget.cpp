@@ -0,0 +1,353 @@
+#include "animation/gina_retarget.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    namespace
+    {
+        // Bones shorter than this take the skeleton size ratio as their translation scale
+        constexpr float MIN_BONE_LENGTH = 1e-4f;
+
+        /**
+         * Lane types the kernel is written against
+         *
+         * float retargets one joint and Float4 four adjacent ones, gathering their source slots into
+         * lanes; the correction tables are already laid out per target joint and load directly.
+         */
+        inline float Load(const float* data, float) noexcept { return *data; }
+        inline float Gather(const float* data, const uint32* slots, float) noexcept { return data[*slots]; }
+        inline void Store(float* data, float value) noexcept { *data = value; }
+
+#if defined(GINA_SSE2_ENABLED)
+        struct Float4
+        {
+            __m128 v;
+        };
+
+        inline Float4 Load(const float* data, Float4) noexcept { return { _mm_loadu_ps(data) }; }
+        inline Float4 Gather(const float* data, const uint32* slots, Float4) noexcept
+        {
+            return { _mm_setr_ps(data[slots[0]], data[slots[1]], data[slots[2]], data[slots[3]]) };
+        }
+        inline void Store(float* data, Float4 value) noexcept { _mm_storeu_ps(data, value.v); }
+
+        inline Float4 operator+(Float4 a, Float4 b) noexcept { return { _mm_add_ps(a.v, b.v) }; }
+        inline Float4 operator-(Float4 a, Float4 b) noexcept { return { _mm_sub_ps(a.v, b.v) }; }
+        inline Float4 operator*(Float4 a, Float4 b) noexcept { return { _mm_mul_ps(a.v, b.v) }; }
+#endif
+
+        template <typename T>
+        struct Vec3
+        {
+            T x, y, z;
+        };
+
+        template <typename T>
+        struct Quat
+        {
+            T x, y, z, w;
+        };
+
+        template <typename T>
+        Quat<T> Multiply(const Quat<T>& a, const Quat<T>& b) noexcept
+        {
+            return {
+                a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+                a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z };
+        }
+
+        template <typename T>
+        Vec3<T> Cross(const Vec3<T>& a, const Vec3<T>& b) noexcept
+        {
+            return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+        }
+
+        // Same formulation as quaternion::rotate
+        template <typename T>
+        Vec3<T> Rotate(const Quat<T>& q, const Vec3<T>& v) noexcept
+        {
+            const Vec3<T> u = { q.x, q.y, q.z };
+            const Vec3<T> c = Cross(u, v);
+            const Vec3<T> t = { c.x + c.x, c.y + c.y, c.z + c.z };
+            const Vec3<T> d = Cross(u, t);
+            return { v.x + t.x * q.w + d.x, v.y + t.y * q.w + d.y, v.z + t.z * q.w + d.z };
+        }
+
+        template <typename T>
+        void RetargetJoints(const RetargetMap& map, const PoseStreams& source, PoseStreams& target, uint32 joint) noexcept
+        {
+            const T lane{};
+            const uint32* slots = &map.sourceSlots[joint];
+
+            const Quat<T> pre = { Load(&map.preX[joint], lane), Load(&map.preY[joint], lane), Load(&map.preZ[joint], lane), Load(&map.preW[joint], lane) };
+            const Quat<T> post = { Load(&map.postX[joint], lane), Load(&map.postY[joint], lane), Load(&map.postZ[joint], lane), Load(&map.postW[joint], lane) };
+            const Quat<T> rotation = {
+                Gather(source.rotationX.data(), slots, lane), Gather(source.rotationY.data(), slots, lane),
+                Gather(source.rotationZ.data(), slots, lane), Gather(source.rotationW.data(), slots, lane) };
+
+            const Quat<T> result = Multiply(Multiply(pre, rotation), post);
+            Store(&target.rotationX[joint], result.x);
+            Store(&target.rotationY[joint], result.y);
+            Store(&target.rotationZ[joint], result.z);
+            Store(&target.rotationW[joint], result.w);
+
+            const Vec3<T> offset = {
+                Gather(source.translationX.data(), slots, lane) - Load(&map.sourceBindTranslationX[joint], lane),
+                Gather(source.translationY.data(), slots, lane) - Load(&map.sourceBindTranslationY[joint], lane),
+                Gather(source.translationZ.data(), slots, lane) - Load(&map.sourceBindTranslationZ[joint], lane) };
+            const Vec3<T> moved = Rotate(pre, offset);
+            const T scale = Load(&map.translationScale[joint], lane);
+            Store(&target.translationX[joint], Load(&map.bindTranslationX[joint], lane) + moved.x * scale);
+            Store(&target.translationY[joint], Load(&map.bindTranslationY[joint], lane) + moved.y * scale);
+            Store(&target.translationZ[joint], Load(&map.bindTranslationZ[joint], lane) + moved.z * scale);
+        }
+
+        // Lower case without the "namespace:" or "path|" prefixes exporters add
+        std::string NormalizeJointName(const std::string& name)
+        {
+            const size_t separator = name.find_last_of(":|");
+            std::string normalized = separator == std::string::npos ? name : name.substr(separator + 1);
+            std::transform(normalized.begin(), normalized.end(), normalized.begin(),
+                [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return normalized;
+        }
+
+        // Diagonal of the bind pose joint bounds, comparing overall skeleton sizes
+        float ComputeBindExtent(const std::vector<Transform>& model)
+        {
+            float3 minimum(std::numeric_limits<float>::max());
+            float3 maximum(-std::numeric_limits<float>::max());
+            for (const Transform& transform : model)
+            {
+                minimum = float3(std::min(minimum.x, transform.translation.x), std::min(minimum.y, transform.translation.y), std::min(minimum.z, transform.translation.z));
+                maximum = float3(std::max(maximum.x, transform.translation.x), std::max(maximum.y, transform.translation.y), std::max(maximum.z, transform.translation.z));
+            }
+            return model.empty() ? 0.0f : (maximum - minimum).length();
+        }
+
+        bool IsDescendant(const Skeleton& skeleton, uint16 joint, uint16 ancestor) noexcept
+        {
+            for (uint16 parent = skeleton.parents[joint]; parent != INVALID_JOINT; parent = skeleton.parents[parent])
+            {
+                if (parent == ancestor)
+                {
+                    return true;
+                }
+            }
+            return ancestor == INVALID_JOINT;
+        }
+
+        void Append(std::vector<float>& x, std::vector<float>& y, std::vector<float>& z, const float3& value)
+        {
+            x.push_back(value.x);
+            y.push_back(value.y);
+            z.push_back(value.z);
+        }
+
+        void Append(std::vector<float>& x, std::vector<float>& y, std::vector<float>& z, std::vector<float>& w, const quaternion& value)
+        {
+            x.push_back(value.x);
+            y.push_back(value.y);
+            z.push_back(value.z);
+            w.push_back(value.w);
+        }
+    }
+
+    uint32 RetargetMap::GetMappedJointCount() const noexcept
+    {
+        const uint32 identity = GetIdentitySlot();
+        return static_cast<uint32>(std::count_if(sourceSlots.begin(), sourceSlots.end(), [identity](uint32 slot) { return slot != identity; }));
+    }
+
+    size_t RetargetMap::GetMemoryUsage() const noexcept
+    {
+        // Twenty float tables plus the slot per target joint
+        return targetJointCount * (20 * sizeof(float) + sizeof(uint32)) + chains.size() * sizeof(RetargetChain) +
+            chainJoints.size() * sizeof(uint16);
+    }
+
+    RetargetMap RetargetMapBuilder::Build(const Skeleton& source, const Skeleton& target, const RetargetSettings& settings)
+    {
+        const uint32 sourceCount = source.GetJointCount();
+        const uint32 targetCount = target.GetJointCount();
+
+        std::vector<uint16> pairs(targetCount, INVALID_JOINT);
+        for (const auto& [targetName, sourceName] : settings.jointPairs)
+        {
+            const uint16 t = target.FindJoint(targetName);
+            const uint16 s = source.FindJoint(sourceName);
+            if (t != INVALID_JOINT && s != INVALID_JOINT)
+            {
+                pairs[t] = s;
+            }
+        }
+
+        if (settings.matchNames)
+        {
+            std::unordered_map<std::string, uint16> sourceNames;
+            for (uint32 s = 0; s < sourceCount; ++s)
+            {
+                sourceNames.emplace(NormalizeJointName(source.jointNames[s]), static_cast<uint16>(s));
+            }
+            for (uint32 t = 0; t < targetCount; ++t)
+            {
+                const auto match = sourceNames.find(NormalizeJointName(target.jointNames[t]));
+                if (pairs[t] == INVALID_JOINT && match != sourceNames.end())
+                {
+                    pairs[t] = match->second;
+                }
+            }
+        }
+
+        std::vector<Transform> sourceModel(sourceCount);
+        std::vector<Transform> targetModel(targetCount);
+        PoseOps::LocalToModel(source, source.bindPose.data(), sourceCount, sourceModel.data());
+        PoseOps::LocalToModel(target, target.bindPose.data(), targetCount, targetModel.data());
+        const float sourceExtent = ComputeBindExtent(sourceModel);
+        const float extentScale = sourceExtent > MIN_BONE_LENGTH ? ComputeBindExtent(targetModel) / sourceExtent : 1.0f;
+
+        RetargetMap map;
+        map.sourceJointCount = sourceCount;
+        map.targetJointCount = targetCount;
+        map.sourceSlots.resize(targetCount, INVALID_JOINT);
+
+        // Parents precede children, so each joint sees the final pairing of its ancestors
+        for (uint32 t = 0; t < targetCount; ++t)
+        {
+            const Transform& bind = target.bindPose[t];
+            Append(map.bindTranslationX, map.bindTranslationY, map.bindTranslationZ, bind.translation);
+            Append(map.bindScaleX, map.bindScaleY, map.bindScaleZ, bind.scale);
+
+            uint16 mappedAncestor = target.parents[t];
+            while (mappedAncestor != INVALID_JOINT && pairs[mappedAncestor] == INVALID_JOINT)
+            {
+                mappedAncestor = target.parents[mappedAncestor];
+            }
+            const uint16 s = pairs[t];
+            const uint16 sourceAncestor = mappedAncestor == INVALID_JOINT ? INVALID_JOINT : pairs[mappedAncestor];
+            if (s == INVALID_JOINT || !IsDescendant(source, s, sourceAncestor))
+            {
+                pairs[t] = INVALID_JOINT;
+                Append(map.preX, map.preY, map.preZ, map.preW, bind.rotation);
+                Append(map.postX, map.postY, map.postZ, map.postW, quaternion::Identity);
+                Append(map.sourceBindTranslationX, map.sourceBindTranslationY, map.sourceBindTranslationZ, float3());
+                map.translationScale.push_back(0.0f);
+                continue;
+            }
+
+            // The slot rotation is the source chain from below sourceAncestor down to s, which in bind pose
+            // equals inverse(sourceModel[sourceAncestor]) * sourceModel[s]
+            std::vector<uint16> chain;
+            for (uint16 joint = s; joint != sourceAncestor; joint = source.parents[joint])
+            {
+                chain.push_back(joint);
+            }
+            if (chain.size() == 1)
+            {
+                map.sourceSlots[t] = s;
+            }
+            else
+            {
+                map.sourceSlots[t] = sourceCount + static_cast<uint32>(map.chains.size());
+                map.chains.push_back({ static_cast<uint32>(map.chainJoints.size()), static_cast<uint32>(chain.size()) });
+                map.chainJoints.insert(map.chainJoints.end(), chain.rbegin(), chain.rend());
+            }
+
+            const uint16 parent = target.parents[t];
+            const quaternion targetParent = parent == INVALID_JOINT ? quaternion::Identity : targetModel[parent].rotation;
+            const quaternion sourceParent = sourceAncestor == INVALID_JOINT ? quaternion::Identity : sourceModel[sourceAncestor].rotation;
+            const quaternion pre = (targetParent.conjugate() * sourceParent).normalized();
+            const quaternion post = (sourceModel[s].rotation.conjugate() * targetModel[t].rotation).normalized();
+            Append(map.preX, map.preY, map.preZ, map.preW, pre);
+            Append(map.postX, map.postY, map.postZ, map.postW, post);
+
+            const float3& sourceTranslation = source.bindPose[s].translation;
+            Append(map.sourceBindTranslationX, map.sourceBindTranslationY, map.sourceBindTranslationZ, sourceTranslation);
+            const float sourceLength = sourceTranslation.length();
+            const float targetLength = bind.translation.length();
+            map.translationScale.push_back(sourceLength > MIN_BONE_LENGTH && targetLength > MIN_BONE_LENGTH ?
+                targetLength / sourceLength : extentScale);
+        }
+
+        const uint32 identity = map.GetIdentitySlot();
+        for (uint32& slot : map.sourceSlots)
+        {
+            slot = slot == INVALID_JOINT ? identity : slot;
+        }
+        return map;
+    }
+
+    void Retargeter::Retarget(const RetargetMap& map, PoseStreams& source, PoseStreams& target) noexcept
+    {
+        GINA_ASSERT_MSG(source.GetJointCount() >= map.GetSourceSlotCount(), "Source streams need room for the chain and identity slots");
+        FillSlots(map, source);
+        target.Resize(map.targetJointCount);
+
+        uint32 simdEnd = 0;
+#if defined(GINA_SSE2_ENABLED)
+        simdEnd = map.targetJointCount / RETARGET_BATCH_WIDTH * RETARGET_BATCH_WIDTH;
+        RetargetSSE2(map, source, target, 0, simdEnd);
+#endif
+        RetargetScalar(map, source, target, simdEnd, map.targetJointCount);
+
+        // Scale is not retargeted: joints keep their bind scale
+        std::copy(map.bindScaleX.begin(), map.bindScaleX.end(), target.scaleX.begin());
+        std::copy(map.bindScaleY.begin(), map.bindScaleY.end(), target.scaleY.begin());
+        std::copy(map.bindScaleZ.begin(), map.bindScaleZ.end(), target.scaleZ.begin());
+    }
+
+    void Retargeter::RetargetScalar(const RetargetMap& map, const PoseStreams& source, PoseStreams& target, uint32 begin, uint32 end) noexcept
+    {
+        for (uint32 joint = begin; joint < end; ++joint)
+        {
+            RetargetJoints<float>(map, source, target, joint);
+        }
+    }
+
+#if defined(GINA_SSE2_ENABLED)
+    void Retargeter::RetargetSSE2(const RetargetMap& map, const PoseStreams& source, PoseStreams& target, uint32 begin, uint32 end) noexcept
+    {
+        for (uint32 joint = begin; joint < end; joint += RETARGET_BATCH_WIDTH)
+        {
+            RetargetJoints<Float4>(map, source, target, joint);
+        }
+    }
+#endif
+
+    void Retargeter::FillSlots(const RetargetMap& map, PoseStreams& source) noexcept
+    {
+        for (uint32 c = 0; c < map.chains.size(); ++c)
+        {
+            const RetargetChain& chain = map.chains[c];
+            quaternion rotation;
+            for (uint32 i = 0; i < chain.jointCount; ++i)
+            {
+                const uint16 joint = map.chainJoints[chain.firstJoint + i];
+                rotation = rotation * quaternion(source.rotationX[joint], source.rotationY[joint], source.rotationZ[joint], source.rotationW[joint]);
+            }
+
+            // The translation is that of the chain's last joint, whose bind translation the map subtracts
+            const uint16 last = map.chainJoints[chain.firstJoint + chain.jointCount - 1];
+            const uint32 slot = map.sourceJointCount + c;
+            source.rotationX[slot] = rotation.x;
+            source.rotationY[slot] = rotation.y;
+            source.rotationZ[slot] = rotation.z;
+            source.rotationW[slot] = rotation.w;
+            source.translationX[slot] = source.translationX[last];
+            source.translationY[slot] = source.translationY[last];
+            source.translationZ[slot] = source.translationZ[last];
+        }
+
+        const uint32 identity = map.GetIdentitySlot();
+        source.Set(identity, Transform());
+    }
+}
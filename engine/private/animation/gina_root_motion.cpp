@@ -0,0 +1,163 @@
+#include "animation/gina_root_motion.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    namespace
+    {
+        const float3 UP(0.0f, 1.0f, 0.0f);
+
+        // Same rotation as quaternion::fromAxisAngle(UP, yaw).rotate(vec)
+        float3 RotateYaw(const float3& vec, float yaw) noexcept
+        {
+            const float c = std::cos(yaw);
+            const float s = std::sin(yaw);
+            return float3(vec.x * c + vec.z * s, vec.y, vec.z * c - vec.x * s);
+        }
+
+        float WrapAngle(float angle) noexcept
+        {
+            angle = std::fmod(angle + PI, 2.0f * PI);
+            return (angle < 0.0f ? angle + 2.0f * PI : angle) - PI;
+        }
+
+        RootMotionDelta Relative(const float3& startPosition, float startYaw, const float3& endPosition, float endYaw) noexcept
+        {
+            RootMotionDelta delta;
+            delta.translation = RotateYaw(endPosition - startPosition, -startYaw);
+            delta.yaw = endYaw - startYaw;
+            return delta;
+        }
+    }
+
+    void RootMotionTrack::Sample(float time, float3& position, float& yaw) const noexcept
+    {
+        const uint32 frameCount = GetFrameCount();
+        if (frameCount == 0)
+        {
+            position = float3();
+            yaw = 0.0f;
+            return;
+        }
+
+        const float frame = std::clamp(time, 0.0f, duration) * sampleRate;
+        const uint32 frame0 = std::min(static_cast<uint32>(frame), frameCount - 1);
+        const uint32 frame1 = std::min(frame0 + 1, frameCount - 1);
+        const float alpha = frame - static_cast<float>(frame0);
+
+        position = lerp(positions[frame0], positions[frame1], alpha);
+        yaw = yaws[frame0] + (yaws[frame1] - yaws[frame0]) * alpha;
+    }
+
+    RootMotionDelta RootMotionTrack::GetDelta(float startTime, float endTime, bool loop) const noexcept
+    {
+        float3 startPosition, endPosition;
+        float startYaw, endYaw;
+
+        if (!loop || duration <= 0.0f || positions.empty())
+        {
+            Sample(startTime, startPosition, startYaw);
+            Sample(endTime, endPosition, endYaw);
+            return Relative(startPosition, startYaw, endPosition, endYaw);
+        }
+
+        // The delta does not depend on where the pair sits in the unwrapped timeline, so shift both times
+        // to put the start inside the first cycle
+        const float startCycle = std::floor(startTime / duration);
+        endTime -= startCycle * duration;
+        const float endCycle = std::floor(endTime / duration);
+        Sample(startTime - startCycle * duration, startPosition, startYaw);
+        Sample(endTime - endCycle * duration, endPosition, endYaw);
+
+        // Every cycle moves and turns the root by the last sample: P(t + d) = P(d) + R(Y(d)) P(t). After n
+        // cycles, forwards or backwards, P(t + nd) = R(nY) P(t) + sum of R(kY) P(d) for k < n; on the ground
+        // plane that sum is R((n - 1) Y / 2) P(d) sin(nY / 2) / sin(Y / 2), which tends to n P(d) as Y does
+        const float3& cyclePosition = positions.back();
+        const float cycleYaw = yaws.back();
+        const float turn = WrapAngle(cycleYaw);
+        const float halfSin = std::sin(0.5f * turn);
+        const float scale = std::abs(halfSin) > 1e-6f ? std::sin(0.5f * endCycle * turn) / halfSin : endCycle;
+
+        float3 cycles = RotateYaw(float3(cyclePosition.x, 0.0f, cyclePosition.z), 0.5f * (endCycle - 1.0f) * turn) * scale;
+        cycles.y = cyclePosition.y * endCycle;
+        endPosition = cycles + RotateYaw(endPosition, endCycle * turn);
+        endYaw += endCycle * cycleYaw;
+
+        return Relative(startPosition, startYaw, endPosition, endYaw);
+    }
+
+    RootMotionTrack RootMotionExtractor::Extract(AnimationClip& clip, const RootMotionSettings& settings)
+    {
+        GINA_ASSERT_MSG(settings.rootJoint < clip.jointCount, "Root joint is not animated by the clip");
+
+        RootMotionTrack track;
+        track.name = clip.name;
+        track.duration = clip.duration;
+        track.sampleRate = clip.sampleRate;
+
+        const uint32 frameCount = clip.GetFrameCount();
+        if (frameCount == 0)
+        {
+            return track;
+        }
+
+        track.positions.resize(frameCount);
+        track.yaws.resize(frameCount);
+
+        const Transform first = clip.frames[settings.rootJoint];
+        float previousHeading = 0.0f;
+        float yaw = 0.0f;
+        float firstYaw = 0.0f;
+        float3 firstPosition;
+
+        for (uint32 frame = 0; frame < frameCount; ++frame)
+        {
+            Transform& root = clip.frames[static_cast<size_t>(frame) * clip.jointCount + settings.rootJoint];
+
+            // Heading of the root's forward axis on the ground, unwrapped so turning in place keeps accumulating;
+            // a forward axis pointing straight up or down has no heading and keeps the previous one
+            const float3 forward = root.rotation.rotate(float3(0.0f, 0.0f, 1.0f));
+            const float heading = forward.x * forward.x + forward.z * forward.z > 1e-8f ? std::atan2(forward.x, forward.z) : previousHeading;
+            yaw = frame == 0 ? heading : yaw + WrapAngle(heading - previousHeading);
+            previousHeading = heading;
+
+            const float3 position(root.translation.x, settings.extractVertical ? root.translation.y - first.translation.y : 0.0f, root.translation.z);
+            if (frame == 0)
+            {
+                firstYaw = yaw;
+                firstPosition = position;
+            }
+
+            track.positions[frame] = RotateYaw(position - firstPosition, -firstYaw);
+            track.yaws[frame] = yaw - firstYaw;
+
+            if (settings.removeFromClip)
+            {
+                // Root relative to the extracted character frame: in place, facing +z
+                root.translation = RotateYaw(root.translation - position, -yaw);
+                root.rotation = (quaternion::fromAxisAngle(UP, -yaw) * root.rotation).normalized();
+            }
+        }
+
+        return track;
+    }
+
+    void RootMotionSampler::GetDeltas(const RootMotionQuery* queries, uint32 count, RootMotionDelta* deltas) noexcept
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            const RootMotionQuery& query = queries[i];
+            deltas[i] = query.track->GetDelta(query.startTime, query.endTime, query.loop);
+        }
+    }
+
+    void RootMotionSampler::Accumulate(Transform& character, const RootMotionDelta& delta) noexcept
+    {
+        character.translation += character.rotation.rotate(delta.translation);
+        character.rotation = (character.rotation * quaternion::fromAxisAngle(UP, delta.yaw)).normalized();
+    }
+}
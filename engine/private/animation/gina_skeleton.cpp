@@ -0,0 +1,146 @@
+#include "animation/gina_skeleton.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    uint16 Skeleton::FindJoint(const std::string& name) const noexcept
+    {
+        for (uint32 i = 0; i < jointNames.size(); ++i)
+        {
+            if (jointNames[i] == name)
+            {
+                return static_cast<uint16>(i);
+            }
+        }
+        return INVALID_JOINT;
+    }
+
+    uint32 Skeleton::SelectLod(float distance, float projectionScale, float maxPixelError) const noexcept
+    {
+        if (distance <= 0.0f)
+        {
+            return 0;
+        }
+
+        const float maxError = maxPixelError * distance / projectionScale;
+
+        uint32 selected = 0;
+        for (uint32 lod = 1; lod < lods.size() && lods[lod].error <= maxError; ++lod)
+        {
+            selected = lod;
+        }
+        return selected;
+    }
+
+    /**
+     * Importance of a joint is the length of the longest bone chain it moves: its own bone (offset
+     * from the parent) plus the most important child. Fingers and facial joints end up with a few
+     * centimeters while the spine and limbs carry most of the character, and a parent is never less
+     * important than any of its children.
+     */
+    std::vector<float> SkeletonBuilder::ComputeImportance(const std::vector<SkeletonJointDesc>& joints)
+    {
+        std::vector<float> importance(joints.size(), 0.0f);
+
+        for (size_t i = joints.size(); i-- > 0;)
+        {
+            importance[i] += joints[i].bindPose.translation.length();
+
+            const uint16 parent = joints[i].parent;
+            if (parent != INVALID_JOINT)
+            {
+                importance[parent] = std::max(importance[parent], importance[i]);
+            }
+        }
+
+        return importance;
+    }
+
+    Skeleton SkeletonBuilder::Build(const std::vector<SkeletonJointDesc>& joints, const SkeletonBuildSettings& settings,
+        std::vector<uint16>* sortedIndices)
+    {
+        GINA_ASSERT_MSG(joints.size() < MAX_SKELETON_JOINTS, "Too many joints");
+
+        const uint32 jointCount = static_cast<uint32>(joints.size());
+        for (uint32 i = 0; i < jointCount; ++i)
+        {
+            GINA_ASSERT_MSG(joints[i].parent == INVALID_JOINT || joints[i].parent < i, "Joints must list parents before children");
+        }
+
+        const std::vector<float> importance = ComputeImportance(joints);
+
+        // Stable sort keeps the parent-first input order between equally important joints
+        std::vector<uint16> order(jointCount);
+        std::iota(order.begin(), order.end(), static_cast<uint16>(0));
+        std::stable_sort(order.begin(), order.end(),
+            [&](uint16 a, uint16 b) { return importance[a] > importance[b]; });
+
+        std::vector<uint16> newIndex(jointCount);
+        for (uint32 i = 0; i < jointCount; ++i)
+        {
+            newIndex[order[i]] = static_cast<uint16>(i);
+        }
+
+        Skeleton skeleton;
+        skeleton.jointNames.reserve(jointCount);
+        skeleton.parents.reserve(jointCount);
+        skeleton.bindPose.reserve(jointCount);
+        skeleton.importance.reserve(jointCount);
+
+        for (uint16 source : order)
+        {
+            const SkeletonJointDesc& joint = joints[source];
+            skeleton.jointNames.push_back(joint.name);
+            skeleton.parents.push_back(joint.parent == INVALID_JOINT ? INVALID_JOINT : newIndex[joint.parent]);
+            skeleton.bindPose.push_back(joint.bindPose);
+            skeleton.importance.push_back(importance[source]);
+        }
+
+        const float rootImportance = jointCount > 0 ? skeleton.importance[0] : 0.0f;
+        skeleton.lods.push_back({ static_cast<uint16>(jointCount), 0.0f });
+
+        for (float threshold : settings.lodThresholds)
+        {
+            const float minImportance = threshold * rootImportance;
+            uint32 kept = 0;
+            while (kept < jointCount && skeleton.importance[kept] >= minImportance)
+            {
+                ++kept;
+            }
+
+            // Thresholds that don't cull anything new would only add an identical level
+            if (kept == 0 || kept >= skeleton.lods.back().jointCount)
+            {
+                continue;
+            }
+
+            skeleton.lods.push_back({ static_cast<uint16>(kept), skeleton.importance[kept] });
+        }
+
+        skeleton.lodRemap.resize(skeleton.lods.size() * jointCount);
+        for (uint32 lod = 0; lod < skeleton.lods.size(); ++lod)
+        {
+            uint16* remap = &skeleton.lodRemap[lod * jointCount];
+            const uint32 kept = skeleton.lods[lod].jointCount;
+
+            // Parents precede children, so a culled joint's parent is already remapped. Culled secondary
+            // roots fall back to joint 0, the most important root.
+            for (uint32 i = 0; i < jointCount; ++i)
+            {
+                const uint16 parent = skeleton.parents[i];
+                remap[i] = i < kept ? static_cast<uint16>(i) : (parent == INVALID_JOINT ? 0 : remap[parent]);
+            }
+        }
+
+        if (sortedIndices != nullptr)
+        {
+            *sortedIndices = std::move(newIndex);
+        }
+
+        return skeleton;
+    }
+}
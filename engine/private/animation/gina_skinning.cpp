@@ -0,0 +1,878 @@
+#include "animation/gina_skinning.h"
+
+#include "animation/gina_pose.h"
+#include "core/gina_assert.h"
+#include "core/gina_cpu_features.h"
+
+namespace gina
+{
+    namespace
+    {
+        constexpr float WEIGHT_SCALE = 1.0f / 255.0f;
+
+        uint32 UnpackByte(uint32 packed, uint32 index) noexcept
+        {
+            return (packed >> (index * 8)) & 0xFF;
+        }
+
+        // Weighted sum of the four palette matrices referenced by a vertex
+        float3x4 BlendPalette(const float3x4* palette, uint32 joints, uint32 weights) noexcept
+        {
+            float3x4 blended;
+            float* out = blended.data();
+            for (uint32 e = 0; e < 12; ++e)
+            {
+                out[e] = 0.0f;
+            }
+
+            for (uint32 i = 0; i < MAX_SKIN_INFLUENCES; ++i)
+            {
+                const float weight = static_cast<float>(UnpackByte(weights, i)) * WEIGHT_SCALE;
+                const float* matrix = palette[UnpackByte(joints, i)].data();
+                for (uint32 e = 0; e < 12; ++e)
+                {
+                    out[e] += weight * matrix[e];
+                }
+            }
+            return blended;
+        }
+    }
+
+    void VertexStreams::Resize(uint32 vertexCount, bool normals)
+    {
+        positionX.resize(vertexCount);
+        positionY.resize(vertexCount);
+        positionZ.resize(vertexCount);
+
+        const uint32 normalCount = normals ? vertexCount : 0;
+        normalX.resize(normalCount);
+        normalY.resize(normalCount);
+        normalZ.resize(normalCount);
+    }
+
+    /**
+     * Quantizes four weights summing to one into 8-bit unorms summing to exactly 255
+     *
+     * Largest remainder rounding: every weight is floored, then the units lost to rounding go to the
+     * weights with the largest fractional parts, so a rigid vertex always gets exactly 255.
+     */
+    uint32 SkinningData::PackWeights(const float* weights) noexcept
+    {
+        float total = 0.0f;
+        for (uint32 i = 0; i < MAX_SKIN_INFLUENCES; ++i)
+        {
+            total += std::max(weights[i], 0.0f);
+        }
+
+        uint32 quantized[MAX_SKIN_INFLUENCES] = {};
+        float remainders[MAX_SKIN_INFLUENCES] = {};
+        uint32 sum = 0;
+        for (uint32 i = 0; i < MAX_SKIN_INFLUENCES; ++i)
+        {
+            const float scaled = total > 0.0f ? std::max(weights[i], 0.0f) / total * 255.0f : (i == 0 ? 255.0f : 0.0f);
+            quantized[i] = static_cast<uint32>(scaled);
+            remainders[i] = scaled - static_cast<float>(quantized[i]);
+            sum += quantized[i];
+        }
+
+        for (; sum < 255; ++sum)
+        {
+            uint32 largest = 0;
+            for (uint32 i = 1; i < MAX_SKIN_INFLUENCES; ++i)
+            {
+                largest = remainders[i] > remainders[largest] ? i : largest;
+            }
+            ++quantized[largest];
+            remainders[largest] = -1.0f;
+        }
+
+        return quantized[0] | (quantized[1] << 8) | (quantized[2] << 16) | (quantized[3] << 24);
+    }
+
+    SkinningData SkinningData::FromMesh(const Mesh& mesh, const Skeleton& skeleton, SkinningMode mode)
+    {
+        const uint32 vertexCount = mesh.GetVertexCount();
+        const bool hasNormals = mesh.normals.size() == vertexCount;
+
+        SkinningData data;
+        data.mode = mode;
+        data.bindVertices.Resize(vertexCount, hasNormals);
+        data.joints.resize(vertexCount, 0);
+        data.weights.resize(vertexCount, 255);
+
+        for (uint32 v = 0; v < vertexCount; ++v)
+        {
+            data.bindVertices.positionX[v] = mesh.positions[v].x;
+            data.bindVertices.positionY[v] = mesh.positions[v].y;
+            data.bindVertices.positionZ[v] = mesh.positions[v].z;
+            if (hasNormals)
+            {
+                data.bindVertices.normalX[v] = mesh.normals[v].x;
+                data.bindVertices.normalY[v] = mesh.normals[v].y;
+                data.bindVertices.normalZ[v] = mesh.normals[v].z;
+            }
+        }
+
+        if (!mesh.IsSkinned())
+        {
+            return data;
+        }
+
+        std::vector<uint16> jointMap(mesh.jointNames.size());
+        for (size_t i = 0; i < mesh.jointNames.size(); ++i)
+        {
+            jointMap[i] = skeleton.FindJoint(mesh.jointNames[i]);
+            GINA_ASSERT_MSG(jointMap[i] == INVALID_JOINT || jointMap[i] < MAX_SKINNING_JOINTS, "Skinned joints must be within the first 256 skeleton joints");
+        }
+
+        for (uint32 v = 0; v < vertexCount; ++v)
+        {
+            const SkinInfluence& influence = mesh.skinning[v];
+            float weights[MAX_SKIN_INFLUENCES] = {};
+            uint32 joints = 0;
+
+            for (uint32 i = 0; i < MAX_SKIN_INFLUENCES; ++i)
+            {
+                const uint16 joint = influence.joints[i] < jointMap.size() ? jointMap[influence.joints[i]] : INVALID_JOINT;
+                if (joint != INVALID_JOINT && joint < MAX_SKINNING_JOINTS)
+                {
+                    weights[i] = influence.weights[i];
+                    joints |= static_cast<uint32>(joint) << (i * 8);
+                }
+            }
+
+            data.joints[v] = joints;
+            data.weights[v] = PackWeights(weights);
+        }
+
+        return data;
+    }
+
+    namespace detail
+    {
+        SkinningDispatch::SkinFunc SkinningDispatch::skinImpl = nullptr;
+        SkinningDispatch::SkinDualQuaternionFunc SkinningDispatch::skinDualQuaternionImpl = nullptr;
+        SkinningDispatch::ConvertPaletteFunc SkinningDispatch::convertPaletteImpl = nullptr;
+        bool SkinningDispatch::initialized = (SkinningDispatch::initialize(), true);
+
+        void SkinningDispatch::initialize() noexcept
+        {
+#if defined(GINA_SSE2_ENABLED)
+            if (CpuFeatures::HasAVX2())
+            {
+                useAVX2();
+                return;
+            }
+            if (CpuFeatures::HasSSE2())
+            {
+                useSSE2();
+                return;
+            }
+#endif
+            useScalar();
+        }
+
+        void SkinningDispatch::useScalar() noexcept
+        {
+            skinImpl = &Skinning::SkinScalar;
+            skinDualQuaternionImpl = &Skinning::SkinDualQuaternionScalar;
+            convertPaletteImpl = &Skinning::ConvertPaletteScalar;
+        }
+
+        void SkinningDispatch::useSSE2() noexcept
+        {
+#if defined(GINA_SSE2_ENABLED)
+            skinImpl = &Skinning::SkinSSE2;
+            skinDualQuaternionImpl = &Skinning::SkinDualQuaternionSSE2;
+            convertPaletteImpl = &Skinning::ConvertPaletteSSE2;
+#else
+            useScalar();
+#endif
+        }
+
+        void SkinningDispatch::useAVX2() noexcept
+        {
+#if defined(GINA_SSE2_ENABLED)
+            if (!CpuFeatures::HasAVX2())
+            {
+                useSSE2();
+                return;
+            }
+
+            // Palette conversion is per joint, too short to gain from 8 lanes
+            skinImpl = &Skinning::SkinAVX2;
+            skinDualQuaternionImpl = &Skinning::SkinDualQuaternionAVX2;
+            convertPaletteImpl = &Skinning::ConvertPaletteSSE2;
+#else
+            useScalar();
+#endif
+        }
+    }
+
+    std::vector<float3x4> Skinning::ComputeInverseBindMatrices(const Skeleton& skeleton)
+    {
+        const uint32 jointCount = skeleton.GetJointCount();
+        std::vector<Transform> bindModel(jointCount);
+        PoseOps::LocalToModel(skeleton, skeleton.bindPose.data(), jointCount, bindModel.data());
+
+        std::vector<float3x4> inverseBind(jointCount);
+        for (uint32 joint = 0; joint < jointCount; ++joint)
+        {
+            inverseBind[joint] = bindModel[joint].ToMatrix().inverse();
+        }
+        return inverseBind;
+    }
+
+    /**
+     * A joint culled by the LOD follows its kept ancestor rigidly in bind configuration, so its skinning
+     * matrix model * inverseBind collapses to the ancestor's: model(ancestor) * bindOffset * inverseBind(joint)
+     * = model(ancestor) * inverseBind(ancestor). Culled entries are plain copies.
+     */
+    void Skinning::BuildPalette(const Skeleton& skeleton, const std::vector<float3x4>& inverseBind,
+        const Transform* model, uint32 lod, float3x4* palette) noexcept
+    {
+        const uint32 jointCount = skeleton.GetJointCount();
+        const uint32 keptCount = skeleton.GetLodJointCount(lod);
+        const uint16* remap = skeleton.GetLodRemap(lod);
+
+        for (uint32 joint = 0; joint < keptCount; ++joint)
+        {
+            palette[joint] = model[joint].ToMatrix() * inverseBind[joint];
+        }
+        for (uint32 joint = keptCount; joint < jointCount; ++joint)
+        {
+            palette[joint] = palette[remap[joint]];
+        }
+    }
+
+    std::vector<Transform> Skinning::ComputeInverseBindTransforms(const Skeleton& skeleton)
+    {
+        const uint32 jointCount = skeleton.GetJointCount();
+        std::vector<Transform> inverseBind(jointCount);
+        PoseOps::LocalToModel(skeleton, skeleton.bindPose.data(), jointCount, inverseBind.data());
+
+        for (Transform& transform : inverseBind)
+        {
+            transform = transform.Inverse();
+        }
+        return inverseBind;
+    }
+
+    void Skinning::BuildDualQuaternionPalette(const Skeleton& skeleton, const std::vector<Transform>& inverseBind,
+        const Transform* model, uint32 lod, dualquaternion* palette) noexcept
+    {
+        const uint32 jointCount = skeleton.GetJointCount();
+        const uint32 keptCount = skeleton.GetLodJointCount(lod);
+        const uint16* remap = skeleton.GetLodRemap(lod);
+
+        detail::SkinningDispatch::convertPaletteImpl(inverseBind.data(), model, keptCount, palette);
+        for (uint32 joint = keptCount; joint < jointCount; ++joint)
+        {
+            palette[joint] = palette[remap[joint]];
+        }
+    }
+
+    namespace
+    {
+        template <typename Palette>
+        void RunSkinning(void (*skin)(const SkinningData&, const Palette*, VertexStreams&, uint32, uint32),
+            const SkinningData& data, const Palette* palette, VertexStreams& output, ThreadPool* threadPool)
+        {
+            const uint32 vertexCount = data.GetVertexCount();
+            if (output.GetVertexCount() != vertexCount || output.HasNormals() != data.bindVertices.HasNormals())
+            {
+                output.Resize(vertexCount, data.bindVertices.HasNormals());
+            }
+
+            if (threadPool == nullptr)
+            {
+                skin(data, palette, output, 0, vertexCount);
+                return;
+            }
+
+            threadPool->ParallelFor(vertexCount, SKINNING_BATCH_SIZE, [&](uint32 begin, uint32 end)
+            {
+                skin(data, palette, output, begin, end);
+            });
+        }
+    }
+
+    void Skinning::Skin(const SkinningData& data, const float3x4* palette, VertexStreams& output, ThreadPool* threadPool)
+    {
+        RunSkinning(detail::SkinningDispatch::skinImpl, data, palette, output, threadPool);
+    }
+
+    void Skinning::Skin(const SkinningData& data, const dualquaternion* palette, VertexStreams& output, ThreadPool* threadPool)
+    {
+        RunSkinning(detail::SkinningDispatch::skinDualQuaternionImpl, data, palette, output, threadPool);
+    }
+
+    void Skinning::ConvertPaletteScalar(const Transform* inverseBind, const Transform* model, uint32 count, dualquaternion* palette) noexcept
+    {
+        for (uint32 joint = 0; joint < count; ++joint)
+        {
+            const quaternion rotation = model[joint].rotation * inverseBind[joint].rotation;
+            const float3 translation = model[joint].rotation.rotate(inverseBind[joint].translation) + model[joint].translation;
+            palette[joint] = dualquaternion::fromRotationTranslation(rotation, translation);
+        }
+    }
+
+    void Skinning::SkinScalar(const SkinningData& data, const float3x4* palette, VertexStreams& output, uint32 begin, uint32 end) noexcept
+    {
+        const VertexStreams& input = data.bindVertices;
+        const bool normals = input.HasNormals();
+
+        for (uint32 v = begin; v < end; ++v)
+        {
+            const float3x4 blended = BlendPalette(palette, data.joints[v], data.weights[v]);
+
+            const float3 position = blended.transformPoint(float3(input.positionX[v], input.positionY[v], input.positionZ[v]));
+            output.positionX[v] = position.x;
+            output.positionY[v] = position.y;
+            output.positionZ[v] = position.z;
+
+            if (normals)
+            {
+                const float3 normal = blended.transformVector(float3(input.normalX[v], input.normalY[v], input.normalZ[v])).normalized();
+                output.normalX[v] = normal.x;
+                output.normalY[v] = normal.y;
+                output.normalZ[v] = normal.z;
+            }
+        }
+    }
+
+    /**
+     * Dual quaternion linear blending: influences in the opposite hemisphere of the first one are
+     * negated so every vertex blends along the shortest arc, then the sum is renormalized into a
+     * rigid transform. Normals are only rotated, so they stay unit length.
+     */
+    void Skinning::SkinDualQuaternionScalar(const SkinningData& data, const dualquaternion* palette, VertexStreams& output, uint32 begin, uint32 end) noexcept
+    {
+        const VertexStreams& input = data.bindVertices;
+        const bool normals = input.HasNormals();
+
+        for (uint32 v = begin; v < end; ++v)
+        {
+            const uint32 joints = data.joints[v];
+            const uint32 weights = data.weights[v];
+            const quaternion& first = palette[UnpackByte(joints, 0)].real;
+
+            float blended[8] = {};
+            for (uint32 i = 0; i < MAX_SKIN_INFLUENCES; ++i)
+            {
+                const dualquaternion& influence = palette[UnpackByte(joints, i)];
+                const float weight = static_cast<float>(UnpackByte(weights, i)) * WEIGHT_SCALE;
+                const float signedWeight = dot(influence.real, first) < 0.0f ? -weight : weight;
+                for (uint32 e = 0; e < 8; ++e)
+                {
+                    blended[e] += signedWeight * influence.data()[e];
+                }
+            }
+
+            const dualquaternion skin = dualquaternion(
+                quaternion(blended[0], blended[1], blended[2], blended[3]),
+                quaternion(blended[4], blended[5], blended[6], blended[7])).normalized();
+
+            const float3 position = skin.transformPoint(float3(input.positionX[v], input.positionY[v], input.positionZ[v]));
+            output.positionX[v] = position.x;
+            output.positionY[v] = position.y;
+            output.positionZ[v] = position.z;
+
+            if (normals)
+            {
+                const float3 normal = skin.transformVector(float3(input.normalX[v], input.normalY[v], input.normalZ[v]));
+                output.normalX[v] = normal.x;
+                output.normalY[v] = normal.y;
+                output.normalZ[v] = normal.z;
+            }
+        }
+    }
+
+#if defined(GINA_SSE2_ENABLED)
+    namespace
+    {
+        // Blended rows of one vertex's skinning matrix
+        struct BlendedRows
+        {
+            __m128 row0, row1, row2;
+        };
+
+        inline BlendedRows BlendRowsSSE2(const float3x4* palette, uint32 joints, uint32 weights) noexcept
+        {
+            BlendedRows rows = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+            for (uint32 i = 0; i < MAX_SKIN_INFLUENCES; ++i)
+            {
+                const __m128 weight = _mm_set1_ps(static_cast<float>(UnpackByte(weights, i)) * WEIGHT_SCALE);
+                const float3x4& matrix = palette[UnpackByte(joints, i)];
+                rows.row0 = _mm_add_ps(rows.row0, _mm_mul_ps(weight, _mm_loadu_ps(matrix.m[0])));
+                rows.row1 = _mm_add_ps(rows.row1, _mm_mul_ps(weight, _mm_loadu_ps(matrix.m[1])));
+                rows.row2 = _mm_add_ps(rows.row2, _mm_mul_ps(weight, _mm_loadu_ps(matrix.m[2])));
+            }
+            return rows;
+        }
+    }
+
+    /**
+     * Four vertices per iteration: each vertex blends its palette rows in registers, then the four
+     * blended matrices are transposed so that the transform runs on SoA position and normal lanes
+     */
+    void Skinning::SkinSSE2(const SkinningData& data, const float3x4* palette, VertexStreams& output, uint32 begin, uint32 end) noexcept
+    {
+        const VertexStreams& input = data.bindVertices;
+        const bool normals = input.HasNormals();
+        const __m128 minLengthSquared = _mm_set1_ps(std::numeric_limits<float>::min());
+
+        uint32 v = begin;
+        for (; v + 4 <= end; v += 4)
+        {
+            BlendedRows rows[4];
+            for (uint32 k = 0; k < 4; ++k)
+            {
+                rows[k] = BlendRowsSSE2(palette, data.joints[v + k], data.weights[v + k]);
+            }
+
+            // After transposing, mRC holds element (R, C) of the four matrices
+            __m128 m00 = rows[0].row0, m01 = rows[1].row0, m02 = rows[2].row0, m03 = rows[3].row0;
+            __m128 m10 = rows[0].row1, m11 = rows[1].row1, m12 = rows[2].row1, m13 = rows[3].row1;
+            __m128 m20 = rows[0].row2, m21 = rows[1].row2, m22 = rows[2].row2, m23 = rows[3].row2;
+            _MM_TRANSPOSE4_PS(m00, m01, m02, m03);
+            _MM_TRANSPOSE4_PS(m10, m11, m12, m13);
+            _MM_TRANSPOSE4_PS(m20, m21, m22, m23);
+
+            const __m128 px = _mm_loadu_ps(&input.positionX[v]);
+            const __m128 py = _mm_loadu_ps(&input.positionY[v]);
+            const __m128 pz = _mm_loadu_ps(&input.positionZ[v]);
+
+            _mm_storeu_ps(&output.positionX[v], _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, px), _mm_mul_ps(m01, py)), _mm_add_ps(_mm_mul_ps(m02, pz), m03)));
+            _mm_storeu_ps(&output.positionY[v], _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, px), _mm_mul_ps(m11, py)), _mm_add_ps(_mm_mul_ps(m12, pz), m13)));
+            _mm_storeu_ps(&output.positionZ[v], _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, px), _mm_mul_ps(m21, py)), _mm_add_ps(_mm_mul_ps(m22, pz), m23)));
+
+            if (normals)
+            {
+                const __m128 nx = _mm_loadu_ps(&input.normalX[v]);
+                const __m128 ny = _mm_loadu_ps(&input.normalY[v]);
+                const __m128 nz = _mm_loadu_ps(&input.normalZ[v]);
+
+                const __m128 sx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, nx), _mm_mul_ps(m01, ny)), _mm_mul_ps(m02, nz));
+                const __m128 sy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, nx), _mm_mul_ps(m11, ny)), _mm_mul_ps(m12, nz));
+                const __m128 sz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, nx), _mm_mul_ps(m21, ny)), _mm_mul_ps(m22, nz));
+
+                const __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, sx), _mm_mul_ps(sy, sy)), _mm_mul_ps(sz, sz));
+                const __m128 valid = _mm_cmpgt_ps(lengthSquared, minLengthSquared);
+                const __m128 invLength = _mm_and_ps(valid, _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_max_ps(lengthSquared, minLengthSquared))));
+
+                _mm_storeu_ps(&output.normalX[v], _mm_mul_ps(sx, invLength));
+                _mm_storeu_ps(&output.normalY[v], _mm_mul_ps(sy, invLength));
+                _mm_storeu_ps(&output.normalZ[v], _mm_mul_ps(sz, invLength));
+            }
+        }
+
+        SkinScalar(data, palette, output, v, end);
+    }
+
+    namespace
+    {
+        GINA_TARGET_AVX2 inline void Transpose4x4Lanes(__m256& r0, __m256& r1, __m256& r2, __m256& r3) noexcept
+        {
+            const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+            const __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+            const __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+            const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+            r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+            r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+            r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        }
+
+        GINA_TARGET_AVX2 inline __m256 MultiplyAdd3(__m256 a0, __m256 b0, __m256 a1, __m256 b1, __m256 a2, __m256 b2) noexcept
+        {
+            return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a0, b0), _mm256_mul_ps(a1, b1)), _mm256_mul_ps(a2, b2));
+        }
+    }
+
+    /**
+     * Eight vertices per iteration. A float3x4 is 12 contiguous floats, so each influence blends rows 0-1
+     * with one 256-bit load and row 2 with a 128-bit load. Vertices k and k + 4 are then paired in the two
+     * 128-bit lanes and an in-lane 4x4 transpose yields SoA matrix elements for all eight vertices.
+     */
+    GINA_TARGET_AVX2 void Skinning::SkinAVX2(const SkinningData& data, const float3x4* palette, VertexStreams& output, uint32 begin, uint32 end) noexcept
+    {
+        const VertexStreams& input = data.bindVertices;
+        const bool normals = input.HasNormals();
+        const __m256 minLengthSquared = _mm256_set1_ps(std::numeric_limits<float>::min());
+
+        uint32 v = begin;
+        for (; v + 8 <= end; v += 8)
+        {
+            __m256 rows01[8];
+            __m128 rows2[8];
+            for (uint32 k = 0; k < 8; ++k)
+            {
+                const uint32 joints = data.joints[v + k];
+                const uint32 weights = data.weights[v + k];
+
+                __m256 accumulated01 = _mm256_setzero_ps();
+                __m128 accumulated2 = _mm_setzero_ps();
+                for (uint32 i = 0; i < MAX_SKIN_INFLUENCES; ++i)
+                {
+                    const float weight = static_cast<float>(UnpackByte(weights, i)) * WEIGHT_SCALE;
+                    const float* matrix = palette[UnpackByte(joints, i)].data();
+                    accumulated01 = _mm256_add_ps(accumulated01, _mm256_mul_ps(_mm256_set1_ps(weight), _mm256_loadu_ps(matrix)));
+                    accumulated2 = _mm_add_ps(accumulated2, _mm_mul_ps(_mm_set1_ps(weight), _mm_loadu_ps(matrix + 8)));
+                }
+                rows01[k] = accumulated01;
+                rows2[k] = accumulated2;
+            }
+
+            __m256 m0[4], m1[4], m2[4];
+            for (uint32 k = 0; k < 4; ++k)
+            {
+                m0[k] = _mm256_permute2f128_ps(rows01[k], rows01[k + 4], 0x20);
+                m1[k] = _mm256_permute2f128_ps(rows01[k], rows01[k + 4], 0x31);
+                m2[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(rows2[k]), rows2[k + 4], 1);
+            }
+            Transpose4x4Lanes(m0[0], m0[1], m0[2], m0[3]);
+            Transpose4x4Lanes(m1[0], m1[1], m1[2], m1[3]);
+            Transpose4x4Lanes(m2[0], m2[1], m2[2], m2[3]);
+
+            const __m256 px = _mm256_loadu_ps(&input.positionX[v]);
+            const __m256 py = _mm256_loadu_ps(&input.positionY[v]);
+            const __m256 pz = _mm256_loadu_ps(&input.positionZ[v]);
+
+            _mm256_storeu_ps(&output.positionX[v], _mm256_add_ps(MultiplyAdd3(m0[0], px, m0[1], py, m0[2], pz), m0[3]));
+            _mm256_storeu_ps(&output.positionY[v], _mm256_add_ps(MultiplyAdd3(m1[0], px, m1[1], py, m1[2], pz), m1[3]));
+            _mm256_storeu_ps(&output.positionZ[v], _mm256_add_ps(MultiplyAdd3(m2[0], px, m2[1], py, m2[2], pz), m2[3]));
+
+            if (normals)
+            {
+                const __m256 nx = _mm256_loadu_ps(&input.normalX[v]);
+                const __m256 ny = _mm256_loadu_ps(&input.normalY[v]);
+                const __m256 nz = _mm256_loadu_ps(&input.normalZ[v]);
+
+                const __m256 sx = MultiplyAdd3(m0[0], nx, m0[1], ny, m0[2], nz);
+                const __m256 sy = MultiplyAdd3(m1[0], nx, m1[1], ny, m1[2], nz);
+                const __m256 sz = MultiplyAdd3(m2[0], nx, m2[1], ny, m2[2], nz);
+
+                const __m256 lengthSquared = MultiplyAdd3(sx, sx, sy, sy, sz, sz);
+                const __m256 valid = _mm256_cmp_ps(lengthSquared, minLengthSquared, _CMP_GT_OQ);
+                const __m256 invLength = _mm256_and_ps(valid,
+                    _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(_mm256_max_ps(lengthSquared, minLengthSquared))));
+
+                _mm256_storeu_ps(&output.normalX[v], _mm256_mul_ps(sx, invLength));
+                _mm256_storeu_ps(&output.normalY[v], _mm256_mul_ps(sy, invLength));
+                _mm256_storeu_ps(&output.normalZ[v], _mm256_mul_ps(sz, invLength));
+            }
+        }
+
+        SkinSSE2(data, palette, output, v, end);
+    }
+
+    namespace
+    {
+        // Four rigid transforms, or vectors, one per lane
+        struct DualQuaternion4
+        {
+            __m128 rx, ry, rz, rw;
+            __m128 dx, dy, dz, dw;
+        };
+
+        inline __m128 Dot3SSE2(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz) noexcept
+        {
+            return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+        }
+
+        // Rotates (x, y, z) in place: v + w * c + r x c with c = 2 * (r x v)
+        inline void RotateSSE2(const DualQuaternion4& q, __m128& x, __m128& y, __m128& z) noexcept
+        {
+            const __m128 two = _mm_set1_ps(2.0f);
+            const __m128 cx = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(q.ry, z), _mm_mul_ps(q.rz, y)));
+            const __m128 cy = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(q.rz, x), _mm_mul_ps(q.rx, z)));
+            const __m128 cz = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(q.rx, y), _mm_mul_ps(q.ry, x)));
+            x = _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(q.rw, cx)), _mm_sub_ps(_mm_mul_ps(q.ry, cz), _mm_mul_ps(q.rz, cy)));
+            y = _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(q.rw, cy)), _mm_sub_ps(_mm_mul_ps(q.rz, cx), _mm_mul_ps(q.rx, cz)));
+            z = _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(q.rw, cz)), _mm_sub_ps(_mm_mul_ps(q.rx, cy), _mm_mul_ps(q.ry, cx)));
+        }
+
+        // Applies blended and renormalized transforms to SoA streams [v, v + 4)
+        inline void TransformVerticesSSE2(const DualQuaternion4& q, const VertexStreams& input, VertexStreams& output, uint32 v) noexcept
+        {
+            // t = 2 * (w * d - dw * r + r x d)
+            const __m128 two = _mm_set1_ps(2.0f);
+            const __m128 tx = _mm_mul_ps(two, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(q.rw, q.dx), _mm_mul_ps(q.dw, q.rx)), _mm_sub_ps(_mm_mul_ps(q.ry, q.dz), _mm_mul_ps(q.rz, q.dy))));
+            const __m128 ty = _mm_mul_ps(two, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(q.rw, q.dy), _mm_mul_ps(q.dw, q.ry)), _mm_sub_ps(_mm_mul_ps(q.rz, q.dx), _mm_mul_ps(q.rx, q.dz))));
+            const __m128 tz = _mm_mul_ps(two, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(q.rw, q.dz), _mm_mul_ps(q.dw, q.rz)), _mm_sub_ps(_mm_mul_ps(q.rx, q.dy), _mm_mul_ps(q.ry, q.dx))));
+
+            __m128 px = _mm_loadu_ps(&input.positionX[v]);
+            __m128 py = _mm_loadu_ps(&input.positionY[v]);
+            __m128 pz = _mm_loadu_ps(&input.positionZ[v]);
+            RotateSSE2(q, px, py, pz);
+            _mm_storeu_ps(&output.positionX[v], _mm_add_ps(px, tx));
+            _mm_storeu_ps(&output.positionY[v], _mm_add_ps(py, ty));
+            _mm_storeu_ps(&output.positionZ[v], _mm_add_ps(pz, tz));
+
+            if (input.HasNormals())
+            {
+                __m128 nx = _mm_loadu_ps(&input.normalX[v]);
+                __m128 ny = _mm_loadu_ps(&input.normalY[v]);
+                __m128 nz = _mm_loadu_ps(&input.normalZ[v]);
+                RotateSSE2(q, nx, ny, nz);
+                _mm_storeu_ps(&output.normalX[v], nx);
+                _mm_storeu_ps(&output.normalY[v], ny);
+                _mm_storeu_ps(&output.normalZ[v], nz);
+            }
+        }
+    }
+
+    /**
+     * Four joints per iteration in SoA form: rotation = model * inverseBind, translation = model rotation
+     * applied to the inverse bind translation plus the model translation, dual = 0.5 * translation * rotation
+     */
+    void Skinning::ConvertPaletteSSE2(const Transform* inverseBind, const Transform* model, uint32 count, dualquaternion* palette) noexcept
+    {
+        const __m128 half = _mm_set1_ps(0.5f);
+
+        uint32 joint = 0;
+        for (; joint + 4 <= count; joint += 4)
+        {
+            // The fourth translation lane reads scale.x, which is never used
+            __m128 mx = _mm_loadu_ps(model[joint + 0].rotation.data()), my = _mm_loadu_ps(model[joint + 1].rotation.data());
+            __m128 mz = _mm_loadu_ps(model[joint + 2].rotation.data()), mw = _mm_loadu_ps(model[joint + 3].rotation.data());
+            __m128 ix = _mm_loadu_ps(inverseBind[joint + 0].rotation.data()), iy = _mm_loadu_ps(inverseBind[joint + 1].rotation.data());
+            __m128 iz = _mm_loadu_ps(inverseBind[joint + 2].rotation.data()), iw = _mm_loadu_ps(inverseBind[joint + 3].rotation.data());
+            __m128 mtx = _mm_loadu_ps(&model[joint + 0].translation.x), mty = _mm_loadu_ps(&model[joint + 1].translation.x);
+            __m128 mtz = _mm_loadu_ps(&model[joint + 2].translation.x), mtw = _mm_loadu_ps(&model[joint + 3].translation.x);
+            __m128 itx = _mm_loadu_ps(&inverseBind[joint + 0].translation.x), ity = _mm_loadu_ps(&inverseBind[joint + 1].translation.x);
+            __m128 itz = _mm_loadu_ps(&inverseBind[joint + 2].translation.x), itw = _mm_loadu_ps(&inverseBind[joint + 3].translation.x);
+            _MM_TRANSPOSE4_PS(mx, my, mz, mw);
+            _MM_TRANSPOSE4_PS(ix, iy, iz, iw);
+            _MM_TRANSPOSE4_PS(mtx, mty, mtz, mtw);
+            _MM_TRANSPOSE4_PS(itx, ity, itz, itw);
+
+            DualQuaternion4 q;
+            q.rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(mw, ix), _mm_mul_ps(mx, iw)), _mm_sub_ps(_mm_mul_ps(my, iz), _mm_mul_ps(mz, iy)));
+            q.ry = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(mw, iy), _mm_mul_ps(mx, iz)), _mm_add_ps(_mm_mul_ps(my, iw), _mm_mul_ps(mz, ix)));
+            q.rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(mw, iz), _mm_mul_ps(mx, iy)), _mm_sub_ps(_mm_mul_ps(mz, iw), _mm_mul_ps(my, ix)));
+            q.rw = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(mw, iw), _mm_mul_ps(mx, ix)), _mm_add_ps(_mm_mul_ps(my, iy), _mm_mul_ps(mz, iz)));
+
+            const DualQuaternion4 modelRotation = { mx, my, mz, mw, mx, my, mz, mw };
+            RotateSSE2(modelRotation, itx, ity, itz);
+            const __m128 tx = _mm_mul_ps(half, _mm_add_ps(itx, mtx));
+            const __m128 ty = _mm_mul_ps(half, _mm_add_ps(ity, mty));
+            const __m128 tz = _mm_mul_ps(half, _mm_add_ps(itz, mtz));
+
+            q.dx = _mm_add_ps(_mm_mul_ps(tx, q.rw), _mm_sub_ps(_mm_mul_ps(ty, q.rz), _mm_mul_ps(tz, q.ry)));
+            q.dy = _mm_add_ps(_mm_mul_ps(ty, q.rw), _mm_sub_ps(_mm_mul_ps(tz, q.rx), _mm_mul_ps(tx, q.rz)));
+            q.dz = _mm_add_ps(_mm_mul_ps(tz, q.rw), _mm_sub_ps(_mm_mul_ps(tx, q.ry), _mm_mul_ps(ty, q.rx)));
+            q.dw = _mm_sub_ps(_mm_setzero_ps(), Dot3SSE2(tx, ty, tz, q.rx, q.ry, q.rz));
+
+            _MM_TRANSPOSE4_PS(q.rx, q.ry, q.rz, q.rw);
+            _MM_TRANSPOSE4_PS(q.dx, q.dy, q.dz, q.dw);
+            _mm_storeu_ps(palette[joint + 0].real.data(), q.rx);
+            _mm_storeu_ps(palette[joint + 1].real.data(), q.ry);
+            _mm_storeu_ps(palette[joint + 2].real.data(), q.rz);
+            _mm_storeu_ps(palette[joint + 3].real.data(), q.rw);
+            _mm_storeu_ps(palette[joint + 0].dual.data(), q.dx);
+            _mm_storeu_ps(palette[joint + 1].dual.data(), q.dy);
+            _mm_storeu_ps(palette[joint + 2].dual.data(), q.dz);
+            _mm_storeu_ps(palette[joint + 3].dual.data(), q.dw);
+        }
+
+        ConvertPaletteScalar(inverseBind + joint, model + joint, count - joint, palette + joint);
+    }
+
+    void Skinning::SkinDualQuaternionSSE2(const SkinningData& data, const dualquaternion* palette, VertexStreams& output, uint32 begin, uint32 end) noexcept
+    {
+        const __m128 weightScale = _mm_set1_ps(WEIGHT_SCALE);
+        const __m128i byteMask = _mm_set1_epi32(0xFF);
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 minLengthSquared = _mm_set1_ps(std::numeric_limits<float>::min());
+
+        uint32 v = begin;
+        for (; v + 4 <= end; v += 4)
+        {
+            const __m128i packedWeights = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data.weights[v]));
+
+            DualQuaternion4 blended;
+            blended.rx = blended.ry = blended.rz = blended.rw = _mm_setzero_ps();
+            blended.dx = blended.dy = blended.dz = blended.dw = _mm_setzero_ps();
+            __m128 fx = _mm_setzero_ps(), fy = _mm_setzero_ps(), fz = _mm_setzero_ps(), fw = _mm_setzero_ps();
+
+            for (uint32 i = 0; i < MAX_SKIN_INFLUENCES; ++i)
+            {
+                const dualquaternion& q0 = palette[UnpackByte(data.joints[v + 0], i)];
+                const dualquaternion& q1 = palette[UnpackByte(data.joints[v + 1], i)];
+                const dualquaternion& q2 = palette[UnpackByte(data.joints[v + 2], i)];
+                const dualquaternion& q3 = palette[UnpackByte(data.joints[v + 3], i)];
+
+                __m128 rx = _mm_loadu_ps(q0.real.data()), ry = _mm_loadu_ps(q1.real.data());
+                __m128 rz = _mm_loadu_ps(q2.real.data()), rw = _mm_loadu_ps(q3.real.data());
+                __m128 dx = _mm_loadu_ps(q0.dual.data()), dy = _mm_loadu_ps(q1.dual.data());
+                __m128 dz = _mm_loadu_ps(q2.dual.data()), dw = _mm_loadu_ps(q3.dual.data());
+                _MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+                _MM_TRANSPOSE4_PS(dx, dy, dz, dw);
+
+                const __m128i byteWeights = _mm_and_si128(_mm_srl_epi32(packedWeights, _mm_cvtsi32_si128(static_cast<int>(i * 8))), byteMask);
+                __m128 weight = _mm_mul_ps(_mm_cvtepi32_ps(byteWeights), weightScale);
+                if (i == 0)
+                {
+                    fx = rx; fy = ry; fz = rz; fw = rw;
+                }
+                else
+                {
+                    const __m128 hemisphere = _mm_add_ps(Dot3SSE2(rx, ry, rz, fx, fy, fz), _mm_mul_ps(rw, fw));
+                    weight = _mm_xor_ps(weight, _mm_and_ps(_mm_cmplt_ps(hemisphere, _mm_setzero_ps()), signMask));
+                }
+
+                blended.rx = _mm_add_ps(blended.rx, _mm_mul_ps(weight, rx));
+                blended.ry = _mm_add_ps(blended.ry, _mm_mul_ps(weight, ry));
+                blended.rz = _mm_add_ps(blended.rz, _mm_mul_ps(weight, rz));
+                blended.rw = _mm_add_ps(blended.rw, _mm_mul_ps(weight, rw));
+                blended.dx = _mm_add_ps(blended.dx, _mm_mul_ps(weight, dx));
+                blended.dy = _mm_add_ps(blended.dy, _mm_mul_ps(weight, dy));
+                blended.dz = _mm_add_ps(blended.dz, _mm_mul_ps(weight, dz));
+                blended.dw = _mm_add_ps(blended.dw, _mm_mul_ps(weight, dw));
+            }
+
+            const __m128 lengthSquared = _mm_add_ps(Dot3SSE2(blended.rx, blended.ry, blended.rz, blended.rx, blended.ry, blended.rz), _mm_mul_ps(blended.rw, blended.rw));
+            const __m128 invLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_max_ps(lengthSquared, minLengthSquared)));
+            blended.rx = _mm_mul_ps(blended.rx, invLength);
+            blended.ry = _mm_mul_ps(blended.ry, invLength);
+            blended.rz = _mm_mul_ps(blended.rz, invLength);
+            blended.rw = _mm_mul_ps(blended.rw, invLength);
+            blended.dx = _mm_mul_ps(blended.dx, invLength);
+            blended.dy = _mm_mul_ps(blended.dy, invLength);
+            blended.dz = _mm_mul_ps(blended.dz, invLength);
+            blended.dw = _mm_mul_ps(blended.dw, invLength);
+
+            TransformVerticesSSE2(blended, data.bindVertices, output, v);
+        }
+
+        SkinDualQuaternionScalar(data, palette, output, v, end);
+    }
+
+    namespace
+    {
+        // Eight rigid transforms, or vectors, one per lane
+        struct DualQuaternion8
+        {
+            __m256 rx, ry, rz, rw;
+            __m256 dx, dy, dz, dw;
+        };
+
+        GINA_TARGET_AVX2 inline void RotateAVX2(const DualQuaternion8& q, __m256& x, __m256& y, __m256& z) noexcept
+        {
+            const __m256 two = _mm256_set1_ps(2.0f);
+            const __m256 cx = _mm256_mul_ps(two, _mm256_sub_ps(_mm256_mul_ps(q.ry, z), _mm256_mul_ps(q.rz, y)));
+            const __m256 cy = _mm256_mul_ps(two, _mm256_sub_ps(_mm256_mul_ps(q.rz, x), _mm256_mul_ps(q.rx, z)));
+            const __m256 cz = _mm256_mul_ps(two, _mm256_sub_ps(_mm256_mul_ps(q.rx, y), _mm256_mul_ps(q.ry, x)));
+            x = _mm256_add_ps(_mm256_add_ps(x, _mm256_mul_ps(q.rw, cx)), _mm256_sub_ps(_mm256_mul_ps(q.ry, cz), _mm256_mul_ps(q.rz, cy)));
+            y = _mm256_add_ps(_mm256_add_ps(y, _mm256_mul_ps(q.rw, cy)), _mm256_sub_ps(_mm256_mul_ps(q.rz, cx), _mm256_mul_ps(q.rx, cz)));
+            z = _mm256_add_ps(_mm256_add_ps(z, _mm256_mul_ps(q.rw, cz)), _mm256_sub_ps(_mm256_mul_ps(q.rx, cy), _mm256_mul_ps(q.ry, cx)));
+        }
+
+        GINA_TARGET_AVX2 inline void TransformVerticesAVX2(const DualQuaternion8& q, const VertexStreams& input, VertexStreams& output, uint32 v) noexcept
+        {
+            const __m256 two = _mm256_set1_ps(2.0f);
+            const __m256 tx = _mm256_mul_ps(two, _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(q.rw, q.dx), _mm256_mul_ps(q.dw, q.rx)), _mm256_sub_ps(_mm256_mul_ps(q.ry, q.dz), _mm256_mul_ps(q.rz, q.dy))));
+            const __m256 ty = _mm256_mul_ps(two, _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(q.rw, q.dy), _mm256_mul_ps(q.dw, q.ry)), _mm256_sub_ps(_mm256_mul_ps(q.rz, q.dx), _mm256_mul_ps(q.rx, q.dz))));
+            const __m256 tz = _mm256_mul_ps(two, _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(q.rw, q.dz), _mm256_mul_ps(q.dw, q.rz)), _mm256_sub_ps(_mm256_mul_ps(q.rx, q.dy), _mm256_mul_ps(q.ry, q.dx))));
+
+            __m256 px = _mm256_loadu_ps(&input.positionX[v]);
+            __m256 py = _mm256_loadu_ps(&input.positionY[v]);
+            __m256 pz = _mm256_loadu_ps(&input.positionZ[v]);
+            RotateAVX2(q, px, py, pz);
+            _mm256_storeu_ps(&output.positionX[v], _mm256_add_ps(px, tx));
+            _mm256_storeu_ps(&output.positionY[v], _mm256_add_ps(py, ty));
+            _mm256_storeu_ps(&output.positionZ[v], _mm256_add_ps(pz, tz));
+
+            if (input.HasNormals())
+            {
+                __m256 nx = _mm256_loadu_ps(&input.normalX[v]);
+                __m256 ny = _mm256_loadu_ps(&input.normalY[v]);
+                __m256 nz = _mm256_loadu_ps(&input.normalZ[v]);
+                RotateAVX2(q, nx, ny, nz);
+                _mm256_storeu_ps(&output.normalX[v], nx);
+                _mm256_storeu_ps(&output.normalY[v], ny);
+                _mm256_storeu_ps(&output.normalZ[v], nz);
+            }
+        }
+    }
+
+    /**
+     * Eight vertices per iteration. A dual quaternion is eight floats, so each influence gathers its
+     * components straight into SoA lanes with the vertex joint indices scaled to palette offsets.
+     */
+    GINA_TARGET_AVX2 void Skinning::SkinDualQuaternionAVX2(const SkinningData& data, const dualquaternion* palette, VertexStreams& output, uint32 begin, uint32 end) noexcept
+    {
+        const __m256 weightScale = _mm256_set1_ps(WEIGHT_SCALE);
+        const __m256i byteMask = _mm256_set1_epi32(0xFF);
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        const __m256 minLengthSquared = _mm256_set1_ps(std::numeric_limits<float>::min());
+        const float* base = palette->data();
+
+        uint32 v = begin;
+        for (; v + 8 <= end; v += 8)
+        {
+            const __m256i packedJoints = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&data.joints[v]));
+            const __m256i packedWeights = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&data.weights[v]));
+
+            DualQuaternion8 blended;
+            blended.rx = blended.ry = blended.rz = blended.rw = _mm256_setzero_ps();
+            blended.dx = blended.dy = blended.dz = blended.dw = _mm256_setzero_ps();
+            __m256 fx = _mm256_setzero_ps(), fy = _mm256_setzero_ps(), fz = _mm256_setzero_ps(), fw = _mm256_setzero_ps();
+
+            for (uint32 i = 0; i < MAX_SKIN_INFLUENCES; ++i)
+            {
+                const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(i * 8));
+                const __m256i offsets = _mm256_slli_epi32(_mm256_and_si256(_mm256_srl_epi32(packedJoints, shift), byteMask), 3);
+
+                const __m256 rx = _mm256_i32gather_ps(base + 0, offsets, 4);
+                const __m256 ry = _mm256_i32gather_ps(base + 1, offsets, 4);
+                const __m256 rz = _mm256_i32gather_ps(base + 2, offsets, 4);
+                const __m256 rw = _mm256_i32gather_ps(base + 3, offsets, 4);
+                const __m256 dx = _mm256_i32gather_ps(base + 4, offsets, 4);
+                const __m256 dy = _mm256_i32gather_ps(base + 5, offsets, 4);
+                const __m256 dz = _mm256_i32gather_ps(base + 6, offsets, 4);
+                const __m256 dw = _mm256_i32gather_ps(base + 7, offsets, 4);
+
+                __m256 weight = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srl_epi32(packedWeights, shift), byteMask)), weightScale);
+                if (i == 0)
+                {
+                    fx = rx; fy = ry; fz = rz; fw = rw;
+                }
+                else
+                {
+                    const __m256 hemisphere = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(rx, fx), _mm256_mul_ps(ry, fy)), _mm256_add_ps(_mm256_mul_ps(rz, fz), _mm256_mul_ps(rw, fw)));
+                    weight = _mm256_xor_ps(weight, _mm256_and_ps(_mm256_cmp_ps(hemisphere, _mm256_setzero_ps(), _CMP_LT_OQ), signMask));
+                }
+
+                blended.rx = _mm256_add_ps(blended.rx, _mm256_mul_ps(weight, rx));
+                blended.ry = _mm256_add_ps(blended.ry, _mm256_mul_ps(weight, ry));
+                blended.rz = _mm256_add_ps(blended.rz, _mm256_mul_ps(weight, rz));
+                blended.rw = _mm256_add_ps(blended.rw, _mm256_mul_ps(weight, rw));
+                blended.dx = _mm256_add_ps(blended.dx, _mm256_mul_ps(weight, dx));
+                blended.dy = _mm256_add_ps(blended.dy, _mm256_mul_ps(weight, dy));
+                blended.dz = _mm256_add_ps(blended.dz, _mm256_mul_ps(weight, dz));
+                blended.dw = _mm256_add_ps(blended.dw, _mm256_mul_ps(weight, dw));
+            }
+
+            const __m256 lengthSquared = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(blended.rx, blended.rx), _mm256_mul_ps(blended.ry, blended.ry)),
+                _mm256_add_ps(_mm256_mul_ps(blended.rz, blended.rz), _mm256_mul_ps(blended.rw, blended.rw)));
+            const __m256 invLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(_mm256_max_ps(lengthSquared, minLengthSquared)));
+            blended.rx = _mm256_mul_ps(blended.rx, invLength);
+            blended.ry = _mm256_mul_ps(blended.ry, invLength);
+            blended.rz = _mm256_mul_ps(blended.rz, invLength);
+            blended.rw = _mm256_mul_ps(blended.rw, invLength);
+            blended.dx = _mm256_mul_ps(blended.dx, invLength);
+            blended.dy = _mm256_mul_ps(blended.dy, invLength);
+            blended.dz = _mm256_mul_ps(blended.dz, invLength);
+            blended.dw = _mm256_mul_ps(blended.dw, invLength);
+
+            TransformVerticesAVX2(blended, data.bindVertices, output, v);
+        }
+
+        SkinDualQuaternionSSE2(data, palette, output, v, end);
+    }
+#endif
+}
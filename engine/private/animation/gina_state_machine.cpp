@@ -0,0 +1,366 @@
+#include "animation/gina_state_machine.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "animation/gina_pose.h"
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    uint16 StateMachine::AddParameter(const std::string& name)
+    {
+        GINA_ASSERT_MSG(FindParameter(name) == INVALID_STATE_PARAMETER, "Duplicate state machine parameter");
+        parameterNames.push_back(name);
+        return static_cast<uint16>(parameterNames.size() - 1);
+    }
+
+    uint16 StateMachine::FindParameter(const std::string& name) const noexcept
+    {
+        for (uint32 i = 0; i < parameterNames.size(); ++i)
+        {
+            if (parameterNames[i] == name)
+            {
+                return static_cast<uint16>(i);
+            }
+        }
+        return INVALID_STATE_PARAMETER;
+    }
+
+    uint16 StateMachine::AddState(const std::string& name, const BlendTree* tree)
+    {
+        GINA_ASSERT_MSG(tree != nullptr, "State without a blend tree");
+        GINA_ASSERT_MSG(states.size() < ANY_ANIMATION_STATE, "Too many animation states");
+        GINA_ASSERT_MSG(FindState(name) == INVALID_ANIMATION_STATE, "Duplicate animation state");
+
+        AnimationState state;
+        state.name = name;
+        state.tree = tree;
+        for (const std::string& parameterName : tree->parameterNames)
+        {
+            const uint16 parameter = FindParameter(parameterName);
+            state.parameterMap.push_back(parameter != INVALID_STATE_PARAMETER ? parameter : AddParameter(parameterName));
+        }
+
+        states.push_back(std::move(state));
+        const uint16 index = static_cast<uint16>(states.size() - 1);
+        if (defaultState == INVALID_ANIMATION_STATE)
+        {
+            defaultState = index;
+        }
+        return index;
+    }
+
+    uint16 StateMachine::FindState(const std::string& name) const noexcept
+    {
+        for (uint32 i = 0; i < states.size(); ++i)
+        {
+            if (states[i].name == name)
+            {
+                return static_cast<uint16>(i);
+            }
+        }
+        return INVALID_ANIMATION_STATE;
+    }
+
+    uint16 StateMachine::AddTransition(uint16 from, uint16 to, float duration, CrossFadeCurve curve)
+    {
+        GINA_ASSERT_MSG(from == ANY_ANIMATION_STATE || from < states.size(), "Transition from an unknown state");
+        GINA_ASSERT_MSG(to < states.size(), "Transition to an unknown state");
+        GINA_ASSERT_MSG(transitions.size() < INVALID_ANIMATION_TRANSITION, "Too many animation transitions");
+
+        AnimationTransition transition;
+        transition.from = from;
+        transition.to = to;
+        transition.duration = std::max(duration, 0.0f);
+        transition.curve = curve;
+        transitions.push_back(std::move(transition));
+
+        const uint16 index = static_cast<uint16>(transitions.size() - 1);
+        (from == ANY_ANIMATION_STATE ? anyStateTransitions : states[from].transitions).push_back(index);
+        return index;
+    }
+
+    void StateMachine::AddCondition(uint16 transition, uint16 parameter, TransitionCompare compare, float threshold)
+    {
+        GINA_ASSERT_MSG(transition < transitions.size(), "Condition on an unknown transition");
+        GINA_ASSERT_MSG(parameter < parameterNames.size(), "Condition on an unknown parameter");
+
+        // Keep each transition's conditions contiguous when they are not added in transition order
+        AnimationTransition& target = transitions[transition];
+        if (target.conditionCount == 0)
+        {
+            target.firstCondition = static_cast<uint32>(conditions.size());
+        }
+        const uint32 insertAt = target.firstCondition + target.conditionCount;
+        conditions.insert(conditions.begin() + insertAt, { parameter, compare, threshold });
+        target.conditionCount++;
+        for (AnimationTransition& other : transitions)
+        {
+            if (&other != &target && other.conditionCount > 0 && other.firstCondition >= insertAt)
+            {
+                other.firstCondition++;
+            }
+        }
+
+        // Watches stay sorted by parameter, then by transition priority
+        std::vector<TransitionWatch>& watches = target.from == ANY_ANIMATION_STATE ? anyStateWatches : states[target.from].watches;
+        const TransitionWatch watch = { parameter, transition };
+        auto less = [](const TransitionWatch& a, const TransitionWatch& b)
+        {
+            return a.parameter != b.parameter ? a.parameter < b.parameter : a.transition < b.transition;
+        };
+
+        auto it = std::lower_bound(watches.begin(), watches.end(), watch, less);
+        if (it == watches.end() || it->parameter != parameter || it->transition != transition)
+        {
+            watches.insert(it, watch);
+        }
+    }
+
+    void StateMachineInstance::Initialize(const StateMachine& stateMachine)
+    {
+        machine = &stateMachine;
+
+        const uint32 parameterCount = stateMachine.GetParameterCount();
+        parameters.assign(parameterCount, 0.0f);
+        dirtyFlags.assign(parameterCount, 0);
+        dirtyParameters.clear();
+        dirtyParameters.reserve(parameterCount);
+
+        size_t treeParameterCount = 0;
+        for (const AnimationState& state : stateMachine.states)
+        {
+            treeParameterCount = std::max(treeParameterCount, state.parameterMap.size());
+        }
+        treeParameters.assign(treeParameterCount, 0.0f);
+
+        currentState = INVALID_ANIMATION_STATE;
+        currentTime = 0.0f;
+        previousState = INVALID_ANIMATION_STATE;
+        previousTime = 0.0f;
+        fadeTime = 0.0f;
+        fadeTransition = INVALID_ANIMATION_TRANSITION;
+        stateEntered = false;
+    }
+
+    void StateMachineInstance::SetParameter(uint16 parameter, float value)
+    {
+        if (parameters[parameter] == value)
+        {
+            return;
+        }
+
+        parameters[parameter] = value;
+        if (!dirtyFlags[parameter])
+        {
+            dirtyFlags[parameter] = 1;
+            dirtyParameters.push_back(parameter);
+        }
+    }
+
+    namespace
+    {
+        bool Compare(TransitionCompare compare, float value, float threshold) noexcept
+        {
+            switch (compare)
+            {
+            case TransitionCompare::Greater:        return value > threshold;
+            case TransitionCompare::GreaterEqual:   return value >= threshold;
+            case TransitionCompare::Less:           return value < threshold;
+            case TransitionCompare::LessEqual:      return value <= threshold;
+            case TransitionCompare::Equal:          return value == threshold;
+            case TransitionCompare::NotEqual:       return value != threshold;
+            }
+            return false;
+        }
+
+        // Highest priority satisfied transition of the list, or best if that one comes first
+        uint16 SelectFromAll(const StateMachine& machine, const std::vector<uint16>& candidates, const StateMachineInstance& instance, uint16 best) noexcept
+        {
+            for (uint16 transition : candidates)
+            {
+                if (transition >= best)
+                {
+                    break;
+                }
+
+                const AnimationTransition& candidate = machine.transitions[transition];
+                if (candidate.to != instance.currentState && StateMachineEvaluator::IsSatisfied(machine, transition, instance.parameters.data()))
+                {
+                    return transition;
+                }
+            }
+            return best;
+        }
+
+        // Same, restricted to the transitions that read a dirty parameter
+        uint16 SelectFromWatches(const StateMachine& machine, const std::vector<TransitionWatch>& watches, const StateMachineInstance& instance, uint16 best) noexcept
+        {
+            if (watches.empty())
+            {
+                return best;
+            }
+
+            for (uint16 parameter : instance.dirtyParameters)
+            {
+                auto it = std::lower_bound(watches.begin(), watches.end(), parameter,
+                    [](const TransitionWatch& watch, uint16 value) { return watch.parameter < value; });
+
+                for (; it != watches.end() && it->parameter == parameter && it->transition < best; ++it)
+                {
+                    const AnimationTransition& candidate = machine.transitions[it->transition];
+                    if (candidate.to != instance.currentState && StateMachineEvaluator::IsSatisfied(machine, it->transition, instance.parameters.data()))
+                    {
+                        best = it->transition;
+                        break;
+                    }
+                }
+            }
+            return best;
+        }
+
+        void EvaluateState(StateMachineInstance& instance, uint16 stateIndex, float time, BlendCommandList& commands,
+            uint32 jointCount, Transform* local)
+        {
+            const AnimationState& state = instance.machine->states[stateIndex];
+            for (size_t i = 0; i < state.parameterMap.size(); ++i)
+            {
+                instance.treeParameters[i] = instance.parameters[state.parameterMap[i]];
+            }
+
+            BlendTreeEvaluator::Compile(*state.tree, instance.treeParameters.data(), commands);
+            BlendTreeEvaluator::Execute(*state.tree, commands, time, jointCount, instance.scratch, local);
+        }
+    }
+
+    /**
+     * Conditions are only re-evaluated for transitions watching a parameter that changed since the last
+     * update, plus every transition of a freshly entered state. Any-state transitions win over those of
+     * the current state and, within each list, the one added first wins, so the outcome does not depend
+     * on the order parameters changed in. A transition started while fading fades out of the state being
+     * faded to and drops the older one.
+     */
+    uint16 StateMachineEvaluator::Update(StateMachineInstance& instance, float deltaTime)
+    {
+        GINA_ASSERT_MSG(instance.machine != nullptr, "State machine instance used before Initialize");
+        const StateMachine& machine = *instance.machine;
+
+        instance.currentTime += deltaTime;
+        if (instance.IsFading())
+        {
+            instance.previousTime += deltaTime;
+            instance.fadeTime += deltaTime;
+            if (instance.fadeTime >= machine.transitions[instance.fadeTransition].duration)
+            {
+                instance.previousState = INVALID_ANIMATION_STATE;
+                instance.fadeTransition = INVALID_ANIMATION_TRANSITION;
+            }
+        }
+
+        if (instance.currentState == INVALID_ANIMATION_STATE)
+        {
+            if (machine.defaultState == INVALID_ANIMATION_STATE)
+            {
+                return INVALID_ANIMATION_TRANSITION;
+            }
+
+            instance.currentState = machine.defaultState;
+            instance.currentTime = 0.0f;
+            instance.stateEntered = true;
+        }
+
+        const AnimationState& state = machine.states[instance.currentState];
+        uint16 selected = INVALID_ANIMATION_TRANSITION;
+        if (instance.stateEntered)
+        {
+            selected = SelectFromAll(machine, machine.anyStateTransitions, instance, selected);
+            if (selected == INVALID_ANIMATION_TRANSITION)
+            {
+                selected = SelectFromAll(machine, state.transitions, instance, selected);
+            }
+        }
+        else if (!instance.dirtyParameters.empty())
+        {
+            selected = SelectFromWatches(machine, machine.anyStateWatches, instance, selected);
+            if (selected == INVALID_ANIMATION_TRANSITION)
+            {
+                selected = SelectFromWatches(machine, state.watches, instance, selected);
+            }
+        }
+
+        for (uint16 parameter : instance.dirtyParameters)
+        {
+            instance.dirtyFlags[parameter] = 0;
+        }
+        instance.dirtyParameters.clear();
+        instance.stateEntered = false;
+
+        if (selected == INVALID_ANIMATION_TRANSITION)
+        {
+            return selected;
+        }
+
+        const AnimationTransition& transition = machine.transitions[selected];
+        instance.previousState = transition.duration > 0.0f ? instance.currentState : INVALID_ANIMATION_STATE;
+        instance.previousTime = instance.currentTime;
+        instance.fadeTime = 0.0f;
+        instance.fadeTransition = transition.duration > 0.0f ? selected : INVALID_ANIMATION_TRANSITION;
+        instance.currentState = transition.to;
+        instance.currentTime = 0.0f;
+        instance.stateEntered = true;
+        std::swap(instance.commands[0], instance.commands[1]);
+        return selected;
+    }
+
+    void StateMachineEvaluator::Evaluate(StateMachineInstance& instance, uint32 jointCount, Transform* local)
+    {
+        if (instance.currentState == INVALID_ANIMATION_STATE)
+        {
+            return;
+        }
+
+        EvaluateState(instance, instance.currentState, instance.currentTime, instance.commands[0], jointCount, local);
+        if (!instance.IsFading())
+        {
+            return;
+        }
+
+        if (instance.fadePose.size() < jointCount)
+        {
+            instance.fadePose.resize(jointCount);
+        }
+        EvaluateState(instance, instance.previousState, instance.previousTime, instance.commands[1], jointCount, instance.fadePose.data());
+
+        const AnimationTransition& transition = instance.machine->transitions[instance.fadeTransition];
+        const float weight = EvaluateCurve(transition.curve, instance.fadeTime / transition.duration);
+        PoseOps::Blend(instance.fadePose.data(), local, weight, jointCount, local);
+    }
+
+    bool StateMachineEvaluator::IsSatisfied(const StateMachine& machine, uint16 transition, const float* parameters) noexcept
+    {
+        const AnimationTransition& target = machine.transitions[transition];
+        const TransitionCondition* conditions = machine.conditions.data() + target.firstCondition;
+        for (uint32 i = 0; i < target.conditionCount; ++i)
+        {
+            const TransitionCondition& condition = conditions[i];
+            if (!Compare(condition.compare, parameters[condition.parameter], condition.threshold))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    float StateMachineEvaluator::EvaluateCurve(CrossFadeCurve curve, float t) noexcept
+    {
+        t = std::clamp(t, 0.0f, 1.0f);
+        switch (curve)
+        {
+        case CrossFadeCurve::SmoothStep:    return t * t * (3.0f - 2.0f * t);
+        case CrossFadeCurve::EaseIn:        return t * t;
+        case CrossFadeCurve::EaseOut:       return 1.0f - (1.0f - t) * (1.0f - t);
+        default:                            return t;
+        }
+    }
+}
@@ -0,0 +1,138 @@
+#include "asset/gina_mesh_asset.h"
+
+#include "core/gina_logger.h"
+
+namespace gina
+{
+    namespace
+    {
+        void WriteMesh(BinaryWriter& writer, const Mesh& mesh)
+        {
+            writer.WriteString(mesh.name);
+            writer.WriteArray(mesh.positions);
+            writer.WriteArray(mesh.normals);
+            writer.WriteArray(mesh.texcoords);
+            writer.WriteArray(mesh.skinning);
+            writer.WriteArray(mesh.indices);
+
+            writer.Write(static_cast<uint32>(mesh.jointNames.size()));
+            for (const std::string& jointName : mesh.jointNames)
+            {
+                writer.WriteString(jointName);
+            }
+        }
+
+        void WriteMeshlets(BinaryWriter& writer, const MeshletData& meshlets)
+        {
+            writer.WriteArray(meshlets.meshlets);
+            writer.WriteArray(meshlets.bounds);
+            writer.WriteArray(meshlets.vertices);
+            writer.WriteArray(meshlets.triangles);
+        }
+
+        void WriteLods(BinaryWriter& writer, const MeshAsset& asset)
+        {
+            writer.WriteArray(asset.lods);
+            writer.WriteArray(asset.lodIndices);
+        }
+
+        bool ReadMesh(BinaryReader& reader, Mesh& mesh)
+        {
+            if (!reader.ReadString(mesh.name)) return false;
+            if (!reader.ReadArray(mesh.positions)) return false;
+            if (!reader.ReadArray(mesh.normals)) return false;
+            if (!reader.ReadArray(mesh.texcoords)) return false;
+            if (!reader.ReadArray(mesh.skinning)) return false;
+            if (!reader.ReadArray(mesh.indices)) return false;
+
+            uint32 jointCount = 0;
+            if (!reader.Read(jointCount)) return false;
+
+            mesh.jointNames.resize(jointCount);
+            for (std::string& jointName : mesh.jointNames)
+            {
+                if (!reader.ReadString(jointName)) return false;
+            }
+
+            return true;
+        }
+
+        bool ReadMeshlets(BinaryReader& reader, MeshletData& meshlets)
+        {
+            return reader.ReadArray(meshlets.meshlets) &&
+                reader.ReadArray(meshlets.bounds) &&
+                reader.ReadArray(meshlets.vertices) &&
+                reader.ReadArray(meshlets.triangles);
+        }
+
+        bool ReadLods(BinaryReader& reader, MeshAsset& asset)
+        {
+            return reader.ReadArray(asset.lods) &&
+                reader.ReadArray(asset.lodIndices);
+        }
+    }
+
+    bool MeshAssetSerializer::Save(const std::string& fileName, const std::vector<MeshAsset>& assets)
+    {
+        BinaryWriter writer;
+        Serialize(writer, assets);
+        return writer.SaveToFile(fileName);
+    }
+
+    bool MeshAssetSerializer::Load(const std::string& fileName, std::vector<MeshAsset>& assets)
+    {
+        BinaryReader reader;
+        if (!reader.LoadFromFile(fileName))
+        {
+            return false;
+        }
+
+        if (!Deserialize(reader, assets))
+        {
+            LOG_ERROR("Failed to load mesh asset '{}'", fileName);
+            return false;
+        }
+
+        return true;
+    }
+
+    void MeshAssetSerializer::Serialize(BinaryWriter& writer, const std::vector<MeshAsset>& assets)
+    {
+        writer.Write(MESH_ASSET_MAGIC);
+        writer.Write(MESH_ASSET_VERSION);
+        writer.Write(static_cast<uint32>(assets.size()));
+
+        for (const MeshAsset& asset : assets)
+        {
+            WriteMesh(writer, asset.mesh);
+            WriteMeshlets(writer, asset.meshlets);
+            WriteLods(writer, asset);
+            writer.Write(static_cast<uint32>(asset.skinningMode));
+        }
+    }
+
+    bool MeshAssetSerializer::Deserialize(BinaryReader& reader, std::vector<MeshAsset>& assets)
+    {
+        uint32 magic = 0;
+        uint32 version = 0;
+        uint32 assetCount = 0;
+
+        if (!reader.Read(magic) || magic != MESH_ASSET_MAGIC) return false;
+        if (!reader.Read(version) || version != MESH_ASSET_VERSION) return false;
+        if (!reader.Read(assetCount)) return false;
+
+        assets.resize(assetCount);
+        for (MeshAsset& asset : assets)
+        {
+            if (!ReadMesh(reader, asset.mesh)) return false;
+            if (!ReadMeshlets(reader, asset.meshlets)) return false;
+            if (!ReadLods(reader, asset)) return false;
+
+            uint32 skinningMode = 0;
+            if (!reader.Read(skinningMode) || skinningMode > static_cast<uint32>(SkinningMode::DualQuaternion)) return false;
+            asset.skinningMode = static_cast<SkinningMode>(skinningMode);
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,69 @@
+#include "asset/gina_mesh_cooker.h"
+
+#include <algorithm>
+
+namespace gina
+{
+    MeshAsset MeshCooker::Cook(const Mesh& mesh, const MeshCookSettings& settings, MeshCookReport& report)
+    {
+        MeshAsset asset;
+        asset.mesh = mesh;
+        asset.skinningMode = settings.skinningMode;
+
+        report.meshName = mesh.name;
+
+        if (settings.optimize)
+        {
+            report.optimization = MeshOptimizer::Optimize(asset.mesh, settings.optimizer);
+        }
+        else
+        {
+            const VertexCacheStatistics statistics = MeshOptimizer::AnalyzeVertexCache(asset.mesh.indices,
+                asset.mesh.GetVertexCount(), settings.optimizer.cacheSize);
+            report.optimization.before = statistics;
+            report.optimization.after = statistics;
+        }
+
+        if (settings.buildMeshlets)
+        {
+            asset.meshlets = MeshletBuilder::Build(asset.mesh, settings.meshlets);
+
+            const MeshletData& meshlets = asset.meshlets;
+            report.meshletCount = static_cast<uint32>(meshlets.meshlets.size());
+            for (const MeshletBounds& bounds : meshlets.bounds)
+            {
+                report.conesEnabled += bounds.coneCutoff < 1.0f ? 1 : 0;
+            }
+
+            if (report.meshletCount > 0)
+            {
+                report.averageMeshletVertices = static_cast<float>(meshlets.vertices.size()) / report.meshletCount;
+                report.averageMeshletTriangles = static_cast<float>(meshlets.triangles.size()) / report.meshletCount;
+            }
+        }
+
+        if (settings.buildLods)
+        {
+            MeshLodBuilder::Build(asset.mesh, settings.lods, asset.lods, asset.lodIndices);
+
+            // Each level gets its own cache-friendly triangle order; the shared vertex buffer stays in LOD 0 fetch order
+            if (settings.optimize)
+            {
+                for (const MeshLod& lod : asset.lods)
+                {
+                    const auto first = asset.lodIndices.begin() + lod.indexOffset;
+                    const std::vector<uint32> levelIndices(first, first + lod.indexCount);
+                    const std::vector<uint32> optimized = MeshOptimizer::OptimizeVertexCache(levelIndices,
+                        asset.mesh.GetVertexCount(), settings.optimizer.cacheSize);
+                    std::copy(optimized.begin(), optimized.end(), first);
+                }
+            }
+
+            report.lods = asset.lods;
+        }
+
+        report.vertexCount = asset.mesh.GetVertexCount();
+        report.triangleCount = asset.mesh.GetTriangleCount();
+        return asset;
+    }
+}
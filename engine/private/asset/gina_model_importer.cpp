@@ -0,0 +1,363 @@
+#include "asset/gina_model_importer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include "core/gina_logger.h"
+
+namespace gina
+{
+    namespace
+    {
+        // Vertex cache and fetch ordering are handled by MeshOptimizer in the cook pipeline,
+        // so aiProcess_ImproveCacheLocality is intentionally not requested here.
+        constexpr unsigned int IMPORT_FLAGS =
+            aiProcess_Triangulate |
+            aiProcess_JoinIdenticalVertices |
+            aiProcess_GenSmoothNormals |
+            aiProcess_LimitBoneWeights |
+            aiProcess_SortByPType |
+            aiProcess_FindDegenerates |
+            aiProcess_ValidateDataStructure;
+
+        // Animation import only needs the node hierarchy and channels, meshes are left untouched
+        constexpr unsigned int ANIMATION_IMPORT_FLAGS = aiProcess_ValidateDataStructure;
+
+        // Assimp leaves it 0 when the format does not say; 25 is its documented fallback
+        constexpr double DEFAULT_TICKS_PER_SECOND = 25.0;
+
+        void AddSkinInfluence(SkinInfluence& influence, uint16 joint, float weight)
+        {
+            uint32 slot = 0;
+            for (uint32 i = 1; i < MAX_SKIN_INFLUENCES; ++i)
+            {
+                if (influence.weights[i] < influence.weights[slot])
+                {
+                    slot = i;
+                }
+            }
+
+            if (weight > influence.weights[slot])
+            {
+                influence.joints[slot] = joint;
+                influence.weights[slot] = weight;
+            }
+        }
+
+        void NormalizeSkinInfluence(SkinInfluence& influence)
+        {
+            float sum = 0.0f;
+            for (float weight : influence.weights)
+            {
+                sum += weight;
+            }
+
+            if (sum <= 0.0f)
+            {
+                influence.weights[0] = 1.0f;
+                return;
+            }
+
+            for (float& weight : influence.weights)
+            {
+                weight /= sum;
+            }
+        }
+
+        Mesh ConvertMesh(const aiMesh& source)
+        {
+            Mesh mesh;
+            mesh.name = source.mName.C_Str();
+
+            mesh.positions.resize(source.mNumVertices);
+            for (uint32 v = 0; v < source.mNumVertices; ++v)
+            {
+                const aiVector3D& p = source.mVertices[v];
+                mesh.positions[v] = float3(p.x, p.y, p.z);
+            }
+
+            if (source.HasNormals())
+            {
+                mesh.normals.resize(source.mNumVertices);
+                for (uint32 v = 0; v < source.mNumVertices; ++v)
+                {
+                    const aiVector3D& n = source.mNormals[v];
+                    mesh.normals[v] = float3(n.x, n.y, n.z);
+                }
+            }
+
+            if (source.HasTextureCoords(0))
+            {
+                mesh.texcoords.resize(source.mNumVertices);
+                for (uint32 v = 0; v < source.mNumVertices; ++v)
+                {
+                    const aiVector3D& uv = source.mTextureCoords[0][v];
+                    mesh.texcoords[v] = float2(uv.x, uv.y);
+                }
+            }
+
+            if (source.HasBones())
+            {
+                mesh.skinning.resize(source.mNumVertices);
+                mesh.jointNames.reserve(source.mNumBones);
+
+                for (uint32 b = 0; b < source.mNumBones; ++b)
+                {
+                    const aiBone& bone = *source.mBones[b];
+                    mesh.jointNames.emplace_back(bone.mName.C_Str());
+
+                    for (uint32 w = 0; w < bone.mNumWeights; ++w)
+                    {
+                        const aiVertexWeight& vertexWeight = bone.mWeights[w];
+                        AddSkinInfluence(mesh.skinning[vertexWeight.mVertexId], static_cast<uint16>(b), vertexWeight.mWeight);
+                    }
+                }
+
+                for (SkinInfluence& influence : mesh.skinning)
+                {
+                    NormalizeSkinInfluence(influence);
+                }
+            }
+
+            mesh.indices.reserve(source.mNumFaces * 3);
+            for (uint32 f = 0; f < source.mNumFaces; ++f)
+            {
+                const aiFace& face = source.mFaces[f];
+                if (face.mNumIndices != 3)
+                {
+                    continue;
+                }
+
+                mesh.indices.push_back(face.mIndices[0]);
+                mesh.indices.push_back(face.mIndices[1]);
+                mesh.indices.push_back(face.mIndices[2]);
+            }
+
+            return mesh;
+        }
+
+        bool ConvertScene(const aiScene* scene, std::vector<Mesh>& meshes)
+        {
+            if (!scene)
+            {
+                return false;
+            }
+
+            meshes.clear();
+            meshes.reserve(scene->mNumMeshes);
+
+            for (uint32 m = 0; m < scene->mNumMeshes; ++m)
+            {
+                const aiMesh& source = *scene->mMeshes[m];
+                if ((source.mPrimitiveTypes & aiPrimitiveType_TRIANGLE) == 0)
+                {
+                    continue;
+                }
+
+                meshes.push_back(ConvertMesh(source));
+            }
+
+            return true;
+        }
+
+        Transform ConvertTransform(const aiMatrix4x4& matrix)
+        {
+            aiVector3D scale;
+            aiQuaternion rotation;
+            aiVector3D translation;
+            matrix.Decompose(scale, rotation, translation);
+
+            Transform transform;
+            transform.rotation = quaternion(rotation.x, rotation.y, rotation.z, rotation.w).normalized();
+            transform.translation = float3(translation.x, translation.y, translation.z);
+            transform.scale = float3(scale.x, scale.y, scale.z);
+            return transform;
+        }
+
+        void ConvertNodes(const aiNode& node, uint16 parent, std::vector<SkeletonJointDesc>& joints)
+        {
+            SkeletonJointDesc joint;
+            joint.name = node.mName.C_Str();
+            joint.parent = parent;
+            joint.bindPose = ConvertTransform(node.mTransformation);
+            joints.push_back(joint);
+
+            const uint16 index = static_cast<uint16>(joints.size() - 1);
+            for (uint32 c = 0; c < node.mNumChildren; ++c)
+            {
+                ConvertNodes(*node.mChildren[c], index, joints);
+            }
+        }
+
+        // Index of the last key at or before time, and the blend towards the next one
+        template <typename Key>
+        uint32 FindKey(const Key* keys, uint32 count, double time, float& alpha)
+        {
+            const Key* next = std::upper_bound(keys, keys + count, time, [](double t, const Key& key) { return t < key.mTime; });
+            if (next == keys)
+            {
+                alpha = 0.0f;
+                return 0;
+            }
+            if (next == keys + count)
+            {
+                alpha = 0.0f;
+                return count - 1;
+            }
+
+            const Key& key = *(next - 1);
+            alpha = static_cast<float>((time - key.mTime) / std::max(next->mTime - key.mTime, 1e-9));
+            return static_cast<uint32>(next - keys - 1);
+        }
+
+        Transform SampleChannel(const aiNodeAnim& channel, double time, const Transform& bindPose)
+        {
+            Transform result = bindPose;
+            float alpha = 0.0f;
+
+            if (channel.mNumPositionKeys > 0)
+            {
+                const uint32 k = FindKey(channel.mPositionKeys, channel.mNumPositionKeys, time, alpha);
+                const aiVector3D& a = channel.mPositionKeys[k].mValue;
+                const aiVector3D& b = channel.mPositionKeys[std::min(k + 1, channel.mNumPositionKeys - 1)].mValue;
+                result.translation = lerp(float3(a.x, a.y, a.z), float3(b.x, b.y, b.z), alpha);
+            }
+
+            if (channel.mNumRotationKeys > 0)
+            {
+                const uint32 k = FindKey(channel.mRotationKeys, channel.mNumRotationKeys, time, alpha);
+                const aiQuaternion& a = channel.mRotationKeys[k].mValue;
+                const aiQuaternion& b = channel.mRotationKeys[std::min(k + 1, channel.mNumRotationKeys - 1)].mValue;
+                result.rotation = slerp(quaternion(a.x, a.y, a.z, a.w), quaternion(b.x, b.y, b.z, b.w), alpha).normalized();
+            }
+
+            if (channel.mNumScalingKeys > 0)
+            {
+                const uint32 k = FindKey(channel.mScalingKeys, channel.mNumScalingKeys, time, alpha);
+                const aiVector3D& a = channel.mScalingKeys[k].mValue;
+                const aiVector3D& b = channel.mScalingKeys[std::min(k + 1, channel.mNumScalingKeys - 1)].mValue;
+                result.scale = lerp(float3(a.x, a.y, a.z), float3(b.x, b.y, b.z), alpha);
+            }
+
+            return result;
+        }
+
+        AnimationClip ConvertAnimation(const aiAnimation& animation, float sampleRate, const std::vector<SkeletonJointDesc>& joints)
+        {
+            const double ticksPerSecond = animation.mTicksPerSecond > 0.0 ? animation.mTicksPerSecond : DEFAULT_TICKS_PER_SECOND;
+
+            AnimationClip clip;
+            clip.name = animation.mName.C_Str();
+            clip.duration = static_cast<float>(animation.mDuration / ticksPerSecond);
+            clip.sampleRate = sampleRate;
+            clip.jointCount = static_cast<uint32>(joints.size());
+
+            std::vector<const aiNodeAnim*> channels(joints.size(), nullptr);
+            std::unordered_map<std::string, uint32> jointIndices;
+            for (uint32 j = 0; j < joints.size(); ++j)
+            {
+                jointIndices.emplace(joints[j].name, j);
+            }
+            for (uint32 c = 0; c < animation.mNumChannels; ++c)
+            {
+                const auto it = jointIndices.find(animation.mChannels[c]->mNodeName.C_Str());
+                if (it != jointIndices.end())
+                {
+                    channels[it->second] = animation.mChannels[c];
+                }
+            }
+
+            const uint32 frameCount = static_cast<uint32>(std::lround(clip.duration * sampleRate)) + 1;
+            clip.frames.reserve(static_cast<size_t>(frameCount) * clip.jointCount);
+            for (uint32 frame = 0; frame < frameCount; ++frame)
+            {
+                const double ticks = std::min(frame / static_cast<double>(sampleRate), static_cast<double>(clip.duration)) * ticksPerSecond;
+                for (uint32 j = 0; j < clip.jointCount; ++j)
+                {
+                    clip.frames.push_back(channels[j] ? SampleChannel(*channels[j], ticks, joints[j].bindPose) : joints[j].bindPose);
+                }
+            }
+
+            return clip;
+        }
+
+        bool ConvertAnimations(const aiScene* scene, float sampleRate, std::vector<SkeletonJointDesc>& joints, std::vector<AnimationClip>& clips)
+        {
+            if (!scene || !scene->mRootNode)
+            {
+                return false;
+            }
+
+            joints.clear();
+            ConvertNodes(*scene->mRootNode, INVALID_JOINT, joints);
+
+            clips.clear();
+            clips.reserve(scene->mNumAnimations);
+            for (uint32 a = 0; a < scene->mNumAnimations; ++a)
+            {
+                clips.push_back(ConvertAnimation(*scene->mAnimations[a], sampleRate, joints));
+            }
+
+            return true;
+        }
+    }
+
+    bool ModelImporter::ImportMeshes(const std::string& fileName, std::vector<Mesh>& meshes)
+    {
+        Assimp::Importer importer;
+        const aiScene* scene = importer.ReadFile(fileName, IMPORT_FLAGS);
+        if (!scene)
+        {
+            LOG_ERROR("Failed to import '{}': {}", fileName, importer.GetErrorString());
+            return false;
+        }
+
+        return ConvertScene(scene, meshes);
+    }
+
+    bool ModelImporter::ImportMeshesFromMemory(const void* data, size_t size, const std::string& formatHint, std::vector<Mesh>& meshes)
+    {
+        Assimp::Importer importer;
+        const aiScene* scene = importer.ReadFileFromMemory(data, size, IMPORT_FLAGS, formatHint.c_str());
+        if (!scene)
+        {
+            LOG_ERROR("Failed to import model from memory: {}", importer.GetErrorString());
+            return false;
+        }
+
+        return ConvertScene(scene, meshes);
+    }
+
+    bool ModelImporter::ImportAnimations(const std::string& fileName, float sampleRate,
+        std::vector<SkeletonJointDesc>& joints, std::vector<AnimationClip>& clips)
+    {
+        Assimp::Importer importer;
+        const aiScene* scene = importer.ReadFile(fileName, ANIMATION_IMPORT_FLAGS);
+        if (!scene)
+        {
+            LOG_ERROR("Failed to import '{}': {}", fileName, importer.GetErrorString());
+            return false;
+        }
+
+        return ConvertAnimations(scene, sampleRate, joints, clips);
+    }
+
+    bool ModelImporter::ImportAnimationsFromMemory(const void* data, size_t size, const std::string& formatHint, float sampleRate,
+        std::vector<SkeletonJointDesc>& joints, std::vector<AnimationClip>& clips)
+    {
+        Assimp::Importer importer;
+        const aiScene* scene = importer.ReadFileFromMemory(data, size, ANIMATION_IMPORT_FLAGS, formatHint.c_str());
+        if (!scene)
+        {
+            LOG_ERROR("Failed to import animations from memory: {}", importer.GetErrorString());
+            return false;
+        }
+
+        return ConvertAnimations(scene, sampleRate, joints, clips);
+    }
+}
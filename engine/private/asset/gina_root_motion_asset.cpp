@@ -0,0 +1,68 @@
+#include "asset/gina_root_motion_asset.h"
+
+#include "core/gina_logger.h"
+
+namespace gina
+{
+    bool RootMotionAssetSerializer::Save(const std::string& fileName, const std::vector<RootMotionTrack>& tracks)
+    {
+        BinaryWriter writer;
+        Serialize(writer, tracks);
+        return writer.SaveToFile(fileName);
+    }
+
+    bool RootMotionAssetSerializer::Load(const std::string& fileName, std::vector<RootMotionTrack>& tracks)
+    {
+        BinaryReader reader;
+        if (!reader.LoadFromFile(fileName))
+        {
+            return false;
+        }
+
+        if (!Deserialize(reader, tracks))
+        {
+            LOG_ERROR("Failed to load root motion asset '{}'", fileName);
+            return false;
+        }
+
+        return true;
+    }
+
+    void RootMotionAssetSerializer::Serialize(BinaryWriter& writer, const std::vector<RootMotionTrack>& tracks)
+    {
+        writer.Write(ROOT_MOTION_ASSET_MAGIC);
+        writer.Write(ROOT_MOTION_ASSET_VERSION);
+        writer.Write(static_cast<uint32>(tracks.size()));
+
+        for (const RootMotionTrack& track : tracks)
+        {
+            writer.WriteString(track.name);
+            writer.Write(track.duration);
+            writer.Write(track.sampleRate);
+            writer.WriteArray(track.positions);
+            writer.WriteArray(track.yaws);
+        }
+    }
+
+    bool RootMotionAssetSerializer::Deserialize(BinaryReader& reader, std::vector<RootMotionTrack>& tracks)
+    {
+        uint32 magic = 0;
+        uint32 version = 0;
+        uint32 trackCount = 0;
+
+        if (!reader.Read(magic) || magic != ROOT_MOTION_ASSET_MAGIC) return false;
+        if (!reader.Read(version) || version != ROOT_MOTION_ASSET_VERSION) return false;
+        if (!reader.Read(trackCount)) return false;
+
+        tracks.resize(trackCount);
+        for (RootMotionTrack& track : tracks)
+        {
+            if (!reader.ReadString(track.name)) return false;
+            if (!reader.Read(track.duration) || !reader.Read(track.sampleRate)) return false;
+            if (!reader.ReadArray(track.positions) || !reader.ReadArray(track.yaws)) return false;
+            if (track.positions.size() != track.yaws.size()) return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,108 @@
+#include "asset/gina_texture_asset.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "core/gina_logger.h"
+
+namespace gina
+{
+    bool TextureAssetSerializer::Save(const std::string& fileName, const TextureAsset& asset)
+    {
+        BinaryWriter writer;
+        Serialize(writer, asset);
+        return writer.SaveToFile(fileName);
+    }
+
+    bool TextureAssetSerializer::Load(const std::string& fileName, TextureAsset& asset)
+    {
+        BinaryReader reader;
+        if (!reader.LoadFromFile(fileName))
+        {
+            return false;
+        }
+
+        if (!Deserialize(reader, asset))
+        {
+            LOG_ERROR("Failed to load texture asset '{}'", fileName);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool TextureAssetSerializer::LoadHeader(const std::string& fileName, TextureAsset& asset, uint64& dataOffset)
+    {
+        std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            LOG_ERROR("Failed to open texture asset '{}'", fileName);
+            return false;
+        }
+
+        const uint64 fileSize = static_cast<uint64>(file.tellg());
+        const uint64 headerSize = std::min<uint64>(fileSize, TEXTURE_ASSET_MAX_HEADER_SIZE);
+        std::vector<byte> header(static_cast<size_t>(headerSize));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(header.data()), static_cast<std::streamsize>(header.size()));
+
+        BinaryReader reader(std::move(header));
+        uint64 dataSize = 0;
+        const bool valid = file && DeserializeHeader(reader, asset, dataSize);
+        dataOffset = headerSize - reader.GetRemaining();
+        if (!valid || dataOffset + dataSize > fileSize)
+        {
+            LOG_ERROR("Failed to load texture asset header '{}'", fileName);
+            return false;
+        }
+
+        asset.data.clear();
+        return true;
+    }
+
+    void TextureAssetSerializer::Serialize(BinaryWriter& writer, const TextureAsset& asset)
+    {
+        writer.Write(TEXTURE_ASSET_MAGIC);
+        writer.Write(TEXTURE_ASSET_VERSION);
+        writer.Write(static_cast<uint32>(asset.format));
+        writer.Write(asset.width);
+        writer.Write(asset.height);
+        writer.Write(asset.contentHash);
+        writer.WriteArray(asset.mips);
+
+        // Mip chunks last, so a streamer can read the header and seek to single mips
+        writer.Write(static_cast<uint64>(asset.data.size()));
+        writer.WriteBytes(asset.data.data(), asset.data.size());
+    }
+
+    bool TextureAssetSerializer::Deserialize(BinaryReader& reader, TextureAsset& asset)
+    {
+        uint64 dataSize = 0;
+        if (!DeserializeHeader(reader, asset, dataSize) || dataSize > reader.GetRemaining()) return false;
+
+        asset.data.resize(static_cast<size_t>(dataSize));
+        return reader.ReadBytes(asset.data.data(), asset.data.size());
+    }
+
+    bool TextureAssetSerializer::DeserializeHeader(BinaryReader& reader, TextureAsset& asset, uint64& dataSize)
+    {
+        uint32 magic = 0;
+        uint32 version = 0;
+        uint32 format = 0;
+
+        if (!reader.Read(magic) || magic != TEXTURE_ASSET_MAGIC) return false;
+        if (!reader.Read(version) || version != TEXTURE_ASSET_VERSION) return false;
+        if (!reader.Read(format) || format > static_cast<uint32>(RHIFormat::BC4Unorm)) return false;
+        if (!reader.Read(asset.width) || !reader.Read(asset.height)) return false;
+        if (!reader.Read(asset.contentHash)) return false;
+        if (!reader.ReadArray(asset.mips)) return false;
+        if (!reader.Read(dataSize)) return false;
+
+        asset.format = static_cast<RHIFormat>(format);
+        for (const TextureMip& mip : asset.mips)
+        {
+            if (mip.offset + mip.size > dataSize) return false;
+        }
+        return true;
+    }
+}
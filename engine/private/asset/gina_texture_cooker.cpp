@@ -0,0 +1,307 @@
+#include "asset/gina_texture_cooker.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+
+#include "core/gina_assert.h"
+#include "core/gina_hash.h"
+#include "core/gina_logger.h"
+#include "texture/gina_block_compression.h"
+
+namespace gina
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        double GetElapsed(Clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        const std::array<float, 256>& GetSrgbToLinear()
+        {
+            static const std::array<float, 256> table = []()
+            {
+                std::array<float, 256> values{};
+                for (uint32 i = 0; i < 256; ++i)
+                {
+                    const float srgb = i / 255.0f;
+                    values[i] = srgb <= 0.04045f ? srgb / 12.92f : std::pow((srgb + 0.055f) / 1.055f, 2.4f);
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        uint8 LinearToSrgb(float linear)
+        {
+            const float srgb = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+            return static_cast<uint8>(std::clamp(srgb * 255.0f + 0.5f, 0.0f, 255.0f));
+        }
+
+        uint8 ToUnorm8(float value)
+        {
+            return static_cast<uint8>(std::clamp(value * 255.0f + 0.5f, 0.0f, 255.0f));
+        }
+
+        // 2x2 box filter; an odd last row or column is averaged with itself
+        void Downsample(const TextureImage& source, TextureCookUsage usage, TextureImage& mip)
+        {
+            mip.width = std::max(source.width / 2, 1u);
+            mip.height = std::max(source.height / 2, 1u);
+            mip.texels.resize(static_cast<size_t>(mip.width) * mip.height * 4);
+
+            const std::array<float, 256>& srgbToLinear = GetSrgbToLinear();
+            for (uint32 y = 0; y < mip.height; ++y)
+            {
+                const uint32 y0 = std::min(y * 2, source.height - 1);
+                const uint32 y1 = std::min(y * 2 + 1, source.height - 1);
+                for (uint32 x = 0; x < mip.width; ++x)
+                {
+                    const uint32 x0 = std::min(x * 2, source.width - 1);
+                    const uint32 x1 = std::min(x * 2 + 1, source.width - 1);
+                    const uint8* samples[4] = {
+                        &source.texels[(static_cast<size_t>(y0) * source.width + x0) * 4],
+                        &source.texels[(static_cast<size_t>(y0) * source.width + x1) * 4],
+                        &source.texels[(static_cast<size_t>(y1) * source.width + x0) * 4],
+                        &source.texels[(static_cast<size_t>(y1) * source.width + x1) * 4]
+                    };
+                    uint8* texel = &mip.texels[(static_cast<size_t>(y) * mip.width + x) * 4];
+
+                    float sum[4] = {};
+                    for (const uint8* sample : samples)
+                    {
+                        for (uint32 channel = 0; channel < 4; ++channel)
+                        {
+                            const bool srgb = usage == TextureCookUsage::Albedo && channel < 3;
+                            sum[channel] += srgb ? srgbToLinear[sample[channel]] : sample[channel] / 255.0f;
+                        }
+                    }
+
+                    switch (usage)
+                    {
+                    case TextureCookUsage::Albedo:
+                        for (uint32 channel = 0; channel < 3; ++channel)
+                        {
+                            texel[channel] = LinearToSrgb(sum[channel] * 0.25f);
+                        }
+                        texel[3] = ToUnorm8(sum[3] * 0.25f);
+                        break;
+
+                    case TextureCookUsage::Normal:
+                    {
+                        // Averaging shortens the normal where the texels disagree; scale it back to unit length
+                        float normal[3];
+                        for (uint32 channel = 0; channel < 3; ++channel)
+                        {
+                            normal[channel] = sum[channel] * 0.5f - 1.0f;
+                        }
+                        const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+                        const float scale = length > 1e-6f ? 1.0f / length : 0.0f;
+                        for (uint32 channel = 0; channel < 3; ++channel)
+                        {
+                            texel[channel] = ToUnorm8(normal[channel] * scale * 0.5f + 0.5f);
+                        }
+                        texel[3] = ToUnorm8(sum[3] * 0.25f);
+                        break;
+                    }
+
+                    case TextureCookUsage::Mask:
+                        for (uint32 channel = 0; channel < 4; ++channel)
+                        {
+                            texel[channel] = ToUnorm8(sum[channel] * 0.25f);
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+
+        uint32 GetFormatChannelCount(RHIFormat format)
+        {
+            switch (format)
+            {
+            case RHIFormat::BC4Unorm:
+                return 1;
+            case RHIFormat::BC5Unorm:
+                return 2;
+            case RHIFormat::BC1Unorm:
+            case RHIFormat::BC1Srgb:
+                return 3;
+            default:
+                return 4;
+            }
+        }
+
+        std::string GetCacheFileName(const std::string& cacheDirectory, uint64 hash)
+        {
+            char name[32];
+            std::snprintf(name, sizeof(name), "%016llx.gtex", static_cast<unsigned long long>(hash));
+            return (std::filesystem::path(cacheDirectory) / name).string();
+        }
+    }
+
+    RHIFormat GetTextureCookFormat(const TextureCookSettings& settings) noexcept
+    {
+        if (settings.format != RHIFormat::Unknown)
+        {
+            return settings.format;
+        }
+
+        switch (settings.usage)
+        {
+        case TextureCookUsage::Normal:
+            return RHIFormat::BC5Unorm;
+        case TextureCookUsage::Mask:
+            return RHIFormat::BC4Unorm;
+        default:
+            return RHIFormat::BC7Srgb;
+        }
+    }
+
+    TextureAsset TextureCooker::Cook(const TextureImage& image, const TextureCookSettings& settings, ThreadPool* pool, TextureCookReport& report)
+    {
+        GINA_ASSERT_MSG(image.width > 0 && image.height > 0 && image.texels.size() == static_cast<size_t>(image.width) * image.height * 4,
+            "Texture image must hold width * height RGBA8 texels");
+
+        const Clock::time_point start = Clock::now();
+        const RHIFormat format = GetTextureCookFormat(settings);
+        GINA_ASSERT_MSG(GetFormatInfo(format).blockSize == BC_BLOCK_DIMENSION, "Textures cook to block compressed formats only");
+
+        std::vector<TextureImage> mips;
+        if (settings.generateMips)
+        {
+            GenerateMips(image, settings.usage, mips);
+        }
+        else
+        {
+            mips.push_back(image);
+        }
+
+        TextureAsset asset;
+        asset.format = format;
+        asset.width = image.width;
+        asset.height = image.height;
+        asset.contentHash = GetCookHash(image, settings);
+
+        report = {};
+        uint64 dataSize = 0;
+        for (const TextureImage& mip : mips)
+        {
+            TextureMip& chunk = asset.mips.emplace_back();
+            chunk.width = mip.width;
+            chunk.height = mip.height;
+            chunk.offset = dataSize;
+            chunk.size = GetMipSize(format, mip.width, mip.height);
+            dataSize += chunk.size;
+            report.sourceBytes += mip.texels.size();
+        }
+        asset.data.resize(dataSize);
+
+        for (size_t i = 0; i < mips.size(); ++i)
+        {
+            CompressImage(format, mips[i].width, mips[i].height, mips[i].texels.data(), asset.data.data() + asset.mips[i].offset, pool);
+        }
+        report.cookTime = GetElapsed(start);
+
+        TextureImage decoded;
+        decoded.width = image.width;
+        decoded.height = image.height;
+        decoded.texels.resize(image.texels.size());
+        DecompressImage(format, image.width, image.height, asset.data.data(), decoded.texels.data());
+
+        report.format = format;
+        report.width = image.width;
+        report.height = image.height;
+        report.mipLevels = static_cast<uint32>(asset.mips.size());
+        report.cookedBytes = asset.data.size();
+        report.psnr = ComputePsnr(image, decoded, GetFormatChannelCount(format));
+        return asset;
+    }
+
+    TextureAsset TextureCooker::CookCached(const TextureImage& image, const TextureCookSettings& settings, const std::string& cacheDirectory,
+        ThreadPool* pool, TextureCookReport& report)
+    {
+        const Clock::time_point start = Clock::now();
+        const uint64 hash = GetCookHash(image, settings);
+        const std::string fileName = GetCacheFileName(cacheDirectory, hash);
+
+        TextureAsset asset;
+        std::error_code error;
+        if (std::filesystem::exists(fileName, error) && TextureAssetSerializer::Load(fileName, asset) && asset.contentHash == hash)
+        {
+            report = {};
+            report.format = asset.format;
+            report.width = asset.width;
+            report.height = asset.height;
+            report.mipLevels = static_cast<uint32>(asset.mips.size());
+            report.cookedBytes = asset.data.size();
+            for (const TextureMip& mip : asset.mips)
+            {
+                report.sourceBytes += static_cast<uint64>(mip.width) * mip.height * 4;
+            }
+            report.cookTime = GetElapsed(start);
+            report.cacheHit = true;
+            return asset;
+        }
+
+        asset = Cook(image, settings, pool, report);
+        std::filesystem::create_directories(cacheDirectory, error);
+        if (!TextureAssetSerializer::Save(fileName, asset))
+        {
+            LOG_WARN("Failed to store cooked texture in cache '{}'", fileName);
+        }
+        return asset;
+    }
+
+    uint64 TextureCooker::GetCookHash(const TextureImage& image, const TextureCookSettings& settings) noexcept
+    {
+        uint64 hash = HASH_SEED;
+        hash = HashValue(hash, TEXTURE_COOKER_VERSION);
+        hash = HashValue(hash, image.width);
+        hash = HashValue(hash, image.height);
+        hash = HashValue(hash, settings.usage);
+        hash = HashValue(hash, GetTextureCookFormat(settings));
+        hash = HashValue(hash, settings.generateMips);
+        return HashBytes(image.texels.data(), image.texels.size(), hash);
+    }
+
+    void TextureCooker::GenerateMips(const TextureImage& image, TextureCookUsage usage, std::vector<TextureImage>& mips)
+    {
+        mips.clear();
+        mips.push_back(image);
+        while (mips.back().width > 1 || mips.back().height > 1)
+        {
+            TextureImage mip;
+            Downsample(mips.back(), usage, mip);
+            mips.push_back(std::move(mip));
+        }
+    }
+
+    double TextureCooker::ComputePsnr(const TextureImage& reference, const TextureImage& image, uint32 channelCount) noexcept
+    {
+        double squaredError = 0.0;
+        const size_t texelCount = static_cast<size_t>(reference.width) * reference.height;
+        for (size_t i = 0; i < texelCount; ++i)
+        {
+            for (uint32 channel = 0; channel < channelCount; ++channel)
+            {
+                const double difference = static_cast<double>(reference.texels[i * 4 + channel]) - image.texels[i * 4 + channel];
+                squaredError += difference * difference;
+            }
+        }
+
+        // Identical images have no noise at all; report a finite ceiling rather than infinity
+        const double meanSquaredError = squaredError / static_cast<double>(texelCount * channelCount);
+        if (meanSquaredError <= 0.0)
+        {
+            return 99.0;
+        }
+        return 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+    }
+}
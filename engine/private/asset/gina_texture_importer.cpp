@@ -0,0 +1,122 @@
+#include "asset/gina_texture_importer.h"
+
+#include <algorithm>
+
+#include "core/gina_binary_stream.h"
+#include "core/gina_logger.h"
+
+namespace gina
+{
+    namespace
+    {
+        constexpr uint32 TGA_HEADER_SIZE = 18;
+        constexpr uint8 TGA_TRUE_COLOR = 2;
+        constexpr uint8 TGA_GRAYSCALE = 3;
+        constexpr uint8 TGA_RLE_FLAG = 8;
+        constexpr uint8 TGA_TOP_TO_BOTTOM = 1 << 5;
+
+        uint16 ReadUint16(const byte* data) noexcept
+        {
+            return static_cast<uint16>(data[0] | (data[1] << 8));
+        }
+
+        // One TGA pixel (BGR, BGRA or gray) as RGBA
+        void ConvertPixel(const byte* source, uint32 bytesPerPixel, uint8* texel) noexcept
+        {
+            if (bytesPerPixel == 1)
+            {
+                texel[0] = texel[1] = texel[2] = source[0];
+                texel[3] = 255;
+                return;
+            }
+            texel[0] = source[2];
+            texel[1] = source[1];
+            texel[2] = source[0];
+            texel[3] = bytesPerPixel == 4 ? source[3] : 255;
+        }
+    }
+
+    bool TextureImporter::Import(const std::string& fileName, TextureImage& image)
+    {
+        BinaryReader reader;
+        if (!reader.LoadFromFile(fileName))
+        {
+            return false;
+        }
+
+        std::vector<byte> data(reader.GetRemaining());
+        reader.ReadBytes(data.data(), data.size());
+        if (!DecodeTga(data, image))
+        {
+            LOG_ERROR("Failed to import texture '{}': not a supported TGA", fileName);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool TextureImporter::DecodeTga(const std::vector<byte>& data, TextureImage& image)
+    {
+        if (data.size() < TGA_HEADER_SIZE) return false;
+
+        const uint8 idLength = data[0];
+        const uint8 colorMapType = data[1];
+        const uint8 imageType = data[2];
+        const uint32 width = ReadUint16(&data[12]);
+        const uint32 height = ReadUint16(&data[14]);
+        const uint32 bitsPerPixel = data[16];
+        const bool topToBottom = (data[17] & TGA_TOP_TO_BOTTOM) != 0;
+
+        const uint8 baseType = imageType & ~TGA_RLE_FLAG;
+        const bool rle = (imageType & TGA_RLE_FLAG) != 0;
+        if (colorMapType != 0 || width == 0 || height == 0) return false;
+        if (baseType == TGA_TRUE_COLOR && bitsPerPixel != 24 && bitsPerPixel != 32) return false;
+        if (baseType == TGA_GRAYSCALE && bitsPerPixel != 8) return false;
+        if (baseType != TGA_TRUE_COLOR && baseType != TGA_GRAYSCALE) return false;
+
+        const uint32 bytesPerPixel = bitsPerPixel / 8;
+        const uint32 pixelCount = width * height;
+        size_t offset = TGA_HEADER_SIZE + idLength;
+
+        // Decoded in file order, bottom row first unless the descriptor says otherwise
+        std::vector<uint8> texels(static_cast<size_t>(pixelCount) * 4);
+        uint32 pixel = 0;
+        while (pixel < pixelCount)
+        {
+            uint32 runLength = 1;
+            bool repeat = false;
+            if (rle)
+            {
+                if (offset >= data.size()) return false;
+                const uint8 packet = data[offset++];
+                runLength = (packet & 0x7F) + 1u;
+                repeat = (packet & 0x80) != 0;
+            }
+            else
+            {
+                runLength = pixelCount;
+            }
+            if (pixel + runLength > pixelCount) return false;
+
+            const size_t readCount = repeat ? 1 : runLength;
+            if (offset + readCount * bytesPerPixel > data.size()) return false;
+            for (uint32 i = 0; i < runLength; ++i)
+            {
+                ConvertPixel(&data[offset + (repeat ? 0 : static_cast<size_t>(i) * bytesPerPixel)], bytesPerPixel, &texels[(pixel + i) * 4]);
+            }
+            offset += readCount * bytesPerPixel;
+            pixel += runLength;
+        }
+
+        image.width = width;
+        image.height = height;
+        image.texels.resize(texels.size());
+        const size_t rowSize = static_cast<size_t>(width) * 4;
+        for (uint32 y = 0; y < height; ++y)
+        {
+            const uint32 sourceRow = topToBottom ? y : height - 1 - y;
+            std::copy_n(texels.begin() + sourceRow * rowSize, rowSize, image.texels.begin() + y * rowSize);
+        }
+        return true;
+    }
+}
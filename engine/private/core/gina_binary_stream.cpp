@@ -0,0 +1,38 @@
+#include "core/gina_binary_stream.h"
+
+#include <fstream>
+
+#include "core/gina_logger.h"
+
+namespace gina
+{
+    bool BinaryWriter::SaveToFile(const std::string& fileName) const
+    {
+        std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            LOG_ERROR("Failed to open '{}' for writing", fileName);
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+        return static_cast<bool>(file);
+    }
+
+    bool BinaryReader::LoadFromFile(const std::string& fileName)
+    {
+        std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            LOG_ERROR("Failed to open '{}' for reading", fileName);
+            return false;
+        }
+
+        const std::streamsize size = file.tellg();
+        file.seekg(0, std::ios::beg);
+
+        m_buffer.resize(static_cast<size_t>(size));
+        m_offset = 0;
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(m_buffer.data()), size));
+    }
+}
@@ -0,0 +1,80 @@
+#include "core/gina_cpu_features.h"
+
+#include "core/gina_math.h"
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <cpuid.h>
+#endif
+
+namespace gina
+{
+    namespace
+    {
+        struct CpuInfo
+        {
+            bool sse2 = false;
+            bool avx2 = false;
+
+            CpuInfo() noexcept
+            {
+#if defined(_MSC_VER)
+                int info[4];
+                __cpuid(info, 0);
+                const int maxLeaf = info[0];
+
+                __cpuid(info, 1);
+                sse2 = (info[3] & (1 << 26)) != 0;
+                const bool osxsave = (info[2] & (1 << 27)) != 0;
+                const bool avx = (info[2] & (1 << 28)) != 0;
+
+                if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+                {
+                    __cpuidex(info, 7, 0);
+                    avx2 = (info[1] & (1 << 5)) != 0;
+                }
+#elif defined(__x86_64__) || defined(__i386__)
+                unsigned int eax, ebx, ecx, edx;
+                const unsigned int maxLeaf = __get_cpuid_max(0, nullptr);
+
+                __cpuid(1, eax, ebx, ecx, edx);
+                sse2 = (edx & (1 << 26)) != 0;
+                const bool osxsave = (ecx & (1 << 27)) != 0;
+                const bool avx = (ecx & (1 << 28)) != 0;
+
+                if (maxLeaf >= 7 && osxsave && avx)
+                {
+                    unsigned int xcr0Low, xcr0High;
+                    __asm__ volatile("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+                    if ((xcr0Low & 0x6) == 0x6)
+                    {
+                        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+                        avx2 = (ebx & (1 << 5)) != 0;
+                    }
+                }
+#endif
+            }
+        };
+
+        const CpuInfo& GetCpuInfo() noexcept
+        {
+            static const CpuInfo info;
+            return info;
+        }
+    }
+
+    bool CpuFeatures::HasSSE2() noexcept
+    {
+#if defined(GINA_SSE2_ENABLED)
+        return GetCpuInfo().sse2;
+#else
+        return false;
+#endif
+    }
+
+    bool CpuFeatures::HasAVX2() noexcept
+    {
+        return GetCpuInfo().avx2;
+    }
+}
@@ -0,0 +1,47 @@
+#include "core/gina_frustum.h"
+
+namespace gina
+{
+    namespace
+    {
+        Plane MakePlane(const float3& normal, const float3& point) noexcept
+        {
+            Plane plane;
+            plane.normal = normal.normalized();
+            plane.distance = -dot(plane.normal, point);
+            return plane;
+        }
+    }
+
+    Frustum Frustum::FromPerspective(const float3& position, const float3& forward, const float3& up,
+        float fovY, float aspectRatio, float nearZ, float farZ) noexcept
+    {
+        const float3 f = forward.normalized();
+        const float3 r = cross(up, f).normalized();
+        const float3 u = cross(f, r);
+
+        const float halfHeight = std::tan(fovY * 0.5f);
+        const float halfWidth = halfHeight * aspectRatio;
+
+        Frustum frustum;
+        frustum.planes[0] = MakePlane(r + f * halfWidth, position);
+        frustum.planes[1] = MakePlane(-r + f * halfWidth, position);
+        frustum.planes[2] = MakePlane(u + f * halfHeight, position);
+        frustum.planes[3] = MakePlane(-u + f * halfHeight, position);
+        frustum.planes[4] = MakePlane(f, position + f * nearZ);
+        frustum.planes[5] = MakePlane(-f, position + f * farZ);
+        return frustum;
+    }
+
+    bool Frustum::IntersectsSphere(const float3& center, float radius) const noexcept
+    {
+        for (const Plane& plane : planes)
+        {
+            if (plane.SignedDistance(center) < -radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -1,5 +1,9 @@
 #include "core/gina_math.h"
 
+#if defined(GINA_SSE2_ENABLED) && !defined(_MSC_VER)
+    #include <cpuid.h>
+#endif
+
 namespace gina
 {
     namespace detail
@@ -390,4 +394,424 @@ namespace gina
         detail::MathDispatch::div2Impl(result, vec, scalar);
         return result;
     }
-}
\ No newline at end of file
+
+    const float3 float3::Zero = float3(0.0f, 0.0f, 0.0f);
+
+    float float3::lengthSquared() const noexcept
+    {
+        return x * x + y * y + z * z;
+    }
+
+    float float3::length() const noexcept
+    {
+        return std::sqrt(lengthSquared());
+    }
+
+    bool float3::isZero() const noexcept
+    {
+        return std::fabs(x) < EPSILON && std::fabs(y) < EPSILON && std::fabs(z) < EPSILON;
+    }
+
+    float3 float3::normalized() const noexcept
+    {
+        float3 result = *this;
+        result.normalize();
+        return result;
+    }
+
+    void float3::normalize() noexcept
+    {
+        // Geometry vectors (e.g. cross products of small triangle edges) can be legitimately tiny,
+        // so only vectors that cannot be normalized in float precision collapse to zero
+        const float lenSq = lengthSquared();
+        if (lenSq <= std::numeric_limits<float>::min())
+        {
+            x = y = z = 0.0f;
+            return;
+        }
+
+        const float invLen = 1.0f / std::sqrt(lenSq);
+        x *= invLen;
+        y *= invLen;
+        z *= invLen;
+    }
+
+    float3& float3::operator+=(const float3& other) noexcept
+    {
+        x += other.x;
+        y += other.y;
+        z += other.z;
+        return *this;
+    }
+
+    float3& float3::operator-=(const float3& other) noexcept
+    {
+        x -= other.x;
+        y -= other.y;
+        z -= other.z;
+        return *this;
+    }
+
+    float3& float3::operator*=(float scalar) noexcept
+    {
+        x *= scalar;
+        y *= scalar;
+        z *= scalar;
+        return *this;
+    }
+
+    float3& float3::operator/=(float scalar) noexcept
+    {
+        *this = *this / scalar;
+        return *this;
+    }
+
+    bool float3::operator==(const float3& other) const noexcept
+    {
+        return gina::isZero(x - other.x) && gina::isZero(y - other.y) && gina::isZero(z - other.z);
+    }
+
+    bool float3::operator!=(const float3& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    float3 float3::operator-() const noexcept
+    {
+        return float3(-x, -y, -z);
+    }
+
+    float dot(const float3& a, const float3& b) noexcept
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    float3 cross(const float3& a, const float3& b) noexcept
+    {
+        return float3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+
+    float distance(const float3& a, const float3& b) noexcept
+    {
+        return (a - b).length();
+    }
+
+    float3 lerp(const float3& a, const float3& b, float t) noexcept
+    {
+        return float3(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t);
+    }
+
+    float3 min(const float3& a, const float3& b) noexcept
+    {
+        return float3(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z));
+    }
+
+    float3 max(const float3& a, const float3& b) noexcept
+    {
+        return float3(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z));
+    }
+
+    float3 operator+(const float3& lhs, const float3& rhs) noexcept
+    {
+        return float3(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z);
+    }
+
+    float3 operator-(const float3& lhs, const float3& rhs) noexcept
+    {
+        return float3(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z);
+    }
+
+    float3 operator*(const float3& lhs, const float3& rhs) noexcept
+    {
+        return float3(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z);
+    }
+
+    float3 operator*(const float3& vec, float scalar) noexcept
+    {
+        return float3(vec.x * scalar, vec.y * scalar, vec.z * scalar);
+    }
+
+    float3 operator*(float scalar, const float3& vec) noexcept
+    {
+        return vec * scalar;
+    }
+
+    float3 operator/(const float3& vec, float scalar) noexcept
+    {
+        if (std::fabs(scalar) < EPSILON)
+        {
+            return float3::Zero;
+        }
+        return vec * (1.0f / scalar);
+    }
+
+    const quaternion quaternion::Identity = quaternion(0.0f, 0.0f, 0.0f, 1.0f);
+
+    quaternion quaternion::fromAxisAngle(const float3& axis, float radians) noexcept
+    {
+        const float3 unitAxis = axis.normalized();
+        const float halfAngle = radians * 0.5f;
+        const float s = std::sin(halfAngle);
+        return quaternion(unitAxis.x * s, unitAxis.y * s, unitAxis.z * s, std::cos(halfAngle));
+    }
+
+    quaternion quaternion::fromTo(const float3& from, const float3& to) noexcept
+    {
+        const float3 a = from.normalized();
+        const float3 b = to.normalized();
+        const float cosine = dot(a, b);
+
+        // Opposite directions: half a turn around any axis perpendicular to from
+        if (cosine < -1.0f + 1e-6f)
+        {
+            const float3 axis = std::fabs(a.x) < 0.9f ? cross(a, float3(1.0f, 0.0f, 0.0f)) : cross(a, float3(0.0f, 1.0f, 0.0f));
+            const float3 unitAxis = axis.normalized();
+            return quaternion(unitAxis.x, unitAxis.y, unitAxis.z, 0.0f);
+        }
+
+        // Half-way quaternion: (a x b, 1 + a.b) has twice the half angle's cosine and sine, so normalizing gives the rotation
+        const float3 axis = cross(a, b);
+        return quaternion(axis.x, axis.y, axis.z, 1.0f + cosine).normalized();
+    }
+
+    float quaternion::lengthSquared() const noexcept
+    {
+        return x * x + y * y + z * z + w * w;
+    }
+
+    float quaternion::length() const noexcept
+    {
+        return std::sqrt(lengthSquared());
+    }
+
+    quaternion quaternion::normalized() const noexcept
+    {
+        quaternion result = *this;
+        result.normalize();
+        return result;
+    }
+
+    void quaternion::normalize() noexcept
+    {
+        const float lenSq = lengthSquared();
+        if (lenSq <= std::numeric_limits<float>::min())
+        {
+            *this = Identity;
+            return;
+        }
+
+        const float invLen = 1.0f / std::sqrt(lenSq);
+        x *= invLen;
+        y *= invLen;
+        z *= invLen;
+        w *= invLen;
+    }
+
+    quaternion quaternion::conjugate() const noexcept
+    {
+        return quaternion(-x, -y, -z, w);
+    }
+
+    float3 quaternion::rotate(const float3& vec) const noexcept
+    {
+        // v' = v + 2w (u x v) + 2 u x (u x v), with u the vector part
+        const float3 u(x, y, z);
+        const float3 t = cross(u, vec) * 2.0f;
+        return vec + t * w + cross(u, t);
+    }
+
+    quaternion& quaternion::operator*=(const quaternion& other) noexcept
+    {
+        *this = *this * other;
+        return *this;
+    }
+
+    bool quaternion::operator==(const quaternion& other) const noexcept
+    {
+        return gina::isZero(x - other.x) && gina::isZero(y - other.y) && gina::isZero(z - other.z) && gina::isZero(w - other.w);
+    }
+
+    bool quaternion::operator!=(const quaternion& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    quaternion quaternion::operator-() const noexcept
+    {
+        return quaternion(-x, -y, -z, -w);
+    }
+
+    float dot(const quaternion& a, const quaternion& b) noexcept
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    }
+
+    quaternion nlerp(const quaternion& a, const quaternion& b, float t) noexcept
+    {
+        // Interpolate along the shortest arc: q and -q are the same rotation
+        const float bt = dot(a, b) < 0.0f ? -t : t;
+        const float at = 1.0f - t;
+        return quaternion(a.x * at + b.x * bt, a.y * at + b.y * bt, a.z * at + b.z * bt, a.w * at + b.w * bt).normalized();
+    }
+
+    quaternion slerp(const quaternion& a, const quaternion& b, float t) noexcept
+    {
+        float cosTheta = dot(a, b);
+        const float sign = cosTheta < 0.0f ? -1.0f : 1.0f;
+        cosTheta *= sign;
+
+        // Nearly parallel rotations: sin(theta) vanishes and nlerp is exact enough
+        if (cosTheta > 1.0f - EPSILON)
+        {
+            return nlerp(a, b, t);
+        }
+
+        const float theta = std::acos(cosTheta);
+        const float invSinTheta = 1.0f / std::sin(theta);
+        const float at = std::sin((1.0f - t) * theta) * invSinTheta;
+        const float bt = std::sin(t * theta) * invSinTheta * sign;
+        return quaternion(a.x * at + b.x * bt, a.y * at + b.y * bt, a.z * at + b.z * bt, a.w * at + b.w * bt);
+    }
+
+    quaternion operator*(const quaternion& lhs, const quaternion& rhs) noexcept
+    {
+        return quaternion(
+            lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
+            lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x,
+            lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w,
+            lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z);
+    }
+
+    const float3x4 float3x4::Identity = float3x4();
+
+    float3x4 float3x4::fromRotationTranslationScale(const quaternion& rotation, const float3& translation, const float3& scale) noexcept
+    {
+        const float xx = rotation.x * rotation.x, yy = rotation.y * rotation.y, zz = rotation.z * rotation.z;
+        const float xy = rotation.x * rotation.y, xz = rotation.x * rotation.z, yz = rotation.y * rotation.z;
+        const float wx = rotation.w * rotation.x, wy = rotation.w * rotation.y, wz = rotation.w * rotation.z;
+
+        float3x4 result;
+        result.m[0][0] = (1.0f - 2.0f * (yy + zz)) * scale.x;
+        result.m[0][1] = 2.0f * (xy - wz) * scale.y;
+        result.m[0][2] = 2.0f * (xz + wy) * scale.z;
+        result.m[0][3] = translation.x;
+        result.m[1][0] = 2.0f * (xy + wz) * scale.x;
+        result.m[1][1] = (1.0f - 2.0f * (xx + zz)) * scale.y;
+        result.m[1][2] = 2.0f * (yz - wx) * scale.z;
+        result.m[1][3] = translation.y;
+        result.m[2][0] = 2.0f * (xz - wy) * scale.x;
+        result.m[2][1] = 2.0f * (yz + wx) * scale.y;
+        result.m[2][2] = (1.0f - 2.0f * (xx + yy)) * scale.z;
+        result.m[2][3] = translation.z;
+        return result;
+    }
+
+    float3 float3x4::transformPoint(const float3& point) const noexcept
+    {
+        return float3(
+            m[0][0] * point.x + m[0][1] * point.y + m[0][2] * point.z + m[0][3],
+            m[1][0] * point.x + m[1][1] * point.y + m[1][2] * point.z + m[1][3],
+            m[2][0] * point.x + m[2][1] * point.y + m[2][2] * point.z + m[2][3]);
+    }
+
+    float3 float3x4::transformVector(const float3& vec) const noexcept
+    {
+        return float3(
+            m[0][0] * vec.x + m[0][1] * vec.y + m[0][2] * vec.z,
+            m[1][0] * vec.x + m[1][1] * vec.y + m[1][2] * vec.z,
+            m[2][0] * vec.x + m[2][1] * vec.y + m[2][2] * vec.z);
+    }
+
+    float3x4 float3x4::inverse() const noexcept
+    {
+        // Inverse of the 3x3 part from its adjugate, then the translation is moved through it
+        const float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+        const float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+        const float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+        const float determinant = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+        if (std::fabs(determinant) <= std::numeric_limits<float>::min())
+        {
+            return Identity;
+        }
+
+        const float invDet = 1.0f / determinant;
+        float3x4 result;
+        result.m[0][0] = c00 * invDet;
+        result.m[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * invDet;
+        result.m[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * invDet;
+        result.m[1][0] = c01 * invDet;
+        result.m[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * invDet;
+        result.m[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * invDet;
+        result.m[2][0] = c02 * invDet;
+        result.m[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * invDet;
+        result.m[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * invDet;
+
+        for (int row = 0; row < 3; ++row)
+        {
+            result.m[row][3] = -(result.m[row][0] * m[0][3] + result.m[row][1] * m[1][3] + result.m[row][2] * m[2][3]);
+        }
+        return result;
+    }
+
+    float3x4 operator*(const float3x4& lhs, const float3x4& rhs) noexcept
+    {
+        float3x4 result;
+        for (int row = 0; row < 3; ++row)
+        {
+            for (int column = 0; column < 4; ++column)
+            {
+                result.m[row][column] =
+                    lhs.m[row][0] * rhs.m[0][column] +
+                    lhs.m[row][1] * rhs.m[1][column] +
+                    lhs.m[row][2] * rhs.m[2][column];
+            }
+            result.m[row][3] += lhs.m[row][3];
+        }
+        return result;
+    }
+
+    const dualquaternion dualquaternion::Identity = dualquaternion();
+
+    dualquaternion dualquaternion::fromRotationTranslation(const quaternion& rotation, const float3& translation) noexcept
+    {
+        const quaternion dual = quaternion(translation.x, translation.y, translation.z, 0.0f) * rotation;
+        return dualquaternion(rotation, quaternion(dual.x * 0.5f, dual.y * 0.5f, dual.z * 0.5f, dual.w * 0.5f));
+    }
+
+    float3 dualquaternion::getTranslation() const noexcept
+    {
+        const quaternion translation = dual * real.conjugate();
+        return float3(translation.x, translation.y, translation.z) * 2.0f;
+    }
+
+    dualquaternion dualquaternion::normalized() const noexcept
+    {
+        const float length = real.length();
+        if (length <= std::numeric_limits<float>::min())
+        {
+            return Identity;
+        }
+
+        const float invLength = 1.0f / length;
+        return dualquaternion(
+            quaternion(real.x * invLength, real.y * invLength, real.z * invLength, real.w * invLength),
+            quaternion(dual.x * invLength, dual.y * invLength, dual.z * invLength, dual.w * invLength));
+    }
+
+    float3 dualquaternion::transformPoint(const float3& point) const noexcept
+    {
+        return real.rotate(point) + getTranslation();
+    }
+
+    float3 dualquaternion::transformVector(const float3& vec) const noexcept
+    {
+        return real.rotate(vec);
+    }
+
+    dualquaternion operator*(const dualquaternion& lhs, const dualquaternion& rhs) noexcept
+    {
+        const quaternion a = lhs.real * rhs.dual;
+        const quaternion b = lhs.dual * rhs.real;
+        return dualquaternion(lhs.real * rhs.real, quaternion(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w));
+    }
+}
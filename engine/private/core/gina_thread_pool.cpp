@@ -0,0 +1,101 @@
+#include "core/gina_thread_pool.h"
+
+#include <algorithm>
+
+namespace gina
+{
+    ThreadPool::ThreadPool(uint32 workerCount)
+    {
+        if (workerCount == 0)
+        {
+            const uint32 hardwareThreads = std::thread::hardware_concurrency();
+            workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+        }
+
+        m_workers.reserve(workerCount);
+        for (uint32 i = 0; i < workerCount; ++i)
+        {
+            m_workers.emplace_back(&ThreadPool::WorkerLoop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wakeCondition.notify_all();
+
+        for (std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::ParallelFor(uint32 count, uint32 grainSize, const RangeFunc& body)
+    {
+        grainSize = std::max(grainSize, 1u);
+        if (m_workers.empty() || count <= grainSize)
+        {
+            if (count > 0)
+            {
+                body(0, count);
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> submitLock(m_submitMutex);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_body = &body;
+            m_count = count;
+            m_grainSize = grainSize;
+            m_nextChunk.store(0, std::memory_order_relaxed);
+            m_busyWorkers = GetWorkerCount();
+            ++m_generation;
+        }
+        m_wakeCondition.notify_all();
+
+        RunChunks();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCondition.wait(lock, [this]() { return m_busyWorkers == 0; });
+        m_body = nullptr;
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        uint64 seenGeneration = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wakeCondition.wait(lock, [&]() { return m_stop || m_generation != seenGeneration; });
+                if (m_stop)
+                {
+                    return;
+                }
+                seenGeneration = m_generation;
+            }
+
+            RunChunks();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_busyWorkers == 0)
+            {
+                m_doneCondition.notify_one();
+            }
+        }
+    }
+
+    void ThreadPool::RunChunks()
+    {
+        const uint32 chunkCount = (m_count + m_grainSize - 1) / m_grainSize;
+        for (uint32 chunk = m_nextChunk.fetch_add(1); chunk < chunkCount; chunk = m_nextChunk.fetch_add(1))
+        {
+            const uint32 begin = chunk * m_grainSize;
+            (*m_body)(begin, std::min(begin + m_grainSize, m_count));
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#include "core/gina_transform.h"
+
+namespace gina
+{
+    const Transform Transform::Identity = Transform();
+
+    float3 Transform::TransformPoint(const float3& point) const noexcept
+    {
+        return rotation.rotate(point * scale) + translation;
+    }
+
+    float3 Transform::TransformVector(const float3& vector) const noexcept
+    {
+        return rotation.rotate(vector * scale);
+    }
+
+    Transform Transform::Inverse() const noexcept
+    {
+        Transform inverse;
+        inverse.rotation = rotation.conjugate();
+        inverse.scale = float3(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+        inverse.translation = inverse.rotation.rotate(-translation) * inverse.scale;
+        return inverse;
+    }
+
+    float3x4 Transform::ToMatrix() const noexcept
+    {
+        return float3x4::fromRotationTranslationScale(rotation, translation, scale);
+    }
+
+    Transform operator*(const Transform& parent, const Transform& child) noexcept
+    {
+        Transform result;
+        result.rotation = parent.rotation * child.rotation;
+        result.translation = parent.TransformPoint(child.translation);
+        result.scale = parent.scale * child.scale;
+        return result;
+    }
+
+    Transform Blend(const Transform& a, const Transform& b, float weight) noexcept
+    {
+        Transform result;
+        result.rotation = nlerp(a.rotation, b.rotation, weight);
+        result.translation = lerp(a.translation, b.translation, weight);
+        result.scale = lerp(a.scale, b.scale, weight);
+        return result;
+    }
+}
@@ -0,0 +1,34 @@
+#include "mesh/gina_mesh_adjacency.h"
+
+namespace gina
+{
+    TriangleAdjacency TriangleAdjacency::Build(const std::vector<uint32>& indices, uint32 vertexCount)
+    {
+        TriangleAdjacency adjacency;
+        adjacency.offsets.assign(vertexCount + 1, 0);
+        adjacency.counts.assign(vertexCount, 0);
+        adjacency.triangles.resize(indices.size());
+
+        for (uint32 index : indices)
+        {
+            adjacency.counts[index]++;
+        }
+
+        for (uint32 v = 0; v < vertexCount; ++v)
+        {
+            adjacency.offsets[v + 1] = adjacency.offsets[v] + adjacency.counts[v];
+        }
+
+        std::vector<uint32> cursor(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+        const uint32 triangleCount = static_cast<uint32>(indices.size() / 3);
+        for (uint32 t = 0; t < triangleCount; ++t)
+        {
+            for (uint32 corner = 0; corner < 3; ++corner)
+            {
+                adjacency.triangles[cursor[indices[t * 3 + corner]]++] = t;
+            }
+        }
+
+        return adjacency;
+    }
+}
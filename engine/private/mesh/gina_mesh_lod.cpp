@@ -0,0 +1,81 @@
+#include "mesh/gina_mesh_lod.h"
+
+#include <algorithm>
+
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    /**
+     * Builds a LOD chain where each level targets triangleRatio of the previous level's triangles
+     *
+     * Every level is simplified from the source indices rather than from the previous level, so its
+     * error is measured against the original surface instead of accumulating across levels. Levels
+     * share the source vertex buffer. The chain stops early once the simplifier can no longer make
+     * meaningful progress within the error limit (locked topology, seams, skin weight boundaries).
+     */
+    void MeshLodBuilder::Build(const Mesh& mesh, const MeshLodSettings& settings,
+        std::vector<MeshLod>& lods, std::vector<uint32>& lodIndices)
+    {
+        GINA_ASSERT_MSG(settings.triangleRatio > 0.0f && settings.triangleRatio < 1.0f, "LOD triangle ratio must be in (0, 1)");
+
+        uint32 previousIndexCount = static_cast<uint32>(mesh.indices.size());
+        float previousError = 0.0f;
+
+        for (uint32 level = 1; level < settings.levelCount; ++level)
+        {
+            const uint32 targetTriangles = static_cast<uint32>(previousIndexCount / 3 * settings.triangleRatio);
+            if (targetTriangles == 0)
+            {
+                break;
+            }
+
+            MeshSimplifyResult result = MeshSimplifier::Simplify(mesh, mesh.indices, targetTriangles * 3, settings.simplifier);
+
+            const uint32 indexCount = static_cast<uint32>(result.indices.size());
+            if (indexCount == 0 || indexCount > previousIndexCount * (1.0f - settings.minReduction))
+            {
+                break;
+            }
+
+            MeshLod lod;
+            lod.indexOffset = static_cast<uint32>(lodIndices.size());
+            lod.indexCount = indexCount;
+            lod.error = std::max(result.error, previousError);
+            lods.push_back(lod);
+
+            lodIndices.insert(lodIndices.end(), result.indices.begin(), result.indices.end());
+
+            previousIndexCount = indexCount;
+            previousError = lod.error;
+        }
+    }
+
+    float MeshLodBuilder::ComputeProjectionScale(float screenHeight, float fovY) noexcept
+    {
+        return screenHeight / (2.0f * std::tan(fovY * 0.5f));
+    }
+
+    /**
+     * Picks the coarsest level whose simplification error, projected at the given view distance,
+     * stays within maxPixelError pixels: error * projectionScale / distance <= maxPixelError
+     */
+    uint32 MeshLodBuilder::SelectLod(const std::vector<MeshLod>& lods, float distance, float projectionScale,
+        float maxPixelError) noexcept
+    {
+        if (distance <= 0.0f)
+        {
+            return 0;
+        }
+
+        // Compare object space errors against the allowed error at this distance to avoid a divide per level
+        const float maxError = maxPixelError * distance / projectionScale;
+
+        uint32 selected = 0;
+        for (uint32 i = 0; i < lods.size() && lods[i].error <= maxError; ++i)
+        {
+            selected = i + 1;
+        }
+        return selected;
+    }
+}
@@ -0,0 +1,425 @@
+#include "mesh/gina_mesh_optimizer.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "mesh/gina_mesh_adjacency.h"
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    namespace
+    {
+        class VertexCacheSimulator
+        {
+        public:
+            VertexCacheSimulator(uint32 vertexCount, uint32 cacheSize)
+                : m_cacheTime(vertexCount, 0), m_cacheSize(cacheSize), m_time(cacheSize + 1)
+            {
+            }
+
+            uint32 Process(uint32 a, uint32 b, uint32 c) noexcept
+            {
+                return Process(a) + Process(b) + Process(c);
+            }
+
+            void Reset() noexcept
+            {
+                m_time += m_cacheSize + 1;
+            }
+
+        private:
+            uint32 Process(uint32 vertex) noexcept
+            {
+                if (m_time - m_cacheTime[vertex] <= m_cacheSize)
+                {
+                    return 0;
+                }
+
+                m_cacheTime[vertex] = m_time++;
+                return 1;
+            }
+
+            std::vector<uint32> m_cacheTime;
+            uint32 m_cacheSize;
+            uint32 m_time;
+        };
+
+        int64 SelectNextFanningVertex(const std::vector<uint32>& candidates, const std::vector<uint32>& liveTriangles,
+            const std::vector<uint32>& cacheTime, uint32 timestamp, uint32 cacheSize)
+        {
+            int64 best = -1;
+            int64 bestPriority = -1;
+
+            for (uint32 vertex : candidates)
+            {
+                if (liveTriangles[vertex] == 0)
+                {
+                    continue;
+                }
+
+                // Prefer vertices that will still be in the cache after their remaining triangles are emitted
+                int64 priority = 0;
+                if (timestamp - cacheTime[vertex] + 2 * liveTriangles[vertex] <= cacheSize)
+                {
+                    priority = timestamp - cacheTime[vertex];
+                }
+
+                if (priority > bestPriority)
+                {
+                    best = vertex;
+                    bestPriority = priority;
+                }
+            }
+
+            return best;
+        }
+    }
+
+    MeshOptimizerReport MeshOptimizer::Optimize(Mesh& mesh, const MeshOptimizerSettings& settings)
+    {
+        MeshOptimizerReport report;
+        report.before = AnalyzeVertexCache(mesh.indices, mesh.GetVertexCount(), settings.cacheSize);
+
+        std::vector<uint32> clusters;
+        mesh.indices = OptimizeVertexCache(mesh.indices, mesh.GetVertexCount(), settings.cacheSize, &clusters);
+
+        if (settings.optimizeOverdraw)
+        {
+            mesh.indices = OptimizeOverdraw(mesh.indices, clusters, mesh.positions, settings.cacheSize, settings.overdrawThreshold);
+        }
+
+        if (settings.optimizeVertexFetch)
+        {
+            OptimizeVertexFetch(mesh);
+        }
+
+        report.after = AnalyzeVertexCache(mesh.indices, mesh.GetVertexCount(), settings.cacheSize);
+        return report;
+    }
+
+    /**
+     * Reorders triangles for post-transform vertex cache efficiency
+     *
+     * Implementation of "Tipsify" from Sander, Nehab and Barczak,
+     * "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" (SIGGRAPH 2007).
+     *
+     * Algorithm steps:
+     * 1. Fan out all remaining triangles around the current vertex
+     * 2. Pick the next fanning vertex among the 1-ring of the emitted triangles,
+     *    preferring vertices that are likely to still be resident in the cache
+     * 3. On a dead end fall back to recently used vertices, then to input order
+     *
+     * Every dead-end fallback starts a new "hard" cluster; cluster start offsets (in triangles)
+     * are written to clusters and are used as the input of OptimizeOverdraw.
+     *
+     * Runs in linear time and is fully deterministic for a given input.
+     */
+    std::vector<uint32> MeshOptimizer::OptimizeVertexCache(const std::vector<uint32>& indices, uint32 vertexCount,
+        uint32 cacheSize, std::vector<uint32>* clusters)
+    {
+        GINA_ASSERT_MSG(indices.size() % 3 == 0, "Index count must be a multiple of 3");
+        GINA_ASSERT_MSG(cacheSize >= 3, "Vertex cache must hold at least one triangle");
+
+        std::vector<uint32> result;
+        result.reserve(indices.size());
+
+        if (clusters)
+        {
+            clusters->clear();
+        }
+
+        const uint32 triangleCount = static_cast<uint32>(indices.size() / 3);
+        if (triangleCount == 0)
+        {
+            return result;
+        }
+
+        TriangleAdjacency adjacency = TriangleAdjacency::Build(indices, vertexCount);
+        std::vector<uint32> liveTriangles = adjacency.counts;
+        std::vector<uint32> cacheTime(vertexCount, 0);
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<uint32> deadEndStack;
+        std::vector<uint32> candidates;
+        deadEndStack.reserve(indices.size());
+        candidates.reserve(64);
+
+        uint32 timestamp = cacheSize + 1;
+        uint32 inputCursor = 0;
+
+        auto nextFromInputOrder = [&]() -> int64
+        {
+            while (!deadEndStack.empty())
+            {
+                const uint32 vertex = deadEndStack.back();
+                deadEndStack.pop_back();
+                if (liveTriangles[vertex] > 0)
+                {
+                    return vertex;
+                }
+            }
+
+            while (inputCursor < vertexCount)
+            {
+                if (liveTriangles[inputCursor] > 0)
+                {
+                    return inputCursor;
+                }
+                ++inputCursor;
+            }
+
+            return -1;
+        };
+
+        int64 fanningVertex = nextFromInputOrder();
+        bool startsCluster = true;
+
+        while (fanningVertex >= 0)
+        {
+            if (startsCluster && clusters)
+            {
+                clusters->push_back(static_cast<uint32>(result.size() / 3));
+            }
+
+            candidates.clear();
+
+            const uint32 begin = adjacency.offsets[fanningVertex];
+            const uint32 end = adjacency.offsets[fanningVertex + 1];
+            for (uint32 i = begin; i < end; ++i)
+            {
+                const uint32 triangle = adjacency.triangles[i];
+                if (emitted[triangle])
+                {
+                    continue;
+                }
+
+                for (uint32 corner = 0; corner < 3; ++corner)
+                {
+                    const uint32 vertex = indices[triangle * 3 + corner];
+                    result.push_back(vertex);
+                    deadEndStack.push_back(vertex);
+                    candidates.push_back(vertex);
+                    liveTriangles[vertex]--;
+
+                    if (timestamp - cacheTime[vertex] > cacheSize)
+                    {
+                        cacheTime[vertex] = timestamp++;
+                    }
+                }
+
+                emitted[triangle] = true;
+            }
+
+            fanningVertex = SelectNextFanningVertex(candidates, liveTriangles, cacheTime, timestamp, cacheSize);
+            startsCluster = fanningVertex < 0;
+            if (startsCluster)
+            {
+                fanningVertex = nextFromInputOrder();
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * Reorders clusters of triangles to reduce overdraw without hurting vertex cache efficiency
+     *
+     * Hard clusters produced by OptimizeVertexCache are split further into "soft" clusters at
+     * points where the running ACMR stays within threshold of the cluster's ACMR, so reordering
+     * them costs at most that much cache efficiency. Clusters are then sorted by a view-independent
+     * occlusion potential: clusters whose area-weighted normal points away from the mesh centroid
+     * are drawn first, so they tend to occlude the inner parts of the mesh.
+     */
+    std::vector<uint32> MeshOptimizer::OptimizeOverdraw(const std::vector<uint32>& indices, const std::vector<uint32>& clusters,
+        const std::vector<float3>& positions, uint32 cacheSize, float threshold)
+    {
+        GINA_ASSERT_MSG(indices.size() % 3 == 0, "Index count must be a multiple of 3");
+
+        const uint32 triangleCount = static_cast<uint32>(indices.size() / 3);
+        if (triangleCount == 0 || clusters.empty())
+        {
+            return indices;
+        }
+
+        const uint32 vertexCount = static_cast<uint32>(positions.size());
+        VertexCacheSimulator cache(vertexCount, cacheSize);
+
+        std::vector<uint32> softClusters;
+        softClusters.reserve(clusters.size() * 2);
+
+        for (size_t c = 0; c < clusters.size(); ++c)
+        {
+            const uint32 begin = clusters[c];
+            const uint32 end = (c + 1 < clusters.size()) ? clusters[c + 1] : triangleCount;
+
+            cache.Reset();
+            uint32 clusterMisses = 0;
+            for (uint32 t = begin; t < end; ++t)
+            {
+                clusterMisses += cache.Process(indices[t * 3 + 0], indices[t * 3 + 1], indices[t * 3 + 2]);
+            }
+
+            const float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+
+            cache.Reset();
+            softClusters.push_back(begin);
+
+            uint32 runningMisses = 0;
+            uint32 runningTriangles = 0;
+            for (uint32 t = begin; t < end; ++t)
+            {
+                runningMisses += cache.Process(indices[t * 3 + 0], indices[t * 3 + 1], indices[t * 3 + 2]);
+                runningTriangles++;
+
+                if (t + 1 < end && static_cast<float>(runningMisses) / static_cast<float>(runningTriangles) <= clusterThreshold)
+                {
+                    softClusters.push_back(t + 1);
+                    cache.Reset();
+                    runningMisses = 0;
+                    runningTriangles = 0;
+                }
+            }
+        }
+
+        float3 meshCentroid;
+        float meshArea = 0.0f;
+        std::vector<float3> clusterCentroids(softClusters.size());
+        std::vector<float3> clusterNormals(softClusters.size());
+
+        for (size_t c = 0; c < softClusters.size(); ++c)
+        {
+            const uint32 begin = softClusters[c];
+            const uint32 end = (c + 1 < softClusters.size()) ? softClusters[c + 1] : triangleCount;
+
+            float3 centroid;
+            float3 normal;
+            float area = 0.0f;
+
+            for (uint32 t = begin; t < end; ++t)
+            {
+                const float3& p0 = positions[indices[t * 3 + 0]];
+                const float3& p1 = positions[indices[t * 3 + 1]];
+                const float3& p2 = positions[indices[t * 3 + 2]];
+
+                const float3 triangleNormal = cross(p1 - p0, p2 - p0);
+                const float triangleArea = triangleNormal.length();
+
+                centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+                normal += triangleNormal;
+                area += triangleArea;
+            }
+
+            meshCentroid += centroid;
+            meshArea += area;
+
+            clusterCentroids[c] = area > 0.0f ? centroid * (1.0f / area) : positions[indices[begin * 3]];
+            clusterNormals[c] = normal.normalized();
+        }
+
+        if (meshArea > 0.0f)
+        {
+            meshCentroid *= 1.0f / meshArea;
+        }
+
+        std::vector<float> sortKeys(softClusters.size());
+        for (size_t c = 0; c < softClusters.size(); ++c)
+        {
+            sortKeys[c] = dot(clusterCentroids[c] - meshCentroid, clusterNormals[c]);
+        }
+
+        std::vector<uint32> order(softClusters.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32 lhs, uint32 rhs) { return sortKeys[lhs] > sortKeys[rhs]; });
+
+        std::vector<uint32> result;
+        result.reserve(indices.size());
+        for (uint32 c : order)
+        {
+            const uint32 begin = softClusters[c];
+            const uint32 end = (c + 1 < softClusters.size()) ? softClusters[c + 1] : triangleCount;
+            result.insert(result.end(), indices.begin() + begin * 3, indices.begin() + end * 3);
+        }
+
+        return result;
+    }
+
+    /**
+     * Renumbers vertices in the order they are first referenced by the index buffer so that
+     * vertex fetches walk memory linearly. Unreferenced vertices are removed.
+     * Returns the old-to-new remap table (INVALID_VERTEX_INDEX for removed vertices).
+     */
+    std::vector<uint32> MeshOptimizer::OptimizeVertexFetch(Mesh& mesh)
+    {
+        const uint32 vertexCount = mesh.GetVertexCount();
+        std::vector<uint32> remap(vertexCount, INVALID_VERTEX_INDEX);
+
+        uint32 nextVertex = 0;
+        for (uint32& index : mesh.indices)
+        {
+            if (remap[index] == INVALID_VERTEX_INDEX)
+            {
+                remap[index] = nextVertex++;
+            }
+            index = remap[index];
+        }
+
+        auto remapStream = [&remap, nextVertex](auto& stream)
+        {
+            if (stream.empty())
+            {
+                return;
+            }
+
+            std::remove_reference_t<decltype(stream)> remapped(nextVertex);
+            for (size_t v = 0; v < stream.size(); ++v)
+            {
+                if (remap[v] != INVALID_VERTEX_INDEX)
+                {
+                    remapped[remap[v]] = stream[v];
+                }
+            }
+            stream.swap(remapped);
+        };
+
+        remapStream(mesh.positions);
+        remapStream(mesh.normals);
+        remapStream(mesh.texcoords);
+        remapStream(mesh.skinning);
+
+        return remap;
+    }
+
+    VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32>& indices, uint32 vertexCount, uint32 cacheSize)
+    {
+        VertexCacheStatistics statistics;
+
+        const uint32 triangleCount = static_cast<uint32>(indices.size() / 3);
+        if (triangleCount == 0)
+        {
+            return statistics;
+        }
+
+        VertexCacheSimulator cache(vertexCount, cacheSize);
+        std::vector<bool> referenced(vertexCount, false);
+        uint32 referencedCount = 0;
+
+        for (uint32 t = 0; t < triangleCount; ++t)
+        {
+            statistics.verticesTransformed += cache.Process(indices[t * 3 + 0], indices[t * 3 + 1], indices[t * 3 + 2]);
+
+            for (uint32 corner = 0; corner < 3; ++corner)
+            {
+                const uint32 vertex = indices[t * 3 + corner];
+                if (!referenced[vertex])
+                {
+                    referenced[vertex] = true;
+                    referencedCount++;
+                }
+            }
+        }
+
+        statistics.acmr = static_cast<float>(statistics.verticesTransformed) / static_cast<float>(triangleCount);
+        statistics.atvr = static_cast<float>(statistics.verticesTransformed) / static_cast<float>(referencedCount);
+        return statistics;
+    }
+}
@@ -0,0 +1,636 @@
+#include "mesh/gina_mesh_simplifier.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "mesh/gina_mesh_adjacency.h"
+#include "mesh/gina_mesh_optimizer.h"
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    namespace
+    {
+        // Vertices whose open edge count cannot be described by a single in/out edge
+        constexpr uint32 MULTIPLE_EDGES = INVALID_VERTEX_INDEX - 1;
+
+        // Weights of the planes that keep open edges in place, relative to the triangle area weights
+        constexpr float BORDER_EDGE_WEIGHT = 10.0f;
+        constexpr float SEAM_EDGE_WEIGHT = 1.0f;
+
+        // A collapse is rejected when it rotates an adjacent triangle normal further than ~75 degrees
+        constexpr float MIN_FLIP_COSINE = 0.25f;
+
+        // Each pass only performs collapses up to this multiple of the error of the goal-th cheapest one,
+        // so a pass never commits expensive collapses ahead of cheap ones that become available later
+        constexpr float PASS_ERROR_SLACK = 1.5f;
+
+        enum class VertexKind : uint8
+        {
+            Manifold, // interior vertex, can collapse onto any neighbor
+            Border,   // on an open boundary, can only slide along it
+            Seam,     // on an attribute seam (two wedges), both wedges collapse along the seam together
+            Locked,   // anything more complex, never moves
+        };
+
+        struct PositionHasher
+        {
+            size_t operator()(const float3& p) const noexcept
+            {
+                size_t hash = 0;
+                for (uint32 i = 0; i < 3; ++i)
+                {
+                    // +0 and -0 compare equal so they must hash equal
+                    const float value = p[i] == 0.0f ? 0.0f : p[i];
+                    uint32 bits;
+                    std::memcpy(&bits, &value, sizeof(bits));
+                    hash = (hash ^ bits) * 0x100000001B3ull;
+                }
+                return hash;
+            }
+        };
+
+        uint64 EdgeKey(uint32 a, uint32 b) noexcept
+        {
+            return (static_cast<uint64>(a) << 32) | b;
+        }
+
+        // Sum of area-weighted squared plane distances, stored as the symmetric 4x4 matrix
+        // [A b; b^T c] with the plane weights accumulated in w
+        struct Quadric
+        {
+            float a00 = 0.0f, a11 = 0.0f, a22 = 0.0f;
+            float a10 = 0.0f, a20 = 0.0f, a21 = 0.0f;
+            float b0 = 0.0f, b1 = 0.0f, b2 = 0.0f;
+            float c = 0.0f;
+            float w = 0.0f;
+
+            void AddPlane(const float3& n, float d, float weight) noexcept
+            {
+                a00 += weight * n.x * n.x;
+                a11 += weight * n.y * n.y;
+                a22 += weight * n.z * n.z;
+                a10 += weight * n.y * n.x;
+                a20 += weight * n.z * n.x;
+                a21 += weight * n.z * n.y;
+                b0 += weight * n.x * d;
+                b1 += weight * n.y * d;
+                b2 += weight * n.z * d;
+                c += weight * d * d;
+                w += weight;
+            }
+
+            void Add(const Quadric& q) noexcept
+            {
+                a00 += q.a00; a11 += q.a11; a22 += q.a22;
+                a10 += q.a10; a20 += q.a20; a21 += q.a21;
+                b0 += q.b0; b1 += q.b1; b2 += q.b2;
+                c += q.c;
+                w += q.w;
+            }
+
+            // Weighted mean squared distance from p to the accumulated planes
+            float Evaluate(const float3& p) const noexcept
+            {
+                const float rx = a00 * p.x + a10 * p.y + a20 * p.z;
+                const float ry = a10 * p.x + a11 * p.y + a21 * p.z;
+                const float rz = a20 * p.x + a21 * p.y + a22 * p.z;
+                const float r = p.x * rx + p.y * ry + p.z * rz + 2.0f * (p.x * b0 + p.y * b1 + p.z * b2) + c;
+                return w > 0.0f ? std::fabs(r) / w : 0.0f;
+            }
+        };
+
+        struct OpenEdge
+        {
+            uint32 from;
+            uint32 to;
+            uint32 triangle;
+            bool seam;
+        };
+
+        struct Collapse
+        {
+            uint32 source;
+            uint32 target;
+            float cost;
+        };
+
+        // Fraction of skin weight that differs between two vertices, in [0, 1]
+        float SkinDistance(const SkinInfluence& a, const SkinInfluence& b) noexcept
+        {
+            auto weightOf = [](const SkinInfluence& influence, uint16 joint)
+            {
+                float weight = 0.0f;
+                for (uint32 i = 0; i < MAX_SKIN_INFLUENCES; ++i)
+                {
+                    weight += influence.joints[i] == joint ? influence.weights[i] : 0.0f;
+                }
+                return weight;
+            };
+
+            // Unused slots have zero weight and contribute nothing regardless of their joint index
+            float difference = 0.0f;
+            for (uint32 i = 0; i < MAX_SKIN_INFLUENCES; ++i)
+            {
+                if (a.weights[i] > 0.0f)
+                {
+                    difference += std::fabs(a.weights[i] - weightOf(b, a.joints[i]));
+                }
+                if (b.weights[i] > 0.0f && weightOf(a, b.joints[i]) == 0.0f)
+                {
+                    difference += b.weights[i];
+                }
+            }
+            return std::min(difference * 0.5f, 1.0f);
+        }
+
+        class Simplifier
+        {
+        public:
+            Simplifier(const Mesh& mesh, const MeshSimplifySettings& settings)
+                : m_mesh(mesh), m_settings(settings), m_vertexCount(mesh.GetVertexCount())
+            {
+            }
+
+            MeshSimplifyResult Run(const std::vector<uint32>& indices, uint32 targetIndexCount)
+            {
+                MeshSimplifyResult result;
+                result.indices.reserve(indices.size());
+                for (size_t i = 0; i + 2 < indices.size(); i += 3)
+                {
+                    if (indices[i] != indices[i + 1] && indices[i] != indices[i + 2] && indices[i + 1] != indices[i + 2])
+                    {
+                        result.indices.insert(result.indices.end(), { indices[i], indices[i + 1], indices[i + 2] });
+                    }
+                }
+
+                NormalizePositions();
+                BuildPositionRemap();
+                ClassifyVertices(result.indices);
+                BuildQuadrics(result.indices);
+
+                const float errorLimit = m_settings.maxError * m_settings.maxError;
+                float maxCost = 0.0f;
+
+                while (result.indices.size() > targetIndexCount)
+                {
+                    const uint32 trianglesToRemove = static_cast<uint32>(result.indices.size() - targetIndexCount + 2) / 3;
+                    if (!RunPass(result.indices, trianglesToRemove, errorLimit, maxCost))
+                    {
+                        break;
+                    }
+                }
+
+                result.relativeError = std::sqrt(maxCost);
+                result.error = result.relativeError * m_extent;
+                return result;
+            }
+
+        private:
+            void NormalizePositions()
+            {
+                float3 minimum(FLT_MAX);
+                float3 maximum(-FLT_MAX);
+                for (const float3& p : m_mesh.positions)
+                {
+                    minimum = min(minimum, p);
+                    maximum = max(maximum, p);
+                }
+
+                const float3 size = maximum - minimum;
+                m_extent = std::max(size.x, std::max(size.y, size.z));
+                const float scale = m_extent > 0.0f ? 1.0f / m_extent : 1.0f;
+
+                m_positions.resize(m_vertexCount);
+                for (uint32 v = 0; v < m_vertexCount; ++v)
+                {
+                    m_positions[v] = (m_mesh.positions[v] - minimum) * scale;
+                }
+            }
+
+            // Vertices sharing a position (split by normals, UVs or skinning) are wedges of the same
+            // point: remap points at the first of them and wedge links all of them in a cycle
+            void BuildPositionRemap()
+            {
+                std::unordered_map<float3, uint32, PositionHasher> firstVertex;
+                firstVertex.reserve(m_vertexCount);
+
+                m_remap.resize(m_vertexCount);
+                m_wedge.resize(m_vertexCount);
+                for (uint32 v = 0; v < m_vertexCount; ++v)
+                {
+                    m_remap[v] = firstVertex.emplace(m_mesh.positions[v], v).first->second;
+                    m_wedge[v] = v;
+                }
+
+                for (uint32 v = 0; v < m_vertexCount; ++v)
+                {
+                    const uint32 r = m_remap[v];
+                    if (r != v)
+                    {
+                        m_wedge[v] = m_wedge[r];
+                        m_wedge[r] = v;
+                    }
+                }
+            }
+
+            void ClassifyVertices(const std::vector<uint32>& indices)
+            {
+                std::unordered_set<uint64> edges;
+                std::unordered_set<uint64> positionEdges;
+                edges.reserve(indices.size());
+                positionEdges.reserve(indices.size());
+
+                for (size_t i = 0; i < indices.size(); i += 3)
+                {
+                    for (uint32 e = 0; e < 3; ++e)
+                    {
+                        const uint32 a = indices[i + e];
+                        const uint32 b = indices[i + (e + 1) % 3];
+                        edges.insert(EdgeKey(a, b));
+                        positionEdges.insert(EdgeKey(m_remap[a], m_remap[b]));
+                    }
+                }
+
+                // Open edges have no opposite half-edge between the same two vertices; they lie on a
+                // border when the opposite is missing at the position level too, and on a seam otherwise
+                m_openOut.assign(m_vertexCount, INVALID_VERTEX_INDEX);
+                m_openIn.assign(m_vertexCount, INVALID_VERTEX_INDEX);
+                m_openEdges.clear();
+                std::vector<bool> seamEdge(m_vertexCount, false);
+                std::vector<bool> borderEdge(m_vertexCount, false);
+
+                auto link = [](uint32& slot, uint32 vertex)
+                {
+                    slot = slot == INVALID_VERTEX_INDEX ? vertex : MULTIPLE_EDGES;
+                };
+
+                for (size_t i = 0; i < indices.size(); i += 3)
+                {
+                    for (uint32 e = 0; e < 3; ++e)
+                    {
+                        const uint32 a = indices[i + e];
+                        const uint32 b = indices[i + (e + 1) % 3];
+                        if (edges.count(EdgeKey(b, a)) != 0)
+                        {
+                            continue;
+                        }
+
+                        link(m_openOut[a], b);
+                        link(m_openIn[b], a);
+
+                        const bool seam = positionEdges.count(EdgeKey(m_remap[b], m_remap[a])) != 0;
+                        m_openEdges.push_back({ a, b, static_cast<uint32>(i / 3), seam });
+                        (seam ? seamEdge : borderEdge)[a] = true;
+                        (seam ? seamEdge : borderEdge)[b] = true;
+                    }
+                }
+
+                auto hasSingleLoop = [&](uint32 v)
+                {
+                    return m_openOut[v] < MULTIPLE_EDGES && m_openIn[v] < MULTIPLE_EDGES;
+                };
+
+                m_kind.assign(m_vertexCount, VertexKind::Locked);
+                for (uint32 v = 0; v < m_vertexCount; ++v)
+                {
+                    const uint32 w = m_wedge[v];
+                    const bool closed = m_openOut[v] == INVALID_VERTEX_INDEX && m_openIn[v] == INVALID_VERTEX_INDEX;
+
+                    if (w == v)
+                    {
+                        if (closed)
+                        {
+                            m_kind[v] = VertexKind::Manifold;
+                        }
+                        else if (hasSingleLoop(v) && !seamEdge[v] && !m_settings.lockBorders)
+                        {
+                            m_kind[v] = VertexKind::Border;
+                        }
+                    }
+                    else if (m_wedge[w] == v && hasSingleLoop(v) && hasSingleLoop(w) &&
+                        !borderEdge[v] && !borderEdge[w] &&
+                        m_remap[m_openOut[v]] == m_remap[m_openIn[w]] && m_remap[m_openIn[v]] == m_remap[m_openOut[w]])
+                    {
+                        m_kind[v] = VertexKind::Seam;
+                    }
+                }
+            }
+
+            void BuildQuadrics(const std::vector<uint32>& indices)
+            {
+                m_quadrics.assign(m_vertexCount, Quadric());
+
+                auto triangleNormal = [&](size_t triangle)
+                {
+                    const float3& p0 = m_positions[indices[triangle * 3]];
+                    return cross(m_positions[indices[triangle * 3 + 1]] - p0, m_positions[indices[triangle * 3 + 2]] - p0);
+                };
+
+                for (size_t triangle = 0; triangle < indices.size() / 3; ++triangle)
+                {
+                    float3 normal = triangleNormal(triangle);
+                    const float area = normal.length();
+                    if (area <= 0.0f)
+                    {
+                        continue;
+                    }
+                    normal *= 1.0f / area;
+
+                    const float d = -dot(normal, m_positions[indices[triangle * 3]]);
+                    for (uint32 corner = 0; corner < 3; ++corner)
+                    {
+                        m_quadrics[m_remap[indices[triangle * 3 + corner]]].AddPlane(normal, d, area);
+                    }
+                }
+
+                // Open edges get an extra plane through the edge, perpendicular to their triangle,
+                // so borders and seams keep their shape and not only the surface they lie on
+                for (const OpenEdge& open : m_openEdges)
+                {
+                    const float3 edge = m_positions[open.to] - m_positions[open.from];
+                    const float length = edge.length();
+                    const float3 edgeNormal = cross(edge, triangleNormal(open.triangle)).normalized();
+                    if (length <= 0.0f || edgeNormal.isZero())
+                    {
+                        continue;
+                    }
+
+                    const float weight = length * length * (open.seam ? SEAM_EDGE_WEIGHT : BORDER_EDGE_WEIGHT);
+                    const float d = -dot(edgeNormal, m_positions[open.from]);
+                    m_quadrics[m_remap[open.from]].AddPlane(edgeNormal, d, weight);
+                    m_quadrics[m_remap[open.to]].AddPlane(edgeNormal, d, weight);
+                }
+            }
+
+            bool IsOpenEdge(uint32 a, uint32 b) const noexcept
+            {
+                return m_openOut[a] == b || m_openIn[a] == b;
+            }
+
+            bool CanCollapse(uint32 source, uint32 target) const noexcept
+            {
+                if (m_remap[source] == m_remap[target])
+                {
+                    return false;
+                }
+
+                switch (m_kind[source])
+                {
+                case VertexKind::Manifold:
+                    return true;
+                case VertexKind::Border:
+                    return m_kind[target] == VertexKind::Border && IsOpenEdge(source, target);
+                case VertexKind::Seam:
+                    return m_kind[target] == VertexKind::Seam && IsOpenEdge(source, target) &&
+                        IsOpenEdge(m_wedge[source], m_wedge[target]);
+                default:
+                    return false;
+                }
+            }
+
+            float ComputeCost(uint32 source, uint32 target) const noexcept
+            {
+                Quadric quadric = m_quadrics[m_remap[source]];
+                quadric.Add(m_quadrics[m_remap[target]]);
+                float cost = quadric.Evaluate(m_positions[target]);
+
+                if (m_mesh.IsSkinned())
+                {
+                    const float penalty = m_settings.skinWeightPenalty * SkinDistance(m_mesh.skinning[source], m_mesh.skinning[target]);
+                    cost += penalty * penalty;
+                }
+
+                return cost;
+            }
+
+            bool HasTriangleFlips(const TriangleAdjacency& adjacency, const std::vector<uint32>& indices,
+                uint32 source, uint32 target) const
+            {
+                const float3& newPosition = m_positions[target];
+
+                uint32 wedge = source;
+                do
+                {
+                    for (uint32 a = adjacency.offsets[wedge]; a < adjacency.offsets[wedge + 1]; ++a)
+                    {
+                        const uint32* triangle = &indices[adjacency.triangles[a] * 3];
+                        if (m_remap[triangle[0]] == m_remap[target] || m_remap[triangle[1]] == m_remap[target] ||
+                            m_remap[triangle[2]] == m_remap[target])
+                        {
+                            continue; // degenerates and disappears
+                        }
+
+                        float3 corners[3] = { m_positions[triangle[0]], m_positions[triangle[1]], m_positions[triangle[2]] };
+                        const float3 before = cross(corners[1] - corners[0], corners[2] - corners[0]);
+                        for (uint32 corner = 0; corner < 3; ++corner)
+                        {
+                            corners[corner] = triangle[corner] == wedge ? newPosition : corners[corner];
+                        }
+                        const float3 after = cross(corners[1] - corners[0], corners[2] - corners[0]);
+
+                        if (dot(before, after) <= MIN_FLIP_COSINE * before.length() * after.length())
+                        {
+                            return true;
+                        }
+                    }
+                    wedge = m_wedge[wedge];
+                } while (wedge != source);
+
+                return false;
+            }
+
+            /**
+             * One round of edge collapses: every collapsible edge is ranked by its quadric cost, then
+             * collapses are applied cheapest first while neither endpoint has been touched this round,
+             * until enough triangles are removed or the error limit is hit. Returns false when no
+             * collapse could be applied.
+             */
+            bool RunPass(std::vector<uint32>& indices, uint32 trianglesToRemove, float errorLimit, float& maxCost)
+            {
+                std::vector<Collapse> collapses;
+                collapses.reserve(indices.size());
+
+                for (size_t i = 0; i < indices.size(); i += 3)
+                {
+                    for (uint32 e = 0; e < 3; ++e)
+                    {
+                        const uint32 a = indices[i + e];
+                        const uint32 b = indices[i + (e + 1) % 3];
+
+                        Collapse best = { 0, 0, FLT_MAX };
+                        if (CanCollapse(a, b))
+                        {
+                            best = { a, b, ComputeCost(a, b) };
+                        }
+                        if (CanCollapse(b, a))
+                        {
+                            const float cost = ComputeCost(b, a);
+                            if (cost < best.cost)
+                            {
+                                best = { b, a, cost };
+                            }
+                        }
+
+                        if (best.cost <= errorLimit)
+                        {
+                            collapses.push_back(best);
+                        }
+                    }
+                }
+
+                if (collapses.empty())
+                {
+                    return false;
+                }
+
+                std::stable_sort(collapses.begin(), collapses.end(),
+                    [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+                const size_t goal = std::max<size_t>(trianglesToRemove / 2, 1);
+                const float passLimit = goal < collapses.size()
+                    ? std::min(errorLimit, collapses[goal].cost * PASS_ERROR_SLACK)
+                    : errorLimit;
+
+                const TriangleAdjacency adjacency = TriangleAdjacency::Build(indices, m_vertexCount);
+
+                std::vector<uint32> collapseRemap(m_vertexCount);
+                for (uint32 v = 0; v < m_vertexCount; ++v)
+                {
+                    collapseRemap[v] = v;
+                }
+
+                std::vector<bool> touched(m_vertexCount, false);
+                uint32 removed = 0;
+                uint32 applied = 0;
+
+                for (const Collapse& collapse : collapses)
+                {
+                    if (collapse.cost > passLimit || removed >= trianglesToRemove)
+                    {
+                        break;
+                    }
+
+                    const uint32 source = collapse.source;
+                    const uint32 target = collapse.target;
+                    if (touched[m_remap[source]] || touched[m_remap[target]] ||
+                        HasTriangleFlips(adjacency, indices, source, target))
+                    {
+                        continue;
+                    }
+
+                    collapseRemap[source] = target;
+                    if (m_kind[source] == VertexKind::Seam)
+                    {
+                        collapseRemap[m_wedge[source]] = m_wedge[target];
+                    }
+
+                    m_quadrics[m_remap[target]].Add(m_quadrics[m_remap[source]]);
+                    touched[m_remap[source]] = true;
+                    touched[m_remap[target]] = true;
+
+                    maxCost = std::max(maxCost, collapse.cost);
+                    removed += m_kind[source] == VertexKind::Border ? 1 : 2;
+                    ++applied;
+                }
+
+                if (applied == 0)
+                {
+                    return false;
+                }
+
+                size_t write = 0;
+                for (size_t i = 0; i < indices.size(); i += 3)
+                {
+                    const uint32 a = collapseRemap[indices[i]];
+                    const uint32 b = collapseRemap[indices[i + 1]];
+                    const uint32 c = collapseRemap[indices[i + 2]];
+                    if (m_remap[a] == m_remap[b] || m_remap[a] == m_remap[c] || m_remap[b] == m_remap[c])
+                    {
+                        continue;
+                    }
+
+                    indices[write++] = a;
+                    indices[write++] = b;
+                    indices[write++] = c;
+                }
+                indices.resize(write);
+
+                RemapEdgeLoops(m_openOut, collapseRemap);
+                RemapEdgeLoops(m_openIn, collapseRemap);
+                return true;
+            }
+
+            // Open edges that ended at a collapsed vertex now end at its target; when the collapsed
+            // edge itself was the loop edge, the loop continues from wherever the target pointed
+            static void RemapEdgeLoops(std::vector<uint32>& loop, const std::vector<uint32>& collapseRemap)
+            {
+                for (uint32 v = 0; v < loop.size(); ++v)
+                {
+                    const uint32 next = loop[v];
+                    if (next < MULTIPLE_EDGES)
+                    {
+                        const uint32 remapped = collapseRemap[next];
+                        loop[v] = remapped == v ? loop[next] : remapped;
+                    }
+                }
+            }
+
+            const Mesh& m_mesh;
+            const MeshSimplifySettings& m_settings;
+            const uint32 m_vertexCount;
+
+            float m_extent = 0.0f;
+            std::vector<float3> m_positions;
+            std::vector<uint32> m_remap;
+            std::vector<uint32> m_wedge;
+            std::vector<uint32> m_openOut;
+            std::vector<uint32> m_openIn;
+            std::vector<VertexKind> m_kind;
+            std::vector<OpenEdge> m_openEdges;
+            std::vector<Quadric> m_quadrics;
+        };
+    }
+
+    /**
+     * Quadric error edge-collapse simplification (Garland-Heckbert) with endpoint placement
+     *
+     * Vertices are only ever collapsed onto existing vertices, so the result indexes the source vertex
+     * buffer and normals, UVs and skin weights stay exact. Attribute seams are detected as vertices
+     * split into two wedges and may only collapse along the seam, moving both wedges together; borders
+     * may only slide along themselves, and anything more complex is locked. The error is the square
+     * root of the mean squared plane distance accumulated from the original surface, plus a penalty
+     * for merging vertices with different skin influences.
+     */
+    MeshSimplifyResult MeshSimplifier::Simplify(const Mesh& mesh, const std::vector<uint32>& indices,
+        uint32 targetIndexCount, const MeshSimplifySettings& settings)
+    {
+        GINA_ASSERT_MSG(indices.size() % 3 == 0, "Index count must be a multiple of 3");
+        GINA_ASSERT_MSG(!mesh.IsSkinned() || mesh.skinning.size() == mesh.positions.size(), "Skinning stream size mismatch");
+
+        Simplifier simplifier(mesh, settings);
+        return simplifier.Run(indices, targetIndexCount);
+    }
+
+    float MeshSimplifier::ComputeExtent(const Mesh& mesh) noexcept
+    {
+        if (mesh.positions.empty())
+        {
+            return 0.0f;
+        }
+
+        float3 minimum = mesh.positions[0];
+        float3 maximum = mesh.positions[0];
+        for (const float3& p : mesh.positions)
+        {
+            minimum = min(minimum, p);
+            maximum = max(maximum, p);
+        }
+
+        const float3 size = maximum - minimum;
+        return std::max(size.x, std::max(size.y, size.z));
+    }
+}
@@ -0,0 +1,288 @@
+#include "mesh/gina_meshlet.h"
+
+#include "mesh/gina_mesh_adjacency.h"
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    namespace
+    {
+        constexpr uint8 NOT_IN_MESHLET = 0xFF;
+
+        // Cones wider than this (dot product between axis and the most divergent normal)
+        // would almost never cull anything, so they are stored as disabled
+        constexpr float MIN_CONE_SPREAD = 0.1f;
+
+        class MeshletAccumulator
+        {
+        public:
+            MeshletAccumulator(MeshletData& data, uint32 vertexCount)
+                : m_data(data), m_localIndex(vertexCount, NOT_IN_MESHLET)
+            {
+            }
+
+            uint32 CountNewVertices(const uint32* triangle) const noexcept
+            {
+                uint32 count = 0;
+                for (uint32 corner = 0; corner < 3; ++corner)
+                {
+                    count += m_localIndex[triangle[corner]] == NOT_IN_MESHLET ? 1 : 0;
+                }
+
+                // Degenerate triangles that reference the same new vertex twice only add it once
+                if (triangle[0] == triangle[1] || triangle[0] == triangle[2] || triangle[1] == triangle[2])
+                {
+                    count = std::min(count, 2u);
+                }
+                return count;
+            }
+
+            void AddTriangle(const uint32* triangle)
+            {
+                uint32 local[3];
+                for (uint32 corner = 0; corner < 3; ++corner)
+                {
+                    const uint32 vertex = triangle[corner];
+                    if (m_localIndex[vertex] == NOT_IN_MESHLET)
+                    {
+                        m_localIndex[vertex] = static_cast<uint8>(m_current.vertexCount++);
+                        m_data.vertices.push_back(vertex);
+                    }
+                    local[corner] = m_localIndex[vertex];
+                }
+
+                m_data.triangles.push_back(MeshletData::PackTriangle(local[0], local[1], local[2]));
+                m_current.triangleCount++;
+            }
+
+            void Flush()
+            {
+                if (m_current.triangleCount == 0)
+                {
+                    return;
+                }
+
+                for (uint32 i = 0; i < m_current.vertexCount; ++i)
+                {
+                    m_localIndex[m_data.vertices[m_current.vertexOffset + i]] = NOT_IN_MESHLET;
+                }
+
+                m_data.meshlets.push_back(m_current);
+
+                m_current = Meshlet();
+                m_current.vertexOffset = static_cast<uint32>(m_data.vertices.size());
+                m_current.triangleOffset = static_cast<uint32>(m_data.triangles.size());
+            }
+
+            const Meshlet& GetCurrent() const noexcept { return m_current; }
+
+        private:
+            MeshletData& m_data;
+            std::vector<uint8> m_localIndex;
+            Meshlet m_current;
+        };
+    }
+
+    /**
+     * Splits a mesh into meshlets of at most maxVertices vertices and maxTriangles triangles
+     *
+     * Greedy growth: each step adds the triangle adjacent to the current meshlet that
+     * introduces the fewest new vertices (lowest triangle index on ties), which keeps meshlets
+     * compact and their normal cones tight. When no adjacent triangle fits, the meshlet is
+     * closed and a new one is seeded from the next unassigned triangle in index buffer order,
+     * so running MeshOptimizer first gives spatially coherent seeds.
+     */
+    MeshletData MeshletBuilder::Build(const Mesh& mesh, const MeshletBuildSettings& settings)
+    {
+        GINA_ASSERT_MSG(settings.maxVertices >= 3 && settings.maxVertices <= 255, "Meshlet vertex limit must be in [3, 255]");
+        GINA_ASSERT_MSG(settings.maxTriangles >= 1, "Meshlet triangle limit must be positive");
+
+        MeshletData data;
+
+        const uint32 vertexCount = mesh.GetVertexCount();
+        const uint32 triangleCount = mesh.GetTriangleCount();
+        if (triangleCount == 0)
+        {
+            return data;
+        }
+
+        data.vertices.reserve(mesh.indices.size());
+        data.triangles.reserve(triangleCount);
+
+        const TriangleAdjacency adjacency = TriangleAdjacency::Build(mesh.indices, vertexCount);
+        std::vector<bool> emitted(triangleCount, false);
+        MeshletAccumulator accumulator(data, vertexCount);
+
+        uint32 seedCursor = 0;
+        uint32 remaining = triangleCount;
+
+        while (remaining > 0)
+        {
+            const Meshlet& current = accumulator.GetCurrent();
+
+            int64 best = -1;
+            uint32 bestNewVertices = 4;
+
+            for (uint32 i = 0; i < current.vertexCount; ++i)
+            {
+                const uint32 vertex = data.vertices[current.vertexOffset + i];
+                for (uint32 a = adjacency.offsets[vertex]; a < adjacency.offsets[vertex + 1]; ++a)
+                {
+                    const uint32 triangle = adjacency.triangles[a];
+                    if (emitted[triangle])
+                    {
+                        continue;
+                    }
+
+                    const uint32 newVertices = accumulator.CountNewVertices(&mesh.indices[triangle * 3]);
+                    if (current.vertexCount + newVertices > settings.maxVertices)
+                    {
+                        continue;
+                    }
+
+                    if (newVertices < bestNewVertices || (newVertices == bestNewVertices && triangle < best))
+                    {
+                        best = triangle;
+                        bestNewVertices = newVertices;
+                    }
+                }
+            }
+
+            if (best < 0)
+            {
+                accumulator.Flush();
+
+                while (emitted[seedCursor])
+                {
+                    ++seedCursor;
+                }
+                best = seedCursor;
+            }
+
+            accumulator.AddTriangle(&mesh.indices[best * 3]);
+            emitted[best] = true;
+            --remaining;
+
+            if (accumulator.GetCurrent().triangleCount >= settings.maxTriangles)
+            {
+                accumulator.Flush();
+            }
+        }
+
+        accumulator.Flush();
+
+        const bool computeCones = settings.computeCones && !mesh.IsSkinned();
+        data.bounds.reserve(data.meshlets.size());
+        for (const Meshlet& meshlet : data.meshlets)
+        {
+            data.bounds.push_back(ComputeBounds(mesh, data, meshlet, computeCones));
+        }
+
+        return data;
+    }
+
+    /**
+     * Computes the bounding sphere (Ritter's approximation) and the backface normal cone of a meshlet
+     *
+     * The cone axis is the normalized average of the triangle normals; the cutoff is the sine of
+     * the angle between the axis and the most divergent normal. A meshlet is entirely back-facing when
+     *   dot(center - camera, axis) >= cutoff * length(center - camera) + radius
+     * Triangle normals follow cross(p1 - p0, p2 - p0), i.e. counter-clockwise front faces as imported.
+     */
+    MeshletBounds MeshletBuilder::ComputeBounds(const Mesh& mesh, const MeshletData& data, const Meshlet& meshlet, bool computeCone)
+    {
+        MeshletBounds bounds;
+        if (meshlet.vertexCount == 0)
+        {
+            return bounds;
+        }
+
+        auto position = [&](uint32 localIndex) -> const float3&
+        {
+            return mesh.positions[data.vertices[meshlet.vertexOffset + localIndex]];
+        };
+
+        auto farthestFrom = [&](const float3& origin) -> uint32
+        {
+            uint32 farthest = 0;
+            float farthestDistance = -1.0f;
+            for (uint32 i = 0; i < meshlet.vertexCount; ++i)
+            {
+                const float distanceSquared = (position(i) - origin).lengthSquared();
+                if (distanceSquared > farthestDistance)
+                {
+                    farthest = i;
+                    farthestDistance = distanceSquared;
+                }
+            }
+            return farthest;
+        };
+
+        const float3& p1 = position(farthestFrom(position(0)));
+        const float3& p2 = position(farthestFrom(p1));
+
+        float3 center = (p1 + p2) * 0.5f;
+        float radius = distance(p1, p2) * 0.5f;
+
+        for (uint32 i = 0; i < meshlet.vertexCount; ++i)
+        {
+            const float3& p = position(i);
+            const float d = distance(p, center);
+            if (d > radius)
+            {
+                const float newRadius = (radius + d) * 0.5f;
+                center += (p - center) * ((newRadius - radius) / d);
+                radius = newRadius;
+            }
+        }
+
+        bounds.center = center;
+        bounds.radius = radius;
+
+        if (!computeCone)
+        {
+            return bounds;
+        }
+
+        auto triangleNormal = [&](uint32 triangle) -> float3
+        {
+            const uint32 packed = data.triangles[meshlet.triangleOffset + triangle];
+            const float3& a = position(MeshletData::UnpackIndex(packed, 0));
+            const float3& b = position(MeshletData::UnpackIndex(packed, 1));
+            const float3& c = position(MeshletData::UnpackIndex(packed, 2));
+            return cross(b - a, c - a).normalized();
+        };
+
+        float3 axis;
+        for (uint32 t = 0; t < meshlet.triangleCount; ++t)
+        {
+            axis += triangleNormal(t);
+        }
+
+        if (axis.lengthSquared() < EPSILON)
+        {
+            return bounds;
+        }
+
+        axis.normalize();
+
+        float minDot = 1.0f;
+        for (uint32 t = 0; t < meshlet.triangleCount; ++t)
+        {
+            const float3 normal = triangleNormal(t);
+            if (!normal.isZero())
+            {
+                minDot = std::min(minDot, dot(axis, normal));
+            }
+        }
+
+        if (minDot <= MIN_CONE_SPREAD)
+        {
+            return bounds;
+        }
+
+        bounds.coneAxis = axis;
+        bounds.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+        return bounds;
+    }
+}
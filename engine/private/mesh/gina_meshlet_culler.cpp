@@ -0,0 +1,146 @@
+#include "mesh/gina_meshlet_culler.h"
+
+#include "core/gina_cpu_features.h"
+
+namespace gina
+{
+    MeshletCuller::CullFunc MeshletCuller::cullImpl = MeshletCuller::SelectImpl();
+
+    MeshletCuller::CullFunc MeshletCuller::SelectImpl() noexcept
+    {
+#if defined(GINA_SSE2_ENABLED)
+        if (CpuFeatures::HasSSE2())
+        {
+            return &MeshletCuller::CullSSE2;
+        }
+#endif
+        return &MeshletCuller::CullScalar;
+    }
+
+    uint32 MeshletCuller::Cull(const MeshletBounds* bounds, uint32 count, const Frustum& frustum,
+        const float3& cameraPosition, uint32* visibleIndices) noexcept
+    {
+        return cullImpl(bounds, count, frustum, cameraPosition, visibleIndices);
+    }
+
+    bool MeshletCuller::IsVisible(const MeshletBounds& bounds, const Frustum& frustum, const float3& cameraPosition) noexcept
+    {
+        if (!frustum.IntersectsSphere(bounds.center, bounds.radius))
+        {
+            return false;
+        }
+
+        const float3 toCenter = bounds.center - cameraPosition;
+        return dot(toCenter, bounds.coneAxis) < bounds.coneCutoff * toCenter.length() + bounds.radius;
+    }
+
+    uint32 MeshletCuller::CullScalar(const MeshletBounds* bounds, uint32 count, const Frustum& frustum,
+        const float3& cameraPosition, uint32* visibleIndices) noexcept
+    {
+        uint32 visibleCount = 0;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            if (IsVisible(bounds[i], frustum, cameraPosition))
+            {
+                visibleIndices[visibleCount++] = i;
+            }
+        }
+        return visibleCount;
+    }
+
+#if defined(GINA_SSE2_ENABLED)
+    /**
+     * Tests four meshlets per iteration
+     *
+     * Each MeshletBounds is two float4 rows (center/radius and axis/cutoff); four of them are
+     * loaded and transposed into SoA registers, tested against all six planes and the cone,
+     * and the resulting lane mask is compacted into the output index list.
+     */
+    uint32 MeshletCuller::CullSSE2(const MeshletBounds* bounds, uint32 count, const Frustum& frustum,
+        const float3& cameraPosition, uint32* visibleIndices) noexcept
+    {
+        __m128 planeX[Frustum::PLANE_COUNT];
+        __m128 planeY[Frustum::PLANE_COUNT];
+        __m128 planeZ[Frustum::PLANE_COUNT];
+        __m128 planeD[Frustum::PLANE_COUNT];
+
+        for (uint32 p = 0; p < Frustum::PLANE_COUNT; ++p)
+        {
+            planeX[p] = _mm_set1_ps(frustum.planes[p].normal.x);
+            planeY[p] = _mm_set1_ps(frustum.planes[p].normal.y);
+            planeZ[p] = _mm_set1_ps(frustum.planes[p].normal.z);
+            planeD[p] = _mm_set1_ps(frustum.planes[p].distance);
+        }
+
+        const __m128 cameraX = _mm_set1_ps(cameraPosition.x);
+        const __m128 cameraY = _mm_set1_ps(cameraPosition.y);
+        const __m128 cameraZ = _mm_set1_ps(cameraPosition.z);
+        const __m128 zero = _mm_setzero_ps();
+
+        uint32 visibleCount = 0;
+        uint32 i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const float* rows = reinterpret_cast<const float*>(bounds + i);
+
+            __m128 centerX = _mm_loadu_ps(rows + 0);
+            __m128 centerY = _mm_loadu_ps(rows + 8);
+            __m128 centerZ = _mm_loadu_ps(rows + 16);
+            __m128 radius = _mm_loadu_ps(rows + 24);
+            _MM_TRANSPOSE4_PS(centerX, centerY, centerZ, radius);
+
+            __m128 axisX = _mm_loadu_ps(rows + 4);
+            __m128 axisY = _mm_loadu_ps(rows + 12);
+            __m128 axisZ = _mm_loadu_ps(rows + 20);
+            __m128 cutoff = _mm_loadu_ps(rows + 28);
+            _MM_TRANSPOSE4_PS(axisX, axisY, axisZ, cutoff);
+
+            const __m128 negRadius = _mm_sub_ps(zero, radius);
+            __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+            for (uint32 p = 0; p < Frustum::PLANE_COUNT; ++p)
+            {
+                __m128 signedDistance = _mm_mul_ps(planeX[p], centerX);
+                signedDistance = _mm_add_ps(signedDistance, _mm_mul_ps(planeY[p], centerY));
+                signedDistance = _mm_add_ps(signedDistance, _mm_mul_ps(planeZ[p], centerZ));
+                signedDistance = _mm_add_ps(signedDistance, planeD[p]);
+                visible = _mm_and_ps(visible, _mm_cmpge_ps(signedDistance, negRadius));
+            }
+
+            const __m128 toCenterX = _mm_sub_ps(centerX, cameraX);
+            const __m128 toCenterY = _mm_sub_ps(centerY, cameraY);
+            const __m128 toCenterZ = _mm_sub_ps(centerZ, cameraZ);
+
+            __m128 lengthSquared = _mm_mul_ps(toCenterX, toCenterX);
+            lengthSquared = _mm_add_ps(lengthSquared, _mm_mul_ps(toCenterY, toCenterY));
+            lengthSquared = _mm_add_ps(lengthSquared, _mm_mul_ps(toCenterZ, toCenterZ));
+
+            __m128 coneDot = _mm_mul_ps(toCenterX, axisX);
+            coneDot = _mm_add_ps(coneDot, _mm_mul_ps(toCenterY, axisY));
+            coneDot = _mm_add_ps(coneDot, _mm_mul_ps(toCenterZ, axisZ));
+
+            const __m128 coneLimit = _mm_add_ps(_mm_mul_ps(cutoff, _mm_sqrt_ps(lengthSquared)), radius);
+            visible = _mm_and_ps(visible, _mm_cmplt_ps(coneDot, coneLimit));
+
+            int mask = _mm_movemask_ps(visible);
+            while (mask)
+            {
+                const int lane = mask & (-mask);
+                visibleIndices[visibleCount++] = i + (lane == 1 ? 0 : lane == 2 ? 1 : lane == 4 ? 2 : 3);
+                mask &= mask - 1;
+            }
+        }
+
+        for (; i < count; ++i)
+        {
+            if (IsVisible(bounds[i], frustum, cameraPosition))
+            {
+                visibleIndices[visibleCount++] = i;
+            }
+        }
+
+        return visibleCount;
+    }
+#endif
+}
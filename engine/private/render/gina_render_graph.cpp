@@ -0,0 +1,487 @@
+#include "render/gina_render_graph.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+#include "core/gina_assert.h"
+#include "core/gina_logger.h"
+#include "rhi/gina_resource_state_tracker.h"
+
+namespace gina
+{
+    namespace
+    {
+        uint64 AlignUp(uint64 value, uint64 alignment) noexcept
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        bool Overlaps(const RenderGraphResourceInfo& a, const RenderGraphResourceInfo& b) noexcept
+        {
+            return a.firstPass <= b.lastPass && b.firstPass <= a.lastPass;
+        }
+    }
+
+    RenderGraphHandle RenderGraph::AddResource(Resource resource)
+    {
+        const RenderGraphHandle handle = static_cast<RenderGraphHandle>(m_versions.size());
+        resource.latest = handle;
+        m_versions.push_back({ static_cast<uint32>(m_resources.size()), INVALID_RENDER_GRAPH_PASS, INVALID_RENDER_GRAPH_HANDLE, {} });
+        m_resources.push_back(std::move(resource));
+        return handle;
+    }
+
+    RenderGraphHandle RenderGraph::CreateTexture(const RHITextureDesc& desc)
+    {
+        Resource resource;
+        resource.info.name = desc.name;
+        resource.info.textureDesc = desc;
+        return AddResource(std::move(resource));
+    }
+
+    RenderGraphHandle RenderGraph::CreateBuffer(const RHIBufferDesc& desc)
+    {
+        Resource resource;
+        resource.info.name = desc.name;
+        resource.info.texture = false;
+        resource.info.bufferDesc = desc;
+        return AddResource(std::move(resource));
+    }
+
+    RenderGraphHandle RenderGraph::ImportTexture(const RHITextureDesc& desc, RHIResourceHandle physical, RHIResourceState initialState,
+        RHIResourceState finalState)
+    {
+        Resource resource;
+        resource.info.name = desc.name;
+        resource.info.imported = true;
+        resource.info.textureDesc = desc;
+        resource.physical = physical;
+        resource.initialState = initialState;
+        resource.finalState = finalState;
+        return AddResource(std::move(resource));
+    }
+
+    RenderGraphHandle RenderGraph::ImportBuffer(const RHIBufferDesc& desc, RHIResourceHandle physical, RHIResourceState initialState,
+        RHIResourceState finalState)
+    {
+        Resource resource;
+        resource.info.name = desc.name;
+        resource.info.texture = false;
+        resource.info.imported = true;
+        resource.info.bufferDesc = desc;
+        resource.physical = physical;
+        resource.initialState = initialState;
+        resource.finalState = finalState;
+        return AddResource(std::move(resource));
+    }
+
+    uint32 RenderGraph::AddPass(std::string name, ExecuteFunc execute, bool sideEffects)
+    {
+        Pass pass;
+        pass.name = std::move(name);
+        pass.execute = std::move(execute);
+        pass.sideEffects = sideEffects;
+        m_passes.push_back(std::move(pass));
+        return static_cast<uint32>(m_passes.size() - 1);
+    }
+
+    void RenderGraph::Read(uint32 pass, RenderGraphHandle handle, RHIResourceState state)
+    {
+        GINA_ASSERT_MSG(pass < m_passes.size() && handle < m_versions.size(), "Unknown pass or resource");
+        m_versions[handle].readers.push_back(pass);
+        m_passes[pass].accesses.push_back({ handle, state, false });
+    }
+
+    RenderGraphHandle RenderGraph::Write(uint32 pass, RenderGraphHandle handle, RHIResourceState state)
+    {
+        GINA_ASSERT_MSG(pass < m_passes.size() && handle < m_versions.size(), "Unknown pass or resource");
+        Resource& resource = m_resources[m_versions[handle].resource];
+        GINA_ASSERT_MSG(resource.latest == handle, "Writing an older version of a resource would fork its contents");
+
+        const RenderGraphHandle written = static_cast<RenderGraphHandle>(m_versions.size());
+        m_versions.push_back({ m_versions[handle].resource, pass, handle, {} });
+        resource.latest = written;
+        m_passes[pass].accesses.push_back({ written, state, true });
+        return written;
+    }
+
+    void RenderGraph::CollectDependencies(std::vector<std::vector<uint32>>& producers, std::vector<std::vector<uint32>>& readers) const
+    {
+        producers.assign(m_passes.size(), {});
+        readers.assign(m_passes.size(), {});
+        for (uint32 pass = 0; pass < m_passes.size(); ++pass)
+        {
+            for (const Access& access : m_passes[pass].accesses)
+            {
+                const Version& version = m_versions[access.handle];
+                if (!access.write)
+                {
+                    // Read after write
+                    if (version.writer != INVALID_RENDER_GRAPH_PASS && version.writer != pass)
+                    {
+                        producers[pass].push_back(version.writer);
+                    }
+                    continue;
+                }
+
+                // Write after write keeps the earlier contents, write after read waits for the readers
+                const Version& previous = m_versions[version.previous];
+                if (previous.writer != INVALID_RENDER_GRAPH_PASS && previous.writer != pass)
+                {
+                    producers[pass].push_back(previous.writer);
+                }
+                for (uint32 reader : previous.readers)
+                {
+                    if (reader != pass)
+                    {
+                        readers[pass].push_back(reader);
+                    }
+                }
+            }
+        }
+    }
+
+    bool RenderGraph::Compile(const RHIDevice* device)
+    {
+        m_compiled.clear();
+        m_finalBarriers.clear();
+        m_report = RenderGraphMemoryReport();
+
+        std::vector<std::vector<uint32>> producers;
+        std::vector<std::vector<uint32>> readers;
+        CollectDependencies(producers, readers);
+
+        // Culling: keep what the roots depend on, walking the data flow backwards. Overwriting what a pass
+        // read only orders the two, it does not make the reader needed
+        std::vector<uint32> stack;
+        for (uint32 pass = 0; pass < m_passes.size(); ++pass)
+        {
+            Pass& current = m_passes[pass];
+            current.culled = true;
+            const bool writesImported = std::any_of(current.accesses.begin(), current.accesses.end(), [&](const Access& access)
+            {
+                return access.write && m_resources[m_versions[access.handle].resource].info.imported;
+            });
+            if (current.sideEffects || writesImported)
+            {
+                stack.push_back(pass);
+            }
+        }
+        while (!stack.empty())
+        {
+            const uint32 pass = stack.back();
+            stack.pop_back();
+            if (!m_passes[pass].culled)
+            {
+                continue;
+            }
+            m_passes[pass].culled = false;
+            stack.insert(stack.end(), producers[pass].begin(), producers[pass].end());
+        }
+
+        // Topological sort of the survivors, ties going to declaration order so the result is stable
+        std::vector<uint32> pendingCount(m_passes.size(), 0);
+        std::vector<std::vector<uint32>> successors(m_passes.size());
+        uint32 liveCount = 0;
+        for (uint32 pass = 0; pass < m_passes.size(); ++pass)
+        {
+            if (m_passes[pass].culled)
+            {
+                ++m_report.culledPasses;
+                continue;
+            }
+            ++liveCount;
+            for (const std::vector<uint32>* predecessors : { &producers[pass], &readers[pass] })
+            {
+                for (uint32 predecessor : *predecessors)
+                {
+                    if (!m_passes[predecessor].culled)
+                    {
+                        successors[predecessor].push_back(pass);
+                        ++pendingCount[pass];
+                    }
+                }
+            }
+        }
+
+        std::priority_queue<uint32, std::vector<uint32>, std::greater<uint32>> ready;
+        for (uint32 pass = 0; pass < m_passes.size(); ++pass)
+        {
+            if (!m_passes[pass].culled && pendingCount[pass] == 0)
+            {
+                ready.push(pass);
+            }
+        }
+        std::vector<uint32> order;
+        order.reserve(liveCount);
+        while (!ready.empty())
+        {
+            const uint32 pass = ready.top();
+            ready.pop();
+            order.push_back(pass);
+            for (uint32 successor : successors[pass])
+            {
+                if (--pendingCount[successor] == 0)
+                {
+                    ready.push(successor);
+                }
+            }
+        }
+        if (order.size() != liveCount)
+        {
+            LOG_ERROR("Render graph has a dependency cycle between {} passes", liveCount - static_cast<uint32>(order.size()));
+            return false;
+        }
+
+        AssignLifetimes(order, device);
+        AliasTransients();
+        ComputeBarriers(order);
+        return true;
+    }
+
+    void RenderGraph::AssignLifetimes(const std::vector<uint32>& order, const RHIDevice* device)
+    {
+        for (Resource& resource : m_resources)
+        {
+            RenderGraphResourceInfo& info = resource.info;
+            info.used = false;
+            info.firstPass = INVALID_RENDER_GRAPH_PASS;
+            info.lastPass = INVALID_RENDER_GRAPH_PASS;
+            info.heapOffset = 0;
+            if (!info.texture)
+            {
+                info.size = info.bufferDesc.size;
+            }
+            else
+            {
+                info.size = device ? device->GetPlacedTextureSize(info.textureDesc) : GetTextureSize(info.textureDesc);
+            }
+        }
+
+        for (uint32 position = 0; position < order.size(); ++position)
+        {
+            for (const Access& access : m_passes[order[position]].accesses)
+            {
+                RenderGraphResourceInfo& info = m_resources[m_versions[access.handle].resource].info;
+                if (!info.used)
+                {
+                    info.used = true;
+                    info.firstPass = position;
+                }
+                info.lastPass = position;
+            }
+        }
+    }
+
+    void RenderGraph::AliasTransients()
+    {
+        // Largest first: the big targets settle at the bottom of the heap and small ones fill the gaps
+        std::vector<uint32> transients;
+        for (uint32 index = 0; index < m_resources.size(); ++index)
+        {
+            const RenderGraphResourceInfo& info = m_resources[index].info;
+            if (info.used && !info.imported)
+            {
+                transients.push_back(index);
+                ++m_report.transientResources;
+                m_report.transientBytes += AlignUp(info.size, RENDER_GRAPH_PLACEMENT_ALIGNMENT);
+            }
+        }
+        std::stable_sort(transients.begin(), transients.end(), [&](uint32 a, uint32 b)
+        {
+            return m_resources[a].info.size > m_resources[b].info.size;
+        });
+
+        // Interval packing: a resource takes the lowest offset clear of every placed resource alive at the same time
+        std::vector<uint32> placed;
+        std::vector<std::pair<uint64, uint64>> taken;
+        for (uint32 index : transients)
+        {
+            RenderGraphResourceInfo& info = m_resources[index].info;
+            const uint64 size = AlignUp(info.size, RENDER_GRAPH_PLACEMENT_ALIGNMENT);
+
+            taken.clear();
+            for (uint32 other : placed)
+            {
+                const RenderGraphResourceInfo& otherInfo = m_resources[other].info;
+                if (Overlaps(info, otherInfo))
+                {
+                    taken.push_back({ otherInfo.heapOffset, otherInfo.heapOffset + AlignUp(otherInfo.size, RENDER_GRAPH_PLACEMENT_ALIGNMENT) });
+                }
+            }
+            std::sort(taken.begin(), taken.end());
+
+            uint64 offset = 0;
+            for (const std::pair<uint64, uint64>& range : taken)
+            {
+                if (offset + size <= range.first)
+                {
+                    break;
+                }
+                offset = std::max(offset, range.second);
+            }
+
+            info.heapOffset = offset;
+            m_report.heapBytes = std::max(m_report.heapBytes, offset + size);
+            placed.push_back(index);
+        }
+    }
+
+    void RenderGraph::ComputeBarriers(const std::vector<uint32>& order)
+    {
+        ResourceStateTracker tracker;
+        for (uint32 index = 0; index < m_resources.size(); ++index)
+        {
+            tracker.Register({ index }, 1, m_resources[index].initialState);
+        }
+
+        // Per resource, the positions using it and the state the first access of each wants
+        std::vector<std::vector<std::pair<uint32, RHIResourceState>>> uses(m_resources.size());
+        for (uint32 position = 0; position < order.size(); ++position)
+        {
+            for (const Access& access : m_passes[order[position]].accesses)
+            {
+                std::vector<std::pair<uint32, RHIResourceState>>& resourceUses = uses[m_versions[access.handle].resource];
+                if (resourceUses.empty() || resourceUses.back().first != position)
+                {
+                    resourceUses.push_back({ position, access.state });
+                }
+            }
+        }
+        std::vector<uint32> nextUse(m_resources.size(), 0);
+
+        m_compiled.resize(order.size());
+        for (uint32 position = 0; position < order.size(); ++position)
+        {
+            RenderGraphCompiledPass& compiled = m_compiled[position];
+            compiled.pass = order[position];
+            for (const Access& access : m_passes[compiled.pass].accesses)
+            {
+                tracker.Use({ m_versions[access.handle].resource }, access.state);
+            }
+            tracker.Flush(compiled.barriers);
+
+            // A resource written here and only read a few passes later starts moving now; the begin half
+            // goes out with the next pass's batch
+            for (const Access& access : m_passes[compiled.pass].accesses)
+            {
+                const uint32 resource = m_versions[access.handle].resource;
+                const std::vector<std::pair<uint32, RHIResourceState>>& resourceUses = uses[resource];
+                uint32& next = nextUse[resource];
+                while (next < resourceUses.size() && resourceUses[next].first <= position)
+                {
+                    ++next;
+                }
+                if (access.write && next < resourceUses.size() && resourceUses[next].first > position + 1 &&
+                    IsReadOnlyState(resourceUses[next].second))
+                {
+                    tracker.BeginTransition({ resource }, resourceUses[next].second);
+                }
+            }
+        }
+
+        for (uint32 index = 0; index < m_resources.size(); ++index)
+        {
+            if (m_resources[index].info.imported)
+            {
+                tracker.Use({ index }, m_resources[index].finalState);
+            }
+        }
+        tracker.Flush(m_finalBarriers);
+
+        // Memory taken over from a resource that died earlier needs an aliasing barrier, ahead of the pass's transitions
+        for (uint32 index = 0; index < m_resources.size(); ++index)
+        {
+            const RenderGraphResourceInfo& info = m_resources[index].info;
+            if (!info.used || info.imported)
+            {
+                continue;
+            }
+            const uint64 end = info.heapOffset + AlignUp(info.size, RENDER_GRAPH_PLACEMENT_ALIGNMENT);
+            const bool aliased = std::any_of(m_resources.begin(), m_resources.end(), [&](const Resource& other)
+            {
+                const RenderGraphResourceInfo& otherInfo = other.info;
+                return otherInfo.used && !otherInfo.imported && otherInfo.lastPass < info.firstPass &&
+                    otherInfo.heapOffset < end && info.heapOffset < otherInfo.heapOffset + AlignUp(otherInfo.size, RENDER_GRAPH_PLACEMENT_ALIGNMENT);
+            });
+            if (aliased)
+            {
+                RenderGraphCompiledPass& compiled = m_compiled[info.firstPass];
+                compiled.activations.push_back(index);
+                compiled.barriers.insert(compiled.barriers.begin() + (compiled.activations.size() - 1),
+                    { { index }, RHIResourceState::Common, RHIResourceState::Common, ALL_RHI_SUBRESOURCES, RHIBarrierFlags::Aliasing });
+            }
+        }
+    }
+
+    void RenderGraph::PlaceTransients(RHIDevice& device, RHIHeapHandle heap, std::vector<RHIResourceHandle>& created)
+    {
+        for (Resource& resource : m_resources)
+        {
+            const RenderGraphResourceInfo& info = resource.info;
+            if (!info.used || info.imported)
+            {
+                continue;
+            }
+            resource.physical = info.texture ? device.CreatePlacedTexture(heap, info.heapOffset, info.textureDesc) :
+                device.CreatePlacedBuffer(heap, info.heapOffset, info.bufferDesc);
+            created.push_back(resource.physical);
+        }
+    }
+
+    void RenderGraph::Execute(RHICommandList& list) const
+    {
+        std::vector<RHIBarrier> barriers;
+        auto issue = [&](const std::vector<RHIBarrier>& graphBarriers)
+        {
+            if (graphBarriers.empty())
+            {
+                return;
+            }
+            barriers = graphBarriers;
+            for (RHIBarrier& barrier : barriers)
+            {
+                barrier.resource = m_resources[barrier.resource.id].physical;
+                GINA_ASSERT_MSG(barrier.resource.IsValid(), "Render graph resource has no physical resource");
+            }
+            list.Barrier(barriers.data(), static_cast<uint32>(barriers.size()));
+        };
+
+        for (const RenderGraphCompiledPass& compiled : m_compiled)
+        {
+            issue(compiled.barriers);
+            const Pass& pass = m_passes[compiled.pass];
+            if (pass.execute)
+            {
+                pass.execute(list, *this);
+            }
+        }
+        issue(m_finalBarriers);
+    }
+
+    void RenderGraph::Clear()
+    {
+        m_resources.clear();
+        m_versions.clear();
+        m_passes.clear();
+        m_compiled.clear();
+        m_finalBarriers.clear();
+        m_report = RenderGraphMemoryReport();
+    }
+
+    const RenderGraphResourceInfo& RenderGraph::GetResourceInfo(RenderGraphHandle handle) const noexcept
+    {
+        return m_resources[m_versions[handle].resource].info;
+    }
+
+    void RenderGraph::SetPhysicalResource(RenderGraphHandle handle, RHIResourceHandle physical)
+    {
+        m_resources[m_versions[handle].resource].physical = physical;
+    }
+
+    RHIResourceHandle RenderGraph::GetPhysicalResource(RenderGraphHandle handle) const noexcept
+    {
+        return m_resources[m_versions[handle].resource].physical;
+    }
+}
@@ -0,0 +1,113 @@
+#include "rhi/gina_command_list_pool.h"
+
+#include <algorithm>
+
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    CommandListPool::CommandListPool(RHIDevice& device, RHIQueueType type)
+        : m_device(&device), m_type(type)
+    {
+    }
+
+    void CommandListPool::BeginFrame(uint64 fenceValue, uint64 completedValue)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        GINA_ASSERT_MSG(m_recording.empty(), "Lists of the previous frame were never submitted");
+        m_fenceValue = fenceValue;
+
+        while (!m_pendingAllocators.empty() && m_pendingAllocators.front().fenceValue <= completedValue)
+        {
+            std::unique_ptr<RHICommandAllocator>& allocator = m_pendingAllocators.front().allocator;
+            allocator->Reset();
+            m_freeAllocators.push_back(std::move(allocator));
+            m_pendingAllocators.pop_front();
+            ++m_stats.recycledAllocators;
+        }
+    }
+
+    RHICommandList& CommandListPool::Acquire(uint32 order)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Recording& recording = m_recording.emplace_back();
+        recording.order = order;
+
+        if (!m_freeAllocators.empty())
+        {
+            recording.allocator = std::move(m_freeAllocators.back());
+            m_freeAllocators.pop_back();
+        }
+        else
+        {
+            recording.allocator = m_device->CreateCommandAllocator(m_type);
+            ++m_stats.allocators;
+        }
+
+        if (!m_freeLists.empty())
+        {
+            recording.list = std::move(m_freeLists.back());
+            m_freeLists.pop_back();
+        }
+        else
+        {
+            recording.list = m_device->CreateCommandList(m_type);
+            ++m_stats.lists;
+        }
+
+        recording.list->Begin(*recording.allocator);
+        return *recording.list;
+    }
+
+    void CommandListPool::Record(ThreadPool* threadPool, uint32 count, uint32 grainSize, const RecordFunc& record)
+    {
+        auto recordChunk = [&](uint32 begin, uint32 end)
+        {
+            record(Acquire(begin), begin, end);
+        };
+
+        if (threadPool == nullptr)
+        {
+            grainSize = std::max(grainSize, 1u);
+            for (uint32 begin = 0; begin < count; begin += grainSize)
+            {
+                recordChunk(begin, std::min(begin + grainSize, count));
+            }
+            return;
+        }
+        threadPool->ParallelFor(count, grainSize, recordChunk);
+    }
+
+    uint32 CommandListPool::Submit(RHIQueue& queue)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::sort(m_recording.begin(), m_recording.end(),
+            [](const Recording& a, const Recording& b) { return a.order < b.order; });
+
+        m_batch.clear();
+        for (Recording& recording : m_recording)
+        {
+            recording.list->End();
+            m_batch.push_back(recording.list.get());
+        }
+        if (!m_batch.empty())
+        {
+            queue.Submit(m_batch.data(), static_cast<uint32>(m_batch.size()));
+        }
+
+        for (Recording& recording : m_recording)
+        {
+            m_freeLists.push_back(std::move(recording.list));
+            m_pendingAllocators.push_back({ m_fenceValue, std::move(recording.allocator) });
+        }
+        const uint32 listCount = static_cast<uint32>(m_recording.size());
+        m_recording.clear();
+        return listCount;
+    }
+
+    CommandListPoolStats CommandListPool::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+}
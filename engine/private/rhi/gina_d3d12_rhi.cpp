@@ -0,0 +1,537 @@
+#include "rhi/gina_d3d12_rhi.h"
+
+#include <d3dx12.h>
+
+#include "core/gina_assert.h"
+#include "core/gina_logger.h"
+
+namespace gina
+{
+    namespace
+    {
+        constexpr RHIResourceState STATE_FLAGS[] = {
+            RHIResourceState::VertexBuffer, RHIResourceState::IndexBuffer, RHIResourceState::ConstantBuffer,
+            RHIResourceState::ShaderResource, RHIResourceState::IndirectArgument, RHIResourceState::CopySource,
+            RHIResourceState::DepthRead, RHIResourceState::RenderTarget, RHIResourceState::UnorderedAccess,
+            RHIResourceState::DepthWrite, RHIResourceState::CopyDest, RHIResourceState::Present };
+
+        D3D12_RESOURCE_STATES ToD3D12State(RHIResourceState flag) noexcept
+        {
+            switch (flag)
+            {
+            case RHIResourceState::VertexBuffer:
+            case RHIResourceState::ConstantBuffer:
+                return D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER;
+            case RHIResourceState::IndexBuffer:
+                return D3D12_RESOURCE_STATE_INDEX_BUFFER;
+            case RHIResourceState::ShaderResource:
+                return D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+            case RHIResourceState::IndirectArgument:
+                return D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT;
+            case RHIResourceState::CopySource:
+                return D3D12_RESOURCE_STATE_COPY_SOURCE;
+            case RHIResourceState::DepthRead:
+                return D3D12_RESOURCE_STATE_DEPTH_READ;
+            case RHIResourceState::RenderTarget:
+                return D3D12_RESOURCE_STATE_RENDER_TARGET;
+            case RHIResourceState::UnorderedAccess:
+                return D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+            case RHIResourceState::DepthWrite:
+                return D3D12_RESOURCE_STATE_DEPTH_WRITE;
+            case RHIResourceState::CopyDest:
+                return D3D12_RESOURCE_STATE_COPY_DEST;
+            case RHIResourceState::Present:
+                return D3D12_RESOURCE_STATE_PRESENT;
+            default:
+                return D3D12_RESOURCE_STATE_COMMON;
+            }
+        }
+
+        D3D12_HEAP_TYPE ToHeapType(RHIMemoryType memory) noexcept
+        {
+            switch (memory)
+            {
+            case RHIMemoryType::Upload:
+                return D3D12_HEAP_TYPE_UPLOAD;
+            case RHIMemoryType::Readback:
+                return D3D12_HEAP_TYPE_READBACK;
+            default:
+                return D3D12_HEAP_TYPE_DEFAULT;
+            }
+        }
+
+        CD3DX12_RESOURCE_DESC ToD3D12BufferDesc(const RHIBufferDesc& desc) noexcept
+        {
+            return CD3DX12_RESOURCE_DESC::Buffer(desc.size, desc.unorderedAccess ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS : D3D12_RESOURCE_FLAG_NONE);
+        }
+
+        // Upload heaps must start readable and readback heaps writable by copies
+        D3D12_RESOURCE_STATES GetInitialBufferState(RHIMemoryType memory) noexcept
+        {
+            switch (memory)
+            {
+            case RHIMemoryType::Upload:
+                return D3D12_RESOURCE_STATE_GENERIC_READ;
+            case RHIMemoryType::Readback:
+                return D3D12_RESOURCE_STATE_COPY_DEST;
+            default:
+                return D3D12_RESOURCE_STATE_COMMON;
+            }
+        }
+
+        CD3DX12_RESOURCE_DESC ToD3D12TextureDesc(const RHITextureDesc& desc) noexcept
+        {
+            D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE;
+            if (HasUsage(desc.usage, RHITextureUsage::RenderTarget))
+            {
+                flags |= D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+            }
+            if (HasUsage(desc.usage, RHITextureUsage::DepthStencil))
+            {
+                flags |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+            }
+            if (HasUsage(desc.usage, RHITextureUsage::UnorderedAccess))
+            {
+                flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+            }
+            return CD3DX12_RESOURCE_DESC::Tex2D(ToDXGIFormat(desc.format), desc.width, desc.height,
+                static_cast<UINT16>(desc.arraySize), static_cast<UINT16>(desc.mipLevels), 1, 0, flags);
+        }
+    }
+
+    DXGI_FORMAT ToDXGIFormat(RHIFormat format) noexcept
+    {
+        switch (format)
+        {
+        case RHIFormat::R8Unorm: return DXGI_FORMAT_R8_UNORM;
+        case RHIFormat::R8G8Unorm: return DXGI_FORMAT_R8G8_UNORM;
+        case RHIFormat::R8G8B8A8Unorm: return DXGI_FORMAT_R8G8B8A8_UNORM;
+        case RHIFormat::R8G8B8A8Srgb: return DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+        case RHIFormat::R16G16B16A16Float: return DXGI_FORMAT_R16G16B16A16_FLOAT;
+        case RHIFormat::R32Float: return DXGI_FORMAT_R32_FLOAT;
+        case RHIFormat::R32G32B32A32Float: return DXGI_FORMAT_R32G32B32A32_FLOAT;
+        case RHIFormat::R32Uint: return DXGI_FORMAT_R32_UINT;
+        case RHIFormat::D32Float: return DXGI_FORMAT_D32_FLOAT;
+        case RHIFormat::D24S8: return DXGI_FORMAT_D24_UNORM_S8_UINT;
+        case RHIFormat::BC1Unorm: return DXGI_FORMAT_BC1_UNORM;
+        case RHIFormat::BC1Srgb: return DXGI_FORMAT_BC1_UNORM_SRGB;
+        case RHIFormat::BC4Unorm: return DXGI_FORMAT_BC4_UNORM;
+        case RHIFormat::BC5Unorm: return DXGI_FORMAT_BC5_UNORM;
+        case RHIFormat::BC7Unorm: return DXGI_FORMAT_BC7_UNORM;
+        case RHIFormat::BC7Srgb: return DXGI_FORMAT_BC7_UNORM_SRGB;
+        default: return DXGI_FORMAT_UNKNOWN;
+        }
+    }
+
+    D3D12_RESOURCE_STATES ToD3D12States(RHIResourceState state) noexcept
+    {
+        D3D12_RESOURCE_STATES states = D3D12_RESOURCE_STATE_COMMON;
+        for (RHIResourceState flag : STATE_FLAGS)
+        {
+            if ((static_cast<uint32>(state) & static_cast<uint32>(flag)) != 0)
+            {
+                states |= ToD3D12State(flag);
+            }
+        }
+        return states;
+    }
+
+    D3D12_COMMAND_LIST_TYPE ToD3D12ListType(RHIQueueType type) noexcept
+    {
+        switch (type)
+        {
+        case RHIQueueType::Compute:
+            return D3D12_COMMAND_LIST_TYPE_COMPUTE;
+        case RHIQueueType::Copy:
+            return D3D12_COMMAND_LIST_TYPE_COPY;
+        default:
+            return D3D12_COMMAND_LIST_TYPE_DIRECT;
+        }
+    }
+
+    D3D12RHIFence::D3D12RHIFence(ID3D12Device* device)
+    {
+        m_fence.Initialize(device);
+    }
+
+    D3D12RHICommandAllocator::D3D12RHICommandAllocator(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type)
+    {
+        HRESULT hr = device->CreateCommandAllocator(type, IID_PPV_ARGS(&m_allocator));
+        GINA_ASSERT_HRESULT(hr, "Failed to create command allocator");
+    }
+
+    void D3D12RHICommandAllocator::Reset()
+    {
+        HRESULT hr = m_allocator->Reset();
+        GINA_ASSERT_HRESULT(hr, "Failed to reset command allocator");
+    }
+
+    D3D12RHICommandList::D3D12RHICommandList(D3D12RHIDevice& device, D3D12_COMMAND_LIST_TYPE type)
+        : m_device(&device), m_type(type)
+    {
+    }
+
+    void D3D12RHICommandList::Begin(RHICommandAllocator& allocator)
+    {
+        ID3D12CommandAllocator* d3d12Allocator = static_cast<D3D12RHICommandAllocator&>(allocator).GetAllocator();
+
+        // Lists are created on first use, as creation needs an allocator and leaves the list recording
+        if (m_commandList == nullptr)
+        {
+            HRESULT hr = m_device->GetDevice()->CreateCommandList(0, m_type, d3d12Allocator, nullptr, IID_PPV_ARGS(&m_commandList));
+            GINA_ASSERT_HRESULT(hr, "Failed to create command list");
+            return;
+        }
+
+        HRESULT hr = m_commandList->Reset(d3d12Allocator, nullptr);
+        GINA_ASSERT_HRESULT(hr, "Failed to reset command list");
+    }
+
+    void D3D12RHICommandList::End()
+    {
+        HRESULT hr = m_commandList->Close();
+        GINA_ASSERT_HRESULT(hr, "Failed to close command list");
+    }
+
+    void D3D12RHICommandList::Barrier(const RHIBarrier* barriers, uint32 count)
+    {
+        m_barriers.clear();
+        for (uint32 i = 0; i < count; ++i)
+        {
+            const RHIBarrier& barrier = barriers[i];
+            ID3D12Resource* resource = m_device->GetResource(barrier.resource);
+
+            D3D12_RESOURCE_BARRIER& d3d12Barrier = m_barriers.emplace_back();
+            if (barrier.flags == RHIBarrierFlags::Aliasing)
+            {
+                d3d12Barrier = CD3DX12_RESOURCE_BARRIER::Aliasing(nullptr, resource);
+                continue;
+            }
+            if (barrier.before == RHIResourceState::UnorderedAccess && barrier.after == RHIResourceState::UnorderedAccess)
+            {
+                d3d12Barrier = CD3DX12_RESOURCE_BARRIER::UAV(resource);
+                continue;
+            }
+
+            D3D12_RESOURCE_BARRIER_FLAGS flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+            if (barrier.flags == RHIBarrierFlags::BeginOnly)
+            {
+                flags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
+            }
+            else if (barrier.flags == RHIBarrierFlags::EndOnly)
+            {
+                flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+            }
+            const uint32 subresource = barrier.subresource == ALL_RHI_SUBRESOURCES ? D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES : barrier.subresource;
+            d3d12Barrier = CD3DX12_RESOURCE_BARRIER::Transition(resource, ToD3D12States(barrier.before), ToD3D12States(barrier.after),
+                subresource, flags);
+        }
+
+        if (!m_barriers.empty())
+        {
+            m_commandList->ResourceBarrier(static_cast<UINT>(m_barriers.size()), m_barriers.data());
+        }
+    }
+
+    void D3D12RHICommandList::CopyBuffer(RHIBufferHandle destination, uint64 destinationOffset, RHIBufferHandle source, uint64 sourceOffset,
+        uint64 size)
+    {
+        m_commandList->CopyBufferRegion(m_device->GetResource(destination), destinationOffset, m_device->GetResource(source), sourceOffset, size);
+    }
+
+    void D3D12RHICommandList::CopyBufferToTexture(RHITextureHandle destination, uint32 subresource, RHIBufferHandle source, uint64 sourceOffset)
+    {
+        ID3D12Resource* texture = m_device->GetResource(destination);
+        const D3D12_RESOURCE_DESC desc = texture->GetDesc();
+
+        D3D12_TEXTURE_COPY_LOCATION sourceLocation = {};
+        sourceLocation.pResource = m_device->GetResource(source);
+        sourceLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+        m_device->GetDevice()->GetCopyableFootprints(&desc, subresource, 1, sourceOffset, &sourceLocation.PlacedFootprint, nullptr, nullptr, nullptr);
+
+        const CD3DX12_TEXTURE_COPY_LOCATION destinationLocation(texture, subresource);
+        m_commandList->CopyTextureRegion(&destinationLocation, 0, 0, 0, &sourceLocation, nullptr);
+    }
+
+    void D3D12RHICommandList::CopyTexture(RHITextureHandle destination, uint32 destinationSubresource, RHITextureHandle source, uint32 sourceSubresource)
+    {
+        const CD3DX12_TEXTURE_COPY_LOCATION destinationLocation(m_device->GetResource(destination), destinationSubresource);
+        const CD3DX12_TEXTURE_COPY_LOCATION sourceLocation(m_device->GetResource(source), sourceSubresource);
+        m_commandList->CopyTextureRegion(&destinationLocation, 0, 0, 0, &sourceLocation, nullptr);
+    }
+
+    void D3D12RHICommandList::SetIndexBuffer(RHIBufferHandle buffer, uint64 offset, uint32 size, bool wideIndices)
+    {
+        D3D12_INDEX_BUFFER_VIEW view = {};
+        view.BufferLocation = m_device->GetResource(buffer)->GetGPUVirtualAddress() + offset;
+        view.SizeInBytes = size;
+        view.Format = wideIndices ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT;
+        m_commandList->IASetIndexBuffer(&view);
+    }
+
+    void D3D12RHICommandList::SetConstants(uint32 slot, const uint32* values, uint32 count)
+    {
+        if (m_type == D3D12_COMMAND_LIST_TYPE_COMPUTE)
+        {
+            m_commandList->SetComputeRoot32BitConstants(slot, count, values, 0);
+        }
+        else
+        {
+            m_commandList->SetGraphicsRoot32BitConstants(slot, count, values, 0);
+        }
+    }
+
+    void D3D12RHICommandList::Draw(uint32 vertexCount, uint32 instanceCount, uint32 firstVertex, uint32 firstInstance)
+    {
+        m_commandList->DrawInstanced(vertexCount, instanceCount, firstVertex, firstInstance);
+    }
+
+    void D3D12RHICommandList::DrawIndexed(uint32 indexCount, uint32 instanceCount, uint32 firstIndex, int32 baseVertex, uint32 firstInstance)
+    {
+        m_commandList->DrawIndexedInstanced(indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+    }
+
+    void D3D12RHICommandList::Dispatch(uint32 groupCountX, uint32 groupCountY, uint32 groupCountZ)
+    {
+        m_commandList->Dispatch(groupCountX, groupCountY, groupCountZ);
+    }
+
+    void D3D12RHIQueue::Submit(RHICommandList* const* lists, uint32 count)
+    {
+        m_lists.clear();
+        for (uint32 i = 0; i < count; ++i)
+        {
+            m_lists.push_back(static_cast<D3D12RHICommandList*>(lists[i])->GetCommandList());
+        }
+        m_queue->ExecuteCommandLists(count, m_lists.data());
+    }
+
+    uint64 D3D12RHIQueue::Signal(RHIFence& fence)
+    {
+        return static_cast<D3D12RHIFence&>(fence).GetFence().Signal(m_queue.Get());
+    }
+
+    void D3D12RHIQueue::Wait(RHIFence& fence, uint64 value)
+    {
+        static_cast<D3D12RHIFence&>(fence).GetFence().WaitOnGPU(m_queue.Get(), value);
+    }
+
+    void D3D12DescriptorHeap::Initialize(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32 count, bool shaderVisible)
+    {
+        D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+        heapDesc.Type = type;
+        heapDesc.NumDescriptors = count;
+        heapDesc.Flags = shaderVisible ? D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE : D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+
+        HRESULT hr = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&m_heap));
+        GINA_ASSERT_HRESULT(hr, "Failed to create descriptor heap");
+
+        m_cpuStart = m_heap->GetCPUDescriptorHandleForHeapStart();
+        if (shaderVisible)
+        {
+            m_gpuStart = m_heap->GetGPUDescriptorHandleForHeapStart();
+        }
+        m_descriptorSize = device->GetDescriptorHandleIncrementSize(type);
+        m_count = count;
+    }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE D3D12DescriptorHeap::GetCPUHandle(uint32 index) const noexcept
+    {
+        return { m_cpuStart.ptr + static_cast<SIZE_T>(index) * m_descriptorSize };
+    }
+
+    D3D12_GPU_DESCRIPTOR_HANDLE D3D12DescriptorHeap::GetGPUHandle(uint32 index) const noexcept
+    {
+        return { m_gpuStart.ptr + static_cast<UINT64>(index) * m_descriptorSize };
+    }
+
+    D3D12RHIDevice::D3D12RHIDevice(Device& device)
+        : m_device(device.GetDevice().Get())
+    {
+        m_queues[static_cast<uint32>(RHIQueueType::Graphics)] = std::make_unique<D3D12RHIQueue>(device.GetCommandSystem().GetCommandQueue());
+
+        for (RHIQueueType type : { RHIQueueType::Compute, RHIQueueType::Copy })
+        {
+            D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+            queueDesc.Type = ToD3D12ListType(type);
+            queueDesc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+
+            ComPtr<ID3D12CommandQueue> queue;
+            HRESULT hr = m_device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&queue));
+            GINA_ASSERT_HRESULT(hr, "Failed to create command queue");
+            m_queues[static_cast<uint32>(type)] = std::make_unique<D3D12RHIQueue>(queue);
+        }
+
+        LOG_INFO("D3D12 RHI device initialized");
+    }
+
+    D3D12RHIDevice::~D3D12RHIDevice()
+    {
+        for (Resource& resource : m_resources)
+        {
+            if (resource.mapped != nullptr)
+            {
+                resource.resource->Unmap(0, nullptr);
+            }
+        }
+    }
+
+    RHIResourceHandle D3D12RHIDevice::AddResource(ComPtr<ID3D12Resource> resource, void* mapped)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return AddResourceLocked({ resource, mapped });
+    }
+
+    RHIResourceHandle D3D12RHIDevice::AddResourceLocked(Resource&& resource)
+    {
+        if (!m_freeResources.empty())
+        {
+            const uint32 id = m_freeResources.back();
+            m_freeResources.pop_back();
+            m_resources[id] = std::move(resource);
+            return { id };
+        }
+        m_resources.push_back(std::move(resource));
+        return { static_cast<uint32>(m_resources.size() - 1) };
+    }
+
+    ID3D12Heap* D3D12RHIDevice::GetHeap(RHIHeapHandle heap) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        GINA_ASSERT_MSG(m_resources[heap.id].heap != nullptr, "Placing into an invalid heap");
+        return m_resources[heap.id].heap.Get();
+    }
+
+    RHIMemoryType D3D12RHIDevice::GetHeapMemory(RHIHeapHandle heap) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_resources[heap.id].memory;
+    }
+
+    RHIBufferHandle D3D12RHIDevice::CreateBuffer(const RHIBufferDesc& desc)
+    {
+        const CD3DX12_HEAP_PROPERTIES heapProperties(ToHeapType(desc.memory));
+        const CD3DX12_RESOURCE_DESC resourceDesc = ToD3D12BufferDesc(desc);
+
+        ComPtr<ID3D12Resource> resource;
+        HRESULT hr = m_device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, GetInitialBufferState(desc.memory),
+            nullptr, IID_PPV_ARGS(&resource));
+        GINA_ASSERT_HRESULT(hr, "Failed to create buffer");
+
+        void* mapped = nullptr;
+        if (desc.memory != RHIMemoryType::Default)
+        {
+            hr = resource->Map(0, nullptr, &mapped);
+            GINA_ASSERT_HRESULT(hr, "Failed to map buffer");
+        }
+        return AddResource(resource, mapped);
+    }
+
+    RHITextureHandle D3D12RHIDevice::CreateTexture(const RHITextureDesc& desc)
+    {
+        const CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
+        const CD3DX12_RESOURCE_DESC resourceDesc = ToD3D12TextureDesc(desc);
+
+        ComPtr<ID3D12Resource> resource;
+        HRESULT hr = m_device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_COMMON,
+            nullptr, IID_PPV_ARGS(&resource));
+        GINA_ASSERT_HRESULT(hr, "Failed to create texture");
+        return AddResource(resource, nullptr);
+    }
+
+    RHIHeapHandle D3D12RHIDevice::CreateHeap(const RHIHeapDesc& desc)
+    {
+        // Buffers, render targets and other textures in one heap need resource heap tier 2
+        const CD3DX12_HEAP_DESC heapDesc(desc.size, ToHeapType(desc.memory), RHI_HEAP_PLACEMENT_ALIGNMENT,
+            D3D12_HEAP_FLAG_ALLOW_ALL_BUFFERS_AND_TEXTURES);
+
+        ComPtr<ID3D12Heap> heap;
+        HRESULT hr = m_device->CreateHeap(&heapDesc, IID_PPV_ARGS(&heap));
+        GINA_ASSERT_HRESULT(hr, "Failed to create heap");
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return AddResourceLocked({ nullptr, nullptr, heap, desc.memory });
+    }
+
+    RHIBufferHandle D3D12RHIDevice::CreatePlacedBuffer(RHIHeapHandle heap, uint64 offset, const RHIBufferDesc& desc)
+    {
+        const CD3DX12_RESOURCE_DESC resourceDesc = ToD3D12BufferDesc(desc);
+        ID3D12Heap* d3d12Heap = GetHeap(heap);
+        const RHIMemoryType memory = GetHeapMemory(heap);
+
+        ComPtr<ID3D12Resource> resource;
+        HRESULT hr = m_device->CreatePlacedResource(d3d12Heap, offset, &resourceDesc, GetInitialBufferState(memory), nullptr,
+            IID_PPV_ARGS(&resource));
+        GINA_ASSERT_HRESULT(hr, "Failed to create placed buffer");
+
+        void* mapped = nullptr;
+        if (memory != RHIMemoryType::Default)
+        {
+            hr = resource->Map(0, nullptr, &mapped);
+            GINA_ASSERT_HRESULT(hr, "Failed to map buffer");
+        }
+        return AddResource(resource, mapped);
+    }
+
+    RHITextureHandle D3D12RHIDevice::CreatePlacedTexture(RHIHeapHandle heap, uint64 offset, const RHITextureDesc& desc)
+    {
+        const CD3DX12_RESOURCE_DESC resourceDesc = ToD3D12TextureDesc(desc);
+
+        ComPtr<ID3D12Resource> resource;
+        HRESULT hr = m_device->CreatePlacedResource(GetHeap(heap), offset, &resourceDesc, D3D12_RESOURCE_STATE_COMMON, nullptr,
+            IID_PPV_ARGS(&resource));
+        GINA_ASSERT_HRESULT(hr, "Failed to create placed texture");
+        return AddResource(resource, nullptr);
+    }
+
+    uint64 D3D12RHIDevice::GetPlacedTextureSize(const RHITextureDesc& desc) const
+    {
+        const CD3DX12_RESOURCE_DESC resourceDesc = ToD3D12TextureDesc(desc);
+        return m_device->GetResourceAllocationInfo(0, 1, &resourceDesc).SizeInBytes;
+    }
+
+    void D3D12RHIDevice::DestroyResource(RHIResourceHandle resource)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Resource& destroyed = m_resources[resource.id];
+        if (destroyed.mapped != nullptr)
+        {
+            destroyed.resource->Unmap(0, nullptr);
+        }
+        destroyed = Resource();
+        m_freeResources.push_back(resource.id);
+    }
+
+    void* D3D12RHIDevice::Map(RHIBufferHandle buffer)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        GINA_ASSERT_MSG(m_resources[buffer.id].mapped != nullptr, "Only upload and readback buffers can be mapped");
+        return m_resources[buffer.id].mapped;
+    }
+
+    ID3D12Resource* D3D12RHIDevice::GetResource(RHIResourceHandle resource) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_resources[resource.id].resource.Get();
+    }
+
+    std::unique_ptr<RHIFence> D3D12RHIDevice::CreateFence()
+    {
+        return std::make_unique<D3D12RHIFence>(m_device);
+    }
+
+    std::unique_ptr<RHICommandAllocator> D3D12RHIDevice::CreateCommandAllocator(RHIQueueType type)
+    {
+        return std::make_unique<D3D12RHICommandAllocator>(m_device, ToD3D12ListType(type));
+    }
+
+    std::unique_ptr<RHICommandList> D3D12RHIDevice::CreateCommandList(RHIQueueType type)
+    {
+        return std::make_unique<D3D12RHICommandList>(*this, ToD3D12ListType(type));
+    }
+
+    RHIQueue& D3D12RHIDevice::GetQueue(RHIQueueType type)
+    {
+        return *m_queues[static_cast<uint32>(type)];
+    }
+}
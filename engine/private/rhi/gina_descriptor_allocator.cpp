@@ -0,0 +1,176 @@
+#include "rhi/gina_descriptor_allocator.h"
+
+#include <algorithm>
+
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    PersistentDescriptorAllocator::PersistentDescriptorAllocator(uint32 base, uint32 capacity)
+        : m_base(base), m_capacity(capacity)
+    {
+        if (capacity > 0)
+        {
+            AddFreeBlock(0, capacity);
+        }
+    }
+
+    void PersistentDescriptorAllocator::AddFreeBlock(uint32 offset, uint32 count)
+    {
+        m_freeByOffset.emplace(offset, count);
+        m_freeBySize.emplace(count, offset);
+    }
+
+    void PersistentDescriptorAllocator::RemoveFreeBlock(std::map<uint32, uint32>::iterator block)
+    {
+        m_freeBySize.erase({ block->second, block->first });
+        m_freeByOffset.erase(block);
+    }
+
+    DescriptorRange PersistentDescriptorAllocator::Allocate(uint32 count)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        count = std::max(count, 1u);
+        auto fit = m_freeBySize.lower_bound({ count, 0 });
+        if (fit == m_freeBySize.end())
+        {
+            ++m_failures;
+            return {};
+        }
+
+        const uint32 blockCount = fit->first;
+        const uint32 offset = fit->second;
+        m_freeBySize.erase(fit);
+        m_freeByOffset.erase(offset);
+        if (blockCount > count)
+        {
+            AddFreeBlock(offset + count, blockCount - count);
+        }
+
+        m_usedCount += count;
+        m_peakUsedCount = std::max(m_peakUsedCount, m_usedCount);
+        return { m_base + offset, count };
+    }
+
+    void PersistentDescriptorAllocator::Free(const DescriptorRange& range, uint64 fenceValue)
+    {
+        if (!range.IsValid())
+        {
+            return;
+        }
+        GINA_ASSERT_MSG(range.index >= m_base && range.index + range.count <= m_base + m_capacity, "Range is not from this allocator");
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        GINA_ASSERT_MSG(m_pendingFrees.empty() || m_pendingFrees.back().fenceValue <= fenceValue, "Frees must come in fence order");
+        m_pendingFrees.push_back({ fenceValue, range });
+    }
+
+    void PersistentDescriptorAllocator::Reclaim(uint64 completedValue)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        while (!m_pendingFrees.empty() && m_pendingFrees.front().fenceValue <= completedValue)
+        {
+            uint32 offset = m_pendingFrees.front().range.index - m_base;
+            uint32 count = m_pendingFrees.front().range.count;
+            m_pendingFrees.pop_front();
+            m_usedCount -= count;
+
+            // Merge with the free blocks right after and right before
+            auto next = m_freeByOffset.lower_bound(offset);
+            if (next != m_freeByOffset.end() && next->first == offset + count)
+            {
+                count += next->second;
+                RemoveFreeBlock(next);
+            }
+            auto previous = m_freeByOffset.lower_bound(offset);
+            if (previous != m_freeByOffset.begin())
+            {
+                --previous;
+                if (previous->first + previous->second == offset)
+                {
+                    offset = previous->first;
+                    count += previous->second;
+                    RemoveFreeBlock(previous);
+                }
+            }
+            AddFreeBlock(offset, count);
+        }
+    }
+
+    PersistentDescriptorStats PersistentDescriptorAllocator::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        PersistentDescriptorStats stats;
+        stats.usedCount = m_usedCount;
+        stats.peakUsedCount = m_peakUsedCount;
+        stats.freeBlockCount = static_cast<uint32>(m_freeByOffset.size());
+        stats.largestFreeBlock = m_freeBySize.empty() ? 0 : m_freeBySize.rbegin()->first;
+        for (const PendingFree& pending : m_pendingFrees)
+        {
+            stats.pendingFreeCount += pending.range.count;
+        }
+        stats.failures = m_failures;
+        return stats;
+    }
+
+    TransientDescriptorAllocator::TransientDescriptorAllocator(uint32 base, uint32 pageCount, uint32 pageSize)
+        : m_base(base), m_pageCount(pageCount), m_pageSize(pageSize)
+    {
+        // Highest first, so pages are handed out from the start of the range
+        for (uint32 page = pageCount; page > 0; --page)
+        {
+            m_freePages.push_back(page - 1);
+        }
+    }
+
+    void TransientDescriptorAllocator::BeginFrame(uint64 fenceValue, uint64 completedValue)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_framePages.empty())
+        {
+            m_retired.push_back({ m_fenceValue, std::move(m_framePages) });
+            m_framePages.clear();
+        }
+        while (!m_retired.empty() && m_retired.front().fenceValue <= completedValue)
+        {
+            const std::vector<uint32>& pages = m_retired.front().pages;
+            m_freePages.insert(m_freePages.end(), pages.rbegin(), pages.rend());
+            m_retired.pop_front();
+        }
+        m_fenceValue = fenceValue;
+    }
+
+    DescriptorRange TransientDescriptorAllocator::Allocate(DescriptorPageCursor& cursor, uint32 count)
+    {
+        // A cursor left over from an earlier frame points at a page that may belong to someone else by now
+        if (cursor.fenceValue != m_fenceValue || cursor.page == INVALID_DESCRIPTOR_INDEX || cursor.used + count > m_pageSize)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (count > m_pageSize || m_freePages.empty())
+            {
+                ++m_failures;
+                return {};
+            }
+            cursor.page = m_freePages.back();
+            cursor.used = 0;
+            cursor.fenceValue = m_fenceValue;
+            m_freePages.pop_back();
+            m_framePages.push_back(cursor.page);
+        }
+
+        const DescriptorRange range = { m_base + cursor.page * m_pageSize + cursor.used, count };
+        cursor.used += count;
+        return range;
+    }
+
+    TransientDescriptorStats TransientDescriptorAllocator::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        TransientDescriptorStats stats;
+        stats.pageCount = m_pageCount;
+        stats.freePageCount = static_cast<uint32>(m_freePages.size());
+        stats.framePageCount = static_cast<uint32>(m_framePages.size());
+        stats.failures = m_failures;
+        return stats;
+    }
+}
@@ -0,0 +1,114 @@
+#include "rhi/gina_frame_ring.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    FrameRing::FrameRing(RHIDevice& device, const FrameRingSettings& settings)
+        : m_device(&device), m_settings(settings), m_fence(device.CreateFence())
+    {
+        m_settings.framesInFlight = std::clamp(m_settings.framesInFlight, 1u, MAX_FRAMES_IN_FLIGHT);
+        m_frames.resize(m_settings.framesInFlight);
+        for (FrameContext& frame : m_frames)
+        {
+            frame.allocator = device.CreateCommandAllocator(m_settings.queue);
+        }
+    }
+
+    FrameRing::~FrameRing()
+    {
+        Flush();
+    }
+
+    FrameContext& FrameRing::BeginFrame()
+    {
+        GINA_ASSERT_MSG(!m_recording, "BeginFrame called twice without EndFrame");
+        FrameContext& frame = m_frames[m_frameIndex];
+        WaitForFrame(frame);
+        Recycle(frame);
+        frame.frameNumber = m_frameNumber;
+        m_recording = true;
+        return frame;
+    }
+
+    void FrameRing::EndFrame()
+    {
+        GINA_ASSERT_MSG(m_recording, "EndFrame called without BeginFrame");
+        FrameContext& frame = m_frames[m_frameIndex];
+        frame.fenceValue = m_device->GetQueue(m_settings.queue).Signal(*m_fence);
+
+        m_recording = false;
+        m_frameIndex = (m_frameIndex + 1) % m_settings.framesInFlight;
+        ++m_frameNumber;
+        ++m_stats.frames;
+    }
+
+    void FrameRing::Flush()
+    {
+        const uint64 lastValue = m_fence->GetLastSignaledValue();
+        if (lastValue != 0)
+        {
+            m_fence->WaitOnCPU(lastValue);
+        }
+        for (FrameContext& frame : m_frames)
+        {
+            // The frame being recorded keeps its releases, they may still be used by commands not submitted yet
+            if (!m_recording || &frame != &m_frames[m_frameIndex])
+            {
+                Recycle(frame);
+            }
+        }
+    }
+
+    void FrameRing::DeferRelease(RHIResourceHandle resource)
+    {
+        if (m_recording)
+        {
+            m_frames[m_frameIndex].releases.push_back(resource);
+            return;
+        }
+
+        // Between frames the last possible use is in the frame that just ended
+        if (m_frameNumber == 0)
+        {
+            m_device->DestroyResource(resource);
+            return;
+        }
+        const uint32 previous = (m_frameIndex + m_settings.framesInFlight - 1) % m_settings.framesInFlight;
+        m_frames[previous].releases.push_back(resource);
+    }
+
+    void FrameRing::WaitForFrame(FrameContext& frame)
+    {
+        if (frame.fenceValue == 0 || m_fence->GetCompletedValue() >= frame.fenceValue)
+        {
+            return;
+        }
+
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point start = Clock::now();
+        m_fence->WaitOnCPU(frame.fenceValue);
+        const double waitTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        ++m_stats.cpuWaits;
+        m_stats.cpuWaitTime += waitTime;
+        m_stats.maxCpuWaitTime = std::max(m_stats.maxCpuWaitTime, waitTime);
+    }
+
+    void FrameRing::Recycle(FrameContext& frame)
+    {
+        if (frame.fenceValue != 0)
+        {
+            frame.allocator->Reset();
+        }
+        for (RHIResourceHandle resource : frame.releases)
+        {
+            m_device->DestroyResource(resource);
+        }
+        frame.releases.clear();
+        frame.fenceValue = 0;
+    }
+}
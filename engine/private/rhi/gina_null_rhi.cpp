@@ -0,0 +1,490 @@
+#include "rhi/gina_null_rhi.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <thread>
+
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    namespace
+    {
+        double GetSteadyMilliseconds()
+        {
+            using namespace std::chrono;
+            return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+        }
+    }
+
+    void NullCommandStream::Clear() noexcept
+    {
+        commands.clear();
+        barriers.clear();
+        constants.clear();
+    }
+
+    void NullCommandStream::Append(const NullCommandStream& other, uint32 submission)
+    {
+        const uint32 barrierBase = static_cast<uint32>(barriers.size());
+        const uint32 constantBase = static_cast<uint32>(constants.size());
+        for (NullCommand command : other.commands)
+        {
+            command.submission = submission;
+            if (command.type == NullCommandType::Barrier)
+            {
+                command.args[0] += barrierBase;
+            }
+            else if (command.type == NullCommandType::SetConstants)
+            {
+                command.args[0] += constantBase;
+            }
+            commands.push_back(command);
+        }
+        barriers.insert(barriers.end(), other.barriers.begin(), other.barriers.end());
+        constants.insert(constants.end(), other.constants.begin(), other.constants.end());
+    }
+
+    uint32 NullCommandStream::Count(NullCommandType type) const noexcept
+    {
+        return static_cast<uint32>(std::count_if(commands.begin(), commands.end(),
+            [type](const NullCommand& command) { return command.type == type; }));
+    }
+
+    uint64 NullFence::GetCompletedValue() const
+    {
+        std::lock_guard<std::mutex> lock(m_device->m_mutex);
+        const double now = m_device->GetTimeLocked();
+        while (!m_pending.empty() && m_pending.front().time <= now)
+        {
+            m_completed = m_pending.front().value;
+            m_pending.pop_front();
+        }
+        return m_completed;
+    }
+
+    double NullFence::GetCompletionTime(uint64 value) const
+    {
+        std::lock_guard<std::mutex> lock(m_device->m_mutex);
+        if (value <= m_completed)
+        {
+            return 0.0;
+        }
+        for (const PendingValue& pending : m_pending)
+        {
+            if (pending.value >= value)
+            {
+                return pending.time;
+            }
+        }
+        return std::numeric_limits<double>::infinity();
+    }
+
+    void NullFence::WaitOnCPU(uint64 value)
+    {
+        GINA_ASSERT_MSG(value <= m_lastSignaled, "Waiting for a fence value that was never signaled");
+        if (GetCompletedValue() >= value)
+        {
+            return;
+        }
+        m_device->WaitUntil(GetCompletionTime(value));
+        GetCompletedValue();
+    }
+
+    void NullCommandAllocator::Reset()
+    {
+        std::lock_guard<std::mutex> lock(m_device->m_mutex);
+        if (m_device->GetTimeLocked() < m_busyUntil)
+        {
+            ++m_device->m_stats.unsafeAllocatorResets;
+        }
+        ++m_resetCount;
+    }
+
+    void NullCommandList::Begin(RHICommandAllocator& allocator)
+    {
+        GINA_ASSERT_MSG(!m_recording, "Command list is already recording");
+        m_allocator = static_cast<NullCommandAllocator*>(&allocator);
+        m_stream.Clear();
+        m_recording = true;
+    }
+
+    void NullCommandList::End()
+    {
+        GINA_ASSERT_MSG(m_recording, "Command list is not recording");
+        m_recording = false;
+    }
+
+    NullCommand& NullCommandList::Record(NullCommandType type)
+    {
+        GINA_ASSERT_MSG(m_recording, "Recording into a closed command list");
+        NullCommand& command = m_stream.commands.emplace_back();
+        command.type = type;
+        command.list = m_id;
+        return command;
+    }
+
+    void NullCommandList::Barrier(const RHIBarrier* barriers, uint32 count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        NullCommand& command = Record(NullCommandType::Barrier);
+        command.args[0] = static_cast<uint32>(m_stream.barriers.size());
+        command.args[1] = count;
+        m_stream.barriers.insert(m_stream.barriers.end(), barriers, barriers + count);
+    }
+
+    void NullCommandList::CopyBuffer(RHIBufferHandle destination, uint64 destinationOffset, RHIBufferHandle source, uint64 sourceOffset,
+        uint64 size)
+    {
+        NullCommand& command = Record(NullCommandType::CopyBuffer);
+        command.resources[0] = destination;
+        command.resources[1] = source;
+        command.offsets[0] = destinationOffset;
+        command.offsets[1] = sourceOffset;
+        command.offsets[2] = size;
+    }
+
+    void NullCommandList::CopyBufferToTexture(RHITextureHandle destination, uint32 subresource, RHIBufferHandle source, uint64 sourceOffset)
+    {
+        NullCommand& command = Record(NullCommandType::CopyBufferToTexture);
+        command.resources[0] = destination;
+        command.resources[1] = source;
+        command.offsets[1] = sourceOffset;
+        command.args[0] = subresource;
+    }
+
+    void NullCommandList::CopyTexture(RHITextureHandle destination, uint32 destinationSubresource, RHITextureHandle source, uint32 sourceSubresource)
+    {
+        NullCommand& command = Record(NullCommandType::CopyTexture);
+        command.resources[0] = destination;
+        command.resources[1] = source;
+        command.args[0] = destinationSubresource;
+        command.args[1] = sourceSubresource;
+    }
+
+    void NullCommandList::SetIndexBuffer(RHIBufferHandle buffer, uint64 offset, uint32 size, bool wideIndices)
+    {
+        NullCommand& command = Record(NullCommandType::SetIndexBuffer);
+        command.resources[0] = buffer;
+        command.offsets[0] = offset;
+        command.args[0] = size;
+        command.args[1] = wideIndices ? 1 : 0;
+    }
+
+    void NullCommandList::SetConstants(uint32 slot, const uint32* values, uint32 count)
+    {
+        NullCommand& command = Record(NullCommandType::SetConstants);
+        command.args[0] = static_cast<uint32>(m_stream.constants.size());
+        command.args[1] = slot;
+        command.args[2] = count;
+        m_stream.constants.insert(m_stream.constants.end(), values, values + count);
+    }
+
+    void NullCommandList::Draw(uint32 vertexCount, uint32 instanceCount, uint32 firstVertex, uint32 firstInstance)
+    {
+        NullCommand& command = Record(NullCommandType::Draw);
+        command.args[0] = vertexCount;
+        command.args[1] = instanceCount;
+        command.args[2] = firstVertex;
+        command.args[3] = firstInstance;
+    }
+
+    void NullCommandList::DrawIndexed(uint32 indexCount, uint32 instanceCount, uint32 firstIndex, int32 baseVertex, uint32 firstInstance)
+    {
+        NullCommand& command = Record(NullCommandType::DrawIndexed);
+        command.args[0] = indexCount;
+        command.args[1] = instanceCount;
+        command.args[2] = firstIndex;
+        command.args[3] = static_cast<uint32>(baseVertex);
+        command.args[4] = firstInstance;
+    }
+
+    void NullCommandList::Dispatch(uint32 groupCountX, uint32 groupCountY, uint32 groupCountZ)
+    {
+        NullCommand& command = Record(NullCommandType::Dispatch);
+        command.args[0] = groupCountX;
+        command.args[1] = groupCountY;
+        command.args[2] = groupCountZ;
+    }
+
+    void NullQueue::Submit(RHICommandList* const* lists, uint32 count)
+    {
+        const NullDeviceSettings& settings = m_device->GetSettings();
+        const uint32 submission = m_submissionCount++;
+
+        uint64 commandCount = 0;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            const NullCommandList& list = *static_cast<const NullCommandList*>(lists[i]);
+            GINA_ASSERT_MSG(!list.IsRecording(), "Submitting a command list that was not closed");
+            commandCount += list.GetStream().commands.size();
+            if (settings.recordCommands)
+            {
+                m_stream.Append(list.GetStream(), submission);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_device->m_mutex);
+        m_busyUntil = std::max(m_busyUntil, m_device->GetTimeLocked()) + settings.submissionTime + settings.commandTime * commandCount;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            NullCommandAllocator* allocator = static_cast<const NullCommandList*>(lists[i])->GetAllocator();
+            if (allocator != nullptr)
+            {
+                allocator->m_busyUntil = std::max(allocator->m_busyUntil, m_busyUntil);
+            }
+        }
+        ++m_device->m_stats.submissions;
+        m_device->m_stats.commands += commandCount;
+    }
+
+    uint64 NullQueue::Signal(RHIFence& fence)
+    {
+        NullFence& nullFence = static_cast<NullFence&>(fence);
+        std::lock_guard<std::mutex> lock(m_device->m_mutex);
+        const uint64 value = ++nullFence.m_lastSignaled;
+        nullFence.m_pending.push_back({ value, std::max(m_busyUntil, m_device->GetTimeLocked()) });
+        return value;
+    }
+
+    void NullQueue::Wait(RHIFence& fence, uint64 value)
+    {
+        const double time = static_cast<NullFence&>(fence).GetCompletionTime(value);
+        GINA_ASSERT_MSG(time != std::numeric_limits<double>::infinity(), "GPU waits need the value signaled first");
+
+        std::lock_guard<std::mutex> lock(m_device->m_mutex);
+        m_busyUntil = std::max(m_busyUntil, time);
+    }
+
+    NullDevice::NullDevice(const NullDeviceSettings& settings)
+        : m_settings(settings), m_startTime(GetSteadyMilliseconds())
+    {
+        for (std::unique_ptr<NullQueue>& queue : m_queues)
+        {
+            queue = std::make_unique<NullQueue>(*this);
+        }
+    }
+
+    RHIResourceHandle NullDevice::AddResource(Resource&& resource)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        resource.alive = true;
+        ++m_stats.liveResources;
+        m_stats.residentBytes += resource.size;
+
+        if (!m_freeResources.empty())
+        {
+            const uint32 id = m_freeResources.back();
+            m_freeResources.pop_back();
+            m_resources[id] = std::move(resource);
+            return { id };
+        }
+        m_resources.push_back(std::move(resource));
+        return { static_cast<uint32>(m_resources.size() - 1) };
+    }
+
+    RHIBufferHandle NullDevice::CreateBuffer(const RHIBufferDesc& desc)
+    {
+        Resource resource;
+        resource.buffer = desc;
+        resource.size = desc.size;
+        if (desc.memory != RHIMemoryType::Default)
+        {
+            resource.memory.resize(desc.size);
+        }
+        return AddResource(std::move(resource));
+    }
+
+    RHITextureHandle NullDevice::CreateTexture(const RHITextureDesc& desc)
+    {
+        Resource resource;
+        resource.texture = true;
+        resource.textureDesc = desc;
+        resource.size = GetTextureSize(desc);
+        return AddResource(std::move(resource));
+    }
+
+    RHIHeapHandle NullDevice::CreateHeap(const RHIHeapDesc& desc)
+    {
+        Resource resource;
+        resource.heap = true;
+        resource.buffer = { desc.size, desc.memory, false, desc.name };
+        resource.size = desc.size;
+        if (desc.memory != RHIMemoryType::Default)
+        {
+            resource.memory.resize(desc.size);
+        }
+        return AddResource(std::move(resource));
+    }
+
+    void NullDevice::Place(Resource& resource, RHIHeapHandle heap, uint64 offset, [[maybe_unused]] uint64 size) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        GINA_ASSERT_MSG(heap.id < m_resources.size() && m_resources[heap.id].alive && m_resources[heap.id].heap, "Placing into an invalid heap");
+        GINA_ASSERT_MSG(offset % RHI_HEAP_PLACEMENT_ALIGNMENT == 0, "Placed resources start at aligned heap offsets");
+        GINA_ASSERT_MSG(offset + size <= m_resources[heap.id].size, "Placed resource runs past the end of its heap");
+        resource.placedHeap = heap;
+        resource.heapOffset = offset;
+    }
+
+    RHIBufferHandle NullDevice::CreatePlacedBuffer(RHIHeapHandle heap, uint64 offset, const RHIBufferDesc& desc)
+    {
+        Resource resource;
+        resource.buffer = desc;
+        Place(resource, heap, offset, desc.size);
+        return AddResource(std::move(resource));
+    }
+
+    RHITextureHandle NullDevice::CreatePlacedTexture(RHIHeapHandle heap, uint64 offset, const RHITextureDesc& desc)
+    {
+        Resource resource;
+        resource.texture = true;
+        resource.textureDesc = desc;
+        Place(resource, heap, offset, GetPlacedTextureSize(desc));
+        return AddResource(std::move(resource));
+    }
+
+    uint64 NullDevice::GetPlacedTextureSize(const RHITextureDesc& desc) const
+    {
+        return GetTextureSize(desc);
+    }
+
+    void NullDevice::DestroyResource(RHIResourceHandle resource)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        GINA_ASSERT_MSG(resource.id < m_resources.size() && m_resources[resource.id].alive, "Destroying an invalid resource");
+
+        Resource& destroyed = m_resources[resource.id];
+        --m_stats.liveResources;
+        m_stats.residentBytes -= destroyed.size;
+        destroyed = Resource();
+        m_freeResources.push_back(resource.id);
+    }
+
+    void* NullDevice::Map(RHIBufferHandle buffer)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Resource& resource = m_resources[buffer.id];
+        if (resource.placedHeap.IsValid())
+        {
+            Resource& heap = m_resources[resource.placedHeap.id];
+            GINA_ASSERT_MSG(!resource.texture && !heap.memory.empty(), "Only buffers in upload and readback heaps can be mapped");
+            return heap.memory.data() + resource.heapOffset;
+        }
+        GINA_ASSERT_MSG(!resource.texture && !resource.heap && !resource.memory.empty(), "Only upload and readback buffers can be mapped");
+        return resource.memory.data();
+    }
+
+    std::unique_ptr<RHIFence> NullDevice::CreateFence()
+    {
+        return std::make_unique<NullFence>(*this);
+    }
+
+    std::unique_ptr<RHICommandAllocator> NullDevice::CreateCommandAllocator(RHIQueueType)
+    {
+        return std::make_unique<NullCommandAllocator>(*this);
+    }
+
+    std::unique_ptr<RHICommandList> NullDevice::CreateCommandList(RHIQueueType)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return std::make_unique<NullCommandList>(m_nextListId++);
+    }
+
+    RHIQueue& NullDevice::GetQueue(RHIQueueType type)
+    {
+        return GetNullQueue(type);
+    }
+
+    const RHIBufferDesc* NullDevice::GetBufferDesc(RHIBufferHandle buffer) const noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const bool valid = buffer.id < m_resources.size() && m_resources[buffer.id].alive && !m_resources[buffer.id].texture &&
+            !m_resources[buffer.id].heap;
+        return valid ? &m_resources[buffer.id].buffer : nullptr;
+    }
+
+    const RHITextureDesc* NullDevice::GetTextureDesc(RHITextureHandle texture) const noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const bool valid = texture.id < m_resources.size() && m_resources[texture.id].alive && m_resources[texture.id].texture;
+        return valid ? &m_resources[texture.id].textureDesc : nullptr;
+    }
+
+    RHIHeapHandle NullDevice::GetPlacedHeap(RHIResourceHandle resource, uint64& offset) const noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (resource.id >= m_resources.size() || !m_resources[resource.id].alive)
+        {
+            return {};
+        }
+        offset = m_resources[resource.id].heapOffset;
+        return m_resources[resource.id].placedHeap;
+    }
+
+    NullDeviceStats NullDevice::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    void NullDevice::ResetStats()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const uint64 liveResources = m_stats.liveResources;
+        const uint64 residentBytes = m_stats.residentBytes;
+        m_stats = NullDeviceStats();
+        m_stats.liveResources = liveResources;
+        m_stats.residentBytes = residentBytes;
+    }
+
+    double NullDevice::GetTime() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return GetTimeLocked();
+    }
+
+    double NullDevice::GetTimeLocked() const
+    {
+        return m_settings.realTime ? GetSteadyMilliseconds() - m_startTime : m_virtualTime;
+    }
+
+    void NullDevice::AdvanceTime(double milliseconds)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_settings.realTime)
+        {
+            m_virtualTime += milliseconds;
+        }
+    }
+
+    void NullDevice::WaitUntil(double time)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const double now = GetTimeLocked();
+        if (time <= now)
+        {
+            return;
+        }
+
+        ++m_stats.cpuWaits;
+        m_stats.cpuWaitTime += time - now;
+        if (!m_settings.realTime)
+        {
+            m_virtualTime = time;
+            return;
+        }
+
+        lock.unlock();
+        const double start = GetSteadyMilliseconds();
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(time - now));
+        while (GetSteadyMilliseconds() - start < time - now)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
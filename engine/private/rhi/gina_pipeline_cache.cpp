@@ -0,0 +1,463 @@
+#include "rhi/gina_pipeline_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+#include "core/gina_hash.h"
+#include "core/gina_logger.h"
+
+namespace gina
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        double GetElapsed(Clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        // The fields HashPipelineDesc reads, in its order: no padding, unused slots or disabled blend factors
+        void WritePipelineDesc(BinaryWriter& writer, const PipelineDesc& desc)
+        {
+            writer.Write(desc.vertexShader);
+            writer.Write(desc.pixelShader);
+            writer.Write(desc.computeShader);
+            writer.Write(desc.rootSignature);
+            if (desc.computeShader != 0)
+            {
+                return;
+            }
+
+            writer.Write(desc.topology);
+            writer.Write(desc.depthFormat);
+            writer.Write(desc.sampleCount);
+
+            const PipelineRasterState& raster = desc.raster;
+            writer.Write(raster.cullMode);
+            writer.Write(raster.wireframe);
+            writer.Write(raster.frontCounterClockwise);
+            writer.Write(raster.depthClip);
+            writer.Write(raster.depthBias);
+            writer.Write(raster.slopeScaledDepthBias);
+
+            const PipelineDepthState& depth = desc.depth;
+            writer.Write(depth.test);
+            writer.Write(depth.write);
+            writer.Write(depth.compare);
+
+            const uint32 renderTargetCount = std::min(desc.renderTargetCount, MAX_PIPELINE_RENDER_TARGETS);
+            writer.Write(renderTargetCount);
+            for (uint32 i = 0; i < renderTargetCount; ++i)
+            {
+                const PipelineBlendState& blend = desc.blend[i];
+                writer.Write(desc.renderTargetFormats[i]);
+                writer.Write(blend.writeMask);
+                writer.Write(blend.enable);
+                if (blend.enable)
+                {
+                    writer.Write(blend.source);
+                    writer.Write(blend.destination);
+                    writer.Write(blend.op);
+                    writer.Write(blend.sourceAlpha);
+                    writer.Write(blend.destinationAlpha);
+                    writer.Write(blend.alphaOp);
+                }
+            }
+        }
+
+        // Fields the file leaves out keep their defaults
+        bool ReadPipelineDesc(BinaryReader& reader, PipelineDesc& desc)
+        {
+            desc = {};
+            if (!reader.Read(desc.vertexShader) || !reader.Read(desc.pixelShader) || !reader.Read(desc.computeShader) ||
+                !reader.Read(desc.rootSignature)) return false;
+            if (desc.computeShader != 0)
+            {
+                return true;
+            }
+
+            if (!reader.Read(desc.topology) || !reader.Read(desc.depthFormat) || !reader.Read(desc.sampleCount)) return false;
+
+            PipelineRasterState& raster = desc.raster;
+            if (!reader.Read(raster.cullMode) || !reader.Read(raster.wireframe) || !reader.Read(raster.frontCounterClockwise) ||
+                !reader.Read(raster.depthClip) || !reader.Read(raster.depthBias) || !reader.Read(raster.slopeScaledDepthBias)) return false;
+
+            PipelineDepthState& depth = desc.depth;
+            if (!reader.Read(depth.test) || !reader.Read(depth.write) || !reader.Read(depth.compare)) return false;
+
+            if (!reader.Read(desc.renderTargetCount) || desc.renderTargetCount > MAX_PIPELINE_RENDER_TARGETS) return false;
+            for (uint32 i = 0; i < desc.renderTargetCount; ++i)
+            {
+                PipelineBlendState& blend = desc.blend[i];
+                if (!reader.Read(desc.renderTargetFormats[i]) || !reader.Read(blend.writeMask) || !reader.Read(blend.enable)) return false;
+                if (blend.enable && (!reader.Read(blend.source) || !reader.Read(blend.destination) || !reader.Read(blend.op) ||
+                    !reader.Read(blend.sourceAlpha) || !reader.Read(blend.destinationAlpha) || !reader.Read(blend.alphaOp))) return false;
+            }
+            return true;
+        }
+    }
+
+    uint64 HashPipelineDesc(const PipelineDesc& desc) noexcept
+    {
+        uint64 hash = HASH_SEED;
+        hash = HashValue(hash, PIPELINE_CACHE_VERSION);
+        hash = HashValue(hash, desc.vertexShader);
+        hash = HashValue(hash, desc.pixelShader);
+        hash = HashValue(hash, desc.computeShader);
+        hash = HashValue(hash, desc.rootSignature);
+
+        // Compute pipelines have no fixed function state to tell them apart
+        if (desc.computeShader != 0)
+        {
+            return hash;
+        }
+
+        hash = HashValue(hash, desc.topology);
+        hash = HashValue(hash, desc.depthFormat);
+        hash = HashValue(hash, desc.sampleCount);
+
+        const PipelineRasterState& raster = desc.raster;
+        hash = HashValue(hash, raster.cullMode);
+        hash = HashValue(hash, raster.wireframe);
+        hash = HashValue(hash, raster.frontCounterClockwise);
+        hash = HashValue(hash, raster.depthClip);
+        hash = HashValue(hash, raster.depthBias);
+        // -0 and 0 compare equal, so they must hash alike too
+        hash = HashValue(hash, raster.slopeScaledDepthBias == 0.0f ? 0.0f : raster.slopeScaledDepthBias);
+
+        const PipelineDepthState& depth = desc.depth;
+        hash = HashValue(hash, depth.test);
+        hash = HashValue(hash, depth.write);
+        hash = HashValue(hash, depth.compare);
+
+        const uint32 renderTargetCount = std::min(desc.renderTargetCount, MAX_PIPELINE_RENDER_TARGETS);
+        hash = HashValue(hash, renderTargetCount);
+        for (uint32 i = 0; i < renderTargetCount; ++i)
+        {
+            const PipelineBlendState& blend = desc.blend[i];
+            hash = HashValue(hash, desc.renderTargetFormats[i]);
+            hash = HashValue(hash, blend.writeMask);
+            hash = HashValue(hash, blend.enable);
+            if (blend.enable)
+            {
+                hash = HashValue(hash, blend.source);
+                hash = HashValue(hash, blend.destination);
+                hash = HashValue(hash, blend.op);
+                hash = HashValue(hash, blend.sourceAlpha);
+                hash = HashValue(hash, blend.destinationAlpha);
+                hash = HashValue(hash, blend.alphaOp);
+            }
+        }
+        return hash;
+    }
+
+    bool IsSamePipelineDesc(const PipelineDesc& a, const PipelineDesc& b) noexcept
+    {
+        if (a.vertexShader != b.vertexShader || a.pixelShader != b.pixelShader || a.computeShader != b.computeShader ||
+            a.rootSignature != b.rootSignature)
+        {
+            return false;
+        }
+        if (a.computeShader != 0)
+        {
+            return true;
+        }
+
+        if (a.topology != b.topology || a.depthFormat != b.depthFormat || a.sampleCount != b.sampleCount)
+        {
+            return false;
+        }
+
+        const PipelineRasterState& rasterA = a.raster;
+        const PipelineRasterState& rasterB = b.raster;
+        if (rasterA.cullMode != rasterB.cullMode || rasterA.wireframe != rasterB.wireframe ||
+            rasterA.frontCounterClockwise != rasterB.frontCounterClockwise || rasterA.depthClip != rasterB.depthClip ||
+            rasterA.depthBias != rasterB.depthBias || rasterA.slopeScaledDepthBias != rasterB.slopeScaledDepthBias)
+        {
+            return false;
+        }
+
+        if (a.depth.test != b.depth.test || a.depth.write != b.depth.write || a.depth.compare != b.depth.compare)
+        {
+            return false;
+        }
+
+        const uint32 renderTargetCount = std::min(a.renderTargetCount, MAX_PIPELINE_RENDER_TARGETS);
+        if (renderTargetCount != std::min(b.renderTargetCount, MAX_PIPELINE_RENDER_TARGETS))
+        {
+            return false;
+        }
+        for (uint32 i = 0; i < renderTargetCount; ++i)
+        {
+            const PipelineBlendState& blendA = a.blend[i];
+            const PipelineBlendState& blendB = b.blend[i];
+            if (a.renderTargetFormats[i] != b.renderTargetFormats[i] || blendA.writeMask != blendB.writeMask || blendA.enable != blendB.enable)
+            {
+                return false;
+            }
+            if (blendA.enable && (blendA.source != blendB.source || blendA.destination != blendB.destination || blendA.op != blendB.op ||
+                blendA.sourceAlpha != blendB.sourceAlpha || blendA.destinationAlpha != blendB.destinationAlpha || blendA.alphaOp != blendB.alphaOp))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    PipelineCache::PipelineCache(PipelineCompiler& compiler, uint64 deviceId)
+        : m_compiler(compiler), m_deviceId(deviceId)
+    {
+    }
+
+    PipelineCache::~PipelineCache()
+    {
+        WaitForPrewarm();
+    }
+
+    bool PipelineCache::Load(const std::string& fileName)
+    {
+        // No file yet is the first run, not an error
+        if (!std::ifstream(fileName, std::ios::binary))
+        {
+            return false;
+        }
+
+        BinaryReader reader;
+        if (!reader.LoadFromFile(fileName))
+        {
+            return false;
+        }
+        if (!Deserialize(reader))
+        {
+            LOG_WARN("Discarding pipeline cache '{}' written by another version or device", fileName);
+            return false;
+        }
+        return true;
+    }
+
+    bool PipelineCache::Save(const std::string& fileName) const
+    {
+        BinaryWriter writer;
+        Serialize(writer);
+        return writer.SaveToFile(fileName);
+    }
+
+    void PipelineCache::Serialize(BinaryWriter& writer) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Pipelines created this run and those loaded but not needed this time; failed ones are dropped.
+        // Sorted so the same set of pipelines always writes the same file
+        std::vector<uint64> keys;
+        for (const auto& [key, entry] : m_entries)
+        {
+            if (entry.state == EntryState::Pending || (entry.state == EntryState::Ready && entry.pipeline.IsValid()))
+            {
+                keys.push_back(key);
+            }
+        }
+        std::sort(keys.begin(), keys.end());
+
+        writer.Write(PIPELINE_CACHE_MAGIC);
+        writer.Write(PIPELINE_CACHE_VERSION);
+        writer.Write(m_deviceId);
+        writer.Write(static_cast<uint32>(keys.size()));
+        for (uint64 key : keys)
+        {
+            const Entry& entry = m_entries.at(key);
+            writer.Write(HashPipelineDesc(entry.desc));
+            WritePipelineDesc(writer, entry.desc);
+            writer.WriteArray(entry.blob);
+        }
+    }
+
+    bool PipelineCache::Deserialize(BinaryReader& reader)
+    {
+        uint32 magic = 0;
+        uint32 version = 0;
+        uint64 deviceId = 0;
+        uint32 entryCount = 0;
+
+        if (!reader.Read(magic) || magic != PIPELINE_CACHE_MAGIC) return false;
+        if (!reader.Read(version) || version != PIPELINE_CACHE_VERSION) return false;
+        if (!reader.Read(deviceId) || deviceId != m_deviceId) return false;
+        if (!reader.Read(entryCount)) return false;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (uint32 i = 0; i < entryCount; ++i)
+        {
+            uint64 key = 0;
+            Entry entry;
+            if (!reader.Read(key) || !ReadPipelineDesc(reader, entry.desc) || !reader.ReadArray(entry.blob)) return false;
+
+            // A description hashing differently now means the hash or the layout changed without a version bump
+            if (HashPipelineDesc(entry.desc) != key)
+            {
+                ++m_stats.rejectedEntries;
+                continue;
+            }
+
+            bool inserted = false;
+            Entry& loaded = FindEntry(entry.desc, inserted);
+            if (inserted)
+            {
+                loaded = std::move(entry);
+                ++m_stats.loadedEntries;
+            }
+        }
+        return true;
+    }
+
+    void PipelineCache::BeginPrewarm(uint32 threadCount)
+    {
+        WaitForPrewarm();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_prewarmKeys.clear();
+            for (const auto& [key, entry] : m_entries)
+            {
+                if (entry.state == EntryState::Pending)
+                {
+                    m_prewarmKeys.push_back(key);
+                }
+            }
+            m_nextPrewarm = 0;
+        }
+
+        threadCount = std::min(std::max(threadCount, 1u), static_cast<uint32>(m_prewarmKeys.size()));
+        for (uint32 i = 0; i < threadCount; ++i)
+        {
+            m_prewarmThreads.emplace_back(&PipelineCache::PrewarmLoop, this);
+        }
+    }
+
+    void PipelineCache::WaitForPrewarm()
+    {
+        for (std::thread& thread : m_prewarmThreads)
+        {
+            thread.join();
+        }
+        m_prewarmThreads.clear();
+    }
+
+    void PipelineCache::PrewarmLoop()
+    {
+        for (uint32 i = m_nextPrewarm++; i < m_prewarmKeys.size(); i = m_nextPrewarm++)
+        {
+            Entry* entry = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                Entry& candidate = m_entries.at(m_prewarmKeys[i]);
+                if (candidate.state != EntryState::Pending)
+                {
+                    continue;
+                }
+                candidate.state = EntryState::Creating;
+                entry = &candidate;
+            }
+            Create(*entry, true);
+        }
+    }
+
+    void PipelineCache::Create(Entry& entry, bool prewarm)
+    {
+        const Clock::time_point start = Clock::now();
+        std::vector<byte> blob;
+        const RHIPipelineHandle pipeline = m_compiler.CreatePipeline(entry.desc, entry.blob, blob);
+        const double createTime = GetElapsed(start);
+        if (!pipeline.IsValid())
+        {
+            LOG_ERROR("Failed to create pipeline {}", HashPipelineDesc(entry.desc));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.blobCreates += entry.blob.empty() ? 0 : 1;
+            m_stats.prewarmed += prewarm ? 1 : 0;
+            m_stats.createTime += createTime;
+            if (!blob.empty())
+            {
+                entry.blob = std::move(blob);
+            }
+            entry.pipeline = pipeline;
+            entry.prewarmed = prewarm;
+            entry.createTime = createTime;
+            entry.state = EntryState::Ready;
+        }
+        m_createdCondition.notify_all();
+    }
+
+    PipelineCache::Entry& PipelineCache::FindEntry(const PipelineDesc& desc, bool& inserted)
+    {
+        for (uint64 key = HashPipelineDesc(desc);; ++key)
+        {
+            auto [it, added] = m_entries.try_emplace(key);
+            inserted = added;
+            if (inserted)
+            {
+                it->second.desc = desc;
+                return it->second;
+            }
+            if (IsSamePipelineDesc(it->second.desc, desc))
+            {
+                return it->second;
+            }
+            ++m_stats.collisions;
+        }
+    }
+
+    RHIPipelineHandle PipelineCache::GetPipeline(const PipelineDesc& desc)
+    {
+        const Clock::time_point start = Clock::now();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        bool inserted = false;
+        Entry& entry = FindEntry(desc, inserted);
+
+        switch (entry.state)
+        {
+        case EntryState::Ready:
+            ++m_stats.hits;
+            break;
+
+        case EntryState::Creating:
+            // Prewarm got there first: wait for it instead of creating the pipeline a second time
+            m_createdCondition.wait(lock, [&]() { return entry.state == EntryState::Ready; });
+            ++m_stats.hits;
+            m_stats.stallTime += GetElapsed(start);
+            break;
+
+        case EntryState::Pending:
+            ++m_stats.misses;
+            entry.state = EntryState::Creating;
+            lock.unlock();
+            Create(entry, false);
+            lock.lock();
+            m_stats.stallTime += GetElapsed(start);
+            break;
+        }
+
+        // First use of a prewarmed pipeline: what it would have cost here, less any wait for it
+        if (entry.prewarmed)
+        {
+            m_stats.hitchTimeAvoided += std::max(entry.createTime - GetElapsed(start), 0.0);
+            entry.prewarmed = false;
+        }
+        return entry.pipeline;
+    }
+
+    uint32 PipelineCache::GetEntryCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return static_cast<uint32>(m_entries.size());
+    }
+
+    PipelineCacheStats PipelineCache::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+}
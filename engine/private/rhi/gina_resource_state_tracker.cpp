@@ -0,0 +1,234 @@
+#include "rhi/gina_resource_state_tracker.h"
+
+#include <algorithm>
+
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    namespace
+    {
+        bool Covers(RHIResourceState current, RHIResourceState state) noexcept
+        {
+            if (current == state)
+            {
+                return true;
+            }
+            const uint32 bits = static_cast<uint32>(state);
+            return IsReadOnlyState(current) && IsReadOnlyState(state) && bits != 0 && (static_cast<uint32>(current) & bits) == bits;
+        }
+
+        // State a transition from current ends in: reads accumulate, anything else replaces
+        RHIResourceState GetTargetState(RHIResourceState current, RHIResourceState state) noexcept
+        {
+            if (current != RHIResourceState::Common && IsReadOnlyState(current) && IsReadOnlyState(state))
+            {
+                return current | state;
+            }
+            return state;
+        }
+    }
+
+    void ResourceStateTracker::Register(RHIResourceHandle resource, uint32 subresourceCount, RHIResourceState state)
+    {
+        if (resource.id >= m_resources.size())
+        {
+            m_resources.resize(resource.id + 1);
+        }
+        TrackedResource& tracked = m_resources[resource.id];
+        tracked = TrackedResource();
+        tracked.registered = true;
+        tracked.subresourceCount = std::max(subresourceCount, 1u);
+        tracked.states.assign(1, state);
+    }
+
+    void ResourceStateTracker::Unregister(RHIResourceHandle resource)
+    {
+        if (IsRegistered(resource))
+        {
+            m_resources[resource.id] = TrackedResource();
+        }
+    }
+
+    bool ResourceStateTracker::IsRegistered(RHIResourceHandle resource) const noexcept
+    {
+        return resource.id < m_resources.size() && m_resources[resource.id].registered;
+    }
+
+    RHIResourceState ResourceStateTracker::GetState(RHIResourceHandle resource, uint32 subresource) const noexcept
+    {
+        const TrackedResource& tracked = m_resources[resource.id];
+        return tracked.states.size() == 1 ? tracked.states[0] : tracked.states[subresource];
+    }
+
+    void ResourceStateTracker::Use(RHIResourceHandle resource, RHIResourceState state, uint32 subresource)
+    {
+        GINA_ASSERT_MSG(IsRegistered(resource), "Using a resource the tracker does not know");
+        TrackedResource& tracked = m_resources[resource.id];
+
+        if (tracked.splitPending)
+        {
+            if (subresource == ALL_RHI_SUBRESOURCES && Covers(tracked.splitState, state))
+            {
+                EndSplit(resource, tracked);
+                return;
+            }
+            EndSplit(resource, tracked);
+        }
+
+        if (subresource != ALL_RHI_SUBRESOURCES)
+        {
+            if (tracked.states.size() == 1)
+            {
+                tracked.states.assign(tracked.subresourceCount, tracked.states[0]);
+            }
+            Transition(resource, tracked, subresource, state);
+        }
+        else if (tracked.states.size() == 1)
+        {
+            Transition(resource, tracked, ALL_RHI_SUBRESOURCES, state);
+        }
+        else
+        {
+            for (uint32 i = 0; i < tracked.subresourceCount; ++i)
+            {
+                Transition(resource, tracked, i, state);
+            }
+        }
+
+        // Back to a single state once the subresources agree again
+        if (tracked.states.size() > 1 &&
+            std::all_of(tracked.states.begin(), tracked.states.end(), [&](RHIResourceState s) { return s == tracked.states[0]; }))
+        {
+            tracked.states.resize(1);
+        }
+    }
+
+    void ResourceStateTracker::BeginTransition(RHIResourceHandle resource, RHIResourceState state)
+    {
+        GINA_ASSERT_MSG(IsRegistered(resource), "Transitioning a resource the tracker does not know");
+        TrackedResource& tracked = m_resources[resource.id];
+
+        // Split barriers need one state to start from, and UAV barriers have no halves
+        if (tracked.splitPending || tracked.states.size() != 1 || Covers(tracked.states[0], state))
+        {
+            return;
+        }
+
+        const RHIResourceState target = GetTargetState(tracked.states[0], state);
+        AddBarrier(tracked, { resource, tracked.states[0], target, ALL_RHI_SUBRESOURCES, RHIBarrierFlags::BeginOnly });
+        tracked.splitPending = true;
+        tracked.splitState = target;
+        ++m_stats.splitBarriers;
+    }
+
+    void ResourceStateTracker::EndSplit(RHIResourceHandle resource, TrackedResource& tracked)
+    {
+        // Both halves in one batch would be a plain barrier split for nothing; collapse them
+        auto begin = std::find_if(m_pending.begin(), m_pending.end(), [&](const RHIBarrier& barrier)
+        {
+            return barrier.resource == resource && barrier.flags == RHIBarrierFlags::BeginOnly;
+        });
+        if (begin != m_pending.end())
+        {
+            begin->flags = RHIBarrierFlags::None;
+            --m_stats.splitBarriers;
+        }
+        else
+        {
+            AddBarrier(tracked, { resource, tracked.states[0], tracked.splitState, ALL_RHI_SUBRESOURCES, RHIBarrierFlags::EndOnly });
+        }
+        tracked.states[0] = tracked.splitState;
+        tracked.splitPending = false;
+    }
+
+    void ResourceStateTracker::Transition(RHIResourceHandle resource, TrackedResource& tracked, uint32 subresource, RHIResourceState state)
+    {
+        RHIResourceState& current = tracked.states[subresource == ALL_RHI_SUBRESOURCES ? 0 : subresource];
+
+        // Unordered access after unordered access needs its writes to finish, once per pass
+        if (current == RHIResourceState::UnorderedAccess && state == RHIResourceState::UnorderedAccess)
+        {
+            const bool pending = tracked.batch == m_batch && std::any_of(m_pending.begin(), m_pending.end(), [&](const RHIBarrier& barrier)
+            {
+                return barrier.resource == resource && barrier.after == RHIResourceState::UnorderedAccess;
+            });
+            if (pending)
+            {
+                ++m_stats.elidedTransitions;
+                return;
+            }
+            AddBarrier(tracked, { resource, state, state, ALL_RHI_SUBRESOURCES, RHIBarrierFlags::None });
+            return;
+        }
+
+        if (Covers(current, state))
+        {
+            ++m_stats.elidedTransitions;
+            return;
+        }
+
+        const RHIResourceState target = GetTargetState(current, state);
+
+        // A barrier for this subresource already waits in the batch: extend it rather than chaining another
+        if (tracked.batch == m_batch)
+        {
+            auto it = std::find_if(m_pending.begin(), m_pending.end(), [&](const RHIBarrier& barrier)
+            {
+                return barrier.resource == resource && barrier.subresource == subresource && barrier.flags == RHIBarrierFlags::None &&
+                    barrier.before != barrier.after;
+            });
+            if (it != m_pending.end())
+            {
+                ++m_stats.elidedTransitions;
+                current = target;
+                if (it->before == target)
+                {
+                    m_pending.erase(it);
+                }
+                else
+                {
+                    it->after = target;
+                }
+                return;
+            }
+        }
+
+        AddBarrier(tracked, { resource, current, target, subresource, RHIBarrierFlags::None });
+        current = target;
+    }
+
+    void ResourceStateTracker::AddBarrier(TrackedResource& tracked, const RHIBarrier& barrier)
+    {
+        tracked.batch = m_batch;
+        m_pending.push_back(barrier);
+    }
+
+    uint32 ResourceStateTracker::Flush(RHICommandList& list)
+    {
+        const uint32 count = static_cast<uint32>(m_pending.size());
+        if (count > 0)
+        {
+            list.Barrier(m_pending.data(), count);
+            m_stats.barriers += count;
+            ++m_stats.batches;
+            m_pending.clear();
+        }
+        ++m_batch;
+        return count;
+    }
+
+    uint32 ResourceStateTracker::Flush(std::vector<RHIBarrier>& barriers)
+    {
+        const uint32 count = static_cast<uint32>(m_pending.size());
+        if (count > 0)
+        {
+            barriers.insert(barriers.end(), m_pending.begin(), m_pending.end());
+            m_stats.barriers += count;
+            ++m_stats.batches;
+            m_pending.clear();
+        }
+        ++m_batch;
+        return count;
+    }
+}
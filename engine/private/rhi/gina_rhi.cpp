@@ -0,0 +1,70 @@
+#include "rhi/gina_rhi.h"
+
+#include <algorithm>
+
+namespace gina
+{
+    RHIFormatInfo GetFormatInfo(RHIFormat format) noexcept
+    {
+        switch (format)
+        {
+        case RHIFormat::R8Unorm:
+            return { 1, 1 };
+        case RHIFormat::R8G8Unorm:
+            return { 1, 2 };
+        case RHIFormat::R8G8B8A8Unorm:
+        case RHIFormat::R8G8B8A8Srgb:
+        case RHIFormat::R32Float:
+        case RHIFormat::R32Uint:
+        case RHIFormat::D32Float:
+        case RHIFormat::D24S8:
+            return { 1, 4 };
+        case RHIFormat::R16G16B16A16Float:
+            return { 1, 8 };
+        case RHIFormat::R32G32B32A32Float:
+            return { 1, 16 };
+        case RHIFormat::BC1Unorm:
+        case RHIFormat::BC1Srgb:
+        case RHIFormat::BC4Unorm:
+            return { 4, 8 };
+        case RHIFormat::BC5Unorm:
+        case RHIFormat::BC7Unorm:
+        case RHIFormat::BC7Srgb:
+            return { 4, 16 };
+        default:
+            return { 1, 0 };
+        }
+    }
+
+    uint64 GetMipSize(RHIFormat format, uint32 width, uint32 height) noexcept
+    {
+        const RHIFormatInfo info = GetFormatInfo(format);
+        const uint64 blocksX = (std::max(width, 1u) + info.blockSize - 1) / info.blockSize;
+        const uint64 blocksY = (std::max(height, 1u) + info.blockSize - 1) / info.blockSize;
+        return blocksX * blocksY * info.bytesPerBlock;
+    }
+
+    uint64 GetTextureSize(const RHITextureDesc& desc) noexcept
+    {
+        uint64 size = 0;
+        for (uint32 mip = 0; mip < desc.mipLevels; ++mip)
+        {
+            size += GetMipSize(desc.format, desc.width >> mip, desc.height >> mip);
+        }
+        return size * desc.arraySize;
+    }
+
+    uint32 GetUploadRowPitch(RHIFormat format, uint32 width) noexcept
+    {
+        const RHIFormatInfo info = GetFormatInfo(format);
+        const uint32 rowSize = (std::max(width, 1u) + info.blockSize - 1) / info.blockSize * info.bytesPerBlock;
+        return (rowSize + RHI_TEXTURE_ROW_ALIGNMENT - 1) / RHI_TEXTURE_ROW_ALIGNMENT * RHI_TEXTURE_ROW_ALIGNMENT;
+    }
+
+    uint64 GetUploadMipSize(RHIFormat format, uint32 width, uint32 height) noexcept
+    {
+        const RHIFormatInfo info = GetFormatInfo(format);
+        const uint64 rows = (std::max(height, 1u) + info.blockSize - 1) / info.blockSize;
+        return rows * GetUploadRowPitch(format, width);
+    }
+}
@@ -0,0 +1,123 @@
+#include "rhi/gina_upload_ring.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/gina_assert.h"
+#include "core/gina_logger.h"
+
+namespace gina
+{
+    bool RingAllocator::Allocate(uint64 size, uint64 alignment, uint64& offset) noexcept
+    {
+        GINA_ASSERT_MSG((alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+        // An empty ring starts over at offset 0, so large allocations do not wrap around for nothing
+        if (m_head == m_tail)
+        {
+            m_head = m_tail = m_retiredHead = 0;
+        }
+
+        uint64 start = m_head;
+        uint64 alignedOffset = (start % m_capacity + alignment - 1) & ~(alignment - 1);
+        if (alignedOffset + size > m_capacity)
+        {
+            start += m_capacity - start % m_capacity;
+            alignedOffset = 0;
+        }
+
+        const uint64 end = start - start % m_capacity + alignedOffset + size;
+        if (end - m_tail > m_capacity)
+        {
+            return false;
+        }
+        m_head = end;
+        offset = alignedOffset;
+        return true;
+    }
+
+    void RingAllocator::Retire(uint64 fenceValue)
+    {
+        if (m_head == m_retiredHead)
+        {
+            return;
+        }
+        m_retired.push_back({ fenceValue, m_head });
+        m_retiredHead = m_head;
+    }
+
+    void RingAllocator::Reclaim(uint64 completedValue) noexcept
+    {
+        while (!m_retired.empty() && m_retired.front().fenceValue <= completedValue)
+        {
+            m_tail = m_retired.front().end;
+            m_retired.pop_front();
+        }
+    }
+
+    UploadRing::UploadRing(RHIDevice& device, RHIFence& fence, uint64 capacity)
+        : m_device(&device), m_fence(&fence), m_allocator(capacity)
+    {
+        m_buffer = device.CreateBuffer({ capacity, RHIMemoryType::Upload, false, "UploadRing" });
+        m_data = static_cast<byte*>(device.Map(m_buffer));
+    }
+
+    UploadRing::~UploadRing()
+    {
+        m_device->DestroyResource(m_buffer);
+    }
+
+    void UploadRing::BeginFrame()
+    {
+        m_allocator.Reclaim(m_fence->GetCompletedValue());
+    }
+
+    UploadAllocation UploadRing::Allocate(uint64 size, uint64 alignment)
+    {
+        // An empty ring allocates from offset 0, so anything up to the capacity fits once the GPU catches up
+        if (size > m_allocator.GetCapacity())
+        {
+            LOG_WARN("Upload ring of {} bytes cannot fit an allocation of {} bytes", m_allocator.GetCapacity(), size);
+            ++m_stats.failures;
+            return {};
+        }
+
+        uint64 offset = 0;
+        bool stalled = false;
+        while (!m_allocator.Allocate(size, alignment, offset))
+        {
+            // Wait for the oldest frame still holding space; if none is left the request cannot fit
+            const uint64 fenceValue = m_allocator.GetOldestFenceValue();
+            if (fenceValue == 0)
+            {
+                LOG_WARN("Upload ring of {} bytes cannot fit {} more bytes this frame", m_allocator.GetCapacity(), size);
+                ++m_stats.failures;
+                return {};
+            }
+            m_fence->WaitOnCPU(fenceValue);
+            m_allocator.Reclaim(m_fence->GetCompletedValue());
+            stalled = true;
+        }
+
+        ++m_stats.allocations;
+        m_stats.bytes += size;
+        m_stats.stalls += stalled ? 1 : 0;
+        m_stats.peakUsedSize = std::max(m_stats.peakUsedSize, m_allocator.GetUsedSize());
+        return { m_buffer, offset, size, m_data + offset };
+    }
+
+    UploadAllocation UploadRing::Upload(const void* data, uint64 size, uint64 alignment)
+    {
+        const UploadAllocation allocation = Allocate(size, alignment);
+        if (allocation.IsValid())
+        {
+            std::memcpy(allocation.data, data, size);
+        }
+        return allocation;
+    }
+
+    void UploadRing::EndFrame(uint64 fenceValue)
+    {
+        m_allocator.Retire(fenceValue);
+    }
+}
@@ -0,0 +1,671 @@
+#include "texture/gina_block_compression.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "core/gina_assert.h"
+
+namespace gina
+{
+    namespace
+    {
+        constexpr uint32 BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+        constexpr uint32 BC7_MODE_6 = 1 << 6;
+        constexpr uint32 REFINE_PASSES = 2;
+
+        using BlockPixels = float[BC_BLOCK_TEXELS][4];
+
+        void LoadPixels(const uint8* texels, BlockPixels pixels) noexcept
+        {
+            for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+            {
+                for (uint32 c = 0; c < 4; ++c)
+                {
+                    pixels[i][c] = texels[i * 4 + c];
+                }
+            }
+        }
+
+        // Mean of the block and the direction it varies most along, over the first channelCount channels.
+        // The axis is zero for a block of one color
+        void FitAxis(const BlockPixels pixels, uint32 channelCount, float* mean, float* axis) noexcept
+        {
+            float minimum[4] = { FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX };
+            float maximum[4] = { -FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            for (uint32 c = 0; c < channelCount; ++c)
+            {
+                mean[c] = 0.0f;
+                for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+                {
+                    mean[c] += pixels[i][c];
+                    minimum[c] = std::min(minimum[c], pixels[i][c]);
+                    maximum[c] = std::max(maximum[c], pixels[i][c]);
+                }
+                mean[c] /= BC_BLOCK_TEXELS;
+                axis[c] = maximum[c] - minimum[c];
+            }
+
+            float covariance[4][4] = {};
+            for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+            {
+                for (uint32 a = 0; a < channelCount; ++a)
+                {
+                    for (uint32 b = 0; b < channelCount; ++b)
+                    {
+                        covariance[a][b] += (pixels[i][a] - mean[a]) * (pixels[i][b] - mean[b]);
+                    }
+                }
+            }
+
+            // Power iteration from the bounding box diagonal, which is already close for most blocks
+            for (uint32 iteration = 0; iteration < 8; ++iteration)
+            {
+                float next[4] = {};
+                float length = 0.0f;
+                for (uint32 a = 0; a < channelCount; ++a)
+                {
+                    for (uint32 b = 0; b < channelCount; ++b)
+                    {
+                        next[a] += covariance[a][b] * axis[b];
+                    }
+                    length += next[a] * next[a];
+                }
+                if (length < 1e-12f)
+                {
+                    break;
+                }
+                length = 1.0f / std::sqrt(length);
+                for (uint32 c = 0; c < channelCount; ++c)
+                {
+                    axis[c] = next[c] * length;
+                }
+            }
+        }
+
+        // Endpoints at the extremes of the block's projection on its axis
+        void FitEndpoints(const BlockPixels pixels, uint32 channelCount, float* start, float* end) noexcept
+        {
+            float mean[4];
+            float axis[4];
+            FitAxis(pixels, channelCount, mean, axis);
+
+            float low = 0.0f;
+            float high = 0.0f;
+            for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+            {
+                float t = 0.0f;
+                for (uint32 c = 0; c < channelCount; ++c)
+                {
+                    t += (pixels[i][c] - mean[c]) * axis[c];
+                }
+                low = std::min(low, t);
+                high = std::max(high, t);
+            }
+            for (uint32 c = 0; c < channelCount; ++c)
+            {
+                start[c] = std::clamp(mean[c] + axis[c] * low, 0.0f, 255.0f);
+                end[c] = std::clamp(mean[c] + axis[c] * high, 0.0f, 255.0f);
+            }
+        }
+
+        // Endpoints minimizing the squared error for fixed interpolation weights (the share of end per texel)
+        bool SolveEndpoints(const BlockPixels pixels, uint32 channelCount, const float* weights, float* start, float* end) noexcept
+        {
+            float aa = 0.0f;
+            float ab = 0.0f;
+            float bb = 0.0f;
+            float ap[4] = {};
+            float bp[4] = {};
+            for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+            {
+                const float b = weights[i];
+                const float a = 1.0f - b;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (uint32 c = 0; c < channelCount; ++c)
+                {
+                    ap[c] += a * pixels[i][c];
+                    bp[c] += b * pixels[i][c];
+                }
+            }
+
+            const float determinant = aa * bb - ab * ab;
+            if (std::fabs(determinant) < 1e-6f)
+            {
+                return false;
+            }
+            const float inverse = 1.0f / determinant;
+            for (uint32 c = 0; c < channelCount; ++c)
+            {
+                start[c] = std::clamp((ap[c] * bb - bp[c] * ab) * inverse, 0.0f, 255.0f);
+                end[c] = std::clamp((bp[c] * aa - ap[c] * ab) * inverse, 0.0f, 255.0f);
+            }
+            return true;
+        }
+
+        // Palette entry closest to each texel, returning the total squared error
+        template <uint32 PaletteSize>
+        uint32 SelectIndices(const uint8* texels, uint32 channelCount, const int32 palette[PaletteSize][4], uint8* indices) noexcept
+        {
+            uint32 total = 0;
+            for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+            {
+                uint32 best = UINT32_MAX;
+                for (uint32 entry = 0; entry < PaletteSize; ++entry)
+                {
+                    uint32 error = 0;
+                    for (uint32 c = 0; c < channelCount; ++c)
+                    {
+                        const int32 difference = static_cast<int32>(texels[i * 4 + c]) - palette[entry][c];
+                        error += static_cast<uint32>(difference * difference);
+                    }
+                    if (error < best)
+                    {
+                        best = error;
+                        indices[i] = static_cast<uint8>(entry);
+                    }
+                }
+                total += best;
+            }
+            return total;
+        }
+
+        uint16 Pack565(const float* color) noexcept
+        {
+            const uint32 r = static_cast<uint32>(color[0] * 31.0f / 255.0f + 0.5f);
+            const uint32 g = static_cast<uint32>(color[1] * 63.0f / 255.0f + 0.5f);
+            const uint32 b = static_cast<uint32>(color[2] * 31.0f / 255.0f + 0.5f);
+            return static_cast<uint16>((r << 11) | (g << 5) | b);
+        }
+
+        void Unpack565(uint16 packed, int32* color) noexcept
+        {
+            const int32 r = (packed >> 11) & 31;
+            const int32 g = (packed >> 5) & 63;
+            const int32 b = packed & 31;
+            color[0] = (r << 3) | (r >> 2);
+            color[1] = (g << 2) | (g >> 4);
+            color[2] = (b << 3) | (b >> 2);
+            color[3] = 255;
+        }
+
+        void GetBC1Palette(uint16 color0, uint16 color1, int32 palette[4][4]) noexcept
+        {
+            Unpack565(color0, palette[0]);
+            Unpack565(color1, palette[1]);
+            for (uint32 c = 0; c < 4; ++c)
+            {
+                if (color0 > color1)
+                {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+                }
+                else
+                {
+                    // Three color mode; the fourth entry is transparent black
+                    palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+                    palette[3][c] = 0;
+                }
+            }
+        }
+
+        void GetBC4Palette(uint8 value0, uint8 value1, int32 palette[8]) noexcept
+        {
+            palette[0] = value0;
+            palette[1] = value1;
+            if (value0 > value1)
+            {
+                for (int32 k = 1; k < 7; ++k)
+                {
+                    palette[k + 1] = ((7 - k) * value0 + k * value1 + 3) / 7;
+                }
+            }
+            else
+            {
+                for (int32 k = 1; k < 5; ++k)
+                {
+                    palette[k + 1] = ((5 - k) * value0 + k * value1 + 2) / 5;
+                }
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+        }
+
+        // 128 bit block written and read from the least significant bit up
+        struct BlockBits
+        {
+            uint64 words[2] = {};
+            uint32 position = 0;
+
+            void Write(uint32 value, uint32 count) noexcept
+            {
+                if (position >= 64)
+                {
+                    words[1] |= static_cast<uint64>(value) << (position - 64);
+                }
+                else
+                {
+                    words[0] |= static_cast<uint64>(value) << position;
+                    if (position + count > 64)
+                    {
+                        words[1] |= static_cast<uint64>(value) >> (64 - position);
+                    }
+                }
+                position += count;
+            }
+
+            uint32 Read(uint32 count) noexcept
+            {
+                uint64 value;
+                if (position >= 64)
+                {
+                    value = words[1] >> (position - 64);
+                }
+                else
+                {
+                    value = words[0] >> position;
+                    if (position + count > 64)
+                    {
+                        value |= words[1] << (64 - position);
+                    }
+                }
+                position += count;
+                return static_cast<uint32>(value & ((1ull << count) - 1));
+            }
+        };
+
+        struct BC7Mode6
+        {
+            uint8 endpoints[2][4];      // 7 bit
+            uint8 parity[2];
+            uint8 indices[BC_BLOCK_TEXELS];
+        };
+
+        void GetBC7Palette(const BC7Mode6& mode, int32 palette[16][4]) noexcept
+        {
+            for (uint32 c = 0; c < 4; ++c)
+            {
+                const int32 start = (mode.endpoints[0][c] << 1) | mode.parity[0];
+                const int32 end = (mode.endpoints[1][c] << 1) | mode.parity[1];
+                for (uint32 i = 0; i < 16; ++i)
+                {
+                    palette[i][c] = ((64 - BC7_WEIGHTS[i]) * start + BC7_WEIGHTS[i] * end + 32) >> 6;
+                }
+            }
+        }
+
+        uint8 QuantizeBC7(float value, uint32 parity) noexcept
+        {
+            return static_cast<uint8>(std::clamp(static_cast<int32>((value - parity) * 0.5f + 0.5f), 0, 127));
+        }
+
+        // Edge blocks repeat the last row and column of the image
+        void GatherBlock(const uint8* texels, uint32 width, uint32 height, uint32 blockX, uint32 blockY, uint8* block) noexcept
+        {
+            for (uint32 y = 0; y < BC_BLOCK_DIMENSION; ++y)
+            {
+                const uint32 sourceY = std::min(blockY * BC_BLOCK_DIMENSION + y, height - 1);
+                for (uint32 x = 0; x < BC_BLOCK_DIMENSION; ++x)
+                {
+                    const uint32 sourceX = std::min(blockX * BC_BLOCK_DIMENSION + x, width - 1);
+                    std::memcpy(block + (y * BC_BLOCK_DIMENSION + x) * 4, texels + (static_cast<size_t>(sourceY) * width + sourceX) * 4, 4);
+                }
+            }
+        }
+    }
+
+    void EncodeBC1Block(const uint8* texels, uint8* block) noexcept
+    {
+        BlockPixels pixels;
+        LoadPixels(texels, pixels);
+
+        float start[4];
+        float end[4];
+        FitEndpoints(pixels, 3, start, end);
+
+        uint16 color0 = Pack565(end);
+        uint16 color1 = Pack565(start);
+        uint8 indices[BC_BLOCK_TEXELS] = {};
+        uint32 bestError = UINT32_MAX;
+        uint16 best0 = color0;
+        uint16 best1 = color1;
+        uint8 bestIndices[BC_BLOCK_TEXELS] = {};
+
+        for (uint32 pass = 0; pass <= REFINE_PASSES; ++pass)
+        {
+            // Four color mode needs color0 above color1; swapping the endpoints mirrors the palette
+            if (color0 < color1)
+            {
+                std::swap(color0, color1);
+            }
+            int32 palette[4][4];
+            GetBC1Palette(color0, color1, palette);
+            const uint32 error = color0 == color1 ? SelectIndices<1>(texels, 3, palette, indices) : SelectIndices<4>(texels, 3, palette, indices);
+            if (error < bestError)
+            {
+                bestError = error;
+                best0 = color0;
+                best1 = color1;
+                std::memcpy(bestIndices, indices, sizeof(indices));
+            }
+            if (color0 == color1)
+            {
+                break;
+            }
+
+            constexpr float WEIGHTS[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+            float weights[BC_BLOCK_TEXELS];
+            for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+            {
+                weights[i] = WEIGHTS[indices[i]];
+            }
+            float color0Value[4];
+            float color1Value[4];
+            if (!SolveEndpoints(pixels, 3, weights, color0Value, color1Value))
+            {
+                break;
+            }
+            color0 = Pack565(color0Value);
+            color1 = Pack565(color1Value);
+        }
+
+        uint32 bits = 0;
+        for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+        {
+            bits |= static_cast<uint32>(bestIndices[i]) << (i * 2);
+        }
+        std::memcpy(block, &best0, 2);
+        std::memcpy(block + 2, &best1, 2);
+        std::memcpy(block + 4, &bits, 4);
+    }
+
+    void DecodeBC1Block(const uint8* block, uint8* texels) noexcept
+    {
+        uint16 color0;
+        uint16 color1;
+        uint32 bits;
+        std::memcpy(&color0, block, 2);
+        std::memcpy(&color1, block + 2, 2);
+        std::memcpy(&bits, block + 4, 4);
+
+        int32 palette[4][4];
+        GetBC1Palette(color0, color1, palette);
+        for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+        {
+            const uint32 index = (bits >> (i * 2)) & 3;
+            for (uint32 c = 0; c < 4; ++c)
+            {
+                texels[i * 4 + c] = static_cast<uint8>(palette[index][c]);
+            }
+        }
+    }
+
+    void EncodeBC4Block(const uint8* texels, uint32 channel, uint8* block) noexcept
+    {
+        uint8 minimum = 255;
+        uint8 maximum = 0;
+        for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+        {
+            minimum = std::min(minimum, texels[i * 4 + channel]);
+            maximum = std::max(maximum, texels[i * 4 + channel]);
+        }
+
+        // Eight value mode: palette positions 0..7 from maximum to minimum are indices 0, 2..7, 1
+        uint64 bits = 0;
+        if (maximum > minimum)
+        {
+            const float scale = 7.0f / (maximum - minimum);
+            for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+            {
+                const uint32 position = static_cast<uint32>((maximum - texels[i * 4 + channel]) * scale + 0.5f);
+                const uint64 index = position == 0 ? 0 : (position == 7 ? 1 : position + 1);
+                bits |= index << (i * 3);
+            }
+        }
+
+        block[0] = maximum;
+        block[1] = minimum;
+        std::memcpy(block + 2, &bits, 6);
+    }
+
+    void DecodeBC4Block(const uint8* block, uint32 channel, uint8* texels) noexcept
+    {
+        int32 palette[8];
+        GetBC4Palette(block[0], block[1], palette);
+        uint64 bits = 0;
+        std::memcpy(&bits, block + 2, 6);
+        for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+        {
+            texels[i * 4 + channel] = static_cast<uint8>(palette[(bits >> (i * 3)) & 7]);
+        }
+    }
+
+    void EncodeBC5Block(const uint8* texels, uint8* block) noexcept
+    {
+        EncodeBC4Block(texels, 0, block);
+        EncodeBC4Block(texels, 1, block + 8);
+    }
+
+    void DecodeBC5Block(const uint8* block, uint8* texels) noexcept
+    {
+        DecodeBC4Block(block, 0, texels);
+        DecodeBC4Block(block + 8, 1, texels);
+        for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+        {
+            texels[i * 4 + 2] = 0;
+            texels[i * 4 + 3] = 255;
+        }
+    }
+
+    void EncodeBC7Block(const uint8* texels, uint8* block) noexcept
+    {
+        BlockPixels pixels;
+        LoadPixels(texels, pixels);
+
+        float start[4];
+        float end[4];
+        FitEndpoints(pixels, 4, start, end);
+
+        BC7Mode6 best = {};
+        uint32 bestError = UINT32_MAX;
+        for (uint32 pass = 0; pass <= REFINE_PASSES; ++pass)
+        {
+            const uint32 passError = bestError;
+            for (uint32 parity = 0; parity < 4; ++parity)
+            {
+                BC7Mode6 mode;
+                mode.parity[0] = parity & 1;
+                mode.parity[1] = parity >> 1;
+                for (uint32 c = 0; c < 4; ++c)
+                {
+                    mode.endpoints[0][c] = QuantizeBC7(start[c], mode.parity[0]);
+                    mode.endpoints[1][c] = QuantizeBC7(end[c], mode.parity[1]);
+                }
+                int32 palette[16][4];
+                GetBC7Palette(mode, palette);
+                const uint32 error = SelectIndices<16>(texels, 4, palette, mode.indices);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    best = mode;
+                }
+            }
+            if (bestError == 0 || (pass > 0 && bestError == passError))
+            {
+                break;
+            }
+
+            float weights[BC_BLOCK_TEXELS];
+            for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+            {
+                weights[i] = BC7_WEIGHTS[best.indices[i]] / 64.0f;
+            }
+            if (!SolveEndpoints(pixels, 4, weights, start, end))
+            {
+                break;
+            }
+        }
+
+        // The first texel's index drops its top bit, so it has to be in the lower half of the palette
+        if (best.indices[0] >= 8)
+        {
+            std::swap(best.endpoints[0], best.endpoints[1]);
+            std::swap(best.parity[0], best.parity[1]);
+            for (uint8& index : best.indices)
+            {
+                index = static_cast<uint8>(15 - index);
+            }
+        }
+
+        BlockBits bits;
+        bits.Write(BC7_MODE_6, 7);
+        for (uint32 c = 0; c < 4; ++c)
+        {
+            bits.Write(best.endpoints[0][c], 7);
+            bits.Write(best.endpoints[1][c], 7);
+        }
+        bits.Write(best.parity[0], 1);
+        bits.Write(best.parity[1], 1);
+        for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+        {
+            bits.Write(best.indices[i], i == 0 ? 3 : 4);
+        }
+        std::memcpy(block, bits.words, 16);
+    }
+
+    void DecodeBC7Block(const uint8* block, uint8* texels) noexcept
+    {
+        BlockBits bits;
+        std::memcpy(bits.words, block, 16);
+        if (bits.Read(7) != BC7_MODE_6)
+        {
+            std::memset(texels, 0, BC_BLOCK_TEXELS * 4);
+            return;
+        }
+
+        BC7Mode6 mode;
+        for (uint32 c = 0; c < 4; ++c)
+        {
+            mode.endpoints[0][c] = static_cast<uint8>(bits.Read(7));
+            mode.endpoints[1][c] = static_cast<uint8>(bits.Read(7));
+        }
+        mode.parity[0] = static_cast<uint8>(bits.Read(1));
+        mode.parity[1] = static_cast<uint8>(bits.Read(1));
+        for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+        {
+            mode.indices[i] = static_cast<uint8>(bits.Read(i == 0 ? 3 : 4));
+        }
+
+        int32 palette[16][4];
+        GetBC7Palette(mode, palette);
+        for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+        {
+            for (uint32 c = 0; c < 4; ++c)
+            {
+                texels[i * 4 + c] = static_cast<uint8>(palette[mode.indices[i]][c]);
+            }
+        }
+    }
+
+    void CompressImage(RHIFormat format, uint32 width, uint32 height, const uint8* texels, uint8* blocks, ThreadPool* pool)
+    {
+        const uint32 bytesPerBlock = GetFormatInfo(format).bytesPerBlock;
+        const uint32 blocksX = (width + BC_BLOCK_DIMENSION - 1) / BC_BLOCK_DIMENSION;
+        const uint32 blocksY = (height + BC_BLOCK_DIMENSION - 1) / BC_BLOCK_DIMENSION;
+
+        const ThreadPool::RangeFunc compressRows = [&](uint32 begin, uint32 end)
+        {
+            uint8 block[BC_BLOCK_TEXELS * 4];
+            for (uint32 blockY = begin; blockY < end; ++blockY)
+            {
+                for (uint32 blockX = 0; blockX < blocksX; ++blockX)
+                {
+                    GatherBlock(texels, width, height, blockX, blockY, block);
+                    uint8* output = blocks + (static_cast<size_t>(blockY) * blocksX + blockX) * bytesPerBlock;
+                    switch (format)
+                    {
+                    case RHIFormat::BC1Unorm:
+                    case RHIFormat::BC1Srgb:
+                        EncodeBC1Block(block, output);
+                        break;
+                    case RHIFormat::BC4Unorm:
+                        EncodeBC4Block(block, 0, output);
+                        break;
+                    case RHIFormat::BC5Unorm:
+                        EncodeBC5Block(block, output);
+                        break;
+                    case RHIFormat::BC7Unorm:
+                    case RHIFormat::BC7Srgb:
+                        EncodeBC7Block(block, output);
+                        break;
+                    default:
+                        GINA_ASSERT_MSG(false, "Not a block compressed format");
+                        break;
+                    }
+                }
+            }
+        };
+
+        if (pool != nullptr)
+        {
+            pool->ParallelFor(blocksY, 1, compressRows);
+        }
+        else
+        {
+            compressRows(0, blocksY);
+        }
+    }
+
+    void DecompressImage(RHIFormat format, uint32 width, uint32 height, const uint8* blocks, uint8* texels)
+    {
+        const uint32 bytesPerBlock = GetFormatInfo(format).bytesPerBlock;
+        const uint32 blocksX = (width + BC_BLOCK_DIMENSION - 1) / BC_BLOCK_DIMENSION;
+        const uint32 blocksY = (height + BC_BLOCK_DIMENSION - 1) / BC_BLOCK_DIMENSION;
+
+        uint8 block[BC_BLOCK_TEXELS * 4];
+        for (uint32 blockY = 0; blockY < blocksY; ++blockY)
+        {
+            for (uint32 blockX = 0; blockX < blocksX; ++blockX)
+            {
+                const uint8* input = blocks + (static_cast<size_t>(blockY) * blocksX + blockX) * bytesPerBlock;
+                std::memset(block, 0, sizeof(block));
+                switch (format)
+                {
+                case RHIFormat::BC1Unorm:
+                case RHIFormat::BC1Srgb:
+                    DecodeBC1Block(input, block);
+                    break;
+                case RHIFormat::BC4Unorm:
+                    DecodeBC4Block(input, 0, block);
+                    for (uint32 i = 0; i < BC_BLOCK_TEXELS; ++i)
+                    {
+                        block[i * 4 + 3] = 255;
+                    }
+                    break;
+                case RHIFormat::BC5Unorm:
+                    DecodeBC5Block(input, block);
+                    break;
+                case RHIFormat::BC7Unorm:
+                case RHIFormat::BC7Srgb:
+                    DecodeBC7Block(input, block);
+                    break;
+                default:
+                    GINA_ASSERT_MSG(false, "Not a block compressed format");
+                    break;
+                }
+
+                for (uint32 y = 0; y < BC_BLOCK_DIMENSION && blockY * BC_BLOCK_DIMENSION + y < height; ++y)
+                {
+                    for (uint32 x = 0; x < BC_BLOCK_DIMENSION && blockX * BC_BLOCK_DIMENSION + x < width; ++x)
+                    {
+                        const size_t target = static_cast<size_t>(blockY * BC_BLOCK_DIMENSION + y) * width + blockX * BC_BLOCK_DIMENSION + x;
+                        std::memcpy(texels + target * 4, block + (y * BC_BLOCK_DIMENSION + x) * 4, 4);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,601 @@
+#include "texture/gina_texture_streamer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include "core/gina_assert.h"
+#include "core/gina_logger.h"
+
+namespace gina
+{
+    namespace
+    {
+        double GetElapsed(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    uint32 ComputeStreamingMip(uint32 width, uint32 height, float screenWidth, float screenHeight) noexcept
+    {
+        const float texelsPerPixel = std::max(width / std::max(screenWidth, 1.0f), height / std::max(screenHeight, 1.0f));
+        return texelsPerPixel <= 1.0f ? 0 : static_cast<uint32>(std::floor(std::log2(texelsPerPixel)));
+    }
+
+    TextureStreamer::TextureStreamer(RHIDevice& device, FrameRing& frames, const TextureStreamerSettings& settings)
+        : m_device(device), m_frames(frames), m_settings(settings), m_uploadRing(device, frames.GetFence(), settings.uploadBufferSize)
+    {
+        for (uint32 i = 0; i < std::max(settings.ioThreadCount, 1u); ++i)
+        {
+            m_ioThreads.emplace_back(&TextureStreamer::IoLoop, this);
+        }
+    }
+
+    TextureStreamer::~TextureStreamer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_ioMutex);
+            m_stopping = true;
+        }
+        m_ioCondition.notify_all();
+        for (std::thread& thread : m_ioThreads)
+        {
+            thread.join();
+        }
+
+        for (const Texture& texture : m_textures)
+        {
+            if (texture.resource.IsValid())
+            {
+                m_device.DestroyResource(texture.resource);
+            }
+        }
+    }
+
+    uint32 TextureStreamer::AddTexture(const std::string& fileName)
+    {
+        TextureAsset header;
+        uint64 dataOffset = 0;
+        if (!TextureAssetSerializer::LoadHeader(fileName, header, dataOffset) || header.mips.empty())
+        {
+            return INVALID_STREAMED_TEXTURE;
+        }
+
+        uint32 index = static_cast<uint32>(m_textures.size());
+        if (!m_freeTextures.empty())
+        {
+            index = m_freeTextures.back();
+            m_freeTextures.pop_back();
+        }
+        else
+        {
+            m_textures.emplace_back();
+        }
+
+        Texture& texture = m_textures[index];
+        texture = Texture();
+        texture.alive = true;
+        texture.fileName = fileName;
+        texture.dataOffset = dataOffset;
+        texture.format = header.format;
+        texture.mips = std::move(header.mips);
+
+        const uint32 mipCount = static_cast<uint32>(texture.mips.size());
+        while (texture.tailMip + 1 < mipCount && (texture.mips[texture.tailMip].width > TEXTURE_STREAMING_TAIL_DIMENSION ||
+            texture.mips[texture.tailMip].height > TEXTURE_STREAMING_TAIL_DIMENSION))
+        {
+            ++texture.tailMip;
+        }
+
+        // Each load uploads through the ring at once, so a mip larger than all of it can never stream
+        while (texture.finestMip < texture.tailMip && GetUploadMipSize(texture.format, texture.mips[texture.finestMip].width,
+            texture.mips[texture.finestMip].height) + RHI_TEXTURE_PLACEMENT_ALIGNMENT > m_settings.uploadBufferSize)
+        {
+            ++texture.finestMip;
+        }
+        texture.residentMip = mipCount;
+        texture.requestedMip = mipCount;
+        texture.wantedMip = texture.tailMip;
+        texture.lastRequestFrame = m_frame;
+        return index;
+    }
+
+    void TextureStreamer::RemoveTexture(uint32 index)
+    {
+        GINA_ASSERT_MSG(index < m_textures.size() && m_textures[index].alive && !m_textures[index].removed, "Removing an invalid texture");
+
+        Texture& texture = m_textures[index];
+        if (texture.loading)
+        {
+            texture.removed = true;
+            return;
+        }
+        FreeSlot(index);
+    }
+
+    void TextureStreamer::FreeSlot(uint32 index)
+    {
+        Texture& texture = m_textures[index];
+        if (texture.resource.IsValid())
+        {
+            m_stats.residentBytes -= GetSize(texture, texture.residentMip);
+            m_frames.DeferRelease(texture.resource);
+        }
+        texture = Texture();
+        m_freeTextures.push_back(index);
+    }
+
+    void TextureStreamer::RequestMip(uint32 index, uint32 mip)
+    {
+        Texture& texture = m_textures[index];
+        texture.requestedMip = std::min(texture.requestedMip, mip);
+    }
+
+    uint64 TextureStreamer::GetSize(const Texture& texture, uint32 firstMip) const noexcept
+    {
+        uint64 size = 0;
+        for (uint32 mip = firstMip; mip < texture.mips.size(); ++mip)
+        {
+            size += texture.mips[mip].size;
+        }
+        return size;
+    }
+
+    void TextureStreamer::Update(RHICommandList& list)
+    {
+        ++m_frame;
+        m_frameUploadBytes = 0;
+        m_uploadRing.BeginFrame();
+
+        ApplyLoads();
+        UpdateWantedMips();
+
+        // A lowered budget: give back whatever nobody requested this frame
+        const uint64 usedBytes = m_stats.residentBytes + m_reservedBytes;
+        if (usedBytes > m_settings.memoryBudget)
+        {
+            Evict(usedBytes - m_settings.memoryBudget, INVALID_STREAMED_TEXTURE, m_frame);
+        }
+
+        IssueLoads();
+        Record(list);
+        m_uploadRing.EndFrame(m_frames.GetCurrentFenceValue());
+    }
+
+    void TextureStreamer::WaitForLoads()
+    {
+        std::unique_lock<std::mutex> lock(m_ioMutex);
+        m_readCondition.wait(lock, [&]() { return m_ioQueue.empty() && m_reading == 0; });
+    }
+
+    void TextureStreamer::ApplyLoads()
+    {
+        std::deque<Load> loads;
+        {
+            std::lock_guard<std::mutex> lock(m_ioMutex);
+            loads.swap(m_readLoads);
+        }
+
+        // Loads past this frame's upload allowance wait for the next one without holding up those behind them,
+        // except that one needing the whole ring holds back the rest until the ring has emptied for it
+        std::deque<Load> deferred;
+        bool holding = false;
+        for (Load& load : loads)
+        {
+            if (holding || !Apply(load, holding))
+            {
+                deferred.push_back(std::move(load));
+            }
+        }
+
+        if (!deferred.empty())
+        {
+            std::lock_guard<std::mutex> lock(m_ioMutex);
+            m_readLoads.insert(m_readLoads.begin(), std::make_move_iterator(deferred.begin()), std::make_move_iterator(deferred.end()));
+        }
+    }
+
+    bool TextureStreamer::Apply(Load& load, bool& holding)
+    {
+        Texture& texture = m_textures[load.texture];
+
+        // Mips the texture still wants; wanted mips never start below the tail, so an empty texture always takes it
+        const uint32 firstMip = std::max(load.firstMip, texture.wantedMip);
+        const bool cancelled = load.failed || texture.removed || firstMip >= texture.residentMip;
+        if (!cancelled)
+        {
+            const RHIFormat format = texture.format;
+            uint64 uploadBytes = 0;
+            for (uint32 mip = firstMip; mip < load.endMip; ++mip)
+            {
+                uploadBytes += GetUploadMipSize(format, texture.mips[mip].width, texture.mips[mip].height) + RHI_TEXTURE_PLACEMENT_ALIGNMENT;
+            }
+
+            // Going over the ring's free space wastes less than one load at the wrap, so twice the load always fits.
+            // A load too big for that fits once the ring is empty, as an empty ring starts over at offset 0
+            const RingAllocator& ring = m_uploadRing.GetAllocator();
+            const bool overFrameBudget = m_frameUploadBytes > 0 && m_frameUploadBytes + uploadBytes > m_settings.maxUploadBytesPerFrame;
+            const bool fits = ring.GetUsedSize() + uploadBytes * 2 <= ring.GetCapacity() || ring.GetUsedSize() == 0;
+            if (overFrameBudget || !fits)
+            {
+                holding = uploadBytes * 2 > ring.GetCapacity();
+                return false;
+            }
+            m_frameUploadBytes += uploadBytes;
+        }
+
+        m_reservedBytes -= load.reservedBytes;
+        --m_stats.pendingLoads;
+        texture.loading = false;
+
+        if (cancelled)
+        {
+            // A missing or truncated file stays that way; retrying it would read and log it every frame
+            if (load.failed)
+            {
+                texture.failed = true;
+                ++m_stats.loadsFailed;
+            }
+            else
+            {
+                ++m_stats.loadsCancelled;
+            }
+            if (texture.removed)
+            {
+                FreeSlot(load.texture);
+            }
+            return true;
+        }
+
+        const uint64 skipped = texture.mips[firstMip].offset - texture.mips[load.firstMip].offset;
+        Reallocate(texture, firstMip, load.data.data() + skipped);
+        ++m_stats.loadsCompleted;
+        m_stats.bytesRead += load.data.size();
+        m_stats.loadTime += GetElapsed(load.issueTime);
+        return true;
+    }
+
+    void TextureStreamer::UpdateWantedMips()
+    {
+        m_stats.wantedBytes = 0;
+        for (Texture& texture : m_textures)
+        {
+            if (!texture.alive || texture.removed)
+            {
+                continue;
+            }
+
+            const uint32 mipCount = static_cast<uint32>(texture.mips.size());
+            if (texture.requestedMip < mipCount)
+            {
+                texture.wantedMip = std::max(std::min(texture.requestedMip, texture.tailMip), texture.finestMip);
+                texture.lastRequestFrame = m_frame;
+            }
+            else if (m_frame - texture.lastRequestFrame > m_settings.idleFrames)
+            {
+                texture.wantedMip = texture.tailMip;
+            }
+            texture.requestedMip = mipCount;
+            m_stats.wantedBytes += GetSize(texture, texture.wantedMip);
+        }
+    }
+
+    void TextureStreamer::IssueLoads()
+    {
+        std::vector<uint32> candidates;
+        for (uint32 i = 0; i < m_textures.size(); ++i)
+        {
+            const Texture& texture = m_textures[i];
+            if (texture.alive && !texture.removed && !texture.loading && !texture.failed && texture.updatedFrame != m_frame &&
+                texture.wantedMip < texture.residentMip)
+            {
+                candidates.push_back(i);
+            }
+        }
+
+        // Nothing resident first, then the textures missing the most mips, the most recently requested first
+        std::sort(candidates.begin(), candidates.end(), [&](uint32 a, uint32 b)
+        {
+            const Texture& first = m_textures[a];
+            const Texture& second = m_textures[b];
+            const bool firstEmpty = !first.resource.IsValid();
+            const bool secondEmpty = !second.resource.IsValid();
+            if (firstEmpty != secondEmpty)
+            {
+                return firstEmpty;
+            }
+            const uint32 firstMissing = first.residentMip - first.wantedMip;
+            const uint32 secondMissing = second.residentMip - second.wantedMip;
+            if (firstMissing != secondMissing)
+            {
+                return firstMissing > secondMissing;
+            }
+            return first.lastRequestFrame > second.lastRequestFrame;
+        });
+
+        for (uint32 index : candidates)
+        {
+            if (m_stats.pendingLoads >= m_settings.maxPendingLoads)
+            {
+                break;
+            }
+            if (!Issue(index))
+            {
+                ++m_stats.budgetDeferrals;
+            }
+        }
+    }
+
+    bool TextureStreamer::Issue(uint32 index)
+    {
+        Texture& texture = m_textures[index];
+        const RHIFormat format = texture.format;
+        const uint32 endMip = texture.residentMip;
+        const uint64 residentSize = texture.resource.IsValid() ? GetSize(texture, endMip) : 0;
+
+        // A load takes at most half the upload ring so that it can share it, but always at least one mip
+        uint32 firstMip = texture.resource.IsValid() ? texture.wantedMip : texture.tailMip;
+        uint64 uploadBytes = 0;
+        for (uint32 mip = endMip; mip > firstMip; --mip)
+        {
+            const TextureMip& chunk = texture.mips[mip - 1];
+            const uint64 mipBytes = GetUploadMipSize(format, chunk.width, chunk.height) + RHI_TEXTURE_PLACEMENT_ALIGNMENT;
+            if (mip < endMip && uploadBytes + mipBytes > m_settings.uploadBufferSize / 2)
+            {
+                firstMip = mip;
+                break;
+            }
+            uploadBytes += mipBytes;
+        }
+
+        // The tail loads whatever the budget says and alone; finer mips make room or make do with fewer
+        if (texture.resource.IsValid())
+        {
+            const uint64 usedBytes = m_stats.residentBytes + m_reservedBytes;
+            uint64 availableBytes = m_settings.memoryBudget > usedBytes ? m_settings.memoryBudget - usedBytes : 0;
+            const uint64 wantedBytes = GetSize(texture, firstMip) - residentSize;
+            if (wantedBytes > availableBytes)
+            {
+                availableBytes += Evict(wantedBytes - availableBytes, index, texture.lastRequestFrame);
+            }
+            while (firstMip < endMip && GetSize(texture, firstMip) - residentSize > availableBytes)
+            {
+                ++firstMip;
+            }
+            if (firstMip == endMip)
+            {
+                return false;
+            }
+        }
+
+        Load load;
+        load.texture = index;
+        load.firstMip = firstMip;
+        load.endMip = endMip;
+        load.reservedBytes = GetSize(texture, firstMip) - residentSize;
+        load.fileName = texture.fileName;
+        load.offset = texture.dataOffset + texture.mips[firstMip].offset;
+        load.data.resize(static_cast<size_t>(texture.mips[endMip - 1].offset + texture.mips[endMip - 1].size - texture.mips[firstMip].offset));
+        load.issueTime = Clock::now();
+
+        texture.loading = true;
+        m_reservedBytes += load.reservedBytes;
+        ++m_stats.loadsIssued;
+        ++m_stats.pendingLoads;
+        {
+            std::lock_guard<std::mutex> lock(m_ioMutex);
+            m_ioQueue.push_back(std::move(load));
+        }
+        m_ioCondition.notify_one();
+        return true;
+    }
+
+    uint64 TextureStreamer::Evict(uint64 bytes, uint32 requester, uint64 requesterFrame)
+    {
+        // Mips nobody wants go first, then those of textures last requested before the requester
+        std::vector<uint32> candidates;
+        for (uint32 i = 0; i < m_textures.size(); ++i)
+        {
+            const Texture& texture = m_textures[i];
+            if (i == requester || !texture.alive || texture.removed || texture.loading || texture.updatedFrame == m_frame ||
+                !texture.resource.IsValid() || texture.residentMip >= texture.tailMip)
+            {
+                continue;
+            }
+            if (texture.residentMip < texture.wantedMip || texture.lastRequestFrame < requesterFrame)
+            {
+                candidates.push_back(i);
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [&](uint32 a, uint32 b)
+        {
+            const Texture& first = m_textures[a];
+            const Texture& second = m_textures[b];
+            const bool firstSurplus = first.residentMip < first.wantedMip;
+            const bool secondSurplus = second.residentMip < second.wantedMip;
+            if (firstSurplus != secondSurplus)
+            {
+                return firstSurplus;
+            }
+            return first.lastRequestFrame < second.lastRequestFrame;
+        });
+
+        uint64 freedBytes = 0;
+        for (uint32 index : candidates)
+        {
+            if (freedBytes >= bytes)
+            {
+                break;
+            }
+
+            Texture& texture = m_textures[index];
+            const uint64 residentSize = GetSize(texture, texture.residentMip);
+            const uint32 lastMip = texture.lastRequestFrame < requesterFrame ? texture.tailMip : texture.wantedMip;
+            uint32 firstMip = std::min(std::max(texture.residentMip, texture.wantedMip), lastMip);
+            while (firstMip < lastMip && freedBytes + residentSize - GetSize(texture, firstMip) < bytes)
+            {
+                ++firstMip;
+            }
+            if (firstMip == texture.residentMip)
+            {
+                continue;
+            }
+
+            freedBytes += residentSize - GetSize(texture, firstMip);
+            m_stats.evictedMips += firstMip - texture.residentMip;
+            Reallocate(texture, firstMip, nullptr);
+        }
+        return freedBytes;
+    }
+
+    void TextureStreamer::Reallocate(Texture& texture, uint32 firstMip, const byte* loaded)
+    {
+        const uint32 mipCount = static_cast<uint32>(texture.mips.size());
+
+        RHITextureDesc desc;
+        desc.width = texture.mips[firstMip].width;
+        desc.height = texture.mips[firstMip].height;
+        desc.mipLevels = mipCount - firstMip;
+        desc.format = texture.format;
+        desc.usage = RHITextureUsage::ShaderResource;
+        desc.name = texture.fileName;
+        const RHITextureHandle resource = m_device.CreateTexture(desc);
+
+        m_beforeCopies.push_back({ resource, RHIResourceState::Common, RHIResourceState::CopyDest });
+        if (texture.resource.IsValid())
+        {
+            m_beforeCopies.push_back({ texture.resource, RHIResourceState::ShaderResource, RHIResourceState::CopySource });
+        }
+
+        const RHIFormatInfo info = GetFormatInfo(texture.format);
+        for (uint32 mip = firstMip; mip < mipCount; ++mip)
+        {
+            PendingCopy copy;
+            copy.destination = resource;
+            copy.subresource = mip - firstMip;
+            if (mip >= texture.residentMip)
+            {
+                copy.sourceTexture = texture.resource;
+                copy.sourceSubresource = mip - texture.residentMip;
+                m_copies.push_back(copy);
+                continue;
+            }
+
+            // Loaded mips are tightly packed; the copy wants rows at the upload pitch
+            const TextureMip& chunk = texture.mips[mip];
+            const UploadAllocation allocation = m_uploadRing.Allocate(GetUploadMipSize(texture.format, chunk.width, chunk.height),
+                RHI_TEXTURE_PLACEMENT_ALIGNMENT);
+            GINA_ASSERT_MSG(allocation.IsValid(), "Texture streaming upload ring overflow");
+
+            const uint32 rowPitch = GetUploadRowPitch(texture.format, chunk.width);
+            const uint64 rowSize = static_cast<uint64>((chunk.width + info.blockSize - 1) / info.blockSize) * info.bytesPerBlock;
+            const uint32 rowCount = (chunk.height + info.blockSize - 1) / info.blockSize;
+            const byte* source = loaded + (chunk.offset - texture.mips[firstMip].offset);
+            for (uint32 row = 0; row < rowCount; ++row)
+            {
+                std::memcpy(allocation.data + static_cast<uint64>(row) * rowPitch, source + row * rowSize, static_cast<size_t>(rowSize));
+            }
+            m_stats.bytesUploaded += chunk.size;
+
+            copy.uploadOffset = allocation.offset;
+            m_copies.push_back(copy);
+        }
+        m_afterCopies.push_back({ resource, RHIResourceState::CopyDest, RHIResourceState::ShaderResource });
+
+        if (texture.resource.IsValid())
+        {
+            m_stats.residentBytes -= GetSize(texture, texture.residentMip);
+            m_frames.DeferRelease(texture.resource);
+        }
+        m_stats.residentBytes += GetSize(texture, firstMip);
+        m_stats.peakResidentBytes = std::max(m_stats.peakResidentBytes, m_stats.residentBytes);
+
+        texture.resource = resource;
+        texture.residentMip = firstMip;
+        texture.updatedFrame = m_frame;
+    }
+
+    void TextureStreamer::Record(RHICommandList& list)
+    {
+        if (m_copies.empty())
+        {
+            return;
+        }
+
+        list.Barrier(m_beforeCopies.data(), static_cast<uint32>(m_beforeCopies.size()));
+        for (const PendingCopy& copy : m_copies)
+        {
+            if (copy.sourceTexture.IsValid())
+            {
+                list.CopyTexture(copy.destination, copy.subresource, copy.sourceTexture, copy.sourceSubresource);
+            }
+            else
+            {
+                list.CopyBufferToTexture(copy.destination, copy.subresource, m_uploadRing.GetBuffer(), copy.uploadOffset);
+            }
+        }
+        list.Barrier(m_afterCopies.data(), static_cast<uint32>(m_afterCopies.size()));
+
+        m_beforeCopies.clear();
+        m_copies.clear();
+        m_afterCopies.clear();
+    }
+
+    void TextureStreamer::IoLoop()
+    {
+        for (;;)
+        {
+            Load load;
+            {
+                std::unique_lock<std::mutex> lock(m_ioMutex);
+                m_ioCondition.wait(lock, [&]() { return m_stopping || !m_ioQueue.empty(); });
+                if (m_ioQueue.empty())
+                {
+                    return;
+                }
+                load = std::move(m_ioQueue.front());
+                m_ioQueue.pop_front();
+                ++m_reading;
+            }
+
+            std::ifstream file(load.fileName, std::ios::binary);
+            file.seekg(static_cast<std::streamoff>(load.offset));
+            file.read(reinterpret_cast<char*>(load.data.data()), static_cast<std::streamsize>(load.data.size()));
+            load.failed = !file;
+            if (load.failed)
+            {
+                LOG_ERROR("Failed to stream mips of '{}'", load.fileName);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_ioMutex);
+                m_readLoads.push_back(std::move(load));
+                --m_reading;
+            }
+            m_readCondition.notify_all();
+        }
+    }
+
+    RHITextureHandle TextureStreamer::GetTexture(uint32 texture) const
+    {
+        return m_textures[texture].resource;
+    }
+
+    uint32 TextureStreamer::GetResidentMip(uint32 texture) const
+    {
+        return m_textures[texture].residentMip;
+    }
+
+    uint32 TextureStreamer::GetWantedMip(uint32 texture) const
+    {
+        return m_textures[texture].wantedMip;
+    }
+
+    uint32 TextureStreamer::GetMipCount(uint32 texture) const
+    {
+        return static_cast<uint32>(m_textures[texture].mips.size());
+    }
+}
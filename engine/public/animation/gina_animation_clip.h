@@ -0,0 +1,60 @@
+#ifndef _GINA_ANIMATION_CLIP_H_
+#define _GINA_ANIMATION_CLIP_H_
+
+#include <string>
+#include <vector>
+
+#include "core/gina_transform.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    // A marker on a clip's timeline: footstep, effect, sound or gameplay cue, told apart by type
+    struct AnimationEvent
+    {
+        float time = 0.0f;
+        uint32 type = 0;
+        uint32 payload = 0;     // e.g. which foot, or a sound or effect id
+    };
+
+    // Events sorted by time (in insertion order among equal times), so crossed ranges are binary searched
+    struct AnimationEventTrack
+    {
+        std::vector<AnimationEvent> events;
+
+        uint32 GetCount() const noexcept { return static_cast<uint32>(events.size()); }
+        void Add(const AnimationEvent& event);
+
+        // First event at or after time, and first event after it
+        uint32 LowerBound(float time) const noexcept;
+        uint32 UpperBound(float time) const noexcept;
+    };
+
+    struct AnimationClip
+    {
+        std::string name;
+        float duration = 0.0f;
+        float sampleRate = 30.0f;
+        uint32 jointCount = 0;
+
+        // Uniformly sampled local transforms, frame-major: frame f holds joints [f * jointCount, (f + 1) * jointCount).
+        // Joints follow the skeleton order, so sampling a LOD prefix reads the head of each frame.
+        std::vector<Transform> frames;
+
+        AnimationEventTrack events;
+
+        uint32 GetFrameCount() const noexcept { return jointCount > 0 ? static_cast<uint32>(frames.size() / jointCount) : 0; }
+
+        // Reorders joints after SkeletonBuilder sorted the skeleton (newIndices from its sortedIndices output)
+        void RemapJoints(const std::vector<uint16>& newIndices);
+    };
+
+    class AnimationSampler
+    {
+    public:
+        // Samples the first jointCount joints at time (wrapped when looping, clamped otherwise) into local
+        static void Sample(const AnimationClip& clip, float time, bool loop, uint32 jointCount, Transform* local) noexcept;
+    };
+}
+
+#endif // !_GINA_ANIMATION_CLIP_H_
@@ -0,0 +1,73 @@
+#ifndef _GINA_ANIMATION_EVENT_H_
+#define _GINA_ANIMATION_EVENT_H_
+
+#include <vector>
+
+#include "animation/gina_animation_clip.h"
+#include "core/gina_action.h"
+#include "core/gina_thread_pool.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    // A clip advancing from previousTime to currentTime this frame, e.g. one playing layer of a character
+    struct AnimationEventQuery
+    {
+        const AnimationClip* clip = nullptr;
+        float previousTime = 0.0f;
+        float currentTime = 0.0f;
+        bool loop = false;
+        uint32 source = 0;              // handed back with every event, e.g. the character index
+    };
+
+    struct FiredAnimationEvent
+    {
+        AnimationEvent event;
+        float time = 0.0f;              // when it fired on the query's timeline (unwrapped when looping)
+        uint32 source = 0;
+    };
+
+    /**
+     * Events crossed by a frame's queries
+     *
+     * Events are grouped by query in query order, and each group is in playback order (descending
+     * time when playing backwards), whatever the number of threads collecting them. The buffer is
+     * meant to live across frames: clearing keeps its capacity, so steady state collection does not
+     * allocate.
+     */
+    struct AnimationEventBuffer
+    {
+        std::vector<FiredAnimationEvent> events;
+        std::vector<uint32> offsets;    // query q fired events[offsets[q], offsets[q + 1])
+
+        uint32 GetCount() const noexcept { return static_cast<uint32>(events.size()); }
+        void Clear() noexcept;
+    };
+
+    // Subscribers receive every event of a frame in one call and pick the types they handle
+    using AnimationEventAction = Action<const FiredAnimationEvent*, uint32>;
+
+    class AnimationEventSampler
+    {
+    public:
+        // Events crossed going from previousTime to currentTime: times in (previous, current] playing forwards,
+        // [current, previous) backwards. Looping clips take unwrapped times, so wraps and whole cycles fire
+        // their events; otherwise times are clamped to the clip.
+        static uint32 CountEvents(const AnimationClip& clip, float previousTime, float currentTime, bool loop) noexcept;
+
+        // Appends the crossed events of one clip
+        static void CollectEvents(const AnimationClip& clip, float previousTime, float currentTime, bool loop, uint32 source,
+            AnimationEventBuffer& buffer);
+
+        // Replaces the buffer contents with the events of every query. Queries are counted, the counts
+        // prefix summed into offsets and each query writes its own range, so the result is identical with
+        // or without a thread pool.
+        static void CollectBatch(const AnimationEventQuery* queries, uint32 count, AnimationEventBuffer& buffer,
+            ThreadPool* threadPool = nullptr);
+
+        // One invocation with every collected event, skipped when nothing fired
+        static void Dispatch(const AnimationEventBuffer& buffer, AnimationEventAction& action);
+    };
+}
+
+#endif // !_GINA_ANIMATION_EVENT_H_
@@ -0,0 +1,43 @@
+#ifndef _GINA_BLEND_SPACE_H_
+#define _GINA_BLEND_SPACE_H_
+
+#include <vector>
+
+#include "core/gina_math.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    constexpr uint16 INVALID_BLEND_TRIANGLE = 0xFFFF;
+
+    struct BlendSpaceTriangulation
+    {
+        // Three sample indices per triangle, counter-clockwise
+        std::vector<uint16> triangles;
+
+        // Per triangle, the triangle across the edge opposite each of its vertices (INVALID_BLEND_TRIANGLE on the hull)
+        std::vector<uint16> neighbors;
+
+        uint32 GetTriangleCount() const noexcept { return static_cast<uint32>(triangles.size() / 3); }
+    };
+
+    struct BlendSpaceLocation
+    {
+        uint16 triangle = INVALID_BLEND_TRIANGLE;
+        float barycentric[3] = {}; // weights of the triangle's three samples
+    };
+
+    class BlendSpaceTriangulator
+    {
+    public:
+        // Delaunay triangulation of the sample positions; empty when they are fewer than three or collinear
+        static BlendSpaceTriangulation Triangulate(const std::vector<float2>& positions);
+
+        // Walks from startTriangle towards the point (from triangle 0 when invalid). Points outside the
+        // triangulation are clamped to the nearest hull edge, so weights stay continuous everywhere.
+        static BlendSpaceLocation Locate(const BlendSpaceTriangulation& triangulation, const std::vector<float2>& positions,
+            const float2& point, uint16 startTriangle) noexcept;
+    };
+}
+
+#endif // !_GINA_BLEND_SPACE_H_
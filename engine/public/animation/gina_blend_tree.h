@@ -0,0 +1,135 @@
+#ifndef _GINA_BLEND_TREE_H_
+#define _GINA_BLEND_TREE_H_
+
+#include <string>
+#include <vector>
+
+#include "animation/gina_animation_clip.h"
+#include "animation/gina_blend_space.h"
+#include "core/gina_transform.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    constexpr uint16 INVALID_BLEND_NODE = 0xFFFF;
+    constexpr uint16 INVALID_BLEND_PARAMETER = 0xFFFF;
+
+    // Children whose normalized weight falls below this are pruned before sampling
+    constexpr float BLEND_WEIGHT_EPSILON = 1e-3f;
+
+    // Weights of blendspace children live on the stack while compiling
+    constexpr uint32 MAX_BLENDSPACE_SAMPLES = 32;
+
+    enum class BlendNodeType : uint8
+    {
+        Clip,
+        Blend,          // lerp between two children
+        Additive,       // base child plus a weighted additive child
+        Mask,           // base child blended towards an overlay child with per joint weights
+        BlendSpace1D,   // children at sorted positions on one parameter axis
+        BlendSpace2D    // children at positions in a two parameter plane
+    };
+
+    struct BlendNode
+    {
+        BlendNodeType type = BlendNodeType::Clip;
+        std::vector<uint16> children;
+
+        // Clip
+        const AnimationClip* clip = nullptr;
+        float speed = 1.0f;
+        bool loop = true;
+
+        // Blend, additive and mask weight, or the blendspace axes; weight is used when no parameter is bound
+        uint16 parameter = INVALID_BLEND_PARAMETER;
+        uint16 parameterY = INVALID_BLEND_PARAMETER;
+        float weight = 1.0f;
+
+        // Blendspace sample positions, one per child (1D uses x), and the 2D Delaunay triangulation
+        std::vector<float2> positions;
+        BlendSpaceTriangulation triangulation;
+
+        // Mask joint weights, one per skeleton joint
+        std::vector<float> jointWeights;
+    };
+
+    /**
+     * Authoring description of an animation blend tree
+     *
+     * Nodes are added bottom-up and reference their children by index; the last node added is the root
+     * unless SetRoot says otherwise. Clips are referenced, not owned, and must outlive the tree. A tree
+     * is shared by every character using it: per character state is just its parameter values and time.
+     */
+    class BlendTree
+    {
+    public:
+        std::vector<BlendNode> nodes;
+        std::vector<std::string> parameterNames;
+        uint16 root = INVALID_BLEND_NODE;
+
+        uint16 AddParameter(const std::string& name);
+        uint16 FindParameter(const std::string& name) const noexcept;
+        uint32 GetParameterCount() const noexcept { return static_cast<uint32>(parameterNames.size()); }
+
+        uint16 AddClip(const AnimationClip* clip, float speed = 1.0f, bool loop = true);
+        uint16 AddBlend(uint16 a, uint16 b, uint16 parameter);
+        uint16 AddAdditive(uint16 base, uint16 additive, uint16 parameter);
+        uint16 AddMask(uint16 base, uint16 overlay, std::vector<float> jointWeights, uint16 parameter);
+        uint16 AddBlendSpace1D(std::vector<uint16> children, const std::vector<float>& positions, uint16 parameter);
+        uint16 AddBlendSpace2D(std::vector<uint16> children, std::vector<float2> positions, uint16 parameterX, uint16 parameterY);
+
+        void SetRoot(uint16 node) noexcept { root = node; }
+
+    private:
+        uint16 AddNode(BlendNode&& node);
+    };
+
+    enum class BlendOp : uint8
+    {
+        SampleClip,     // push a sampled clip pose
+        Blend,          // pop two, push lerp(below, top, weight)
+        Additive,       // pop two, push below + top * weight
+        Mask            // pop two, push masked lerp(below, top, weight)
+    };
+
+    struct BlendCommand
+    {
+        BlendOp op = BlendOp::SampleClip;
+        uint16 node = INVALID_BLEND_NODE; // clip or mask node
+        float weight = 0.0f;
+    };
+
+    // Post-order pose ops over a stack of scratch poses, rebuilt whenever parameters change. One list
+    // per character: it also remembers where each 2D blendspace lookup ended, to start from there next time.
+    struct BlendCommandList
+    {
+        std::vector<BlendCommand> commands;
+        uint32 maxStackDepth = 0;
+        uint32 sampledClipCount = 0;
+
+        std::vector<uint16> blendSpaceTriangles; // per node
+
+        void Clear() noexcept;
+    };
+
+    class BlendTreeEvaluator
+    {
+    public:
+        // Resolves node weights from parameter values and flattens the active part of the tree into
+        // commands; pruned subtrees emit nothing, so their clips are never sampled
+        static void Compile(const BlendTree& tree, const float* parameters, BlendCommandList& commands);
+
+        // Runs the commands over the first jointCount joints; scratch grows to maxStackDepth poses
+        // once and is reused afterwards
+        static void Execute(const BlendTree& tree, const BlendCommandList& commands, float time, uint32 jointCount,
+            std::vector<Transform>& scratch, Transform* local);
+
+        // Normalized blendspace weights of every child for the given parameter values. In 2D at most the
+        // three samples of the containing triangle are non-zero, or only the first when the samples span no
+        // area; triangle carries the lookup between calls.
+        static void ComputeBlendSpace1DWeights(const BlendNode& node, float x, float* weights) noexcept;
+        static void ComputeBlendSpace2DWeights(const BlendNode& node, const float2& position, uint16& triangle, float* weights) noexcept;
+    };
+}
+
+#endif // !_GINA_BLEND_TREE_H_
@@ -0,0 +1,130 @@
+#ifndef _GINA_IK_H_
+#define _GINA_IK_H_
+
+#include <vector>
+
+#include "animation/gina_skeleton.h"
+#include "core/gina_transform.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    // FABRIK chains are solved in registers; spines and tails stay well below this
+    constexpr uint32 MAX_IK_CHAIN_JOINTS = 16;
+
+    // Instances per SIMD kernel step
+    constexpr uint32 IK_BATCH_WIDTH = 4;
+
+    // Structure-of-arrays float3, one element per solved instance
+    struct IKVectorStream
+    {
+        std::vector<float> x, y, z;
+
+        uint32 GetCount() const noexcept { return static_cast<uint32>(x.size()); }
+        void Resize(uint32 count);
+
+        float3 Get(uint32 index) const noexcept { return float3(x[index], y[index], z[index]); }
+        void Set(uint32 index, const float3& value) noexcept;
+    };
+
+    // Structure-of-arrays quaternions
+    struct IKRotationStream
+    {
+        std::vector<float> x, y, z, w;
+
+        uint32 GetCount() const noexcept { return static_cast<uint32>(x.size()); }
+        void Resize(uint32 count);
+
+        quaternion Get(uint32 index) const noexcept { return quaternion(x[index], y[index], z[index], w[index]); }
+        void Set(uint32 index, const quaternion& value) noexcept;
+    };
+
+    /**
+     * Many instances of the same IK problem in model space
+     *
+     * Callers gather joint positions from each character's model pose, solve the whole batch in one
+     * call, then hand each character's rotation deltas to IKSolver::ApplyRotationDeltas. A delta is a
+     * model space rotation: the joint's new model rotation is delta * old model rotation. Weights blend
+     * every delta from identity, 0 leaving the pose untouched.
+     */
+    struct TwoBoneIKBatch
+    {
+        IKVectorStream root, mid, end;  // e.g. hip, knee and ankle
+        IKVectorStream target;
+        IKVectorStream pole;            // direction the mid joint bends towards
+        std::vector<float> weight;
+
+        IKRotationStream rootDelta, midDelta;
+
+        uint32 GetCount() const noexcept { return root.GetCount(); }
+        void Resize(uint32 count);
+    };
+
+    struct FabrikIKBatch
+    {
+        // Chain joint positions, base first; solved in place. The base never moves.
+        std::vector<IKVectorStream> positions;
+        IKVectorStream target;
+        std::vector<float> weight;
+
+        uint32 maxIterations = 10;
+        float tolerance = 1e-3f;
+
+        // One per chain joint but the last
+        std::vector<IKRotationStream> deltas;
+
+        uint32 GetJointCount() const noexcept { return static_cast<uint32>(positions.size()); }
+        uint32 GetCount() const noexcept { return target.GetCount(); }
+        void Resize(uint32 jointCount, uint32 count);
+    };
+
+    struct LookAtIKBatch
+    {
+        IKVectorStream position;        // aiming joint
+        IKVectorStream forward;         // its current aim direction
+        IKVectorStream target;
+        std::vector<float> weight;
+
+        // Largest rotation applied, e.g. how far a head may turn
+        float maxAngle = PI;
+
+        IKRotationStream delta;
+
+        uint32 GetCount() const noexcept { return position.GetCount(); }
+        void Resize(uint32 count);
+    };
+
+    class IKSolver
+    {
+    public:
+        // Analytic solve in the plane of the root, target and pole; targets out of reach (too far or too
+        // close for the bone lengths) are clamped, leaving the limb fully stretched or folded towards them
+        static void SolveTwoBone(TwoBoneIKBatch& batch) noexcept;
+
+        // Forward and backward reaching until the end is within tolerance or maxIterations ran; chains
+        // that cannot reach straighten towards the target
+        static void SolveFabrik(FabrikIKBatch& batch) noexcept;
+
+        // Shortest rotation of forward towards the target, limited to maxAngle
+        static void SolveLookAt(LookAtIKBatch& batch) noexcept;
+
+        // Kernels over instances [begin, end); the SSE2 ones need the range to be a multiple of IK_BATCH_WIDTH
+        static void SolveTwoBoneScalar(TwoBoneIKBatch& batch, uint32 begin, uint32 end) noexcept;
+        static void SolveFabrikScalar(FabrikIKBatch& batch, uint32 begin, uint32 end) noexcept;
+        static void SolveLookAtScalar(LookAtIKBatch& batch, uint32 begin, uint32 end) noexcept;
+#if defined(GINA_SSE2_ENABLED)
+        static void SolveTwoBoneSSE2(TwoBoneIKBatch& batch, uint32 begin, uint32 end) noexcept;
+        static void SolveFabrikSSE2(FabrikIKBatch& batch, uint32 begin, uint32 end) noexcept;
+        static void SolveLookAtSSE2(LookAtIKBatch& batch, uint32 begin, uint32 end) noexcept;
+#endif
+
+        // Applies model space deltas to joints listed parents first (a joint's parent, if in the list,
+        // comes before it). Local rotations of the listed joints are rewritten; their model rotations and
+        // positions are updated, but other descendants keep stale model transforms until the next
+        // PoseOps::LocalToModel.
+        static void ApplyRotationDeltas(const Skeleton& skeleton, const uint16* joints, const quaternion* deltas, uint32 count,
+            Transform* local, Transform* model) noexcept;
+    };
+}
+
+#endif // !_GINA_IK_H_
@@ -0,0 +1,149 @@
+#ifndef _GINA_MOTION_MATCHING_H_
+#define _GINA_MOTION_MATCHING_H_
+
+#include <vector>
+
+#include "animation/gina_animation_clip.h"
+#include "animation/gina_skeleton.h"
+#include "core/gina_thread_pool.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    constexpr uint32 INVALID_MOTION_ENTRY = 0xFFFFFFFF;
+
+    // Trajectory samples ahead of the current frame
+    constexpr uint32 MOTION_TRAJECTORY_SAMPLES = 3;
+
+    /**
+     * Feature vector layout, in character space (x right, y up, z forward, on the ground under the root):
+     * future root positions (xz), future facing directions (xz), left and right foot positions (xyz)
+     * and left and right foot velocities (xyz)
+     */
+    constexpr uint32 MOTION_TRAJECTORY_POSITION_OFFSET = 0;
+    constexpr uint32 MOTION_TRAJECTORY_DIRECTION_OFFSET = MOTION_TRAJECTORY_POSITION_OFFSET + 2 * MOTION_TRAJECTORY_SAMPLES;
+    constexpr uint32 MOTION_FOOT_POSITION_OFFSET = MOTION_TRAJECTORY_DIRECTION_OFFSET + 2 * MOTION_TRAJECTORY_SAMPLES;
+    constexpr uint32 MOTION_FOOT_VELOCITY_OFFSET = MOTION_FOOT_POSITION_OFFSET + 6;
+    constexpr uint32 MOTION_FEATURE_COUNT = MOTION_FOOT_VELOCITY_OFFSET + 6;
+
+    // Entries are stored in blocks of this many, one AVX2 register per feature
+    constexpr uint32 MOTION_BLOCK_SIZE = 8;
+
+    // Entries per KD-tree leaf
+    constexpr uint32 MOTION_LEAF_SIZE = 64;
+
+    struct MotionClip
+    {
+        const AnimationClip* clip = nullptr;
+        bool loop = false;
+    };
+
+    struct MotionFeatureSettings
+    {
+        uint16 leftFoot = INVALID_JOINT;
+        uint16 rightFoot = INVALID_JOINT;
+        float trajectoryTimes[MOTION_TRAJECTORY_SAMPLES] = { 0.333f, 0.667f, 1.0f };
+
+        // Relative importance of each feature group after normalization
+        float trajectoryPositionWeight = 1.0f;
+        float trajectoryDirectionWeight = 1.5f;
+        float footPositionWeight = 0.75f;
+        float footVelocityWeight = 1.0f;
+    };
+
+    // KD-tree node over a contiguous range of blocks; bounds live in MotionDatabase::nodeBounds
+    struct MotionNode
+    {
+        uint32 firstBlock = 0;
+        uint32 blockCount = 0;
+        uint32 right = INVALID_MOTION_ENTRY; // left child follows its parent; leaves have no right child
+    };
+
+    /**
+     * Normalized motion features of every searchable clip frame
+     *
+     * Features are stored as a structure of arrays in blocks of MOTION_BLOCK_SIZE entries: feature d of
+     * entry e is features[(e / 8 * MOTION_FEATURE_COUNT + d) * 8 + e % 8]. Entries are ordered by the
+     * KD-tree, every leaf starts a new block and the unused lanes are padded with far away values, so
+     * kernels never look at entry counts. Normalization subtracts the mean of each feature and divides
+     * each group by its standard deviation before applying the group weight.
+     */
+    struct MotionDatabase
+    {
+        std::vector<float> features;
+        std::vector<uint32> entryClips;     // per stored entry, INVALID_MOTION_ENTRY for padding
+        std::vector<uint32> entryFrames;
+        uint32 entryCount = 0;
+
+        std::vector<float> offsets;         // raw feature - offset, times scale
+        std::vector<float> scales;
+
+        std::vector<MotionNode> nodes;
+        std::vector<float> nodeBounds;      // per node, MOTION_FEATURE_COUNT minimums then as many maximums
+
+        uint32 GetBlockCount() const noexcept { return static_cast<uint32>(entryClips.size() / MOTION_BLOCK_SIZE); }
+        const float* GetBlock(uint32 block) const noexcept { return &features[block * MOTION_FEATURE_COUNT * MOTION_BLOCK_SIZE]; }
+
+        void Normalize(const float* raw, float* normalized) const noexcept;
+    };
+
+    struct MotionMatch
+    {
+        uint32 entry = INVALID_MOTION_ENTRY; // stored entry index
+        uint32 clip = INVALID_MOTION_ENTRY;
+        uint32 frame = 0;
+        float cost = 0.0f;
+    };
+
+    class MotionDatabaseBuilder
+    {
+    public:
+        // Every frame of every clip whose trajectory samples stay inside the clip (any frame when looping)
+        static MotionDatabase Build(const Skeleton& skeleton, const std::vector<MotionClip>& clips, const MotionFeatureSettings& settings);
+
+        // From raw feature rows (MOTION_FEATURE_COUNT floats each) with their clip and frame
+        static MotionDatabase Build(const std::vector<float>& rawFeatures, const std::vector<uint32>& clips,
+            const std::vector<uint32>& frames, const MotionFeatureSettings& settings);
+
+        // Raw features of one clip frame; false when a trajectory sample falls past the end of a clip that does not loop
+        static bool ExtractFeatures(const Skeleton& skeleton, const MotionClip& clip, uint32 frame,
+            const MotionFeatureSettings& settings, std::vector<Transform>& scratch, float* features);
+    };
+
+    namespace detail
+    {
+        struct MotionMatchingDispatch
+        {
+            using SearchBlocksFunc = void(*)(const MotionDatabase&, const float*, uint32, uint32, MotionMatch&);
+
+            static SearchBlocksFunc searchBlocksImpl;
+
+            static void initialize() noexcept;
+            static void useScalar() noexcept;
+            static void useAVX2() noexcept;
+
+        private:
+            static bool initialized;
+        };
+    }
+
+    class MotionMatcher
+    {
+    public:
+        // Nearest entry to a normalized query. With the tree, subtrees whose bounds are farther than the
+        // best match so far are skipped; the result is the same as the exhaustive search.
+        static MotionMatch Search(const MotionDatabase& database, const float* query, bool useTree = true) noexcept;
+
+        static void SearchBatch(const MotionDatabase& database, const float* queries, uint32 queryCount, MotionMatch* results,
+            bool useTree = true, ThreadPool* threadPool = nullptr);
+
+        // Kernels over blocks [first, first + count); they only replace best with strictly closer entries and
+        // stop accumulating a block once every lane is already farther than best
+        static void SearchBlocksScalar(const MotionDatabase& database, const float* query, uint32 first, uint32 count, MotionMatch& best) noexcept;
+#if defined(GINA_SSE2_ENABLED)
+        static void SearchBlocksAVX2(const MotionDatabase& database, const float* query, uint32 first, uint32 count, MotionMatch& best) noexcept;
+#endif
+    };
+}
+
+#endif // !_GINA_MOTION_MATCHING_H_
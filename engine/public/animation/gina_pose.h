@@ -0,0 +1,54 @@
+#ifndef _GINA_POSE_H_
+#define _GINA_POSE_H_
+
+#include <vector>
+
+#include "animation/gina_skeleton.h"
+#include "core/gina_transform.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    // Structure-of-arrays local pose, one element per joint, for passes that run joints in SIMD lanes
+    struct PoseStreams
+    {
+        std::vector<float> rotationX, rotationY, rotationZ, rotationW;
+        std::vector<float> translationX, translationY, translationZ;
+        std::vector<float> scaleX, scaleY, scaleZ;
+
+        uint32 GetJointCount() const noexcept { return static_cast<uint32>(rotationX.size()); }
+        void Resize(uint32 jointCount);
+
+        Transform Get(uint32 joint) const noexcept;
+        void Set(uint32 joint, const Transform& transform) noexcept;
+    };
+
+    // Pose passes over the first jointCount joints of a skeleton, i.e. a LOD prefix
+    class PoseOps
+    {
+    public:
+        static void Blend(const Transform* a, const Transform* b, float weight, uint32 jointCount, Transform* result) noexcept;
+
+        // Blend with the weight scaled per joint, e.g. an upper body mask
+        static void BlendMasked(const Transform* a, const Transform* b, float weight, const float* jointWeights,
+            uint32 jointCount, Transform* result) noexcept;
+
+        // Difference of pose from reference, such that Add(reference, delta, 1) reproduces pose
+        static void MakeAdditive(const Transform* reference, const Transform* pose, uint32 jointCount, Transform* delta) noexcept;
+
+        // Applies an additive delta on top of base, scaled by weight
+        static void Add(const Transform* base, const Transform* delta, float weight, uint32 jointCount, Transform* result) noexcept;
+
+        static void LocalToModel(const Skeleton& skeleton, const Transform* local, uint32 jointCount, Transform* model) noexcept;
+
+        // Fills model transforms of joints culled by a LOD from their nearest kept ancestor, rigidly
+        // attached in bind pose, for consumers that need every joint (attachments, IK targets)
+        static void FillCulledJoints(const Skeleton& skeleton, uint32 lod, Transform* model) noexcept;
+
+        // Conversions between transforms and streams, which must hold at least jointCount joints
+        static void ToStreams(const Transform* pose, uint32 jointCount, PoseStreams& streams) noexcept;
+        static void FromStreams(const PoseStreams& streams, uint32 jointCount, Transform* pose) noexcept;
+    };
+}
+
+#endif // !_GINA_POSE_H_
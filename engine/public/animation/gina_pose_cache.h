@@ -0,0 +1,134 @@
+#ifndef _GINA_POSE_CACHE_H_
+#define _GINA_POSE_CACHE_H_
+
+#include <vector>
+
+#include "animation/gina_animation_clip.h"
+#include "animation/gina_skeleton.h"
+#include "core/gina_thread_pool.h"
+#include "core/gina_transform.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    using PoseHandle = uint32;
+    constexpr PoseHandle INVALID_POSE_HANDLE = 0xFFFFFFFF;
+
+    struct PoseCacheSettings
+    {
+        // Requested times snap to multiples of this many seconds so nearby instances share a pose; 0 keeps exact times
+        float timeQuantum = 1.0f / 60.0f;
+
+        // Reduced rate update: instances evaluate every updateInterval frames, staggered, and interpolate in between
+        uint32 updateInterval = 1;
+    };
+
+    /**
+     * Per instance state of the reduced rate update
+     *
+     * On its update frames an instance evaluates the pose it will have when it next updates, so the
+     * frames in between interpolate towards where the animation is going rather than lagging behind it.
+     * Poses are model space, so interpolated frames skip the local to model pass as well.
+     */
+    struct ReducedRatePose
+    {
+        std::vector<Transform> from;    // model pose at the last update
+        std::vector<Transform> to;      // model pose expected at the next update
+        uint32 framesSinceUpdate = 0;
+    };
+
+    /**
+     * Poses shared by every instance playing the same clip at the same quantized time and LOD this frame
+     *
+     * A frame requests the poses of all instances, evaluates each distinct (clip, quantized time,
+     * LOD) once, sampled and converted to model space, then hands every instance a pointer to its
+     * shared pose. Poses stay valid until the next BeginFrame, which keeps the storage so steady state
+     * frames do not allocate.
+     */
+    class PoseCache
+    {
+    public:
+        explicit PoseCache(const Skeleton& skeleton, const PoseCacheSettings& settings = {});
+
+        const PoseCacheSettings& GetSettings() const noexcept { return m_settings; }
+
+        // Drops the previous frame's poses and advances the frame counter staggering reduced rate updates
+        void BeginFrame();
+
+        PoseHandle Request(const AnimationClip& clip, float time, bool loop, uint32 lod);
+
+        // Samples every distinct requested pose, spread over the thread pool when given
+        void Evaluate(ThreadPool* threadPool = nullptr);
+
+        const Transform* GetLocalPose(PoseHandle handle) const noexcept;
+        const Transform* GetModelPose(PoseHandle handle) const noexcept;
+        uint32 GetPoseJointCount(PoseHandle handle) const noexcept { return m_poses[handle].jointCount; }
+
+        // Whether an instance evaluates this frame under the reduced rate update; 1 / updateInterval of instances do
+        bool IsUpdateFrame(uint32 instance) const noexcept;
+
+        // Reduced rate update of one instance playing clip at time, advancing by deltaTime a frame. On update
+        // frames it requests the pose due at the next update and returns the handle; otherwise it returns
+        // INVALID_POSE_HANDLE and nothing needs evaluating. Instances without a pose yet update at once and
+        // settle into their staggered slot from their next update.
+        PoseHandle RequestReducedRate(const ReducedRatePose& state, uint32 instance, const AnimationClip& clip, float time,
+            float deltaTime, bool loop, uint32 lod);
+
+        // After Evaluate, writes the instance's model pose: the start of its interpolation on update frames
+        // (taking the evaluated pose as the next target) and the interpolated pose on the frames between
+        void ResolveReducedRate(ReducedRatePose& state, PoseHandle handle, Transform* model) const;
+
+        uint32 GetRequestCount() const noexcept { return m_requestCount; }
+        uint32 GetEvaluatedCount() const noexcept { return static_cast<uint32>(m_poses.size()); }
+
+    private:
+        struct Key
+        {
+            const AnimationClip* clip;
+            uint32 time;                // quantization step, or the time's bits without quantization
+            uint16 jointCount;
+            bool loop;
+
+            bool operator==(const Key& other) const noexcept
+            {
+                return clip == other.clip && time == other.time && jointCount == other.jointCount && loop == other.loop;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const noexcept;
+        };
+
+        // Open addressing slot; empty unless stamped with the current frame, so BeginFrame clears nothing
+        struct LookupSlot
+        {
+            Key key;
+            PoseHandle handle;
+            uint32 frame;
+        };
+
+        struct CachedPose
+        {
+            const AnimationClip* clip;
+            float time;
+            bool loop;
+            uint32 jointCount;
+            uint32 offset;              // into m_local and m_model
+        };
+
+        void GrowLookup();
+
+        const Skeleton* m_skeleton = nullptr;
+        PoseCacheSettings m_settings;
+        uint32 m_frame = 0;
+        uint32 m_requestCount = 0;
+
+        std::vector<LookupSlot> m_lookup;   // power of two size, at most half full
+        std::vector<CachedPose> m_poses;
+        std::vector<Transform> m_local;
+        std::vector<Transform> m_model;
+    };
+}
+
+#endif // !_GINA_POSE_CACHE_H_
@@ -0,0 +1,95 @@
+#ifndef _GINA_RETARGET_H_
+#define _GINA_RETARGET_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "animation/gina_pose.h"
+#include "animation/gina_skeleton.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    // Target joints per SIMD kernel step
+    constexpr uint32 RETARGET_BATCH_WIDTH = 4;
+
+    struct RetargetSettings
+    {
+        // Explicit (target joint, source joint) names, taking precedence over matching
+        std::vector<std::pair<std::string, std::string>> jointPairs;
+
+        // Pair remaining joints whose names are equal ignoring case and any "namespace:" or "path|" prefix
+        bool matchNames = true;
+    };
+
+    // Source joints collapsed into one target joint, e.g. two source spine joints driving a single target spine
+    struct RetargetChain
+    {
+        uint32 firstJoint = 0;          // into RetargetMap::chainJoints, listed parents first
+        uint32 jointCount = 0;
+    };
+
+    /**
+     * Precomputed mapping from a source skeleton's local pose to a target skeleton's
+     *
+     * Every target joint reads one source slot: a source joint, a chain slot holding the combined
+     * rotation of a collapsed source chain, or the identity slot for unmapped joints. Its rotation is
+     * pre * slot * post, where the corrections move the slot rotation from the source bind frames into
+     * the target's, and its translation is the target bind translation plus the source's offset from
+     * its own bind translation, rotated by pre and scaled by the bone length ratio. Unmapped joints
+     * have pre set to their bind rotation and a zero scale, so they hold their bind pose without a
+     * branch. All tables are per target joint in structure-of-arrays layout.
+     */
+    struct RetargetMap
+    {
+        uint32 sourceJointCount = 0;
+        uint32 targetJointCount = 0;
+
+        std::vector<uint32> sourceSlots;
+        std::vector<float> preX, preY, preZ, preW;
+        std::vector<float> postX, postY, postZ, postW;
+        std::vector<float> bindTranslationX, bindTranslationY, bindTranslationZ;
+        std::vector<float> sourceBindTranslationX, sourceBindTranslationY, sourceBindTranslationZ;
+        std::vector<float> translationScale;
+        std::vector<float> bindScaleX, bindScaleY, bindScaleZ;
+
+        std::vector<RetargetChain> chains;
+        std::vector<uint16> chainJoints;
+
+        // Source pose streams handed to the retargeter hold the source joints followed by the chain and identity slots
+        uint32 GetSourceSlotCount() const noexcept { return sourceJointCount + static_cast<uint32>(chains.size()) + 1; }
+        uint32 GetIdentitySlot() const noexcept { return GetSourceSlotCount() - 1; }
+
+        // Target joints paired with a source joint
+        uint32 GetMappedJointCount() const noexcept;
+        size_t GetMemoryUsage() const noexcept;
+    };
+
+    class RetargetMapBuilder
+    {
+    public:
+        // Target joints whose pair is not below the source joint of their nearest mapped ancestor are
+        // left unmapped, as the hierarchies disagree there
+        static RetargetMap Build(const Skeleton& source, const Skeleton& target, const RetargetSettings& settings = {});
+    };
+
+    class Retargeter
+    {
+    public:
+        // Source streams must hold GetSourceSlotCount() joints with the source local pose in the first
+        // sourceJointCount; the remaining slots are filled here. Target streams are resized to the target.
+        static void Retarget(const RetargetMap& map, PoseStreams& source, PoseStreams& target) noexcept;
+
+        // Kernels over target joints [begin, end) once the slots are filled; the SSE2 one needs the range to
+        // be a multiple of RETARGET_BATCH_WIDTH
+        static void RetargetScalar(const RetargetMap& map, const PoseStreams& source, PoseStreams& target, uint32 begin, uint32 end) noexcept;
+#if defined(GINA_SSE2_ENABLED)
+        static void RetargetSSE2(const RetargetMap& map, const PoseStreams& source, PoseStreams& target, uint32 begin, uint32 end) noexcept;
+#endif
+
+        static void FillSlots(const RetargetMap& map, PoseStreams& source) noexcept;
+    };
+}
+
+#endif // !_GINA_RETARGET_H_
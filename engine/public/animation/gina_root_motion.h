@@ -0,0 +1,80 @@
+#ifndef _GINA_ROOT_MOTION_H_
+#define _GINA_ROOT_MOTION_H_
+
+#include <string>
+#include <vector>
+
+#include "animation/gina_animation_clip.h"
+#include "core/gina_transform.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    struct RootMotionSettings
+    {
+        uint16 rootJoint = 0;           // its local transform is the movement, so any parents must stay still
+        bool extractVertical = false;   // keep height in the pose unless the clip climbs or jumps
+        bool removeFromClip = true;     // leave the clip playing in place, facing +z
+    };
+
+    // Root movement between two times, expressed in the character's frame (y up, facing +z) at the first
+    struct RootMotionDelta
+    {
+        float3 translation;
+        float yaw = 0.0f;               // radians about +y
+    };
+
+    /**
+     * Root translation and yaw of a clip, one sample per frame, apart from the pose
+     *
+     * Positions and unwrapped yaws are accumulated from the first frame: each sample is the prefix sum
+     * of the per-frame displacements before it. The root delta between any two times is then the
+     * difference of two interpolated samples, rotated into the frame at the first time, whatever the
+     * skeleton size or the distance between the times.
+     */
+    struct RootMotionTrack
+    {
+        std::string name;
+        float duration = 0.0f;
+        float sampleRate = 30.0f;
+
+        std::vector<float3> positions;  // world displacement since frame 0
+        std::vector<float> yaws;        // unwrapped rotation about +y since frame 0
+
+        uint32 GetFrameCount() const noexcept { return static_cast<uint32>(positions.size()); }
+
+        // Accumulated displacement and yaw at a time clamped to the clip
+        void Sample(float time, float3& position, float& yaw) const noexcept;
+
+        // Root movement from startTime to endTime. Looping tracks take unwrapped times, so wraps and
+        // whole cycles are accumulated (endTime before startTime plays backwards); otherwise times are clamped.
+        RootMotionDelta GetDelta(float startTime, float endTime, bool loop) const noexcept;
+    };
+
+    struct RootMotionQuery
+    {
+        const RootMotionTrack* track = nullptr;
+        float startTime = 0.0f;
+        float endTime = 0.0f;
+        bool loop = false;
+    };
+
+    class RootMotionExtractor
+    {
+    public:
+        // Moves the root's ground translation and yaw (and height with extractVertical) into a track
+        static RootMotionTrack Extract(AnimationClip& clip, const RootMotionSettings& settings = {});
+    };
+
+    class RootMotionSampler
+    {
+    public:
+        // One delta per query, e.g. every character advancing its clip this tick
+        static void GetDeltas(const RootMotionQuery* queries, uint32 count, RootMotionDelta* deltas) noexcept;
+
+        // Moves a character transform by a delta in its own frame
+        static void Accumulate(Transform& character, const RootMotionDelta& delta) noexcept;
+    };
+}
+
+#endif // !_GINA_ROOT_MOTION_H_
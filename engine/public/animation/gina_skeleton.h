@@ -0,0 +1,79 @@
+#ifndef _GINA_SKELETON_H_
+#define _GINA_SKELETON_H_
+
+#include <string>
+#include <vector>
+
+#include "core/gina_transform.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    constexpr uint16 INVALID_JOINT = 0xFFFF;
+    constexpr uint32 MAX_SKELETON_JOINTS = INVALID_JOINT;
+
+    struct SkeletonLod
+    {
+        uint16 jointCount = 0;
+        float error = 0.0f; // importance of the most important culled joint, in object space units
+    };
+
+    /**
+     * Joint hierarchy sorted by descending importance
+     *
+     * A joint's importance never exceeds its parent's, so parents always precede their children and
+     * any prefix of the joint array is a complete hierarchy. A LOD level is therefore just a joint
+     * count: sampling, blending and local-to-model passes run over the first GetLodJointCount(lod)
+     * joints only, and skinning maps the culled joints to their nearest kept ancestor.
+     */
+    class Skeleton
+    {
+    public:
+        std::vector<std::string> jointNames;
+        std::vector<uint16> parents;
+        std::vector<Transform> bindPose; // local space
+        std::vector<float> importance;
+
+        // lods[0] keeps every joint; coarser levels keep shorter prefixes
+        std::vector<SkeletonLod> lods;
+
+        // For every LOD, each joint's nearest kept ancestor (or itself when kept), GetJointCount() entries per LOD
+        std::vector<uint16> lodRemap;
+
+        uint32 GetJointCount() const noexcept { return static_cast<uint32>(parents.size()); }
+        uint32 GetLodCount() const noexcept { return static_cast<uint32>(lods.size()); }
+        uint32 GetLodJointCount(uint32 lod) const noexcept { return lods[lod].jointCount; }
+        const uint16* GetLodRemap(uint32 lod) const noexcept { return &lodRemap[lod * GetJointCount()]; }
+
+        uint16 FindJoint(const std::string& name) const noexcept;
+
+        // Coarsest LOD whose error projects to at most maxPixelError pixels (see MeshLodBuilder::ComputeProjectionScale)
+        uint32 SelectLod(float distance, float projectionScale, float maxPixelError = 1.0f) const noexcept;
+    };
+
+    struct SkeletonJointDesc
+    {
+        std::string name;
+        uint16 parent = INVALID_JOINT;
+        Transform bindPose;
+    };
+
+    struct SkeletonBuildSettings
+    {
+        // Each coarser LOD culls the joints whose importance is below this fraction of the root's
+        std::vector<float> lodThresholds = { 0.05f, 0.15f, 0.3f };
+    };
+
+    class SkeletonBuilder
+    {
+    public:
+        // Joints must list parents before children. sortedIndices, when given, receives the new index
+        // of every input joint so clips and meshes authored against the input order can be remapped.
+        static Skeleton Build(const std::vector<SkeletonJointDesc>& joints, const SkeletonBuildSettings& settings = {},
+            std::vector<uint16>* sortedIndices = nullptr);
+
+        static std::vector<float> ComputeImportance(const std::vector<SkeletonJointDesc>& joints);
+    };
+}
+
+#endif // !_GINA_SKELETON_H_
@@ -0,0 +1,118 @@
+#ifndef _GINA_SKINNING_H_
+#define _GINA_SKINNING_H_
+
+#include <vector>
+
+#include "animation/gina_skeleton.h"
+#include "mesh/gina_mesh.h"
+#include "core/gina_thread_pool.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    // Packed joint indices are 8 bits each, so a skinned mesh addresses at most this many palette entries
+    constexpr uint32 MAX_SKINNING_JOINTS = 256;
+
+    // Vertices per worker task; a multiple of the widest kernel batch
+    constexpr uint32 SKINNING_BATCH_SIZE = 1024;
+
+    // Structure-of-arrays vertex positions and, optionally, normals
+    struct VertexStreams
+    {
+        std::vector<float> positionX, positionY, positionZ;
+        std::vector<float> normalX, normalY, normalZ;
+
+        uint32 GetVertexCount() const noexcept { return static_cast<uint32>(positionX.size()); }
+        bool HasNormals() const noexcept { return !normalX.empty(); }
+
+        void Resize(uint32 vertexCount, bool normals);
+    };
+
+    struct SkinningData
+    {
+        VertexStreams bindVertices;
+
+        // Four 8-bit skeleton joint indices per vertex, influence i in bits [8i, 8i + 8)
+        std::vector<uint32> joints;
+
+        // Four 8-bit unorm weights per vertex, laid out like joints and summing to exactly 255
+        std::vector<uint32> weights;
+
+        // Which palette the mesh is skinned with, from the mesh asset
+        SkinningMode mode = SkinningMode::Linear;
+
+        uint32 GetVertexCount() const noexcept { return bindVertices.GetVertexCount(); }
+
+        // Converts mesh skinning (mesh-local joint names) to skeleton joint indices; influences on
+        // joints missing from the skeleton are dropped and the remaining weights renormalized
+        static SkinningData FromMesh(const Mesh& mesh, const Skeleton& skeleton, SkinningMode mode = SkinningMode::Linear);
+
+        static uint32 PackWeights(const float* weights) noexcept;
+    };
+
+    namespace detail
+    {
+        struct SkinningDispatch
+        {
+            using SkinFunc = void(*)(const SkinningData&, const float3x4*, VertexStreams&, uint32, uint32);
+            using SkinDualQuaternionFunc = void(*)(const SkinningData&, const dualquaternion*, VertexStreams&, uint32, uint32);
+            using ConvertPaletteFunc = void(*)(const Transform*, const Transform*, uint32, dualquaternion*);
+
+            static SkinFunc skinImpl;
+            static SkinDualQuaternionFunc skinDualQuaternionImpl;
+            static ConvertPaletteFunc convertPaletteImpl;
+
+            static void initialize() noexcept;
+            static void useScalar() noexcept;
+            static void useSSE2() noexcept;
+            static void useAVX2() noexcept;
+
+        private:
+            static bool initialized;
+        };
+    }
+
+    class Skinning
+    {
+    public:
+        // Inverse of each joint's model space bind transform
+        static std::vector<float3x4> ComputeInverseBindMatrices(const Skeleton& skeleton);
+
+        // Palette of model * inverseBind per joint; joints culled by the LOD reuse their nearest kept ancestor's entry
+        static void BuildPalette(const Skeleton& skeleton, const std::vector<float3x4>& inverseBind,
+            const Transform* model, uint32 lod, float3x4* palette) noexcept;
+
+        // Inverse of each joint's model space bind transform, for dual quaternion palettes
+        static std::vector<Transform> ComputeInverseBindTransforms(const Skeleton& skeleton);
+
+        // Dual quaternion palette of model * inverseBind per joint, with the same LOD remap as BuildPalette.
+        // Joint scale is ignored: dual quaternions only represent rigid transforms.
+        static void BuildDualQuaternionPalette(const Skeleton& skeleton, const std::vector<Transform>& inverseBind,
+            const Transform* model, uint32 lod, dualquaternion* palette) noexcept;
+
+        // Skins every vertex with the best kernel for this CPU, split across the pool's workers when given
+        static void Skin(const SkinningData& data, const float3x4* palette, VertexStreams& output, ThreadPool* threadPool = nullptr);
+        static void Skin(const SkinningData& data, const dualquaternion* palette, VertexStreams& output, ThreadPool* threadPool = nullptr);
+
+        // Palette conversion over joints [0, count)
+        static void ConvertPaletteScalar(const Transform* inverseBind, const Transform* model, uint32 count, dualquaternion* palette) noexcept;
+#if defined(GINA_SSE2_ENABLED)
+        static void ConvertPaletteSSE2(const Transform* inverseBind, const Transform* model, uint32 count, dualquaternion* palette) noexcept;
+#endif
+
+        // Kernels over vertices [begin, end); output must already be sized like the bind vertices
+        static void SkinScalar(const SkinningData& data, const float3x4* palette, VertexStreams& output, uint32 begin, uint32 end) noexcept;
+#if defined(GINA_SSE2_ENABLED)
+        static void SkinSSE2(const SkinningData& data, const float3x4* palette, VertexStreams& output, uint32 begin, uint32 end) noexcept;
+        static void SkinAVX2(const SkinningData& data, const float3x4* palette, VertexStreams& output, uint32 begin, uint32 end) noexcept;
+#endif
+
+        static void SkinDualQuaternionScalar(const SkinningData& data, const dualquaternion* palette, VertexStreams& output, uint32 begin, uint32 end) noexcept;
+#if defined(GINA_SSE2_ENABLED)
+        static void SkinDualQuaternionSSE2(const SkinningData& data, const dualquaternion* palette, VertexStreams& output, uint32 begin, uint32 end) noexcept;
+        static void SkinDualQuaternionAVX2(const SkinningData& data, const dualquaternion* palette, VertexStreams& output, uint32 begin, uint32 end) noexcept;
+#endif
+    };
+}
+
+#endif // !_GINA_SKINNING_H_
@@ -0,0 +1,167 @@
+#ifndef _GINA_STATE_MACHINE_H_
+#define _GINA_STATE_MACHINE_H_
+
+#include <string>
+#include <vector>
+
+#include "animation/gina_blend_tree.h"
+#include "core/gina_transform.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    constexpr uint16 INVALID_ANIMATION_STATE = 0xFFFF;
+    constexpr uint16 INVALID_ANIMATION_TRANSITION = 0xFFFF;
+    constexpr uint16 INVALID_STATE_PARAMETER = 0xFFFF;
+
+    // Transition source that matches whichever state is current
+    constexpr uint16 ANY_ANIMATION_STATE = 0xFFFE;
+
+    enum class TransitionCompare : uint8
+    {
+        Greater,
+        GreaterEqual,
+        Less,
+        LessEqual,
+        Equal,
+        NotEqual
+    };
+
+    enum class CrossFadeCurve : uint8
+    {
+        Linear,
+        SmoothStep,
+        EaseIn,
+        EaseOut
+    };
+
+    struct TransitionCondition
+    {
+        uint16 parameter = INVALID_STATE_PARAMETER;
+        TransitionCompare compare = TransitionCompare::Greater;
+        float threshold = 0.0f;
+    };
+
+    struct AnimationTransition
+    {
+        uint16 from = INVALID_ANIMATION_STATE;
+        uint16 to = INVALID_ANIMATION_STATE;
+        float duration = 0.0f;
+        CrossFadeCurve curve = CrossFadeCurve::Linear;
+
+        // Range of StateMachine::conditions that must all hold. Without conditions the transition fires
+        // as soon as its source state is entered.
+        uint32 firstCondition = 0;
+        uint32 conditionCount = 0;
+    };
+
+    // Transition that has to be re-evaluated when parameter changes
+    struct TransitionWatch
+    {
+        uint16 parameter = INVALID_STATE_PARAMETER;
+        uint16 transition = INVALID_ANIMATION_TRANSITION;
+    };
+
+    struct AnimationState
+    {
+        std::string name;
+        const BlendTree* tree = nullptr;
+
+        // Machine parameter feeding each blend tree parameter, matched by name
+        std::vector<uint16> parameterMap;
+
+        // Outgoing transitions in priority order, and the same transitions indexed by the parameters they read
+        std::vector<uint16> transitions;
+        std::vector<TransitionWatch> watches;
+    };
+
+    /**
+     * Authoring description of an animation state machine
+     *
+     * States play blend trees; transitions between them cross-fade over a duration along a curve once
+     * their conditions on the machine parameters hold. Blend tree parameters are machine parameters of
+     * the same name, created on demand. Like blend trees, a machine is shared by every character using
+     * it and must outlive them; per character state lives in StateMachineInstance.
+     */
+    class StateMachine
+    {
+    public:
+        std::vector<AnimationState> states;
+        std::vector<AnimationTransition> transitions;
+        std::vector<TransitionCondition> conditions; // grouped by transition, in transition order
+        std::vector<std::string> parameterNames;
+        uint16 defaultState = INVALID_ANIMATION_STATE;
+
+        // Transitions from ANY_ANIMATION_STATE, checked before those of the current state
+        std::vector<uint16> anyStateTransitions;
+        std::vector<TransitionWatch> anyStateWatches;
+
+        uint16 AddParameter(const std::string& name);
+        uint16 FindParameter(const std::string& name) const noexcept;
+        uint32 GetParameterCount() const noexcept { return static_cast<uint32>(parameterNames.size()); }
+
+        // The first state added is the default state
+        uint16 AddState(const std::string& name, const BlendTree* tree);
+        uint16 FindState(const std::string& name) const noexcept;
+
+        uint16 AddTransition(uint16 from, uint16 to, float duration, CrossFadeCurve curve = CrossFadeCurve::Linear);
+        void AddCondition(uint16 transition, uint16 parameter, TransitionCompare compare, float threshold);
+
+        void SetDefaultState(uint16 state) noexcept { defaultState = state; }
+    };
+
+    /**
+     * Per character state machine state
+     *
+     * SetParameter only records the value and marks the parameter dirty; the next Update looks at the
+     * transitions watching dirty parameters and nothing else. Its signature fits Action<uint16, float>,
+     * so an instance can subscribe to a gameplay action directly; crowds batch their changes by calling
+     * it in a loop before updating.
+     */
+    struct StateMachineInstance
+    {
+        const StateMachine* machine = nullptr;
+        std::vector<float> parameters;
+        std::vector<uint16> dirtyParameters;
+        std::vector<uint8> dirtyFlags;
+
+        uint16 currentState = INVALID_ANIMATION_STATE;
+        float currentTime = 0.0f;
+
+        // Cross-fade from the previous state; INVALID_ANIMATION_STATE when not fading
+        uint16 previousState = INVALID_ANIMATION_STATE;
+        float previousTime = 0.0f;
+        float fadeTime = 0.0f;
+        uint16 fadeTransition = INVALID_ANIMATION_TRANSITION;
+
+        // Entering a state checks all of its transitions once, whatever changed
+        bool stateEntered = false;
+
+        // Current and previous state commands, swapped when a transition starts; pose scratch for both
+        BlendCommandList commands[2];
+        std::vector<float> treeParameters;
+        std::vector<Transform> scratch;
+        std::vector<Transform> fadePose;
+
+        void Initialize(const StateMachine& stateMachine);
+        void SetParameter(uint16 parameter, float value);
+        float GetParameter(uint16 parameter) const noexcept { return parameters[parameter]; }
+        bool IsFading() const noexcept { return previousState != INVALID_ANIMATION_STATE; }
+    };
+
+    class StateMachineEvaluator
+    {
+    public:
+        // Advances time and fades, then starts at most one transition whose conditions were affected by a
+        // parameter change since the last update. Returns the transition taken or INVALID_ANIMATION_TRANSITION.
+        static uint16 Update(StateMachineInstance& instance, float deltaTime);
+
+        // Current pose of the first jointCount joints, cross-faded from the previous state while fading
+        static void Evaluate(StateMachineInstance& instance, uint32 jointCount, Transform* local);
+
+        static bool IsSatisfied(const StateMachine& machine, uint16 transition, const float* parameters) noexcept;
+        static float EvaluateCurve(CrossFadeCurve curve, float t) noexcept;
+    };
+}
+
+#endif // !_GINA_STATE_MACHINE_H_
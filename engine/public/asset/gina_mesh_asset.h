@@ -0,0 +1,43 @@
+#ifndef _GINA_MESH_ASSET_H_
+#define _GINA_MESH_ASSET_H_
+
+#include <string>
+#include <vector>
+
+#include "mesh/gina_mesh.h"
+#include "mesh/gina_mesh_lod.h"
+#include "mesh/gina_meshlet.h"
+#include "core/gina_binary_stream.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    constexpr uint32 MESH_ASSET_MAGIC = 0x48534D47; // "GMSH"
+    constexpr uint32 MESH_ASSET_VERSION = 4;
+
+    struct MeshAsset
+    {
+        Mesh mesh;
+        MeshletData meshlets;
+
+        // Reduced levels of detail, finest first; LOD 0 is the mesh itself. They share the
+        // mesh vertex buffer and index into lodIndices
+        std::vector<MeshLod> lods;
+        std::vector<uint32> lodIndices;
+
+        // How the runtime skins this mesh; ignored for static meshes
+        SkinningMode skinningMode = SkinningMode::Linear;
+    };
+
+    class MeshAssetSerializer
+    {
+    public:
+        static bool Save(const std::string& fileName, const std::vector<MeshAsset>& assets);
+        static bool Load(const std::string& fileName, std::vector<MeshAsset>& assets);
+
+        static void Serialize(BinaryWriter& writer, const std::vector<MeshAsset>& assets);
+        static bool Deserialize(BinaryReader& reader, std::vector<MeshAsset>& assets);
+    };
+}
+
+#endif // !_GINA_MESH_ASSET_H_
@@ -0,0 +1,50 @@
+#ifndef _GINA_MESH_COOKER_H_
+#define _GINA_MESH_COOKER_H_
+
+#include <string>
+#include <vector>
+
+#include "asset/gina_mesh_asset.h"
+#include "mesh/gina_mesh_lod.h"
+#include "mesh/gina_mesh_optimizer.h"
+#include "mesh/gina_meshlet.h"
+
+namespace gina
+{
+    struct MeshCookSettings
+    {
+        bool optimize = true;
+        MeshOptimizerSettings optimizer;
+
+        bool buildMeshlets = true;
+        MeshletBuildSettings meshlets;
+
+        bool buildLods = true;
+        MeshLodSettings lods;
+
+        SkinningMode skinningMode = SkinningMode::Linear;
+    };
+
+    struct MeshCookReport
+    {
+        std::string meshName;
+        uint32 vertexCount = 0;
+        uint32 triangleCount = 0;
+        MeshOptimizerReport optimization;
+
+        uint32 meshletCount = 0;
+        uint32 conesEnabled = 0;
+        float averageMeshletVertices = 0.0f;
+        float averageMeshletTriangles = 0.0f;
+
+        std::vector<MeshLod> lods;
+    };
+
+    class MeshCooker
+    {
+    public:
+        static MeshAsset Cook(const Mesh& mesh, const MeshCookSettings& settings, MeshCookReport& report);
+    };
+}
+
+#endif // !_GINA_MESH_COOKER_H_
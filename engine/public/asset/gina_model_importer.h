@@ -0,0 +1,29 @@
+#ifndef _GINA_MODEL_IMPORTER_H_
+#define _GINA_MODEL_IMPORTER_H_
+
+#include <string>
+#include <vector>
+
+#include "animation/gina_animation_clip.h"
+#include "animation/gina_skeleton.h"
+#include "mesh/gina_mesh.h"
+
+namespace gina
+{
+    class ModelImporter
+    {
+    public:
+        static bool ImportMeshes(const std::string& fileName, std::vector<Mesh>& meshes);
+        static bool ImportMeshesFromMemory(const void* data, size_t size, const std::string& formatHint, std::vector<Mesh>& meshes);
+
+        // The scene's node hierarchy as joints (parents first) and every animation resampled at sampleRate
+        // against it; nodes without a channel hold their bind pose. Clips follow the joint order given here,
+        // so remap them if SkeletonBuilder sorts the joints.
+        static bool ImportAnimations(const std::string& fileName, float sampleRate,
+            std::vector<SkeletonJointDesc>& joints, std::vector<AnimationClip>& clips);
+        static bool ImportAnimationsFromMemory(const void* data, size_t size, const std::string& formatHint, float sampleRate,
+            std::vector<SkeletonJointDesc>& joints, std::vector<AnimationClip>& clips);
+    };
+}
+
+#endif // !_GINA_MODEL_IMPORTER_H_
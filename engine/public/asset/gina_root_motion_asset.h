@@ -0,0 +1,28 @@
+#ifndef _GINA_ROOT_MOTION_ASSET_H_
+#define _GINA_ROOT_MOTION_ASSET_H_
+
+#include <string>
+#include <vector>
+
+#include "animation/gina_root_motion.h"
+#include "core/gina_binary_stream.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    constexpr uint32 ROOT_MOTION_ASSET_MAGIC = 0x544F5247; // "GROT"
+    constexpr uint32 ROOT_MOTION_ASSET_VERSION = 1;
+
+    // Root tracks cooked from a file's clips, loaded by gameplay and movement validation without the clips
+    class RootMotionAssetSerializer
+    {
+    public:
+        static bool Save(const std::string& fileName, const std::vector<RootMotionTrack>& tracks);
+        static bool Load(const std::string& fileName, std::vector<RootMotionTrack>& tracks);
+
+        static void Serialize(BinaryWriter& writer, const std::vector<RootMotionTrack>& tracks);
+        static bool Deserialize(BinaryReader& reader, std::vector<RootMotionTrack>& tracks);
+    };
+}
+
+#endif // !_GINA_ROOT_MOTION_ASSET_H_
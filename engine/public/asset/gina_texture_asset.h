@@ -0,0 +1,53 @@
+#ifndef _GINA_TEXTURE_ASSET_H_
+#define _GINA_TEXTURE_ASSET_H_
+
+#include <string>
+#include <vector>
+
+#include "core/gina_binary_stream.h"
+#include "core/gina_types.h"
+#include "rhi/gina_rhi.h"
+
+namespace gina
+{
+    constexpr uint32 TEXTURE_ASSET_MAGIC = 0x58455447; // "GTEX"
+    constexpr uint32 TEXTURE_ASSET_VERSION = 1;
+    constexpr uint32 TEXTURE_ASSET_MAX_HEADER_SIZE = 4096;
+
+    // One mip level, stored as its own chunk of the texture data so it can be loaded on its own
+    struct TextureMip
+    {
+        uint32 width = 0;
+        uint32 height = 0;
+        uint64 offset = 0;      // into TextureAsset::data
+        uint64 size = 0;
+    };
+
+    struct TextureAsset
+    {
+        RHIFormat format = RHIFormat::Unknown;
+        uint32 width = 0;
+        uint32 height = 0;
+        uint64 contentHash = 0;         // of the source texels and cook settings it was made from
+        std::vector<TextureMip> mips;   // largest first
+        std::vector<byte> data;
+    };
+
+    class TextureAssetSerializer
+    {
+    public:
+        static bool Save(const std::string& fileName, const TextureAsset& asset);
+        static bool Load(const std::string& fileName, TextureAsset& asset);
+
+        // Everything but the data; mip chunks then start at dataOffset + TextureMip::offset in the file
+        static bool LoadHeader(const std::string& fileName, TextureAsset& asset, uint64& dataOffset);
+
+        static void Serialize(BinaryWriter& writer, const TextureAsset& asset);
+        static bool Deserialize(BinaryReader& reader, TextureAsset& asset);
+
+    private:
+        static bool DeserializeHeader(BinaryReader& reader, TextureAsset& asset, uint64& dataSize);
+    };
+}
+
+#endif // !_GINA_TEXTURE_ASSET_H_
@@ -0,0 +1,70 @@
+#ifndef _GINA_TEXTURE_COOKER_H_
+#define _GINA_TEXTURE_COOKER_H_
+
+#include <string>
+#include <vector>
+
+#include "asset/gina_texture_asset.h"
+#include "asset/gina_texture_importer.h"
+#include "core/gina_thread_pool.h"
+
+namespace gina
+{
+    constexpr uint32 TEXTURE_COOKER_VERSION = 1;    // part of every cache key: bump when the output changes
+
+    enum class TextureCookUsage : uint8
+    {
+        Albedo,     // sRGB color and alpha
+        Normal,     // tangent space, X and Y in red and green
+        Mask        // one linear channel in red: roughness, occlusion, height
+    };
+
+    struct TextureCookSettings
+    {
+        TextureCookUsage usage = TextureCookUsage::Albedo;
+        RHIFormat format = RHIFormat::Unknown;  // Unknown picks the format of the usage
+        bool generateMips = true;
+    };
+
+    // BC7 for albedo, BC5 for normals, BC4 for masks, unless the settings ask for another BC format
+    RHIFormat GetTextureCookFormat(const TextureCookSettings& settings) noexcept;
+
+    struct TextureCookReport
+    {
+        RHIFormat format = RHIFormat::Unknown;
+        uint32 width = 0;
+        uint32 height = 0;
+        uint32 mipLevels = 0;
+        uint64 sourceBytes = 0;     // RGBA8 texels of every mip
+        uint64 cookedBytes = 0;
+        double cookTime = 0.0;      // ms, mip generation and compression or loading from the cache
+        double psnr = 0.0;          // dB of the top mip over the channels the format keeps; 0 on a cache hit
+        bool cacheHit = false;
+    };
+
+    /**
+     * Turns source images into block compressed textures with their mip chain
+     *
+     * Mips are box filtered the way the usage needs: albedo in linear space, normals renormalized, masks
+     * as plain values. Every mip is compressed with its block rows spread over the pool. CookCached keys
+     * the result by a hash of the source texels, the settings and TEXTURE_COOKER_VERSION, so cooking an
+     * unchanged texture again only reads back the blob of the last cook.
+     */
+    class TextureCooker
+    {
+    public:
+        static TextureAsset Cook(const TextureImage& image, const TextureCookSettings& settings, ThreadPool* pool, TextureCookReport& report);
+        static TextureAsset CookCached(const TextureImage& image, const TextureCookSettings& settings, const std::string& cacheDirectory,
+            ThreadPool* pool, TextureCookReport& report);
+
+        static uint64 GetCookHash(const TextureImage& image, const TextureCookSettings& settings) noexcept;
+
+        // The full chain down to 1x1, the image itself first
+        static void GenerateMips(const TextureImage& image, TextureCookUsage usage, std::vector<TextureImage>& mips);
+
+        // Over the first channelCount channels of two images of the same size
+        static double ComputePsnr(const TextureImage& reference, const TextureImage& image, uint32 channelCount) noexcept;
+    };
+}
+
+#endif // !_GINA_TEXTURE_COOKER_H_
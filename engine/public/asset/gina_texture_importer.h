@@ -0,0 +1,29 @@
+#ifndef _GINA_TEXTURE_IMPORTER_H_
+#define _GINA_TEXTURE_IMPORTER_H_
+
+#include <string>
+#include <vector>
+
+#include "core/gina_types.h"
+
+namespace gina
+{
+    // Source texels as RGBA8, row by row from the top
+    struct TextureImage
+    {
+        uint32 width = 0;
+        uint32 height = 0;
+        std::vector<uint8> texels;
+    };
+
+    class TextureImporter
+    {
+    public:
+        static bool Import(const std::string& fileName, TextureImage& image);
+
+        // Uncompressed and RLE TGA in true color (24 and 32 bit) and grayscale, what texture tools export
+        static bool DecodeTga(const std::vector<byte>& data, TextureImage& image);
+    };
+}
+
+#endif // !_GINA_TEXTURE_IMPORTER_H_
@@ -0,0 +1,108 @@
+#ifndef _GINA_BINARY_STREAM_H_
+#define _GINA_BINARY_STREAM_H_
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <type_traits>
+
+#include "core/gina_types.h"
+
+namespace gina
+{
+    class BinaryWriter
+    {
+    public:
+        template <typename T>
+        void Write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter only supports trivially copyable types");
+            WriteBytes(&value, sizeof(T));
+        }
+
+        template <typename T>
+        void WriteArray(const std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter only supports trivially copyable types");
+            Write(static_cast<uint32>(values.size()));
+            WriteBytes(values.data(), values.size() * sizeof(T));
+        }
+
+        void WriteString(const std::string& value)
+        {
+            Write(static_cast<uint32>(value.size()));
+            WriteBytes(value.data(), value.size());
+        }
+
+        void WriteBytes(const void* data, size_t size)
+        {
+            if (size == 0) return;
+
+            const size_t offset = m_buffer.size();
+            m_buffer.resize(offset + size);
+            std::memcpy(m_buffer.data() + offset, data, size);
+        }
+
+        const std::vector<byte>& GetBuffer() const noexcept { return m_buffer; }
+        bool SaveToFile(const std::string& fileName) const;
+
+    private:
+        std::vector<byte> m_buffer;
+    };
+
+    class BinaryReader
+    {
+    public:
+        BinaryReader() = default;
+        explicit BinaryReader(std::vector<byte> buffer) : m_buffer(std::move(buffer)) {}
+
+        bool LoadFromFile(const std::string& fileName);
+
+        template <typename T>
+        bool Read(T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "BinaryReader only supports trivially copyable types");
+            return ReadBytes(&value, sizeof(T));
+        }
+
+        template <typename T>
+        bool ReadArray(std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "BinaryReader only supports trivially copyable types");
+            uint32 count = 0;
+            if (!Read(count) || static_cast<size_t>(count) * sizeof(T) > GetRemaining()) return false;
+
+            values.resize(count);
+            return ReadBytes(values.data(), count * sizeof(T));
+        }
+
+        bool ReadString(std::string& value)
+        {
+            uint32 size = 0;
+            if (!Read(size) || size > GetRemaining()) return false;
+
+            value.assign(reinterpret_cast<const char*>(m_buffer.data() + m_offset), size);
+            m_offset += size;
+            return true;
+        }
+
+        bool ReadBytes(void* data, size_t size)
+        {
+            if (size > GetRemaining()) return false;
+            if (size == 0) return true;
+
+            std::memcpy(data, m_buffer.data() + m_offset, size);
+            m_offset += size;
+            return true;
+        }
+
+        size_t GetRemaining() const noexcept { return m_buffer.size() - m_offset; }
+        bool IsAtEnd() const noexcept { return m_offset == m_buffer.size(); }
+
+    private:
+        std::vector<byte> m_buffer;
+        size_t m_offset = 0;
+    };
+}
+
+#endif // !_GINA_BINARY_STREAM_H_
@@ -0,0 +1,27 @@
+#ifndef _GINA_CPU_FEATURES_H_
+#define _GINA_CPU_FEATURES_H_
+
+#include "core/gina_math.h"
+
+// AVX2 code paths are compiled per function so the rest of the engine keeps its baseline target;
+// they must only run after CpuFeatures::HasAVX2() returned true
+#if defined(GINA_SSE2_ENABLED)
+    #define GINA_AVX2_ENABLED 1
+    #if defined(_MSC_VER)
+        #define GINA_TARGET_AVX2
+    #else
+        #define GINA_TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#endif
+
+namespace gina
+{
+    class CpuFeatures
+    {
+    public:
+        static bool HasSSE2() noexcept;
+        static bool HasAVX2() noexcept;
+    };
+}
+
+#endif // !_GINA_CPU_FEATURES_H_
@@ -0,0 +1,32 @@
+#ifndef _GINA_FRUSTUM_H_
+#define _GINA_FRUSTUM_H_
+
+#include "core/gina_math.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    struct Plane
+    {
+        float3 normal;
+        float distance = 0.0f;
+
+        float SignedDistance(const float3& point) const noexcept { return dot(normal, point) + distance; }
+    };
+
+    class Frustum
+    {
+    public:
+        static constexpr uint32 PLANE_COUNT = 6;
+
+        // Plane normals point into the frustum
+        Plane planes[PLANE_COUNT];
+
+        static Frustum FromPerspective(const float3& position, const float3& forward, const float3& up,
+            float fovY, float aspectRatio, float nearZ, float farZ) noexcept;
+
+        bool IntersectsSphere(const float3& center, float radius) const noexcept;
+    };
+}
+
+#endif // !_GINA_FRUSTUM_H_
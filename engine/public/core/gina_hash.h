@@ -0,0 +1,46 @@
+#ifndef _GINA_HASH_H_
+#define _GINA_HASH_H_
+
+#include <cstring>
+#include <type_traits>
+
+#include "core/gina_types.h"
+
+namespace gina
+{
+    constexpr uint64 HASH_SEED = 14695981039346656037ull;
+    constexpr uint64 HASH_PRIME = 1099511628211ull;
+
+    // FNV-1a over 64-bit words with an extra shift to spread the high bits. Stable across runs and
+    // builds, so the result can key files on disk
+    inline uint64 HashBytes(const void* data, size_t size, uint64 seed = HASH_SEED) noexcept
+    {
+        const byte* bytes = static_cast<const byte*>(data);
+        uint64 hash = seed ^ (static_cast<uint64>(size) * HASH_PRIME);
+
+        size_t i = 0;
+        for (; i + sizeof(uint64) <= size; i += sizeof(uint64))
+        {
+            uint64 word;
+            std::memcpy(&word, bytes + i, sizeof(uint64));
+            hash = (hash ^ word) * HASH_PRIME;
+            hash ^= hash >> 29;
+        }
+        for (; i < size; ++i)
+        {
+            hash = (hash ^ bytes[i]) * HASH_PRIME;
+        }
+
+        return hash ^ (hash >> 32);
+    }
+
+    // Folds one scalar into a running hash; structs go field by field so padding never leaks in
+    template <typename T>
+    uint64 HashValue(uint64 hash, const T& value) noexcept
+    {
+        static_assert(std::is_scalar_v<T>, "HashValue only hashes scalars");
+        return HashBytes(&value, sizeof(T), hash);
+    }
+}
+
+#endif // !_GINA_HASH_H_
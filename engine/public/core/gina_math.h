@@ -113,6 +113,137 @@ namespace gina
     float2 operator*(float scalar, const float2& vec) noexcept;
     float2 operator/(const float2& vec, float scalar) noexcept;
 
+    class float3
+    {
+    public:
+        float x, y, z;
+
+        constexpr float3() noexcept : x(0), y(0), z(0) {}
+        constexpr float3(float x, float y, float z) noexcept : x(x), y(y), z(z) {}
+        constexpr explicit float3(float s) noexcept : x(s), y(s), z(s) {}
+
+        float* data() noexcept { return &x; }
+        const float* data() const noexcept { return &x; }
+
+        float& operator[](size_t index) noexcept { return (&x)[index]; }
+        float operator[](size_t index) const noexcept { return (&x)[index]; }
+
+        static const float3 Zero;
+
+        float lengthSquared() const noexcept;
+        float length() const noexcept;
+        float3 normalized() const noexcept;
+        void normalize() noexcept;
+        bool isZero() const noexcept;
+
+        float3& operator+=(const float3& other) noexcept;
+        float3& operator-=(const float3& other) noexcept;
+        float3& operator*=(float scalar) noexcept;
+        float3& operator/=(float scalar) noexcept;
+        bool operator==(const float3& other) const noexcept;
+        bool operator!=(const float3& other) const noexcept;
+        float3 operator-() const noexcept;
+    };
+
+    float dot(const float3& a, const float3& b) noexcept;
+    float3 cross(const float3& a, const float3& b) noexcept;
+    float distance(const float3& a, const float3& b) noexcept;
+    float3 lerp(const float3& a, const float3& b, float t) noexcept;
+    float3 min(const float3& a, const float3& b) noexcept;
+    float3 max(const float3& a, const float3& b) noexcept;
+    float3 operator+(const float3& lhs, const float3& rhs) noexcept;
+    float3 operator-(const float3& lhs, const float3& rhs) noexcept;
+    float3 operator*(const float3& lhs, const float3& rhs) noexcept;
+    float3 operator*(const float3& vec, float scalar) noexcept;
+    float3 operator*(float scalar, const float3& vec) noexcept;
+    float3 operator/(const float3& vec, float scalar) noexcept;
+
+    class quaternion
+    {
+    public:
+        float x, y, z, w;
+
+        constexpr quaternion() noexcept : x(0), y(0), z(0), w(1) {}
+        constexpr quaternion(float x, float y, float z, float w) noexcept : x(x), y(y), z(z), w(w) {}
+
+        float* data() noexcept { return &x; }
+        const float* data() const noexcept { return &x; }
+
+        static const quaternion Identity;
+
+        static quaternion fromAxisAngle(const float3& axis, float radians) noexcept;
+
+        // Shortest arc rotation taking the direction of from onto the direction of to
+        static quaternion fromTo(const float3& from, const float3& to) noexcept;
+
+        float lengthSquared() const noexcept;
+        float length() const noexcept;
+        quaternion normalized() const noexcept;
+        void normalize() noexcept;
+        quaternion conjugate() const noexcept;
+        float3 rotate(const float3& vec) const noexcept;
+
+        quaternion& operator*=(const quaternion& other) noexcept;
+        bool operator==(const quaternion& other) const noexcept;
+        bool operator!=(const quaternion& other) const noexcept;
+        quaternion operator-() const noexcept;
+    };
+
+    float dot(const quaternion& a, const quaternion& b) noexcept;
+    quaternion nlerp(const quaternion& a, const quaternion& b, float t) noexcept;
+    quaternion slerp(const quaternion& a, const quaternion& b, float t) noexcept;
+    quaternion operator*(const quaternion& lhs, const quaternion& rhs) noexcept;
+
+    // Affine transform stored as three rows of a row-major 4x4 matrix whose last row is (0, 0, 0, 1).
+    // Transforms column vectors: the translation is column 3.
+    class float3x4
+    {
+    public:
+        float m[3][4];
+
+        constexpr float3x4() noexcept : m{ { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 } } {}
+
+        float* data() noexcept { return &m[0][0]; }
+        const float* data() const noexcept { return &m[0][0]; }
+
+        static const float3x4 Identity;
+
+        static float3x4 fromRotationTranslationScale(const quaternion& rotation, const float3& translation, const float3& scale) noexcept;
+
+        float3 transformPoint(const float3& point) const noexcept;
+        float3 transformVector(const float3& vec) const noexcept;
+        float3x4 inverse() const noexcept;
+    };
+
+    float3x4 operator*(const float3x4& lhs, const float3x4& rhs) noexcept;
+
+    // Rigid transform as a unit dual quaternion: real is the rotation, dual = 0.5 * translation * real.
+    // Blending dual quaternions and renormalizing stays a rigid transform, unlike blending matrices.
+    class dualquaternion
+    {
+    public:
+        quaternion real;
+        quaternion dual;
+
+        constexpr dualquaternion() noexcept : real(), dual(0, 0, 0, 0) {}
+        constexpr dualquaternion(const quaternion& real, const quaternion& dual) noexcept : real(real), dual(dual) {}
+
+        float* data() noexcept { return real.data(); }
+        const float* data() const noexcept { return real.data(); }
+
+        static const dualquaternion Identity;
+
+        static dualquaternion fromRotationTranslation(const quaternion& rotation, const float3& translation) noexcept;
+
+        float3 getTranslation() const noexcept;
+        dualquaternion normalized() const noexcept;
+        float3 transformPoint(const float3& point) const noexcept;
+        float3 transformVector(const float3& vec) const noexcept;
+    };
+
+    // lhs * rhs applies rhs first, like quaternion and matrix products
+    dualquaternion operator*(const dualquaternion& lhs, const dualquaternion& rhs) noexcept;
+
     namespace detail 
     {
         struct BasicMathImpl
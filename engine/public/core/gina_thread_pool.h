@@ -0,0 +1,52 @@
+#ifndef _GINA_THREAD_POOL_H_
+#define _GINA_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/gina_types.h"
+#include "core/gina_non_copyable.h"
+
+namespace gina
+{
+    class ThreadPool final : public NonCopyable
+    {
+    public:
+        using RangeFunc = std::function<void(uint32 begin, uint32 end)>;
+
+        // workerCount 0 uses one worker per hardware thread besides the caller's
+        explicit ThreadPool(uint32 workerCount = 0);
+        ~ThreadPool();
+
+        uint32 GetWorkerCount() const noexcept { return static_cast<uint32>(m_workers.size()); }
+
+        // Splits [0, count) into chunks of at most grainSize and runs them on the workers and the
+        // calling thread; returns once every chunk is done. Concurrent calls are serialized.
+        void ParallelFor(uint32 count, uint32 grainSize, const RangeFunc& body);
+
+    private:
+        void WorkerLoop();
+        void RunChunks();
+
+        std::vector<std::thread> m_workers;
+
+        std::mutex m_submitMutex;
+        std::mutex m_mutex;
+        std::condition_variable m_wakeCondition;
+        std::condition_variable m_doneCondition;
+
+        const RangeFunc* m_body = nullptr;
+        uint32 m_count = 0;
+        uint32 m_grainSize = 1;
+        std::atomic<uint32> m_nextChunk{ 0 };
+        uint32 m_busyWorkers = 0;
+        uint64 m_generation = 0;
+        bool m_stop = false;
+    };
+}
+
+#endif // !_GINA_THREAD_POOL_H_
@@ -0,0 +1,31 @@
+#ifndef _GINA_TRANSFORM_H_
+#define _GINA_TRANSFORM_H_
+
+#include "core/gina_math.h"
+
+namespace gina
+{
+    // Rotation, translation and per-axis scale applied as scale -> rotate -> translate.
+    // Composition keeps scale per axis and ignores the shear a rotated non-uniform parent scale would introduce.
+    struct Transform
+    {
+        quaternion rotation;
+        float3 translation;
+        float3 scale = float3(1.0f);
+
+        static const Transform Identity;
+
+        float3 TransformPoint(const float3& point) const noexcept;
+        float3 TransformVector(const float3& vector) const noexcept;
+        Transform Inverse() const noexcept; // exact for uniform scale
+        float3x4 ToMatrix() const noexcept;
+    };
+
+    // parent * child: the child transform expressed in the parent's space
+    Transform operator*(const Transform& parent, const Transform& child) noexcept;
+
+    // Per-component interpolation with shortest-arc normalized rotation blending
+    Transform Blend(const Transform& a, const Transform& b, float weight) noexcept;
+}
+
+#endif // !_GINA_TRANSFORM_H_
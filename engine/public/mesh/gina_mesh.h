@@ -0,0 +1,45 @@
+#ifndef _GINA_MESH_H_
+#define _GINA_MESH_H_
+
+#include <string>
+#include <vector>
+
+#include "core/gina_math.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    constexpr uint32 MAX_SKIN_INFLUENCES = 4;
+
+    enum class SkinningMode : uint32
+    {
+        Linear,         // blended matrices, cheapest; volume collapses at strongly twisted joints
+        DualQuaternion  // blended rigid transforms, volume preserving; ignores joint scale
+    };
+
+    struct SkinInfluence
+    {
+        uint16 joints[MAX_SKIN_INFLUENCES] = {};
+        float weights[MAX_SKIN_INFLUENCES] = {};
+    };
+
+    struct Mesh
+    {
+        std::string name;
+
+        std::vector<float3> positions;
+        std::vector<float3> normals;
+        std::vector<float2> texcoords;
+        std::vector<SkinInfluence> skinning;
+        std::vector<uint32> indices;
+
+        // Skinning joint indices refer to this table (names of the bones that influence the mesh)
+        std::vector<std::string> jointNames;
+
+        uint32 GetVertexCount() const noexcept { return static_cast<uint32>(positions.size()); }
+        uint32 GetTriangleCount() const noexcept { return static_cast<uint32>(indices.size() / 3); }
+        bool IsSkinned() const noexcept { return !skinning.empty(); }
+    };
+}
+
+#endif // !_GINA_MESH_H_
@@ -0,0 +1,22 @@
+#ifndef _GINA_MESH_ADJACENCY_H_
+#define _GINA_MESH_ADJACENCY_H_
+
+#include <vector>
+
+#include "core/gina_types.h"
+
+namespace gina
+{
+    // Vertex-to-triangle adjacency in compressed form: the triangles that reference vertex v
+    // are triangles[offsets[v]] .. triangles[offsets[v + 1] - 1]
+    struct TriangleAdjacency
+    {
+        std::vector<uint32> offsets;
+        std::vector<uint32> triangles;
+        std::vector<uint32> counts;
+
+        static TriangleAdjacency Build(const std::vector<uint32>& indices, uint32 vertexCount);
+    };
+}
+
+#endif // !_GINA_MESH_ADJACENCY_H_
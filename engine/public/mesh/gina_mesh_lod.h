@@ -0,0 +1,44 @@
+#ifndef _GINA_MESH_LOD_H_
+#define _GINA_MESH_LOD_H_
+
+#include <vector>
+
+#include "mesh/gina_mesh.h"
+#include "mesh/gina_mesh_simplifier.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    struct MeshLod
+    {
+        uint32 indexOffset = 0;
+        uint32 indexCount = 0;
+        float error = 0.0f; // object space simplification error, non-decreasing along the chain
+    };
+
+    struct MeshLodSettings
+    {
+        uint32 levelCount = 4;       // including LOD 0, the source mesh
+        float triangleRatio = 0.5f;  // target triangle count of each level relative to the previous one
+        float minReduction = 0.1f;   // levels removing less than this fraction of the previous level's triangles are dropped
+
+        MeshSimplifySettings simplifier;
+    };
+
+    class MeshLodBuilder
+    {
+    public:
+        // Appends LOD 1 .. levelCount - 1 of mesh to lods, with their indices appended to lodIndices
+        static void Build(const Mesh& mesh, const MeshLodSettings& settings,
+            std::vector<MeshLod>& lods, std::vector<uint32>& lodIndices);
+
+        // Pixels covered by one object space unit at distance 1 (screenHeight / (2 * tan(fovY / 2)))
+        static float ComputeProjectionScale(float screenHeight, float fovY) noexcept;
+
+        // Returns 0 for the source mesh or i + 1 for lods[i]
+        static uint32 SelectLod(const std::vector<MeshLod>& lods, float distance, float projectionScale,
+            float maxPixelError = 1.0f) noexcept;
+    };
+}
+
+#endif // !_GINA_MESH_LOD_H_
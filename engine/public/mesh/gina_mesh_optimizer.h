@@ -0,0 +1,53 @@
+#ifndef _GINA_MESH_OPTIMIZER_H_
+#define _GINA_MESH_OPTIMIZER_H_
+
+#include <vector>
+
+#include "mesh/gina_mesh.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    constexpr uint32 DEFAULT_VERTEX_CACHE_SIZE = 16;
+    constexpr uint32 INVALID_VERTEX_INDEX = ~0u;
+
+    struct VertexCacheStatistics
+    {
+        uint32 verticesTransformed = 0;
+        float acmr = 0.0f; // average cache miss ratio: transformed vertices per triangle
+        float atvr = 0.0f; // average transformed vertex ratio: transformed vertices per referenced vertex
+    };
+
+    struct MeshOptimizerSettings
+    {
+        uint32 cacheSize = DEFAULT_VERTEX_CACHE_SIZE;
+        float overdrawThreshold = 1.05f;
+        bool optimizeOverdraw = true;
+        bool optimizeVertexFetch = true;
+    };
+
+    struct MeshOptimizerReport
+    {
+        VertexCacheStatistics before;
+        VertexCacheStatistics after;
+    };
+
+    class MeshOptimizer
+    {
+    public:
+        static MeshOptimizerReport Optimize(Mesh& mesh, const MeshOptimizerSettings& settings = {});
+
+        static std::vector<uint32> OptimizeVertexCache(const std::vector<uint32>& indices, uint32 vertexCount,
+            uint32 cacheSize = DEFAULT_VERTEX_CACHE_SIZE, std::vector<uint32>* clusters = nullptr);
+
+        static std::vector<uint32> OptimizeOverdraw(const std::vector<uint32>& indices, const std::vector<uint32>& clusters,
+            const std::vector<float3>& positions, uint32 cacheSize = DEFAULT_VERTEX_CACHE_SIZE, float threshold = 1.05f);
+
+        static std::vector<uint32> OptimizeVertexFetch(Mesh& mesh);
+
+        static VertexCacheStatistics AnalyzeVertexCache(const std::vector<uint32>& indices, uint32 vertexCount,
+            uint32 cacheSize = DEFAULT_VERTEX_CACHE_SIZE);
+    };
+}
+
+#endif // !_GINA_MESH_OPTIMIZER_H_
@@ -0,0 +1,42 @@
+#ifndef _GINA_MESH_SIMPLIFIER_H_
+#define _GINA_MESH_SIMPLIFIER_H_
+
+#include <vector>
+
+#include "mesh/gina_mesh.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    struct MeshSimplifySettings
+    {
+        // Collapses whose error exceeds this, relative to the mesh extent, are never performed
+        float maxError = 1.0f;
+
+        // Error (relative to the mesh extent) charged for collapsing between two vertices with
+        // completely different skin influences; partial differences are charged proportionally
+        float skinWeightPenalty = 0.1f;
+
+        bool lockBorders = false;
+    };
+
+    struct MeshSimplifyResult
+    {
+        // References the source vertex buffer, so attributes and skin weights are kept as-is
+        std::vector<uint32> indices;
+
+        float error = 0.0f;         // object space units
+        float relativeError = 0.0f; // relative to the mesh extent
+    };
+
+    class MeshSimplifier
+    {
+    public:
+        static MeshSimplifyResult Simplify(const Mesh& mesh, const std::vector<uint32>& indices,
+            uint32 targetIndexCount, const MeshSimplifySettings& settings = {});
+
+        static float ComputeExtent(const Mesh& mesh) noexcept;
+    };
+}
+
+#endif // !_GINA_MESH_SIMPLIFIER_H_
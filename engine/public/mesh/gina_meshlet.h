@@ -0,0 +1,69 @@
+#ifndef _GINA_MESHLET_H_
+#define _GINA_MESHLET_H_
+
+#include <vector>
+
+#include "mesh/gina_mesh.h"
+#include "core/gina_math.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    constexpr uint32 MESHLET_MAX_VERTICES = 64;
+    constexpr uint32 MESHLET_MAX_TRIANGLES = 124;
+
+    struct Meshlet
+    {
+        uint32 vertexOffset = 0;
+        uint32 triangleOffset = 0;
+        uint32 vertexCount = 0;
+        uint32 triangleCount = 0;
+    };
+
+    // Laid out as two float4 (center/radius, axis/cutoff) so the cooked array can be uploaded
+    // as-is and consumed by a GPU culling pass without conversion
+    struct MeshletBounds
+    {
+        float3 center;
+        float radius = 0.0f;
+        float3 coneAxis;
+        float coneCutoff = 1.0f; // 1 disables backface cone culling for this meshlet
+    };
+
+    static_assert(sizeof(Meshlet) == 16, "Meshlet layout must match the GPU structure");
+    static_assert(sizeof(MeshletBounds) == 32, "MeshletBounds layout must match the GPU structure");
+
+    struct MeshletData
+    {
+        std::vector<Meshlet> meshlets;
+        std::vector<MeshletBounds> bounds;
+
+        // Mesh vertex index of every meshlet-local vertex
+        std::vector<uint32> vertices;
+
+        // One entry per triangle: three 8-bit meshlet-local vertex indices packed as i0 | i1 << 8 | i2 << 16
+        std::vector<uint32> triangles;
+
+        static uint32 PackTriangle(uint32 i0, uint32 i1, uint32 i2) noexcept { return i0 | (i1 << 8) | (i2 << 16); }
+        static uint32 UnpackIndex(uint32 packed, uint32 corner) noexcept { return (packed >> (corner * 8)) & 0xFF; }
+    };
+
+    struct MeshletBuildSettings
+    {
+        uint32 maxVertices = MESHLET_MAX_VERTICES;
+        uint32 maxTriangles = MESHLET_MAX_TRIANGLES;
+
+        // Bind-pose normal cones are meaningless once a mesh is deformed, so skinned meshes
+        // always get disabled cones and are only culled by their bounding spheres
+        bool computeCones = true;
+    };
+
+    class MeshletBuilder
+    {
+    public:
+        static MeshletData Build(const Mesh& mesh, const MeshletBuildSettings& settings = {});
+        static MeshletBounds ComputeBounds(const Mesh& mesh, const MeshletData& data, const Meshlet& meshlet, bool computeCone);
+    };
+}
+
+#endif // !_GINA_MESHLET_H_
@@ -0,0 +1,40 @@
+#ifndef _GINA_MESHLET_CULLER_H_
+#define _GINA_MESHLET_CULLER_H_
+
+#include "mesh/gina_meshlet.h"
+#include "core/gina_frustum.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    /**
+     * CPU reference culler for meshlets: frustum test against the bounding sphere and
+     * backface test against the normal cone. Bounds and frustum must be in the same space.
+     * Writes the indices of visible meshlets to visibleIndices (capacity >= count) and
+     * returns how many were written, in ascending order.
+     */
+    class MeshletCuller
+    {
+    public:
+        using CullFunc = uint32(*)(const MeshletBounds*, uint32, const Frustum&, const float3&, uint32*);
+
+        static uint32 Cull(const MeshletBounds* bounds, uint32 count, const Frustum& frustum,
+            const float3& cameraPosition, uint32* visibleIndices) noexcept;
+
+        static uint32 CullScalar(const MeshletBounds* bounds, uint32 count, const Frustum& frustum,
+            const float3& cameraPosition, uint32* visibleIndices) noexcept;
+
+#if defined(GINA_SSE2_ENABLED)
+        static uint32 CullSSE2(const MeshletBounds* bounds, uint32 count, const Frustum& frustum,
+            const float3& cameraPosition, uint32* visibleIndices) noexcept;
+#endif
+
+        static bool IsVisible(const MeshletBounds& bounds, const Frustum& frustum, const float3& cameraPosition) noexcept;
+
+    private:
+        static CullFunc SelectImpl() noexcept;
+        static CullFunc cullImpl;
+    };
+}
+
+#endif // !_GINA_MESHLET_CULLER_H_
@@ -0,0 +1,172 @@
+#ifndef _GINA_RENDER_GRAPH_H_
+#define _GINA_RENDER_GRAPH_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/gina_non_copyable.h"
+#include "rhi/gina_rhi.h"
+
+namespace gina
+{
+    constexpr uint64 RENDER_GRAPH_PLACEMENT_ALIGNMENT = RHI_HEAP_PLACEMENT_ALIGNMENT;
+
+    // One version of a graph resource: every write produces a new handle for the passes after it
+    using RenderGraphHandle = uint32;
+    constexpr RenderGraphHandle INVALID_RENDER_GRAPH_HANDLE = 0xFFFFFFFF;
+    constexpr uint32 INVALID_RENDER_GRAPH_PASS = 0xFFFFFFFF;
+
+    struct RenderGraphResourceInfo
+    {
+        std::string name;
+        bool texture = true;
+        bool imported = false;
+        RHITextureDesc textureDesc;
+        RHIBufferDesc bufferDesc;
+
+        // Filled by Compile for transient resources the surviving passes use, positions in execution order
+        bool used = false;
+        uint32 firstPass = INVALID_RENDER_GRAPH_PASS;
+        uint32 lastPass = INVALID_RENDER_GRAPH_PASS;
+        uint64 size = 0;
+        uint64 heapOffset = 0;
+    };
+
+    struct RenderGraphCompiledPass
+    {
+        uint32 pass = INVALID_RENDER_GRAPH_PASS;
+        std::vector<RHIBarrier> barriers;       // issued as one batch before the pass, ids are graph resources
+
+        // Transients whose memory this pass takes over from an aliased one. Their aliasing barriers lead the
+        // batch; the pass must clear, discard or fully overwrite them before reading, as their contents are undefined
+        std::vector<uint32> activations;
+    };
+
+    struct RenderGraphMemoryReport
+    {
+        uint32 transientResources = 0;
+        uint32 culledPasses = 0;
+        uint64 transientBytes = 0;      // every transient in its own allocation
+        uint64 heapBytes = 0;           // aliased into one heap
+
+        uint64 GetSavedBytes() const noexcept { return transientBytes - heapBytes; }
+    };
+
+    /**
+     * A frame described as passes and the resources they read and write, compiled before it runs
+     *
+     * Passes declare their reads and writes against resource handles; a write returns a new handle, so
+     * the edges between passes come from the handles and not from declaration order. Compile culls passes
+     * nothing observable depends on (roots are passes with side effects and writes to imported resources),
+     * sorts the rest topologically, works out the pass range each transient is alive in and packs the
+     * transients into one heap, overlapping resources whose lifetimes do not. Barriers are computed per
+     * pass ahead of time with a ResourceStateTracker and issued as one batch each, split when a resource
+     * idles between its producer and its consumer.
+     *
+     * Compile is CPU only; given a device it sizes textures the way that device places them. Execute
+     * records the compiled passes into a command list, using the physical resources set with
+     * SetPhysicalResource. Every used transient must be a placed resource at its heapOffset in one heap of
+     * at least heapBytes, which PlaceTransients sets up: the lifetimes and aliasing barriers only hold for
+     * that layout.
+     */
+    class RenderGraph : public NonCopyable
+    {
+    public:
+        using ExecuteFunc = std::function<void(RHICommandList& list, const RenderGraph& graph)>;
+
+        RenderGraphHandle CreateTexture(const RHITextureDesc& desc);
+        RenderGraphHandle CreateBuffer(const RHIBufferDesc& desc);
+
+        // Resources living outside the graph, such as the back buffer: never culled away or aliased
+        RenderGraphHandle ImportTexture(const RHITextureDesc& desc, RHIResourceHandle physical, RHIResourceState initialState,
+            RHIResourceState finalState);
+        RenderGraphHandle ImportBuffer(const RHIBufferDesc& desc, RHIResourceHandle physical, RHIResourceState initialState,
+            RHIResourceState finalState);
+
+        uint32 AddPass(std::string name, ExecuteFunc execute = {}, bool sideEffects = false);
+
+        void Read(uint32 pass, RenderGraphHandle handle, RHIResourceState state = RHIResourceState::ShaderResource);
+
+        // Writes the latest version of a resource and returns the version readers after this pass use
+        RenderGraphHandle Write(uint32 pass, RenderGraphHandle handle, RHIResourceState state = RHIResourceState::RenderTarget);
+
+        // False when the passes depend on each other in a cycle
+        bool Compile(const RHIDevice* device = nullptr);
+
+        // Creates every used transient in the heap at its offset and makes it the physical resource. The
+        // created resources are appended to created, for the caller to destroy once the frame is done
+        void PlaceTransients(RHIDevice& device, RHIHeapHandle heap, std::vector<RHIResourceHandle>& created);
+
+        // Records the compiled passes and their barriers, then moves imported resources to their final state
+        void Execute(RHICommandList& list) const;
+
+        // Starts a new frame's graph
+        void Clear();
+
+        uint32 GetResourceIndex(RenderGraphHandle handle) const noexcept { return m_versions[handle].resource; }
+        const RenderGraphResourceInfo& GetResourceInfo(RenderGraphHandle handle) const noexcept;
+
+        void SetPhysicalResource(RenderGraphHandle handle, RHIResourceHandle physical);
+        RHIResourceHandle GetPhysicalResource(RenderGraphHandle handle) const noexcept;
+
+        uint32 GetPassCount() const noexcept { return static_cast<uint32>(m_passes.size()); }
+        const std::string& GetPassName(uint32 pass) const noexcept { return m_passes[pass].name; }
+        bool IsPassCulled(uint32 pass) const noexcept { return m_passes[pass].culled; }
+
+        const std::vector<RenderGraphCompiledPass>& GetCompiledPasses() const noexcept { return m_compiled; }
+        const std::vector<RHIBarrier>& GetFinalBarriers() const noexcept { return m_finalBarriers; }
+        const RenderGraphMemoryReport& GetMemoryReport() const noexcept { return m_report; }
+
+    private:
+        struct Resource
+        {
+            RenderGraphResourceInfo info;
+            RHIResourceHandle physical;
+            RHIResourceState initialState = RHIResourceState::Common;
+            RHIResourceState finalState = RHIResourceState::Common;
+            RenderGraphHandle latest = INVALID_RENDER_GRAPH_HANDLE;
+        };
+
+        struct Version
+        {
+            uint32 resource;
+            uint32 writer;                          // INVALID_RENDER_GRAPH_PASS for the initial contents
+            RenderGraphHandle previous;
+            std::vector<uint32> readers;
+        };
+
+        struct Access
+        {
+            RenderGraphHandle handle;
+            RHIResourceState state;
+            bool write;
+        };
+
+        struct Pass
+        {
+            std::string name;
+            ExecuteFunc execute;
+            bool sideEffects = false;
+            bool culled = false;
+            std::vector<Access> accesses;
+        };
+
+        RenderGraphHandle AddResource(Resource resource);
+        // Per pass, the passes whose contents it uses (read and write after write) and those that read what it overwrites
+        void CollectDependencies(std::vector<std::vector<uint32>>& producers, std::vector<std::vector<uint32>>& readers) const;
+        void AssignLifetimes(const std::vector<uint32>& order, const RHIDevice* device);
+        void AliasTransients();
+        void ComputeBarriers(const std::vector<uint32>& order);
+
+        std::vector<Resource> m_resources;
+        std::vector<Version> m_versions;
+        std::vector<Pass> m_passes;
+
+        std::vector<RenderGraphCompiledPass> m_compiled;
+        std::vector<RHIBarrier> m_finalBarriers;
+        RenderGraphMemoryReport m_report;
+    };
+}
+
+#endif // !_GINA_RENDER_GRAPH_H_
@@ -0,0 +1,83 @@
+#ifndef _GINA_COMMAND_LIST_POOL_H_
+#define _GINA_COMMAND_LIST_POOL_H_
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "core/gina_non_copyable.h"
+#include "core/gina_thread_pool.h"
+#include "rhi/gina_rhi.h"
+
+namespace gina
+{
+    struct CommandListPoolStats
+    {
+        uint32 allocators = 0;          // created so far, in use or not
+        uint32 lists = 0;
+        uint32 recycledAllocators = 0;  // reset and reused after their fence value completed
+    };
+
+    /**
+     * Command lists and allocators for recording one frame on many threads
+     *
+     * Every recording job acquires its own list and allocator, so jobs never share recording state.
+     * Each list carries an order key and Submit executes all of them in one batch sorted by it, which
+     * keeps the GPU command order independent of which thread ran which job. Allocators used in a
+     * frame are tagged with the frame's fence value and only reset and handed out again once the GPU
+     * reached it; lists can be reused as soon as they were submitted.
+     */
+    class CommandListPool : public NonCopyable
+    {
+    public:
+        using RecordFunc = std::function<void(RHICommandList& list, uint32 begin, uint32 end)>;
+
+        explicit CommandListPool(RHIDevice& device, RHIQueueType type = RHIQueueType::Graphics);
+
+        // Recycles allocators the GPU is done with; lists acquired until the next BeginFrame belong to the
+        // frame signaling fenceValue
+        void BeginFrame(uint64 fenceValue, uint64 completedValue);
+
+        // Thread safe; returns a list recording into an allocator of its own
+        RHICommandList& Acquire(uint32 order);
+
+        // Records [0, count) in chunks of at most grainSize, spread over the thread pool when given. Every
+        // chunk gets its own list ordered by the chunk's first item.
+        void Record(ThreadPool* threadPool, uint32 count, uint32 grainSize, const RecordFunc& record);
+
+        // Closes every acquired list and submits them in one batch by ascending order; returns the list count
+        uint32 Submit(RHIQueue& queue);
+
+        CommandListPoolStats GetStats() const;
+
+    private:
+        struct Recording
+        {
+            uint32 order;
+            std::unique_ptr<RHICommandList> list;
+            std::unique_ptr<RHICommandAllocator> allocator;
+        };
+
+        struct PendingAllocator
+        {
+            uint64 fenceValue;
+            std::unique_ptr<RHICommandAllocator> allocator;
+        };
+
+        RHIDevice* m_device;
+        RHIQueueType m_type;
+        uint64 m_fenceValue = 0;
+
+        mutable std::mutex m_mutex;
+        std::vector<Recording> m_recording;
+        std::deque<PendingAllocator> m_pendingAllocators;   // by ascending fence value
+        std::vector<std::unique_ptr<RHICommandAllocator>> m_freeAllocators;
+        std::vector<std::unique_ptr<RHICommandList>> m_freeLists;
+        std::vector<RHICommandList*> m_batch;
+        CommandListPoolStats m_stats;
+    };
+}
+
+#endif // !_GINA_COMMAND_LIST_POOL_H_
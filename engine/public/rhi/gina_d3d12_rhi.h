@@ -0,0 +1,171 @@
+#ifndef _GINA_D3D12_RHI_H_
+#define _GINA_D3D12_RHI_H_
+
+#include <mutex>
+#include <vector>
+
+#include "core/gina_device.h"
+#include "core/gina_fence.h"
+#include "core/gina_non_copyable.h"
+#include "rhi/gina_rhi.h"
+
+namespace gina
+{
+    class D3D12RHIDevice;
+
+    DXGI_FORMAT ToDXGIFormat(RHIFormat format) noexcept;
+    D3D12_RESOURCE_STATES ToD3D12States(RHIResourceState state) noexcept;
+    D3D12_COMMAND_LIST_TYPE ToD3D12ListType(RHIQueueType type) noexcept;
+
+    class D3D12RHIFence final : public RHIFence, public NonCopyable
+    {
+    public:
+        explicit D3D12RHIFence(ID3D12Device* device);
+
+        uint64 GetCompletedValue() const override { return m_fence.GetCompletedValue(); }
+        uint64 GetLastSignaledValue() const override { return m_fence.GetCurrentValue(); }
+        void WaitOnCPU(uint64 value) override { m_fence.WaitOnCPU(value); }
+
+        Fence& GetFence() noexcept { return m_fence; }
+
+    private:
+        Fence m_fence;
+    };
+
+    class D3D12RHICommandAllocator final : public RHICommandAllocator, public NonCopyable
+    {
+    public:
+        D3D12RHICommandAllocator(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type);
+
+        void Reset() override;
+        ID3D12CommandAllocator* GetAllocator() const noexcept { return m_allocator.Get(); }
+
+    private:
+        ComPtr<ID3D12CommandAllocator> m_allocator;
+    };
+
+    class D3D12RHICommandList final : public RHICommandList, public NonCopyable
+    {
+    public:
+        D3D12RHICommandList(D3D12RHIDevice& device, D3D12_COMMAND_LIST_TYPE type);
+
+        ID3D12GraphicsCommandList* GetCommandList() const noexcept { return m_commandList.Get(); }
+
+        void Begin(RHICommandAllocator& allocator) override;
+        void End() override;
+
+        void Barrier(const RHIBarrier* barriers, uint32 count) override;
+        void CopyBuffer(RHIBufferHandle destination, uint64 destinationOffset, RHIBufferHandle source, uint64 sourceOffset,
+            uint64 size) override;
+        void CopyBufferToTexture(RHITextureHandle destination, uint32 subresource, RHIBufferHandle source, uint64 sourceOffset) override;
+        void CopyTexture(RHITextureHandle destination, uint32 destinationSubresource, RHITextureHandle source, uint32 sourceSubresource) override;
+        void SetIndexBuffer(RHIBufferHandle buffer, uint64 offset, uint32 size, bool wideIndices) override;
+        void SetConstants(uint32 slot, const uint32* values, uint32 count) override;
+        void Draw(uint32 vertexCount, uint32 instanceCount, uint32 firstVertex, uint32 firstInstance) override;
+        void DrawIndexed(uint32 indexCount, uint32 instanceCount, uint32 firstIndex, int32 baseVertex, uint32 firstInstance) override;
+        void Dispatch(uint32 groupCountX, uint32 groupCountY, uint32 groupCountZ) override;
+
+    private:
+        D3D12RHIDevice* m_device;
+        D3D12_COMMAND_LIST_TYPE m_type;
+        ComPtr<ID3D12GraphicsCommandList> m_commandList;
+        std::vector<D3D12_RESOURCE_BARRIER> m_barriers;
+    };
+
+    class D3D12RHIQueue final : public RHIQueue, public NonCopyable
+    {
+    public:
+        explicit D3D12RHIQueue(ComPtr<ID3D12CommandQueue> queue) : m_queue(queue) {}
+
+        ID3D12CommandQueue* GetCommandQueue() const noexcept { return m_queue.Get(); }
+
+        void Submit(RHICommandList* const* lists, uint32 count) override;
+        uint64 Signal(RHIFence& fence) override;
+        void Wait(RHIFence& fence, uint64 value) override;
+
+    private:
+        ComPtr<ID3D12CommandQueue> m_queue;
+        std::vector<ID3D12CommandList*> m_lists;
+    };
+
+    /**
+     * Descriptor heap addressed by the indices of the descriptor allocators
+     *
+     * The allocators only hand out indices; this turns them into CPU handles for creating views and,
+     * for shader visible heaps, GPU handles for descriptor tables. Bindless shaders index the heap
+     * with the same values.
+     */
+    class D3D12DescriptorHeap : public NonCopyable
+    {
+    public:
+        void Initialize(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32 count, bool shaderVisible);
+
+        ID3D12DescriptorHeap* GetHeap() const noexcept { return m_heap.Get(); }
+        uint32 GetCount() const noexcept { return m_count; }
+
+        D3D12_CPU_DESCRIPTOR_HANDLE GetCPUHandle(uint32 index) const noexcept;
+        D3D12_GPU_DESCRIPTOR_HANDLE GetGPUHandle(uint32 index) const noexcept;
+
+    private:
+        ComPtr<ID3D12DescriptorHeap> m_heap;
+        D3D12_CPU_DESCRIPTOR_HANDLE m_cpuStart = {};
+        D3D12_GPU_DESCRIPTOR_HANDLE m_gpuStart = {};
+        uint32 m_descriptorSize = 0;
+        uint32 m_count = 0;
+    };
+
+    /**
+     * D3D12 backend over an initialized Device
+     *
+     * The graphics queue is the device's command system queue, so RHI submissions and the swap chain
+     * stay ordered; compute and copy queues are created here. Resources are committed unless placed in a
+     * heap, with upload and readback buffers mapped for their whole lifetime. Heaps allow every kind of
+     * resource, which needs resource heap tier 2.
+     */
+    class D3D12RHIDevice final : public RHIDevice, public NonCopyable
+    {
+    public:
+        explicit D3D12RHIDevice(Device& device);
+        ~D3D12RHIDevice() override;
+
+        RHIBufferHandle CreateBuffer(const RHIBufferDesc& desc) override;
+        RHITextureHandle CreateTexture(const RHITextureDesc& desc) override;
+        RHIHeapHandle CreateHeap(const RHIHeapDesc& desc) override;
+        RHIBufferHandle CreatePlacedBuffer(RHIHeapHandle heap, uint64 offset, const RHIBufferDesc& desc) override;
+        RHITextureHandle CreatePlacedTexture(RHIHeapHandle heap, uint64 offset, const RHITextureDesc& desc) override;
+        uint64 GetPlacedTextureSize(const RHITextureDesc& desc) const override;
+        void DestroyResource(RHIResourceHandle resource) override;
+        void* Map(RHIBufferHandle buffer) override;
+
+        std::unique_ptr<RHIFence> CreateFence() override;
+        std::unique_ptr<RHICommandAllocator> CreateCommandAllocator(RHIQueueType type) override;
+        std::unique_ptr<RHICommandList> CreateCommandList(RHIQueueType type) override;
+        RHIQueue& GetQueue(RHIQueueType type) override;
+
+        ID3D12Device* GetDevice() const noexcept { return m_device; }
+        ID3D12Resource* GetResource(RHIResourceHandle resource) const;
+
+    private:
+        struct Resource
+        {
+            ComPtr<ID3D12Resource> resource;
+            void* mapped = nullptr;
+            ComPtr<ID3D12Heap> heap;        // set for heaps, which have no resource
+            RHIMemoryType memory = RHIMemoryType::Default;
+        };
+
+        RHIResourceHandle AddResource(ComPtr<ID3D12Resource> resource, void* mapped);
+        RHIResourceHandle AddResourceLocked(Resource&& resource);
+        ID3D12Heap* GetHeap(RHIHeapHandle heap) const;
+        RHIMemoryType GetHeapMemory(RHIHeapHandle heap) const;
+
+        ID3D12Device* m_device;
+        std::unique_ptr<D3D12RHIQueue> m_queues[static_cast<uint32>(RHIQueueType::Count)];
+
+        mutable std::mutex m_mutex;
+        std::vector<Resource> m_resources;
+        std::vector<uint32> m_freeResources;
+    };
+}
+
+#endif // !_GINA_D3D12_RHI_H_
@@ -0,0 +1,141 @@
+#ifndef _GINA_DESCRIPTOR_ALLOCATOR_H_
+#define _GINA_DESCRIPTOR_ALLOCATOR_H_
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "core/gina_non_copyable.h"
+#include "core/gina_types.h"
+
+namespace gina
+{
+    constexpr uint32 INVALID_DESCRIPTOR_INDEX = 0xFFFFFFFF;
+
+    // Contiguous descriptors of a heap; index is what shaders use as the bindless index of the first one
+    struct DescriptorRange
+    {
+        uint32 index = INVALID_DESCRIPTOR_INDEX;
+        uint32 count = 0;
+
+        bool IsValid() const noexcept { return index != INVALID_DESCRIPTOR_INDEX; }
+    };
+
+    struct PersistentDescriptorStats
+    {
+        uint32 usedCount = 0;
+        uint32 peakUsedCount = 0;
+        uint32 freeBlockCount = 0;
+        uint32 largestFreeBlock = 0;
+        uint32 pendingFreeCount = 0;    // freed, waiting for the GPU
+        uint64 failures = 0;
+    };
+
+    /**
+     * Long lived descriptors (textures, buffers) in [base, base + capacity) of a heap
+     *
+     * Free space is kept as blocks sorted by offset and by size: allocations take the lowest of the
+     * best fitting blocks and frees merge with their neighbours, so the heap does not fragment under
+     * streaming. Frees are deferred until the fence value of the last frame that may reference the
+     * descriptors completes. Thread safe.
+     */
+    class PersistentDescriptorAllocator : public NonCopyable
+    {
+    public:
+        PersistentDescriptorAllocator(uint32 base, uint32 capacity);
+
+        DescriptorRange Allocate(uint32 count = 1);
+
+        // Returns the range to the heap once fenceValue completes
+        void Free(const DescriptorRange& range, uint64 fenceValue);
+
+        // Releases deferred frees whose fence value completed
+        void Reclaim(uint64 completedValue);
+
+        PersistentDescriptorStats GetStats() const;
+
+    private:
+        void AddFreeBlock(uint32 offset, uint32 count);
+        void RemoveFreeBlock(std::map<uint32, uint32>::iterator block);
+
+        struct PendingFree
+        {
+            uint64 fenceValue;
+            DescriptorRange range;
+        };
+
+        uint32 m_base;
+        uint32 m_capacity;
+
+        mutable std::mutex m_mutex;
+        std::map<uint32, uint32> m_freeByOffset;        // offset -> count
+        std::set<std::pair<uint32, uint32>> m_freeBySize;   // (count, offset)
+        std::deque<PendingFree> m_pendingFrees;
+        uint32 m_usedCount = 0;
+        uint32 m_peakUsedCount = 0;
+        uint64 m_failures = 0;
+    };
+
+    // Per recording thread position in a page of transient descriptors; zero initialized is empty
+    struct DescriptorPageCursor
+    {
+        uint32 page = INVALID_DESCRIPTOR_INDEX;
+        uint32 used = 0;
+        uint64 fenceValue = 0;          // frame the page belongs to; pages of older frames are stale
+    };
+
+    struct TransientDescriptorStats
+    {
+        uint32 pageCount = 0;
+        uint32 freePageCount = 0;
+        uint32 framePageCount = 0;      // taken by the current frame
+        uint64 failures = 0;
+    };
+
+    /**
+     * Per frame descriptor tables in [base, base + pageCount * pageSize) of a heap
+     *
+     * The range is cut into pages. A thread takes a page under a lock, then allocates from it by bumping
+     * its own cursor without synchronization. Pages are retired with the frame's fence value and reused
+     * once it completes, so nothing is freed individually.
+     */
+    class TransientDescriptorAllocator : public NonCopyable
+    {
+    public:
+        TransientDescriptorAllocator(uint32 base, uint32 pageCount, uint32 pageSize);
+
+        uint32 GetPageSize() const noexcept { return m_pageSize; }
+
+        // Retires the previous frame's pages and frees those of completed frames; fenceValue is the value
+        // this frame signals
+        void BeginFrame(uint64 fenceValue, uint64 completedValue);
+
+        // Contiguous range of count descriptors, at most a page; invalid when every page is in use
+        DescriptorRange Allocate(DescriptorPageCursor& cursor, uint32 count);
+
+        TransientDescriptorStats GetStats() const;
+
+    private:
+        struct RetiredPages
+        {
+            uint64 fenceValue;
+            std::vector<uint32> pages;
+        };
+
+        uint32 m_base;
+        uint32 m_pageCount;
+        uint32 m_pageSize;
+        uint64 m_fenceValue = 0;
+
+        mutable std::mutex m_mutex;
+        std::vector<uint32> m_freePages;
+        std::vector<uint32> m_framePages;
+        std::deque<RetiredPages> m_retired;
+        uint64 m_failures = 0;
+    };
+}
+
+#endif // !_GINA_DESCRIPTOR_ALLOCATOR_H_
@@ -0,0 +1,93 @@
+#ifndef _GINA_FRAME_RING_H_
+#define _GINA_FRAME_RING_H_
+
+#include <memory>
+#include <vector>
+
+#include "core/gina_constants.h"
+#include "core/gina_non_copyable.h"
+#include "rhi/gina_rhi.h"
+
+namespace gina
+{
+    constexpr uint32 MAX_FRAMES_IN_FLIGHT = 8;
+
+    struct FrameRingSettings
+    {
+        // Frames the CPU may record ahead of the GPU; 1 serializes them like a flush every frame
+        uint32 framesInFlight = BUFFER_COUNT;
+        RHIQueueType queue = RHIQueueType::Graphics;
+    };
+
+    struct FrameRingStats
+    {
+        uint64 frames = 0;
+        uint64 cpuWaits = 0;            // BeginFrame calls that blocked on the GPU
+        double cpuWaitTime = 0.0;       // milliseconds blocked, measured on the steady clock
+        double maxCpuWaitTime = 0.0;
+    };
+
+    // Per frame state recycled once the GPU is past the frame's fence value
+    struct FrameContext
+    {
+        std::unique_ptr<RHICommandAllocator> allocator;
+        uint64 fenceValue = 0;          // value signaled at the end of the frame, 0 before the first use
+        uint64 frameNumber = 0;
+        std::vector<RHIResourceHandle> releases;
+    };
+
+    /**
+     * Ring of frame contexts pacing the CPU against the GPU
+     *
+     * EndFrame signals the ring's fence after the frame's submissions and records the value in the
+     * frame's context. BeginFrame picks the next context and only blocks if the GPU has not reached
+     * that context's value yet, i.e. when the CPU is framesInFlight frames ahead, then resets its
+     * allocator and destroys the resources released during it. Everything else keeps running, unlike
+     * a flush that drains the queue every frame.
+     */
+    class FrameRing : public NonCopyable
+    {
+    public:
+        explicit FrameRing(RHIDevice& device, const FrameRingSettings& settings = {});
+        ~FrameRing();
+
+        const FrameRingSettings& GetSettings() const noexcept { return m_settings; }
+        uint32 GetFramesInFlight() const noexcept { return m_settings.framesInFlight; }
+
+        FrameContext& BeginFrame();
+        void EndFrame();
+
+        // Waits for every frame in flight and recycles all contexts
+        void Flush();
+
+        FrameContext& GetCurrentFrame() noexcept { return m_frames[m_frameIndex]; }
+        uint32 GetFrameIndex() const noexcept { return m_frameIndex; }
+        uint64 GetFrameNumber() const noexcept { return m_frameNumber; }
+
+        // Value the current frame signals at EndFrame; work tagged with it is done once GetCompletedValue reaches it
+        uint64 GetCurrentFenceValue() const noexcept { return m_fence->GetLastSignaledValue() + 1; }
+        uint64 GetCompletedValue() const { return m_fence->GetCompletedValue(); }
+        RHIFence& GetFence() noexcept { return *m_fence; }
+
+        // Destroys a resource once the GPU finished the current frame, or the last ended one between frames
+        void DeferRelease(RHIResourceHandle resource);
+
+        const FrameRingStats& GetStats() const noexcept { return m_stats; }
+        void ResetStats() noexcept { m_stats = FrameRingStats(); }
+
+    private:
+        void WaitForFrame(FrameContext& frame);
+        void Recycle(FrameContext& frame);
+
+        RHIDevice* m_device;
+        FrameRingSettings m_settings;
+        std::unique_ptr<RHIFence> m_fence;
+        std::vector<FrameContext> m_frames;
+        uint32 m_frameIndex = 0;
+        uint64 m_frameNumber = 0;
+        bool m_recording = false;
+        FrameRingStats m_stats;
+    };
+}
+
+#endif // !_GINA_FRAME_RING_H_
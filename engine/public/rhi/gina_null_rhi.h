@@ -0,0 +1,267 @@
+#ifndef _GINA_NULL_RHI_H_
+#define _GINA_NULL_RHI_H_
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "core/gina_non_copyable.h"
+#include "rhi/gina_rhi.h"
+
+namespace gina
+{
+    struct NullDeviceSettings
+    {
+        // Simulated GPU time of each submitted batch and of each command in it, in milliseconds
+        double submissionTime = 0.0;
+        double commandTime = 0.0;
+
+        // Real time sleeps through CPU waits, for measuring pipelining; virtual time jumps over them
+        // instantly, so tests are deterministic and fast
+        bool realTime = false;
+
+        // Copy submitted commands into the queue's stream; off when only the timing matters
+        bool recordCommands = true;
+    };
+
+    struct NullDeviceStats
+    {
+        uint64 submissions = 0;
+        uint64 commands = 0;
+        uint64 cpuWaits = 0;            // WaitOnCPU calls that had to block
+        double cpuWaitTime = 0.0;       // milliseconds spent blocked, simulated or real
+        uint64 unsafeAllocatorResets = 0; // allocators reset while the GPU could still be reading them
+        uint64 liveResources = 0;
+        uint64 residentBytes = 0;
+    };
+
+    enum class NullCommandType : uint8
+    {
+        Barrier,
+        CopyBuffer,
+        CopyBufferToTexture,
+        CopyTexture,
+        SetIndexBuffer,
+        SetConstants,
+        Draw,
+        DrawIndexed,
+        Dispatch
+    };
+
+    /**
+     * One recorded command
+     *
+     * Barrier commands reference args[1] barriers starting at args[0] in the owning barrier array and
+     * SetConstants args[2] values starting at args[0] in the constant array, with the slot in args[1].
+     * Other commands keep their parameters in order in resources, offsets and args.
+     */
+    struct NullCommand
+    {
+        NullCommandType type = NullCommandType::Draw;
+        uint32 list = 0;                // id of the recording list
+        uint32 submission = 0;          // index of the submission that executed it, once submitted
+        RHIResourceHandle resources[2];
+        uint64 offsets[3] = {};
+        uint32 args[5] = {};
+    };
+
+    // Commands of one list or of everything a queue executed, in order
+    struct NullCommandStream
+    {
+        std::vector<NullCommand> commands;
+        std::vector<RHIBarrier> barriers;
+        std::vector<uint32> constants;
+
+        void Clear() noexcept;
+        void Append(const NullCommandStream& other, uint32 submission);
+        uint32 Count(NullCommandType type) const noexcept;
+    };
+
+    class NullDevice;
+
+    class NullFence final : public RHIFence, public NonCopyable
+    {
+    public:
+        explicit NullFence(NullDevice& device) : m_device(&device) {}
+
+        uint64 GetCompletedValue() const override;
+        uint64 GetLastSignaledValue() const override { return m_lastSignaled; }
+        void WaitOnCPU(uint64 value) override;
+
+        // Simulated time the value completes at; values not signaled yet never complete
+        double GetCompletionTime(uint64 value) const;
+
+    private:
+        friend class NullQueue;
+
+        struct PendingValue
+        {
+            uint64 value;
+            double time;
+        };
+
+        NullDevice* m_device;
+        uint64 m_lastSignaled = 0;
+        mutable uint64 m_completed = 0;
+        mutable std::deque<PendingValue> m_pending;
+    };
+
+    class NullCommandAllocator final : public RHICommandAllocator, public NonCopyable
+    {
+    public:
+        explicit NullCommandAllocator(NullDevice& device) : m_device(&device) {}
+
+        void Reset() override;
+        uint32 GetResetCount() const noexcept { return m_resetCount; }
+
+    private:
+        friend class NullQueue;
+
+        NullDevice* m_device;
+        double m_busyUntil = 0.0;       // GPU completion time of the last submission using it
+        uint32 m_resetCount = 0;
+    };
+
+    class NullCommandList final : public RHICommandList, public NonCopyable
+    {
+    public:
+        explicit NullCommandList(uint32 id) : m_id(id) {}
+
+        uint32 GetId() const noexcept { return m_id; }
+        bool IsRecording() const noexcept { return m_recording; }
+        const NullCommandStream& GetStream() const noexcept { return m_stream; }
+        NullCommandAllocator* GetAllocator() const noexcept { return m_allocator; }
+
+        void Begin(RHICommandAllocator& allocator) override;
+        void End() override;
+
+        void Barrier(const RHIBarrier* barriers, uint32 count) override;
+        void CopyBuffer(RHIBufferHandle destination, uint64 destinationOffset, RHIBufferHandle source, uint64 sourceOffset,
+            uint64 size) override;
+        void CopyBufferToTexture(RHITextureHandle destination, uint32 subresource, RHIBufferHandle source, uint64 sourceOffset) override;
+        void CopyTexture(RHITextureHandle destination, uint32 destinationSubresource, RHITextureHandle source, uint32 sourceSubresource) override;
+        void SetIndexBuffer(RHIBufferHandle buffer, uint64 offset, uint32 size, bool wideIndices) override;
+        void SetConstants(uint32 slot, const uint32* values, uint32 count) override;
+        void Draw(uint32 vertexCount, uint32 instanceCount, uint32 firstVertex, uint32 firstInstance) override;
+        void DrawIndexed(uint32 indexCount, uint32 instanceCount, uint32 firstIndex, int32 baseVertex, uint32 firstInstance) override;
+        void Dispatch(uint32 groupCountX, uint32 groupCountY, uint32 groupCountZ) override;
+
+    private:
+        NullCommand& Record(NullCommandType type);
+
+        uint32 m_id;
+        bool m_recording = false;
+        NullCommandAllocator* m_allocator = nullptr;
+        NullCommandStream m_stream;
+    };
+
+    // Executes submissions one after another on a simulated timeline and keeps the executed stream
+    class NullQueue final : public RHIQueue, public NonCopyable
+    {
+    public:
+        explicit NullQueue(NullDevice& device) : m_device(&device) {}
+
+        void Submit(RHICommandList* const* lists, uint32 count) override;
+        uint64 Signal(RHIFence& fence) override;
+        void Wait(RHIFence& fence, uint64 value) override;
+
+        const NullCommandStream& GetStream() const noexcept { return m_stream; }
+        void ClearStream() noexcept { m_stream.Clear(); }
+        uint32 GetSubmissionCount() const noexcept { return m_submissionCount; }
+
+        // Simulated time the GPU finishes everything submitted so far
+        double GetBusyUntil() const noexcept { return m_busyUntil; }
+
+    private:
+        NullDevice* m_device;
+        NullCommandStream m_stream;
+        uint32 m_submissionCount = 0;
+        double m_busyUntil = 0.0;
+    };
+
+    /**
+     * Headless backend for tests and benchmarks on machines without a GPU
+     *
+     * Every queue is a serial GPU timeline: a submission starts when the queue is idle and the CPU has
+     * submitted it, and lasts submissionTime plus commandTime per command. Fences complete when the
+     * timeline passes their signal. The clock is either real (steady clock, CPU waits sleep) or virtual
+     * (advanced by AdvanceTime to stand in for CPU work, CPU waits jump ahead), with times in
+     * milliseconds. Upload and readback buffers and heaps get CPU memory; other resources only count their
+     * size, and placed resources count nothing beyond their heap.
+     */
+    class NullDevice final : public RHIDevice, public NonCopyable
+    {
+    public:
+        explicit NullDevice(const NullDeviceSettings& settings = {});
+
+        RHIBufferHandle CreateBuffer(const RHIBufferDesc& desc) override;
+        RHITextureHandle CreateTexture(const RHITextureDesc& desc) override;
+        RHIHeapHandle CreateHeap(const RHIHeapDesc& desc) override;
+        RHIBufferHandle CreatePlacedBuffer(RHIHeapHandle heap, uint64 offset, const RHIBufferDesc& desc) override;
+        RHITextureHandle CreatePlacedTexture(RHIHeapHandle heap, uint64 offset, const RHITextureDesc& desc) override;
+        uint64 GetPlacedTextureSize(const RHITextureDesc& desc) const override;
+        void DestroyResource(RHIResourceHandle resource) override;
+        void* Map(RHIBufferHandle buffer) override;
+
+        std::unique_ptr<RHIFence> CreateFence() override;
+        std::unique_ptr<RHICommandAllocator> CreateCommandAllocator(RHIQueueType type) override;
+        std::unique_ptr<RHICommandList> CreateCommandList(RHIQueueType type) override;
+        RHIQueue& GetQueue(RHIQueueType type) override;
+
+        NullQueue& GetNullQueue(RHIQueueType type) noexcept { return *m_queues[static_cast<uint32>(type)]; }
+        const NullDeviceSettings& GetSettings() const noexcept { return m_settings; }
+        const RHIBufferDesc* GetBufferDesc(RHIBufferHandle buffer) const noexcept;
+        const RHITextureDesc* GetTextureDesc(RHITextureHandle texture) const noexcept;
+
+        // Heap and offset of a placed resource, an invalid heap for any other
+        RHIHeapHandle GetPlacedHeap(RHIResourceHandle resource, uint64& offset) const noexcept;
+
+        NullDeviceStats GetStats() const;
+        void ResetStats();
+
+        double GetTime() const;
+
+        // Moves the virtual clock forward, standing in for CPU work; ignored with a real time clock
+        void AdvanceTime(double milliseconds);
+
+    private:
+        friend class NullFence;
+        friend class NullCommandAllocator;
+        friend class NullQueue;
+
+        // Blocks until the clock reaches time and accounts the wait
+        void WaitUntil(double time);
+        double GetTimeLocked() const;
+
+        struct Resource
+        {
+            bool alive = false;
+            bool texture = false;
+            RHIBufferDesc buffer;
+            RHITextureDesc textureDesc;
+            uint64 size = 0;                // resident bytes; placed resources count in their heap
+            std::vector<byte> memory;
+            bool heap = false;
+            RHIHeapHandle placedHeap;
+            uint64 heapOffset = 0;
+        };
+
+        RHIResourceHandle AddResource(Resource&& resource);
+
+        // Checks a placement and, for mappable heaps, leaves nothing to allocate
+        void Place(Resource& resource, RHIHeapHandle heap, uint64 offset, uint64 size) const;
+
+        NullDeviceSettings m_settings;
+        std::unique_ptr<NullQueue> m_queues[static_cast<uint32>(RHIQueueType::Count)];
+
+        mutable std::mutex m_mutex;     // resources, stats and the clock, for recording and streaming threads
+        std::vector<Resource> m_resources;
+        std::vector<uint32> m_freeResources;
+        NullDeviceStats m_stats;
+        uint32 m_nextListId = 0;
+        double m_virtualTime = 0.0;
+        double m_startTime = 0.0;
+    };
+}
+
+#endif // !_GINA_NULL_RHI_H_
@@ -0,0 +1,230 @@
+#ifndef _GINA_PIPELINE_CACHE_H_
+#define _GINA_PIPELINE_CACHE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/gina_binary_stream.h"
+#include "core/gina_non_copyable.h"
+#include "rhi/gina_rhi.h"
+
+namespace gina
+{
+    constexpr uint32 PIPELINE_CACHE_MAGIC = 0x4F535047; // "GPSO"
+    constexpr uint32 PIPELINE_CACHE_VERSION = 2;
+    constexpr uint32 MAX_PIPELINE_RENDER_TARGETS = 8;
+
+    using RHIPipelineHandle = RHIResourceHandle;
+
+    enum class PipelineTopology : uint8
+    {
+        TriangleList,
+        TriangleStrip,
+        LineList,
+        PointList
+    };
+
+    enum class PipelineCullMode : uint8
+    {
+        None,
+        Front,
+        Back
+    };
+
+    enum class PipelineCompare : uint8
+    {
+        Never,
+        Less,
+        LessEqual,
+        Equal,
+        GreaterEqual,
+        Greater,
+        Always
+    };
+
+    enum class PipelineBlendFactor : uint8
+    {
+        Zero,
+        One,
+        SourceAlpha,
+        InverseSourceAlpha,
+        SourceColor,
+        InverseSourceColor,
+        DestinationAlpha,
+        InverseDestinationAlpha
+    };
+
+    enum class PipelineBlendOp : uint8
+    {
+        Add,
+        Subtract,
+        Min,
+        Max
+    };
+
+    struct PipelineRasterState
+    {
+        PipelineCullMode cullMode = PipelineCullMode::Back;
+        bool wireframe = false;
+        bool frontCounterClockwise = false;
+        bool depthClip = true;
+        int32 depthBias = 0;
+        float slopeScaledDepthBias = 0.0f;
+    };
+
+    struct PipelineDepthState
+    {
+        bool test = true;
+        bool write = true;
+        PipelineCompare compare = PipelineCompare::GreaterEqual;    // reversed Z
+    };
+
+    struct PipelineBlendState
+    {
+        bool enable = false;
+        PipelineBlendFactor source = PipelineBlendFactor::One;
+        PipelineBlendFactor destination = PipelineBlendFactor::Zero;
+        PipelineBlendOp op = PipelineBlendOp::Add;
+        PipelineBlendFactor sourceAlpha = PipelineBlendFactor::One;
+        PipelineBlendFactor destinationAlpha = PipelineBlendFactor::Zero;
+        PipelineBlendOp alphaOp = PipelineBlendOp::Add;
+        uint8 writeMask = 0xF;
+    };
+
+    /**
+     * Everything a pipeline state object is created from, by value
+     *
+     * Shaders and the root signature are referenced by the hash of their bytecode, so the description
+     * stays small and the same shader built twice keys the same pipeline. A compute pipeline only sets
+     * computeShader and rootSignature.
+     */
+    struct PipelineDesc
+    {
+        uint64 vertexShader = 0;
+        uint64 pixelShader = 0;
+        uint64 computeShader = 0;
+        uint64 rootSignature = 0;
+
+        PipelineTopology topology = PipelineTopology::TriangleList;
+        uint32 renderTargetCount = 0;
+        RHIFormat renderTargetFormats[MAX_PIPELINE_RENDER_TARGETS] = {};
+        RHIFormat depthFormat = RHIFormat::Unknown;
+        uint32 sampleCount = 1;
+
+        PipelineRasterState raster;
+        PipelineDepthState depth;
+        PipelineBlendState blend[MAX_PIPELINE_RENDER_TARGETS];
+    };
+
+    // Hash of the fields that matter, one by one: unused render target slots and padding never change it
+    uint64 HashPipelineDesc(const PipelineDesc& desc) noexcept;
+
+    // Equality over the fields HashPipelineDesc reads
+    bool IsSamePipelineDesc(const PipelineDesc& a, const PipelineDesc& b) noexcept;
+
+    /**
+     * What a backend does to create a pipeline; called from several threads at once
+     *
+     * cachedBlob holds what an earlier run persisted for this description (ID3D12PipelineState::GetCachedBlob
+     * on D3D12), empty when there is none; the backend should fall back to a full compile when the driver
+     * refuses it. blob receives what to persist for the next run.
+     */
+    class PipelineCompiler
+    {
+    public:
+        virtual ~PipelineCompiler() = default;
+
+        virtual RHIPipelineHandle CreatePipeline(const PipelineDesc& desc, const std::vector<byte>& cachedBlob, std::vector<byte>& blob) = 0;
+    };
+
+    struct PipelineCacheStats
+    {
+        uint64 hits = 0;                // lookups that found the pipeline created
+        uint64 misses = 0;              // lookups that had to create it on the spot
+        uint64 prewarmed = 0;           // created by the prewarm threads
+        uint64 blobCreates = 0;         // created from a persisted blob rather than from scratch
+        uint32 loadedEntries = 0;
+        uint32 rejectedEntries = 0;     // in the file but no longer matching their key
+        uint32 collisions = 0;          // descriptions whose hash was already taken by another one
+        double createTime = 0.0;        // ms spent creating pipelines, on every thread
+        double stallTime = 0.0;         // ms lookups spent creating or waiting for a pipeline
+        double hitchTimeAvoided = 0.0;  // creation time prewarming took off the first use of each pipeline
+    };
+
+    /**
+     * Pipelines by hash of their description, persisted across runs
+     *
+     * Load reads the versioned cache file of the previous run: the descriptions used and the blobs the
+     * backend produced for them. Files from another cache version or another device are dropped whole.
+     * BeginPrewarm then creates all of those pipelines on its own threads, so by the time a draw asks for
+     * one with GetPipeline it is usually there; a lookup of a pipeline still being prewarmed waits for it
+     * rather than creating it twice, and one never seen before is created on the calling thread and ends
+     * up in the next Save. Thread safe.
+     */
+    class PipelineCache : public NonCopyable
+    {
+    public:
+        // deviceId identifies the adapter and driver the blobs are valid for
+        PipelineCache(PipelineCompiler& compiler, uint64 deviceId);
+        ~PipelineCache();
+
+        bool Load(const std::string& fileName);
+        bool Save(const std::string& fileName) const;
+
+        void Serialize(BinaryWriter& writer) const;
+        bool Deserialize(BinaryReader& reader);
+
+        // Creates every loaded pipeline nobody asked for yet on threadCount threads and returns right away
+        void BeginPrewarm(uint32 threadCount);
+        void WaitForPrewarm();
+
+        RHIPipelineHandle GetPipeline(const PipelineDesc& desc);
+
+        uint32 GetEntryCount() const;
+        PipelineCacheStats GetStats() const;
+
+    private:
+        enum class EntryState : uint8
+        {
+            Pending,        // known from the file, not created yet
+            Creating,
+            Ready
+        };
+
+        struct Entry
+        {
+            PipelineDesc desc;
+            std::vector<byte> blob;
+            RHIPipelineHandle pipeline;
+            EntryState state = EntryState::Pending;
+            bool prewarmed = false;
+            double createTime = 0.0;
+        };
+
+        // Entry of desc under its hash, or the next free key when another description holds it; with the lock held
+        Entry& FindEntry(const PipelineDesc& desc, bool& inserted);
+
+        // Creates the pipeline of an entry claimed as Creating, without holding the lock
+        void Create(Entry& entry, bool prewarm);
+        void PrewarmLoop();
+
+        PipelineCompiler& m_compiler;
+        uint64 m_deviceId;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_createdCondition;
+        std::unordered_map<uint64, Entry> m_entries;    // nodes stay put, so entries are used outside the lock
+        PipelineCacheStats m_stats;
+
+        std::vector<uint64> m_prewarmKeys;
+        std::atomic<uint32> m_nextPrewarm{ 0 };
+        std::vector<std::thread> m_prewarmThreads;
+    };
+}
+
+#endif // !_GINA_PIPELINE_CACHE_H_
@@ -0,0 +1,78 @@
+#ifndef _GINA_RESOURCE_STATE_TRACKER_H_
+#define _GINA_RESOURCE_STATE_TRACKER_H_
+
+#include <vector>
+
+#include "rhi/gina_rhi.h"
+
+namespace gina
+{
+    struct ResourceStateTrackerStats
+    {
+        uint64 barriers = 0;            // emitted, split halves counted separately
+        uint64 batches = 0;             // Barrier calls
+        uint64 splitBarriers = 0;       // transitions issued as begin/end pairs
+        uint64 elidedTransitions = 0;   // uses that needed no barrier or merged into a pending one
+    };
+
+    /**
+     * Current state of every registered resource, per subresource, and the barriers to move them
+     *
+     * Passes declare how they use resources with Use; the tracker compares against the tracked state
+     * and collects the minimal transitions: nothing when the state already covers the use, read states
+     * merged into one combined read state, UAV barriers between unordered access uses, per subresource
+     * barriers only where subresources differ. Flush then issues everything collected as one Barrier
+     * call at the pass boundary. BeginTransition starts a split barrier right after the producing pass
+     * when the next use is known, and the matching Use ends it, giving the GPU the passes in between
+     * to do the transition.
+     *
+     * Tracking follows submission order on one queue, so uses are declared on the thread that orders
+     * the passes.
+     */
+    class ResourceStateTracker
+    {
+    public:
+        void Register(RHIResourceHandle resource, uint32 subresourceCount, RHIResourceState state);
+        void Unregister(RHIResourceHandle resource);
+
+        bool IsRegistered(RHIResourceHandle resource) const noexcept;
+        RHIResourceState GetState(RHIResourceHandle resource, uint32 subresource = 0) const noexcept;
+
+        void Use(RHIResourceHandle resource, RHIResourceState state, uint32 subresource = ALL_RHI_SUBRESOURCES);
+
+        // Begins moving a whole resource to state; the Use that needs it ends the transition
+        void BeginTransition(RHIResourceHandle resource, RHIResourceState state);
+
+        const std::vector<RHIBarrier>& GetPendingBarriers() const noexcept { return m_pending; }
+
+        // Issues the collected barriers in one call and returns their count
+        uint32 Flush(RHICommandList& list);
+
+        // Same, appending the batch to barriers instead, for recording ahead of execution
+        uint32 Flush(std::vector<RHIBarrier>& barriers);
+
+        const ResourceStateTrackerStats& GetStats() const noexcept { return m_stats; }
+
+    private:
+        struct TrackedResource
+        {
+            bool registered = false;
+            bool splitPending = false;
+            uint32 subresourceCount = 1;
+            RHIResourceState splitState = RHIResourceState::Common;
+            std::vector<RHIResourceState> states;   // one entry while all subresources share a state
+            uint64 batch = 0;                       // last batch it has pending barriers in
+        };
+
+        void Transition(RHIResourceHandle resource, TrackedResource& tracked, uint32 subresource, RHIResourceState state);
+        void AddBarrier(TrackedResource& tracked, const RHIBarrier& barrier);
+        void EndSplit(RHIResourceHandle resource, TrackedResource& tracked);
+
+        std::vector<TrackedResource> m_resources;   // by handle id
+        std::vector<RHIBarrier> m_pending;
+        uint64 m_batch = 1;
+        ResourceStateTrackerStats m_stats;
+    };
+}
+
+#endif // !_GINA_RESOURCE_STATE_TRACKER_H_
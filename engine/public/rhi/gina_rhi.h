@@ -0,0 +1,285 @@
+#ifndef _GINA_RHI_H_
+#define _GINA_RHI_H_
+
+#include <memory>
+#include <string>
+
+#include "core/gina_types.h"
+
+namespace gina
+{
+    constexpr uint32 INVALID_RHI_RESOURCE = 0xFFFFFFFF;
+    constexpr uint32 ALL_RHI_SUBRESOURCES = 0xFFFFFFFF;
+
+    // Buffer to texture copies read rows at this pitch alignment, from offsets at the placement alignment
+    constexpr uint32 RHI_TEXTURE_ROW_ALIGNMENT = 256;
+    constexpr uint32 RHI_TEXTURE_PLACEMENT_ALIGNMENT = 512;
+
+    // Resources placed in a heap start at offsets aligned to this
+    constexpr uint64 RHI_HEAP_PLACEMENT_ALIGNMENT = 65536;
+
+    // Buffers and textures share one id space, so barriers and state tracking treat them alike
+    struct RHIResourceHandle
+    {
+        uint32 id = INVALID_RHI_RESOURCE;
+
+        bool IsValid() const noexcept { return id != INVALID_RHI_RESOURCE; }
+        bool operator==(const RHIResourceHandle& other) const noexcept { return id == other.id; }
+        bool operator!=(const RHIResourceHandle& other) const noexcept { return id != other.id; }
+    };
+
+    using RHIBufferHandle = RHIResourceHandle;
+    using RHITextureHandle = RHIResourceHandle;
+    using RHIHeapHandle = RHIResourceHandle;
+
+    enum class RHIQueueType : uint8
+    {
+        Graphics,
+        Compute,
+        Copy,
+        Count
+    };
+
+    enum class RHIMemoryType : uint8
+    {
+        Default,    // GPU only
+        Upload,     // CPU writes, persistently mapped
+        Readback    // CPU reads, persistently mapped
+    };
+
+    enum class RHIFormat : uint8
+    {
+        Unknown,
+        R8Unorm,
+        R8G8Unorm,
+        R8G8B8A8Unorm,
+        R8G8B8A8Srgb,
+        R16G16B16A16Float,
+        R32Float,
+        R32G32B32A32Float,
+        R32Uint,
+        D32Float,
+        D24S8,
+        BC1Unorm,
+        BC1Srgb,
+        BC5Unorm,
+        BC7Unorm,
+        BC7Srgb,
+        BC4Unorm
+    };
+
+    // Texels per block side (1 for uncompressed formats) and bytes per block
+    struct RHIFormatInfo
+    {
+        uint32 blockSize = 1;
+        uint32 bytesPerBlock = 0;
+    };
+
+    enum class RHITextureUsage : uint8
+    {
+        ShaderResource = 1 << 0,
+        RenderTarget = 1 << 1,
+        DepthStencil = 1 << 2,
+        UnorderedAccess = 1 << 3
+    };
+
+    inline RHITextureUsage operator|(RHITextureUsage a, RHITextureUsage b) noexcept
+    {
+        return static_cast<RHITextureUsage>(static_cast<uint8>(a) | static_cast<uint8>(b));
+    }
+    inline bool HasUsage(RHITextureUsage usage, RHITextureUsage flag) noexcept
+    {
+        return (static_cast<uint8>(usage) & static_cast<uint8>(flag)) != 0;
+    }
+
+    // Resource states as bit flags; read states may be combined, write states stand alone
+    enum class RHIResourceState : uint32
+    {
+        Common = 0,
+        VertexBuffer = 1 << 0,
+        IndexBuffer = 1 << 1,
+        ConstantBuffer = 1 << 2,
+        ShaderResource = 1 << 3,
+        IndirectArgument = 1 << 4,
+        CopySource = 1 << 5,
+        DepthRead = 1 << 6,
+        RenderTarget = 1 << 7,
+        UnorderedAccess = 1 << 8,
+        DepthWrite = 1 << 9,
+        CopyDest = 1 << 10,
+        Present = 1 << 11
+    };
+
+    constexpr uint32 RHI_READ_STATES = (1u << 7) - 1;
+
+    inline RHIResourceState operator|(RHIResourceState a, RHIResourceState b) noexcept
+    {
+        return static_cast<RHIResourceState>(static_cast<uint32>(a) | static_cast<uint32>(b));
+    }
+    inline bool IsReadOnlyState(RHIResourceState state) noexcept
+    {
+        return (static_cast<uint32>(state) & ~RHI_READ_STATES) == 0;
+    }
+
+    enum class RHIBarrierFlags : uint8
+    {
+        None,
+        BeginOnly,  // first half of a split barrier, letting the GPU start the transition early
+        EndOnly,    // second half, where the resource is next used
+        Aliasing    // the resource takes over placed memory another one used before; states are ignored
+    };
+
+    struct RHIBarrier
+    {
+        RHIResourceHandle resource;
+        RHIResourceState before = RHIResourceState::Common;
+        RHIResourceState after = RHIResourceState::Common;
+        uint32 subresource = ALL_RHI_SUBRESOURCES;
+        RHIBarrierFlags flags = RHIBarrierFlags::None;
+
+        bool operator==(const RHIBarrier& other) const noexcept
+        {
+            return resource == other.resource && before == other.before && after == other.after &&
+                subresource == other.subresource && flags == other.flags;
+        }
+    };
+
+    struct RHIBufferDesc
+    {
+        uint64 size = 0;
+        RHIMemoryType memory = RHIMemoryType::Default;
+        bool unorderedAccess = false;
+        std::string name;
+    };
+
+    struct RHITextureDesc
+    {
+        uint32 width = 1;
+        uint32 height = 1;
+        uint32 arraySize = 1;
+        uint32 mipLevels = 1;
+        RHIFormat format = RHIFormat::R8G8B8A8Unorm;
+        RHITextureUsage usage = RHITextureUsage::ShaderResource;
+        std::string name;
+    };
+
+    // Memory that placed buffers and textures of any kind share; placed resources may overlap in time
+    struct RHIHeapDesc
+    {
+        uint64 size = 0;
+        RHIMemoryType memory = RHIMemoryType::Default;
+        std::string name;
+    };
+
+    RHIFormatInfo GetFormatInfo(RHIFormat format) noexcept;
+
+    // Tightly packed bytes of one mip level, and of the whole texture (every mip of every array slice)
+    uint64 GetMipSize(RHIFormat format, uint32 width, uint32 height) noexcept;
+    uint64 GetTextureSize(const RHITextureDesc& desc) noexcept;
+
+    // Layout of a mip in an upload buffer for CopyBufferToTexture: rows of blocks at an aligned pitch
+    uint32 GetUploadRowPitch(RHIFormat format, uint32 width) noexcept;
+    uint64 GetUploadMipSize(RHIFormat format, uint32 width, uint32 height) noexcept;
+
+    class RHIFence
+    {
+    public:
+        virtual ~RHIFence() = default;
+
+        virtual uint64 GetCompletedValue() const = 0;
+        virtual uint64 GetLastSignaledValue() const = 0;
+
+        // Blocks the calling thread until the fence reaches value
+        virtual void WaitOnCPU(uint64 value) = 0;
+    };
+
+    // Memory backing recorded commands; only reset once the GPU finished every list recorded into it
+    class RHICommandAllocator
+    {
+    public:
+        virtual ~RHICommandAllocator() = default;
+
+        virtual void Reset() = 0;
+    };
+
+    class RHICommandList
+    {
+    public:
+        virtual ~RHICommandList() = default;
+
+        // Starts recording into allocator, discarding anything recorded before
+        virtual void Begin(RHICommandAllocator& allocator) = 0;
+        virtual void End() = 0;
+
+        virtual void Barrier(const RHIBarrier* barriers, uint32 count) = 0;
+        virtual void CopyBuffer(RHIBufferHandle destination, uint64 destinationOffset, RHIBufferHandle source, uint64 sourceOffset,
+            uint64 size) = 0;
+
+        // Source data is the subresource's mip laid out as GetUploadRowPitch rows, starting at a
+        // RHI_TEXTURE_PLACEMENT_ALIGNMENT aligned sourceOffset
+        virtual void CopyBufferToTexture(RHITextureHandle destination, uint32 subresource, RHIBufferHandle source, uint64 sourceOffset) = 0;
+
+        // Whole subresource to a subresource of the same size and format in another texture
+        virtual void CopyTexture(RHITextureHandle destination, uint32 destinationSubresource, RHITextureHandle source, uint32 sourceSubresource) = 0;
+
+        virtual void SetIndexBuffer(RHIBufferHandle buffer, uint64 offset, uint32 size, bool wideIndices) = 0;
+        virtual void SetConstants(uint32 slot, const uint32* values, uint32 count) = 0;
+        virtual void Draw(uint32 vertexCount, uint32 instanceCount, uint32 firstVertex, uint32 firstInstance) = 0;
+        virtual void DrawIndexed(uint32 indexCount, uint32 instanceCount, uint32 firstIndex, int32 baseVertex, uint32 firstInstance) = 0;
+        virtual void Dispatch(uint32 groupCountX, uint32 groupCountY, uint32 groupCountZ) = 0;
+    };
+
+    class RHIQueue
+    {
+    public:
+        virtual ~RHIQueue() = default;
+
+        // Executes closed lists in order, as one batch
+        virtual void Submit(RHICommandList* const* lists, uint32 count) = 0;
+
+        // Signals the fence's next value once everything submitted so far completes, and returns that value
+        virtual uint64 Signal(RHIFence& fence) = 0;
+
+        // Makes later submissions on this queue wait for the fence to reach value, without blocking the CPU
+        virtual void Wait(RHIFence& fence, uint64 value) = 0;
+    };
+
+    /**
+     * Backend independent device
+     *
+     * Frame orchestration is written against these interfaces, so it runs on the D3D12 backend or on
+     * the headless null backend that records commands and simulates the GPU timeline. Resources are
+     * plain handles owned by the device; fences, allocators and lists are owned by their creator.
+     */
+    class RHIDevice
+    {
+    public:
+        virtual ~RHIDevice() = default;
+
+        virtual RHIBufferHandle CreateBuffer(const RHIBufferDesc& desc) = 0;
+        virtual RHITextureHandle CreateTexture(const RHITextureDesc& desc) = 0;
+
+        // Placed resources live at an RHI_HEAP_PLACEMENT_ALIGNMENT aligned offset of a heap and own no memory;
+        // the heap outlives them. Resources sharing bytes need an aliasing barrier before each takes over
+        virtual RHIHeapHandle CreateHeap(const RHIHeapDesc& desc) = 0;
+        virtual RHIBufferHandle CreatePlacedBuffer(RHIHeapHandle heap, uint64 offset, const RHIBufferDesc& desc) = 0;
+        virtual RHITextureHandle CreatePlacedTexture(RHIHeapHandle heap, uint64 offset, const RHITextureDesc& desc) = 0;
+
+        // Bytes a placed texture takes in a heap, before aligning its end
+        virtual uint64 GetPlacedTextureSize(const RHITextureDesc& desc) const = 0;
+
+        // Heaps, buffers and textures alike
+        virtual void DestroyResource(RHIResourceHandle resource) = 0;
+
+        // Persistent CPU pointer to an upload or readback buffer
+        virtual void* Map(RHIBufferHandle buffer) = 0;
+
+        virtual std::unique_ptr<RHIFence> CreateFence() = 0;
+        virtual std::unique_ptr<RHICommandAllocator> CreateCommandAllocator(RHIQueueType type) = 0;
+        virtual std::unique_ptr<RHICommandList> CreateCommandList(RHIQueueType type) = 0;
+
+        virtual RHIQueue& GetQueue(RHIQueueType type) = 0;
+    };
+}
+
+#endif // !_GINA_RHI_H_
@@ -0,0 +1,112 @@
+#ifndef _GINA_UPLOAD_RING_H_
+#define _GINA_UPLOAD_RING_H_
+
+#include <deque>
+
+#include "core/gina_non_copyable.h"
+#include "rhi/gina_rhi.h"
+
+namespace gina
+{
+    // Constant buffer views must start at multiples of this
+    constexpr uint64 UPLOAD_RING_ALIGNMENT = 256;
+
+    /**
+     * Offset bookkeeping of a ring buffer whose regions are freed by fence value
+     *
+     * Allocations advance the head; Retire tags everything allocated since the previous Retire with the
+     * fence value the GPU signals after using it, and Reclaim moves the tail past every region whose
+     * value completed. An allocation that would cross the end of the ring starts over at offset 0, so
+     * regions are always contiguous. Head and tail are monotonic byte positions; offsets are positions
+     * modulo the capacity.
+     */
+    class RingAllocator
+    {
+    public:
+        explicit RingAllocator(uint64 capacity) : m_capacity(capacity) {}
+
+        uint64 GetCapacity() const noexcept { return m_capacity; }
+        uint64 GetUsedSize() const noexcept { return m_head - m_tail; }
+
+        // False when the free space cannot hold the aligned allocation; alignment must be a power of two
+        bool Allocate(uint64 size, uint64 alignment, uint64& offset) noexcept;
+
+        void Retire(uint64 fenceValue);
+        void Reclaim(uint64 completedValue) noexcept;
+
+        // Fence value freeing the oldest retired region, 0 when nothing waits for the GPU
+        uint64 GetOldestFenceValue() const noexcept { return m_retired.empty() ? 0 : m_retired.front().fenceValue; }
+
+    private:
+        struct RetiredRegion
+        {
+            uint64 fenceValue;
+            uint64 end;                 // head when it was retired
+        };
+
+        uint64 m_capacity;
+        uint64 m_head = 0;
+        uint64 m_tail = 0;
+        uint64 m_retiredHead = 0;
+        std::deque<RetiredRegion> m_retired;
+    };
+
+    struct UploadAllocation
+    {
+        RHIBufferHandle buffer;
+        uint64 offset = 0;
+        uint64 size = 0;
+        byte* data = nullptr;           // persistently mapped CPU address of offset
+
+        bool IsValid() const noexcept { return data != nullptr; }
+    };
+
+    struct UploadRingStats
+    {
+        uint64 allocations = 0;
+        uint64 bytes = 0;               // requested, without alignment padding
+        uint64 peakUsedSize = 0;        // padding included
+        uint64 stalls = 0;              // allocations that waited on the CPU for the GPU to free space
+        uint64 failures = 0;            // allocations larger than everything the GPU could free
+    };
+
+    /**
+     * Persistently mapped upload buffer for per frame data such as constants and skinning palettes
+     *
+     * One upload buffer is created and mapped up front, so per draw data never creates or maps
+     * resources. Allocations of a frame are retired with the frame's fence value at EndFrame and reused
+     * once it completes. When the ring is full, Allocate waits for the oldest frame instead of failing;
+     * only requests larger than the whole ring fail, without waiting.
+     */
+    class UploadRing : public NonCopyable
+    {
+    public:
+        UploadRing(RHIDevice& device, RHIFence& fence, uint64 capacity);
+        ~UploadRing();
+
+        RHIBufferHandle GetBuffer() const noexcept { return m_buffer; }
+        const RingAllocator& GetAllocator() const noexcept { return m_allocator; }
+
+        // Frees the regions of frames the GPU finished
+        void BeginFrame();
+
+        UploadAllocation Allocate(uint64 size, uint64 alignment = UPLOAD_RING_ALIGNMENT);
+        UploadAllocation Upload(const void* data, uint64 size, uint64 alignment = UPLOAD_RING_ALIGNMENT);
+
+        // Ties the frame's allocations to the fence value signaled after the commands reading them
+        void EndFrame(uint64 fenceValue);
+
+        const UploadRingStats& GetStats() const noexcept { return m_stats; }
+        void ResetStats() noexcept { m_stats = UploadRingStats(); }
+
+    private:
+        RHIDevice* m_device;
+        RHIFence* m_fence;
+        RHIBufferHandle m_buffer;
+        byte* m_data = nullptr;
+        RingAllocator m_allocator;
+        UploadRingStats m_stats;
+    };
+}
+
+#endif // !_GINA_UPLOAD_RING_H_
@@ -0,0 +1,44 @@
+#ifndef _GINA_BLOCK_COMPRESSION_H_
+#define _GINA_BLOCK_COMPRESSION_H_
+
+#include "core/gina_thread_pool.h"
+#include "core/gina_types.h"
+#include "rhi/gina_rhi.h"
+
+namespace gina
+{
+    constexpr uint32 BC_BLOCK_DIMENSION = 4;
+    constexpr uint32 BC_BLOCK_TEXELS = BC_BLOCK_DIMENSION * BC_BLOCK_DIMENSION;
+
+    // Single blocks. texels are the 16 RGBA8 texels of a 4x4 block, row by row
+
+    // Opaque color in 8 bytes: two 565 endpoints on the principal axis, four colors between them
+    void EncodeBC1Block(const uint8* texels, uint8* block) noexcept;
+    void DecodeBC1Block(const uint8* block, uint8* texels) noexcept;
+
+    // One channel in 8 bytes: two 8 bit endpoints, eight values between them
+    void EncodeBC4Block(const uint8* texels, uint32 channel, uint8* block) noexcept;
+    void DecodeBC4Block(const uint8* block, uint32 channel, uint8* texels) noexcept;
+
+    // Red and green as two BC4 blocks, for tangent space normals; decodes blue as 0 and alpha as 255
+    void EncodeBC5Block(const uint8* texels, uint8* block) noexcept;
+    void DecodeBC5Block(const uint8* block, uint8* texels) noexcept;
+
+    /**
+     * RGBA in 16 bytes, always as BC7 mode 6
+     *
+     * Mode 6 is the single subset mode with 7 bit endpoints, a parity bit per endpoint and 16 colors
+     * between them. It is the mode that fits smooth albedo and alpha best per unit of search, so the
+     * encoder fits the endpoints to the principal axis of the block, refines them by least squares and
+     * tries every parity bit combination. DecodeBC7Block only decodes mode 6.
+     */
+    void EncodeBC7Block(const uint8* texels, uint8* block) noexcept;
+    void DecodeBC7Block(const uint8* block, uint8* texels) noexcept;
+
+    // Whole images of RGBA8 texels in one of the BC formats; partial edge blocks repeat the last row and
+    // column. Compression splits the block rows across the pool when there is one
+    void CompressImage(RHIFormat format, uint32 width, uint32 height, const uint8* texels, uint8* blocks, ThreadPool* pool = nullptr);
+    void DecompressImage(RHIFormat format, uint32 width, uint32 height, const uint8* blocks, uint8* texels);
+}
+
+#endif // !_GINA_BLOCK_COMPRESSION_H_
@@ -0,0 +1,192 @@
+#ifndef _GINA_TEXTURE_STREAMER_H_
+#define _GINA_TEXTURE_STREAMER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "asset/gina_texture_asset.h"
+#include "core/gina_non_copyable.h"
+#include "rhi/gina_frame_ring.h"
+#include "rhi/gina_upload_ring.h"
+
+namespace gina
+{
+    constexpr uint32 INVALID_STREAMED_TEXTURE = 0xFFFFFFFF;
+
+    // Mips no larger than this on either side are the tail: loaded first and never evicted
+    constexpr uint32 TEXTURE_STREAMING_TAIL_DIMENSION = 64;
+
+    struct TextureStreamerSettings
+    {
+        uint64 memoryBudget = 256ull << 20;             // bytes streamed textures may hold on the GPU
+        uint64 uploadBufferSize = 32ull << 20;          // loads take at most half of it, or all of it for one mip too big to share
+        uint64 maxUploadBytesPerFrame = 8ull << 20;     // bounds the copies of a frame, not a single load
+        uint32 maxPendingLoads = 16;
+        uint32 ioThreadCount = 2;
+        uint32 idleFrames = 30;                         // frames without a request before only the tail is wanted
+    };
+
+    struct TextureStreamerStats
+    {
+        uint64 residentBytes = 0;       // of the textures in use; replaced ones live on until the GPU is done
+        uint64 peakResidentBytes = 0;
+        uint64 wantedBytes = 0;         // every texture at its wanted mip, as of the last Update
+        uint32 pendingLoads = 0;
+        uint64 loadsIssued = 0;
+        uint64 loadsCompleted = 0;
+        uint64 loadsCancelled = 0;      // read after the texture stopped wanting the mips or went away
+        uint64 loadsFailed = 0;         // reads that failed; their textures are not loaded again
+        uint64 budgetDeferrals = 0;     // loads put off because nothing older was left to evict
+        uint64 bytesRead = 0;
+        uint64 bytesUploaded = 0;
+        uint64 evictedMips = 0;
+        double loadTime = 0.0;          // ms from issuing to uploading, summed over completed loads
+    };
+
+    // Finest mip that still gives a texel per pixel to a texture covering screenWidth x screenHeight pixels
+    uint32 ComputeStreamingMip(uint32 width, uint32 height, float screenWidth, float screenHeight) noexcept;
+
+    /**
+     * Keeps the mips of cooked textures resident as far as the renderer asks for them, within a budget
+     *
+     * AddTexture only reads the header of a .gtex; the mip tail loads with the first Update. Each frame
+     * the renderer reports the finest mip it sampled of each texture with RequestMip (sampler feedback
+     * or ComputeStreamingMip); a texture keeps wanting that mip until it has gone idleFrames without a
+     * request. Missing mips are read as one contiguous chunk by the I/O threads, most urgent first, and
+     * uploaded by a later Update through an upload ring. When a load does not fit the budget the
+     * streamer first drops mips textures hold beyond what they want, then mips of textures last
+     * requested before the one loading, least recently requested first; it never evicts into the tail.
+     * A texture whose read fails keeps the mips it has and is not loaded again.
+     *
+     * Without tiled resources a change of resident mips means a new texture: Update creates it, copies
+     * the mips it keeps from the old one and the loaded ones from the upload ring, and hands the old one
+     * to the frame ring to release. GetTexture therefore changes whenever the residency does. Update
+     * runs once per frame between FrameRing::BeginFrame and EndFrame; streamed textures are expected in
+     * ShaderResource state between frames. All calls come from one thread.
+     */
+    class TextureStreamer : public NonCopyable
+    {
+    public:
+        TextureStreamer(RHIDevice& device, FrameRing& frames, const TextureStreamerSettings& settings = {});
+        ~TextureStreamer();
+
+        // INVALID_STREAMED_TEXTURE when the file cannot be read
+        uint32 AddTexture(const std::string& fileName);
+        void RemoveTexture(uint32 texture);
+
+        // The finest request of a frame wins
+        void RequestMip(uint32 texture, uint32 mip);
+
+        // Uploads finished loads, evicts to stay in budget and issues new loads; copies go into list
+        void Update(RHICommandList& list);
+
+        // Blocks until the I/O threads have read everything issued; the next Update uploads it
+        void WaitForLoads();
+
+        void SetMemoryBudget(uint64 budget) noexcept { m_settings.memoryBudget = budget; }
+
+        // Invalid until the tail is resident
+        RHITextureHandle GetTexture(uint32 texture) const;
+
+        // Finest resident mip, the mip count when nothing is
+        uint32 GetResidentMip(uint32 texture) const;
+        uint32 GetWantedMip(uint32 texture) const;
+        uint32 GetMipCount(uint32 texture) const;
+
+        const TextureStreamerStats& GetStats() const noexcept { return m_stats; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Texture
+        {
+            bool alive = false;
+            bool loading = false;
+            bool removed = false;           // waits for its load before the slot is reused
+            bool failed = false;            // a read failed: keeps what it has and loads nothing more
+            std::string fileName;
+            uint64 dataOffset = 0;
+            RHIFormat format = RHIFormat::Unknown;
+            std::vector<TextureMip> mips;
+            uint32 tailMip = 0;
+            uint32 finestMip = 0;           // finest mip that fits the upload ring
+            RHITextureHandle resource;
+            uint32 residentMip = 0;
+            uint32 requestedMip = 0;        // this frame, the mip count when nobody asked
+            uint32 wantedMip = 0;
+            uint64 lastRequestFrame = 0;
+            uint64 updatedFrame = 0;        // frame its resource was last replaced
+        };
+
+        struct Load
+        {
+            uint32 texture = INVALID_STREAMED_TEXTURE;
+            uint32 firstMip = 0;
+            uint32 endMip = 0;              // resident mip when issued
+            uint64 reservedBytes = 0;       // budget set aside for the larger resource
+            std::string fileName;
+            uint64 offset = 0;
+            std::vector<byte> data;
+            bool failed = false;
+            Clock::time_point issueTime;
+        };
+
+        struct PendingCopy
+        {
+            RHITextureHandle destination;
+            uint32 subresource = 0;
+            RHITextureHandle sourceTexture;     // or from the upload ring when invalid
+            uint32 sourceSubresource = 0;
+            uint64 uploadOffset = 0;
+        };
+
+        uint64 GetSize(const Texture& texture, uint32 firstMip) const noexcept;
+
+        void ApplyLoads();
+        // False when the load waits for a later frame; holding is set when it needs the whole upload ring
+        bool Apply(Load& load, bool& holding);
+        void UpdateWantedMips();
+        void IssueLoads();
+        bool Issue(uint32 index);
+        uint64 Evict(uint64 bytes, uint32 requester, uint64 requesterFrame);
+
+        // Replaces the resource with one holding mips from firstMip on; loaded holds mips firstMip up to the resident one
+        void Reallocate(Texture& texture, uint32 firstMip, const byte* loaded);
+        void Record(RHICommandList& list);
+        void FreeSlot(uint32 index);
+
+        void IoLoop();
+
+        RHIDevice& m_device;
+        FrameRing& m_frames;
+        TextureStreamerSettings m_settings;
+        UploadRing m_uploadRing;
+
+        std::vector<Texture> m_textures;
+        std::vector<uint32> m_freeTextures;
+        uint64 m_frame = 1;
+        uint64 m_reservedBytes = 0;
+        uint64 m_frameUploadBytes = 0;
+        TextureStreamerStats m_stats;
+
+        std::vector<RHIBarrier> m_beforeCopies;
+        std::vector<PendingCopy> m_copies;
+        std::vector<RHIBarrier> m_afterCopies;
+
+        std::mutex m_ioMutex;
+        std::condition_variable m_ioCondition;
+        std::condition_variable m_readCondition;
+        std::deque<Load> m_ioQueue;
+        std::deque<Load> m_readLoads;
+        uint32 m_reading = 0;
+        bool m_stopping = false;
+        std::vector<std::thread> m_ioThreads;
+    };
+}
+
+#endif // !_GINA_TEXTURE_STREAMER_H_
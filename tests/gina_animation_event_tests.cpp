@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "animation/gina_animation_event.h"
+
+using namespace gina;
+
+namespace
+{
+    constexpr uint32 FOOTSTEP = 1;
+    constexpr uint32 SOUND = 2;
+
+    // One second walk cycle: footsteps at 0 and 0.5, a sound at 0.25, events added out of order
+    AnimationClip CreateWalkClip()
+    {
+        AnimationClip clip;
+        clip.duration = 1.0f;
+        clip.events.Add({ 0.5f, FOOTSTEP, 1 });
+        clip.events.Add({ 0.25f, SOUND, 7 });
+        clip.events.Add({ 0.0f, FOOTSTEP, 0 });
+        return clip;
+    }
+
+    std::vector<float> CollectTimes(const AnimationClip& clip, float previous, float current, bool loop)
+    {
+        AnimationEventBuffer buffer;
+        AnimationEventSampler::CollectEvents(clip, previous, current, loop, 0, buffer);
+        EXPECT_EQ(buffer.GetCount(), AnimationEventSampler::CountEvents(clip, previous, current, loop));
+
+        std::vector<float> times;
+        for (const FiredAnimationEvent& fired : buffer.events)
+        {
+            times.push_back(fired.time);
+        }
+        return times;
+    }
+
+    class EventReceiver
+    {
+    public:
+        void OnEvents(const FiredAnimationEvent* events, uint32 count)
+        {
+            calls++;
+            for (uint32 i = 0; i < count; ++i)
+            {
+                if (events[i].event.type == FOOTSTEP)
+                {
+                    footsteps++;
+                }
+            }
+        }
+
+        uint32 calls = 0;
+        uint32 footsteps = 0;
+    };
+}
+
+TEST(AnimationEventTest, TrackStaysSorted)
+{
+    const AnimationClip clip = CreateWalkClip();
+    ASSERT_EQ(clip.events.GetCount(), 3u);
+    EXPECT_FLOAT_EQ(clip.events.events[0].time, 0.0f);
+    EXPECT_EQ(clip.events.events[1].type, SOUND);
+    EXPECT_EQ(clip.events.events[2].payload, 1u);
+    EXPECT_EQ(clip.events.LowerBound(0.25f), 1u);
+    EXPECT_EQ(clip.events.UpperBound(0.25f), 2u);
+}
+
+TEST(AnimationEventTest, CollectsCrossedEventsInPlaybackOrder)
+{
+    const AnimationClip clip = CreateWalkClip();
+
+    // Forwards the range is (previous, current]
+    EXPECT_EQ(CollectTimes(clip, 0.1f, 0.5f, true), (std::vector<float>{ 0.25f, 0.5f }));
+    EXPECT_EQ(CollectTimes(clip, 0.25f, 0.4f, true), std::vector<float>());
+    EXPECT_EQ(CollectTimes(clip, 0.3f, 0.3f, true), std::vector<float>());
+
+    // Wrapping around fires the end of one cycle and the start of the next, in time order
+    EXPECT_EQ(CollectTimes(clip, 0.9f, 1.3f, true), (std::vector<float>{ 1.0f, 1.25f }));
+    EXPECT_EQ(CollectTimes(clip, 0.4f, 2.6f, true), (std::vector<float>{ 0.5f, 1.0f, 1.25f, 1.5f, 2.0f, 2.25f, 2.5f }));
+
+    // Backwards the range is [current, previous), in descending time
+    EXPECT_EQ(CollectTimes(clip, 0.6f, 0.25f, true), (std::vector<float>{ 0.5f, 0.25f }));
+    EXPECT_EQ(CollectTimes(clip, 1.1f, 0.4f, true), (std::vector<float>{ 1.0f, 0.5f }));
+    EXPECT_EQ(CollectTimes(clip, 2.1f, -0.8f, true), (std::vector<float>{ 2.0f, 1.5f, 1.25f, 1.0f, 0.5f, 0.25f, 0.0f, -0.5f, -0.75f }));
+
+    // Going back from a cycle boundary leaves out what sits on it, an event at the very end included
+    AnimationClip ending = CreateWalkClip();
+    ending.events.Add({ 1.0f, SOUND, 9 });
+    EXPECT_EQ(CollectTimes(ending, 1.0f, 0.7f, true), std::vector<float>());
+    EXPECT_EQ(CollectTimes(ending, 2.0f, 1.2f, true), (std::vector<float>{ 1.5f, 1.25f }));
+    EXPECT_EQ(CollectTimes(ending, 2.0f, 0.4f, true), (std::vector<float>{ 1.5f, 1.25f, 1.0f, 1.0f, 0.5f }));
+    EXPECT_EQ(CollectTimes(ending, 3.0f, 0.9f, true).front(), 2.5f);
+
+    // Without looping, times clamp to the clip and nothing fires past its end
+    EXPECT_EQ(CollectTimes(clip, 0.4f, 3.0f, false), (std::vector<float>{ 0.5f }));
+    EXPECT_EQ(CollectTimes(clip, 1.5f, -1.0f, false), (std::vector<float>{ 0.5f, 0.25f, 0.0f }));
+}
+
+TEST(AnimationEventTest, BatchIsDeterministicAndDispatchedOnce)
+{
+    const AnimationClip walk = CreateWalkClip();
+    AnimationClip run = CreateWalkClip();
+    run.duration = 0.6f;
+
+    std::vector<AnimationEventQuery> queries(1000);
+    for (uint32 q = 0; q < 1000; ++q)
+    {
+        AnimationEventQuery& query = queries[q];
+        query.clip = q % 3 == 0 ? &run : &walk;
+        query.previousTime = 0.037f * q;
+        query.currentTime = query.previousTime + (q % 5 == 0 ? -0.4f : 0.3f);
+        query.loop = q % 7 != 0;
+        query.source = q;
+    }
+
+    AnimationEventBuffer serial;
+    AnimationEventSampler::CollectBatch(queries.data(), 1000, serial);
+
+    ThreadPool threadPool(3);
+    AnimationEventBuffer threaded;
+    AnimationEventSampler::CollectBatch(queries.data(), 1000, threaded, &threadPool);
+
+    ASSERT_EQ(serial.GetCount(), threaded.GetCount());
+    ASSERT_EQ(serial.offsets, threaded.offsets);
+    EXPECT_GT(serial.GetCount(), 500u);
+    for (uint32 i = 0; i < serial.GetCount(); ++i)
+    {
+        EXPECT_EQ(serial.events[i].source, threaded.events[i].source);
+        EXPECT_EQ(serial.events[i].time, threaded.events[i].time);
+        EXPECT_EQ(serial.events[i].event.type, threaded.events[i].event.type);
+    }
+
+    // Every query's range holds exactly its own events
+    for (uint32 q = 0; q < 1000; ++q)
+    {
+        const AnimationEventQuery& query = queries[q];
+        EXPECT_EQ(serial.offsets[q + 1] - serial.offsets[q],
+            AnimationEventSampler::CountEvents(*query.clip, query.previousTime, query.currentTime, query.loop));
+        for (uint32 i = serial.offsets[q]; i < serial.offsets[q + 1]; ++i)
+        {
+            EXPECT_EQ(serial.events[i].source, q);
+        }
+    }
+
+    // The next frame reuses the storage
+    const FiredAnimationEvent* storage = threaded.events.data();
+    for (AnimationEventQuery& query : queries)
+    {
+        query.previousTime = query.currentTime;
+        query.currentTime += 0.1f;
+    }
+    AnimationEventSampler::CollectBatch(queries.data(), 1000, threaded, &threadPool);
+    EXPECT_LE(threaded.GetCount(), serial.GetCount());
+    EXPECT_EQ(threaded.events.data(), storage);
+
+    EventReceiver receiver;
+    AnimationEventAction action;
+    action.Subscribe(&receiver, &EventReceiver::OnEvents);
+    AnimationEventSampler::Dispatch(serial, action);
+    EXPECT_EQ(receiver.calls, 1u);
+    EXPECT_GT(receiver.footsteps, 0u);
+
+    AnimationEventBuffer empty;
+    AnimationEventSampler::Dispatch(empty, action);
+    EXPECT_EQ(receiver.calls, 1u);
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include "animation/gina_animation_clip.h"
+#include "animation/gina_pose.h"
+#include "animation/gina_skeleton.h"
+
+using namespace gina;
+
+namespace
+{
+    void AddJoint(std::vector<SkeletonJointDesc>& joints, const char* name, uint16 parent, const float3& offset)
+    {
+        SkeletonJointDesc joint;
+        joint.name = name;
+        joint.parent = parent;
+        joint.bindPose.translation = offset;
+        joints.push_back(joint);
+    }
+
+    // Root -> spine -> arm -> hand -> two short fingers, plus a long leg; authored depth-first
+    std::vector<SkeletonJointDesc> CreateTestJoints()
+    {
+        std::vector<SkeletonJointDesc> joints;
+        AddJoint(joints, "root", INVALID_JOINT, float3(0.0f, 0.0f, 0.0f));
+        AddJoint(joints, "spine", 0, float3(0.0f, 0.5f, 0.0f));
+        AddJoint(joints, "arm", 1, float3(0.3f, 0.0f, 0.0f));
+        AddJoint(joints, "hand", 2, float3(0.3f, 0.0f, 0.0f));
+        AddJoint(joints, "finger0", 3, float3(0.02f, 0.0f, 0.0f));
+        AddJoint(joints, "finger1", 4, float3(0.02f, 0.0f, 0.0f));
+        AddJoint(joints, "leg", 0, float3(0.1f, -0.9f, 0.0f));
+        return joints;
+    }
+
+    AnimationClip CreateRotationClip(uint32 jointCount, float degreesPerSecond, float duration)
+    {
+        AnimationClip clip;
+        clip.duration = duration;
+        clip.sampleRate = 10.0f;
+        clip.jointCount = jointCount;
+
+        const uint32 frameCount = static_cast<uint32>(duration * clip.sampleRate) + 1;
+        for (uint32 frame = 0; frame < frameCount; ++frame)
+        {
+            const float time = frame / clip.sampleRate;
+            for (uint32 joint = 0; joint < jointCount; ++joint)
+            {
+                Transform local;
+                local.rotation = quaternion::fromAxisAngle(float3(0.0f, 0.0f, 1.0f), ConvertToRadians(degreesPerSecond * time));
+                local.translation = float3(static_cast<float>(joint), time, 0.0f);
+                clip.frames.push_back(local);
+            }
+        }
+        return clip;
+    }
+}
+
+TEST(SkeletonTest, ImportanceOrderKeepsParentsFirst)
+{
+    std::vector<uint16> sortedIndices;
+    const Skeleton skeleton = SkeletonBuilder::Build(CreateTestJoints(), {}, &sortedIndices);
+
+    ASSERT_EQ(skeleton.GetJointCount(), 7u);
+    EXPECT_EQ(skeleton.jointNames[0], "root");
+    EXPECT_EQ(skeleton.jointNames[skeleton.GetJointCount() - 1], "finger1");
+
+    for (uint32 joint = 0; joint < skeleton.GetJointCount(); ++joint)
+    {
+        const uint16 parent = skeleton.parents[joint];
+        if (parent != INVALID_JOINT)
+        {
+            EXPECT_LT(parent, joint);
+            EXPECT_GE(skeleton.importance[parent], skeleton.importance[joint]);
+        }
+    }
+
+    for (uint32 source = 0; source < sortedIndices.size(); ++source)
+    {
+        EXPECT_EQ(skeleton.jointNames[sortedIndices[source]], CreateTestJoints()[source].name);
+    }
+}
+
+TEST(SkeletonTest, LodsArePrefixesWithAncestorRemap)
+{
+    const Skeleton skeleton = SkeletonBuilder::Build(CreateTestJoints());
+
+    ASSERT_GT(skeleton.GetLodCount(), 1u);
+    EXPECT_EQ(skeleton.GetLodJointCount(0), skeleton.GetJointCount());
+
+    for (uint32 lod = 1; lod < skeleton.GetLodCount(); ++lod)
+    {
+        EXPECT_LT(skeleton.GetLodJointCount(lod), skeleton.GetLodJointCount(lod - 1));
+        EXPECT_GT(skeleton.lods[lod].error, skeleton.lods[lod - 1].error);
+
+        const uint16* remap = skeleton.GetLodRemap(lod);
+        for (uint32 joint = 0; joint < skeleton.GetJointCount(); ++joint)
+        {
+            ASSERT_LT(remap[joint], skeleton.GetLodJointCount(lod));
+            if (joint < skeleton.GetLodJointCount(lod))
+            {
+                EXPECT_EQ(remap[joint], joint);
+                continue;
+            }
+
+            // The remapped joint is an ancestor of the culled one
+            uint16 ancestor = skeleton.parents[joint];
+            while (ancestor != INVALID_JOINT && ancestor != remap[joint])
+            {
+                ancestor = skeleton.parents[ancestor];
+            }
+            EXPECT_EQ(ancestor, remap[joint]);
+        }
+    }
+
+    // The fingers are the first joints to go
+    const uint32 coarsest = skeleton.GetLodCount() - 1;
+    EXPECT_EQ(skeleton.GetLodRemap(1)[skeleton.FindJoint("finger1")], skeleton.FindJoint("hand"));
+    EXPECT_EQ(skeleton.SelectLod(0.5f, 1000.0f), 0u);
+    EXPECT_EQ(skeleton.SelectLod(1e6f, 1000.0f), coarsest);
+}
+
+TEST(AnimationTest, SampleInterpolatesAndLoops)
+{
+    const AnimationClip clip = CreateRotationClip(3, 90.0f, 1.0f);
+    Transform local[3];
+
+    AnimationSampler::Sample(clip, 0.25f, false, 3, local);
+    EXPECT_NEAR(local[2].translation.x, 2.0f, 1e-5f);
+    EXPECT_NEAR(local[2].translation.y, 0.25f, 1e-5f);
+    EXPECT_NEAR(local[1].rotation.rotate(float3(1.0f, 0.0f, 0.0f)).y, std::sin(ConvertToRadians(22.5f)), 1e-3f);
+
+    Transform wrapped[3];
+    AnimationSampler::Sample(clip, 1.25f, true, 3, wrapped);
+    EXPECT_NEAR(wrapped[2].translation.y, 0.25f, 1e-5f);
+
+    AnimationSampler::Sample(clip, 5.0f, false, 3, local);
+    EXPECT_NEAR(local[0].translation.y, 1.0f, 1e-5f);
+}
+
+TEST(AnimationTest, LodPrefixMatchesFullPose)
+{
+    std::vector<uint16> sortedIndices;
+    const Skeleton skeleton = SkeletonBuilder::Build(CreateTestJoints(), {}, &sortedIndices);
+    AnimationClip clip = CreateRotationClip(skeleton.GetJointCount(), 45.0f, 2.0f);
+    clip.RemapJoints(sortedIndices);
+
+    std::vector<Transform> fullLocal(skeleton.GetJointCount());
+    std::vector<Transform> fullModel(skeleton.GetJointCount());
+    AnimationSampler::Sample(clip, 0.7f, true, skeleton.GetJointCount(), fullLocal.data());
+    PoseOps::LocalToModel(skeleton, fullLocal.data(), skeleton.GetJointCount(), fullModel.data());
+
+    const uint32 lod = skeleton.GetLodCount() - 1;
+    const uint32 jointCount = skeleton.GetLodJointCount(lod);
+    std::vector<Transform> lodLocal(skeleton.GetJointCount());
+    std::vector<Transform> lodModel(skeleton.GetJointCount());
+    AnimationSampler::Sample(clip, 0.7f, true, jointCount, lodLocal.data());
+    PoseOps::LocalToModel(skeleton, lodLocal.data(), jointCount, lodModel.data());
+    PoseOps::FillCulledJoints(skeleton, lod, lodModel.data());
+
+    for (uint32 joint = 0; joint < jointCount; ++joint)
+    {
+        EXPECT_TRUE(lodModel[joint].translation == fullModel[joint].translation);
+        EXPECT_TRUE(lodModel[joint].rotation == fullModel[joint].rotation);
+    }
+
+    // Culled joints follow their kept ancestor rigidly
+    for (uint32 joint = jointCount; joint < skeleton.GetJointCount(); ++joint)
+    {
+        const Transform& ancestor = lodModel[skeleton.GetLodRemap(lod)[joint]];
+        EXPECT_TRUE(lodModel[joint].rotation == ancestor.rotation);
+    }
+}
+
+TEST(AnimationTest, LocalToModelComposesChain)
+{
+    const Skeleton skeleton = SkeletonBuilder::Build(CreateTestJoints());
+    std::vector<Transform> local = skeleton.bindPose;
+    std::vector<Transform> model(skeleton.GetJointCount());
+
+    // Rotating the spine by 90 degrees around Z swings the arm chain from +X to +Y
+    const uint16 spine = skeleton.FindJoint("spine");
+    local[spine].rotation = quaternion::fromAxisAngle(float3(0.0f, 0.0f, 1.0f), ConvertToRadians(90.0f));
+    PoseOps::LocalToModel(skeleton, local.data(), skeleton.GetJointCount(), model.data());
+
+    const float3 hand = model[skeleton.FindJoint("hand")].translation;
+    EXPECT_NEAR(hand.x, 0.0f, 1e-5f);
+    EXPECT_NEAR(hand.y, 1.1f, 1e-5f);
+    EXPECT_TRUE(model[skeleton.FindJoint("leg")].translation == float3(0.1f, -0.9f, 0.0f));
+}
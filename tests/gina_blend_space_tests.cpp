@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "animation/gina_blend_space.h"
+#include "animation/gina_blend_tree.h"
+
+using namespace gina;
+
+namespace
+{
+    // Locomotion layout: idle in the center, walk and run rings on the speed / direction plane
+    std::vector<float2> CreateLocomotionSamples()
+    {
+        std::vector<float2> positions = { float2(0.0f, 0.0f) };
+        for (float radius : { 1.5f, 4.0f })
+        {
+            for (uint32 i = 0; i < 8; ++i)
+            {
+                const float angle = 2.0f * PI * i / 8.0f;
+                positions.emplace_back(std::cos(angle) * radius, std::sin(angle) * radius);
+            }
+        }
+        return positions;
+    }
+
+    std::vector<float> ComputeWeights(const BlendNode& node, const float2& point, uint16& triangle)
+    {
+        std::vector<float> weights(node.positions.size());
+        BlendTreeEvaluator::ComputeBlendSpace2DWeights(node, point, triangle, weights.data());
+        return weights;
+    }
+
+    float2 WeightedPosition(const BlendNode& node, const std::vector<float>& weights)
+    {
+        float2 position;
+        for (size_t i = 0; i < weights.size(); ++i)
+        {
+            position += node.positions[i] * weights[i];
+        }
+        return position;
+    }
+
+    BlendNode CreateLocomotionNode()
+    {
+        static AnimationClip clip;
+        clip.jointCount = 1;
+
+        BlendTree tree;
+        std::vector<uint16> children;
+        std::vector<float2> positions = CreateLocomotionSamples();
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+            children.push_back(tree.AddClip(&clip));
+        }
+        tree.AddBlendSpace2D(children, positions, tree.AddParameter("x"), tree.AddParameter("y"));
+        return tree.nodes[tree.root];
+    }
+}
+
+TEST(BlendSpaceTest, TriangulationIsDelaunay)
+{
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+    std::vector<float2> positions = CreateLocomotionSamples();
+    for (uint32 i = 0; i < 12; ++i)
+    {
+        positions.emplace_back(coordinate(random) * 3.0f, coordinate(random) * 3.0f);
+    }
+
+    const BlendSpaceTriangulation triangulation = BlendSpaceTriangulator::Triangulate(positions);
+    ASSERT_GT(triangulation.GetTriangleCount(), positions.size());
+
+    for (uint32 t = 0; t < triangulation.GetTriangleCount(); ++t)
+    {
+        const float2& a = positions[triangulation.triangles[t * 3]];
+        const float2& b = positions[triangulation.triangles[t * 3 + 1]];
+        const float2& c = positions[triangulation.triangles[t * 3 + 2]];
+        EXPECT_GT((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x), 0.0f);
+
+        // Empty circumcircle, with a little slack for cocircular samples
+        const float d = 2.0f * (a.x * (b.y - c.y) + b.x * (c.y - a.y) + c.x * (a.y - b.y));
+        const float2 center(
+            (a.lengthSquared() * (b.y - c.y) + b.lengthSquared() * (c.y - a.y) + c.lengthSquared() * (a.y - b.y)) / d,
+            (a.lengthSquared() * (c.x - b.x) + b.lengthSquared() * (a.x - c.x) + c.lengthSquared() * (b.x - a.x)) / d);
+        const float radius = distance(center, a);
+        for (const float2& position : positions)
+        {
+            EXPECT_GE(distance(center, position), radius - 1e-3f);
+        }
+
+        // Adjacency is symmetric
+        for (uint32 e = 0; e < 3; ++e)
+        {
+            const uint16 neighbor = triangulation.neighbors[t * 3 + e];
+            if (neighbor != INVALID_BLEND_TRIANGLE)
+            {
+                const uint16* back = &triangulation.neighbors[neighbor * 3];
+                EXPECT_TRUE(back[0] == t || back[1] == t || back[2] == t);
+            }
+        }
+    }
+}
+
+TEST(BlendSpaceTest, BarycentricWeightsReproduceParameters)
+{
+    const BlendNode node = CreateLocomotionNode();
+    uint16 triangle = INVALID_BLEND_TRIANGLE;
+
+    // Exactly on a sample, that sample plays alone
+    for (size_t i = 0; i < node.positions.size(); ++i)
+    {
+        const std::vector<float> weights = ComputeWeights(node, node.positions[i], triangle);
+        EXPECT_NEAR(weights[i], 1.0f, 1e-5f);
+    }
+
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> coordinate(-2.8f, 2.8f);
+    for (uint32 i = 0; i < 200; ++i)
+    {
+        const float2 point(coordinate(random), coordinate(random));
+        const std::vector<float> weights = ComputeWeights(node, point, triangle);
+
+        float total = 0.0f;
+        uint32 active = 0;
+        for (float weight : weights)
+        {
+            EXPECT_GE(weight, 0.0f);
+            total += weight;
+            active += weight > 0.0f ? 1 : 0;
+        }
+        EXPECT_NEAR(total, 1.0f, 1e-5f);
+        EXPECT_LE(active, 3u);
+        EXPECT_LT(distance(WeightedPosition(node, weights), point), 1e-4f);
+
+        // Walking from the cached triangle finds the same answer as starting over
+        uint16 fresh = INVALID_BLEND_TRIANGLE;
+        EXPECT_EQ(ComputeWeights(node, point, fresh), weights);
+    }
+
+    // Outside the hull the parameters clamp to the nearest edge
+    const std::vector<float> weights = ComputeWeights(node, float2(10.0f, 0.0f), triangle);
+    EXPECT_NEAR(WeightedPosition(node, weights).x, 4.0f, 1e-5f);
+    EXPECT_NEAR(WeightedPosition(node, weights).y, 0.0f, 1e-5f);
+}
+
+TEST(BlendSpaceTest, WeightsAreContinuousAlongPaths)
+{
+    const BlendNode node = CreateLocomotionNode();
+
+    // Circles inside, across and outside the hull; each step moves the parameters by ~0.005
+    for (float radius : { 0.7f, 3.0f, 3.9f, 6.0f })
+    {
+        uint16 triangle = INVALID_BLEND_TRIANGLE;
+        const uint32 steps = static_cast<uint32>(2.0f * PI * radius / 0.005f);
+        std::vector<float> previous = ComputeWeights(node, float2(radius, 0.0f), triangle);
+
+        for (uint32 step = 1; step <= steps; ++step)
+        {
+            const float angle = 2.0f * PI * step / steps;
+            const std::vector<float> weights = ComputeWeights(node, float2(std::cos(angle), std::sin(angle)) * radius, triangle);
+            for (size_t i = 0; i < weights.size(); ++i)
+            {
+                ASSERT_LT(std::fabs(weights[i] - previous[i]), 0.02f) << "radius " << radius << ", step " << step << ", sample " << i;
+            }
+            previous = weights;
+        }
+    }
+}
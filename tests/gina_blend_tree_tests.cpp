@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "animation/gina_blend_tree.h"
+#include "animation/gina_pose.h"
+
+using namespace gina;
+
+namespace
+{
+    constexpr uint32 JOINT_COUNT = 4;
+
+    // Two frames one second apart; every joint holds the same transform
+    AnimationClip CreateConstantClip(const float3& translation, const quaternion& rotation = quaternion::Identity)
+    {
+        AnimationClip clip;
+        clip.duration = 1.0f;
+        clip.sampleRate = 1.0f;
+        clip.jointCount = JOINT_COUNT;
+        for (uint32 i = 0; i < 2 * JOINT_COUNT; ++i)
+        {
+            Transform transform;
+            transform.translation = translation;
+            transform.rotation = rotation;
+            clip.frames.push_back(transform);
+        }
+        return clip;
+    }
+
+    std::vector<Transform> Evaluate(const BlendTree& tree, const std::vector<float>& parameters, BlendCommandList& commands)
+    {
+        std::vector<Transform> scratch;
+        std::vector<Transform> local(JOINT_COUNT);
+        BlendTreeEvaluator::Compile(tree, parameters.data(), commands);
+        BlendTreeEvaluator::Execute(tree, commands, 0.25f, JOINT_COUNT, scratch, local.data());
+        return local;
+    }
+}
+
+TEST(BlendTreeTest, BlendPrunesZeroWeightChildren)
+{
+    const AnimationClip walk = CreateConstantClip(float3(1.0f, 0.0f, 0.0f));
+    const AnimationClip run = CreateConstantClip(float3(3.0f, 0.0f, 0.0f));
+
+    BlendTree tree;
+    const uint16 speed = tree.AddParameter("speed");
+    tree.AddBlend(tree.AddClip(&walk), tree.AddClip(&run), speed);
+
+    BlendCommandList commands;
+    std::vector<Transform> pose = Evaluate(tree, { 0.0f }, commands);
+    EXPECT_EQ(commands.sampledClipCount, 1u);
+    EXPECT_EQ(commands.commands.size(), 1u);
+    EXPECT_NEAR(pose[0].translation.x, 1.0f, 1e-6f);
+
+    pose = Evaluate(tree, { 1.0f }, commands);
+    EXPECT_EQ(commands.sampledClipCount, 1u);
+    EXPECT_NEAR(pose[0].translation.x, 3.0f, 1e-6f);
+
+    pose = Evaluate(tree, { 0.25f }, commands);
+    EXPECT_EQ(commands.sampledClipCount, 2u);
+    EXPECT_EQ(commands.maxStackDepth, 2u);
+    EXPECT_NEAR(pose[JOINT_COUNT - 1].translation.x, 1.5f, 1e-6f);
+}
+
+TEST(BlendTreeTest, BlendSpace1DSamplesOnlyTheActiveSegment)
+{
+    std::vector<AnimationClip> clips;
+    for (uint32 i = 0; i < 5; ++i)
+    {
+        clips.push_back(CreateConstantClip(float3(static_cast<float>(i), 0.0f, 0.0f)));
+    }
+
+    BlendTree tree;
+    const uint16 speed = tree.AddParameter("speed");
+    std::vector<uint16> children;
+    for (const AnimationClip& clip : clips)
+    {
+        children.push_back(tree.AddClip(&clip));
+    }
+    tree.AddBlendSpace1D(children, { 0.0f, 1.0f, 2.0f, 4.0f, 8.0f }, speed);
+
+    BlendCommandList commands;
+    std::vector<Transform> pose = Evaluate(tree, { 3.0f }, commands);
+    EXPECT_EQ(commands.sampledClipCount, 2u);
+    EXPECT_NEAR(pose[0].translation.x, 2.5f, 1e-6f);
+
+    pose = Evaluate(tree, { 100.0f }, commands);
+    EXPECT_EQ(commands.sampledClipCount, 1u);
+    EXPECT_NEAR(pose[0].translation.x, 4.0f, 1e-6f);
+}
+
+TEST(BlendTreeTest, NestedWeightsMatchWeightedAverage)
+{
+    const AnimationClip a = CreateConstantClip(float3(1.0f, 0.0f, 0.0f));
+    const AnimationClip b = CreateConstantClip(float3(0.0f, 1.0f, 0.0f));
+    const AnimationClip c = CreateConstantClip(float3(0.0f, 0.0f, 1.0f));
+    const AnimationClip d = CreateConstantClip(float3(0.0f, 0.0f, 0.0f));
+
+    BlendTree tree;
+    const uint16 x = tree.AddParameter("x");
+    const uint16 y = tree.AddParameter("y");
+    const uint16 fade = tree.AddParameter("fade");
+    const uint16 space = tree.AddBlendSpace2D({ tree.AddClip(&a), tree.AddClip(&b), tree.AddClip(&c) },
+        { float2(0.0f, 0.0f), float2(1.0f, 0.0f), float2(0.0f, 1.0f) }, x, y);
+    tree.AddBlend(space, tree.AddClip(&d), fade);
+
+    // Translations blend linearly, so the chained lerps reproduce the normalized weighted sum
+    const std::vector<float> parameters = { 0.3f, 0.2f, 0.4f };
+    BlendCommandList commands;
+    const std::vector<Transform> pose = Evaluate(tree, parameters, commands);
+
+    float weights[3];
+    uint16 triangle = INVALID_BLEND_TRIANGLE;
+    BlendTreeEvaluator::ComputeBlendSpace2DWeights(tree.nodes[space], float2(0.3f, 0.2f), triangle, weights);
+    EXPECT_NEAR(weights[0] + weights[1] + weights[2], 1.0f, 1e-6f);
+    EXPECT_EQ(commands.sampledClipCount, 4u);
+    EXPECT_NEAR(pose[0].translation.x, 0.6f * weights[0], 1e-5f);
+    EXPECT_NEAR(pose[0].translation.y, 0.6f * weights[1], 1e-5f);
+    EXPECT_NEAR(pose[0].translation.z, 0.6f * weights[2], 1e-5f);
+}
+
+TEST(BlendTreeTest, CollinearBlendSpaceFallsBackToFirstSample)
+{
+    const AnimationClip a = CreateConstantClip(float3(1.0f, 0.0f, 0.0f));
+    const AnimationClip b = CreateConstantClip(float3(2.0f, 0.0f, 0.0f));
+    const AnimationClip c = CreateConstantClip(float3(3.0f, 0.0f, 0.0f));
+
+    // Built by hand: AddBlendSpace2D asserts on samples that span no area
+    BlendTree tree;
+    const uint16 x = tree.AddParameter("x");
+    const uint16 y = tree.AddParameter("y");
+    BlendNode space;
+    space.type = BlendNodeType::BlendSpace2D;
+    space.children = { tree.AddClip(&a), tree.AddClip(&b), tree.AddClip(&c) };
+    space.positions = { float2(0.0f, 0.0f), float2(1.0f, 0.0f), float2(2.0f, 0.0f) };
+    space.triangulation = BlendSpaceTriangulator::Triangulate(space.positions);
+    space.parameter = x;
+    space.parameterY = y;
+    tree.nodes.push_back(std::move(space));
+    tree.root = static_cast<uint16>(tree.nodes.size() - 1);
+    ASSERT_EQ(tree.nodes[tree.root].triangulation.GetTriangleCount(), 0u);
+
+    BlendCommandList commands;
+    const std::vector<Transform> pose = Evaluate(tree, { 1.5f, 0.5f }, commands);
+    EXPECT_EQ(commands.sampledClipCount, 1u);
+    EXPECT_EQ(commands.maxStackDepth, 1u);
+    EXPECT_NEAR(pose[0].translation.x, 1.0f, 1e-6f);
+}
+
+TEST(BlendTreeTest, AdditiveAndMaskLayers)
+{
+    const quaternion lean = quaternion::fromAxisAngle(float3(0.0f, 0.0f, 1.0f), 0.5f);
+    const AnimationClip base = CreateConstantClip(float3(1.0f, 0.0f, 0.0f));
+    const AnimationClip leanPose = CreateConstantClip(float3(1.0f, 0.5f, 0.0f), lean);
+    const AnimationClip wave = CreateConstantClip(float3(0.0f, 2.0f, 0.0f));
+
+    // Additive clip relative to the base pose
+    AnimationClip additive = leanPose;
+    PoseOps::MakeAdditive(base.frames.data(), leanPose.frames.data(), static_cast<uint32>(additive.frames.size()), additive.frames.data());
+
+    BlendTree tree;
+    const uint16 leanAmount = tree.AddParameter("lean");
+    const uint16 waveAmount = tree.AddParameter("wave");
+    const uint16 leaning = tree.AddAdditive(tree.AddClip(&base), tree.AddClip(&additive), leanAmount);
+    tree.AddMask(leaning, tree.AddClip(&wave), { 0.0f, 0.0f, 1.0f, 1.0f }, waveAmount);
+
+    BlendCommandList commands;
+    std::vector<Transform> pose = Evaluate(tree, { 0.0f, 0.0f }, commands);
+    EXPECT_EQ(commands.sampledClipCount, 1u);
+    EXPECT_TRUE(pose[0].translation == float3(1.0f, 0.0f, 0.0f));
+
+    pose = Evaluate(tree, { 1.0f, 1.0f }, commands);
+    EXPECT_EQ(commands.sampledClipCount, 3u);
+    EXPECT_NEAR(pose[0].translation.y, 0.5f, 1e-5f);
+    EXPECT_NEAR(dot(pose[0].rotation, lean), 1.0f, 1e-5f);
+    EXPECT_NEAR(pose[2].translation.y, 2.0f, 1e-5f);
+    EXPECT_NEAR(pose[3].translation.x, 0.0f, 1e-5f);
+}
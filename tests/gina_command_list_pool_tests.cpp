@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "core/gina_thread_pool.h"
+#include "rhi/gina_command_list_pool.h"
+#include "rhi/gina_frame_ring.h"
+#include "rhi/gina_null_rhi.h"
+
+using namespace gina;
+
+namespace
+{
+    // One draw per item, its index in firstInstance, so the stream shows the order items reached the GPU
+    void RecordDraws(RHICommandList& list, uint32 begin, uint32 end)
+    {
+        for (uint32 i = begin; i < end; ++i)
+        {
+            list.DrawIndexed(36, 1, 0, 0, i);
+        }
+    }
+}
+
+TEST(CommandListPoolTest, SubmitsOneBatchInOrder)
+{
+    NullDevice device;
+    CommandListPool pool(device);
+    pool.BeginFrame(1, 0);
+
+    // Acquired out of order, as threads would
+    for (uint32 order : { 20u, 0u, 10u })
+    {
+        RecordDraws(pool.Acquire(order), order, order + 10);
+    }
+    EXPECT_EQ(pool.Submit(device.GetQueue(RHIQueueType::Graphics)), 3u);
+
+    const NullQueue& queue = device.GetNullQueue(RHIQueueType::Graphics);
+    EXPECT_EQ(queue.GetSubmissionCount(), 1u);
+    ASSERT_EQ(queue.GetStream().commands.size(), 30u);
+    for (uint32 i = 0; i < 30; ++i)
+    {
+        EXPECT_EQ(queue.GetStream().commands[i].args[4], i);
+    }
+    EXPECT_EQ(pool.GetStats().lists, 3u);
+    EXPECT_EQ(pool.GetStats().allocators, 3u);
+
+    // Lists are reused at once, allocators only after their fence value completes
+    pool.BeginFrame(2, 0);
+    pool.Acquire(0);
+    pool.Submit(device.GetQueue(RHIQueueType::Graphics));
+    EXPECT_EQ(pool.GetStats().lists, 3u);
+    EXPECT_EQ(pool.GetStats().allocators, 4u);
+
+    pool.BeginFrame(3, 1);
+    EXPECT_EQ(pool.GetStats().recycledAllocators, 3u);
+    pool.Acquire(0);
+    pool.Submit(device.GetQueue(RHIQueueType::Graphics));
+    EXPECT_EQ(pool.GetStats().allocators, 4u);
+}
+
+TEST(CommandListPoolTest, ParallelRecordingIsDeterministic)
+{
+    constexpr uint32 ITEM_COUNT = 2000;
+    constexpr uint32 GRAIN_SIZE = 64;
+    constexpr uint32 CHUNK_COUNT = (ITEM_COUNT + GRAIN_SIZE - 1) / GRAIN_SIZE;
+    constexpr uint32 FRAMES_IN_FLIGHT = 2;
+
+    NullDeviceSettings settings;
+    settings.submissionTime = 1.0;
+    settings.commandTime = 0.01;
+    NullDevice device(settings);
+    FrameRing ring(device, { FRAMES_IN_FLIGHT });
+    CommandListPool pool(device);
+    ThreadPool threadPool(3);
+    NullQueue& queue = device.GetNullQueue(RHIQueueType::Graphics);
+
+    for (uint32 frame = 0; frame < 8; ++frame)
+    {
+        ring.BeginFrame();
+        pool.BeginFrame(ring.GetCurrentFenceValue(), ring.GetCompletedValue());
+        pool.Record(&threadPool, ITEM_COUNT, GRAIN_SIZE, RecordDraws);
+        EXPECT_EQ(pool.Submit(queue), CHUNK_COUNT);
+        ring.EndFrame();
+        device.AdvanceTime(5.0);
+
+        const NullCommandStream& stream = queue.GetStream();
+        ASSERT_EQ(stream.commands.size(), ITEM_COUNT);
+        for (uint32 i = 0; i < ITEM_COUNT; ++i)
+        {
+            ASSERT_EQ(stream.commands[i].args[4], i);
+        }
+        queue.ClearStream();
+    }
+
+    // One batch a frame, allocators reused across the ring without touching any the GPU still reads
+    EXPECT_EQ(queue.GetSubmissionCount(), 8u);
+    EXPECT_EQ(device.GetStats().unsafeAllocatorResets, 0u);
+    EXPECT_EQ(pool.GetStats().lists, CHUNK_COUNT);
+    EXPECT_LE(pool.GetStats().allocators, CHUNK_COUNT * FRAMES_IN_FLIGHT);
+    EXPECT_GT(pool.GetStats().recycledAllocators, 0u);
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <set>
+#include "core/gina_thread_pool.h"
+#include "rhi/gina_descriptor_allocator.h"
+
+using namespace gina;
+
+TEST(DescriptorAllocatorTest, PersistentFreesAfterFenceAndCoalesces)
+{
+    // The persistent range starts after 16 descriptors reserved for something else
+    PersistentDescriptorAllocator allocator(16, 64);
+
+    const DescriptorRange a = allocator.Allocate(8);
+    const DescriptorRange b = allocator.Allocate(8);
+    const DescriptorRange c = allocator.Allocate(8);
+    EXPECT_EQ(a.index, 16u);
+    EXPECT_EQ(b.index, 24u);
+    EXPECT_EQ(c.index, 32u);
+    EXPECT_EQ(allocator.GetStats().usedCount, 24u);
+
+    // Freed descriptors stay reserved until the GPU is past the last frame using them
+    allocator.Free(a, 1);
+    allocator.Free(b, 2);
+    allocator.Reclaim(0);
+    EXPECT_EQ(allocator.GetStats().pendingFreeCount, 16u);
+    EXPECT_EQ(allocator.GetStats().usedCount, 24u);
+
+    allocator.Reclaim(1);
+    EXPECT_EQ(allocator.GetStats().usedCount, 16u);
+    EXPECT_EQ(allocator.GetStats().freeBlockCount, 2u);
+
+    // Best fit reuses the hole left by a, not the large block at the end
+    const DescriptorRange d = allocator.Allocate(4);
+    EXPECT_EQ(d.index, 16u);
+
+    // Freeing the neighbours merges everything back into one block
+    allocator.Free(d, 3);
+    allocator.Free(c, 3);
+    allocator.Reclaim(3);
+    EXPECT_EQ(allocator.GetStats().usedCount, 0u);
+    EXPECT_EQ(allocator.GetStats().freeBlockCount, 1u);
+    EXPECT_EQ(allocator.GetStats().largestFreeBlock, 64u);
+    EXPECT_EQ(allocator.GetStats().peakUsedCount, 24u);
+
+    EXPECT_EQ(allocator.Allocate(64).index, 16u);
+    EXPECT_FALSE(allocator.Allocate(1).IsValid());
+    EXPECT_EQ(allocator.GetStats().failures, 1u);
+}
+
+TEST(DescriptorAllocatorTest, TransientPagesRecycleByFence)
+{
+    constexpr uint32 BASE = 1000;
+    TransientDescriptorAllocator allocator(BASE, 4, 16);
+    DescriptorPageCursor cursor;
+
+    allocator.BeginFrame(1, 0);
+    const DescriptorRange first = allocator.Allocate(cursor, 10);
+    const DescriptorRange second = allocator.Allocate(cursor, 6);
+    EXPECT_EQ(first.index, BASE);
+    EXPECT_EQ(second.index, BASE + 10);
+
+    // Too little left in the page, the next table starts a new one
+    const DescriptorRange third = allocator.Allocate(cursor, 4);
+    EXPECT_EQ(third.index, BASE + 16);
+    EXPECT_EQ(allocator.GetStats().framePageCount, 2u);
+    EXPECT_FALSE(allocator.Allocate(cursor, 17).IsValid());
+
+    // Frame 2 cannot reuse frame 1's pages while the GPU may still read them
+    allocator.BeginFrame(2, 0);
+    EXPECT_EQ(allocator.GetStats().freePageCount, 2u);
+    EXPECT_EQ(allocator.Allocate(cursor, 4).index, BASE + 32);
+    DescriptorPageCursor other;
+    EXPECT_EQ(allocator.Allocate(other, 4).index, BASE + 48);
+    EXPECT_FALSE(allocator.Allocate(other, 16).IsValid());
+
+    // Once frame 1 completes its pages come back, lowest first
+    allocator.BeginFrame(3, 1);
+    EXPECT_EQ(allocator.GetStats().freePageCount, 2u);
+    EXPECT_EQ(allocator.Allocate(cursor, 1).index, BASE);
+    EXPECT_EQ(allocator.GetStats().failures, 2u);
+}
+
+TEST(DescriptorAllocatorTest, TransientRangesDoNotOverlapAcrossThreads)
+{
+    constexpr uint32 TABLE_COUNT = 4000;
+    constexpr uint32 TABLE_SIZE = 5;
+    TransientDescriptorAllocator allocator(0, 2048, 64);
+    ThreadPool threadPool(3);
+
+    std::vector<DescriptorRange> ranges(TABLE_COUNT);
+    allocator.BeginFrame(1, 0);
+    threadPool.ParallelFor(TABLE_COUNT, 100, [&](uint32 begin, uint32 end)
+    {
+        DescriptorPageCursor cursor;
+        for (uint32 i = begin; i < end; ++i)
+        {
+            ranges[i] = allocator.Allocate(cursor, TABLE_SIZE);
+        }
+    });
+
+    std::set<uint32> used;
+    for (const DescriptorRange& range : ranges)
+    {
+        ASSERT_TRUE(range.IsValid());
+        for (uint32 i = 0; i < range.count; ++i)
+        {
+            EXPECT_TRUE(used.insert(range.index + i).second);
+        }
+    }
+    EXPECT_EQ(allocator.GetStats().failures, 0u);
+}
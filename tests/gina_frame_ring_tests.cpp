@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "rhi/gina_frame_ring.h"
+#include "rhi/gina_null_rhi.h"
+
+using namespace gina;
+
+namespace
+{
+    // One frame on the virtual clock: cpuTime of recording, then one submission timed by the device settings
+    void RunFrame(NullDevice& device, FrameRing& ring, RHICommandList& list, double cpuTime)
+    {
+        FrameContext& frame = ring.BeginFrame();
+        list.Begin(*frame.allocator);
+        list.Draw(3, 1, 0, 0);
+        list.End();
+        device.AdvanceTime(cpuTime);
+
+        RHICommandList* batch[] = { &list };
+        device.GetQueue(RHIQueueType::Graphics).Submit(batch, 1);
+        ring.EndFrame();
+    }
+
+    NullDeviceSettings CreateSettings(double gpuTime)
+    {
+        NullDeviceSettings settings;
+        settings.submissionTime = gpuTime;
+        settings.recordCommands = false;
+        return settings;
+    }
+}
+
+TEST(FrameRingTest, CPURunsAheadOfGPU)
+{
+    constexpr uint32 FRAME_COUNT = 20;
+
+    // GPU 8 ms and CPU 10 ms a frame: a single frame in flight serializes them, two overlap them
+    for (uint32 framesInFlight : { 1u, 2u })
+    {
+        NullDevice device(CreateSettings(8.0));
+        FrameRing ring(device, { framesInFlight });
+        std::unique_ptr<RHICommandList> list = device.CreateCommandList(RHIQueueType::Graphics);
+        for (uint32 i = 0; i < FRAME_COUNT; ++i)
+        {
+            RunFrame(device, ring, *list, 10.0);
+        }
+        ring.Flush();
+
+        const NullDeviceStats stats = device.GetStats();
+        EXPECT_EQ(stats.unsafeAllocatorResets, 0u);
+        EXPECT_EQ(ring.GetStats().frames, FRAME_COUNT);
+        if (framesInFlight == 1)
+        {
+            EXPECT_EQ(ring.GetStats().cpuWaits, FRAME_COUNT - 1);
+            EXPECT_DOUBLE_EQ(device.GetTime(), FRAME_COUNT * 18.0);
+        }
+        else
+        {
+            EXPECT_EQ(ring.GetStats().cpuWaits, 0u);
+            EXPECT_DOUBLE_EQ(device.GetTime(), FRAME_COUNT * 10.0 + 8.0);
+        }
+    }
+}
+
+TEST(FrameRingTest, GPUBoundFramesStayWithinRing)
+{
+    constexpr uint32 FRAMES_IN_FLIGHT = 3;
+    NullDevice device(CreateSettings(10.0));
+    FrameRing ring(device, { FRAMES_IN_FLIGHT });
+    std::unique_ptr<RHICommandList> list = device.CreateCommandList(RHIQueueType::Graphics);
+
+    for (uint32 i = 0; i < 30; ++i)
+    {
+        FrameContext& frame = ring.BeginFrame();
+        EXPECT_EQ(frame.frameNumber, i);
+        EXPECT_EQ(ring.GetFrameIndex(), i % FRAMES_IN_FLIGHT);
+        EXPECT_EQ(ring.GetCurrentFenceValue(), i + 1);
+
+        // Never more than the ring's frames are queued on the GPU
+        EXPECT_GE(ring.GetCompletedValue() + FRAMES_IN_FLIGHT, i + 1);
+
+        list->Begin(*frame.allocator);
+        list->End();
+        device.AdvanceTime(4.0);
+        RHICommandList* batch[] = { list.get() };
+        device.GetQueue(RHIQueueType::Graphics).Submit(batch, 1);
+        ring.EndFrame();
+    }
+
+    // Once the ring is full the CPU waits and the GPU runs back to back: frame 26 completes at 4 + 27 * 10 ms,
+    // then frame 29 records for 4 ms
+    EXPECT_EQ(device.GetStats().unsafeAllocatorResets, 0u);
+    EXPECT_EQ(ring.GetStats().cpuWaits, 30u - FRAMES_IN_FLIGHT);
+    EXPECT_DOUBLE_EQ(device.GetTime(), 278.0);
+    EXPECT_NEAR(device.GetStats().cpuWaitTime, 278.0 - 30 * 4.0, 1e-6);
+}
+
+TEST(FrameRingTest, DeferredReleasesWaitForTheirFrame)
+{
+    NullDevice device(CreateSettings(5.0));
+    FrameRing ring(device, { 2 });
+    std::unique_ptr<RHICommandList> list = device.CreateCommandList(RHIQueueType::Graphics);
+
+    const RHIBufferHandle transient = device.CreateBuffer({ 4096, RHIMemoryType::Upload, false, "transient" });
+    const RHIBufferHandle between = device.CreateBuffer({ 1024, RHIMemoryType::Default, false, "between" });
+
+    ring.BeginFrame();
+    ring.DeferRelease(transient);
+    list->Begin(*ring.GetCurrentFrame().allocator);
+    list->End();
+    RHICommandList* batch[] = { list.get() };
+    device.GetQueue(RHIQueueType::Graphics).Submit(batch, 1);
+    ring.EndFrame();
+
+    // Released between frames, it may still be in use by frame 0
+    ring.DeferRelease(between);
+
+    RunFrame(device, ring, *list, 1.0);
+    EXPECT_EQ(device.GetStats().liveResources, 2u);
+
+    // Frame 2 reuses frame 0's context, so it waits for frame 0 and frees what frame 0 released
+    ring.BeginFrame();
+    EXPECT_EQ(device.GetStats().liveResources, 0u);
+    EXPECT_GE(ring.GetCompletedValue(), 1u);
+
+    // Flushing leaves the frame being recorded alone
+    const RHIBufferHandle late = device.CreateBuffer({ 16, RHIMemoryType::Default, false, "late" });
+    ring.DeferRelease(late);
+    ring.Flush();
+    EXPECT_EQ(device.GetStats().liveResources, 1u);
+    ring.EndFrame();
+    ring.Flush();
+    EXPECT_EQ(device.GetStats().liveResources, 0u);
+}
+
+TEST(FrameRingTest, FramesInFlightIsClamped)
+{
+    NullDevice device;
+    EXPECT_EQ(FrameRing(device, { 0 }).GetFramesInFlight(), 1u);
+    EXPECT_EQ(FrameRing(device, { 64 }).GetFramesInFlight(), MAX_FRAMES_IN_FLIGHT);
+    EXPECT_EQ(FrameRing(device).GetFramesInFlight(), BUFFER_COUNT);
+}
@@ -0,0 +1,270 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "animation/gina_ik.h"
+#include "animation/gina_pose.h"
+
+using namespace gina;
+
+namespace
+{
+    void ExpectNear(const float3& actual, const float3& expected, float tolerance)
+    {
+        EXPECT_NEAR(actual.x, expected.x, tolerance);
+        EXPECT_NEAR(actual.y, expected.y, tolerance);
+        EXPECT_NEAR(actual.z, expected.z, tolerance);
+    }
+
+    // A metre long leg hanging from the hip, knee bent slightly forward
+    void SetLeg(TwoBoneIKBatch& batch, uint32 index, const float3& hip, const float3& target)
+    {
+        batch.root.Set(index, hip);
+        batch.mid.Set(index, hip + float3(0.0f, -0.5f, 0.05f));
+        batch.end.Set(index, hip + float3(0.0f, -1.0f, 0.0f));
+        batch.target.Set(index, target);
+        batch.pole.Set(index, float3(0.0f, 0.0f, 1.0f));
+    }
+
+    // Positions after rotating the limb by its deltas
+    void ApplyLeg(const TwoBoneIKBatch& batch, uint32 index, float3& mid, float3& end)
+    {
+        const float3 root = batch.root.Get(index);
+        mid = root + batch.rootDelta.Get(index).rotate(batch.mid.Get(index) - root);
+        end = mid + batch.midDelta.Get(index).rotate(batch.end.Get(index) - batch.mid.Get(index));
+    }
+
+    // Bones about 0.5 long zig-zagging up +y
+    void SetChain(FabrikIKBatch& batch, uint32 index, const float3& base, const float3& target)
+    {
+        for (uint32 j = 0; j < batch.GetJointCount(); ++j)
+        {
+            batch.positions[j].Set(index, base + float3(0.05f * (j % 2), 0.5f * j, 0.0f));
+        }
+        batch.target.Set(index, target);
+    }
+}
+
+TEST(IKTest, TwoBoneReachesTargetsWithinReach)
+{
+    TwoBoneIKBatch batch;
+    batch.Resize(7);
+
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> offset(-0.6f, 0.6f);
+    std::uniform_real_distribution<float> distance(0.2f, 0.95f);
+    for (uint32 i = 0; i < batch.GetCount(); ++i)
+    {
+        const float3 hip(i * 1.0f, 1.0f, 0.0f);
+        const float3 direction = float3(offset(random), -1.0f, offset(random)).normalized();
+        SetLeg(batch, i, hip, hip + direction * distance(random));
+    }
+    IKSolver::SolveTwoBone(batch);
+
+    for (uint32 i = 0; i < batch.GetCount(); ++i)
+    {
+        const float3 root = batch.root.Get(i);
+        float3 mid, end;
+        ApplyLeg(batch, i, mid, end);
+        ExpectNear(end, batch.target.Get(i), 1e-4f);
+
+        // Rigid bones, and the knee bends towards the pole
+        EXPECT_NEAR((mid - root).length(), (batch.mid.Get(i) - root).length(), 1e-5f);
+        EXPECT_NEAR((end - mid).length(), (batch.end.Get(i) - batch.mid.Get(i)).length(), 1e-5f);
+        const float3 limb = (end - root).normalized();
+        const float3 bend = (mid - root) - limb * dot(mid - root, limb);
+        EXPECT_GT(dot(bend, float3(0.0f, 0.0f, 1.0f)), 0.0f);
+    }
+}
+
+TEST(IKTest, TwoBoneClampsTargetsOutOfReach)
+{
+    TwoBoneIKBatch batch;
+    batch.Resize(3);
+    const float3 hip(0.0f, 1.0f, 0.0f);
+    SetLeg(batch, 0, hip, float3(3.0f, -2.0f, 0.0f));   // too far: stretch towards it
+    SetLeg(batch, 1, hip, hip + float3(0.0f, -0.00001f, 0.0f));
+    SetLeg(batch, 2, hip, float3(0.5f, 0.2f, 0.3f));
+    batch.weight[2] = 0.0f;
+    IKSolver::SolveTwoBone(batch);
+
+    const float upper = (batch.mid.Get(0) - hip).length();
+    const float lower = (batch.end.Get(0) - batch.mid.Get(0)).length();
+
+    float3 mid, end;
+    ApplyLeg(batch, 0, mid, end);
+    const float3 direction = (batch.target.Get(0) - hip).normalized();
+    ExpectNear(end, hip + direction * (upper + lower), 1e-4f);
+    ExpectNear(mid, hip + direction * upper, 1e-4f);
+
+    // Too close: folded as far as the bone lengths allow, without NaNs
+    ApplyLeg(batch, 1, mid, end);
+    EXPECT_NEAR((end - hip).length(), std::fabs(upper - lower), 1e-4f);
+    EXPECT_FALSE(std::isnan(mid.x) || std::isnan(end.x));
+
+    // Zero weight leaves the pose alone
+    EXPECT_EQ(batch.rootDelta.Get(2), quaternion::Identity);
+    EXPECT_EQ(batch.midDelta.Get(2), quaternion::Identity);
+}
+
+TEST(IKTest, FabrikConvergesOrStraightens)
+{
+    FabrikIKBatch batch;
+    batch.Resize(5, 6);
+    batch.maxIterations = 32;
+    batch.tolerance = 1e-4f;
+
+    const float3 targets[] = {
+        float3(1.0f, 1.2f, 0.0f), float3(-0.5f, 1.0f, 0.8f), float3(0.2f, 0.5f, -0.3f),
+        float3(0.0f, 1.9f, 0.1f), float3(5.0f, 0.0f, 0.0f), float3(0.0f, -4.0f, 0.0f) };
+    std::vector<std::vector<float3>> original(6);
+    for (uint32 i = 0; i < 6; ++i)
+    {
+        SetChain(batch, i, float3(0.0f), targets[i]);
+        for (uint32 j = 0; j < 5; ++j)
+        {
+            original[i].push_back(batch.positions[j].Get(i));
+        }
+    }
+    IKSolver::SolveFabrik(batch);
+
+    for (uint32 i = 0; i < 6; ++i)
+    {
+        float chainLength = 0.0f;
+        for (uint32 j = 1; j < 5; ++j)
+        {
+            const float length = (original[i][j] - original[i][j - 1]).length();
+            EXPECT_NEAR((batch.positions[j].Get(i) - batch.positions[j - 1].Get(i)).length(), length, 1e-4f);
+            chainLength += length;
+        }
+        ExpectNear(batch.positions[0].Get(i), original[i][0], 0.0f);
+
+        const float3 end = batch.positions[4].Get(i);
+        if (targets[i].length() <= chainLength)
+        {
+            EXPECT_LE((end - targets[i]).length(), 1e-4f) << "instance " << i;
+        }
+        else
+        {
+            ExpectNear(end, targets[i].normalized() * chainLength, 1e-4f);
+        }
+
+        // Rotating the original bones by the deltas reproduces the solved chain
+        float3 position = original[i][0];
+        for (uint32 j = 0; j < 4; ++j)
+        {
+            position += batch.deltas[j].Get(i).rotate(original[i][j + 1] - original[i][j]);
+            ExpectNear(position, batch.positions[j + 1].Get(i), 1e-4f);
+        }
+    }
+}
+
+TEST(IKTest, LookAtAimsWithinLimit)
+{
+    LookAtIKBatch batch;
+    batch.Resize(3);
+    batch.maxAngle = 0.25f * PI;
+    for (uint32 i = 0; i < 3; ++i)
+    {
+        batch.position.Set(i, float3(0.0f, 1.7f, 0.0f));
+        batch.forward.Set(i, float3(0.0f, 0.0f, 1.0f));
+    }
+    batch.target.Set(0, float3(1.0f, 2.0f, 5.0f));      // about 11 degrees away
+    batch.target.Set(1, float3(5.0f, 1.7f, 0.0f));      // 90 degrees away
+    batch.target.Set(2, float3(0.0f, 1.7f, -5.0f));     // straight behind
+    IKSolver::SolveLookAt(batch);
+
+    const float3 aim = batch.delta.Get(0).rotate(float3(0.0f, 0.0f, 1.0f));
+    ExpectNear(aim, (batch.target.Get(0) - batch.position.Get(0)).normalized(), 1e-5f);
+
+    const float3 limited = batch.delta.Get(1).rotate(float3(0.0f, 0.0f, 1.0f));
+    ExpectNear(limited, float3(std::sin(0.25f * PI), 0.0f, std::cos(0.25f * PI)), 1e-5f);
+
+    const float3 behind = batch.delta.Get(2).rotate(float3(0.0f, 0.0f, 1.0f));
+    EXPECT_NEAR(std::acos(std::min(dot(behind, float3(0.0f, 0.0f, 1.0f)), 1.0f)), 0.25f * PI, 1e-4f);
+}
+
+TEST(IKTest, SimdKernelsMatchScalarReference)
+{
+    constexpr uint32 COUNT = 19;
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> coordinate(-2.0f, 2.0f);
+
+    TwoBoneIKBatch legs;
+    legs.Resize(COUNT);
+    FabrikIKBatch chains;
+    chains.Resize(4, COUNT);
+    LookAtIKBatch heads;
+    heads.Resize(COUNT);
+    heads.maxAngle = 1.0f;
+    for (uint32 i = 0; i < COUNT; ++i)
+    {
+        const float3 target(coordinate(random), coordinate(random), coordinate(random));
+        SetLeg(legs, i, float3(0.0f, 1.0f, 0.0f), target);
+        legs.weight[i] = 0.5f + 0.025f * i;
+        SetChain(chains, i, float3(0.0f), target);
+        heads.forward.Set(i, float3(coordinate(random), coordinate(random), coordinate(random)));
+        heads.target.Set(i, target);
+    }
+
+    TwoBoneIKBatch scalarLegs = legs;
+    FabrikIKBatch scalarChains = chains;
+    LookAtIKBatch scalarHeads = heads;
+    IKSolver::SolveTwoBone(legs);
+    IKSolver::SolveFabrik(chains);
+    IKSolver::SolveLookAt(heads);
+    IKSolver::SolveTwoBoneScalar(scalarLegs, 0, COUNT);
+    IKSolver::SolveFabrikScalar(scalarChains, 0, COUNT);
+    IKSolver::SolveLookAtScalar(scalarHeads, 0, COUNT);
+
+    for (uint32 i = 0; i < COUNT; ++i)
+    {
+        EXPECT_EQ(legs.rootDelta.Get(i), scalarLegs.rootDelta.Get(i));
+        EXPECT_EQ(legs.midDelta.Get(i), scalarLegs.midDelta.Get(i));
+        EXPECT_EQ(heads.delta.Get(i), scalarHeads.delta.Get(i));
+        for (uint32 j = 0; j < 3; ++j)
+        {
+            EXPECT_EQ(chains.deltas[j].Get(i), scalarChains.deltas[j].Get(i));
+            ExpectNear(chains.positions[j + 1].Get(i), scalarChains.positions[j + 1].Get(i), 1e-5f);
+        }
+    }
+}
+
+TEST(IKTest, AppliedDeltasPlaceTheFootOnTarget)
+{
+    std::vector<SkeletonJointDesc> joints(4);
+    joints[0].name = "pelvis";
+    joints[0].bindPose.translation = float3(0.0f, 1.0f, 0.0f);
+    joints[1].name = "thigh";
+    joints[1].parent = 0;
+    joints[1].bindPose.translation = float3(0.1f, 0.0f, 0.0f);
+    joints[1].bindPose.rotation = quaternion::fromAxisAngle(float3(0.0f, 1.0f, 0.0f), 0.3f);
+    joints[2].name = "calf";
+    joints[2].parent = 1;
+    joints[2].bindPose.translation = float3(0.0f, -0.45f, 0.02f);
+    joints[3].name = "foot";
+    joints[3].parent = 2;
+    joints[3].bindPose.translation = float3(0.0f, -0.45f, 0.0f);
+    const Skeleton skeleton = SkeletonBuilder::Build(joints);
+
+    const uint16 thigh = skeleton.FindJoint("thigh");
+    const uint16 calf = skeleton.FindJoint("calf");
+    const uint16 foot = skeleton.FindJoint("foot");
+    std::vector<Transform> local = skeleton.bindPose;
+    std::vector<Transform> model(skeleton.GetJointCount());
+    PoseOps::LocalToModel(skeleton, local.data(), skeleton.GetJointCount(), model.data());
+
+    TwoBoneIKBatch batch;
+    batch.Resize(1);
+    batch.root.Set(0, model[thigh].translation);
+    batch.mid.Set(0, model[calf].translation);
+    batch.end.Set(0, model[foot].translation);
+    batch.target.Set(0, float3(0.3f, 0.25f, 0.2f));
+    batch.pole.Set(0, float3(0.0f, 0.0f, 1.0f));
+    IKSolver::SolveTwoBone(batch);
+
+    const uint16 chain[] = { thigh, calf };
+    const quaternion deltas[] = { batch.rootDelta.Get(0), batch.midDelta.Get(0) };
+    IKSolver::ApplyRotationDeltas(skeleton, chain, deltas, 2, local.data(), model.data());
+    PoseOps::LocalToModel(skeleton, local.data(), skeleton.GetJointCount(), model.data());
+
+    ExpectNear(model[foot].translation, batch.target.Get(0), 1e-4f);
+}
@@ -109,4 +109,61 @@ TEST(MathTest, MathDispatch)
     EXPECT_NE(detail::MathDispatch::mul2Impl, nullptr);
     EXPECT_NE(detail::MathDispatch::div2Impl, nullptr);
     EXPECT_NE(detail::MathDispatch::lerp2Impl, nullptr);
-} 
\ No newline at end of file
+} 
+
+TEST(MathTest, QuaternionRotation)
+{
+    const quaternion q = quaternion::fromAxisAngle(float3(0.0f, 0.0f, 1.0f), ConvertToRadians(90.0f));
+    const float3 rotated = q.rotate(float3(1.0f, 0.0f, 0.0f));
+    EXPECT_NEAR(rotated.x, 0.0f, 1e-6f);
+    EXPECT_NEAR(rotated.y, 1.0f, 1e-6f);
+
+    const float3 twice = (q * q).rotate(float3(1.0f, 0.0f, 0.0f));
+    EXPECT_NEAR(twice.x, -1.0f, 1e-6f);
+
+    const float3 back = q.conjugate().rotate(rotated);
+    EXPECT_NEAR(back.x, 1.0f, 1e-6f);
+    EXPECT_NEAR(q.length(), 1.0f, 1e-6f);
+}
+
+TEST(MathTest, QuaternionFromToRotatesOntoTarget)
+{
+    const float3 from(1.0f, 2.0f, -0.5f);
+    const float3 to(-3.0f, 0.5f, 1.0f);
+    const quaternion q = quaternion::fromTo(from, to);
+    EXPECT_NEAR(distance(q.rotate(from.normalized()), to.normalized()), 0.0f, 1e-5f);
+    EXPECT_NEAR(q.length(), 1.0f, 1e-6f);
+
+    // The rotation axis is perpendicular to both, so no twist is added
+    EXPECT_NEAR(dot(float3(q.x, q.y, q.z), from), 0.0f, 1e-5f);
+
+    const quaternion opposite = quaternion::fromTo(float3(0.0f, 1.0f, 0.0f), float3(0.0f, -2.0f, 0.0f));
+    EXPECT_NEAR(distance(opposite.rotate(float3(0.0f, 1.0f, 0.0f)), float3(0.0f, -1.0f, 0.0f)), 0.0f, 1e-5f);
+    EXPECT_EQ(quaternion::fromTo(from, from * 2.0f), quaternion::Identity);
+}
+
+TEST(MathTest, QuaternionInterpolationTakesShortestArc)
+{
+    const quaternion a = quaternion::fromAxisAngle(float3(0.0f, 1.0f, 0.0f), ConvertToRadians(10.0f));
+    const quaternion b = -quaternion::fromAxisAngle(float3(0.0f, 1.0f, 0.0f), ConvertToRadians(50.0f));
+    const quaternion expected = quaternion::fromAxisAngle(float3(0.0f, 1.0f, 0.0f), ConvertToRadians(30.0f));
+
+    const quaternion s = slerp(a, b, 0.5f);
+    const quaternion n = nlerp(a, b, 0.5f);
+    EXPECT_NEAR(std::fabs(dot(s, expected)), 1.0f, 1e-5f);
+    EXPECT_NEAR(std::fabs(dot(n, expected)), 1.0f, 1e-5f);
+}
+
+TEST(MathTest, DualQuaternionMatchesRigidTransform)
+{
+    const quaternion rotationA = quaternion::fromAxisAngle(float3(0.0f, 1.0f, 0.0f), ConvertToRadians(90.0f));
+    const quaternion rotationB = quaternion::fromAxisAngle(float3(1.0f, 0.0f, 1.0f), ConvertToRadians(30.0f));
+    const dualquaternion a = dualquaternion::fromRotationTranslation(rotationA, float3(1.0f, 2.0f, 3.0f));
+    const dualquaternion b = dualquaternion::fromRotationTranslation(rotationB, float3(-1.0f, 0.5f, 0.0f));
+
+    const float3 point(0.3f, -0.7f, 2.0f);
+    EXPECT_NEAR(distance(a.getTranslation(), float3(1.0f, 2.0f, 3.0f)), 0.0f, 1e-5f);
+    EXPECT_NEAR(distance(a.transformPoint(point), rotationA.rotate(point) + float3(1.0f, 2.0f, 3.0f)), 0.0f, 1e-5f);
+    EXPECT_NEAR(distance((a * b).transformPoint(point), a.transformPoint(b.transformPoint(point))), 0.0f, 1e-5f);
+    EXPECT_NEAR((a * b).normalized().real.length(), 1.0f, 1e-6f);
+}
@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "mesh/gina_mesh_lod.h"
+#include "mesh/gina_mesh_simplifier.h"
+
+using namespace gina;
+
+namespace
+{
+    Mesh CreateGridMesh(uint32 cells)
+    {
+        Mesh mesh;
+        for (uint32 y = 0; y <= cells; ++y)
+        {
+            for (uint32 x = 0; x <= cells; ++x)
+            {
+                mesh.positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.0f);
+                mesh.texcoords.emplace_back(static_cast<float>(x) / cells, static_cast<float>(y) / cells);
+            }
+        }
+
+        const uint32 stride = cells + 1;
+        for (uint32 y = 0; y < cells; ++y)
+        {
+            for (uint32 x = 0; x < cells; ++x)
+            {
+                const uint32 v0 = y * stride + x;
+                mesh.indices.insert(mesh.indices.end(), { v0, v0 + 1, v0 + stride });
+                mesh.indices.insert(mesh.indices.end(), { v0 + 1, v0 + stride + 1, v0 + stride });
+            }
+        }
+
+        return mesh;
+    }
+
+    Mesh CreateSphereMesh(uint32 rings, uint32 segments)
+    {
+        Mesh mesh;
+        mesh.positions.emplace_back(0.0f, 1.0f, 0.0f);
+        for (uint32 ring = 1; ring < rings; ++ring)
+        {
+            const float theta = PI * ring / rings;
+            for (uint32 segment = 0; segment < segments; ++segment)
+            {
+                const float phi = 2.0f * PI * segment / segments;
+                mesh.positions.emplace_back(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+            }
+        }
+        mesh.positions.emplace_back(0.0f, -1.0f, 0.0f);
+
+        const uint32 bottom = mesh.GetVertexCount() - 1;
+        auto ringVertex = [segments](uint32 ring, uint32 segment) { return 1 + (ring - 1) * segments + segment % segments; };
+
+        for (uint32 segment = 0; segment < segments; ++segment)
+        {
+            mesh.indices.insert(mesh.indices.end(), { 0, ringVertex(1, segment + 1), ringVertex(1, segment) });
+            mesh.indices.insert(mesh.indices.end(), { bottom, ringVertex(rings - 1, segment), ringVertex(rings - 1, segment + 1) });
+        }
+
+        for (uint32 ring = 1; ring < rings - 1; ++ring)
+        {
+            for (uint32 segment = 0; segment < segments; ++segment)
+            {
+                const uint32 a = ringVertex(ring, segment);
+                const uint32 b = ringVertex(ring, segment + 1);
+                const uint32 c = ringVertex(ring + 1, segment);
+                const uint32 d = ringVertex(ring + 1, segment + 1);
+                mesh.indices.insert(mesh.indices.end(), { a, b, c });
+                mesh.indices.insert(mesh.indices.end(), { b, d, c });
+            }
+        }
+
+        return mesh;
+    }
+
+    // Splits the grid along column x = seam into two UV islands: vertices on the seam are duplicated
+    // and the triangles right of it use the copies. Returns the first duplicated vertex index.
+    uint32 AddUvSeam(Mesh& mesh, uint32 cells, uint32 seam)
+    {
+        const uint32 stride = cells + 1;
+        const uint32 firstCopy = mesh.GetVertexCount();
+        for (uint32 y = 0; y <= cells; ++y)
+        {
+            mesh.positions.push_back(mesh.positions[y * stride + seam]);
+            mesh.texcoords.emplace_back(0.0f, static_cast<float>(y) / cells);
+        }
+
+        for (size_t i = 0; i < mesh.indices.size(); i += 3)
+        {
+            bool rightOfSeam = false;
+            for (uint32 corner = 0; corner < 3; ++corner)
+            {
+                rightOfSeam |= mesh.indices[i + corner] % stride > seam;
+            }
+
+            for (uint32 corner = 0; rightOfSeam && corner < 3; ++corner)
+            {
+                uint32& index = mesh.indices[i + corner];
+                if (index < firstCopy && index % stride == seam)
+                {
+                    index = firstCopy + index / stride;
+                }
+            }
+        }
+
+        return firstCopy;
+    }
+}
+
+TEST(MeshSimplifierTest, FlatGridSimplifiesWithoutError)
+{
+    const Mesh mesh = CreateGridMesh(16);
+    const MeshSimplifyResult result = MeshSimplifier::Simplify(mesh, mesh.indices, static_cast<uint32>(mesh.indices.size() / 4));
+
+    EXPECT_LE(result.indices.size(), mesh.indices.size() / 4);
+    EXPECT_GT(result.indices.size(), 0u);
+    EXPECT_NEAR(result.error, 0.0f, 1e-3f);
+
+    // The square outline is a border: its corners can't move, so the covered area is unchanged
+    float area = 0.0f;
+    for (size_t i = 0; i < result.indices.size(); i += 3)
+    {
+        const float3& p0 = mesh.positions[result.indices[i]];
+        const float3 normal = cross(mesh.positions[result.indices[i + 1]] - p0, mesh.positions[result.indices[i + 2]] - p0);
+        EXPECT_GT(normal.z, 0.0f);
+        area += normal.z * 0.5f;
+    }
+    EXPECT_NEAR(area, 256.0f, 1e-2f);
+}
+
+TEST(MeshSimplifierTest, SphereErrorIsBoundedAndReported)
+{
+    const Mesh mesh = CreateSphereMesh(32, 64);
+    MeshSimplifySettings settings;
+    settings.maxError = 0.02f;
+
+    const MeshSimplifyResult result = MeshSimplifier::Simplify(mesh, mesh.indices, 0, settings);
+
+    EXPECT_LT(result.indices.size(), mesh.indices.size() / 4);
+    EXPECT_GT(result.error, 0.0f);
+    EXPECT_LE(result.relativeError, settings.maxError);
+    EXPECT_NEAR(result.error, result.relativeError * MeshSimplifier::ComputeExtent(mesh), 1e-6f);
+
+    for (uint32 index : result.indices)
+    {
+        ASSERT_LT(index, mesh.GetVertexCount());
+    }
+}
+
+TEST(MeshSimplifierTest, PreservesUvSeams)
+{
+    constexpr uint32 cells = 16;
+    constexpr uint32 seam = 8;
+    Mesh mesh = CreateGridMesh(cells);
+    const uint32 firstCopy = AddUvSeam(mesh, cells, seam);
+
+    const MeshSimplifyResult result = MeshSimplifier::Simplify(mesh, mesh.indices, static_cast<uint32>(mesh.indices.size() / 8));
+    EXPECT_LE(result.indices.size(), mesh.indices.size() / 8);
+
+    // No triangle may mix the two UV islands: left triangles only use original seam vertices,
+    // right triangles only use the copies, and the seam stays a straight line at x = seam
+    for (size_t i = 0; i < result.indices.size(); i += 3)
+    {
+        bool usesCopy = false;
+        bool usesLeft = false;
+        bool usesRight = false;
+        for (uint32 corner = 0; corner < 3; ++corner)
+        {
+            const uint32 index = result.indices[i + corner];
+            const float x = mesh.positions[index].x;
+            usesCopy |= index >= firstCopy;
+            usesLeft |= x < seam;
+            usesRight |= x > seam;
+        }
+
+        EXPECT_FALSE(usesLeft && usesRight);
+        EXPECT_FALSE(usesLeft && usesCopy);
+    }
+}
+
+TEST(MeshSimplifierTest, SkinWeightBoundariesIncreaseError)
+{
+    Mesh mesh = CreateSphereMesh(16, 32);
+    MeshSimplifySettings settings;
+    settings.maxError = 0.05f;
+
+    mesh.skinning.resize(mesh.GetVertexCount());
+    for (SkinInfluence& influence : mesh.skinning)
+    {
+        influence.weights[0] = 1.0f;
+    }
+    const MeshSimplifyResult uniform = MeshSimplifier::Simplify(mesh, mesh.indices, 0, settings);
+
+    // Upper and lower hemispheres bound to different joints: collapses across the equator pay the penalty
+    for (uint32 v = 0; v < mesh.GetVertexCount(); ++v)
+    {
+        mesh.skinning[v].joints[0] = mesh.positions[v].y > 0.0f ? 1 : 0;
+    }
+    const MeshSimplifyResult split = MeshSimplifier::Simplify(mesh, mesh.indices, 0, settings);
+
+    EXPECT_GT(split.indices.size(), uniform.indices.size());
+    EXPECT_LE(split.relativeError, settings.maxError);
+}
+
+TEST(MeshLodTest, ChainDecreasesTrianglesAndIncreasesError)
+{
+    const Mesh mesh = CreateSphereMesh(32, 64);
+    MeshLodSettings settings;
+    settings.levelCount = 4;
+
+    std::vector<MeshLod> lods;
+    std::vector<uint32> lodIndices;
+    MeshLodBuilder::Build(mesh, settings, lods, lodIndices);
+
+    ASSERT_EQ(lods.size(), 3u);
+    uint32 previousCount = static_cast<uint32>(mesh.indices.size());
+    float previousError = 0.0f;
+    for (const MeshLod& lod : lods)
+    {
+        EXPECT_LT(lod.indexCount, previousCount);
+        EXPECT_LE(lod.indexCount, previousCount * settings.triangleRatio + 3);
+        EXPECT_GE(lod.error, previousError);
+        EXPECT_LE(lod.indexOffset + lod.indexCount, lodIndices.size());
+        previousCount = lod.indexCount;
+        previousError = lod.error;
+    }
+    EXPECT_GT(lods.back().error, 0.0f);
+}
+
+TEST(MeshLodTest, SelectsCoarserLevelsWithDistance)
+{
+    const std::vector<MeshLod> lods = { { 0, 300, 0.001f }, { 300, 150, 0.01f }, { 450, 60, 0.1f } };
+    const float projectionScale = MeshLodBuilder::ComputeProjectionScale(1080.0f, ConvertToRadians(60.0f));
+
+    EXPECT_EQ(MeshLodBuilder::SelectLod(lods, 0.0f, projectionScale), 0u);
+    EXPECT_EQ(MeshLodBuilder::SelectLod(lods, 0.5f, projectionScale), 0u);
+    EXPECT_EQ(MeshLodBuilder::SelectLod(lods, 1000.0f, projectionScale), 3u);
+
+    uint32 previous = 0;
+    for (float distance = 0.1f; distance < 1000.0f; distance *= 1.5f)
+    {
+        const uint32 lod = MeshLodBuilder::SelectLod(lods, distance, projectionScale);
+        EXPECT_GE(lod, previous);
+        previous = lod;
+
+        // The selected level's error projects to at most one pixel
+        if (lod > 0)
+        {
+            EXPECT_LE(lods[lod - 1].error * projectionScale / distance, 1.0f + 1e-4f);
+        }
+    }
+}
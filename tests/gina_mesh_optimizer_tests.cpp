@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include "mesh/gina_mesh_optimizer.h"
+#include "asset/gina_mesh_asset.h"
+
+using namespace gina;
+
+namespace
+{
+    Mesh CreateGridMesh(uint32 cellsX, uint32 cellsY)
+    {
+        Mesh mesh;
+        mesh.name = "grid";
+
+        for (uint32 y = 0; y <= cellsY; ++y)
+        {
+            for (uint32 x = 0; x <= cellsX; ++x)
+            {
+                mesh.positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.0f);
+                mesh.texcoords.emplace_back(static_cast<float>(x) / cellsX, static_cast<float>(y) / cellsY);
+            }
+        }
+
+        const uint32 stride = cellsX + 1;
+        for (uint32 y = 0; y < cellsY; ++y)
+        {
+            for (uint32 x = 0; x < cellsX; ++x)
+            {
+                const uint32 v0 = y * stride + x;
+                mesh.indices.insert(mesh.indices.end(), { v0, v0 + 1, v0 + stride });
+                mesh.indices.insert(mesh.indices.end(), { v0 + 1, v0 + stride + 1, v0 + stride });
+            }
+        }
+
+        return mesh;
+    }
+
+    void ShuffleTriangles(std::vector<uint32>& indices, uint32 seed)
+    {
+        std::vector<std::array<uint32, 3>> triangles(indices.size() / 3);
+        std::memcpy(triangles.data(), indices.data(), indices.size() * sizeof(uint32));
+
+        std::mt19937 random(seed);
+        std::shuffle(triangles.begin(), triangles.end(), random);
+        std::memcpy(indices.data(), triangles.data(), indices.size() * sizeof(uint32));
+    }
+
+    std::vector<std::array<uint32, 3>> SortedTriangles(const std::vector<uint32>& indices)
+    {
+        std::vector<std::array<uint32, 3>> triangles;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            std::array<uint32, 3> triangle = { indices[i], indices[i + 1], indices[i + 2] };
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            triangles.push_back(triangle);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+}
+
+TEST(MeshOptimizerTest, AnalyzeSingleTriangle)
+{
+    const std::vector<uint32> indices = { 0, 1, 2 };
+    VertexCacheStatistics statistics = MeshOptimizer::AnalyzeVertexCache(indices, 3);
+
+    EXPECT_EQ(statistics.verticesTransformed, 3u);
+    EXPECT_FLOAT_EQ(statistics.acmr, 3.0f);
+    EXPECT_FLOAT_EQ(statistics.atvr, 1.0f);
+}
+
+TEST(MeshOptimizerTest, AnalyzeCountsCacheEvictions)
+{
+    const std::vector<uint32> indices = { 0, 1, 2, 3, 4, 5, 0, 1, 2 };
+    EXPECT_EQ(MeshOptimizer::AnalyzeVertexCache(indices, 6, 6).verticesTransformed, 6u);
+    EXPECT_EQ(MeshOptimizer::AnalyzeVertexCache(indices, 6, 3).verticesTransformed, 9u);
+}
+
+TEST(MeshOptimizerTest, VertexCachePreservesTriangles)
+{
+    Mesh mesh = CreateGridMesh(16, 16);
+    ShuffleTriangles(mesh.indices, 7);
+
+    std::vector<uint32> clusters;
+    std::vector<uint32> optimized = MeshOptimizer::OptimizeVertexCache(mesh.indices, mesh.GetVertexCount(), 16, &clusters);
+
+    EXPECT_EQ(SortedTriangles(optimized), SortedTriangles(mesh.indices));
+    ASSERT_FALSE(clusters.empty());
+    EXPECT_EQ(clusters.front(), 0u);
+    EXPECT_TRUE(std::is_sorted(clusters.begin(), clusters.end()));
+}
+
+TEST(MeshOptimizerTest, VertexCacheImprovesAcmr)
+{
+    Mesh mesh = CreateGridMesh(32, 32);
+    ShuffleTriangles(mesh.indices, 11);
+
+    const VertexCacheStatistics before = MeshOptimizer::AnalyzeVertexCache(mesh.indices, mesh.GetVertexCount());
+    std::vector<uint32> optimized = MeshOptimizer::OptimizeVertexCache(mesh.indices, mesh.GetVertexCount());
+    const VertexCacheStatistics after = MeshOptimizer::AnalyzeVertexCache(optimized, mesh.GetVertexCount());
+
+    EXPECT_LT(after.acmr, before.acmr);
+    EXPECT_LT(after.acmr, 1.0f);
+    EXPECT_GE(after.atvr, 1.0f);
+}
+
+TEST(MeshOptimizerTest, OptimizeIsDeterministic)
+{
+    Mesh first = CreateGridMesh(24, 24);
+    ShuffleTriangles(first.indices, 3);
+    Mesh second = first;
+
+    MeshOptimizer::Optimize(first);
+    MeshOptimizer::Optimize(second);
+
+    EXPECT_EQ(first.indices, second.indices);
+    ASSERT_EQ(first.positions.size(), second.positions.size());
+    for (size_t i = 0; i < first.positions.size(); ++i)
+    {
+        EXPECT_EQ(first.positions[i], second.positions[i]);
+    }
+}
+
+TEST(MeshOptimizerTest, OverdrawKeepsAcmrWithinThreshold)
+{
+    Mesh mesh = CreateGridMesh(32, 32);
+    ShuffleTriangles(mesh.indices, 5);
+
+    std::vector<uint32> clusters;
+    std::vector<uint32> cacheOptimized = MeshOptimizer::OptimizeVertexCache(mesh.indices, mesh.GetVertexCount(), 16, &clusters);
+    std::vector<uint32> overdrawOptimized = MeshOptimizer::OptimizeOverdraw(cacheOptimized, clusters, mesh.positions, 16, 1.05f);
+
+    EXPECT_EQ(SortedTriangles(overdrawOptimized), SortedTriangles(mesh.indices));
+
+    const float cacheAcmr = MeshOptimizer::AnalyzeVertexCache(cacheOptimized, mesh.GetVertexCount()).acmr;
+    const float overdrawAcmr = MeshOptimizer::AnalyzeVertexCache(overdrawOptimized, mesh.GetVertexCount()).acmr;
+    EXPECT_LE(overdrawAcmr, cacheAcmr * 1.05f + 0.05f);
+}
+
+TEST(MeshOptimizerTest, VertexFetchUsesFirstReferenceOrder)
+{
+    Mesh mesh;
+    mesh.positions = { float3(0, 0, 0), float3(1, 0, 0), float3(2, 0, 0), float3(3, 0, 0), float3(4, 0, 0) };
+    mesh.indices = { 3, 1, 4, 1, 4, 2 };
+
+    std::vector<uint32> remap = MeshOptimizer::OptimizeVertexFetch(mesh);
+
+    EXPECT_EQ(remap[0], INVALID_VERTEX_INDEX);
+    EXPECT_EQ(remap[3], 0u);
+    EXPECT_EQ(remap[1], 1u);
+    EXPECT_EQ(remap[4], 2u);
+    EXPECT_EQ(remap[2], 3u);
+
+    ASSERT_EQ(mesh.GetVertexCount(), 4u);
+    EXPECT_EQ(mesh.indices, (std::vector<uint32>{ 0, 1, 2, 1, 2, 3 }));
+    EXPECT_EQ(mesh.positions[0], float3(3, 0, 0));
+    EXPECT_EQ(mesh.positions[3], float3(2, 0, 0));
+}
+
+TEST(MeshAssetTest, SerializationRoundTrip)
+{
+    MeshAsset asset;
+    asset.mesh = CreateGridMesh(4, 4);
+    asset.mesh.jointNames = { "root", "spine" };
+    asset.mesh.skinning.resize(asset.mesh.GetVertexCount());
+    asset.lods.push_back({ 0, 6, 0.25f });
+    asset.lodIndices.assign(asset.mesh.indices.begin(), asset.mesh.indices.begin() + 6);
+    asset.skinningMode = SkinningMode::DualQuaternion;
+
+    BinaryWriter writer;
+    MeshAssetSerializer::Serialize(writer, { asset });
+
+    BinaryReader reader(writer.GetBuffer());
+    std::vector<MeshAsset> loaded;
+    ASSERT_TRUE(MeshAssetSerializer::Deserialize(reader, loaded));
+    ASSERT_EQ(loaded.size(), 1u);
+
+    EXPECT_EQ(loaded[0].mesh.name, "grid");
+    EXPECT_EQ(loaded[0].mesh.indices, asset.mesh.indices);
+    EXPECT_EQ(loaded[0].mesh.GetVertexCount(), asset.mesh.GetVertexCount());
+    EXPECT_EQ(loaded[0].mesh.jointNames, asset.mesh.jointNames);
+    ASSERT_EQ(loaded[0].lods.size(), 1u);
+    EXPECT_EQ(loaded[0].lods[0].indexCount, 6u);
+    EXPECT_FLOAT_EQ(loaded[0].lods[0].error, 0.25f);
+    EXPECT_EQ(loaded[0].lodIndices, asset.lodIndices);
+    EXPECT_EQ(loaded[0].skinningMode, SkinningMode::DualQuaternion);
+    EXPECT_TRUE(reader.IsAtEnd());
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <random>
+#include "mesh/gina_meshlet.h"
+#include "mesh/gina_meshlet_culler.h"
+
+using namespace gina;
+
+namespace
+{
+    Mesh CreateGridMesh(uint32 cells, float z = 0.0f)
+    {
+        Mesh mesh;
+        for (uint32 y = 0; y <= cells; ++y)
+        {
+            for (uint32 x = 0; x <= cells; ++x)
+            {
+                mesh.positions.emplace_back(static_cast<float>(x), static_cast<float>(y), z);
+            }
+        }
+
+        const uint32 stride = cells + 1;
+        for (uint32 y = 0; y < cells; ++y)
+        {
+            for (uint32 x = 0; x < cells; ++x)
+            {
+                const uint32 v0 = y * stride + x;
+                mesh.indices.insert(mesh.indices.end(), { v0, v0 + 1, v0 + stride });
+                mesh.indices.insert(mesh.indices.end(), { v0 + 1, v0 + stride + 1, v0 + stride });
+            }
+        }
+
+        return mesh;
+    }
+
+    Frustum CreateTestFrustum(const float3& position, const float3& forward)
+    {
+        return Frustum::FromPerspective(position, forward, float3(0.0f, 1.0f, 0.0f), ConvertToRadians(90.0f), 1.0f, 0.1f, 1000.0f);
+    }
+}
+
+TEST(MeshletBuilderTest, RespectsLimitsAndCoversAllTriangles)
+{
+    const Mesh mesh = CreateGridMesh(40);
+    MeshletBuildSettings settings;
+    settings.maxVertices = 64;
+    settings.maxTriangles = 124;
+
+    const MeshletData data = MeshletBuilder::Build(mesh, settings);
+    ASSERT_FALSE(data.meshlets.empty());
+    EXPECT_EQ(data.bounds.size(), data.meshlets.size());
+    EXPECT_EQ(data.triangles.size(), mesh.GetTriangleCount());
+
+    std::vector<std::array<uint32, 3>> rebuilt;
+    for (const Meshlet& meshlet : data.meshlets)
+    {
+        EXPECT_LE(meshlet.vertexCount, settings.maxVertices);
+        EXPECT_LE(meshlet.triangleCount, settings.maxTriangles);
+        EXPECT_GT(meshlet.triangleCount, 0u);
+
+        for (uint32 t = 0; t < meshlet.triangleCount; ++t)
+        {
+            const uint32 packed = data.triangles[meshlet.triangleOffset + t];
+            std::array<uint32, 3> triangle;
+            for (uint32 corner = 0; corner < 3; ++corner)
+            {
+                const uint32 local = MeshletData::UnpackIndex(packed, corner);
+                ASSERT_LT(local, meshlet.vertexCount);
+                triangle[corner] = data.vertices[meshlet.vertexOffset + local];
+            }
+            rebuilt.push_back(triangle);
+        }
+    }
+
+    std::vector<std::array<uint32, 3>> original;
+    for (size_t i = 0; i < mesh.indices.size(); i += 3)
+    {
+        original.push_back({ mesh.indices[i], mesh.indices[i + 1], mesh.indices[i + 2] });
+    }
+
+    std::sort(rebuilt.begin(), rebuilt.end());
+    std::sort(original.begin(), original.end());
+    EXPECT_EQ(rebuilt, original);
+}
+
+TEST(MeshletBuilderTest, BoundingSphereContainsVertices)
+{
+    const Mesh mesh = CreateGridMesh(20);
+    const MeshletData data = MeshletBuilder::Build(mesh);
+
+    for (size_t m = 0; m < data.meshlets.size(); ++m)
+    {
+        const Meshlet& meshlet = data.meshlets[m];
+        const MeshletBounds& bounds = data.bounds[m];
+        for (uint32 v = 0; v < meshlet.vertexCount; ++v)
+        {
+            const float3& p = mesh.positions[data.vertices[meshlet.vertexOffset + v]];
+            EXPECT_LE(distance(p, bounds.center), bounds.radius * 1.0001f + 1e-5f);
+        }
+    }
+}
+
+TEST(MeshletBuilderTest, FlatPatchHasTightCone)
+{
+    const Mesh mesh = CreateGridMesh(4);
+    const MeshletData data = MeshletBuilder::Build(mesh);
+
+    ASSERT_EQ(data.meshlets.size(), 1u);
+    EXPECT_NEAR(data.bounds[0].coneAxis.z, 1.0f, 1e-4f);
+    EXPECT_NEAR(data.bounds[0].coneCutoff, 0.0f, 1e-3f);
+}
+
+TEST(MeshletBuilderTest, SkinnedMeshesDisableCones)
+{
+    Mesh mesh = CreateGridMesh(4);
+    mesh.skinning.resize(mesh.GetVertexCount());
+
+    const MeshletData data = MeshletBuilder::Build(mesh);
+    ASSERT_FALSE(data.bounds.empty());
+    EXPECT_FLOAT_EQ(data.bounds[0].coneCutoff, 1.0f);
+}
+
+TEST(MeshletCullerTest, CullsBackfacingAndOutsideMeshlets)
+{
+    const Mesh mesh = CreateGridMesh(4);
+    const MeshletData data = MeshletBuilder::Build(mesh);
+    ASSERT_EQ(data.meshlets.size(), 1u);
+
+    // Patch normal is +Z: visible from +Z looking down -Z, back-facing from -Z looking down +Z
+    const float3 front(2.0f, 2.0f, 10.0f);
+    const float3 back(2.0f, 2.0f, -10.0f);
+    uint32 visible[1];
+
+    EXPECT_EQ(MeshletCuller::Cull(data.bounds.data(), 1, CreateTestFrustum(front, float3(0, 0, -1)), front, visible), 1u);
+    EXPECT_EQ(MeshletCuller::Cull(data.bounds.data(), 1, CreateTestFrustum(back, float3(0, 0, 1)), back, visible), 0u);
+    EXPECT_EQ(MeshletCuller::Cull(data.bounds.data(), 1, CreateTestFrustum(front, float3(0, 0, 1)), front, visible), 0u);
+}
+
+TEST(MeshletCullerTest, SimdMatchesScalar)
+{
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> cutoff(0.0f, 1.0f);
+
+    std::vector<MeshletBounds> bounds(1027);
+    for (MeshletBounds& b : bounds)
+    {
+        b.center = float3(position(random), position(random), position(random));
+        b.radius = cutoff(random) * 3.0f;
+        b.coneAxis = float3(unit(random), unit(random), unit(random)).normalized();
+        b.coneCutoff = cutoff(random);
+    }
+
+    const float3 camera(1.0f, 2.0f, -60.0f);
+    const Frustum frustum = CreateTestFrustum(camera, float3(0.1f, 0.0f, 1.0f));
+
+    std::vector<uint32> scalarVisible(bounds.size());
+    std::vector<uint32> dispatchedVisible(bounds.size());
+
+    const uint32 scalarCount = MeshletCuller::CullScalar(bounds.data(), static_cast<uint32>(bounds.size()), frustum, camera, scalarVisible.data());
+    const uint32 dispatchedCount = MeshletCuller::Cull(bounds.data(), static_cast<uint32>(bounds.size()), frustum, camera, dispatchedVisible.data());
+
+    ASSERT_EQ(scalarCount, dispatchedCount);
+    EXPECT_GT(scalarCount, 0u);
+    EXPECT_LT(scalarCount, bounds.size());
+    scalarVisible.resize(scalarCount);
+    dispatchedVisible.resize(dispatchedCount);
+    EXPECT_EQ(scalarVisible, dispatchedVisible);
+}
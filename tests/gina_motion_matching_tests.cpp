@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "animation/gina_motion_matching.h"
+#include "core/gina_cpu_features.h"
+
+using namespace gina;
+
+namespace
+{
+    void AddJoint(std::vector<SkeletonJointDesc>& joints, const char* name, uint16 parent, const float3& offset)
+    {
+        SkeletonJointDesc joint;
+        joint.name = name;
+        joint.parent = parent;
+        joint.bindPose.translation = offset;
+        joints.push_back(joint);
+    }
+
+    Skeleton CreateLegSkeleton()
+    {
+        std::vector<SkeletonJointDesc> joints;
+        AddJoint(joints, "root", INVALID_JOINT, float3(0.0f, 0.0f, 0.0f));
+        AddJoint(joints, "pelvis", 0, float3(0.0f, 1.0f, 0.0f));
+        AddJoint(joints, "l_foot", 1, float3(-0.2f, -0.9f, 0.0f));
+        AddJoint(joints, "r_foot", 1, float3(0.2f, -0.9f, 0.0f));
+        return SkeletonBuilder::Build(joints);
+    }
+
+    // Two seconds of walking in a straight line at 1.5 m/s from origin along heading
+    AnimationClip CreateWalkClip(const Skeleton& skeleton, const float3& origin, float heading)
+    {
+        AnimationClip clip;
+        clip.duration = 2.0f;
+        clip.sampleRate = 30.0f;
+        clip.jointCount = skeleton.GetJointCount();
+
+        const quaternion rotation = quaternion::fromAxisAngle(float3(0.0f, 1.0f, 0.0f), heading);
+        const float3 direction = rotation.rotate(float3(0.0f, 0.0f, 1.0f));
+        for (uint32 frame = 0; frame <= 60; ++frame)
+        {
+            for (uint32 joint = 0; joint < clip.jointCount; ++joint)
+            {
+                Transform local = skeleton.bindPose[joint];
+                if (skeleton.parents[joint] == INVALID_JOINT)
+                {
+                    local.translation = origin + direction * (1.5f * frame / clip.sampleRate);
+                    local.rotation = rotation;
+                }
+                clip.frames.push_back(local);
+            }
+        }
+        return clip;
+    }
+
+    // Raw features gathered around a few random poses, the way mocap clusters around locomotion modes
+    void CreateClusteredFeatures(uint32 entryCount, uint32 seed, std::vector<float>& rows, std::vector<uint32>& clips, std::vector<uint32>& frames)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> center(-3.0f, 3.0f);
+        std::normal_distribution<float> noise(0.0f, 0.3f);
+
+        std::vector<float> centers(16 * MOTION_FEATURE_COUNT);
+        for (float& value : centers)
+        {
+            value = center(random);
+        }
+
+        for (uint32 e = 0; e < entryCount; ++e)
+        {
+            const uint32 cluster = e % 16;
+            for (uint32 d = 0; d < MOTION_FEATURE_COUNT; ++d)
+            {
+                rows.push_back(centers[cluster * MOTION_FEATURE_COUNT + d] + noise(random));
+            }
+            clips.push_back(cluster);
+            frames.push_back(e);
+        }
+    }
+
+    float EntryCost(const MotionDatabase& database, uint32 entry, const float* query)
+    {
+        const float* block = database.GetBlock(entry / MOTION_BLOCK_SIZE);
+        float cost = 0.0f;
+        for (uint32 d = 0; d < MOTION_FEATURE_COUNT; ++d)
+        {
+            const float difference = block[d * MOTION_BLOCK_SIZE + entry % MOTION_BLOCK_SIZE] - query[d];
+            cost += difference * difference;
+        }
+        return cost;
+    }
+}
+
+TEST(MotionMatchingTest, FeaturesAreInCharacterSpace)
+{
+    const Skeleton skeleton = CreateLegSkeleton();
+    const AnimationClip forward = CreateWalkClip(skeleton, float3(0.0f, 0.0f, 0.0f), 0.0f);
+    const AnimationClip turned = CreateWalkClip(skeleton, float3(5.0f, 0.0f, -3.0f), 0.5f * PI);
+
+    MotionFeatureSettings settings;
+    settings.leftFoot = skeleton.FindJoint("l_foot");
+    settings.rightFoot = skeleton.FindJoint("r_foot");
+
+    std::vector<Transform> scratch;
+    float a[MOTION_FEATURE_COUNT];
+    float b[MOTION_FEATURE_COUNT];
+    ASSERT_TRUE(MotionDatabaseBuilder::ExtractFeatures(skeleton, { &forward, false }, 10, settings, scratch, a));
+    ASSERT_TRUE(MotionDatabaseBuilder::ExtractFeatures(skeleton, { &turned, false }, 10, settings, scratch, b));
+    for (uint32 d = 0; d < MOTION_FEATURE_COUNT; ++d)
+    {
+        EXPECT_NEAR(a[d], b[d], 1e-4f) << "feature " << d;
+    }
+
+    for (uint32 i = 0; i < MOTION_TRAJECTORY_SAMPLES; ++i)
+    {
+        EXPECT_NEAR(a[MOTION_TRAJECTORY_POSITION_OFFSET + i * 2], 0.0f, 1e-5f);
+        EXPECT_NEAR(a[MOTION_TRAJECTORY_POSITION_OFFSET + i * 2 + 1], 1.5f * settings.trajectoryTimes[i], 1e-4f);
+        EXPECT_NEAR(a[MOTION_TRAJECTORY_DIRECTION_OFFSET + i * 2 + 1], 1.0f, 1e-5f);
+    }
+    EXPECT_NEAR(a[MOTION_FOOT_POSITION_OFFSET], -0.2f, 1e-5f);
+    EXPECT_NEAR(a[MOTION_FOOT_POSITION_OFFSET + 1], 0.1f, 1e-5f);
+    EXPECT_NEAR(a[MOTION_FOOT_VELOCITY_OFFSET + 2], 1.5f, 1e-3f);
+
+    // Without looping, only frames with a full second of future trajectory are searchable
+    EXPECT_FALSE(MotionDatabaseBuilder::ExtractFeatures(skeleton, { &forward, false }, 31, settings, scratch, a));
+    const MotionDatabase database = MotionDatabaseBuilder::Build(skeleton, { { &forward, false }, { &turned, false } }, settings);
+    EXPECT_EQ(database.entryCount, 62u);
+    EXPECT_EQ(database.GetBlockCount() * MOTION_BLOCK_SIZE, database.entryClips.size());
+}
+
+TEST(MotionMatchingTest, NormalizedFeaturesAreCentered)
+{
+    std::vector<float> rows;
+    std::vector<uint32> clips, frames;
+    CreateClusteredFeatures(1000, 3, rows, clips, frames);
+    const MotionDatabase database = MotionDatabaseBuilder::Build(rows, clips, frames, MotionFeatureSettings());
+
+    double sum[MOTION_FEATURE_COUNT] = {};
+    uint32 stored = 0;
+    for (uint32 entry = 0; entry < database.entryClips.size(); ++entry)
+    {
+        if (database.entryClips[entry] == INVALID_MOTION_ENTRY)
+        {
+            continue;
+        }
+
+        const float* block = database.GetBlock(entry / MOTION_BLOCK_SIZE);
+        for (uint32 d = 0; d < MOTION_FEATURE_COUNT; ++d)
+        {
+            sum[d] += block[d * MOTION_BLOCK_SIZE + entry % MOTION_BLOCK_SIZE];
+        }
+        stored++;
+    }
+
+    EXPECT_EQ(stored, 1000u);
+    for (uint32 d = 0; d < MOTION_FEATURE_COUNT; ++d)
+    {
+        EXPECT_NEAR(sum[d] / stored, 0.0, 1e-4);
+    }
+}
+
+TEST(MotionMatchingTest, TreeSearchMatchesExhaustiveSearch)
+{
+    std::vector<float> rows;
+    std::vector<uint32> clips, frames;
+    CreateClusteredFeatures(5000, 5, rows, clips, frames);
+    const MotionDatabase database = MotionDatabaseBuilder::Build(rows, clips, frames, MotionFeatureSettings());
+    EXPECT_GT(database.nodes.size(), 1u);
+
+    std::mt19937 random(9);
+    std::normal_distribution<float> noise(0.0f, 0.4f);
+    std::vector<float> queries(200 * MOTION_FEATURE_COUNT);
+    for (uint32 q = 0; q < 200; ++q)
+    {
+        float raw[MOTION_FEATURE_COUNT];
+        for (uint32 d = 0; d < MOTION_FEATURE_COUNT; ++d)
+        {
+            raw[d] = rows[(q * 37 % 5000) * MOTION_FEATURE_COUNT + d] + noise(random) * (q % 4);
+        }
+        database.Normalize(raw, &queries[q * MOTION_FEATURE_COUNT]);
+    }
+
+    std::vector<MotionMatch> matches(200);
+    ThreadPool threadPool(2);
+    MotionMatcher::SearchBatch(database, queries.data(), 200, matches.data(), true, &threadPool);
+
+    for (uint32 q = 0; q < 200; ++q)
+    {
+        const float* query = &queries[q * MOTION_FEATURE_COUNT];
+        const MotionMatch exhaustive = MotionMatcher::Search(database, query, false);
+        ASSERT_NE(matches[q].entry, INVALID_MOTION_ENTRY);
+        EXPECT_NEAR(matches[q].cost, exhaustive.cost, 1e-4f * (1.0f + exhaustive.cost));
+        EXPECT_NEAR(EntryCost(database, matches[q].entry, query), matches[q].cost, 1e-4f * (1.0f + exhaustive.cost));
+        EXPECT_EQ(matches[q].clip, database.entryClips[matches[q].entry]);
+    }
+
+    // A query taken from the database finds its own entry
+    float query[MOTION_FEATURE_COUNT];
+    database.Normalize(&rows[1234 * MOTION_FEATURE_COUNT], query);
+    const MotionMatch match = MotionMatcher::Search(database, query);
+    EXPECT_EQ(match.clip, clips[1234]);
+    EXPECT_EQ(match.frame, frames[1234]);
+    EXPECT_NEAR(match.cost, 0.0f, 1e-8f);
+}
+
+TEST(MotionMatchingTest, SimdKernelMatchesScalarReference)
+{
+    std::vector<float> rows;
+    std::vector<uint32> clips, frames;
+    CreateClusteredFeatures(3001, 7, rows, clips, frames);
+    const MotionDatabase database = MotionDatabaseBuilder::Build(rows, clips, frames, MotionFeatureSettings());
+
+#if defined(GINA_SSE2_ENABLED)
+    if (!CpuFeatures::HasAVX2())
+    {
+        return;
+    }
+
+    std::mt19937 random(13);
+    std::uniform_real_distribution<float> coordinate(-2.0f, 2.0f);
+    for (uint32 q = 0; q < 50; ++q)
+    {
+        float query[MOTION_FEATURE_COUNT];
+        for (float& value : query)
+        {
+            value = coordinate(random);
+        }
+
+        MotionMatch scalar, avx2;
+        scalar.cost = avx2.cost = std::numeric_limits<float>::max();
+        MotionMatcher::SearchBlocksScalar(database, query, 0, database.GetBlockCount(), scalar);
+        MotionMatcher::SearchBlocksAVX2(database, query, 0, database.GetBlockCount(), avx2);
+        EXPECT_EQ(scalar.entry, avx2.entry);
+        EXPECT_NEAR(scalar.cost, avx2.cost, 1e-4f * scalar.cost);
+    }
+#endif
+}
@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include "core/gina_hash.h"
+#include "rhi/gina_pipeline_cache.h"
+
+using namespace gina;
+
+namespace
+{
+    // Creating from scratch takes a while, from a blob it is nearly free, like a driver's shader cache
+    class FakePipelineCompiler final : public PipelineCompiler
+    {
+    public:
+        RHIPipelineHandle CreatePipeline(const PipelineDesc& desc, const std::vector<byte>& cachedBlob, std::vector<byte>& blob) override
+        {
+            const uint64 hash = HashPipelineDesc(desc);
+            uint64 cached = 0;
+            if (acceptBlobs && cachedBlob.size() == sizeof(uint64))
+            {
+                std::memcpy(&cached, cachedBlob.data(), sizeof(uint64));
+            }
+            if (cached != hash)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                ++compiles;
+            }
+
+            blob.resize(sizeof(uint64));
+            std::memcpy(blob.data(), &hash, sizeof(uint64));
+            return { nextPipeline++ };
+        }
+
+        bool acceptBlobs = true;        // false plays a driver that rejects every blob
+        std::atomic<uint32> nextPipeline{ 0 };
+        std::atomic<uint32> compiles{ 0 };
+    };
+
+    PipelineDesc MakeOpaqueDesc(uint64 pixelShader)
+    {
+        PipelineDesc desc;
+        desc.vertexShader = HashBytes("mesh_vs", 7);
+        desc.pixelShader = pixelShader;
+        desc.rootSignature = HashBytes("bindless", 8);
+        desc.renderTargetCount = 1;
+        desc.renderTargetFormats[0] = RHIFormat::R16G16B16A16Float;
+        desc.depthFormat = RHIFormat::D32Float;
+        return desc;
+    }
+}
+
+TEST(PipelineCacheTest, HashesOnlyStateThatMatters)
+{
+    const PipelineDesc desc = MakeOpaqueDesc(42);
+    const uint64 hash = HashPipelineDesc(desc);
+
+    // Keys live in files, so they must not drift between builds
+    EXPECT_EQ(HashBytes("gina pipeline", 13), 0x9ECBFECD77ADBD8Aull);
+
+    // Slots past the render target count and the factors of disabled blending are not part of the pipeline
+    PipelineDesc same = desc;
+    same.renderTargetFormats[3] = RHIFormat::R8Unorm;
+    same.blend[0].source = PipelineBlendFactor::SourceAlpha;
+    EXPECT_EQ(HashPipelineDesc(same), hash);
+
+    // A bias of -0 is the same pipeline as one of 0
+    PipelineDesc negativeZero = desc;
+    negativeZero.raster.slopeScaledDepthBias = -0.0f;
+    EXPECT_TRUE(IsSamePipelineDesc(negativeZero, desc));
+    EXPECT_EQ(HashPipelineDesc(negativeZero), hash);
+    FakePipelineCompiler compiler;
+    PipelineCache cache(compiler, 1);
+    EXPECT_EQ(cache.GetPipeline(negativeZero), cache.GetPipeline(desc));
+    EXPECT_EQ(compiler.compiles.load(), 1u);
+
+    PipelineDesc blended = same;
+    blended.blend[0].enable = true;
+    PipelineDesc culled = desc;
+    culled.raster.cullMode = PipelineCullMode::None;
+    PipelineDesc format = desc;
+    format.renderTargetFormats[0] = RHIFormat::R8G8B8A8Srgb;
+    EXPECT_NE(HashPipelineDesc(blended), hash);
+    EXPECT_NE(HashPipelineDesc(culled), hash);
+    EXPECT_NE(HashPipelineDesc(format), hash);
+    EXPECT_NE(HashPipelineDesc(MakeOpaqueDesc(43)), hash);
+
+    // Lookups confirm a hash hit against the stored description, over the same fields
+    EXPECT_TRUE(IsSamePipelineDesc(same, desc));
+    EXPECT_FALSE(IsSamePipelineDesc(blended, desc));
+    EXPECT_FALSE(IsSamePipelineDesc(culled, desc));
+    EXPECT_FALSE(IsSamePipelineDesc(format, desc));
+    EXPECT_FALSE(IsSamePipelineDesc(MakeOpaqueDesc(43), desc));
+}
+
+TEST(PipelineCacheTest, WritesTheSameFileForTheSamePipelines)
+{
+    // Descriptions differing only in state that does not matter, asked for in a different order
+    const PipelineDesc a = MakeOpaqueDesc(42);
+    PipelineDesc b = MakeOpaqueDesc(42);
+    b.renderTargetFormats[5] = RHIFormat::R8Unorm;
+    b.blend[0].destination = PipelineBlendFactor::One;
+
+    FakePipelineCompiler compiler;
+    BinaryWriter first, second;
+    {
+        PipelineCache cache(compiler, 1);
+        cache.GetPipeline(a);
+        cache.GetPipeline(MakeOpaqueDesc(7));
+        cache.Serialize(first);
+    }
+    {
+        PipelineCache cache(compiler, 1);
+        cache.GetPipeline(MakeOpaqueDesc(7));
+        cache.GetPipeline(b);
+        cache.Serialize(second);
+    }
+    EXPECT_EQ(first.GetBuffer(), second.GetBuffer());
+
+    // And the descriptions read back hash as they were written
+    BinaryReader reader(first.GetBuffer());
+    PipelineCache cache(compiler, 1);
+    ASSERT_TRUE(cache.Deserialize(reader));
+    EXPECT_EQ(cache.GetStats().loadedEntries, 2u);
+    EXPECT_EQ(cache.GetStats().rejectedEntries, 0u);
+}
+
+TEST(PipelineCacheTest, PrewarmsWhatTheLastRunUsed)
+{
+    const std::string fileName = testing::TempDir() + "gina_pipeline_cache_test.bin";
+    const uint64 DEVICE = 0x10DE2684;
+
+    // First run: everything is a miss and creates on the spot
+    {
+        FakePipelineCompiler compiler;
+        PipelineCache cache(compiler, DEVICE);
+        EXPECT_FALSE(cache.Load(fileName + ".missing"));
+        for (uint64 shader = 0; shader < 4; ++shader)
+        {
+            EXPECT_TRUE(cache.GetPipeline(MakeOpaqueDesc(shader)).IsValid());
+        }
+        EXPECT_EQ(cache.GetPipeline(MakeOpaqueDesc(0)).id, 0u);
+
+        const PipelineCacheStats stats = cache.GetStats();
+        EXPECT_EQ(stats.misses, 4u);
+        EXPECT_EQ(stats.hits, 1u);
+        EXPECT_EQ(compiler.compiles, 4u);
+        EXPECT_GT(stats.stallTime, 0.0);
+        ASSERT_TRUE(cache.Save(fileName));
+    }
+
+    // Next run: the prewarm threads create them from their blobs before anything asks
+    {
+        FakePipelineCompiler compiler;
+        PipelineCache cache(compiler, DEVICE);
+        ASSERT_TRUE(cache.Load(fileName));
+        cache.BeginPrewarm(2);
+        cache.WaitForPrewarm();
+        for (uint64 shader = 0; shader < 4; ++shader)
+        {
+            EXPECT_TRUE(cache.GetPipeline(MakeOpaqueDesc(shader)).IsValid());
+        }
+        cache.GetPipeline(MakeOpaqueDesc(7));
+
+        const PipelineCacheStats stats = cache.GetStats();
+        EXPECT_EQ(stats.loadedEntries, 4u);
+        EXPECT_EQ(stats.prewarmed, 4u);
+        EXPECT_EQ(stats.blobCreates, 4u);
+        EXPECT_EQ(stats.hits, 4u);
+        EXPECT_EQ(stats.misses, 1u);
+        EXPECT_EQ(compiler.compiles, 1u);
+        EXPECT_GT(stats.hitchTimeAvoided, 0.0);
+        EXPECT_EQ(cache.GetEntryCount(), 5u);
+    }
+
+    // Blobs from another driver are useless: the whole file goes
+    {
+        FakePipelineCompiler compiler;
+        PipelineCache cache(compiler, DEVICE + 1);
+        EXPECT_FALSE(cache.Load(fileName));
+        EXPECT_EQ(cache.GetEntryCount(), 0u);
+    }
+    std::remove(fileName.c_str());
+}
+
+TEST(PipelineCacheTest, WaitsForPipelinesBeingPrewarmed)
+{
+    FakePipelineCompiler compiler;
+    BinaryWriter writer;
+    {
+        PipelineCache cache(compiler, 1);
+        for (uint64 shader = 0; shader < 16; ++shader)
+        {
+            cache.GetPipeline(MakeOpaqueDesc(shader));
+        }
+        cache.Serialize(writer);
+    }
+
+    // Blobs refused so prewarming is slow; ask for everything while it runs: each pipeline is created once
+    BinaryReader reader(writer.GetBuffer());
+    FakePipelineCompiler coldCompiler;
+    coldCompiler.acceptBlobs = false;
+    PipelineCache cache(coldCompiler, 1);
+    ASSERT_TRUE(cache.Deserialize(reader));
+    cache.BeginPrewarm(2);
+    for (uint64 shader = 16; shader > 0; --shader)
+    {
+        EXPECT_TRUE(cache.GetPipeline(MakeOpaqueDesc(shader - 1)).IsValid());
+    }
+    cache.WaitForPrewarm();
+
+    const PipelineCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.hits + stats.misses, 16u);
+    EXPECT_EQ(stats.prewarmed + stats.misses, 16u);
+    EXPECT_EQ(coldCompiler.nextPipeline, 16u);
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "animation/gina_pose.h"
+#include "animation/gina_pose_cache.h"
+
+using namespace gina;
+
+namespace
+{
+    // Root, spine and a small tip culled at the coarsest LOD
+    Skeleton CreateSkeleton()
+    {
+        std::vector<SkeletonJointDesc> joints(3);
+        joints[0].name = "root";
+        joints[1].name = "spine";
+        joints[1].parent = 0;
+        joints[1].bindPose.translation = float3(0.0f, 1.0f, 0.0f);
+        joints[2].name = "tip";
+        joints[2].parent = 1;
+        joints[2].bindPose.translation = float3(0.0f, 0.01f, 0.0f);
+
+        SkeletonBuildSettings settings;
+        settings.lodThresholds = { 0.05f };
+        return SkeletonBuilder::Build(joints, settings);
+    }
+
+    // The root walks along z and the spine turns a full circle about y over one second
+    AnimationClip CreateClip(const Skeleton& skeleton)
+    {
+        AnimationClip clip;
+        clip.duration = 1.0f;
+        clip.sampleRate = 30.0f;
+        clip.jointCount = skeleton.GetJointCount();
+        for (uint32 frame = 0; frame <= 30; ++frame)
+        {
+            const float time = frame / clip.sampleRate;
+            for (uint32 joint = 0; joint < clip.jointCount; ++joint)
+            {
+                Transform transform = skeleton.bindPose[joint];
+                if (joint == 0)
+                {
+                    transform.translation = float3(0.0f, 0.0f, 2.0f * time);
+                }
+                else if (joint == 1)
+                {
+                    transform.rotation = quaternion::fromAxisAngle(float3(0.0f, 1.0f, 0.0f), 2.0f * PI * time);
+                }
+                clip.frames.push_back(transform);
+            }
+        }
+        return clip;
+    }
+
+    std::vector<Transform> SampleModel(const Skeleton& skeleton, const AnimationClip& clip, float time, uint32 jointCount)
+    {
+        std::vector<Transform> local(jointCount);
+        std::vector<Transform> model(jointCount);
+        AnimationSampler::Sample(clip, time, true, jointCount, local.data());
+        PoseOps::LocalToModel(skeleton, local.data(), jointCount, model.data());
+        return model;
+    }
+}
+
+TEST(PoseCacheTest, SharesQuantizedPoses)
+{
+    const Skeleton skeleton = CreateSkeleton();
+    ASSERT_EQ(skeleton.GetLodCount(), 2u);
+    ASSERT_LT(skeleton.GetLodJointCount(1), skeleton.GetJointCount());
+    const AnimationClip walk = CreateClip(skeleton);
+    const AnimationClip run = CreateClip(skeleton);
+
+    PoseCacheSettings settings;
+    settings.timeQuantum = 0.1f;
+    PoseCache cache(skeleton, settings);
+    cache.BeginFrame();
+
+    // Times within half a quantum share, looping times wrap, LODs and clips do not share
+    const PoseHandle a = cache.Request(walk, 0.31f, true, 0);
+    EXPECT_EQ(cache.Request(walk, 0.27f, true, 0), a);
+    EXPECT_EQ(cache.Request(walk, 2.33f, true, 0), a);
+    EXPECT_NE(cache.Request(walk, 0.36f, true, 0), a);
+    const PoseHandle coarse = cache.Request(walk, 0.3f, true, 1);
+    EXPECT_NE(coarse, a);
+    EXPECT_NE(cache.Request(run, 0.3f, true, 0), a);
+    EXPECT_EQ(cache.Request(walk, 0.99f, true, 0), cache.Request(walk, 0.01f, true, 0));
+    EXPECT_EQ(cache.GetRequestCount(), 8u);
+    EXPECT_EQ(cache.GetEvaluatedCount(), 5u);
+
+    cache.Evaluate();
+    EXPECT_EQ(cache.GetPoseJointCount(coarse), skeleton.GetLodJointCount(1));
+    const std::vector<Transform> expected = SampleModel(skeleton, walk, 0.3f, skeleton.GetJointCount());
+    for (uint32 joint = 0; joint < skeleton.GetJointCount(); ++joint)
+    {
+        EXPECT_TRUE(cache.GetModelPose(a)[joint].rotation == expected[joint].rotation);
+        EXPECT_NEAR((cache.GetModelPose(a)[joint].translation - expected[joint].translation).length(), 0.0f, 1e-5f);
+    }
+    EXPECT_NEAR(cache.GetLocalPose(a)[0].translation.z, 0.6f, 1e-5f);
+
+    // Without quantization only identical times share; a new frame starts empty
+    PoseCache exact(skeleton, { 0.0f, 1 });
+    exact.BeginFrame();
+    EXPECT_NE(exact.Request(walk, 0.31f, true, 0), exact.Request(walk, 0.3100001f, true, 0));
+    EXPECT_EQ(exact.Request(walk, 0.5f, false, 0), exact.Request(walk, 0.5f, false, 0));
+    exact.BeginFrame();
+    EXPECT_EQ(exact.GetEvaluatedCount(), 0u);
+
+    // Enough distinct poses to grow the lookup; earlier handles survive and the next frame reuses it
+    for (uint32 frame = 0; frame < 2; ++frame)
+    {
+        exact.BeginFrame();
+        std::vector<PoseHandle> handles;
+        for (uint32 i = 0; i < 200; ++i)
+        {
+            handles.push_back(exact.Request(walk, i / 200.0f, true, 0));
+        }
+        for (uint32 i = 0; i < 200; ++i)
+        {
+            EXPECT_EQ(exact.Request(walk, i / 200.0f, true, 0), handles[i]);
+        }
+        EXPECT_EQ(exact.GetEvaluatedCount(), 200u);
+    }
+}
+
+TEST(PoseCacheTest, ReducedRateInterpolatesBetweenStaggeredUpdates)
+{
+    const Skeleton skeleton = CreateSkeleton();
+    const AnimationClip clip = CreateClip(skeleton);
+    const uint32 jointCount = skeleton.GetJointCount();
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+    constexpr uint32 INSTANCE_COUNT = 8;
+
+    PoseCache cache(skeleton, { 0.0f, 4 });
+    std::vector<ReducedRatePose> states(INSTANCE_COUNT);
+    std::vector<Transform> model(jointCount);
+    for (uint32 frame = 0; frame < 40; ++frame)
+    {
+        const float time = frame * DELTA_TIME;
+        cache.BeginFrame();
+        std::vector<PoseHandle> handles(INSTANCE_COUNT);
+        for (uint32 i = 0; i < INSTANCE_COUNT; ++i)
+        {
+            handles[i] = cache.RequestReducedRate(states[i], i, clip, time, DELTA_TIME, true, 0);
+        }
+
+        // After the first frame a quarter of the instances update each frame, all sharing one pose
+        EXPECT_EQ(cache.GetRequestCount(), frame == 0 ? INSTANCE_COUNT : INSTANCE_COUNT / 4) << frame;
+        EXPECT_EQ(cache.GetEvaluatedCount(), 1u);
+        cache.Evaluate();
+
+        for (uint32 i = 0; i < INSTANCE_COUNT; ++i)
+        {
+            cache.ResolveReducedRate(states[i], handles[i], model.data());
+            if (frame < 8)
+            {
+                continue;
+            }
+
+            // Settled instances sit on the sampled pose at their updates and move towards the next in between
+            const std::vector<Transform> current = SampleModel(skeleton, clip, time, jointCount);
+            const float error = (model[0].translation - current[0].translation).length();
+            EXPECT_LT(error, 1e-4f) << frame << " " << i;
+            EXPECT_GT(std::fabs(dot(model[1].rotation, current[1].rotation)), 0.999f) << frame << " " << i;
+            if (handles[i] != INVALID_POSE_HANDLE)
+            {
+                EXPECT_TRUE(model[1].rotation == current[1].rotation) << frame << " " << i;
+            }
+        }
+    }
+}
@@ -0,0 +1,297 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "render/gina_render_graph.h"
+#include "rhi/gina_null_rhi.h"
+
+using namespace gina;
+
+namespace
+{
+    using State = RHIResourceState;
+
+    RHITextureDesc MakeTexture(const char* name, uint32 width, uint32 height, RHIFormat format)
+    {
+        RHITextureDesc desc;
+        desc.name = name;
+        desc.width = width;
+        desc.height = height;
+        desc.format = format;
+        desc.usage = RHITextureUsage::ShaderResource | RHITextureUsage::RenderTarget;
+        return desc;
+    }
+
+    uint64 AlignedSize(const RHITextureDesc& desc)
+    {
+        return (GetTextureSize(desc) + RENDER_GRAPH_PLACEMENT_ALIGNMENT - 1) / RENDER_GRAPH_PLACEMENT_ALIGNMENT * RENDER_GRAPH_PLACEMENT_ALIGNMENT;
+    }
+
+    RHIBarrier MakeBarrier(const RenderGraph& graph, RenderGraphHandle handle, State before, State after,
+        RHIBarrierFlags flags = RHIBarrierFlags::None)
+    {
+        return { { graph.GetResourceIndex(handle) }, before, after, ALL_RHI_SUBRESOURCES, flags };
+    }
+
+    std::vector<uint32> GetOrder(const RenderGraph& graph)
+    {
+        std::vector<uint32> order;
+        for (const RenderGraphCompiledPass& compiled : graph.GetCompiledPasses())
+        {
+            order.push_back(compiled.pass);
+        }
+        return order;
+    }
+}
+
+TEST(RenderGraphTest, CullsAndAliasesPostProcessChain)
+{
+    const RHITextureDesc albedoDesc = MakeTexture("albedo", 1920, 1080, RHIFormat::R8G8B8A8Unorm);
+    const RHITextureDesc normalsDesc = MakeTexture("normals", 1920, 1080, RHIFormat::R16G16B16A16Float);
+    const RHITextureDesc depthDesc = MakeTexture("depth", 1920, 1080, RHIFormat::D32Float);
+    const RHITextureDesc hdrDesc = MakeTexture("hdr", 1920, 1080, RHIFormat::R16G16B16A16Float);
+    const RHITextureDesc bloomDesc = MakeTexture("bloom", 960, 540, RHIFormat::R16G16B16A16Float);
+
+    RenderGraph graph;
+    RenderGraphHandle backBuffer = graph.ImportTexture(MakeTexture("back buffer", 1920, 1080, RHIFormat::R8G8B8A8Unorm), { 100 },
+        State::Present, State::Present);
+
+    const uint32 gbuffer = graph.AddPass("gbuffer");
+    const RenderGraphHandle albedo = graph.Write(gbuffer, graph.CreateTexture(albedoDesc));
+    const RenderGraphHandle normals = graph.Write(gbuffer, graph.CreateTexture(normalsDesc));
+    const RenderGraphHandle depth = graph.Write(gbuffer, graph.CreateTexture(depthDesc), State::DepthWrite);
+
+    const uint32 lighting = graph.AddPass("lighting");
+    graph.Read(lighting, albedo);
+    graph.Read(lighting, normals);
+    graph.Read(lighting, depth);
+    const RenderGraphHandle hdr = graph.Write(lighting, graph.CreateTexture(hdrDesc));
+
+    const uint32 bloomDown = graph.AddPass("bloom down");
+    graph.Read(bloomDown, hdr);
+    const RenderGraphHandle bloomHalf = graph.Write(bloomDown, graph.CreateTexture(bloomDesc));
+
+    const uint32 bloomBlur = graph.AddPass("bloom blur");
+    graph.Read(bloomBlur, bloomHalf);
+    const RenderGraphHandle bloom = graph.Write(bloomBlur, graph.CreateTexture(bloomDesc));
+
+    // Nothing reads the debug view, so the pass goes
+    const uint32 debugView = graph.AddPass("debug view");
+    graph.Read(debugView, depth);
+    const RenderGraphHandle debug = graph.Write(debugView, graph.CreateTexture(hdrDesc));
+
+    const uint32 tonemap = graph.AddPass("tonemap");
+    graph.Read(tonemap, hdr);
+    graph.Read(tonemap, bloom);
+    backBuffer = graph.Write(tonemap, backBuffer);
+
+    ASSERT_TRUE(graph.Compile());
+    EXPECT_TRUE(graph.IsPassCulled(debugView));
+    EXPECT_EQ(GetOrder(graph), (std::vector<uint32>{ gbuffer, lighting, bloomDown, bloomBlur, tonemap }));
+    EXPECT_FALSE(graph.GetResourceInfo(debug).used);
+
+    EXPECT_EQ(graph.GetResourceInfo(albedo).firstPass, 0u);
+    EXPECT_EQ(graph.GetResourceInfo(albedo).lastPass, 1u);
+    EXPECT_EQ(graph.GetResourceInfo(hdr).lastPass, 4u);
+    EXPECT_EQ(graph.GetResourceInfo(bloomHalf).firstPass, 2u);
+
+    // Resources alive at the same time never share memory
+    const RenderGraphHandle transients[] = { albedo, normals, depth, hdr, bloomHalf, bloom };
+    for (RenderGraphHandle a : transients)
+    {
+        for (RenderGraphHandle b : transients)
+        {
+            const RenderGraphResourceInfo& infoA = graph.GetResourceInfo(a);
+            const RenderGraphResourceInfo& infoB = graph.GetResourceInfo(b);
+            const bool alive = infoA.firstPass <= infoB.lastPass && infoB.firstPass <= infoA.lastPass;
+            const bool shared = infoA.heapOffset < infoB.heapOffset + infoB.size && infoB.heapOffset < infoA.heapOffset + infoA.size;
+            EXPECT_TRUE(a == b || !alive || !shared) << infoA.name << " and " << infoB.name;
+        }
+    }
+
+    // The bloom targets fit in the G-buffer's memory once lighting is done with it
+    const RenderGraphMemoryReport& report = graph.GetMemoryReport();
+    EXPECT_EQ(report.transientResources, 6u);
+    EXPECT_EQ(report.culledPasses, 1u);
+    EXPECT_EQ(report.heapBytes, AlignedSize(albedoDesc) + AlignedSize(normalsDesc) + AlignedSize(depthDesc) + AlignedSize(hdrDesc));
+    EXPECT_EQ(report.GetSavedBytes(), 2 * AlignedSize(bloomDesc));
+    EXPECT_EQ(graph.GetCompiledPasses()[2].activations, std::vector<uint32>{ graph.GetResourceIndex(bloomHalf) });
+    EXPECT_EQ(graph.GetCompiledPasses()[2].barriers.front(), MakeBarrier(graph, bloomHalf, State::Common, State::Common, RHIBarrierFlags::Aliasing));
+
+    // All of a pass's transitions go out as one batch before it
+    EXPECT_EQ(graph.GetCompiledPasses()[1].barriers, (std::vector<RHIBarrier>{
+        MakeBarrier(graph, albedo, State::RenderTarget, State::ShaderResource),
+        MakeBarrier(graph, normals, State::RenderTarget, State::ShaderResource),
+        MakeBarrier(graph, depth, State::DepthWrite, State::ShaderResource),
+        MakeBarrier(graph, hdr, State::Common, State::RenderTarget) }));
+    EXPECT_EQ(graph.GetFinalBarriers(), std::vector<RHIBarrier>{ MakeBarrier(graph, backBuffer, State::RenderTarget, State::Present) });
+
+    // A pass reading what a kept pass later overwrites is only ordered before it, not kept alive by it
+    RenderGraph overwrite;
+    RenderGraphHandle target = overwrite.ImportTexture(MakeTexture("back buffer", 64, 64, RHIFormat::R8G8B8A8Unorm), { 100 },
+        State::Present, State::Present);
+    const uint32 produce = overwrite.AddPass("produce");
+    const RenderGraphHandle produced = overwrite.Write(produce, overwrite.CreateTexture(hdrDesc));
+    const uint32 inspect = overwrite.AddPass("inspect");
+    overwrite.Read(inspect, produced);
+    overwrite.Write(inspect, overwrite.CreateTexture(bloomDesc));
+    const uint32 present = overwrite.AddPass("present");
+    overwrite.Write(present, produced);
+    target = overwrite.Write(present, target);
+
+    ASSERT_TRUE(overwrite.Compile());
+    EXPECT_TRUE(overwrite.IsPassCulled(inspect));
+    EXPECT_EQ(GetOrder(overwrite), (std::vector<uint32>{ produce, present }));
+    EXPECT_EQ(overwrite.GetMemoryReport().culledPasses, 1u);
+}
+
+TEST(RenderGraphTest, SortsByDependenciesNotDeclarationOrder)
+{
+    RenderGraph graph;
+    RenderGraphHandle backBuffer = graph.ImportTexture(MakeTexture("back buffer", 64, 64, RHIFormat::R8G8B8A8Unorm), { 0 },
+        State::Present, State::Present);
+    const RenderGraphHandle scene = graph.CreateTexture(MakeTexture("scene", 64, 64, RHIFormat::R16G16B16A16Float));
+
+    // Declared consumer first; the handles still put the producer ahead of it
+    const uint32 composite = graph.AddPass("composite");
+    const uint32 overlay = graph.AddPass("overlay");
+    const uint32 draw = graph.AddPass("draw");
+    const RenderGraphHandle drawn = graph.Write(draw, scene);
+    const RenderGraphHandle overlaid = graph.Write(overlay, drawn);
+    graph.Read(composite, overlaid);
+    backBuffer = graph.Write(composite, backBuffer);
+
+    ASSERT_TRUE(graph.Compile());
+    EXPECT_EQ(GetOrder(graph), (std::vector<uint32>{ draw, overlay, composite }));
+
+    // Two passes each reading what the other writes cannot be ordered
+    RenderGraph cyclic;
+    const RenderGraphHandle a = cyclic.CreateTexture(MakeTexture("a", 64, 64, RHIFormat::R8Unorm));
+    const RenderGraphHandle b = cyclic.CreateTexture(MakeTexture("b", 64, 64, RHIFormat::R8Unorm));
+    const uint32 first = cyclic.AddPass("first", {}, true);
+    const uint32 second = cyclic.AddPass("second", {}, true);
+    const RenderGraphHandle writtenA = cyclic.Write(first, a);
+    const RenderGraphHandle writtenB = cyclic.Write(second, b);
+    cyclic.Read(first, writtenB);
+    cyclic.Read(second, writtenA);
+    EXPECT_FALSE(cyclic.Compile());
+}
+
+TEST(RenderGraphTest, ExecutesWithSplitBarriersOnPhysicalResources)
+{
+    NullDevice device;
+    std::unique_ptr<RHICommandAllocator> allocator = device.CreateCommandAllocator(RHIQueueType::Graphics);
+    std::unique_ptr<RHICommandList> list = device.CreateCommandList(RHIQueueType::Graphics);
+
+    const RHITextureDesc shadowDesc = MakeTexture("shadow map", 1024, 1024, RHIFormat::D32Float);
+    const RHITextureDesc backBufferDesc = MakeTexture("back buffer", 256, 256, RHIFormat::R8G8B8A8Unorm);
+    RHIBufferDesc particlesDesc;
+    particlesDesc.size = 65536;
+    particlesDesc.unorderedAccess = true;
+    particlesDesc.name = "particles";
+
+    // Draw count per pass tells the passes apart in the stream
+    auto draw = [](uint32 vertices)
+    {
+        return [vertices](RHICommandList& list, const RenderGraph&) { list.Draw(vertices, 1, 0, 0); };
+    };
+
+    RenderGraph graph;
+    RenderGraphHandle backBuffer = graph.ImportTexture(backBufferDesc, device.CreateTexture(backBufferDesc), State::Present, State::Present);
+    const uint32 shadows = graph.AddPass("shadows", draw(1));
+    const RenderGraphHandle shadowMap = graph.Write(shadows, graph.CreateTexture(shadowDesc), State::DepthWrite);
+    const uint32 particles = graph.AddPass("particles", draw(2), true);
+    const RenderGraphHandle particleBuffer = graph.Write(particles, graph.CreateBuffer(particlesDesc), State::UnorderedAccess);
+    const uint32 lighting = graph.AddPass("lighting", draw(3));
+    graph.Read(lighting, shadowMap);
+    backBuffer = graph.Write(lighting, backBuffer);
+
+    ASSERT_TRUE(graph.Compile());
+    graph.SetPhysicalResource(shadowMap, device.CreateTexture(shadowDesc));
+    graph.SetPhysicalResource(particleBuffer, device.CreateBuffer(particlesDesc));
+
+    // The shadow map idles through the particle pass, which gets the start of its transition
+    const std::vector<RenderGraphCompiledPass>& compiled = graph.GetCompiledPasses();
+    EXPECT_EQ(compiled[1].barriers, (std::vector<RHIBarrier>{
+        MakeBarrier(graph, shadowMap, State::DepthWrite, State::ShaderResource, RHIBarrierFlags::BeginOnly),
+        MakeBarrier(graph, particleBuffer, State::Common, State::UnorderedAccess) }));
+    EXPECT_EQ(compiled[2].barriers, (std::vector<RHIBarrier>{
+        MakeBarrier(graph, shadowMap, State::DepthWrite, State::ShaderResource, RHIBarrierFlags::EndOnly),
+        MakeBarrier(graph, backBuffer, State::Present, State::RenderTarget) }));
+
+    list->Begin(*allocator);
+    graph.Execute(*list);
+    list->End();
+
+    const NullCommandStream& stream = static_cast<NullCommandList&>(*list).GetStream();
+    ASSERT_EQ(stream.commands.size(), 7u);
+    const NullCommandType expected[] = { NullCommandType::Barrier, NullCommandType::Draw, NullCommandType::Barrier, NullCommandType::Draw,
+        NullCommandType::Barrier, NullCommandType::Draw, NullCommandType::Barrier };
+    for (uint32 i = 0; i < 7; ++i)
+    {
+        EXPECT_EQ(stream.commands[i].type, expected[i]);
+    }
+    EXPECT_EQ(stream.commands[5].args[0], 3u);
+    EXPECT_EQ(stream.barriers.size(), 6u);
+    EXPECT_EQ(stream.barriers[1].resource, graph.GetPhysicalResource(shadowMap));
+    EXPECT_EQ(stream.barriers[1].flags, RHIBarrierFlags::BeginOnly);
+    EXPECT_EQ(stream.barriers.back().resource, graph.GetPhysicalResource(backBuffer));
+    EXPECT_EQ(stream.barriers.back().after, State::Present);
+}
+
+TEST(RenderGraphTest, PlacesTransientsInOneHeap)
+{
+    NullDevice device;
+    std::unique_ptr<RHICommandAllocator> allocator = device.CreateCommandAllocator(RHIQueueType::Graphics);
+    std::unique_ptr<RHICommandList> list = device.CreateCommandList(RHIQueueType::Graphics);
+    const RHITextureDesc targetDesc = MakeTexture("target", 256, 256, RHIFormat::R8G8B8A8Unorm);
+
+    // A ping-pong chain: the third target takes over the first one's memory
+    RenderGraph graph;
+    RenderGraphHandle backBuffer = graph.ImportTexture(targetDesc, device.CreateTexture(targetDesc), State::Present, State::Present);
+    const uint32 first = graph.AddPass("first");
+    const RenderGraphHandle a = graph.Write(first, graph.CreateTexture(targetDesc));
+    const uint32 second = graph.AddPass("second");
+    graph.Read(second, a);
+    const RenderGraphHandle b = graph.Write(second, graph.CreateTexture(targetDesc));
+    const uint32 third = graph.AddPass("third");
+    graph.Read(third, b);
+    const RenderGraphHandle c = graph.Write(third, graph.CreateTexture(targetDesc));
+    const uint32 present = graph.AddPass("present");
+    graph.Read(present, c);
+    backBuffer = graph.Write(present, backBuffer);
+
+    ASSERT_TRUE(graph.Compile(&device));
+    const RenderGraphMemoryReport& report = graph.GetMemoryReport();
+    EXPECT_EQ(report.heapBytes, 2 * AlignedSize(targetDesc));
+    EXPECT_EQ(graph.GetResourceInfo(c).heapOffset, graph.GetResourceInfo(a).heapOffset);
+
+    const RHIHeapHandle heap = device.CreateHeap({ report.heapBytes, RHIMemoryType::Default, "transients" });
+    std::vector<RHIResourceHandle> created;
+    graph.PlaceTransients(device, heap, created);
+    ASSERT_EQ(created.size(), 3u);
+    for (RenderGraphHandle transient : { a, b, c })
+    {
+        uint64 offset = 0;
+        EXPECT_EQ(device.GetPlacedHeap(graph.GetPhysicalResource(transient), offset), heap);
+        EXPECT_EQ(offset, graph.GetResourceInfo(transient).heapOffset);
+    }
+
+    list->Begin(*allocator);
+    graph.Execute(*list);
+    list->End();
+
+    // The aliasing barrier hands the memory to the placed resource that takes it over
+    const NullCommandStream& stream = static_cast<NullCommandList&>(*list).GetStream();
+    const auto aliasing = std::find_if(stream.barriers.begin(), stream.barriers.end(), [](const RHIBarrier& barrier)
+    {
+        return barrier.flags == RHIBarrierFlags::Aliasing;
+    });
+    ASSERT_NE(aliasing, stream.barriers.end());
+    EXPECT_EQ(aliasing->resource, graph.GetPhysicalResource(c));
+
+    for (RHIResourceHandle resource : created)
+    {
+        device.DestroyResource(resource);
+    }
+    device.DestroyResource(heap);
+    EXPECT_EQ(device.GetStats().liveResources, 1u);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "rhi/gina_null_rhi.h"
+#include "rhi/gina_resource_state_tracker.h"
+
+using namespace gina;
+
+namespace
+{
+    using State = RHIResourceState;
+
+    const RHIResourceHandle TEXTURE = { 0 };
+    const RHIResourceHandle BUFFER = { 1 };
+    const RHIResourceHandle MIP_CHAIN = { 2 };
+
+    RHIBarrier MakeBarrier(RHIResourceHandle resource, State before, State after, uint32 subresource = ALL_RHI_SUBRESOURCES,
+        RHIBarrierFlags flags = RHIBarrierFlags::None)
+    {
+        return { resource, before, after, subresource, flags };
+    }
+
+    // Checks the barriers collected for a pass and issues them
+    void ExpectPass(ResourceStateTracker& tracker, RHICommandList& list, const std::vector<RHIBarrier>& expected)
+    {
+        EXPECT_EQ(tracker.GetPendingBarriers(), expected);
+        EXPECT_EQ(tracker.Flush(list), expected.size());
+    }
+}
+
+TEST(ResourceStateTrackerTest, EmitsMinimalMergedTransitions)
+{
+    NullDevice device;
+    std::unique_ptr<RHICommandAllocator> allocator = device.CreateCommandAllocator(RHIQueueType::Graphics);
+    std::unique_ptr<RHICommandList> list = device.CreateCommandList(RHIQueueType::Graphics);
+    list->Begin(*allocator);
+
+    ResourceStateTracker tracker;
+    tracker.Register(TEXTURE, 1, State::Common);
+    tracker.Register(BUFFER, 1, State::CopyDest);
+
+    tracker.Use(TEXTURE, State::RenderTarget);
+    tracker.Use(BUFFER, State::VertexBuffer);
+    ExpectPass(tracker, *list, { MakeBarrier(TEXTURE, State::Common, State::RenderTarget),
+        MakeBarrier(BUFFER, State::CopyDest, State::VertexBuffer) });
+
+    // Reads of one pass combine into a single read state; reads already covered need nothing
+    tracker.Use(TEXTURE, State::ShaderResource);
+    tracker.Use(TEXTURE, State::CopySource);
+    tracker.Use(BUFFER, State::VertexBuffer);
+    tracker.Use(BUFFER, State::IndexBuffer);
+    ExpectPass(tracker, *list, { MakeBarrier(TEXTURE, State::RenderTarget, State::ShaderResource | State::CopySource),
+        MakeBarrier(BUFFER, State::VertexBuffer, State::VertexBuffer | State::IndexBuffer) });
+
+    tracker.Use(TEXTURE, State::ShaderResource);
+    tracker.Use(BUFFER, State::IndexBuffer);
+    ExpectPass(tracker, *list, {});
+    EXPECT_EQ(tracker.GetState(TEXTURE), State::ShaderResource | State::CopySource);
+
+    // Unordered access after unordered access gets one UAV barrier per pass
+    tracker.Use(BUFFER, State::UnorderedAccess);
+    ExpectPass(tracker, *list, { MakeBarrier(BUFFER, State::VertexBuffer | State::IndexBuffer, State::UnorderedAccess) });
+    tracker.Use(BUFFER, State::UnorderedAccess);
+    tracker.Use(BUFFER, State::UnorderedAccess);
+    ExpectPass(tracker, *list, { MakeBarrier(BUFFER, State::UnorderedAccess, State::UnorderedAccess) });
+
+    // Every pass boundary is one Barrier call holding all of its barriers
+    list->End();
+    const NullCommandStream& stream = static_cast<NullCommandList&>(*list).GetStream();
+    EXPECT_EQ(stream.Count(NullCommandType::Barrier), 4u);
+    EXPECT_EQ(stream.commands[0].args[1], 2u);
+    EXPECT_EQ(stream.barriers.size(), 6u);
+    EXPECT_EQ(tracker.GetStats().barriers, 6u);
+    EXPECT_EQ(tracker.GetStats().batches, 4u);
+    EXPECT_EQ(tracker.GetStats().elidedTransitions, 5u);
+}
+
+TEST(ResourceStateTrackerTest, TracksSubresourcesIndependently)
+{
+    NullDevice device;
+    std::unique_ptr<RHICommandAllocator> allocator = device.CreateCommandAllocator(RHIQueueType::Graphics);
+    std::unique_ptr<RHICommandList> list = device.CreateCommandList(RHIQueueType::Graphics);
+    list->Begin(*allocator);
+
+    // Mip generation: each pass reads the previous mip and renders the next
+    ResourceStateTracker tracker;
+    tracker.Register(MIP_CHAIN, 4, State::ShaderResource);
+
+    tracker.Use(MIP_CHAIN, State::ShaderResource, 0);
+    tracker.Use(MIP_CHAIN, State::RenderTarget, 1);
+    ExpectPass(tracker, *list, { MakeBarrier(MIP_CHAIN, State::ShaderResource, State::RenderTarget, 1) });
+
+    tracker.Use(MIP_CHAIN, State::ShaderResource, 1);
+    tracker.Use(MIP_CHAIN, State::RenderTarget, 2);
+    ExpectPass(tracker, *list, { MakeBarrier(MIP_CHAIN, State::RenderTarget, State::ShaderResource, 1),
+        MakeBarrier(MIP_CHAIN, State::ShaderResource, State::RenderTarget, 2) });
+    EXPECT_EQ(tracker.GetState(MIP_CHAIN, 2), State::RenderTarget);
+    EXPECT_EQ(tracker.GetState(MIP_CHAIN, 3), State::ShaderResource);
+
+    // Using the whole texture only moves the subresources that differ, then tracks it as one again
+    tracker.Use(MIP_CHAIN, State::ShaderResource);
+    ExpectPass(tracker, *list, { MakeBarrier(MIP_CHAIN, State::RenderTarget, State::ShaderResource, 2) });
+    tracker.Use(MIP_CHAIN, State::CopyDest);
+    ExpectPass(tracker, *list, { MakeBarrier(MIP_CHAIN, State::ShaderResource, State::CopyDest) });
+}
+
+TEST(ResourceStateTrackerTest, SplitsBarriersAcrossPasses)
+{
+    NullDevice device;
+    std::unique_ptr<RHICommandAllocator> allocator = device.CreateCommandAllocator(RHIQueueType::Graphics);
+    std::unique_ptr<RHICommandList> list = device.CreateCommandList(RHIQueueType::Graphics);
+    list->Begin(*allocator);
+
+    ResourceStateTracker tracker;
+    tracker.Register(TEXTURE, 1, State::RenderTarget);
+    tracker.Register(BUFFER, 1, State::UnorderedAccess);
+
+    // Shadow map rendered, sampled two passes later: the transition starts right away and ends at the read
+    tracker.BeginTransition(TEXTURE, State::ShaderResource);
+    ExpectPass(tracker, *list, { MakeBarrier(TEXTURE, State::RenderTarget, State::ShaderResource, ALL_RHI_SUBRESOURCES,
+        RHIBarrierFlags::BeginOnly) });
+    tracker.Use(BUFFER, State::ShaderResource);
+    ExpectPass(tracker, *list, { MakeBarrier(BUFFER, State::UnorderedAccess, State::ShaderResource) });
+    tracker.Use(TEXTURE, State::ShaderResource);
+    ExpectPass(tracker, *list, { MakeBarrier(TEXTURE, State::RenderTarget, State::ShaderResource, ALL_RHI_SUBRESOURCES,
+        RHIBarrierFlags::EndOnly) });
+    EXPECT_EQ(tracker.GetState(TEXTURE), State::ShaderResource);
+
+    // Without a pass in between the split is pointless and collapses into a plain barrier
+    tracker.BeginTransition(BUFFER, State::UnorderedAccess);
+    tracker.Use(BUFFER, State::UnorderedAccess);
+    ExpectPass(tracker, *list, { MakeBarrier(BUFFER, State::ShaderResource, State::UnorderedAccess) });
+
+    // A use other than the one announced ends the split first
+    tracker.BeginTransition(TEXTURE, State::RenderTarget);
+    ExpectPass(tracker, *list, { MakeBarrier(TEXTURE, State::ShaderResource, State::RenderTarget, ALL_RHI_SUBRESOURCES,
+        RHIBarrierFlags::BeginOnly) });
+    tracker.Use(TEXTURE, State::CopyDest);
+    ExpectPass(tracker, *list, { MakeBarrier(TEXTURE, State::ShaderResource, State::RenderTarget, ALL_RHI_SUBRESOURCES,
+        RHIBarrierFlags::EndOnly), MakeBarrier(TEXTURE, State::RenderTarget, State::CopyDest) });
+
+    EXPECT_EQ(tracker.GetStats().splitBarriers, 2u);
+}
@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include "animation/gina_retarget.h"
+#include "asset/gina_model_importer.h"
+
+using namespace gina;
+
+namespace
+{
+    // Motion capture skeleton in centimetres with a neck the target lacks
+    const char* SOURCE_BVH =
+        "HIERARCHY\n"
+        "ROOT Hips\n"
+        "{\n"
+        "  OFFSET 0.0 0.0 0.0\n"
+        "  CHANNELS 6 Xposition Yposition Zposition Zrotation Xrotation Yrotation\n"
+        "  JOINT Spine\n"
+        "  {\n"
+        "    OFFSET 0.0 10.0 0.0\n"
+        "    CHANNELS 3 Zrotation Xrotation Yrotation\n"
+        "    JOINT Neck\n"
+        "    {\n"
+        "      OFFSET 0.0 25.0 0.0\n"
+        "      CHANNELS 3 Zrotation Xrotation Yrotation\n"
+        "      JOINT Head\n"
+        "      {\n"
+        "        OFFSET 0.0 10.0 0.0\n"
+        "        CHANNELS 3 Zrotation Xrotation Yrotation\n"
+        "        End Site\n"
+        "        {\n"
+        "          OFFSET 0.0 15.0 0.0\n"
+        "        }\n"
+        "      }\n"
+        "    }\n"
+        "  }\n"
+        "  JOINT LeftUpLeg\n"
+        "  {\n"
+        "    OFFSET 10.0 0.0 0.0\n"
+        "    CHANNELS 3 Zrotation Xrotation Yrotation\n"
+        "    JOINT LeftLeg\n"
+        "    {\n"
+        "      OFFSET 0.0 -45.0 0.0\n"
+        "      CHANNELS 3 Zrotation Xrotation Yrotation\n"
+        "      End Site\n"
+        "      {\n"
+        "        OFFSET 0.0 -45.0 0.0\n"
+        "      }\n"
+        "    }\n"
+        "  }\n"
+        "}\n"
+        "MOTION\n"
+        "Frames: 3\n"
+        "Frame Time: 0.5\n"
+        "0.0 90.0 0.0 0.0 0.0 0.0 0.0 0.0 0.0 0.0 0.0 0.0 0.0 0.0 0.0 0.0 0.0 0.0 0.0 0.0 0.0\n"
+        "5.0 92.0 50.0 10.0 20.0 30.0 5.0 -10.0 15.0 20.0 0.0 -5.0 0.0 10.0 0.0 -30.0 10.0 0.0 45.0 0.0 0.0\n"
+        "10.0 90.0 100.0 -15.0 5.0 60.0 -10.0 20.0 0.0 0.0 -25.0 10.0 15.0 0.0 -10.0 10.0 -60.0 5.0 90.0 5.0 0.0\n";
+
+    // Game rig in metres: namespaced names, a hips frame turned a quarter around y, an extra spine joint
+    // and a leg whose bone frames are flipped, with the leg joints named differently
+    const char* TARGET_GLTF = R"({
+        "asset": { "version": "2.0" },
+        "scene": 0,
+        "scenes": [ { "nodes": [ 0 ] } ],
+        "nodes": [
+            { "name": "rig:Hips", "rotation": [ 0.0, 0.70710678, 0.0, 0.70710678 ], "children": [ 1, 4 ] },
+            { "name": "rig:Spine", "translation": [ 0.0, 0.15, 0.0 ], "children": [ 2 ] },
+            { "name": "rig:Spine1", "translation": [ 0.0, 0.15, 0.0 ], "rotation": [ 0.17364818, 0.0, 0.0, 0.98480775 ], "children": [ 3 ] },
+            { "name": "rig:Head", "translation": [ 0.0, 0.2, 0.0 ] },
+            { "name": "LeftThigh", "translation": [ 0.0, 0.0, 0.1 ], "rotation": [ 0.0, 0.0, 1.0, 0.0 ], "children": [ 5 ] },
+            { "name": "LeftShin", "translation": [ 0.0, 0.42, 0.0 ] }
+        ]
+    })";
+
+    Skeleton ImportSkeleton(const char* data, const char* format, std::vector<AnimationClip>& clips)
+    {
+        std::vector<SkeletonJointDesc> joints;
+        EXPECT_TRUE(ModelImporter::ImportAnimationsFromMemory(data, std::strlen(data), format, 30.0f, joints, clips));
+
+        std::vector<uint16> sortedIndices;
+        Skeleton skeleton = SkeletonBuilder::Build(joints, {}, &sortedIndices);
+        for (AnimationClip& clip : clips)
+        {
+            clip.RemapJoints(sortedIndices);
+        }
+        return skeleton;
+    }
+
+    std::vector<Transform> ToModel(const Skeleton& skeleton, const std::vector<Transform>& local)
+    {
+        std::vector<Transform> model(skeleton.GetJointCount());
+        PoseOps::LocalToModel(skeleton, local.data(), skeleton.GetJointCount(), model.data());
+        return model;
+    }
+
+    std::vector<Transform> RetargetPose(const RetargetMap& map, const std::vector<Transform>& sourceLocal)
+    {
+        PoseStreams source;
+        PoseStreams target;
+        source.Resize(map.GetSourceSlotCount());
+        PoseOps::ToStreams(sourceLocal.data(), map.sourceJointCount, source);
+        Retargeter::Retarget(map, source, target);
+
+        std::vector<Transform> targetLocal(map.targetJointCount);
+        PoseOps::FromStreams(target, map.targetJointCount, targetLocal.data());
+        return targetLocal;
+    }
+}
+
+TEST(RetargetTest, ImportedSkeletonsFollowSourceMotion)
+{
+    std::vector<AnimationClip> clips;
+    const Skeleton source = ImportSkeleton(SOURCE_BVH, "bvh", clips);
+    ASSERT_EQ(clips.size(), 1u);
+    std::vector<AnimationClip> noClips;
+    const Skeleton target = ImportSkeleton(TARGET_GLTF, "gltf", noClips);
+
+    const uint16 sourceHips = source.FindJoint("Hips");
+    const uint16 sourceUpLeg = source.FindJoint("LeftUpLeg");
+    const uint16 sourceLeg = source.FindJoint("LeftLeg");
+    const uint16 targetHips = target.FindJoint("rig:Hips");
+    const uint16 targetThigh = target.FindJoint("LeftThigh");
+    const uint16 targetShin = target.FindJoint("LeftShin");
+    ASSERT_NE(targetShin, INVALID_JOINT);
+
+    RetargetSettings settings;
+    settings.jointPairs = { { "LeftThigh", "LeftUpLeg" }, { "LeftShin", "LeftLeg" } };
+    const RetargetMap map = RetargetMapBuilder::Build(source, target, settings);
+
+    // Hips, spine, head (through the collapsed neck) and both leg joints; the extra spine joint keeps its bind pose
+    const std::vector<std::pair<uint16, uint16>> pairs = {
+        { targetHips, sourceHips }, { target.FindJoint("rig:Spine"), source.FindJoint("Spine") },
+        { target.FindJoint("rig:Head"), source.FindJoint("Head") }, { targetThigh, sourceUpLeg }, { targetShin, sourceLeg } };
+    EXPECT_EQ(map.GetMappedJointCount(), 5u);
+    EXPECT_EQ(map.chains.size(), 1u);
+    EXPECT_EQ(map.sourceSlots[target.FindJoint("rig:Spine1")], map.GetIdentitySlot());
+
+    // The source bind pose retargets to the target bind pose
+    const std::vector<Transform> bind = RetargetPose(map, source.bindPose);
+    for (uint32 joint = 0; joint < target.GetJointCount(); ++joint)
+    {
+        EXPECT_TRUE(bind[joint].rotation == target.bindPose[joint].rotation) << joint;
+        EXPECT_NEAR((bind[joint].translation - target.bindPose[joint].translation).length(), 0.0f, 1e-5f) << joint;
+    }
+
+    const std::vector<Transform> sourceBindModel = ToModel(source, source.bindPose);
+    const std::vector<Transform> targetBindModel = ToModel(target, target.bindPose);
+    const AnimationClip& clip = clips[0];
+    for (float time : { 0.0f, 0.4f, 0.75f, 1.0f })
+    {
+        std::vector<Transform> sourceLocal(source.GetJointCount());
+        AnimationSampler::Sample(clip, time, false, source.GetJointCount(), sourceLocal.data());
+        const std::vector<Transform> sourceModel = ToModel(source, sourceLocal);
+        const std::vector<Transform> targetModel = ToModel(target, RetargetPose(map, sourceLocal));
+
+        // Mapped joints turn by the same model space rotation from their bind pose
+        for (const auto& [t, s] : pairs)
+        {
+            const quaternion targetDelta = targetModel[t].rotation * targetBindModel[t].rotation.conjugate();
+            const quaternion sourceDelta = sourceModel[s].rotation * sourceBindModel[s].rotation.conjugate();
+            EXPECT_NEAR(std::fabs(dot(targetDelta, sourceDelta)), 1.0f, 1e-5f) << time << " " << t;
+        }
+
+        // Legs point the same way despite the flipped bone frames
+        const float3 targetShinDirection = (targetModel[targetShin].translation - targetModel[targetThigh].translation).normalized();
+        const float3 sourceLegDirection = (sourceModel[sourceLeg].translation - sourceModel[sourceUpLeg].translation).normalized();
+        EXPECT_GT(dot(targetShinDirection, sourceLegDirection), 0.9999f) << time;
+
+        // Hips travel scaled from centimetres to the smaller rig
+        const float3 targetMovement = targetModel[targetHips].translation - targetBindModel[targetHips].translation;
+        const float3 sourceMovement = sourceModel[sourceHips].translation - sourceBindModel[sourceHips].translation;
+        EXPECT_NEAR((targetMovement - sourceMovement * map.translationScale[targetHips]).length(), 0.0f, 1e-4f);
+    }
+    EXPECT_GT(map.translationScale[targetHips], 0.005f);
+    EXPECT_LT(map.translationScale[targetHips], 0.02f);
+    EXPECT_NEAR(map.translationScale[targetShin], 0.42f / 45.0f, 1e-5f);
+}
+
+TEST(RetargetTest, VectorPassMatchesScalar)
+{
+    // Two chains of 11 joints, the target with different proportions, bind rotations and every third joint extra
+    std::vector<SkeletonJointDesc> sourceJoints;
+    std::vector<SkeletonJointDesc> targetJoints;
+    for (uint32 i = 0; i < 22; ++i)
+    {
+        SkeletonJointDesc joint;
+        joint.name = "joint" + std::to_string(i % 11) + (i < 11 ? "" : "_r");
+        joint.parent = i == 0 || i == 11 ? (i == 0 ? INVALID_JOINT : 0) : static_cast<uint16>(i - 1);
+        joint.bindPose.translation = float3(0.1f * i, 1.0f, 0.0f);
+        sourceJoints.push_back(joint);
+
+        joint.name = "Rig|" + (i % 3 == 2 ? "extra" + std::to_string(i) : joint.name);
+        joint.bindPose.translation = float3(0.0f, 0.7f, 0.05f * i);
+        joint.bindPose.rotation = quaternion::fromAxisAngle(float3(0.0f, 0.0f, 1.0f), 0.2f * i);
+        targetJoints.push_back(joint);
+    }
+    const Skeleton source = SkeletonBuilder::Build(sourceJoints);
+    const Skeleton target = SkeletonBuilder::Build(targetJoints);
+    const RetargetMap map = RetargetMapBuilder::Build(source, target);
+    EXPECT_GT(map.chains.size(), 0u);
+
+    PoseStreams sourceStreams;
+    sourceStreams.Resize(map.GetSourceSlotCount());
+    for (uint32 joint = 0; joint < source.GetJointCount(); ++joint)
+    {
+        Transform pose;
+        pose.rotation = quaternion::fromAxisAngle(float3(0.3f, 1.0f, -0.2f).normalized(), 0.1f * joint - 0.8f);
+        pose.translation = source.bindPose[joint].translation + float3(0.01f * joint, -0.02f, 0.03f);
+        sourceStreams.Set(joint, pose);
+    }
+
+    PoseStreams vectorized;
+    Retargeter::Retarget(map, sourceStreams, vectorized);
+    PoseStreams scalar;
+    scalar.Resize(map.targetJointCount);
+    Retargeter::RetargetScalar(map, sourceStreams, scalar, 0, map.targetJointCount);
+    for (uint32 joint = 0; joint < map.targetJointCount; ++joint)
+    {
+        const Transform a = vectorized.Get(joint);
+        const Transform b = scalar.Get(joint);
+        EXPECT_NEAR(std::fabs(dot(a.rotation, b.rotation)), 1.0f, 1e-6f) << joint;
+        EXPECT_NEAR((a.translation - b.translation).length(), 0.0f, 1e-6f) << joint;
+    }
+}
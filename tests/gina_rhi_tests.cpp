@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "rhi/gina_null_rhi.h"
+
+using namespace gina;
+
+TEST(RHITest, NullBackendRecordsSubmittedCommandsInOrder)
+{
+    NullDevice device;
+    const RHIBufferHandle indices = device.CreateBuffer({ 1024, RHIMemoryType::Default, false, "indices" });
+    const RHITextureHandle target = device.CreateTexture({ 64, 64, 1, 1, RHIFormat::R8G8B8A8Unorm, RHITextureUsage::RenderTarget, "target" });
+
+    std::unique_ptr<RHICommandAllocator> allocator = device.CreateCommandAllocator(RHIQueueType::Graphics);
+    std::unique_ptr<RHICommandList> first = device.CreateCommandList(RHIQueueType::Graphics);
+    std::unique_ptr<RHICommandList> second = device.CreateCommandList(RHIQueueType::Graphics);
+
+    const RHIBarrier toTarget = { target, RHIResourceState::Common, RHIResourceState::RenderTarget };
+    const uint32 constants[] = { 7, 8, 9 };
+    first->Begin(*allocator);
+    first->Barrier(&toTarget, 1);
+    first->SetConstants(0, constants, 3);
+    first->SetIndexBuffer(indices, 0, 1024, false);
+    first->DrawIndexed(36, 2, 0, 4, 0);
+    first->End();
+
+    const RHIBarrier toPresent = { target, RHIResourceState::RenderTarget, RHIResourceState::Present };
+    second->Begin(*allocator);
+    second->SetConstants(1, constants + 1, 2);
+    second->Barrier(&toPresent, 1);
+    second->End();
+
+    RHIQueue& queue = device.GetQueue(RHIQueueType::Graphics);
+    RHICommandList* batch[] = { first.get() };
+    queue.Submit(batch, 1);
+    batch[0] = second.get();
+    queue.Submit(batch, 1);
+
+    // Both submissions land in one stream, their barrier and constant references rebased onto it
+    const NullCommandStream& stream = device.GetNullQueue(RHIQueueType::Graphics).GetStream();
+    ASSERT_EQ(stream.commands.size(), 6u);
+    EXPECT_EQ(stream.Count(NullCommandType::Barrier), 2u);
+    EXPECT_EQ(stream.Count(NullCommandType::SetConstants), 2u);
+
+    const NullCommand& draw = stream.commands[3];
+    EXPECT_EQ(draw.type, NullCommandType::DrawIndexed);
+    EXPECT_EQ(draw.args[0], 36u);
+    EXPECT_EQ(draw.args[1], 2u);
+    EXPECT_EQ(static_cast<int32>(draw.args[3]), 4);
+    EXPECT_EQ(draw.submission, 0u);
+    EXPECT_EQ(stream.commands[2].resources[0], indices);
+
+    const NullCommand& laterConstants = stream.commands[4];
+    EXPECT_EQ(laterConstants.submission, 1u);
+    EXPECT_EQ(laterConstants.list, static_cast<const NullCommandList*>(second.get())->GetId());
+    EXPECT_EQ(laterConstants.args[1], 1u);
+    EXPECT_EQ(stream.constants[laterConstants.args[0]], 8u);
+    EXPECT_EQ(stream.constants[laterConstants.args[0] + 1], 9u);
+
+    const NullCommand& laterBarrier = stream.commands[5];
+    ASSERT_EQ(laterBarrier.args[1], 1u);
+    EXPECT_EQ(stream.barriers[laterBarrier.args[0]], toPresent);
+
+    EXPECT_EQ(device.GetStats().submissions, 2u);
+    EXPECT_EQ(device.GetStats().commands, 6u);
+}
+
+TEST(RHITest, NullBackendSimulatesFenceLatency)
+{
+    NullDeviceSettings settings;
+    settings.submissionTime = 2.0;
+    settings.commandTime = 0.5;
+    NullDevice device(settings);
+
+    std::unique_ptr<RHIFence> fence = device.CreateFence();
+    std::unique_ptr<RHICommandAllocator> allocator = device.CreateCommandAllocator(RHIQueueType::Graphics);
+    std::unique_ptr<RHICommandList> list = device.CreateCommandList(RHIQueueType::Graphics);
+    RHIQueue& queue = device.GetQueue(RHIQueueType::Graphics);
+
+    list->Begin(*allocator);
+    list->Draw(3, 1, 0, 0);
+    list->Draw(3, 1, 0, 0);
+    list->End();
+    RHICommandList* batch[] = { list.get() };
+    queue.Submit(batch, 1);
+    const uint64 value = queue.Signal(*fence);
+    EXPECT_EQ(value, 1u);
+    EXPECT_EQ(fence->GetLastSignaledValue(), 1u);
+
+    // 2 ms for the batch plus 0.5 ms per draw
+    EXPECT_EQ(fence->GetCompletedValue(), 0u);
+    device.AdvanceTime(2.9);
+    EXPECT_EQ(fence->GetCompletedValue(), 0u);
+
+    // Resetting the allocator before the GPU finished with it is flagged
+    allocator->Reset();
+    EXPECT_EQ(device.GetStats().unsafeAllocatorResets, 1u);
+
+    fence->WaitOnCPU(value);
+    EXPECT_EQ(fence->GetCompletedValue(), 1u);
+    EXPECT_DOUBLE_EQ(device.GetTime(), 3.0);
+    EXPECT_EQ(device.GetStats().cpuWaits, 1u);
+    EXPECT_NEAR(device.GetStats().cpuWaitTime, 0.1, 1e-9);
+
+    allocator->Reset();
+    EXPECT_EQ(device.GetStats().unsafeAllocatorResets, 1u);
+
+    // Submissions queue behind busy work, and waits for completed values return at once
+    list->Begin(*allocator);
+    list->End();
+    queue.Submit(batch, 1);
+    queue.Submit(batch, 1);
+    const uint64 later = queue.Signal(*fence);
+    EXPECT_DOUBLE_EQ(static_cast<NullFence&>(*fence).GetCompletionTime(later), 7.0);
+    fence->WaitOnCPU(value);
+    EXPECT_EQ(device.GetStats().cpuWaits, 1u);
+
+    // A queue waiting on another queue's fence runs nothing until that value completes
+    std::unique_ptr<RHIFence> copyFence = device.CreateFence();
+    RHIQueue& copyQueue = device.GetQueue(RHIQueueType::Copy);
+    EXPECT_DOUBLE_EQ(static_cast<NullFence&>(*copyFence).GetCompletionTime(copyQueue.Signal(*copyFence)), 3.0);
+    copyQueue.Wait(*fence, later);
+    EXPECT_DOUBLE_EQ(static_cast<NullFence&>(*copyFence).GetCompletionTime(copyQueue.Signal(*copyFence)), 7.0);
+}
+
+TEST(RHITest, NullBackendTracksResources)
+{
+    NullDevice device;
+    const RHIBufferHandle upload = device.CreateBuffer({ 256, RHIMemoryType::Upload, false, "upload" });
+    const RHITextureHandle texture = device.CreateTexture({ 256, 128, 2, 3, RHIFormat::BC7Unorm, RHITextureUsage::ShaderResource, "albedo" });
+
+    // BC7 mips of 256x128, 128x64 and 64x32 texels at 16 bytes per 4x4 block, for both slices
+    const uint64 textureSize = 2 * (64 * 32 + 32 * 16 + 16 * 8) * 16;
+    EXPECT_EQ(GetTextureSize(*device.GetTextureDesc(texture)), textureSize);
+    EXPECT_EQ(device.GetStats().liveResources, 2u);
+    EXPECT_EQ(device.GetStats().residentBytes, 256 + textureSize);
+    EXPECT_EQ(device.GetBufferDesc(texture), nullptr);
+    EXPECT_EQ(device.GetTextureDesc(upload), nullptr);
+    EXPECT_EQ(device.GetBufferDesc(upload)->name, "upload");
+
+    byte* mapped = static_cast<byte*>(device.Map(upload));
+    ASSERT_NE(mapped, nullptr);
+    std::memset(mapped, 0xAB, 256);
+    EXPECT_EQ(static_cast<byte*>(device.Map(upload))[255], 0xAB);
+
+    device.DestroyResource(upload);
+    EXPECT_EQ(device.GetStats().liveResources, 1u);
+    EXPECT_EQ(device.GetStats().residentBytes, textureSize);
+    EXPECT_EQ(device.GetBufferDesc(upload), nullptr);
+
+    // Freed ids are reused
+    const RHIBufferHandle reused = device.CreateBuffer({ 64, RHIMemoryType::Readback, false, "readback" });
+    EXPECT_EQ(reused, upload);
+    EXPECT_EQ(device.GetStats().residentBytes, 64 + textureSize);
+}
+
+TEST(RHITest, NullBackendPlacesResourcesInHeaps)
+{
+    NullDevice device;
+    const RHIHeapHandle heap = device.CreateHeap({ 4 * RHI_HEAP_PLACEMENT_ALIGNMENT, RHIMemoryType::Default, "transients" });
+    const RHITextureDesc desc = { 128, 128, 1, 1, RHIFormat::R8G8B8A8Unorm, RHITextureUsage::RenderTarget, "target" };
+    const RHITextureHandle first = device.CreatePlacedTexture(heap, 0, desc);
+    const RHITextureHandle second = device.CreatePlacedTexture(heap, 0, desc);
+    const RHIBufferHandle buffer = device.CreatePlacedBuffer(heap, RHI_HEAP_PLACEMENT_ALIGNMENT, { 1024, RHIMemoryType::Default, true, "buffer" });
+
+    // Aliased resources share the heap's memory and add none of their own
+    EXPECT_EQ(device.GetPlacedTextureSize(desc), 128u * 128u * 4u);
+    EXPECT_EQ(device.GetStats().liveResources, 4u);
+    EXPECT_EQ(device.GetStats().residentBytes, 4 * RHI_HEAP_PLACEMENT_ALIGNMENT);
+    uint64 offset = 1;
+    EXPECT_EQ(device.GetPlacedHeap(second, offset), heap);
+    EXPECT_EQ(offset, 0u);
+    EXPECT_EQ(device.GetPlacedHeap(buffer, offset), heap);
+    EXPECT_EQ(offset, RHI_HEAP_PLACEMENT_ALIGNMENT);
+    EXPECT_FALSE(device.GetPlacedHeap(heap, offset).IsValid());
+    EXPECT_EQ(device.GetBufferDesc(heap), nullptr);
+    EXPECT_EQ(device.GetTextureDesc(first)->name, "target");
+
+    device.DestroyResource(first);
+    device.DestroyResource(second);
+    device.DestroyResource(buffer);
+    device.DestroyResource(heap);
+    EXPECT_EQ(device.GetStats().liveResources, 0u);
+    EXPECT_EQ(device.GetStats().residentBytes, 0u);
+
+    // Buffers placed in an upload heap map into its memory
+    const RHIHeapHandle uploadHeap = device.CreateHeap({ 2 * RHI_HEAP_PLACEMENT_ALIGNMENT, RHIMemoryType::Upload, "upload" });
+    const RHIBufferHandle low = device.CreatePlacedBuffer(uploadHeap, 0, { 256, RHIMemoryType::Upload, false, "low" });
+    const RHIBufferHandle high = device.CreatePlacedBuffer(uploadHeap, RHI_HEAP_PLACEMENT_ALIGNMENT, { 256, RHIMemoryType::Upload, false, "high" });
+    byte* lowMapped = static_cast<byte*>(device.Map(low));
+    ASSERT_NE(lowMapped, nullptr);
+    EXPECT_EQ(static_cast<byte*>(device.Map(high)), lowMapped + RHI_HEAP_PLACEMENT_ALIGNMENT);
+}
+
+TEST(RHITest, UploadLayoutFollowsCopyAlignment)
+{
+    EXPECT_EQ(GetMipSize(RHIFormat::R8G8B8A8Unorm, 13, 7), 13u * 7u * 4u);
+    EXPECT_EQ(GetMipSize(RHIFormat::BC1Unorm, 13, 7), 4u * 2u * 8u);
+    EXPECT_EQ(GetMipSize(RHIFormat::BC5Unorm, 1, 1), 16u);
+
+    // Rows are padded to 256 bytes
+    EXPECT_EQ(GetUploadRowPitch(RHIFormat::R8G8B8A8Unorm, 13), 256u);
+    EXPECT_EQ(GetUploadRowPitch(RHIFormat::R8G8B8A8Unorm, 65), 512u);
+    EXPECT_EQ(GetUploadRowPitch(RHIFormat::BC7Unorm, 64), 256u);
+    EXPECT_EQ(GetUploadMipSize(RHIFormat::R8G8B8A8Unorm, 13, 7), 7u * 256u);
+    EXPECT_EQ(GetUploadMipSize(RHIFormat::BC7Unorm, 256, 256), 64u * 1024u);
+
+    EXPECT_TRUE(IsReadOnlyState(RHIResourceState::ShaderResource | RHIResourceState::CopySource));
+    EXPECT_FALSE(IsReadOnlyState(RHIResourceState::CopyDest));
+    EXPECT_TRUE(IsReadOnlyState(RHIResourceState::Common));
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "animation/gina_root_motion.h"
+#include "asset/gina_model_importer.h"
+#include "asset/gina_root_motion_asset.h"
+
+using namespace gina;
+
+namespace
+{
+    // Root walking a circle of radius 3 at 1.5 m/s while its pelvis bobs and the root pitches slightly
+    AnimationClip CreateArcClip(float duration)
+    {
+        AnimationClip clip;
+        clip.name = "arc";
+        clip.duration = duration;
+        clip.sampleRate = 30.0f;
+        clip.jointCount = 2;
+
+        const uint32 frameCount = static_cast<uint32>(duration * clip.sampleRate) + 1;
+        for (uint32 frame = 0; frame < frameCount; ++frame)
+        {
+            const float time = frame / clip.sampleRate;
+            const float angle = 0.5f * time + 0.3f;
+
+            Transform root;
+            root.translation = float3(3.0f * (1.0f - std::cos(angle)), 0.05f * std::sin(6.0f * time), 3.0f * std::sin(angle));
+            root.rotation = quaternion::fromAxisAngle(float3(0.0f, 1.0f, 0.0f), angle) *
+                quaternion::fromAxisAngle(float3(1.0f, 0.0f, 0.0f), 0.1f * std::sin(6.0f * time));
+            clip.frames.push_back(root);
+
+            Transform pelvis;
+            pelvis.translation = float3(0.0f, 1.0f, 0.0f);
+            clip.frames.push_back(pelvis);
+        }
+        return clip;
+    }
+
+    float Heading(const quaternion& rotation)
+    {
+        const float3 forward = rotation.rotate(float3(0.0f, 0.0f, 1.0f));
+        return std::atan2(forward.x, forward.z);
+    }
+}
+
+TEST(RootMotionTest, DeltaMatchesSampledRoot)
+{
+    const AnimationClip original = CreateArcClip(2.0f);
+    AnimationClip clip = original;
+    const RootMotionTrack track = RootMotionExtractor::Extract(clip);
+    EXPECT_EQ(track.GetFrameCount(), original.GetFrameCount());
+
+    for (float start : { 0.0f, 0.37f, 1.2f })
+    {
+        for (float end : { 0.5f, 1.0f, 1.99f })
+        {
+            Transform a, b;
+            AnimationSampler::Sample(original, start, false, 1, &a);
+            AnimationSampler::Sample(original, end, false, 1, &b);
+            const float startYaw = Heading(a.rotation);
+
+            // Ground movement in the character's frame at the start
+            const float3 movement = quaternion::fromAxisAngle(float3(0.0f, 1.0f, 0.0f), -startYaw).rotate(b.translation - a.translation);
+            const RootMotionDelta delta = track.GetDelta(start, end, false);
+            EXPECT_NEAR(delta.translation.x, movement.x, 2e-3f);
+            EXPECT_NEAR(delta.translation.y, 0.0f, 1e-6f);
+            EXPECT_NEAR(delta.translation.z, movement.z, 2e-3f);
+            EXPECT_NEAR(delta.yaw, Heading(b.rotation) - startYaw, 1e-4f);
+        }
+    }
+
+    // The stripped clip plays in place facing +z, keeping the bob and pitch
+    for (uint32 frame = 0; frame < clip.GetFrameCount(); ++frame)
+    {
+        const Transform& root = clip.frames[frame * clip.jointCount];
+        const Transform& source = original.frames[frame * clip.jointCount];
+        EXPECT_NEAR(root.translation.x, 0.0f, 1e-5f);
+        EXPECT_NEAR(root.translation.z, 0.0f, 1e-5f);
+        EXPECT_NEAR(root.translation.y, source.translation.y, 1e-6f);
+        EXPECT_NEAR(Heading(root.rotation), 0.0f, 1e-5f);
+        EXPECT_EQ(clip.frames[frame * clip.jointCount + 1].translation, original.frames[frame * clip.jointCount + 1].translation);
+    }
+}
+
+TEST(RootMotionTest, LoopingDeltasAccumulateCycles)
+{
+    AnimationClip clip = CreateArcClip(1.0f);
+    const RootMotionTrack track = RootMotionExtractor::Extract(clip);
+
+    // Ticking through three and a half cycles ends where a single query spanning them does
+    Transform ticked;
+    float time = 0.2f;
+    for (uint32 tick = 0; tick < 210; ++tick)
+    {
+        RootMotionSampler::Accumulate(ticked, track.GetDelta(time, time + 1.0f / 60.0f, true));
+        time += 1.0f / 60.0f;
+    }
+
+    Transform jumped;
+    RootMotionSampler::Accumulate(jumped, track.GetDelta(0.2f, time, true));
+    EXPECT_NEAR(ticked.translation.x, jumped.translation.x, 1e-3f);
+    EXPECT_NEAR(ticked.translation.z, jumped.translation.z, 1e-3f);
+    EXPECT_NEAR(Heading(ticked.rotation), Heading(jumped.rotation), 1e-4f);
+
+    // Each whole cycle adds the clip's full displacement and turn
+    const RootMotionDelta cycle = track.GetDelta(0.0f, 1.0f, true);
+    EXPECT_NEAR(cycle.yaw, 0.5f, 1e-4f);
+    const RootMotionDelta twoCycles = track.GetDelta(5.0f, 7.0f, true);
+    EXPECT_NEAR(twoCycles.yaw, 1.0f, 1e-4f);
+    Transform twice;
+    RootMotionSampler::Accumulate(twice, cycle);
+    RootMotionSampler::Accumulate(twice, cycle);
+    EXPECT_NEAR(twoCycles.translation.x, twice.translation.x, 1e-4f);
+    EXPECT_NEAR(twoCycles.translation.z, twice.translation.z, 1e-4f);
+
+    // Many cycles at once, forwards and backwards, compose like repeating one
+    Transform repeated;
+    for (uint32 i = 0; i < 40; ++i)
+    {
+        RootMotionSampler::Accumulate(repeated, cycle);
+    }
+    Transform composed;
+    RootMotionSampler::Accumulate(composed, track.GetDelta(0.0f, 40.0f, true));
+    EXPECT_NEAR(composed.translation.x, repeated.translation.x, 1e-3f);
+    EXPECT_NEAR(composed.translation.z, repeated.translation.z, 1e-3f);
+    EXPECT_NEAR(Heading(composed.rotation), Heading(repeated.rotation), 1e-3f);
+    RootMotionSampler::Accumulate(composed, track.GetDelta(40.0f, 0.0f, true));
+    EXPECT_NEAR(composed.translation.length(), 0.0f, 1e-3f);
+
+    // Playing backwards across the wrap undoes playing forwards
+    Transform character;
+    RootMotionSampler::Accumulate(character, track.GetDelta(0.9f, 1.3f, true));
+    RootMotionSampler::Accumulate(character, track.GetDelta(1.3f, 0.9f, true));
+    EXPECT_NEAR(character.translation.length(), 0.0f, 1e-5f);
+    EXPECT_NEAR(Heading(character.rotation), 0.0f, 1e-5f);
+
+    // Without looping the times clamp to the clip
+    const RootMotionDelta clamped = track.GetDelta(0.5f, 3.0f, false);
+    const RootMotionDelta toEnd = track.GetDelta(0.5f, 1.0f, false);
+    EXPECT_EQ(clamped.translation, toEnd.translation);
+    EXPECT_FLOAT_EQ(clamped.yaw, toEnd.yaw);
+}
+
+TEST(RootMotionTest, CooksRootTrackFromImportedClip)
+{
+    // Walks 40 units forward while turning a quarter turn left, over one second
+    const char* bvh =
+        "HIERARCHY\n"
+        "ROOT Hips\n"
+        "{\n"
+        "  OFFSET 0.0 0.0 0.0\n"
+        "  CHANNELS 6 Xposition Yposition Zposition Zrotation Xrotation Yrotation\n"
+        "  JOINT Spine\n"
+        "  {\n"
+        "    OFFSET 0.0 10.0 0.0\n"
+        "    CHANNELS 3 Zrotation Xrotation Yrotation\n"
+        "    End Site\n"
+        "    {\n"
+        "      OFFSET 0.0 10.0 0.0\n"
+        "    }\n"
+        "  }\n"
+        "}\n"
+        "MOTION\n"
+        "Frames: 5\n"
+        "Frame Time: 0.25\n"
+        "0.0 90.0 0.0 0.0 0.0 0.0 0.0 0.0 0.0\n"
+        "0.0 90.0 10.0 0.0 0.0 22.5 0.0 0.0 0.0\n"
+        "0.0 90.0 20.0 0.0 0.0 45.0 0.0 0.0 0.0\n"
+        "0.0 90.0 30.0 0.0 0.0 67.5 0.0 0.0 0.0\n"
+        "0.0 90.0 40.0 0.0 0.0 90.0 0.0 0.0 0.0\n";
+
+    std::vector<SkeletonJointDesc> joints;
+    std::vector<AnimationClip> clips;
+    ASSERT_TRUE(ModelImporter::ImportAnimationsFromMemory(bvh, std::strlen(bvh), "bvh", 20.0f, joints, clips));
+    ASSERT_EQ(clips.size(), 1u);
+    ASSERT_GE(joints.size(), 2u);
+    EXPECT_EQ(joints[0].name, "Hips");
+    EXPECT_EQ(joints[1].parent, 0);
+    EXPECT_FLOAT_EQ(clips[0].duration, 1.0f);
+    EXPECT_EQ(clips[0].GetFrameCount(), 21u);
+    EXPECT_NEAR(clips[0].frames[10 * clips[0].jointCount].translation.z, 20.0f, 1e-4f);
+
+    const RootMotionTrack track = RootMotionExtractor::Extract(clips[0]);
+    const RootMotionDelta delta = track.GetDelta(0.0f, 1.0f, false);
+    EXPECT_NEAR(delta.translation.z, 40.0f, 1e-3f);
+    EXPECT_NEAR(delta.yaw, 0.5f * PI, 1e-4f);
+    EXPECT_NEAR(clips[0].frames[20 * clips[0].jointCount].translation.z, 0.0f, 1e-4f);
+    EXPECT_NEAR(clips[0].frames[20 * clips[0].jointCount].translation.y, 90.0f, 1e-4f);
+
+    BinaryWriter writer;
+    RootMotionAssetSerializer::Serialize(writer, { track });
+    BinaryReader reader(writer.GetBuffer());
+    std::vector<RootMotionTrack> loaded;
+    ASSERT_TRUE(RootMotionAssetSerializer::Deserialize(reader, loaded));
+    ASSERT_EQ(loaded.size(), 1u);
+    EXPECT_EQ(loaded[0].GetFrameCount(), track.GetFrameCount());
+    EXPECT_FLOAT_EQ(loaded[0].GetDelta(0.25f, 0.75f, false).yaw, track.GetDelta(0.25f, 0.75f, false).yaw);
+}
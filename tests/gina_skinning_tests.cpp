@@ -0,0 +1,398 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "animation/gina_pose.h"
+#include "animation/gina_skinning.h"
+#include "core/gina_cpu_features.h"
+
+using namespace gina;
+
+namespace
+{
+    void AddJoint(std::vector<SkeletonJointDesc>& joints, const char* name, uint16 parent, const float3& offset)
+    {
+        SkeletonJointDesc joint;
+        joint.name = name;
+        joint.parent = parent;
+        joint.bindPose.translation = offset;
+        joints.push_back(joint);
+    }
+
+    Skeleton CreateArmSkeleton()
+    {
+        std::vector<SkeletonJointDesc> joints;
+        AddJoint(joints, "root", INVALID_JOINT, float3(0.0f, 0.0f, 0.0f));
+        AddJoint(joints, "upper", 0, float3(0.0f, 1.0f, 0.0f));
+        AddJoint(joints, "lower", 1, float3(1.0f, 0.0f, 0.0f));
+        AddJoint(joints, "hand", 2, float3(1.0f, 0.0f, 0.0f));
+        AddJoint(joints, "finger", 3, float3(0.01f, 0.0f, 0.0f));
+        return SkeletonBuilder::Build(joints);
+    }
+
+    // Random vertices with up to four random influences; the count is deliberately not a multiple of 8
+    SkinningData CreateRandomData(uint32 vertexCount, uint32 jointCount, uint32 seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> weight(0.0f, 1.0f);
+        std::uniform_int_distribution<uint32> joint(0, jointCount - 1);
+
+        SkinningData data;
+        data.bindVertices.Resize(vertexCount, true);
+        for (uint32 v = 0; v < vertexCount; ++v)
+        {
+            data.bindVertices.positionX[v] = coordinate(random);
+            data.bindVertices.positionY[v] = coordinate(random);
+            data.bindVertices.positionZ[v] = coordinate(random);
+
+            const float3 normal = float3(coordinate(random), coordinate(random), coordinate(random)).normalized();
+            data.bindVertices.normalX[v] = normal.x;
+            data.bindVertices.normalY[v] = normal.y;
+            data.bindVertices.normalZ[v] = normal.z;
+
+            float weights[MAX_SKIN_INFLUENCES];
+            uint32 joints = 0;
+            for (uint32 i = 0; i < MAX_SKIN_INFLUENCES; ++i)
+            {
+                weights[i] = weight(random);
+                joints |= joint(random) << (i * 8);
+            }
+            data.joints.push_back(joints);
+            data.weights.push_back(SkinningData::PackWeights(weights));
+        }
+        return data;
+    }
+
+    std::vector<float3x4> CreateRandomPalette(uint32 jointCount, uint32 seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+
+        std::vector<float3x4> palette(jointCount);
+        for (float3x4& matrix : palette)
+        {
+            const quaternion rotation = quaternion(value(random), value(random), value(random), value(random)).normalized();
+            matrix = float3x4::fromRotationTranslationScale(rotation, float3(value(random), value(random), value(random)), float3(1.0f));
+        }
+        return palette;
+    }
+
+    std::vector<Transform> CreateRandomTransforms(uint32 count, uint32 seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+
+        std::vector<Transform> transforms(count);
+        for (Transform& transform : transforms)
+        {
+            transform.rotation = quaternion(value(random), value(random), value(random), value(random)).normalized();
+            transform.translation = float3(value(random), value(random), value(random));
+        }
+        return transforms;
+    }
+
+    void ExpectStreamsNear(const VertexStreams& expected, const VertexStreams& actual, float tolerance)
+    {
+        ASSERT_EQ(expected.GetVertexCount(), actual.GetVertexCount());
+        for (uint32 v = 0; v < expected.GetVertexCount(); ++v)
+        {
+            ASSERT_NEAR(expected.positionX[v], actual.positionX[v], tolerance) << "vertex " << v;
+            ASSERT_NEAR(expected.positionY[v], actual.positionY[v], tolerance) << "vertex " << v;
+            ASSERT_NEAR(expected.positionZ[v], actual.positionZ[v], tolerance) << "vertex " << v;
+            ASSERT_NEAR(expected.normalX[v], actual.normalX[v], tolerance) << "vertex " << v;
+            ASSERT_NEAR(expected.normalY[v], actual.normalY[v], tolerance) << "vertex " << v;
+            ASSERT_NEAR(expected.normalZ[v], actual.normalZ[v], tolerance) << "vertex " << v;
+        }
+    }
+}
+
+TEST(SkinningTest, PackedWeightsSumTo255)
+{
+    const float thirds[MAX_SKIN_INFLUENCES] = { 1.0f, 1.0f, 1.0f, 0.0f };
+    const float rigid[MAX_SKIN_INFLUENCES] = { 0.0f, 0.0f, 2.0f, 0.0f };
+    const float none[MAX_SKIN_INFLUENCES] = {};
+
+    for (const float* weights : { thirds, rigid, none })
+    {
+        const uint32 packed = SkinningData::PackWeights(weights);
+        const uint32 sum = (packed & 0xFF) + ((packed >> 8) & 0xFF) + ((packed >> 16) & 0xFF) + (packed >> 24);
+        EXPECT_EQ(sum, 255u);
+    }
+
+    EXPECT_EQ(SkinningData::PackWeights(rigid), 255u << 16);
+    EXPECT_EQ(SkinningData::PackWeights(none), 255u);
+}
+
+TEST(SkinningTest, BindPoseLeavesVerticesInPlace)
+{
+    const Skeleton skeleton = CreateArmSkeleton();
+    const std::vector<float3x4> inverseBind = Skinning::ComputeInverseBindMatrices(skeleton);
+
+    std::vector<Transform> model(skeleton.GetJointCount());
+    PoseOps::LocalToModel(skeleton, skeleton.bindPose.data(), skeleton.GetJointCount(), model.data());
+
+    std::vector<float3x4> palette(skeleton.GetJointCount());
+    Skinning::BuildPalette(skeleton, inverseBind, model.data(), 0, palette.data());
+
+    const SkinningData data = CreateRandomData(37, skeleton.GetJointCount(), 3);
+    VertexStreams output;
+    Skinning::Skin(data, palette.data(), output);
+
+    ExpectStreamsNear(data.bindVertices, output, 1e-5f);
+}
+
+TEST(SkinningTest, RotatedJointMovesItsVertices)
+{
+    const Skeleton skeleton = CreateArmSkeleton();
+    const std::vector<float3x4> inverseBind = Skinning::ComputeInverseBindMatrices(skeleton);
+
+    // Bend the elbow 90 degrees around Z: a vertex at the hand swings from (2, 1, 0) to (1, 2, 0)
+    std::vector<Transform> local = skeleton.bindPose;
+    local[skeleton.FindJoint("lower")].rotation = quaternion::fromAxisAngle(float3(0.0f, 0.0f, 1.0f), ConvertToRadians(90.0f));
+    std::vector<Transform> model(skeleton.GetJointCount());
+    PoseOps::LocalToModel(skeleton, local.data(), skeleton.GetJointCount(), model.data());
+
+    std::vector<float3x4> palette(skeleton.GetJointCount());
+    Skinning::BuildPalette(skeleton, inverseBind, model.data(), 0, palette.data());
+
+    Mesh mesh;
+    mesh.positions = { float3(2.0f, 1.0f, 0.0f), float3(1.5f, 1.0f, 0.0f) };
+    mesh.normals = { float3(1.0f, 0.0f, 0.0f), float3(1.0f, 0.0f, 0.0f) };
+    mesh.jointNames = { "lower", "upper", "unknown" };
+    mesh.skinning.resize(2);
+    mesh.skinning[0].joints[0] = 0;
+    mesh.skinning[0].weights[0] = 1.0f;
+    mesh.skinning[1].joints[0] = 0;
+    mesh.skinning[1].joints[1] = 1;
+    mesh.skinning[1].joints[2] = 2;
+    mesh.skinning[1].weights[0] = 0.25f;
+    mesh.skinning[1].weights[1] = 0.25f;
+    mesh.skinning[1].weights[2] = 0.5f; // dropped, the skeleton has no such joint
+
+    const SkinningData data = SkinningData::FromMesh(mesh, skeleton);
+    VertexStreams output;
+    Skinning::Skin(data, palette.data(), output);
+
+    EXPECT_NEAR(output.positionX[0], 1.0f, 1e-5f);
+    EXPECT_NEAR(output.positionY[0], 2.0f, 1e-5f);
+    EXPECT_NEAR(output.normalY[0], 1.0f, 1e-5f);
+
+    // Half lower arm (1, 1.5), half upper arm (1.5, 1)
+    EXPECT_NEAR(output.positionX[1], 1.25f, 1e-2f);
+    EXPECT_NEAR(output.positionY[1], 1.25f, 1e-2f);
+}
+
+TEST(SkinningTest, LodPaletteFollowsKeptAncestors)
+{
+    const Skeleton skeleton = CreateArmSkeleton();
+    const std::vector<float3x4> inverseBind = Skinning::ComputeInverseBindMatrices(skeleton);
+    ASSERT_GT(skeleton.GetLodCount(), 1u);
+
+    std::vector<Transform> local = skeleton.bindPose;
+    local[skeleton.FindJoint("hand")].rotation = quaternion::fromAxisAngle(float3(0.0f, 1.0f, 0.0f), 0.7f);
+    std::vector<Transform> model(skeleton.GetJointCount());
+    PoseOps::LocalToModel(skeleton, local.data(), skeleton.GetJointCount(), model.data());
+
+    const uint32 lod = skeleton.GetLodCount() - 1;
+    std::vector<float3x4> palette(skeleton.GetJointCount());
+    Skinning::BuildPalette(skeleton, inverseBind, model.data(), lod, palette.data());
+
+    const uint16* remap = skeleton.GetLodRemap(lod);
+    for (uint32 joint = skeleton.GetLodJointCount(lod); joint < skeleton.GetJointCount(); ++joint)
+    {
+        const float* culled = palette[joint].data();
+        const float* ancestor = palette[remap[joint]].data();
+        for (uint32 e = 0; e < 12; ++e)
+        {
+            EXPECT_EQ(culled[e], ancestor[e]);
+        }
+    }
+}
+
+TEST(SkinningTest, SimdKernelsMatchScalarReference)
+{
+    constexpr uint32 VERTEX_COUNT = 1003;
+    constexpr uint32 JOINT_COUNT = 64;
+
+    const SkinningData data = CreateRandomData(VERTEX_COUNT, JOINT_COUNT, 7);
+    const std::vector<float3x4> palette = CreateRandomPalette(JOINT_COUNT, 11);
+
+    VertexStreams reference;
+    reference.Resize(VERTEX_COUNT, true);
+    Skinning::SkinScalar(data, palette.data(), reference, 0, VERTEX_COUNT);
+
+#if defined(GINA_SSE2_ENABLED)
+    VertexStreams sse2;
+    sse2.Resize(VERTEX_COUNT, true);
+    Skinning::SkinSSE2(data, palette.data(), sse2, 0, VERTEX_COUNT);
+    ExpectStreamsNear(reference, sse2, 1e-5f);
+
+    if (CpuFeatures::HasAVX2())
+    {
+        VertexStreams avx2;
+        avx2.Resize(VERTEX_COUNT, true);
+        Skinning::SkinAVX2(data, palette.data(), avx2, 0, VERTEX_COUNT);
+        ExpectStreamsNear(reference, avx2, 1e-5f);
+
+        // Unaligned sub-range exercises the 8-wide loop, the 4-wide remainder and the scalar tail
+        VertexStreams range = reference;
+        Skinning::SkinAVX2(data, palette.data(), range, 5, 5 + 8 + 4 + 3);
+        ExpectStreamsNear(reference, range, 1e-5f);
+    }
+#endif
+}
+
+TEST(SkinningTest, ThreadedSkinningMatchesSingleThreaded)
+{
+    constexpr uint32 VERTEX_COUNT = 10 * SKINNING_BATCH_SIZE + 17;
+    constexpr uint32 JOINT_COUNT = 200;
+
+    const SkinningData data = CreateRandomData(VERTEX_COUNT, JOINT_COUNT, 5);
+    const std::vector<float3x4> palette = CreateRandomPalette(JOINT_COUNT, 13);
+
+    VertexStreams single;
+    Skinning::Skin(data, palette.data(), single);
+
+    ThreadPool threadPool(3);
+    VertexStreams threaded;
+    Skinning::Skin(data, palette.data(), threaded, &threadPool);
+
+    ExpectStreamsNear(single, threaded, 0.0f);
+}
+
+TEST(SkinningTest, DualQuaternionPreservesVolumeAtTwist)
+{
+    // A ring of vertices around a twist joint, half weighted to a joint turned 180 degrees around
+    // the bone axis: blended matrices collapse the ring onto the axis, dual quaternions keep its radius
+    std::vector<Transform> model(2);
+    model[1].rotation = quaternion::fromAxisAngle(float3(1.0f, 0.0f, 0.0f), ConvertToRadians(179.0f));
+
+    std::vector<float3x4> matrices = { model[0].ToMatrix(), model[1].ToMatrix() };
+    std::vector<dualquaternion> dualQuaternions(2);
+    Skinning::ConvertPaletteScalar(std::vector<Transform>(2).data(), model.data(), 2, dualQuaternions.data());
+
+    SkinningData data;
+    data.bindVertices.Resize(8, true);
+    for (uint32 v = 0; v < 8; ++v)
+    {
+        const float angle = 2.0f * PI * v / 8.0f;
+        data.bindVertices.positionX[v] = 1.0f;
+        data.bindVertices.positionY[v] = data.bindVertices.normalY[v] = std::cos(angle);
+        data.bindVertices.positionZ[v] = data.bindVertices.normalZ[v] = std::sin(angle);
+
+        const float weights[MAX_SKIN_INFLUENCES] = { 0.5f, 0.5f, 0.0f, 0.0f };
+        data.joints.push_back(0 | (1 << 8));
+        data.weights.push_back(SkinningData::PackWeights(weights));
+    }
+
+    VertexStreams linear;
+    VertexStreams dual;
+    Skinning::Skin(data, matrices.data(), linear);
+    Skinning::Skin(data, dualQuaternions.data(), dual);
+
+    for (uint32 v = 0; v < 8; ++v)
+    {
+        const float linearRadius = float2(linear.positionY[v], linear.positionZ[v]).length();
+        const float dualRadius = float2(dual.positionY[v], dual.positionZ[v]).length();
+        EXPECT_LT(linearRadius, 0.05f);
+        EXPECT_NEAR(dualRadius, 1.0f, 1e-4f);
+        EXPECT_NEAR(dual.positionX[v], 1.0f, 1e-5f);
+        EXPECT_NEAR(float3(dual.normalX[v], dual.normalY[v], dual.normalZ[v]).length(), 1.0f, 1e-5f);
+    }
+}
+
+TEST(SkinningTest, DualQuaternionMatchesLinearForRigidVertices)
+{
+    const Skeleton skeleton = CreateArmSkeleton();
+
+    std::vector<Transform> local = skeleton.bindPose;
+    local[skeleton.FindJoint("lower")].rotation = quaternion::fromAxisAngle(float3(0.0f, 0.0f, 1.0f), ConvertToRadians(60.0f));
+    local[skeleton.FindJoint("hand")].rotation = quaternion::fromAxisAngle(float3(0.0f, 1.0f, 0.0f), ConvertToRadians(-30.0f));
+    std::vector<Transform> model(skeleton.GetJointCount());
+    PoseOps::LocalToModel(skeleton, local.data(), skeleton.GetJointCount(), model.data());
+
+    const uint32 lod = skeleton.GetLodCount() - 1;
+    std::vector<float3x4> matrices(skeleton.GetJointCount());
+    Skinning::BuildPalette(skeleton, Skinning::ComputeInverseBindMatrices(skeleton), model.data(), lod, matrices.data());
+    std::vector<dualquaternion> dualQuaternions(skeleton.GetJointCount());
+    Skinning::BuildDualQuaternionPalette(skeleton, Skinning::ComputeInverseBindTransforms(skeleton), model.data(), lod, dualQuaternions.data());
+
+    // One full-weight influence per vertex: both methods apply the same rigid transform
+    SkinningData data = CreateRandomData(29, skeleton.GetJointCount(), 17);
+    for (uint32 v = 0; v < data.GetVertexCount(); ++v)
+    {
+        data.joints[v] = v % skeleton.GetJointCount();
+        data.weights[v] = 255;
+    }
+
+    VertexStreams linear;
+    VertexStreams dual;
+    Skinning::Skin(data, matrices.data(), linear);
+    Skinning::Skin(data, dualQuaternions.data(), dual);
+    ExpectStreamsNear(linear, dual, 1e-5f);
+}
+
+TEST(SkinningTest, DualQuaternionSimdMatchesScalarReference)
+{
+    constexpr uint32 VERTEX_COUNT = 1003;
+    constexpr uint32 JOINT_COUNT = 67;
+
+    const std::vector<Transform> inverseBind = CreateRandomTransforms(JOINT_COUNT, 19);
+    const std::vector<Transform> model = CreateRandomTransforms(JOINT_COUNT, 23);
+
+    std::vector<dualquaternion> palette(JOINT_COUNT);
+    Skinning::ConvertPaletteScalar(inverseBind.data(), model.data(), JOINT_COUNT, palette.data());
+
+    const SkinningData data = CreateRandomData(VERTEX_COUNT, JOINT_COUNT, 29);
+    VertexStreams reference;
+    reference.Resize(VERTEX_COUNT, true);
+    Skinning::SkinDualQuaternionScalar(data, palette.data(), reference, 0, VERTEX_COUNT);
+
+#if defined(GINA_SSE2_ENABLED)
+    std::vector<dualquaternion> convertedSSE2(JOINT_COUNT);
+    Skinning::ConvertPaletteSSE2(inverseBind.data(), model.data(), JOINT_COUNT, convertedSSE2.data());
+    for (uint32 joint = 0; joint < JOINT_COUNT; ++joint)
+    {
+        for (uint32 e = 0; e < 8; ++e)
+        {
+            EXPECT_NEAR(convertedSSE2[joint].data()[e], palette[joint].data()[e], 1e-6f);
+        }
+    }
+
+    VertexStreams sse2;
+    sse2.Resize(VERTEX_COUNT, true);
+    Skinning::SkinDualQuaternionSSE2(data, palette.data(), sse2, 0, VERTEX_COUNT);
+    ExpectStreamsNear(reference, sse2, 1e-5f);
+
+    if (CpuFeatures::HasAVX2())
+    {
+        VertexStreams avx2;
+        avx2.Resize(VERTEX_COUNT, true);
+        Skinning::SkinDualQuaternionAVX2(data, palette.data(), avx2, 0, VERTEX_COUNT);
+        ExpectStreamsNear(reference, avx2, 1e-5f);
+    }
+#endif
+}
+
+TEST(ThreadPoolTest, ParallelForCoversRangeOnce)
+{
+    ThreadPool threadPool(3);
+    EXPECT_EQ(threadPool.GetWorkerCount(), 3u);
+
+    for (uint32 count : { 0u, 1u, 63u, 64u, 1000u })
+    {
+        std::vector<std::atomic<uint32>> visits(count);
+        threadPool.ParallelFor(count, 16, [&](uint32 begin, uint32 end)
+        {
+            EXPECT_LE(end - begin, 16u);
+            for (uint32 i = begin; i < end; ++i)
+            {
+                visits[i].fetch_add(1);
+            }
+        });
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(visits[i].load(), 1u) << "count " << count << ", index " << i;
+        }
+    }
+}
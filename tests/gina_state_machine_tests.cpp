@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "animation/gina_state_machine.h"
+#include "core/gina_action.h"
+
+using namespace gina;
+
+namespace
+{
+    constexpr uint32 JOINT_COUNT = 2;
+
+    AnimationClip CreateConstantClip(float x)
+    {
+        AnimationClip clip;
+        clip.duration = 1.0f;
+        clip.sampleRate = 1.0f;
+        clip.jointCount = JOINT_COUNT;
+        for (uint32 i = 0; i < 2 * JOINT_COUNT; ++i)
+        {
+            Transform transform;
+            transform.translation = float3(x, 0.0f, 0.0f);
+            clip.frames.push_back(transform);
+        }
+        return clip;
+    }
+
+    float EvaluateX(StateMachineInstance& instance)
+    {
+        Transform local[JOINT_COUNT];
+        StateMachineEvaluator::Evaluate(instance, JOINT_COUNT, local);
+        return local[0].translation.x;
+    }
+
+    // Idle, walk and hit states each playing a constant clip at x = 0, 1 and 2
+    class StateMachineTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            for (uint32 i = 0; i < 3; ++i)
+            {
+                clips[i] = CreateConstantClip(static_cast<float>(i));
+                trees[i].AddClip(&clips[i]);
+            }
+
+            speed = machine.AddParameter("speed");
+            hit = machine.AddParameter("hit");
+            idle = machine.AddState("idle", &trees[0]);
+            walk = machine.AddState("walk", &trees[1]);
+            stagger = machine.AddState("hit", &trees[2]);
+
+            idleToWalk = machine.AddTransition(idle, walk, 0.4f);
+            machine.AddCondition(idleToWalk, speed, TransitionCompare::Greater, 0.5f);
+            walkToIdle = machine.AddTransition(walk, idle, 0.2f, CrossFadeCurve::SmoothStep);
+            machine.AddCondition(walkToIdle, speed, TransitionCompare::LessEqual, 0.5f);
+            anyToHit = machine.AddTransition(ANY_ANIMATION_STATE, stagger, 0.0f);
+            machine.AddCondition(anyToHit, hit, TransitionCompare::Equal, 1.0f);
+            hitToIdle = machine.AddTransition(stagger, idle, 0.1f);
+
+            instance.Initialize(machine);
+        }
+
+        AnimationClip clips[3];
+        BlendTree trees[3];
+        StateMachine machine;
+        StateMachineInstance instance;
+        uint16 speed, hit;
+        uint16 idle, walk, stagger;
+        uint16 idleToWalk, walkToIdle, anyToHit, hitToIdle;
+    };
+}
+
+TEST_F(StateMachineTest, CrossFadesAlongTheCurve)
+{
+    EXPECT_EQ(StateMachineEvaluator::Update(instance, 0.1f), INVALID_ANIMATION_TRANSITION);
+    EXPECT_EQ(instance.currentState, idle);
+    EXPECT_NEAR(EvaluateX(instance), 0.0f, 1e-6f);
+
+    instance.SetParameter(speed, 1.0f);
+    EXPECT_EQ(StateMachineEvaluator::Update(instance, 0.1f), idleToWalk);
+    EXPECT_EQ(instance.currentState, walk);
+    EXPECT_TRUE(instance.IsFading());
+
+    EXPECT_EQ(StateMachineEvaluator::Update(instance, 0.1f), INVALID_ANIMATION_TRANSITION);
+    EXPECT_NEAR(EvaluateX(instance), 0.25f, 1e-5f);
+    StateMachineEvaluator::Update(instance, 0.3f);
+    EXPECT_FALSE(instance.IsFading());
+    EXPECT_NEAR(EvaluateX(instance), 1.0f, 1e-6f);
+
+    // Back to idle along a smoothstep
+    instance.SetParameter(speed, 0.0f);
+    EXPECT_EQ(StateMachineEvaluator::Update(instance, 0.1f), walkToIdle);
+    StateMachineEvaluator::Update(instance, 0.05f);
+    EXPECT_NEAR(EvaluateX(instance), 1.0f - StateMachineEvaluator::EvaluateCurve(CrossFadeCurve::SmoothStep, 0.25f), 1e-5f);
+
+    EXPECT_EQ(StateMachineEvaluator::EvaluateCurve(CrossFadeCurve::EaseIn, 0.0f), 0.0f);
+    EXPECT_EQ(StateMachineEvaluator::EvaluateCurve(CrossFadeCurve::EaseOut, 2.0f), 1.0f);
+}
+
+TEST_F(StateMachineTest, OnlyChangedParametersTriggerEvaluation)
+{
+    StateMachineEvaluator::Update(instance, 0.1f);
+
+    // Writing the value behind the machine's back is not a change event, so nothing is polled
+    instance.parameters[speed] = 1.0f;
+    EXPECT_EQ(StateMachineEvaluator::Update(instance, 0.1f), INVALID_ANIMATION_TRANSITION);
+    EXPECT_EQ(StateMachineEvaluator::Update(instance, 0.1f), INVALID_ANIMATION_TRANSITION);
+
+    // Setting the same value again is not a change either
+    instance.SetParameter(speed, 1.0f);
+    EXPECT_TRUE(instance.dirtyParameters.empty());
+
+    // A change to a parameter no idle transition reads leaves idle alone, but re-checks idle -> walk
+    instance.SetParameter(hit, 2.0f);
+    EXPECT_EQ(StateMachineEvaluator::Update(instance, 0.1f), INVALID_ANIMATION_TRANSITION);
+    instance.SetParameter(speed, 0.9f);
+    EXPECT_EQ(StateMachineEvaluator::Update(instance, 0.1f), idleToWalk);
+}
+
+TEST_F(StateMachineTest, AnyStateWinsAndEnteredStatesAreChecked)
+{
+    StateMachineEvaluator::Update(instance, 0.1f);
+
+    // Both conditions become true in the same update; the any-state transition has priority
+    instance.SetParameter(speed, 1.0f);
+    instance.SetParameter(hit, 1.0f);
+    EXPECT_EQ(StateMachineEvaluator::Update(instance, 0.1f), anyToHit);
+    EXPECT_EQ(instance.currentState, stagger);
+    EXPECT_FALSE(instance.IsFading());
+
+    // The unconditional way out fires when the state is entered, then idle sees speed already set
+    // and the still-true hit condition, which wins again
+    EXPECT_EQ(StateMachineEvaluator::Update(instance, 0.1f), hitToIdle);
+    EXPECT_EQ(StateMachineEvaluator::Update(instance, 0.1f), anyToHit);
+
+    instance.SetParameter(hit, 0.0f);
+    EXPECT_EQ(StateMachineEvaluator::Update(instance, 0.1f), hitToIdle);
+    EXPECT_EQ(StateMachineEvaluator::Update(instance, 0.1f), idleToWalk);
+}
+
+TEST_F(StateMachineTest, ParametersArriveThroughActions)
+{
+    Action<uint16, float> parameterChanged;
+    parameterChanged.Subscribe(&instance, &StateMachineInstance::SetParameter);
+    StateMachineEvaluator::Update(instance, 0.1f);
+
+    parameterChanged.Invoke(speed, 0.75f);
+    EXPECT_EQ(instance.GetParameter(speed), 0.75f);
+    EXPECT_EQ(StateMachineEvaluator::Update(instance, 0.1f), idleToWalk);
+}
+
+TEST(StateMachineParameterTest, BlendTreeParametersShareMachineParameters)
+{
+    const AnimationClip slow = CreateConstantClip(0.0f);
+    const AnimationClip fast = CreateConstantClip(4.0f);
+
+    BlendTree tree;
+    tree.AddBlend(tree.AddClip(&slow), tree.AddClip(&fast), tree.AddParameter("speed"));
+
+    StateMachine machine;
+    const uint16 mood = machine.AddParameter("mood");
+    machine.AddState("move", &tree);
+    EXPECT_EQ(machine.GetParameterCount(), 2u);
+    EXPECT_NE(machine.FindParameter("speed"), mood);
+
+    StateMachineInstance instance;
+    instance.Initialize(machine);
+    instance.SetParameter(machine.FindParameter("speed"), 0.25f);
+    StateMachineEvaluator::Update(instance, 0.0f);
+    EXPECT_NEAR(EvaluateX(instance), 1.0f, 1e-6f);
+}
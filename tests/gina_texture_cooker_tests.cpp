@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include "asset/gina_texture_cooker.h"
+#include "texture/gina_block_compression.h"
+
+using namespace gina;
+
+namespace
+{
+    // Smooth gradients with a little texture on top, like most albedo and mask content
+    TextureImage MakeAlbedo(uint32 width, uint32 height)
+    {
+        TextureImage image{ width, height, std::vector<uint8>(static_cast<size_t>(width) * height * 4) };
+        for (uint32 y = 0; y < height; ++y)
+        {
+            for (uint32 x = 0; x < width; ++x)
+            {
+                uint8* texel = &image.texels[(static_cast<size_t>(y) * width + x) * 4];
+                const uint32 grain = (x * 7 + y * 13) % 5;
+                texel[0] = static_cast<uint8>(40 + x * 150 / width + grain);
+                texel[1] = static_cast<uint8>(90 + y * 100 / height + grain);
+                texel[2] = static_cast<uint8>(60 + (x + y) * 40 / (width + height));
+                texel[3] = static_cast<uint8>(255 - y * 64 / height);
+            }
+        }
+        return image;
+    }
+
+    // Normals of gentle bumps, encoded the usual way as n * 0.5 + 0.5
+    TextureImage MakeNormals(uint32 width, uint32 height)
+    {
+        TextureImage image{ width, height, std::vector<uint8>(static_cast<size_t>(width) * height * 4) };
+        for (uint32 y = 0; y < height; ++y)
+        {
+            for (uint32 x = 0; x < width; ++x)
+            {
+                const float nx = 0.4f * std::sin(x * 0.2f);
+                const float ny = 0.4f * std::cos(y * 0.15f);
+                const float nz = std::sqrt(1.0f - nx * nx - ny * ny);
+                uint8* texel = &image.texels[(static_cast<size_t>(y) * width + x) * 4];
+                texel[0] = static_cast<uint8>((nx * 0.5f + 0.5f) * 255.0f + 0.5f);
+                texel[1] = static_cast<uint8>((ny * 0.5f + 0.5f) * 255.0f + 0.5f);
+                texel[2] = static_cast<uint8>((nz * 0.5f + 0.5f) * 255.0f + 0.5f);
+                texel[3] = 255;
+            }
+        }
+        return image;
+    }
+}
+
+TEST(TextureCookerTest, PicksTheBlockFormatOfTheUsage)
+{
+    const TextureImage albedo = MakeAlbedo(64, 48);
+    const TextureImage normals = MakeNormals(64, 48);
+
+    TextureCookSettings settings;
+    TextureCookReport report;
+    const TextureAsset bc7 = TextureCooker::Cook(albedo, settings, nullptr, report);
+    EXPECT_EQ(bc7.format, RHIFormat::BC7Srgb);
+    EXPECT_GT(report.psnr, 40.0);
+    EXPECT_EQ(bc7.mips[0].size, 64u * 48u);    // a byte per texel
+    EXPECT_EQ(report.cookedBytes, bc7.data.size());
+
+    settings.usage = TextureCookUsage::Normal;
+    const TextureAsset bc5 = TextureCooker::Cook(normals, settings, nullptr, report);
+    EXPECT_EQ(bc5.format, RHIFormat::BC5Unorm);
+    EXPECT_GT(report.psnr, 40.0);
+
+    settings.usage = TextureCookUsage::Mask;
+    const TextureAsset bc4 = TextureCooker::Cook(albedo, settings, nullptr, report);
+    EXPECT_EQ(bc4.format, RHIFormat::BC4Unorm);
+    EXPECT_GT(report.psnr, 40.0);
+
+    // BC1 is the small one and it shows
+    settings.usage = TextureCookUsage::Albedo;
+    settings.format = RHIFormat::BC1Srgb;
+    TextureCooker::Cook(albedo, settings, nullptr, report);
+    EXPECT_GT(report.psnr, 30.0);
+    EXPECT_EQ(report.mipLevels, 7u);
+
+    // The pool splits the work but not the result
+    ThreadPool pool(3);
+    settings.format = RHIFormat::Unknown;
+    const TextureAsset parallel = TextureCooker::Cook(albedo, settings, &pool, report);
+    EXPECT_EQ(parallel.data, bc7.data);
+}
+
+TEST(TextureCookerTest, FiltersMipsPerUsage)
+{
+    // Black and white checker: averaged in linear space it is mid grey in light, not 128 in sRGB
+    TextureImage checker{ 2, 2, { 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 255 } };
+    std::vector<TextureImage> mips;
+    TextureCooker::GenerateMips(checker, TextureCookUsage::Albedo, mips);
+    ASSERT_EQ(mips.size(), 2u);
+    EXPECT_EQ(mips[1].texels[0], 188);
+    TextureCooker::GenerateMips(checker, TextureCookUsage::Mask, mips);
+    EXPECT_EQ(mips[1].texels[0], 128);
+
+    // Two normals leaning apart average to one of unit length, straight up
+    TextureImage normals{ 2, 1, { 218, 128, 218, 255, 38, 128, 218, 255 } };
+    TextureCooker::GenerateMips(normals, TextureCookUsage::Normal, mips);
+    EXPECT_NEAR(mips[1].texels[0], 128, 1);
+    EXPECT_EQ(mips[1].texels[2], 255);
+
+    // Non power of two sizes halve down to 1x1
+    TextureCooker::GenerateMips(MakeAlbedo(37, 10), TextureCookUsage::Albedo, mips);
+    ASSERT_EQ(mips.size(), 6u);
+    EXPECT_EQ(mips[1].width, 18u);
+    EXPECT_EQ(mips[1].height, 5u);
+    EXPECT_EQ(mips[5].width, 1u);
+    EXPECT_EQ(mips[5].height, 1u);
+}
+
+TEST(TextureCookerTest, ReusesCachedCooks)
+{
+    const std::string cacheDirectory = testing::TempDir() + "gina_texture_cache_test";
+    std::filesystem::remove_all(cacheDirectory);
+
+    const TextureImage image = MakeAlbedo(32, 32);
+    TextureCookSettings settings;
+    TextureCookReport report;
+    const TextureAsset first = TextureCooker::CookCached(image, settings, cacheDirectory, nullptr, report);
+    EXPECT_FALSE(report.cacheHit);
+
+    const TextureAsset second = TextureCooker::CookCached(image, settings, cacheDirectory, nullptr, report);
+    EXPECT_TRUE(report.cacheHit);
+    EXPECT_EQ(second.contentHash, first.contentHash);
+    EXPECT_EQ(second.mips.size(), first.mips.size());
+    EXPECT_EQ(second.data, first.data);
+
+    // A different source or different settings is a different entry
+    TextureImage edited = image;
+    edited.texels[5] ^= 1;
+    TextureCooker::CookCached(edited, settings, cacheDirectory, nullptr, report);
+    EXPECT_FALSE(report.cacheHit);
+    settings.generateMips = false;
+    TextureCooker::CookCached(image, settings, cacheDirectory, nullptr, report);
+    EXPECT_FALSE(report.cacheHit);
+    EXPECT_EQ(report.mipLevels, 1u);
+
+    std::filesystem::remove_all(cacheDirectory);
+}
+
+TEST(TextureCookerTest, DecodesTga)
+{
+    // 2x2 RLE true color with alpha, bottom row first: a run of two reds, then a green and a blue raw
+    const std::vector<byte> tga = {
+        0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 2, 0, 32, 8,
+        0x81, 0, 0, 255, 255,
+        0x01, 0, 255, 0, 128, 255, 0, 0, 64
+    };
+    TextureImage image;
+    ASSERT_TRUE(TextureImporter::DecodeTga(tga, image));
+    ASSERT_EQ(image.width, 2u);
+    ASSERT_EQ(image.height, 2u);
+    const std::vector<uint8> expected = { 0, 255, 0, 128, 0, 0, 255, 64, 255, 0, 0, 255, 255, 0, 0, 255 };
+    EXPECT_EQ(image.texels, expected);
+
+    std::vector<byte> truncated = tga;
+    truncated.resize(tga.size() - 2);
+    EXPECT_FALSE(TextureImporter::DecodeTga(truncated, image));
+
+    // Through a file and the serializer: what was cooked is what loads
+    TextureCookReport report;
+    const TextureAsset asset = TextureCooker::Cook(image, TextureCookSettings(), nullptr, report);
+    const std::string fileName = testing::TempDir() + "gina_texture_asset_test.gtex";
+    ASSERT_TRUE(TextureAssetSerializer::Save(fileName, asset));
+    TextureAsset loaded;
+    ASSERT_TRUE(TextureAssetSerializer::Load(fileName, loaded));
+    EXPECT_EQ(loaded.format, asset.format);
+    EXPECT_EQ(loaded.mips.size(), 2u);
+    EXPECT_EQ(loaded.mips[1].offset, 16u);
+    EXPECT_EQ(loaded.data, asset.data);
+    std::remove(fileName.c_str());
+}
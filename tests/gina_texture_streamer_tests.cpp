@@ -0,0 +1,308 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include "asset/gina_texture_cooker.h"
+#include "rhi/gina_null_rhi.h"
+#include "texture/gina_texture_streamer.h"
+
+using namespace gina;
+
+namespace
+{
+    // 256x256 BC4: 32 KB top mip, 8 KB next, 2744 bytes of tail from 64x64 down
+    constexpr uint64 TAIL_SIZE = 2744;
+    constexpr uint64 FULL_SIZE = 32768 + 8192 + TAIL_SIZE;
+
+    std::string CookTexture(const std::string& name, uint8 seed)
+    {
+        TextureImage image{ 256, 256, std::vector<uint8>(256 * 256 * 4) };
+        for (size_t i = 0; i < image.texels.size(); ++i)
+        {
+            image.texels[i] = static_cast<uint8>(i / 4 % 256 + seed);
+        }
+
+        TextureCookSettings settings;
+        settings.usage = TextureCookUsage::Mask;
+        TextureCookReport report;
+        const std::string fileName = testing::TempDir() + name + ".gtex";
+        TextureAssetSerializer::Save(fileName, TextureCooker::Cook(image, settings, nullptr, report));
+        return fileName;
+    }
+
+    class StreamingFrames
+    {
+    public:
+        StreamingFrames() : m_frames(m_device, { 2 }), m_list(m_device.CreateCommandList(RHIQueueType::Graphics)) {}
+
+        NullDevice& GetDevice() noexcept { return m_device; }
+        FrameRing& GetFrames() noexcept { return m_frames; }
+        const NullCommandStream& GetStream() const noexcept { return static_cast<const NullCommandList&>(*m_list).GetStream(); }
+
+        void Run(TextureStreamer& streamer)
+        {
+            FrameContext& frame = m_frames.BeginFrame();
+            m_list->Begin(*frame.allocator);
+            streamer.Update(*m_list);
+            m_list->End();
+            RHICommandList* lists[] = { m_list.get() };
+            m_device.GetQueue(RHIQueueType::Graphics).Submit(lists, 1);
+            m_frames.EndFrame();
+        }
+
+        // Issues in one frame, uploads in the next
+        void RunLoads(TextureStreamer& streamer)
+        {
+            Run(streamer);
+            streamer.WaitForLoads();
+            Run(streamer);
+        }
+
+    private:
+        NullDevice m_device;
+        FrameRing m_frames;
+        std::unique_ptr<RHICommandList> m_list;
+    };
+}
+
+TEST(TextureStreamerTest, LoadsTheTailThenRequestedMips)
+{
+    const std::string fileName = CookTexture("gina_streamer_single", 0);
+    StreamingFrames frames;
+    TextureStreamer streamer(frames.GetDevice(), frames.GetFrames());
+    EXPECT_EQ(streamer.AddTexture(fileName + ".missing"), INVALID_STREAMED_TEXTURE);
+
+    const uint32 texture = streamer.AddTexture(fileName);
+    ASSERT_NE(texture, INVALID_STREAMED_TEXTURE);
+    EXPECT_EQ(streamer.GetMipCount(texture), 9u);
+    EXPECT_FALSE(streamer.GetTexture(texture).IsValid());
+
+    // Only the tail at first, uploaded mip by mip into a fresh texture
+    frames.RunLoads(streamer);
+    EXPECT_EQ(streamer.GetResidentMip(texture), 2u);
+    EXPECT_TRUE(streamer.GetTexture(texture).IsValid());
+    EXPECT_EQ(frames.GetStream().Count(NullCommandType::CopyBufferToTexture), 7u);
+    EXPECT_EQ(streamer.GetStats().residentBytes, TAIL_SIZE);
+
+    // Asking for the top mip: the two missing mips are read, the tail is copied over on the GPU
+    const RHITextureHandle tail = streamer.GetTexture(texture);
+    streamer.RequestMip(texture, 0);
+    frames.Run(streamer);
+    EXPECT_EQ(streamer.GetWantedMip(texture), 0u);
+    streamer.WaitForLoads();
+    frames.Run(streamer);
+    EXPECT_EQ(streamer.GetResidentMip(texture), 0u);
+    EXPECT_NE(streamer.GetTexture(texture), tail);
+
+    const NullCommandStream& stream = frames.GetStream();
+    EXPECT_EQ(stream.Count(NullCommandType::CopyBufferToTexture), 2u);
+    EXPECT_EQ(stream.Count(NullCommandType::CopyTexture), 7u);
+    EXPECT_EQ(stream.Count(NullCommandType::Barrier), 2u);
+    const RHITextureDesc* desc = frames.GetDevice().GetTextureDesc(streamer.GetTexture(texture));
+    ASSERT_NE(desc, nullptr);
+    EXPECT_EQ(desc->width, 256u);
+    EXPECT_EQ(desc->mipLevels, 9u);
+
+    const TextureStreamerStats& stats = streamer.GetStats();
+    EXPECT_EQ(stats.loadsCompleted, 2u);
+    EXPECT_EQ(stats.bytesRead, FULL_SIZE);
+    EXPECT_EQ(stats.residentBytes, FULL_SIZE);
+    EXPECT_EQ(stats.pendingLoads, 0u);
+
+    // The tail texture goes once the GPU is past the frame that copied from it
+    frames.GetFrames().Flush();
+    EXPECT_EQ(frames.GetDevice().GetStats().residentBytes - streamer.GetStats().residentBytes, 32ull << 20);
+    std::remove(fileName.c_str());
+}
+
+TEST(TextureStreamerTest, EvictsLeastRecentlyRequestedUnderBudget)
+{
+    std::vector<std::string> fileNames;
+    for (uint8 i = 0; i < 4; ++i)
+    {
+        fileNames.push_back(CookTexture("gina_streamer_lru" + std::to_string(i), i));
+    }
+
+    // Room for two full textures and the other two tails
+    TextureStreamerSettings settings;
+    settings.memoryBudget = FULL_SIZE * 2 + TAIL_SIZE * 2;
+    StreamingFrames frames;
+    TextureStreamer streamer(frames.GetDevice(), frames.GetFrames(), settings);
+    std::vector<uint32> textures;
+    for (const std::string& fileName : fileNames)
+    {
+        textures.push_back(streamer.AddTexture(fileName));
+    }
+    frames.RunLoads(streamer);
+
+    // Everything visible at once: two get their mips, the others wait rather than evict textures just as recent
+    for (uint32 frame = 0; frame < 4; ++frame)
+    {
+        for (uint32 texture : textures)
+        {
+            streamer.RequestMip(texture, 0);
+        }
+        frames.RunLoads(streamer);
+    }
+    uint32 fullTextures = 0;
+    for (uint32 texture : textures)
+    {
+        fullTextures += streamer.GetResidentMip(texture) == 0 ? 1 : 0;
+    }
+    EXPECT_EQ(fullTextures, 2u);
+    EXPECT_EQ(streamer.GetStats().evictedMips, 0u);
+    EXPECT_GT(streamer.GetStats().budgetDeferrals, 0u);
+    EXPECT_LE(streamer.GetStats().residentBytes, settings.memoryBudget);
+
+    // The camera turns to the last two: the first two were requested longer ago and make room, down to their tails
+    for (uint32 frame = 0; frame < 4; ++frame)
+    {
+        streamer.RequestMip(textures[2], 0);
+        streamer.RequestMip(textures[3], 0);
+        frames.RunLoads(streamer);
+    }
+    EXPECT_EQ(streamer.GetResidentMip(textures[2]), 0u);
+    EXPECT_EQ(streamer.GetResidentMip(textures[3]), 0u);
+    EXPECT_GE(streamer.GetResidentMip(textures[0]), 1u);
+    EXPECT_GE(streamer.GetResidentMip(textures[1]), 1u);
+    EXPECT_LE(streamer.GetResidentMip(textures[0]), 2u);
+    EXPECT_GT(streamer.GetStats().evictedMips, 0u);
+    EXPECT_LE(streamer.GetStats().residentBytes, settings.memoryBudget);
+    EXPECT_LE(streamer.GetStats().peakResidentBytes, settings.memoryBudget);
+
+    for (const std::string& fileName : fileNames)
+    {
+        std::remove(fileName.c_str());
+    }
+}
+
+TEST(TextureStreamerTest, ForgetsIdleTexturesAndCancelsStaleLoads)
+{
+    const std::string fileName = CookTexture("gina_streamer_idle", 0);
+    TextureStreamerSettings settings;
+    settings.idleFrames = 2;
+    StreamingFrames frames;
+    TextureStreamer streamer(frames.GetDevice(), frames.GetFrames(), settings);
+    const uint32 texture = streamer.AddTexture(fileName);
+    frames.RunLoads(streamer);
+    streamer.RequestMip(texture, 1);
+    frames.RunLoads(streamer);
+    EXPECT_EQ(streamer.GetResidentMip(texture), 1u);
+
+    // Out of sight it only wants its tail, but keeps its mips until memory is needed
+    for (uint32 frame = 0; frame < 3; ++frame)
+    {
+        frames.Run(streamer);
+    }
+    EXPECT_EQ(streamer.GetWantedMip(texture), 2u);
+    EXPECT_EQ(streamer.GetResidentMip(texture), 1u);
+    streamer.SetMemoryBudget(TAIL_SIZE);
+    frames.Run(streamer);
+    EXPECT_EQ(streamer.GetResidentMip(texture), 2u);
+    EXPECT_EQ(streamer.GetStats().residentBytes, TAIL_SIZE);
+
+    // Removed while its load is in flight: the read is dropped, the slot is reused
+    streamer.SetMemoryBudget(FULL_SIZE);
+    streamer.RequestMip(texture, 0);
+    frames.Run(streamer);
+    EXPECT_EQ(streamer.GetStats().pendingLoads, 1u);
+    streamer.RemoveTexture(texture);
+    streamer.WaitForLoads();
+    frames.Run(streamer);
+    EXPECT_EQ(streamer.GetStats().loadsCancelled, 1u);
+    EXPECT_EQ(streamer.GetStats().pendingLoads, 0u);
+    EXPECT_EQ(streamer.GetStats().residentBytes, 0u);
+    EXPECT_EQ(streamer.AddTexture(fileName), texture);
+
+    EXPECT_EQ(ComputeStreamingMip(2048, 2048, 2048.0f, 2048.0f), 0u);
+    EXPECT_EQ(ComputeStreamingMip(2048, 1024, 300.0f, 300.0f), 2u);
+    EXPECT_EQ(ComputeStreamingMip(64, 64, 1000.0f, 1000.0f), 0u);
+    std::remove(fileName.c_str());
+}
+
+TEST(TextureStreamerTest, StopsLoadingTexturesWhoseFileFails)
+{
+    const std::string fileName = CookTexture("gina_streamer_failed", 0);
+    StreamingFrames frames;
+    TextureStreamer streamer(frames.GetDevice(), frames.GetFrames());
+    const uint32 texture = streamer.AddTexture(fileName);
+    frames.RunLoads(streamer);
+    EXPECT_EQ(streamer.GetResidentMip(texture), 2u);
+
+    // The file goes bad after its tail loaded: one read fails and the texture keeps the tail
+    std::ofstream(fileName, std::ios::binary | std::ios::trunc).close();
+    for (uint32 frame = 0; frame < 5; ++frame)
+    {
+        streamer.RequestMip(texture, 0);
+        frames.Run(streamer);
+        streamer.WaitForLoads();
+    }
+
+    const TextureStreamerStats& stats = streamer.GetStats();
+    EXPECT_EQ(stats.loadsIssued, 2u);
+    EXPECT_EQ(stats.loadsFailed, 1u);
+    EXPECT_EQ(stats.loadsCancelled, 0u);
+    EXPECT_EQ(stats.pendingLoads, 0u);
+    EXPECT_EQ(streamer.GetResidentMip(texture), 2u);
+    EXPECT_TRUE(streamer.GetTexture(texture).IsValid());
+    EXPECT_EQ(stats.residentBytes, TAIL_SIZE);
+    std::remove(fileName.c_str());
+}
+
+TEST(TextureStreamerTest, StreamsMipsLargerThanHalfTheUploadRing)
+{
+    std::vector<std::string> fileNames;
+    for (uint8 i = 0; i < 4; ++i)
+    {
+        fileNames.push_back(CookTexture("gina_streamer_small_ring" + std::to_string(i), i));
+    }
+
+    // The 32 KB top mips plus their alignment take more than half the ring: each goes alone once it is empty
+    TextureStreamerSettings settings;
+    settings.uploadBufferSize = 64ull << 10;
+    StreamingFrames frames;
+    TextureStreamer streamer(frames.GetDevice(), frames.GetFrames(), settings);
+    std::vector<uint32> textures;
+    for (uint32 i = 0; i < 3; ++i)
+    {
+        textures.push_back(streamer.AddTexture(fileNames[i]));
+    }
+    for (uint32 frame = 0; frame < 20; ++frame)
+    {
+        for (uint32 texture : textures)
+        {
+            streamer.RequestMip(texture, 0);
+        }
+        frames.Run(streamer);
+        streamer.WaitForLoads();
+    }
+    for (uint32 texture : textures)
+    {
+        EXPECT_EQ(streamer.GetResidentMip(texture), 0u);
+    }
+    EXPECT_EQ(streamer.GetStats().pendingLoads, 0u);
+
+    // Loads keep flowing after them
+    const uint32 later = streamer.AddTexture(fileNames[3]);
+    frames.RunLoads(streamer);
+    EXPECT_EQ(streamer.GetResidentMip(later), 2u);
+
+    // A ring smaller than the top mip streams down to the next one
+    settings.uploadBufferSize = 32ull << 10;
+    TextureStreamer small(frames.GetDevice(), frames.GetFrames(), settings);
+    const uint32 texture = small.AddTexture(fileNames[0]);
+    for (uint32 frame = 0; frame < 6; ++frame)
+    {
+        small.RequestMip(texture, 0);
+        frames.Run(small);
+        small.WaitForLoads();
+    }
+    EXPECT_EQ(small.GetWantedMip(texture), 1u);
+    EXPECT_EQ(small.GetResidentMip(texture), 1u);
+    EXPECT_EQ(small.GetStats().pendingLoads, 0u);
+
+    for (const std::string& fileName : fileNames)
+    {
+        std::remove(fileName.c_str());
+    }
+}
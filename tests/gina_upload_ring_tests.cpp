@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "rhi/gina_frame_ring.h"
+#include "rhi/gina_null_rhi.h"
+#include "rhi/gina_upload_ring.h"
+
+using namespace gina;
+
+TEST(UploadRingTest, AllocatorAlignsAndWrapsAround)
+{
+    RingAllocator ring(1024);
+    uint64 offset = 0;
+
+    ASSERT_TRUE(ring.Allocate(100, 256, offset));
+    EXPECT_EQ(offset, 0u);
+    ASSERT_TRUE(ring.Allocate(100, 256, offset));
+    EXPECT_EQ(offset, 256u);
+    ring.Retire(1);
+
+    ASSERT_TRUE(ring.Allocate(300, 256, offset));
+    EXPECT_EQ(offset, 512u);
+    EXPECT_EQ(ring.GetUsedSize(), 812u);
+    ring.Retire(2);
+
+    // 300 bytes do not fit before the end; wrapping to 0 would overwrite frame 1
+    EXPECT_FALSE(ring.Allocate(300, 256, offset));
+    EXPECT_EQ(ring.GetOldestFenceValue(), 1u);
+
+    ring.Reclaim(1);
+    ASSERT_TRUE(ring.Allocate(300, 256, offset));
+    EXPECT_EQ(offset, 0u);
+    EXPECT_FALSE(ring.Allocate(100, 256, offset));
+    ring.Retire(3);
+
+    // Nothing reclaims until its value completes, then the ring drains in order
+    ring.Reclaim(1);
+    EXPECT_EQ(ring.GetOldestFenceValue(), 2u);
+    ring.Reclaim(3);
+    EXPECT_EQ(ring.GetUsedSize(), 0u);
+    EXPECT_EQ(ring.GetOldestFenceValue(), 0u);
+
+    // An empty ring fits its whole capacity, never more
+    ASSERT_TRUE(ring.Allocate(1024, 256, offset));
+    EXPECT_EQ(offset, 0u);
+    ring.Retire(4);
+    ring.Reclaim(4);
+    EXPECT_FALSE(ring.Allocate(1025, 256, offset));
+}
+
+TEST(UploadRingTest, StallsUntilTheGPUFreesSpace)
+{
+    NullDeviceSettings settings;
+    settings.submissionTime = 10.0;
+    settings.recordCommands = false;
+    NullDevice device(settings);
+    FrameRing frames(device, { 3 });
+    UploadRing ring(device, frames.GetFence(), 4096);
+    RHIQueue& queue = device.GetQueue(RHIQueueType::Graphics);
+    EXPECT_EQ(device.GetStats().liveResources, 1u);
+
+    // Three frames in flight of six 256 byte slots overflow a 4 KB ring: the fifth draw of the third frame
+    // wraps around and waits for the first frame
+    for (uint32 frame = 0; frame < 3; ++frame)
+    {
+        frames.BeginFrame();
+        ring.BeginFrame();
+        for (uint32 draw = 0; draw < 6; ++draw)
+        {
+            const uint32 constants[4] = { frame, draw, 0, 0 };
+            const UploadAllocation allocation = ring.Upload(constants, sizeof(constants));
+            ASSERT_TRUE(allocation.IsValid());
+            EXPECT_EQ(allocation.offset % UPLOAD_RING_ALIGNMENT, 0u);
+            EXPECT_EQ(allocation.buffer, ring.GetBuffer());
+
+            // Writes land in the mapped buffer
+            uint32 written[4];
+            std::memcpy(written, static_cast<byte*>(device.Map(ring.GetBuffer())) + allocation.offset, sizeof(written));
+            EXPECT_EQ(written[0], frame);
+            EXPECT_EQ(written[1], draw);
+        }
+        queue.Submit(nullptr, 0);
+        ring.EndFrame(frames.GetCurrentFenceValue());
+        frames.EndFrame();
+        device.AdvanceTime(1.0);
+    }
+
+    EXPECT_EQ(ring.GetStats().allocations, 18u);
+    EXPECT_EQ(ring.GetStats().bytes, 18u * 16u);
+    EXPECT_EQ(ring.GetStats().stalls, 1u);
+    EXPECT_EQ(ring.GetStats().peakUsedSize, 3840u + 16u);
+    EXPECT_EQ(device.GetStats().cpuWaits, 1u);
+    EXPECT_EQ(frames.GetStats().cpuWaits, 0u);
+
+    // A request larger than the ring cannot be satisfied by waiting, so it fails without waiting
+    frames.BeginFrame();
+    ring.BeginFrame();
+    EXPECT_FALSE(ring.Allocate(8192).IsValid());
+    EXPECT_EQ(ring.GetStats().failures, 1u);
+    EXPECT_EQ(ring.GetStats().stalls, 1u);
+    EXPECT_EQ(device.GetStats().cpuWaits, 1u);
+    frames.EndFrame();
+}
@@ -0,0 +1,397 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "asset/gina_mesh_cooker.h"
+#include "asset/gina_model_importer.h"
+#include "asset/gina_root_motion_asset.h"
+#include "asset/gina_texture_cooker.h"
+
+using namespace gina;
+
+namespace
+{
+    struct RootMotionCookOptions
+    {
+        std::string output;
+        std::string rootJoint;
+        float sampleRate = 30.0f;
+        RootMotionSettings settings;
+    };
+
+    struct TextureCookOptions
+    {
+        std::string cacheDirectory;
+        TextureCookSettings settings;
+    };
+
+    void PrintUsage()
+    {
+        const MeshCookSettings defaults;
+        std::printf(
+            "Usage: gina_cook <input model> <output.gmesh> [options]\n"
+            "       gina_cook <input.tga> <output.gtex> [texture options]\n"
+            "Options:\n"
+            "  --no-optimize          Skip the vertex cache / overdraw / fetch optimization stage\n"
+            "  --cache-size <n>       Simulated post-transform cache size (default %u)\n"
+            "  --overdraw <t>         Overdraw threshold, max allowed ACMR degradation (default 1.05)\n"
+            "  --no-meshlets          Skip meshlet generation\n"
+            "  --meshlet-vertices <n> Max vertices per meshlet (default %u)\n"
+            "  --meshlet-triangles <n> Max triangles per meshlet (default %u)\n"
+            "  --lods <n>             Number of LOD levels including the source mesh, 1 disables (default %u)\n"
+            "  --lod-ratio <r>        Triangle ratio between consecutive LOD levels (default %.2f)\n"
+            "  --lod-error <e>        Max LOD simplification error relative to the mesh extent (default %.2f)\n"
+            "  --skinning <lbs|dq>    Runtime skinning mode for skinned meshes (default lbs)\n"
+            "  --root-motion <file>   Also extract the root motion of every animation into a .groot file\n"
+            "  --root-joint <name>    Node whose movement is extracted (default the scene root)\n"
+            "  --root-rate <hz>       Root track sample rate (default 30)\n"
+            "  --root-vertical        Extract height changes as well as ground movement\n"
+            "Texture options:\n"
+            "  --usage <albedo|normal|mask> BC7 sRGB, BC5 or BC4 (default albedo)\n"
+            "  --format <bc1|bc4|bc5|bc7> Override the block format of the usage\n"
+            "  --no-mips              Cook the top level only\n"
+            "  --cache <dir>          Reuse cooked textures with the same source and settings from <dir>\n",
+            DEFAULT_VERTEX_CACHE_SIZE, MESHLET_MAX_VERTICES, MESHLET_MAX_TRIANGLES,
+            defaults.lods.levelCount, defaults.lods.triangleRatio, defaults.lods.simplifier.maxError);
+    }
+
+    bool ParseArguments(int argc, char** argv, std::string& input, std::string& output, MeshCookSettings& settings,
+        RootMotionCookOptions& rootMotion)
+    {
+        if (argc < 3)
+        {
+            return false;
+        }
+
+        input = argv[1];
+        output = argv[2];
+
+        for (int i = 3; i < argc; ++i)
+        {
+            const std::string argument = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (argument == "--no-optimize")
+            {
+                settings.optimize = false;
+            }
+            else if (argument == "--cache-size" && hasValue)
+            {
+                settings.optimizer.cacheSize = static_cast<uint32>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (argument == "--overdraw" && hasValue)
+            {
+                settings.optimizer.overdrawThreshold = std::strtof(argv[++i], nullptr);
+            }
+            else if (argument == "--no-meshlets")
+            {
+                settings.buildMeshlets = false;
+            }
+            else if (argument == "--meshlet-vertices" && hasValue)
+            {
+                settings.meshlets.maxVertices = static_cast<uint32>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (argument == "--meshlet-triangles" && hasValue)
+            {
+                settings.meshlets.maxTriangles = static_cast<uint32>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (argument == "--lods" && hasValue)
+            {
+                settings.lods.levelCount = static_cast<uint32>(std::strtoul(argv[++i], nullptr, 10));
+                settings.buildLods = settings.lods.levelCount > 1;
+            }
+            else if (argument == "--lod-ratio" && hasValue)
+            {
+                settings.lods.triangleRatio = std::strtof(argv[++i], nullptr);
+            }
+            else if (argument == "--lod-error" && hasValue)
+            {
+                settings.lods.simplifier.maxError = std::strtof(argv[++i], nullptr);
+            }
+            else if (argument == "--skinning" && hasValue)
+            {
+                const std::string mode = argv[++i];
+                if (mode != "lbs" && mode != "dq")
+                {
+                    std::printf("Unknown skinning mode '%s'\n", mode.c_str());
+                    return false;
+                }
+                settings.skinningMode = mode == "dq" ? SkinningMode::DualQuaternion : SkinningMode::Linear;
+            }
+            else if (argument == "--root-motion" && hasValue)
+            {
+                rootMotion.output = argv[++i];
+            }
+            else if (argument == "--root-joint" && hasValue)
+            {
+                rootMotion.rootJoint = argv[++i];
+            }
+            else if (argument == "--root-rate" && hasValue)
+            {
+                rootMotion.sampleRate = std::strtof(argv[++i], nullptr);
+            }
+            else if (argument == "--root-vertical")
+            {
+                rootMotion.settings.extractVertical = true;
+            }
+            else
+            {
+                std::printf("Unknown option '%s'\n", argument.c_str());
+                return false;
+            }
+        }
+
+        return settings.optimizer.cacheSize >= 3 &&
+            settings.meshlets.maxVertices >= 3 && settings.meshlets.maxVertices <= 255 &&
+            settings.meshlets.maxTriangles >= 1 &&
+            settings.lods.triangleRatio > 0.0f && settings.lods.triangleRatio < 1.0f &&
+            rootMotion.sampleRate > 0.0f;
+    }
+
+    bool IsTextureInput(const std::string& input)
+    {
+        const size_t dot = input.find_last_of('.');
+        std::string extension = dot == std::string::npos ? std::string() : input.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == "tga";
+    }
+
+    bool ParseTextureArguments(int argc, char** argv, TextureCookOptions& options)
+    {
+        std::string format;
+        for (int i = 3; i < argc; ++i)
+        {
+            const std::string argument = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (argument == "--usage" && hasValue)
+            {
+                const std::string usage = argv[++i];
+                if (usage == "albedo") options.settings.usage = TextureCookUsage::Albedo;
+                else if (usage == "normal") options.settings.usage = TextureCookUsage::Normal;
+                else if (usage == "mask") options.settings.usage = TextureCookUsage::Mask;
+                else
+                {
+                    std::printf("Unknown texture usage '%s'\n", usage.c_str());
+                    return false;
+                }
+            }
+            else if (argument == "--format" && hasValue)
+            {
+                format = argv[++i];
+            }
+            else if (argument == "--no-mips")
+            {
+                options.settings.generateMips = false;
+            }
+            else if (argument == "--cache" && hasValue)
+            {
+                options.cacheDirectory = argv[++i];
+            }
+            else
+            {
+                std::printf("Unknown option '%s'\n", argument.c_str());
+                return false;
+            }
+        }
+
+        // Whether BC1 and BC7 are sRGB depends on the usage, which may come after the format
+        if (format.empty())
+        {
+            return true;
+        }
+        const bool albedo = options.settings.usage == TextureCookUsage::Albedo;
+        if (format == "bc1") options.settings.format = albedo ? RHIFormat::BC1Srgb : RHIFormat::BC1Unorm;
+        else if (format == "bc4") options.settings.format = RHIFormat::BC4Unorm;
+        else if (format == "bc5") options.settings.format = RHIFormat::BC5Unorm;
+        else if (format == "bc7") options.settings.format = albedo ? RHIFormat::BC7Srgb : RHIFormat::BC7Unorm;
+        else
+        {
+            std::printf("Unknown texture format '%s'\n", format.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    const char* GetFormatName(RHIFormat format)
+    {
+        switch (format)
+        {
+        case RHIFormat::BC1Unorm: return "BC1";
+        case RHIFormat::BC1Srgb: return "BC1 sRGB";
+        case RHIFormat::BC4Unorm: return "BC4";
+        case RHIFormat::BC5Unorm: return "BC5";
+        case RHIFormat::BC7Unorm: return "BC7";
+        case RHIFormat::BC7Srgb: return "BC7 sRGB";
+        default: return "?";
+        }
+    }
+
+    int CookTexture(const std::string& input, const std::string& output, const TextureCookOptions& options)
+    {
+        TextureImage image;
+        if (!TextureImporter::Import(input, image))
+        {
+            std::printf("Failed to import '%s'\n", input.c_str());
+            return 1;
+        }
+
+        ThreadPool pool;
+        TextureCookReport report;
+        const TextureAsset asset = options.cacheDirectory.empty() ?
+            TextureCooker::Cook(image, options.settings, &pool, report) :
+            TextureCooker::CookCached(image, options.settings, options.cacheDirectory, &pool, report);
+
+        const double megapixels = report.sourceBytes / 4.0 / 1e6;
+        std::printf("%-32s %ux%u  %-8s mips %2u  %8.1f KB -> %8.1f KB  %.1f ms  %.1f MP/s",
+            input.c_str(), report.width, report.height, GetFormatName(report.format), report.mipLevels,
+            report.sourceBytes / 1024.0, report.cookedBytes / 1024.0, report.cookTime,
+            report.cookTime > 0.0 ? megapixels / (report.cookTime / 1000.0) : 0.0);
+        if (report.cacheHit)
+        {
+            std::printf("  (cache hit)\n");
+        }
+        else
+        {
+            std::printf("  PSNR %.2f dB\n", report.psnr);
+        }
+
+        if (!TextureAssetSerializer::Save(output, asset))
+        {
+            std::printf("Failed to write '%s'\n", output.c_str());
+            return 1;
+        }
+
+        std::printf("Cooked texture to '%s'\n", output.c_str());
+        return 0;
+    }
+
+    void PrintReport(const MeshCookReport& report)
+    {
+        const MeshOptimizerReport& optimization = report.optimization;
+        std::printf("%-32s verts %8u  tris %8u  ACMR %.3f -> %.3f  ATVR %.3f -> %.3f\n",
+            report.meshName.c_str(), report.vertexCount, report.triangleCount,
+            optimization.before.acmr, optimization.after.acmr,
+            optimization.before.atvr, optimization.after.atvr);
+
+        if (report.meshletCount > 0)
+        {
+            std::printf("%-32s meshlets %5u  avg verts %.1f  avg tris %.1f  cones %u\n",
+                "", report.meshletCount, report.averageMeshletVertices, report.averageMeshletTriangles, report.conesEnabled);
+        }
+
+        for (size_t i = 0; i < report.lods.size(); ++i)
+        {
+            const MeshLod& lod = report.lods[i];
+            std::printf("%-32s LOD %zu     tris %8u  (%5.1f%%)  error %g\n", "", i + 1, lod.indexCount / 3,
+                100.0f * lod.indexCount / 3 / report.triangleCount, lod.error);
+        }
+    }
+
+    bool CookRootMotion(const std::string& input, RootMotionCookOptions& options)
+    {
+        std::vector<SkeletonJointDesc> joints;
+        std::vector<AnimationClip> clips;
+        if (!ModelImporter::ImportAnimations(input, options.sampleRate, joints, clips))
+        {
+            std::printf("Failed to import animations from '%s'\n", input.c_str());
+            return false;
+        }
+
+        if (!options.rootJoint.empty())
+        {
+            const auto it = std::find_if(joints.begin(), joints.end(),
+                [&](const SkeletonJointDesc& joint) { return joint.name == options.rootJoint; });
+            if (it == joints.end())
+            {
+                std::printf("No node named '%s'\n", options.rootJoint.c_str());
+                return false;
+            }
+            options.settings.rootJoint = static_cast<uint16>(it - joints.begin());
+        }
+
+        std::vector<RootMotionTrack> tracks;
+        tracks.reserve(clips.size());
+        for (AnimationClip& clip : clips)
+        {
+            const size_t clipBytes = clip.frames.size() * sizeof(Transform);
+            tracks.push_back(RootMotionExtractor::Extract(clip, options.settings));
+
+            const RootMotionTrack& track = tracks.back();
+            const size_t trackBytes = track.positions.size() * sizeof(float3) + track.yaws.size() * sizeof(float);
+            const float3 displacement = track.positions.empty() ? float3() : track.positions.back();
+            const float turn = track.yaws.empty() ? 0.0f : track.yaws.back();
+            std::printf("%-32s frames %6u  moves %.2f  turns %.1f deg  root track %zu bytes (clip %zu)\n",
+                track.name.c_str(), track.GetFrameCount(), displacement.length(), ConvertToDegrees(turn), trackBytes, clipBytes);
+        }
+
+        if (!RootMotionAssetSerializer::Save(options.output, tracks))
+        {
+            std::printf("Failed to write '%s'\n", options.output.c_str());
+            return false;
+        }
+
+        std::printf("Extracted %zu root track(s) to '%s'\n", tracks.size(), options.output.c_str());
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string input;
+    std::string output;
+    MeshCookSettings settings;
+    RootMotionCookOptions rootMotion;
+
+    if (argc >= 3 && IsTextureInput(argv[1]))
+    {
+        TextureCookOptions texture;
+        if (!ParseTextureArguments(argc, argv, texture))
+        {
+            PrintUsage();
+            return 1;
+        }
+        return CookTexture(argv[1], argv[2], texture);
+    }
+
+    if (!ParseArguments(argc, argv, input, output, settings, rootMotion))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    std::vector<Mesh> meshes;
+    if (!ModelImporter::ImportMeshes(input, meshes))
+    {
+        std::printf("Failed to import '%s'\n", input.c_str());
+        return 1;
+    }
+
+    std::vector<MeshAsset> assets;
+    assets.reserve(meshes.size());
+
+    for (const Mesh& mesh : meshes)
+    {
+        MeshCookReport report;
+        assets.push_back(MeshCooker::Cook(mesh, settings, report));
+        PrintReport(report);
+    }
+
+    if (!MeshAssetSerializer::Save(output, assets))
+    {
+        std::printf("Failed to write '%s'\n", output.c_str());
+        return 1;
+    }
+
+    std::printf("Cooked %zu mesh(es) to '%s'\n", assets.size(), output.c_str());
+
+    if (!rootMotion.output.empty() && !CookRootMotion(input, rootMotion))
+    {
+        return 1;
+    }
+
+    return 0;
+}